@@ -0,0 +1,63 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : BenchGraph.H
+* Author          : Jishnu M Thampan
+* Description     : Synthetic road graphs shared by the benchmarks
+****************************************************************************/
+#ifndef BENCH_GRAPH_H
+#define BENCH_GRAPH_H
+
+#include <random>
+#include <sstream>
+
+#include <nsp/CRoutingGraph.h>
+
+#define GRID_SPACING (0.001) /**< @brief Grid spacing in degree */
+#define GRID_ORIGIN_LATITUDE (49.0)
+#define GRID_ORIGIN_LONGITUDE (8.0)
+
+/**
+ * Builds a side x side grid where every node is connected to its four
+ * neighbours in both directions. The edge lengths are the great-circle
+ * distances stretched by a random detour factor of up to 25%.
+ */
+static inline void buildGridGraph(unsigned int side, CRoutingGraph &graph)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> detour(1.0, 1.25);
+
+  for (unsigned int row = 0; row < side; row++)
+  {
+    for (unsigned int col = 0; col < side; col++)
+    {
+      std::ostringstream name;
+      name << "grid_" << row << "_" << col;
+      graph.addNode(name.str(), GRID_ORIGIN_LATITUDE + row * GRID_SPACING,
+                    GRID_ORIGIN_LONGITUDE + col * GRID_SPACING);
+    }
+  }
+  for (unsigned int row = 0; row < side; row++)
+  {
+    for (unsigned int col = 0; col < side; col++)
+    {
+      CRoutingGraph::node_t node = row * side + col;
+      if (col + 1 < side)
+      {
+        double length = graph.getDistance(node, node + 1) * detour(generator);
+        graph.addEdge(node, node + 1, length);
+        graph.addEdge(node + 1, node, length);
+      }
+      if (row + 1 < side)
+      {
+        double length =
+            graph.getDistance(node, node + side) * detour(generator);
+        graph.addEdge(node, node + side, length);
+        graph.addEdge(node + side, node, length);
+      }
+    }
+  }
+  graph.finalize();
+}
+
+#endif // BENCH_GRAPH_H
@@ -0,0 +1,138 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CAttributeExtractorBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the single-pass attribute extraction
+*                   against the previous count/substr/find extraction on
+*                   POI records.
+*                   Usage: CAttributeExtractorBench [lines]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nsp/CAttributeExtractor.h>
+#include <nsp/TypeMapping.h>
+
+#define DEFAULT_LINES (10000000) /**< @brief Number of extracted lines */
+#define DISTINCT_LINES (4096)    /**< @brief Number of generated records */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * The extraction as it was before the single-pass splitter: one count per
+ * delimiter, then a copy of the remaining text and one find per delimiter
+ * for every attribute.
+ */
+static bool legacyExtractAttributes(const std::string &line,
+                                    const std::vector<char> &delimiters,
+                                    unsigned int maxAttributes,
+                                    std::vector<std::string> &attributeVec)
+{
+  unsigned int numberOfAttributes = 0;
+  for (unsigned int i = 0; i < delimiters.size(); i++)
+  {
+    numberOfAttributes += std::count(line.begin(), line.end(), delimiters[i]);
+  }
+  if (maxAttributes != (numberOfAttributes + 1))
+  {
+    return false;
+  }
+  size_t parseStartPosition = 0, parseEndPosition = line.length();
+  for (unsigned int i = 0;
+       (i <= numberOfAttributes) && (parseStartPosition <= parseEndPosition);
+       i++)
+  {
+    std::string textToBeProcessed =
+        line.substr(parseStartPosition, parseEndPosition);
+    size_t delimiterPos = textToBeProcessed.find(delimiters[0]);
+    for (unsigned int j = 1; j < delimiters.size(); j++)
+    {
+      size_t newPos = textToBeProcessed.find(delimiters[j]);
+      if (delimiterPos >= newPos)
+      {
+        delimiterPos = newPos;
+      }
+    }
+    attributeVec.push_back(line.substr(parseStartPosition, delimiterPos));
+    parseStartPosition += delimiterPos + 1;
+  }
+  return !attributeVec.empty();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int lines = (argc > 1) ? atoi(argv[1]) : DEFAULT_LINES;
+
+  /* POI records like in the CSV files, cycled through for every pass */
+  const char *types[] = {"RESTAURANT", "TOURISTIC", "GASSTATION",
+                         "UNIVERSITY"};
+  std::mt19937 generator(6);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::vector<std::string> records;
+  size_t bytes = 0;
+  for (unsigned int i = 0; i < DISTINCT_LINES; i++)
+  {
+    std::ostringstream record;
+    record.precision(9);
+    record << types[i % 4] << ";poi_" << i << ";generated point of interest;"
+           << latitude(generator) << ";" << longitude(generator);
+    records.push_back(record.str());
+    bytes += record.str().length();
+  }
+  double megabytes = (double)bytes * lines / DISTINCT_LINES / 1e6;
+  std::cout << "Extracting " << lines << " lines, " << megabytes << " MB"
+            << std::endl;
+
+  std::vector<char> delimiters;
+  delimiters.push_back(';');
+  delimiters.push_back(',');
+
+  size_t legacyAttributes = 0;
+  benchClock_t::time_point legacyStart = benchClock_t::now();
+  for (unsigned int i = 0; i < lines; i++)
+  {
+    std::vector<std::string> attributeVec;
+    legacyExtractAttributes(records[i % DISTINCT_LINES], delimiters,
+                            MAX_POI_ATTRIBUTES, attributeVec);
+    legacyAttributes += attributeVec.size();
+  }
+  std::chrono::duration<double> legacyTime =
+      benchClock_t::now() - legacyStart;
+  std::cout << "Previous extraction:  " << legacyTime.count() << " s, "
+            << megabytes / legacyTime.count() << " MB/s" << std::endl;
+
+  CAttributeExtractor attributeExtractor;
+  attributeExtractor.setDelimiters(delimiters);
+  attributeExtractor.setMaxAttributes(MAX_POI_ATTRIBUTES);
+  std::vector<std::string_view> attributeVec;
+  size_t attributes = 0;
+  benchClock_t::time_point start = benchClock_t::now();
+  for (unsigned int i = 0; i < lines; i++)
+  {
+    attributeExtractor.extractAttributes(
+        std::string_view(records[i % DISTINCT_LINES]), attributeVec);
+    attributes += attributeVec.size();
+  }
+  std::chrono::duration<double> time = benchClock_t::now() - start;
+  std::cout << "Single-pass splitter: " << time.count() << " s, "
+            << megabytes / time.count() << " MB/s, "
+            << legacyTime.count() / time.count() << "x faster" << std::endl;
+
+  if (attributes != legacyAttributes)
+  {
+    std::cout << "ERROR! The attribute counts differ: " << attributes
+              << " != " << legacyAttributes << std::endl;
+    return 1;
+  }
+  return 0;
+}
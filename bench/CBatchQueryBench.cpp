@@ -0,0 +1,117 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBatchQueryBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the batch query API. Runs the same batch
+*                   of nearest-POI and route distance queries with 1, 2,
+*                   4, ... worker threads and reports the speedup.
+*                   Usage: CBatchQueryBench [pois] [poiQueries] [gridSide]
+*                          [routeQueries]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <nsp/CBatchQuery.h>
+
+#include "BenchGraph.h"
+
+#define DEFAULT_POIS (200000)          /**< @brief Size of the POI database */
+#define DEFAULT_POI_QUERIES (1000000)  /**< @brief Nearest-POI queries */
+#define DEFAULT_GRID_SIDE (100)        /**< @brief 100 x 100 road grid */
+#define DEFAULT_ROUTE_QUERIES (100000) /**< @brief Route distance queries */
+
+/**
+ * Prints the statistics of a batch
+ */
+static void printStats(const char *pName, unsigned int threads,
+                       const CBatchQuery::batchStats_t &stats,
+                       double singleThreadSeconds)
+{
+  std::cout << pName << " threads=" << threads
+            << " qps=" << stats.queriesPerSecond
+            << " mean=" << stats.meanLatencyUs
+            << "us p50=" << stats.p50LatencyUs
+            << "us p99=" << stats.p99LatencyUs
+            << "us max=" << stats.maxLatencyUs
+            << "us speedup=" << singleThreadSeconds / stats.elapsedSeconds
+            << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  size_t poiCount = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  size_t poiQueries = (argc > 2) ? atoi(argv[2]) : DEFAULT_POI_QUERIES;
+  unsigned int side = (argc > 3) ? atoi(argv[3]) : DEFAULT_GRID_SIDE;
+  size_t routeQueries = (argc > 4) ? atoi(argv[4]) : DEFAULT_ROUTE_QUERIES;
+
+  /* POIs spread over Germany */
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> randomLatitude(47.3, 55.0);
+  std::uniform_real_distribution<double> randomLongitude(5.9, 15.0);
+  CPoiDatabase poiDb;
+  for (size_t i = 0; i < poiCount; i++)
+  {
+    std::ostringstream name;
+    name << "poi_" << i;
+    poiDb.addPoi(CPOI(CPOI::RESTAURANT, name.str(), "bench",
+                      randomLatitude(generator), randomLongitude(generator)));
+  }
+  CSpatialGrid grid;
+  grid.build(poiDb);
+  std::vector<double> latitudes(poiQueries), longitudes(poiQueries);
+  for (size_t i = 0; i < poiQueries; i++)
+  {
+    latitudes[i] = randomLatitude(generator);
+    longitudes[i] = randomLongitude(generator);
+  }
+  std::vector<const CPOI *> pois(poiQueries);
+  std::vector<double> poiDistances(poiQueries);
+
+  CRoutingGraph graph;
+  buildGridGraph(side, graph);
+  CContractionHierarchy hierarchy;
+  hierarchy.build(graph);
+  std::uniform_int_distribution<CRoutingGraph::node_t> randomNode(
+      0, graph.getNodeCount() - 1);
+  std::vector<CRoutingGraph::node_t> sources(routeQueries),
+      targets(routeQueries);
+  for (size_t i = 0; i < routeQueries; i++)
+  {
+    sources[i] = randomNode(generator);
+    targets[i] = randomNode(generator);
+  }
+  std::vector<double> routeDistances(routeQueries);
+
+  std::cout << poiCount << " POIs (cell size " << grid.getCellSize()
+            << " deg), road grid with " << graph.getNodeCount() << " nodes, "
+            << std::thread::hardware_concurrency() << " cores" << std::endl;
+
+  unsigned int maxThreads =
+      std::max(1u, std::thread::hardware_concurrency());
+  double poiBaseSeconds = 0, routeBaseSeconds = 0;
+  for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    CThreadPool pool(threads);
+    CBatchQuery batchQuery(pool);
+    CBatchQuery::batchStats_t stats;
+
+    batchQuery.findNearestPois(grid, latitudes.data(), longitudes.data(),
+                               poiQueries, pois.data(), poiDistances.data(),
+                               stats);
+    if (1 == threads)
+      poiBaseSeconds = stats.elapsedSeconds;
+    printStats("nearest-poi", threads, stats, poiBaseSeconds);
+
+    batchQuery.findRouteDistances(hierarchy, sources.data(), targets.data(),
+                                  routeQueries, routeDistances.data(), stats);
+    if (1 == threads)
+      routeBaseSeconds = stats.elapsedSeconds;
+    printStats("route-distance", threads, stats, routeBaseSeconds);
+  }
+  return 0;
+}
@@ -0,0 +1,147 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBinaryPersistenceBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the startup from a binary snapshot: the
+*                   mapping of the snapshot, a name lookup, the checksums
+*                   and readData into the Databases, against readData of
+*                   the same POIs from a JSON file.
+*                   Usage: CBinaryPersistenceBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CBinaryPersistence.h>
+#include <nsp/CJsonPersistence.h>
+
+#define DEFAULT_POIS (10000000) /**< @brief Number of generated POIs */
+#define BENCH_MEDIA "CBinaryPersistenceBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".bin" /**< @brief The snapshot */
+#define JSON_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The JSON file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Gets the seconds since a start time
+ */
+static double getSeconds(benchClock_t::time_point start)
+{
+  return std::chrono::duration<double>(benchClock_t::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  double writeTime = 0, jsonWriteTime = 0;
+  {
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    waypointDb.addWaypoint(CWaypoint(49.8666, 8.6407, "Darmstadt"));
+    for (unsigned int i = 0; i < pois; i++)
+    {
+      poiDb.addPoi(CPOI((CPOI::t_poi)(i % CPOI::UNKNOWN),
+                        "poi_" + std::to_string(i),
+                        "generated point of interest", latitude(generator),
+                        longitude(generator)));
+    }
+    CBinaryPersistence binary;
+    binary.setMediaName(BENCH_MEDIA);
+    benchClock_t::time_point start = benchClock_t::now();
+    binary.writeData(waypointDb, poiDb);
+    writeTime = getSeconds(start);
+    CJsonPersistence json;
+    json.setMediaName(BENCH_MEDIA);
+    start = benchClock_t::now();
+    json.writeData(waypointDb, poiDb);
+    jsonWriteTime = getSeconds(start);
+  }
+  std::cout << "writeData snapshot:       " << writeTime * 1e3 << " ms"
+            << std::endl;
+  std::cout << "writeData JSON:           " << jsonWriteTime * 1e3 << " ms"
+            << std::endl;
+
+  CBinaryPersistence binary;
+  binary.setMediaName(BENCH_MEDIA);
+  CBinarySnapshot snapshot;
+  benchClock_t::time_point start = benchClock_t::now();
+  bool isMapped = binary.readSnapshot(snapshot);
+  double mapTime = getSeconds(start);
+
+  /* The first lookup also faults in the pages it touches */
+  start = benchClock_t::now();
+  size_t index = 0;
+  bool isFound = snapshot.find(CBinarySnapshot::POI_TABLE,
+                               "poi_" + std::to_string(pois / 2), index);
+  double findTime = getSeconds(start);
+
+  start = benchClock_t::now();
+  bool isVerified = snapshot.verify();
+  double verifyTime = getSeconds(start);
+
+  start = benchClock_t::now();
+  const double *pLatitudes = snapshot.getLatitudes(CBinarySnapshot::POI_TABLE);
+  double minLatitude = 90, maxLatitude = -90;
+  for (size_t i = 0; i < snapshot.getCount(CBinarySnapshot::POI_TABLE); i++)
+  {
+    minLatitude = std::min(minLatitude, pLatitudes[i]);
+    maxLatitude = std::max(maxLatitude, pLatitudes[i]);
+  }
+  double scanTime = getSeconds(start);
+  snapshot.close();
+
+  std::cout << "readSnapshot:             " << mapTime * 1e3 << " ms ("
+            << (isMapped ? "mapped" : "FAILED") << ")" << std::endl;
+  std::cout << "find, first lookup:       " << findTime * 1e3 << " ms ("
+            << (isFound ? "found" : "MISSING") << " at " << index << ")"
+            << std::endl;
+  std::cout << "verify checksums:         " << verifyTime * 1e3 << " ms ("
+            << (isVerified ? "intact" : "DAMAGED") << ")" << std::endl;
+  std::cout << "latitude column scan:     " << scanTime * 1e3 << " ms ("
+            << minLatitude << " .. " << maxLatitude << ")" << std::endl;
+
+  double readTime = 0, jsonReadTime = 0;
+  size_t size = 0, jsonSize = 0;
+  {
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    start = benchClock_t::now();
+    binary.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+    readTime = getSeconds(start);
+    size = poiDb.size();
+  }
+  {
+    CJsonPersistence json;
+    json.setMediaName(BENCH_MEDIA);
+    json.setScanner(CJsonPersistence::INDEX_SCANNER);
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    start = benchClock_t::now();
+    json.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+    jsonReadTime = getSeconds(start);
+    jsonSize = poiDb.size();
+  }
+  std::cout << "readData snapshot:        " << readTime * 1e3 << " ms ("
+            << size << " POIs)" << std::endl;
+  std::cout << "readData JSON (index):    " << jsonReadTime * 1e3 << " ms ("
+            << jsonSize << " POIs)" << std::endl;
+
+  remove(BENCH_FILE);
+  remove(JSON_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCSVReadBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of loading a generated POI file with CCSV
+*                   on one and on several threads, against reading the
+*                   raw file contents only.
+*                   Usage: CCSVReadBench [pois] [threads]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nsp/CCSV.h>
+#include <nsp/CMappedFile.h>
+
+#define DEFAULT_POIS (1000000) /**< @brief Number of generated POIs */
+#define BENCH_MEDIA "CCSVReadBench" /**< @brief Media of the generated files */
+#define BENCH_WP_FILE "src/" BENCH_MEDIA "-wp.txt"
+#define BENCH_POI_FILE "src/" BENCH_MEDIA "-poi.txt"
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Writes POIs with unique names and random coordinates
+ */
+static size_t writePoiFile(unsigned int pois)
+{
+  const char *types[] = {"RESTAURANT", "TOURISTIC", "GASSTATION",
+                         "UNIVERSITY"};
+  std::mt19937 generator(4);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::ofstream poiFile(BENCH_POI_FILE, std::ios::out | std::ios::binary);
+  poiFile.precision(9);
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    poiFile << types[i % 4] << ";poi_" << i << ";generated point of interest;"
+            << latitude(generator) << ";" << longitude(generator) << "\n";
+  }
+  std::ofstream wpFile(BENCH_WP_FILE, std::ios::out | std::ios::binary);
+  return poiFile.tellp();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  unsigned int threads =
+      (argc > 2) ? atoi(argv[2]) : std::thread::hardware_concurrency();
+  double megabytes = writePoiFile(pois) / 1e6;
+  std::cout << "POI file: " << pois << " POIs, " << megabytes << " MB"
+            << std::endl;
+
+  /* Lower bound: touch every byte of the mapping once */
+  benchClock_t::time_point scanStart = benchClock_t::now();
+  CMappedFile mappedFile;
+  size_t lines = 0;
+  if (mappedFile.open(BENCH_POI_FILE))
+  {
+    mappedFile.adviseSequential();
+    const char *pData = mappedFile.getData();
+    const char *pEnd = pData + mappedFile.getSize();
+    while ((pData < pEnd) &&
+           (NULL != (pData = static_cast<const char *>(
+                         memchr(pData, '\n', pEnd - pData)))))
+    {
+      pData++;
+      lines++;
+    }
+  }
+  std::chrono::duration<double> scanTime = benchClock_t::now() - scanStart;
+  mappedFile.close();
+  std::cout << "Line scan of the mapping: " << megabytes / scanTime.count()
+            << " MB/s (" << lines << " lines)" << std::endl;
+
+  /* Copying every line into a string vector, as the reader did before */
+  benchClock_t::time_point copyStart = benchClock_t::now();
+  std::vector<std::string> fileContents;
+  {
+    std::ifstream poiFile(BENCH_POI_FILE);
+    std::string line;
+    while (getline(poiFile, line))
+    {
+      fileContents.push_back(line);
+    }
+  }
+  std::chrono::duration<double> copyTime = benchClock_t::now() - copyStart;
+  std::vector<std::string>().swap(fileContents);
+  std::cout << "getline() into a string vector: "
+            << megabytes / copyTime.count() << " MB/s" << std::endl;
+
+  CCSV csv;
+  csv.setMediaName(BENCH_MEDIA);
+  unsigned int threadCounts[] = {1, threads};
+  for (unsigned int i = 0; i < ((threads > 1) ? 2 : 1); i++)
+  {
+    CWpDatabase wpDb;
+    CPoiDatabase poiDb;
+    csv.setThreadCount(threadCounts[i]);
+    benchClock_t::time_point loadStart = benchClock_t::now();
+    csv.readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+    std::chrono::duration<double> loadTime = benchClock_t::now() - loadStart;
+    std::cout << "CCSV::readData() on " << threadCounts[i]
+              << " thread(s): " << megabytes / loadTime.count() << " MB/s, "
+              << poiDb.size() / loadTime.count() << " POIs/s" << std::endl;
+  }
+
+  remove(BENCH_WP_FILE);
+  remove(BENCH_POI_FILE);
+  return 0;
+}
@@ -0,0 +1,114 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCSVWriteBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of writing a generated POI database with
+*                   CCSV on the calling thread and with the background I/O
+*                   thread, against the previous fstream writer and against
+*                   writing the same bytes in large blocks only.
+*                   Usage: CCSVWriteBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CBufferedWriter.h>
+#include <nsp/CCSV.h>
+#include <nsp/TypeMapping.h>
+
+#define DEFAULT_POIS (1000000) /**< @brief Number of generated POIs */
+#define BENCH_MEDIA "CCSVWriteBench" /**< @brief Media of the written files */
+#define BENCH_WP_FILE "src/" BENCH_MEDIA "-wp.txt"
+#define BENCH_POI_FILE "src/" BENCH_MEDIA "-poi.txt"
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * The POI writer as it was before the buffered writer: a copy of the
+ * Database, then one stream insertion per field and a flush per line.
+ */
+static void legacyWritePoiFile(const CPoiDatabase &poiDb)
+{
+  std::fstream poiFile(BENCH_POI_FILE, std::ios::out);
+  CPoiDatabase::POIDatabaseMap_t db;
+  poiDb.getPoiDatabase(db);
+  for (CPoiDatabase::POIDatabaseMap_t::const_iterator itr = db.begin();
+       itr != db.end(); ++itr)
+  {
+    std::string poiType;
+    type_mapping::convertPoiTypeToString((itr->second).getType(), poiType);
+    poiFile << poiType << ";" << (itr->first) << ";"
+            << (itr->second.getDescription()) << ";"
+            << (itr->second).getLatitude() << ";"
+            << (itr->second).getLongitude() << std::endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(8);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    poiDb.addPoi(CPOI((CPOI::t_poi)(i % 4), "poi_" + std::to_string(i),
+                      "generated point of interest", latitude(generator),
+                      longitude(generator)));
+  }
+
+  benchClock_t::time_point legacyStart = benchClock_t::now();
+  legacyWritePoiFile(poiDb);
+  std::chrono::duration<double> legacyTime =
+      benchClock_t::now() - legacyStart;
+  std::cout << "Previous fstream writer (6 digits): "
+            << pois / legacyTime.count() << " POIs/s" << std::endl;
+
+  CCSV csv;
+  csv.setMediaName(BENCH_MEDIA);
+  const char *modes[] = {"calling thread", "background I/O thread"};
+  unsigned int threadCounts[] = {1, 0};
+  for (unsigned int i = 0; i < 2; i++)
+  {
+    csv.setThreadCount(threadCounts[i]);
+    benchClock_t::time_point start = benchClock_t::now();
+    csv.writeData(wpDb, poiDb);
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    std::cout << "CCSV::writeData() on the " << modes[i] << ": "
+              << pois / time.count() << " POIs/s, "
+              << legacyTime.count() / time.count() << "x faster"
+              << std::endl;
+  }
+
+  /* Lower bound: the same number of bytes in full buffers, flushed once */
+  struct stat fileStat;
+  stat(BENCH_POI_FILE, &fileStat);
+  std::string block(WRITE_BUFFER_SIZE, 'x');
+  CBufferedWriter writer;
+  benchClock_t::time_point blockStart = benchClock_t::now();
+  writer.open(BENCH_POI_FILE);
+  for (off_t written = 0; written < fileStat.st_size;
+       written += WRITE_BUFFER_SIZE)
+  {
+    writer.append(block);
+  }
+  writer.close();
+  std::chrono::duration<double> blockTime = benchClock_t::now() - blockStart;
+  std::cout << "Block writes of " << fileStat.st_size / 1e6
+            << " MB: " << fileStat.st_size / 1e6 / blockTime.count()
+            << " MB/s, " << pois / blockTime.count() << " POIs/s"
+            << std::endl;
+
+  remove(BENCH_WP_FILE);
+  remove(BENCH_POI_FILE);
+  return 0;
+}
@@ -0,0 +1,173 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactPersistenceBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the compact coordinate format: the size on
+*                   disk and the write and read throughput of the CSV, JSON,
+*                   binary snapshot and compact backends for the same POIs,
+*                   and the raw records/s of the encoder and the decoder.
+*                   The POIs are clustered around cities, as real data is.
+*                   Usage: CCompactPersistenceBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nsp/CBinaryPersistence.h>
+#include <nsp/CCSV.h>
+#include <nsp/CCompactDecoder.h>
+#include <nsp/CCompactEncoder.h>
+#include <nsp/CCompactPersistence.h>
+#include <nsp/CJsonPersistence.h>
+
+#define DEFAULT_POIS (1000000) /**< @brief Number of generated POIs */
+#define CITIES (500)           /**< @brief Number of POI clusters */
+#define BENCH_MEDIA "CCompactPersistenceBench" /**< @brief Name of the media */
+#define RAW_FILE "myCode/" BENCH_MEDIA "-raw.nspc" /**< @brief Encoder file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Gets the seconds since a start time
+ */
+static double getSeconds(benchClock_t::time_point start)
+{
+  return std::chrono::duration<double>(benchClock_t::now() - start).count();
+}
+
+/**
+ * Gets the size of a file, 0 if it does not exist
+ */
+static size_t getFileSize(const std::string &fileName)
+{
+  struct stat status;
+  return (0 == stat(fileName.c_str(), &status)) ? status.st_size : 0;
+}
+
+/**
+ * Writes and reads the Databases with a backend and prints a result line
+ */
+static void runBackend(const char *pLabel, CPersistentStorage &storage,
+                       const std::vector<std::string> &files,
+                       const CWpDatabase &waypointDb,
+                       const CPoiDatabase &poiDb)
+{
+  storage.setMediaName(BENCH_MEDIA);
+  benchClock_t::time_point start = benchClock_t::now();
+  storage.writeData(waypointDb, poiDb);
+  double writeTime = getSeconds(start);
+  size_t size = 0;
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    size += getFileSize(files[i]);
+  }
+  CWpDatabase readWaypointDb;
+  CPoiDatabase readPoiDb;
+  start = benchClock_t::now();
+  storage.readData(readWaypointDb, readPoiDb, CPersistentStorage::REPLACE);
+  double readTime = getSeconds(start);
+  double records = poiDb.size() + waypointDb.size();
+  std::cout << std::left << std::setw(10) << pLabel << std::right
+            << std::setw(10) << size / 1048576.0 << " MB " << std::setw(8)
+            << (double)size / records << " B/rec  write " << std::setw(9)
+            << records / writeTime / 1e6 << " Mrec/s  read " << std::setw(9)
+            << records / readTime / 1e6 << " Mrec/s ("
+            << readPoiDb.size() << " POIs)" << std::endl;
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    remove(files[i].c_str());
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> cityLatitude(-60.0, 70.0),
+      cityLongitude(-180.0, 180.0);
+  std::normal_distribution<double> offset(0.0, 0.05);
+  std::vector<std::pair<double, double> > cities;
+  for (int i = 0; i < CITIES; i++)
+  {
+    cities.push_back(
+        std::make_pair(cityLatitude(generator), cityLongitude(generator)));
+  }
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  bool isSourceCreated = (0 == mkdir("src", 0755));
+  CWpDatabase waypointDb;
+  CPoiDatabase poiDb;
+  waypointDb.addWaypoint(CWaypoint(49.8666, 8.6407, "Darmstadt"));
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    const std::pair<double, double> &city = cities[i % CITIES];
+    poiDb.addPoi(CPOI((CPOI::t_poi)(i % CPOI::UNKNOWN),
+                      "poi_" + std::to_string(i),
+                      "generated point of interest",
+                      city.first + offset(generator),
+                      city.second + offset(generator)));
+  }
+
+  std::cout << std::fixed << std::setprecision(2);
+  CCSV csv;
+  runBackend("CSV", csv,
+             {"src/" BENCH_MEDIA "-wp.txt", "src/" BENCH_MEDIA "-poi.txt"},
+             waypointDb, poiDb);
+  CJsonPersistence json;
+  json.setScanner(CJsonPersistence::INDEX_SCANNER);
+  runBackend("JSON", json, {"myCode/" BENCH_MEDIA ".json"}, waypointDb,
+             poiDb);
+  CBinaryPersistence binary;
+  runBackend("snapshot", binary, {"myCode/" BENCH_MEDIA ".bin"}, waypointDb,
+             poiDb);
+  CCompactPersistence compact;
+  runBackend("compact", compact, {"myCode/" BENCH_MEDIA ".nspc"}, waypointDb,
+             poiDb);
+
+  /* The encoder and the decoder alone, in the name order of the Database */
+  CCompactEncoder encoder;
+  encoder.open(RAW_FILE);
+  benchClock_t::time_point start = benchClock_t::now();
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    encoder.addPoi(itr->second);
+  }
+  encoder.close();
+  double encodeTime = getSeconds(start);
+
+  CCompactDecoder decoder;
+  decoder.open(RAW_FILE);
+  std::vector<CCompactDecoder::record_t> records;
+  size_t decoded = 0;
+  start = benchClock_t::now();
+  for (size_t block = 0; block < decoder.getBlockCount(); block++)
+  {
+    decoder.decodeBlock(block, records);
+    decoded += records.size();
+  }
+  double decodeTime = getSeconds(start);
+  decoder.close();
+  std::cout << "encoder, name order:  " << std::setw(9)
+            << pois / encodeTime / 1e6 << " Mrec/s ("
+            << encoder.getSize() / 1048576.0 << " MB)" << std::endl;
+  std::cout << "decoder, name order:  " << std::setw(9)
+            << decoded / decodeTime / 1e6 << " Mrec/s (" << decoded
+            << " records)" << std::endl;
+
+  remove(RAW_FILE);
+  if (isSourceCreated)
+    rmdir("src");
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
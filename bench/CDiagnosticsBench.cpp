@@ -0,0 +1,89 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDiagnosticsBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of reading a CSV file with many duplicate and
+*                   invalid lines when every diagnostic is printed, when
+*                   the messages are sampled and when they are printed by
+*                   the logger thread of a CRingBufferSink.
+*                   Usage: CDiagnosticsBench [lines]
+****************************************************************************/
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <nsp/CCSV.h>
+#include <nsp/CDiagnostics.h>
+
+#define DEFAULT_LINES (1000000) /**< @brief Number of generated lines */
+#define BENCH_MEDIA "CDiagnosticsBench" /**< @brief Media of the read files */
+#define BENCH_LOG "src/" BENCH_MEDIA "-log.txt" /**< @brief Printed output */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Reads the files and prints the time
+ * @param const char* name [IN] - Name of the measured configuration
+ * @return None
+ */
+static void measureRead(const char *name)
+{
+  CCSV csv;
+  csv.setMediaName(BENCH_MEDIA);
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  benchClock_t::time_point start = benchClock_t::now();
+  csv.readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+  std::chrono::duration<double> time = benchClock_t::now() - start;
+  std::cout << name << ": " << time.count() * 1e3 << " ms, "
+            << CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY)
+            << " duplicates, "
+            << CDiagnostics::getCount(CDiagnostics::INVALID_RECORD)
+            << " invalid lines" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int lines = (argc > 1) ? atoi(argv[1]) : DEFAULT_LINES;
+  {
+    /* Every second line is a duplicate, every tenth line is invalid */
+    std::ofstream wpFile("src/" BENCH_MEDIA "-wp.txt");
+    for (unsigned int i = 0; i < lines; i++)
+    {
+      if (0 == i % 10)
+        wpFile << "invalid;line\n";
+      else
+        wpFile << "wp_" << i / 2 << ";" << (int)(i % 179) - 89 << ".25;"
+               << (int)(i % 359) - 179 << ".5\n";
+    }
+    std::ofstream poiFile("src/" BENCH_MEDIA "-poi.txt");
+  }
+
+  std::ofstream log(BENCH_LOG);
+  CConsoleSink consoleSink(log);
+  CDiagnostics::setSink(&consoleSink);
+  CDiagnostics::setSampling(ULONG_MAX, 0);
+  measureRead("Every message printed");
+  CDiagnostics::setSampling(DIAGNOSTIC_SAMPLE_LIMIT,
+                            DIAGNOSTIC_SAMPLE_INTERVAL);
+  measureRead("Sampled messages printed");
+  {
+    CRingBufferSink ringBufferSink(log);
+    CDiagnostics::setSink(&ringBufferSink);
+    CDiagnostics::setSampling(ULONG_MAX, 0);
+    measureRead("Every message to the ring buffer");
+    CDiagnostics::setSink(NULL);
+    std::cout << "Dropped by the ring buffer: "
+              << ringBufferSink.getDroppedCount() << std::endl;
+  }
+
+  remove("src/" BENCH_MEDIA "-wp.txt");
+  remove("src/" BENCH_MEDIA "-poi.txt");
+  remove(BENCH_LOG);
+  return 0;
+}
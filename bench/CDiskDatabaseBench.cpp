@@ -0,0 +1,164 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDiskDatabaseBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the disk-resident Database: inserts in
+*                   random order, lookups of random and of hot names, a
+*                   range scan by name and area queries, with a buffer pool
+*                   much smaller than the file.
+*                   Usage: CDiskDatabaseBench [pois] [frames]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nsp/CDiskDatabase.h>
+
+#define DEFAULT_POIS (2000000) /**< @brief Number of generated POIs */
+#define LOOKUPS (200000)       /**< @brief Number of lookups per run */
+#define HOT_NAMES (1000)       /**< @brief Names of the hot lookups */
+#define AREA_QUERIES (1000)    /**< @brief Number of area queries */
+#define BENCH_FILE "myCode/CDiskDatabaseBench.db" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Gets the seconds since a start time
+ */
+static double getSeconds(benchClock_t::time_point start)
+{
+  return std::chrono::duration<double>(benchClock_t::now() - start).count();
+}
+
+/**
+ * Gets the name of a generated POI
+ */
+static std::string getName(unsigned int number)
+{
+  return "poi_" + std::to_string(number);
+}
+
+/**
+ * Prints the pool statistics since the last call
+ */
+static void printPool(const CBufferPool &pool)
+{
+  static uint64_t s_hits = 0, s_misses = 0;
+  uint64_t hits = pool.getHits() - s_hits, misses = pool.getMisses() - s_misses;
+  std::cout << " (hit ratio "
+            << 100.0 * hits / std::max<uint64_t>(hits + misses, 1) << " %)"
+            << std::endl;
+  s_hits = pool.getHits();
+  s_misses = pool.getMisses();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  size_t frames = (argc > 2) ? atoi(argv[2]) : DEFAULT_POOL_FRAMES;
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> latitude(-60.0, 70.0),
+      longitude(-180.0, 180.0);
+  std::vector<unsigned int> numbers(pois);
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    numbers[i] = i;
+  }
+  std::shuffle(numbers.begin(), numbers.end(), generator);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  CDiskPoiDatabase poiDb;
+  if (!poiDb.open(BENCH_FILE, frames, true))
+  {
+    std::cout << "Unable to open " << BENCH_FILE << std::endl;
+    return 1;
+  }
+  const CBufferPool &pool = poiDb.getPool();
+
+  benchClock_t::time_point start = benchClock_t::now();
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    poiDb.addData(getName(numbers[i]),
+                  CPOI((CPOI::t_poi)(i % CPOI::UNKNOWN), getName(numbers[i]),
+                       "generated point of interest", latitude(generator),
+                       longitude(generator)));
+  }
+  poiDb.flush();
+  double insertTime = getSeconds(start);
+  std::cout << "addData, random order:    " << pois / insertTime / 1e3
+            << " k/s, file " << pool.getPageCount() * (DB_PAGE_SIZE / 1048576.0)
+            << " MB, pool " << frames * (DB_PAGE_SIZE / 1048576.0) << " MB";
+  printPool(pool);
+
+  std::uniform_int_distribution<unsigned int> anyName(0, pois - 1),
+      hotName(0, std::min(pois, (unsigned int)HOT_NAMES) - 1);
+  CPOI poi;
+  size_t found = 0;
+  start = benchClock_t::now();
+  for (int i = 0; i < LOOKUPS; i++)
+  {
+    found += poiDb.findData(getName(anyName(generator)), poi);
+  }
+  double lookupTime = getSeconds(start);
+  std::cout << "findData, random names:   " << LOOKUPS / lookupTime / 1e3
+            << " k/s, " << found << " found";
+  printPool(pool);
+
+  found = 0;
+  start = benchClock_t::now();
+  for (int i = 0; i < LOOKUPS; i++)
+  {
+    found += poiDb.findData(getName(numbers[hotName(generator)]), poi);
+  }
+  double hotTime = getSeconds(start);
+  std::cout << "findData, " << HOT_NAMES
+            << " hot names: " << LOOKUPS / hotTime / 1e3 << " k/s, " << found
+            << " found";
+  printPool(pool);
+
+  size_t scanned = 0;
+  start = benchClock_t::now();
+  poiDb.scanData("poi_5", "poi_6", [&](const CPOI &) {
+    scanned++;
+    return true;
+  });
+  double scanTime = getSeconds(start);
+  std::cout << "scanData, poi_5*:         " << scanned / scanTime / 1e6
+            << " M/s, " << scanned << " POIs";
+  printPool(pool);
+
+  std::vector<CPOI> entries;
+  size_t inArea = 0;
+  start = benchClock_t::now();
+  for (int i = 0; i < AREA_QUERIES; i++)
+  {
+    double south = latitude(generator), west = longitude(generator);
+    poiDb.findArea(south, west, south + 1.0, west + 1.0, entries);
+    inArea += entries.size();
+  }
+  double areaTime = getSeconds(start);
+  std::cout << "findArea, 1 x 1 degree:   " << areaTime / AREA_QUERIES * 1e3
+            << " ms/query, " << (double)inArea / AREA_QUERIES << " POIs";
+  printPool(pool);
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  std::cout << "max resident memory:      " << usage.ru_maxrss / 1024.0
+            << " MB" << std::endl;
+
+  poiDb.close();
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
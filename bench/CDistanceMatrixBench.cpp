@@ -0,0 +1,110 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDistanceMatrixBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the all-pairs distance matrix against
+*                   pairwise CWaypoint::calculateDistance calls.
+*                   Usage: CDistanceMatrixBench [points] [maxThreads]
+****************************************************************************/
+#include <math.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <nsp/CDistanceMatrix.h>
+#include <nsp/CThreadPool.h>
+
+#define DEFAULT_POINTS (5000) /**< @brief Number of points (matrix side) */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Computes the matrix with the given pool and reports the throughput
+ */
+template <typename output_t>
+static double timeMatrix(CThreadPool &pool,
+                         const std::vector<const CWaypoint *> &points,
+                         std::vector<output_t> &matrix, const char *label)
+{
+  CDistanceMatrix distanceMatrix(pool);
+  distanceMatrix.setPoints(points);
+  benchClock_t::time_point start = benchClock_t::now();
+  distanceMatrix.compute(matrix.data());
+  std::chrono::duration<double> elapsed = benchClock_t::now() - start;
+  std::cout << "  " << label << ": " << elapsed.count() << " s, "
+            << matrix.size() / elapsed.count() / 1e6 << " M distances/s"
+            << std::endl;
+  return elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int count = (argc > 1) ? atoi(argv[1]) : DEFAULT_POINTS;
+  unsigned int maxThreads = (argc > 2) ? atoi(argv[2]) : 0;
+  if (0 == maxThreads)
+  {
+    maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> latitude(47.0, 55.0),
+      longitude(6.0, 15.0);
+  std::vector<CWaypoint> waypoints;
+  waypoints.reserve(count);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    waypoints.push_back(
+        CWaypoint(latitude(generator), longitude(generator), "point"));
+  }
+  std::vector<const CWaypoint *> points;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    points.push_back(&waypoints[i]);
+  }
+
+  /* Baseline: one calculateDistance call per entry */
+  std::vector<double> reference((size_t)count * count);
+  benchClock_t::time_point start = benchClock_t::now();
+  for (size_t row = 0; row < count; row++)
+  {
+    for (size_t column = 0; column < count; column++)
+    {
+      reference[row * count + column] =
+          waypoints[row].calculateDistance(waypoints[column]);
+    }
+  }
+  std::chrono::duration<double> baseline = benchClock_t::now() - start;
+  std::cout << count << " x " << count << " matrix" << std::endl;
+  std::cout << "  calculateDistance: " << baseline.count() << " s, "
+            << reference.size() / baseline.count() / 1e6 << " M distances/s"
+            << std::endl;
+
+  std::vector<double> matrix(reference.size());
+  std::vector<float> floatMatrix(reference.size());
+  for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    CThreadPool pool(threads);
+    std::cout << threads << " thread(s)" << std::endl;
+    double elapsed = timeMatrix(pool, points, matrix, "double");
+    timeMatrix(pool, points, floatMatrix, "float ");
+    std::cout << "  speedup over calculateDistance: "
+              << baseline.count() / elapsed << std::endl;
+  }
+
+  double maxError = 0, maxFloatError = 0;
+  for (size_t i = 0; i < reference.size(); i++)
+  {
+    maxError = std::max(maxError, fabs(matrix[i] - reference[i]));
+    maxFloatError =
+        std::max(maxFloatError, fabs(floatMatrix[i] - reference[i]));
+  }
+  std::cout << "Max difference to calculateDistance: " << maxError
+            << " km (double), " << maxFloatError << " km (float)"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,121 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CHierarchyRouteFinderBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the contraction hierarchy preprocessing
+*                   and of the route queries on the memory-mapped
+*                   hierarchy. A sample of the queries is checked against
+*                   the A* search.
+*                   Usage: CHierarchyRouteFinderBench [gridSide] [queries]
+*                          [threads]
+****************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <nsp/CContractionHierarchy.h>
+#include <nsp/CHierarchyRouteFinder.h>
+#include <nsp/CRouteFinder.h>
+#include <nsp/CRoutingGraph.h>
+
+#include "BenchGraph.h"
+
+#define DEFAULT_GRID_SIDE (300)  /**< @brief 300 x 300 = 90k nodes */
+#define DEFAULT_QUERIES (10000)  /**< @brief Number of timed queries */
+#define CHECKED_QUERIES (20)     /**< @brief Queries compared with A* */
+#define HIERARCHY_FILE "CHierarchyRouteFinderBench.ch"
+
+typedef std::chrono::steady_clock benchClock_t;
+
+int main(int argc, char *argv[])
+{
+  unsigned int side = (argc > 1) ? atoi(argv[1]) : DEFAULT_GRID_SIDE;
+  unsigned int queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+  unsigned int threads = (argc > 3) ? atoi(argv[3]) : 0;
+
+  CRoutingGraph graph;
+  buildGridGraph(side, graph);
+  std::cout << "Grid graph: " << graph.getNodeCount() << " nodes, "
+            << graph.getEdgeCount() << " edges" << std::endl;
+
+  /* Offline stage */
+  CContractionHierarchy hierarchy;
+  benchClock_t::time_point buildStart = benchClock_t::now();
+  hierarchy.build(graph, threads);
+  std::chrono::duration<double> buildTime = benchClock_t::now() - buildStart;
+  std::cout << "Preprocessing: " << buildTime.count() << " s, "
+            << hierarchy.getUpEdgeCount() << " upward and "
+            << hierarchy.getDownEdgeCount() << " downward edges" << std::endl;
+  if (!hierarchy.writeToFile(HIERARCHY_FILE))
+  {
+    return 1;
+  }
+  hierarchy.clear();
+
+  /* Online stage */
+  benchClock_t::time_point openStart = benchClock_t::now();
+  if (!hierarchy.openFile(HIERARCHY_FILE))
+  {
+    return 1;
+  }
+  std::chrono::duration<double> openTime = benchClock_t::now() - openStart;
+  std::cout << "Mapped hierarchy in " << openTime.count() * 1e3 << " ms"
+            << std::endl;
+
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<CRoutingGraph::node_t> randomNode(
+      0, graph.getNodeCount() - 1);
+  std::vector<CRoutingGraph::node_t> sources(queries), targets(queries);
+  for (unsigned int i = 0; i < queries; i++)
+  {
+    sources[i] = randomNode(generator);
+    targets[i] = randomNode(generator);
+  }
+
+  CHierarchyRouteFinder finder(hierarchy);
+  CRouteFinder referenceFinder(graph);
+  std::vector<CRoutingGraph::node_t> path;
+  unsigned int mismatches = 0;
+  for (unsigned int i = 0; (i < queries) && (i < CHECKED_QUERIES); i++)
+  {
+    double distance = 0, referenceDistance = 0;
+    bool isFound = finder.findPath(sources[i], targets[i], path, distance);
+    bool isReferenceFound = referenceFinder.findPath(
+        sources[i], targets[i], path, referenceDistance);
+    if ((isFound != isReferenceFound) ||
+        (fabs(distance - referenceDistance) > 1e-6))
+    {
+      mismatches++;
+    }
+  }
+
+  unsigned long long settledNodes = 0;
+  unsigned int foundPaths = 0;
+  benchClock_t::time_point queryStart = benchClock_t::now();
+  for (unsigned int i = 0; i < queries; i++)
+  {
+    double distance = 0;
+    if (finder.findPath(sources[i], targets[i], path, distance))
+    {
+      foundPaths++;
+    }
+    settledNodes += finder.getSettledNodeCount();
+  }
+  std::chrono::duration<double> queryTime = benchClock_t::now() - queryStart;
+
+  std::cout << "CH queries: " << queries << " (" << foundPaths
+            << " paths found) in " << queryTime.count() << " s" << std::endl;
+  std::cout << "Throughput: " << queries / queryTime.count()
+            << " queries/s, mean latency: "
+            << (queries ? queryTime.count() * 1e6 / queries : 0)
+            << " us, mean settled nodes: "
+            << (queries ? settledNodes / queries : 0) << std::endl;
+  std::cout << "Mismatches against A*: " << mismatches << std::endl;
+  remove(HIERARCHY_FILE);
+  return (0 == mismatches) ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJournalBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of saving a few changes of a large POI
+*                   database with CJournal against rewriting the whole
+*                   CSV files, and of reading base and journal back.
+*                   Usage: CJournalBench [pois] [changes]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CCSV.h>
+#include <nsp/CJournal.h>
+
+#define DEFAULT_POIS (1000000)  /**< @brief Number of generated POIs */
+#define DEFAULT_CHANGES (100)   /**< @brief Number of changes per save */
+#define SAVES (10)              /**< @brief Number of measured saves */
+#define BENCH_MEDIA "CJournalBench" /**< @brief Media of the written files */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  unsigned int changes = (argc > 2) ? atoi(argv[2]) : DEFAULT_CHANGES;
+  std::mt19937 generator(9);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::uniform_int_distribution<unsigned int> poiIndex(0, pois - 1);
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  wpDb.setChangeTracking(true);
+  poiDb.setChangeTracking(true);
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    poiDb.addPoi(CPOI((CPOI::t_poi)(i % 4), "poi_" + std::to_string(i),
+                      "generated point of interest", latitude(generator),
+                      longitude(generator)));
+  }
+
+  CCSV csv;
+  CJournal journal(csv);
+  journal.setMediaName(BENCH_MEDIA);
+  journal.setCompactionThreshold(pois); /* Measure the appends only */
+  benchClock_t::time_point fullStart = benchClock_t::now();
+  journal.writeData(wpDb, poiDb); /* The first save writes the base */
+  std::chrono::duration<double> fullTime = benchClock_t::now() - fullStart;
+  std::cout << "Full save of " << pois << " POIs: " << fullTime.count() * 1e3
+            << " ms" << std::endl;
+
+  std::chrono::duration<double> journalTime(0);
+  for (unsigned int save = 0; save < SAVES; save++)
+  {
+    for (unsigned int i = 0; i < changes; i++)
+    {
+      poiDb.updatePoi(CPOI(CPOI::RESTAURANT,
+                           "poi_" + std::to_string(poiIndex(generator)),
+                           "changed point of interest", latitude(generator),
+                           longitude(generator)));
+    }
+    benchClock_t::time_point start = benchClock_t::now();
+    journal.writeData(wpDb, poiDb);
+    journalTime += benchClock_t::now() - start;
+  }
+  std::cout << "Journal save of " << changes
+            << " changes: " << journalTime.count() * 1e3 / SAVES << " ms, "
+            << fullTime.count() / (journalTime.count() / SAVES)
+            << "x faster" << std::endl;
+
+  CWpDatabase readWpDb;
+  CPoiDatabase readPoiDb;
+  benchClock_t::time_point readStart = benchClock_t::now();
+  journal.readData(readWpDb, readPoiDb, CPersistentStorage::REPLACE);
+  std::chrono::duration<double> readTime = benchClock_t::now() - readStart;
+  std::cout << "Read of base and journal: " << readTime.count() * 1e3
+            << " ms, " << readPoiDb.size() << " POIs" << std::endl;
+
+  remove("src/" BENCH_MEDIA "-wp.txt");
+  remove("src/" BENCH_MEDIA "-poi.txt");
+  remove("src/" BENCH_MEDIA "-journal.txt");
+  return (readPoiDb.size() == poiDb.size()) ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonIndexScanBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of CJsonIndexScanner against CJsonScanner on
+*                   a generated JSON file of POIs, scanning the tokens only
+*                   and loading the databases with both readData backends.
+*                   Usage: CJsonIndexScanBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <nsp/CJsonIndexScanner.h>
+#include <nsp/CJsonPersistence.h>
+#include <nsp/CJsonScanner.h>
+
+#define DEFAULT_POIS (500000) /**< @brief Number of generated POIs */
+#define RUNS (3)              /**< @brief Number of measured runs */
+#define BENCH_MEDIA "CJsonIndexScanBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Scans all tokens and returns the best time of RUNS scans
+ * @param const std::string& contents [IN] - The JSON text
+ * @param bool useIndex [IN] - true for CJsonIndexScanner
+ * @param size_t& tokens [OUT] - Number of tokens
+ * @return double - The best time in seconds
+ */
+static double scanTokens(const std::string &contents, bool useIndex,
+                         size_t &tokens)
+{
+  std::chrono::duration<double> bestTime(0);
+  for (int run = 0; run < RUNS; run++)
+  {
+    std::istringstream input(contents);
+    APT::CJsonScanner flexScanner(input);
+    CJsonIndexScanner indexScanner(contents);
+    tokens = 0;
+    benchClock_t::time_point start = benchClock_t::now();
+    if (useIndex)
+    {
+      while (NULL != indexScanner.nextToken())
+        tokens++;
+    }
+    else
+    {
+      while (NULL != flexScanner.nextToken())
+        tokens++;
+    }
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+  }
+  return bestTime.count();
+}
+/**
+ * Loads the file with readData and returns the best time of RUNS loads
+ * @param CJsonPersistence::scanner_t scanner [IN] - The scanner backend
+ * @param size_t& pois [OUT] - Number of loaded POIs
+ * @return double - The best time in seconds
+ */
+static double loadFile(CJsonPersistence::scanner_t scanner, size_t &pois)
+{
+  std::chrono::duration<double> bestTime(0);
+  for (int run = 0; run < RUNS; run++)
+  {
+    CJsonPersistence persistence;
+    persistence.setMediaName(BENCH_MEDIA);
+    persistence.setScanner(scanner);
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    benchClock_t::time_point start = benchClock_t::now();
+    persistence.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    CPoiDatabase::POIDatabaseMap_t poiMap;
+    poiDb.getPoiDatabase(poiMap);
+    pois = poiMap.size();
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+  }
+  return bestTime.count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::ostringstream json;
+  json.precision(17);
+  json << "{\n  \"pois\" : [\n";
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    json << "    {\"name\" : \"poi_" << i << "\", \"latitude\" : "
+         << latitude(generator) << ", \"longitude\" : " << longitude(generator)
+         << ", \"description\" : \"generated \\\"point\\\" of interest\", "
+            "\"type\" : \"RESTAURANT\"}"
+         << ((i + 1 < pois) ? ",\n" : "\n");
+  }
+  json << "  ]\n}\n";
+  std::string contents = json.str();
+
+  size_t flexTokens = 0, indexTokens = 0;
+  double flexTime = scanTokens(contents, false, flexTokens);
+  double indexTime = scanTokens(contents, true, indexTokens);
+  std::cout << "Scanning " << contents.size() / 1e6 << " MB, " << flexTokens
+            << " tokens" << std::endl;
+  std::cout << "CJsonScanner:      " << flexTime * 1e3 << " ms, "
+            << contents.size() / flexTime / 1e6 << " MB/s" << std::endl;
+  std::cout << "CJsonIndexScanner: " << indexTime * 1e3 << " ms, "
+            << contents.size() / indexTime / 1e6 << " MB/s ("
+            << indexTokens << " tokens)" << std::endl;
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  std::ofstream(BENCH_FILE, std::ios::binary) << contents;
+  size_t flexPois = 0, indexPois = 0;
+  double flexLoad = loadFile(CJsonPersistence::FLEX_SCANNER, flexPois);
+  double indexLoad = loadFile(CJsonPersistence::INDEX_SCANNER, indexPois);
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  std::cout << "readData FLEX_SCANNER:  " << flexLoad * 1e3 << " ms, "
+            << flexPois << " POIs" << std::endl;
+  std::cout << "readData INDEX_SCANNER: " << indexLoad * 1e3 << " ms, "
+            << indexPois << " POIs" << std::endl;
+  return 0;
+}
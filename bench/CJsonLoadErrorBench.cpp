@@ -0,0 +1,135 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonLoadErrorBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of CJsonPersistence::readData on a generated
+*                   JSON file of POIs where a share of the records is
+*                   invalid (repeated or invalid values, unknown attributes,
+*                   values of the wrong type). The messages are counted but
+*                   not printed, so the time is the time of the parser.
+*                   Usage: CJsonLoadErrorBench [pois] [invalidPercent]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CJsonPersistence.h>
+
+#define DEFAULT_POIS (200000)   /**< @brief Number of generated POIs */
+#define DEFAULT_INVALID (10)    /**< @brief Percentage of invalid POIs */
+#define RUNS (5)                /**< @brief Number of measured loads */
+#define BENCH_MEDIA "CJsonLoadErrorBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * CDiscardSink drops the messages, the benchmark measures the parser and
+ * not the console.
+ */
+class CDiscardSink : public CDiagnosticSink {
+public:
+  void write(CDiagnostics::category_t, std::string_view) {}
+};
+
+/**
+ * The attributes of an invalid POI, one kind of error per POI
+ */
+static const char *const invalidAttributes[] = {
+    "\"latitude\" : 12.5, \"longitude\" : 8.5, \"latitude\" : 12.5",
+    "\"latitude\" : 123.5, \"longitude\" : 8.5",
+    "\"latitude\" : \"12.5\", \"longitude\" : 8.5",
+    "\"latitude\" : 12.5, \"longitude\" : 8.5, \"rating\" : 5",
+};
+
+/**
+ * Loads the file with readData and returns the best time of RUNS loads
+ * @param CJsonPersistence::scanner_t scanner [IN] - The scanner backend
+ * @param size_t& pois [OUT] - Number of loaded POIs
+ * @return double - The best time in seconds
+ */
+static double loadFile(CJsonPersistence::scanner_t scanner, size_t &pois)
+{
+  std::chrono::duration<double> bestTime(0);
+  for (int run = 0; run < RUNS; run++)
+  {
+    CJsonPersistence persistence;
+    persistence.setMediaName(BENCH_MEDIA);
+    persistence.setScanner(scanner);
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    benchClock_t::time_point start = benchClock_t::now();
+    persistence.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    CPoiDatabase::POIDatabaseMap_t poiMap;
+    poiDb.getPoiDatabase(poiMap);
+    pois = poiMap.size();
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+  }
+  return bestTime.count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  unsigned int invalidPercent = (argc > 2) ? atoi(argv[2]) : DEFAULT_INVALID;
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::uniform_int_distribution<unsigned int> percent(0, 99);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  {
+    std::ofstream json(BENCH_FILE, std::ios::binary);
+    json.precision(17);
+    json << "{\n  \"pois\" : [\n";
+    for (unsigned int i = 0; i < pois; i++)
+    {
+      json << "    {\"name\" : \"poi_" << i << "\", ";
+      if (percent(generator) < invalidPercent)
+      {
+        json << invalidAttributes[i % (sizeof(invalidAttributes) /
+                                       sizeof(invalidAttributes[0]))];
+      }
+      else
+      {
+        json << "\"latitude\" : " << latitude(generator)
+             << ", \"longitude\" : " << longitude(generator);
+      }
+      json << ", \"description\" : \"generated point of interest\", "
+              "\"type\" : \"RESTAURANT\"}"
+           << ((i + 1 < pois) ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+  }
+
+  CDiscardSink sink;
+  CDiagnostics::setSink(&sink);
+  size_t flexPois = 0, indexPois = 0;
+  double flexLoad = loadFile(CJsonPersistence::FLEX_SCANNER, flexPois);
+  double indexLoad = loadFile(CJsonPersistence::INDEX_SCANNER, indexPois);
+  /* The counts are those of the last load */
+  unsigned long errors = CDiagnostics::getCount(CDiagnostics::INVALID_JSON);
+  CDiagnostics::setSink(NULL);
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+
+  std::cout << pois << " POIs, " << errors << " invalid records per load"
+            << std::endl;
+  std::cout << "readData FLEX_SCANNER:  " << flexLoad * 1e3 << " ms, "
+            << flexPois << " POIs" << std::endl;
+  std::cout << "readData INDEX_SCANNER: " << indexLoad * 1e3 << " ms, "
+            << indexPois << " POIs" << std::endl;
+  return 0;
+}
@@ -0,0 +1,129 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonParallelLoadBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of CJsonPersistence::readData on one thread
+*                   and with several threads, on a generated JSON file of
+*                   waypoints and POIs where some records are invalid. The
+*                   loaded records and the messages of every thread count
+*                   are compared with those of the load on one thread.
+*                   Usage: CJsonParallelLoadBench [pois] [threads]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CJsonPersistence.h>
+
+#define DEFAULT_POIS (1000000) /**< @brief Number of generated POIs */
+#define DEFAULT_THREADS (4)    /**< @brief Most threads of a load */
+#define RUNS (3)               /**< @brief Number of measured loads */
+#define BENCH_MEDIA "CJsonParallelLoadBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Loads the file with readData and returns the best time of RUNS loads
+ * @param unsigned int threads [IN] - The threads parsing the file
+ * @param std::string& result [OUT] - The messages and records of the load
+ * @return double - The best time in seconds
+ */
+static double loadFile(unsigned int threads, std::string &result)
+{
+  std::chrono::duration<double> bestTime(0);
+  for (int run = 0; run < RUNS; run++)
+  {
+    std::ostringstream messages;
+    CConsoleSink sink(messages);
+    CDiagnostics::setSink(&sink);
+    CJsonPersistence persistence;
+    persistence.setMediaName(BENCH_MEDIA);
+    persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+    persistence.setThreadCount(threads);
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    benchClock_t::time_point start = benchClock_t::now();
+    persistence.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    CDiagnostics::setSink(NULL);
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+
+    CWpDatabase::WaypointDatabaseMap_t waypointMap;
+    waypointDb.getWpDatabase(waypointMap);
+    CPoiDatabase::POIDatabaseMap_t poiMap;
+    poiDb.getPoiDatabase(poiMap);
+    messages << waypointMap.size() << " waypoints, " << poiMap.size()
+             << " POIs";
+    result = messages.str();
+  }
+  return bestTime.count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  unsigned int maxThreads = (argc > 2) ? atoi(argv[2]) : DEFAULT_THREADS;
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::uniform_int_distribution<unsigned int> percent(0, 99);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  {
+    std::ofstream json(BENCH_FILE, std::ios::binary);
+    json.precision(17);
+    const char *arrays[] = {"waypoints", "pois"};
+    json << "{\n";
+    for (unsigned int array = 0; array < 2; array++)
+    {
+      unsigned int count = (0 == array) ? pois / 4 : pois;
+      json << "  \"" << arrays[array] << "\" : [\n";
+      for (unsigned int i = 0; i < count; i++)
+      {
+        /* One record in a hundred has a repeated attribute */
+        json << "    {\"name\" : \"" << arrays[array] << "_" << i << "\", "
+             << ((0 == percent(generator)) ? "\"name\" : \"again\", " : "")
+             << "\"latitude\" : " << latitude(generator)
+             << ", \"longitude\" : " << longitude(generator);
+        if (1 == array)
+        {
+          json << ", \"description\" : \"generated point of interest\", "
+                  "\"type\" : \"RESTAURANT\"";
+        }
+        json << "}" << ((i + 1 < count) ? ",\n" : "\n");
+      }
+      json << ((0 == array) ? "  ],\n" : "  ]\n");
+    }
+    json << "}\n";
+  }
+
+  std::string sequentialResult;
+  double sequentialTime = loadFile(1, sequentialResult);
+  std::cout << "readData on 1 thread:  " << sequentialTime * 1e3 << " ms"
+            << std::endl;
+  for (unsigned int threads = 2; threads <= maxThreads; threads *= 2)
+  {
+    std::string result;
+    double time = loadFile(threads, result);
+    std::cout << "readData on " << threads << " threads: " << time * 1e3
+              << " ms, " << sequentialTime / time << "x, "
+              << ((result == sequentialResult) ? "same" : "DIFFERENT")
+              << " records and messages" << std::endl;
+  }
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
@@ -0,0 +1,75 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonScanBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the token throughput of CJsonScanner on a
+*                   generated JSON file of POIs held in memory.
+*                   Usage: CJsonScanBench [pois]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <nsp/CJsonScanner.h>
+
+#define DEFAULT_POIS (500000) /**< @brief Number of generated POIs */
+#define RUNS (3)              /**< @brief Number of measured scans */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(3);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  std::ostringstream json;
+  json.precision(17);
+  json << "{\n  \"pois\" : [\n";
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    json << "    {\"name\" : \"poi_" << i << "\", \"latitude\" : "
+         << latitude(generator) << ", \"longitude\" : " << longitude(generator)
+         << ", \"description\" : \"generated point of interest\", "
+            "\"type\" : \"RESTAURANT\"}"
+         << ((i + 1 < pois) ? ",\n" : "\n");
+  }
+  json << "  ]\n}\n";
+  std::string contents = json.str();
+
+  std::chrono::duration<double> bestTime(0);
+  size_t tokens = 0, stringBytes = 0;
+  double numberSum = 0;
+  for (int run = 0; run < RUNS; run++)
+  {
+    std::istringstream input(contents);
+    APT::CJsonScanner scanner(input);
+    tokens = stringBytes = 0;
+    numberSum = 0;
+    benchClock_t::time_point start = benchClock_t::now();
+    APT::CJsonToken *pToken = NULL;
+    while (NULL != (pToken = scanner.nextToken()))
+    {
+      tokens++;
+      if (APT::CJsonToken::STRING == pToken->getType())
+        stringBytes += pToken->getString().size();
+      else if (APT::CJsonToken::NUMBER == pToken->getType())
+        numberSum += pToken->getNumber();
+    }
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+  }
+  std::cout << "Scanned " << tokens << " tokens (" << contents.size() / 1e6
+            << " MB) in " << bestTime.count() * 1e3 << " ms: "
+            << tokens / bestTime.count() / 1e6 << " M tokens/s, "
+            << contents.size() / bestTime.count() / 1e6 << " MB/s" << std::endl;
+  std::cout << "String bytes: " << stringBytes << ", number sum: " << numberSum
+            << std::endl;
+  return 0;
+}
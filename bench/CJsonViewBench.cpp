@@ -0,0 +1,136 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonViewBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the lazy load CJsonPersistence::readView
+*                   against readData on a generated JSON file of POIs, for
+*                   a job which only needs the coordinates (a bounding box)
+*                   and for one which also reads every name.
+*                   Usage: CJsonViewBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CJsonPersistence.h>
+#include <nsp/CJsonView.h>
+
+#define DEFAULT_POIS (1000000) /**< @brief Number of generated POIs */
+#define RUNS (3)               /**< @brief Number of measured loads */
+#define BENCH_MEDIA "CJsonViewBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+typedef enum {
+  READ_DATA_FLEX,  /**< readData with the flex scanner */
+  READ_DATA_INDEX, /**< readData with the index scanner */
+  READ_VIEW,       /**< readView, coordinates only */
+  READ_VIEW_NAMES  /**< readView, every name is materialized */
+} loadMode_t;
+
+/**
+ * Loads the file and computes the bounding box of the POIs, returns the
+ * best time of RUNS loads
+ * @param loadMode_t mode [IN] - How the file is loaded
+ * @param double& checksum [OUT] - The bounding box and name lengths
+ * @return double - The best time in seconds
+ */
+static double loadFile(loadMode_t mode, double &checksum)
+{
+  std::chrono::duration<double> bestTime(0);
+  for (int run = 0; run < RUNS; run++)
+  {
+    CJsonPersistence persistence;
+    persistence.setMediaName(BENCH_MEDIA);
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    CJsonView view;
+    double minLatitude = 90, maxLatitude = -90;
+    size_t nameLength = 0;
+    benchClock_t::time_point start = benchClock_t::now();
+    if ((READ_DATA_FLEX == mode) || (READ_DATA_INDEX == mode))
+    {
+      if (READ_DATA_INDEX == mode)
+        persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+      persistence.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+      for (CPoiDatabase::const_iterator itr = poiDb.begin();
+           itr != poiDb.end(); ++itr)
+      {
+        minLatitude = std::min(minLatitude, itr->second.getLatitude());
+        maxLatitude = std::max(maxLatitude, itr->second.getLatitude());
+      }
+    }
+    else
+    {
+      persistence.readView(view);
+      for (size_t i = 0; i < view.getPoiCount(); i++)
+      {
+        const CJsonView::record_t &record = view.getPoi(i);
+        minLatitude = std::min(minLatitude, record.latitude);
+        maxLatitude = std::max(maxLatitude, record.latitude);
+        if (READ_VIEW_NAMES == mode)
+          nameLength += view.getName(record).size();
+      }
+    }
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    checksum = minLatitude + maxLatitude + nameLength;
+    if ((0 == run) || (time < bestTime))
+      bestTime = time;
+  }
+  return bestTime.count();
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  {
+    std::ofstream json(BENCH_FILE, std::ios::binary);
+    /* Six decimals (about 0.1 m), as the positions of real POI data */
+    json.setf(std::ios::fixed);
+    json.precision(6);
+    json << "{\n  \"pois\" : [\n";
+    for (unsigned int i = 0; i < pois; i++)
+    {
+      json << "    {\"name\" : \"poi_" << i
+           << "\", \"latitude\" : " << latitude(generator)
+           << ", \"longitude\" : " << longitude(generator)
+           << ", \"description\" : \"generated point of interest\", "
+              "\"type\" : \"RESTAURANT\"}"
+           << ((i + 1 < pois) ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+  }
+
+  const char *names[] = {"readData FLEX_SCANNER: ", "readData INDEX_SCANNER:",
+                         "readView coordinates:  ", "readView with names:   "};
+  double flexTime = 0;
+  for (int mode = READ_DATA_FLEX; mode <= READ_VIEW_NAMES; mode++)
+  {
+    double checksum = 0;
+    double time = loadFile((loadMode_t)mode, checksum);
+    if (READ_DATA_FLEX == mode)
+      flexTime = time;
+    std::cout << names[mode] << " " << time * 1e3 << " ms, "
+              << flexTime / time << "x (checksum " << checksum << ")"
+              << std::endl;
+  }
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
@@ -0,0 +1,85 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonWriteBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of CJsonPersistence::writeData on generated
+*                   databases of growing size, reporting the throughput and
+*                   the growth of the peak memory while writing.
+*                   Usage: CJsonWriteBench [entries]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <nsp/CJsonPersistence.h>
+
+#define DEFAULT_ENTRIES (1000000) /**< @brief Entries of the largest run */
+#define BENCH_MEDIA "CJsonWriteBench" /**< @brief Name of the media */
+#define BENCH_FILE "myCode/" BENCH_MEDIA ".json" /**< @brief The file */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Gets the peak resident memory of the process
+ * @return long - The peak resident memory in kB
+ */
+static long getPeakMemory(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int entries = (argc > 1) ? atoi(argv[1]) : DEFAULT_ENTRIES;
+  std::mt19937 generator(9);
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0),
+      longitude(-180.0, 180.0);
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  CJsonPersistence persistence;
+  persistence.setMediaName(BENCH_MEDIA);
+
+  /* Each run doubles the databases, the peak memory of the process only
+   * grows while writing if the writer needs more than the last run */
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  unsigned int count = 0;
+  for (unsigned int size = entries / 8; size <= entries; size *= 2)
+  {
+    for (; count < size; count++)
+    {
+      wpDb.addWaypoint(CWaypoint(latitude(generator), longitude(generator),
+                                 "wp_" + std::to_string(count)));
+      poiDb.addPoi(CPOI((CPOI::t_poi)(count % 4),
+                        "poi_" + std::to_string(count),
+                        "generated \"point\" of interest",
+                        latitude(generator), longitude(generator)));
+    }
+    long memoryBefore = getPeakMemory();
+    benchClock_t::time_point start = benchClock_t::now();
+    bool isWritten = persistence.writeData(wpDb, poiDb);
+    std::chrono::duration<double> time = benchClock_t::now() - start;
+    struct stat fileStat;
+    stat(BENCH_FILE, &fileStat);
+    std::cout << 2 * size << " entries" << (isWritten ? "" : " (failed)")
+              << ": " << time.count() * 1e3 << " ms, "
+              << fileStat.st_size / 1e6 / time.count()
+              << " MB/s, peak memory +"
+              << (getPeakMemory() - memoryBefore) / 1024 << " MB" << std::endl;
+    if (0 == size)
+      break;
+  }
+  remove(BENCH_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
@@ -0,0 +1,141 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CMapMatcherBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the map matching of a simulated GPS trace
+*                   on a synthetic grid graph, in batch and online mode.
+*                   Usage: CMapMatcherBench [gridSide] [fixes]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <nsp/CMapMatcher.h>
+#include <nsp/CRoutingGraph.h>
+
+#include "BenchGraph.h"
+
+#define DEFAULT_GRID_SIDE (300)   /**< @brief 300 x 300 = 90k nodes */
+#define DEFAULT_FIXES (200000)    /**< @brief Number of simulated fixes */
+#define FIXES_PER_EDGE (3)        /**< @brief Fixes recorded per edge */
+#define GPS_NOISE_DEGREE (0.0001) /**< @brief Noise of a fix, about 10 m */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Drives a random walk over the grid without U-turns and records noisy
+ * fixes along the edges. The node at which a fix was recorded is kept as
+ * the ground truth, INVALID_NODE for fixes between two nodes.
+ */
+static void simulateTrace(unsigned int side, unsigned int fixes,
+                          std::vector<double> &latitudes,
+                          std::vector<double> &longitudes,
+                          std::vector<CRoutingGraph::node_t> &truth)
+{
+  std::mt19937 generator(3);
+  std::normal_distribution<double> noise(0.0, GPS_NOISE_DEGREE);
+  std::uniform_int_distribution<int> direction(0, 3);
+  const int rowStep[4] = {1, 0, -1, 0}, columnStep[4] = {0, 1, 0, -1};
+  int row = side / 2, column = side / 2, heading = 0;
+
+  while (latitudes.size() < fixes)
+  {
+    int next = direction(generator);
+    if ((next + 2) % 4 == heading)
+      continue; /* No U-turns */
+    int nextRow = row + rowStep[next], nextColumn = column + columnStep[next];
+    if ((nextRow < 0) || (nextColumn < 0) || (nextRow >= (int)side) ||
+        (nextColumn >= (int)side))
+      continue;
+    for (int i = 0; i < FIXES_PER_EDGE; i++)
+    {
+      double fraction = (double)i / FIXES_PER_EDGE;
+      latitudes.push_back(
+          GRID_ORIGIN_LATITUDE +
+          (row + fraction * rowStep[next]) * GRID_SPACING + noise(generator));
+      longitudes.push_back(GRID_ORIGIN_LONGITUDE +
+                           (column + fraction * columnStep[next]) *
+                               GRID_SPACING +
+                           noise(generator));
+      truth.push_back((0 == i) ? row * side + column
+                               : CRoutingGraph::INVALID_NODE);
+    }
+    row = nextRow;
+    column = nextColumn;
+    heading = next;
+  }
+}
+/**
+ * Counts the fixes recorded at a node which were matched to that node
+ */
+static double getAccuracy(const std::vector<CRoutingGraph::node_t> &truth,
+                          const std::vector<CRoutingGraph::node_t> &matched)
+{
+  unsigned int nodeFixes = 0, correct = 0;
+  for (size_t i = 0; (i < truth.size()) && (i < matched.size()); i++)
+  {
+    if (CRoutingGraph::INVALID_NODE != truth[i])
+    {
+      nodeFixes++;
+      correct += (truth[i] == matched[i]) ? 1 : 0;
+    }
+  }
+  return nodeFixes ? (100.0 * correct / nodeFixes) : 0;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned int side = (argc > 1) ? atoi(argv[1]) : DEFAULT_GRID_SIDE;
+  unsigned int fixes = (argc > 2) ? atoi(argv[2]) : DEFAULT_FIXES;
+
+  CRoutingGraph graph;
+  buildGridGraph(side, graph);
+  std::vector<double> latitudes, longitudes;
+  std::vector<CRoutingGraph::node_t> truth;
+  simulateTrace(side, fixes, latitudes, longitudes, truth);
+  std::cout << "Grid graph: " << graph.getNodeCount() << " nodes, trace: "
+            << latitudes.size() << " fixes" << std::endl;
+
+  CMapMatcher matcher(graph);
+  std::vector<CRoutingGraph::node_t> matched;
+
+  benchClock_t::time_point batchStart = benchClock_t::now();
+  matcher.match(latitudes.data(), longitudes.data(), latitudes.size(),
+                matched);
+  std::chrono::duration<double> batchTime = benchClock_t::now() - batchStart;
+  std::cout << "Batch:  " << latitudes.size() / batchTime.count()
+            << " fixes/s, accuracy at nodes: " << getAccuracy(truth, matched)
+            << " %" << std::endl;
+
+  std::vector<CRoutingGraph::node_t> online;
+  online.reserve(latitudes.size());
+  size_t pendingSum = 0, maxPending = 0;
+  CRoutingGraph::node_t node;
+  benchClock_t::time_point onlineStart = benchClock_t::now();
+  for (size_t i = 0; i < latitudes.size(); i++)
+  {
+    matcher.addFix(latitudes[i], longitudes[i]);
+    while (matcher.getMatch(node))
+    {
+      online.push_back(node);
+    }
+    pendingSum += matcher.getPendingFixCount();
+    maxPending = std::max(maxPending, matcher.getPendingFixCount());
+  }
+  matcher.flush();
+  while (matcher.getMatch(node))
+  {
+    online.push_back(node);
+  }
+  std::chrono::duration<double> onlineTime =
+      benchClock_t::now() - onlineStart;
+  std::cout << "Online: " << latitudes.size() / onlineTime.count()
+            << " fixes/s, accuracy at nodes: " << getAccuracy(truth, online)
+            << " %, mean/max pending fixes: "
+            << (double)pendingSum / latitudes.size() << "/" << maxPending
+            << std::endl;
+  return 0;
+}
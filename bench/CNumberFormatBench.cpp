@@ -0,0 +1,115 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CNumberFormatBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of formatting coordinates with
+*                   type_mapping::formatDouble() against a stringstream per
+*                   number, and of writing a generated POI file with CCSV.
+*                   Usage: CNumberFormatBench [numbers] [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nsp/CCSV.h>
+#include <nsp/TypeMapping.h>
+
+#define DEFAULT_NUMBERS (10000000) /**< @brief Number of formatted numbers */
+#define DEFAULT_POIS (1000000)     /**< @brief Number of written POIs */
+#define DISTINCT_NUMBERS (4096)    /**< @brief Number of generated numbers */
+#define BENCH_MEDIA "CNumberFormatBench" /**< @brief Media of the files */
+#define BENCH_WP_FILE "src/" BENCH_MEDIA "-wp.txt"
+#define BENCH_POI_FILE "src/" BENCH_MEDIA "-poi.txt"
+
+typedef std::chrono::steady_clock benchClock_t;
+
+int main(int argc, char *argv[])
+{
+  unsigned int numbers = (argc > 1) ? atoi(argv[1]) : DEFAULT_NUMBERS;
+  unsigned int pois = (argc > 2) ? atoi(argv[2]) : DEFAULT_POIS;
+
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> coordinate(-180.0, 180.0);
+  std::vector<double> values;
+  for (unsigned int i = 0; i < DISTINCT_NUMBERS; i++)
+  {
+    values.push_back(coordinate(generator));
+  }
+
+  /* As the stream formatting did before formatDouble(): one stringstream
+   * per number */
+  size_t streamLength = 0;
+  benchClock_t::time_point streamStart = benchClock_t::now();
+  for (unsigned int i = 0; i < numbers; i++)
+  {
+    std::stringstream ss;
+    ss << values[i % DISTINCT_NUMBERS];
+    streamLength += ss.str().length();
+  }
+  std::chrono::duration<double> streamTime =
+      benchClock_t::now() - streamStart;
+  std::cout << "stringstream (6 digits):  " << numbers / streamTime.count()
+            << " numbers/s" << std::endl;
+
+  char buffer[MAX_DOUBLE_TEXT_LENGTH];
+  size_t length = 0, mismatches = 0;
+  benchClock_t::time_point start = benchClock_t::now();
+  for (unsigned int i = 0; i < numbers; i++)
+  {
+    length += type_mapping::formatDouble(values[i % DISTINCT_NUMBERS], buffer,
+                                         sizeof(buffer));
+  }
+  std::chrono::duration<double> time = benchClock_t::now() - start;
+  std::cout << "formatDouble (round trip): " << numbers / time.count()
+            << " numbers/s, " << streamTime.count() / time.count()
+            << "x faster, " << (double)length / numbers << " characters"
+            << std::endl;
+
+  /* Every formatted number has to parse back to the same double */
+  for (unsigned int i = 0; i < DISTINCT_NUMBERS; i++)
+  {
+    double number = 0;
+    size_t numberLength =
+        type_mapping::formatDouble(values[i], buffer, sizeof(buffer));
+    if (!type_mapping::convertStringToDouble(
+            std::string_view(buffer, numberLength), number) ||
+        (number != values[i]))
+    {
+      mismatches++;
+    }
+  }
+
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  std::uniform_real_distribution<double> latitude(-80.0, 80.0);
+  for (unsigned int i = 0; i < pois; i++)
+  {
+    poiDb.addPoi(CPOI(CPOI::RESTAURANT, "poi_" + std::to_string(i),
+                      "generated point of interest", latitude(generator),
+                      coordinate(generator)));
+  }
+  CCSV csv;
+  csv.setMediaName(BENCH_MEDIA);
+  benchClock_t::time_point writeStart = benchClock_t::now();
+  csv.writeData(wpDb, poiDb);
+  std::chrono::duration<double> writeTime = benchClock_t::now() - writeStart;
+  std::cout << "CCSV::writeData(): " << pois / writeTime.count() << " POIs/s"
+            << std::endl;
+  remove(BENCH_WP_FILE);
+  remove(BENCH_POI_FILE);
+
+  if (0 != mismatches)
+  {
+    std::cout << "ERROR! " << mismatches << " numbers are not read back"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
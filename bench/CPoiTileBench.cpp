@@ -0,0 +1,184 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CPoiTileBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the tiled lazy loading of POIs: the startup
+*                   time and the memory of reading a whole compact file
+*                   against opening the tiled file and loading the area of
+*                   one city, then panning over many cities under a memory
+*                   limit. Each mode runs in its own process, so that its
+*                   memory is measured alone.
+*                   Usage: CPoiTileBench [pois]
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nsp/CCompactPersistence.h>
+#include <nsp/CPoiTileStore.h>
+
+#define DEFAULT_POIS (2000000) /**< @brief Number of generated POIs */
+#define CITIES (500)           /**< @brief Number of POI clusters */
+#define PANS (1000)            /**< @brief Number of areas of the panning */
+#define PAN_MEMORY \
+  (32 * 1024 * 1024) /**< @brief Memory limit of the panning */
+#define BENCH_MEDIA "CPoiTileBench" /**< @brief Name of the media */
+#define COMPACT_FILE "myCode/" BENCH_MEDIA ".nspc" /**< @brief Whole file */
+#define TILE_FILE "myCode/" BENCH_MEDIA "-tiles.nspc" /**< @brief Tiles */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+/**
+ * Gets the seconds since a start time
+ */
+static double getSeconds(benchClock_t::time_point start)
+{
+  return std::chrono::duration<double>(benchClock_t::now() - start).count();
+}
+
+/**
+ * Gets the maximum resident memory of the process in MB
+ */
+static double getMaxResident(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024.0;
+}
+
+/**
+ * Gets the centres of the POI clusters, the same in every process
+ */
+static void getCities(std::mt19937 &generator,
+                      std::vector<std::pair<double, double> > &cities)
+{
+  std::uniform_real_distribution<double> cityLatitude(-60.0, 70.0),
+      cityLongitude(-180.0, 180.0);
+  for (int i = 0; i < CITIES; i++)
+  {
+    cities.push_back(
+        std::make_pair(cityLatitude(generator), cityLongitude(generator)));
+  }
+}
+
+/**
+ * Reads every POI of the compact file
+ */
+static void runFull(void)
+{
+  benchClock_t::time_point start = benchClock_t::now();
+  CCompactPersistence compact;
+  CWpDatabase waypointDb;
+  CPoiDatabase poiDb;
+  compact.setMediaName(BENCH_MEDIA);
+  compact.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+  double loadTime = getSeconds(start);
+  std::cout << "whole file, readData:  " << std::setw(9) << loadTime * 1e3
+            << " ms startup, " << std::setw(8) << poiDb.size() << " POIs, "
+            << std::setw(8) << getMaxResident() << " MB max resident"
+            << std::endl;
+}
+
+/**
+ * Loads the area of one city, then pans over random cities
+ */
+static void runTiles(void)
+{
+  std::mt19937 generator(13);
+  std::vector<std::pair<double, double> > cities;
+  getCities(generator, cities);
+  benchClock_t::time_point start = benchClock_t::now();
+  CPoiDatabase poiDb;
+  poiDb.openTiles(TILE_FILE, PAN_MEMORY);
+  const std::pair<double, double> &city = cities[0];
+  poiDb.loadArea(city.first - 0.5, city.second - 0.5, city.first + 0.5,
+                 city.second + 0.5);
+  double loadTime = getSeconds(start);
+  std::cout << "tiles, one city:       " << std::setw(9) << loadTime * 1e3
+            << " ms startup, " << std::setw(8) << poiDb.size() << " POIs, "
+            << std::setw(8) << getMaxResident() << " MB max resident"
+            << std::endl;
+
+  std::uniform_int_distribution<int> anyCity(0, CITIES - 1);
+  start = benchClock_t::now();
+  for (int i = 0; i < PANS; i++)
+  {
+    const std::pair<double, double> &pan = cities[anyCity(generator)];
+    poiDb.loadArea(pan.first - 0.25, pan.second - 0.25, pan.first + 0.25,
+                   pan.second + 0.25);
+  }
+  double panTime = getSeconds(start);
+  std::cout << "tiles, " << PANS << " pans:     " << std::setw(9)
+            << panTime / PANS * 1e3 << " ms/area,  " << std::setw(8)
+            << poiDb.size() << " POIs, " << std::setw(8)
+            << getMaxResident() << " MB max resident, "
+            << poiDb.getLoadedTileCount() << " tiles of "
+            << poiDb.getTileMemory() / 1048576.0 << " MB" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  std::cout << std::fixed << std::setprecision(2);
+  if ((argc > 1) && (0 == strcmp(argv[1], "--full")))
+  {
+    runFull();
+    return 0;
+  }
+  if ((argc > 1) && (0 == strcmp(argv[1], "--tiles")))
+  {
+    runTiles();
+    return 0;
+  }
+  unsigned int pois = (argc > 1) ? atoi(argv[1]) : DEFAULT_POIS;
+  std::mt19937 generator(13);
+  std::vector<std::pair<double, double> > cities;
+  getCities(generator, cities);
+  std::normal_distribution<double> offset(0.0, 0.05);
+
+  bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+  {
+    CWpDatabase waypointDb;
+    CPoiDatabase poiDb;
+    for (unsigned int i = 0; i < pois; i++)
+    {
+      const std::pair<double, double> &city = cities[i % CITIES];
+      poiDb.addPoi(CPOI((CPOI::t_poi)(i % CPOI::UNKNOWN),
+                        "poi_" + std::to_string(i),
+                        "generated point of interest",
+                        city.first + offset(generator),
+                        city.second + offset(generator)));
+    }
+    CCompactPersistence compact;
+    compact.setMediaName(BENCH_MEDIA);
+    compact.writeData(waypointDb, poiDb);
+    benchClock_t::time_point start = benchClock_t::now();
+    CPoiTileStore::writeTiles(TILE_FILE, poiDb);
+    std::cout << "writeTiles:            " << std::setw(9)
+              << getSeconds(start) * 1e3 << " ms" << std::endl;
+  }
+
+  std::string command(argv[0]);
+  if (0 != system((command + " --full").c_str()) ||
+      0 != system((command + " --tiles").c_str()))
+  {
+    std::cout << "Unable to run " << command << std::endl;
+  }
+
+  remove(COMPACT_FILE);
+  remove(TILE_FILE);
+  if (isDirectoryCreated)
+    rmdir("myCode");
+  return 0;
+}
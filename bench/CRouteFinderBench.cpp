@@ -0,0 +1,72 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CRouteFinderBench.cpp
+* Author          : Jishnu M Thampan
+* Description     : Benchmark of the A* route queries on a synthetic grid
+*                   graph.
+*                   Usage: CRouteFinderBench [gridSide] [queries]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <nsp/CRouteFinder.h>
+#include <nsp/CRoutingGraph.h>
+
+#include "BenchGraph.h"
+
+#define DEFAULT_GRID_SIDE (1000)  /**< @brief 1000 x 1000 = 1M nodes */
+#define DEFAULT_QUERIES (100)     /**< @brief Number of timed queries */
+
+typedef std::chrono::steady_clock benchClock_t;
+
+int main(int argc, char *argv[])
+{
+  unsigned int side = (argc > 1) ? atoi(argv[1]) : DEFAULT_GRID_SIDE;
+  unsigned int queries = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+
+  CRoutingGraph graph;
+  benchClock_t::time_point buildStart = benchClock_t::now();
+  buildGridGraph(side, graph);
+  std::chrono::duration<double> buildTime = benchClock_t::now() - buildStart;
+
+  std::cout << "Grid graph: " << graph.getNodeCount() << " nodes, "
+            << graph.getEdgeCount() << " edges, built in "
+            << buildTime.count() << " s" << std::endl;
+
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<CRoutingGraph::node_t> randomNode(
+      0, graph.getNodeCount() - 1);
+  CRouteFinder finder(graph);
+  std::vector<CRoutingGraph::node_t> path;
+  unsigned long long settledNodes = 0;
+  unsigned int foundPaths = 0;
+  double totalLength = 0;
+
+  benchClock_t::time_point queryStart = benchClock_t::now();
+  for (unsigned int i = 0; i < queries; i++)
+  {
+    double distance = 0;
+    if (finder.findPath(randomNode(generator), randomNode(generator), path,
+                        distance))
+    {
+      foundPaths++;
+      totalLength += distance;
+    }
+    settledNodes += finder.getSettledNodeCount();
+  }
+  std::chrono::duration<double> queryTime = benchClock_t::now() - queryStart;
+
+  std::cout << "A* queries: " << queries << " (" << foundPaths
+            << " paths found) in " << queryTime.count() << " s" << std::endl;
+  std::cout << "Throughput: " << queries / queryTime.count()
+            << " queries/s, mean settled nodes: "
+            << (queries ? settledNodes / queries : 0)
+            << ", mean path length: "
+            << (foundPaths ? totalLength / foundPaths : 0) << " km"
+            << std::endl;
+  return 0;
+}
@@ -9,13 +9,20 @@
 #define CATTRIBUTE_EXTRACTOR_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
  * CAttributeExtractor is a utility class which
  * extracts the contents from a file based on the
  * configured delimit characters and the maximum
- * attributes allowed per line
+ * attributes allowed per line.
+ *
+ * The text is split in a single pass: blocks of 16 bytes (SSE2) or 32 bytes
+ * (AVX2) are compared against every delimiter at once and the attributes
+ * are emitted at the set bits of the resulting mask. Extracting keeps no
+ * state in the extractor, so one configured extractor can split lines on
+ * several threads.
  */
 class CAttributeExtractor {
 
@@ -34,11 +41,11 @@ private:
                                   attributes in the text */
 
   /**
-       * Gets the closes Delimiter Positon within the input text
-       * @param  const std::string& line [IN] - Input text
-       * @return size_t - Position of the closest delimiter
-       */
-  size_t getClosestDelimiterPos(const std::string &line);
+   * Checks if the character is one of the delimiters
+   * @param char character [IN] - The character to be checked
+   * @return true if it is a delimiter, false otherwise
+   */
+  bool isDelimiter(char character) const;
   /**
        * Gets the delimiter count
        * @param None
@@ -79,6 +86,17 @@ public:
        */
   RC_t extractAttributes(const std::string &line,
                          std::vector<std::string> &attributeVec);
+  /**
+   * Splits the text in a single pass into views of the attributes. The
+   * views point into the text, so nothing is copied. The split stops at the
+   * first delimiter beyond the max attributes.
+   * @param std::string_view line [IN] - The text to be extracted
+   * @param std::vector<std::string_view>& attributeVec [OUT] - Views of the
+   * attributes, cleared first so that it can be reused for every line
+   * @return RC_t - the error code after extraction
+   */
+  RC_t extractAttributes(std::string_view line,
+                         std::vector<std::string_view> &attributeVec);
   /**
        * Prints the content of WP Database
        * @param RC_t& ec[IN] - Reference to the error code to be converted to
@@ -0,0 +1,160 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBPlusTree.H
+* Author          : Jishnu M Thampan
+* Description     : class CBPlusTree
+*                   A B+tree of byte string keys and values in the pages of
+*                   a CBufferPool.
+****************************************************************************/
+#ifndef CBPLUS_TREE_H
+#define CBPLUS_TREE_H
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "CBufferPool.h"
+
+#define MAX_ENTRY_SIZE \
+  (1000) /**< @brief Represents the largest key and value together, so
+            that a split page always holds its half */
+
+/**
+ * CBPlusTree keeps its entries in the order of their keys, compared
+ * bytewise like memcmp. The entries are in the leaf pages, which are
+ * linked in key order for range scans. The inner pages hold the first key
+ * of each child after the first, so a lookup reads one page per level.
+ *
+ * A page is a slotted page: a header, an array of 2 byte cell offsets in
+ * key order and the cells, which grow from the end of the page towards
+ * the offsets. A full page is split into two pages of about half the
+ * bytes each. Removed entries free space in their page, pages are not
+ * merged, so the tree does not shrink until the file is truncated.
+ *
+ * Several trees can share one pool, each with its own meta page which
+ * holds the root, the height and the number of entries. The meta page is
+ * written by flush().
+ */
+class CBPlusTree {
+public:
+  /**
+   * Represents the result of an insert
+   */
+  typedef enum {
+    INSERTED = 0, /**< \brief Represents a new entry */
+    REPLACED,     /**< \brief Represents a replaced value */
+    DUPLICATE,    /**< \brief Represents a key which is present */
+    FAILED        /**< \brief Represents a too large entry or a failed page */
+  } status_t;
+  /**
+   * Visits an entry of a scan, the key and value are valid during the
+   * call. The tree must not be changed during a scan.
+   * @return true to continue the scan, false to stop it
+   */
+  typedef std::function<bool(std::string_view key, std::string_view value)>
+      visitor_t;
+
+private:
+  typedef struct {
+    bool isSplit;      /**< \brief Represents a child which was split */
+    std::string key;   /**< \brief Represents the first key of the right
+                          page */
+    uint32_t pageId;   /**< \brief Represents the right page */
+  } split_t;
+
+  CBufferPool *m_pPool; /**< \brief Represents the pages */
+  uint32_t m_metaPage;  /**< \brief Represents the meta page of the tree */
+  uint32_t m_rootPage;  /**< \brief Represents the root page */
+  uint32_t m_height;    /**< \brief Represents the levels, 1 for a leaf */
+  uint64_t m_count;     /**< \brief Represents the number of entries */
+
+  /**
+   * Inserts an entry below a page, splitting the pages which are full
+   * @param uint32_t pageId [IN] - The page
+   * @param std::string_view key, value [IN] - The entry
+   * @param bool isReplacing [IN] - Replaces the value of a present key
+   * @param split_t& split [OUT] - The split of the page
+   * @return status_t - The result
+   */
+  status_t insertBelow(uint32_t pageId, std::string_view key,
+                       std::string_view value, bool isReplacing,
+                       split_t &split);
+  /**
+   * Gets the leaf page which holds a key, or would hold it
+   * @param std::string_view key [IN] - The key
+   * @param uint32_t& pageId [OUT] - The leaf page
+   * @return true if every page could be read, false otherwise
+   */
+  bool findLeaf(std::string_view key, uint32_t &pageId) const;
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBPlusTree(CBPlusTree &);
+  CBPlusTree &operator=(CBPlusTree &);
+
+public:
+  CBPlusTree();
+  /**
+   * Opens the tree of a meta page. A zeroed meta page, as it is created
+   * by CBufferPool::newPage(), gets an empty tree.
+   * @param CBufferPool& pool [IN] - The pool, it must stay open while the
+   * tree is used
+   * @param uint32_t metaPage [IN] - The meta page
+   * @return true if the meta page holds a tree, false otherwise
+   */
+  bool open(CBufferPool &pool, uint32_t metaPage);
+  /**
+   * Writes the root, the height and the number of entries to the meta page
+   * @param None
+   * @return true if the meta page could be written, false otherwise
+   */
+  bool flush(void);
+  /**
+   * Inserts an entry
+   * @param std::string_view key [IN] - The key
+   * @param std::string_view value [IN] - The value
+   * @param bool isReplacing [IN] - Replaces the value of a present key
+   * @return status_t - The result, FAILED if key and value have more than
+   * MAX_ENTRY_SIZE bytes
+   */
+  status_t insert(std::string_view key, std::string_view value,
+                  bool isReplacing);
+  /**
+   * Finds the value of a key
+   * @param std::string_view key [IN] - The key
+   * @param std::string& value [OUT] - The value
+   * @return true if the key is present, false otherwise
+   */
+  bool find(std::string_view key, std::string &value) const;
+  /**
+   * Removes an entry
+   * @param std::string_view key [IN] - The key
+   * @return true if the key was present, false otherwise
+   */
+  bool erase(std::string_view key);
+  /**
+   * Visits the entries from a key up to another in key order
+   * @param std::string_view from [IN] - The first key
+   * @param std::string_view to [IN] - The key after the last, empty for
+   * the end of the tree
+   * @param const visitor_t& visitor [IN] - Called for each entry
+   * @return true if every page could be read, false otherwise
+   */
+  bool scan(std::string_view from, std::string_view to,
+            const visitor_t &visitor) const;
+  /**
+   * Gets the number of entries
+   */
+  uint64_t size(void) const { return m_count; }
+  /**
+   * Gets the number of levels, 1 for a tree of one leaf
+   */
+  uint32_t getHeight(void) const { return m_height; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBPLUS_TREE_H
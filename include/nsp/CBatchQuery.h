@@ -0,0 +1,121 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBatchQuery.H
+* Author          : Jishnu M Thampan
+* Description     : class CBatchQuery
+*                   Answers large arrays of nearest-POI and route distance
+*                   queries on the workers of a CThreadPool.
+****************************************************************************/
+#ifndef CBATCH_QUERY_H
+#define CBATCH_QUERY_H
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "CContractionHierarchy.h"
+#include "CHierarchyRouteFinder.h"
+#include "CSpatialGrid.h"
+#include "CThreadPool.h"
+
+/**
+ * CBatchQuery cuts a batch of queries into blocks which are executed by the
+ * workers of a thread pool. Idle workers steal blocks, so the load stays
+ * balanced when some queries take much longer than others. The results are
+ * written into arrays which the caller has allocated, result i belongs to
+ * query i. Every batch reports its throughput and latency distribution.
+ *
+ * A CBatchQuery object keeps one route finder per worker and must only be
+ * used by one thread at a time.
+ */
+class CBatchQuery {
+public:
+  typedef CContractionHierarchy::node_t node_t;
+
+  typedef struct {
+    size_t queryCount;       /**< \brief Represents the queries of the batch */
+    double elapsedSeconds;   /**< \brief Represents the wall clock time */
+    double queriesPerSecond; /**< \brief Represents the throughput */
+    double meanLatencyUs; /**< \brief Represents the mean query latency */
+    double p50LatencyUs;  /**< \brief Represents the median query latency */
+    double p99LatencyUs;  /**< \brief Represents the 99th percentile */
+    double maxLatencyUs;  /**< \brief Represents the slowest query */
+  } batchStats_t;         /**< \brief Represents the statistics of a batch */
+
+private:
+  CThreadPool *m_pPool; /**< \brief Represents the pool running the queries */
+  std::vector<double>
+      m_latencies; /**< \brief Represents the latency of each query in us */
+  const CContractionHierarchy *m_pFinderHierarchy; /**< \brief Represents
+                                                      the hierarchy of the
+                                                      route finders */
+  std::vector<CHierarchyRouteFinder *>
+      m_routeFinders; /**< \brief Represents the route finder of each
+                         worker */
+
+  /**
+   * Fills the statistics from the latencies of the last batch
+   * @param size_t count [IN] - Number of queries
+   * @param double elapsedSeconds [IN] - Wall clock time of the batch
+   * @param batchStats_t& stats [OUT] - The statistics
+   * @return None
+   */
+  void computeStats(size_t count, double elapsedSeconds,
+                    batchStats_t &stats);
+  /**
+   * Deletes the route finders
+   * @param None
+   * @return None
+   */
+  void releaseRouteFinders(void);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBatchQuery(CBatchQuery &);
+  CBatchQuery &operator=(CBatchQuery &);
+
+public:
+  /**
+   * Constructor of CBatchQuery class
+   * @param CThreadPool& pool [IN] - The pool which runs the queries. It must
+   * outlive the CBatchQuery object.
+   */
+  CBatchQuery(CThreadPool &pool);
+  ~CBatchQuery();
+  /**
+   * Searches the nearest POI of every position
+   * @param const CSpatialGrid& grid [IN] - The POI index
+   * @param const double* latitudes [IN] - Latitudes of the positions
+   * @param const double* longitudes [IN] - Longitudes of the positions
+   * @param size_t count [IN] - Number of positions
+   * @param const CPOI** pois [OUT] - The nearest POI of each position, NULL
+   * if the grid is empty
+   * @param double* distances [OUT] - The distances in kilometers
+   * @param batchStats_t& stats [OUT] - Statistics of the batch
+   * @return None
+   */
+  void findNearestPois(const CSpatialGrid &grid, const double *latitudes,
+                       const double *longitudes, size_t count,
+                       const CPOI **pois, double *distances,
+                       batchStats_t &stats);
+  /**
+   * Searches the shortest path length of every source/target pair
+   * @param const CContractionHierarchy& hierarchy [IN] - The road network
+   * @param const node_t* sources [IN] - Start nodes
+   * @param const node_t* targets [IN] - Destination nodes
+   * @param size_t count [IN] - Number of pairs
+   * @param double* distances [OUT] - The lengths in kilometers, HUGE_VAL if
+   * the target cannot be reached
+   * @param batchStats_t& stats [OUT] - Statistics of the batch
+   * @return None
+   */
+  void findRouteDistances(const CContractionHierarchy &hierarchy,
+                          const node_t *sources, const node_t *targets,
+                          size_t count, double *distances,
+                          batchStats_t &stats);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBATCH_QUERY_H
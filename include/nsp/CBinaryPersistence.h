@@ -0,0 +1,91 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBinaryPersistence.H
+* Author          : Jishnu M Thampan
+* Description     : class CBinaryPersistence
+*                   Persistent storage which writes the Databases as a
+*                   binary snapshot that is read by mapping it.
+****************************************************************************/
+#ifndef CBINARY_PERSISTENCE_H
+#define CBINARY_PERSISTENCE_H
+
+#include <string>
+#include <vector>
+
+#include "CBinarySnapshot.h"
+#include "CPersistentStorage.h"
+#include "CPoiDatabase.h"
+#include "CWpDatabase.h"
+
+/**
+ * CBinaryPersistence stores the Databases in one snapshot file,
+ * myCode/<name>.bin, in the layout described by CBinarySnapshot: columns of
+ * the coordinates and the POI types, a string heap and a hash index of the
+ * names. The entries are written in the order of the names.
+ *
+ * readSnapshot() maps the file without parsing it, which takes the same time
+ * for any number of entries. readData() checks the checksums and copies the
+ * entries into the Databases.
+ */
+class CBinaryPersistence : public CPersistentStorage {
+private:
+  std::string m_fileName; /**< \brief Represents the snapshot file name
+                             (with path) */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBinaryPersistence(CBinaryPersistence &);
+  CBinaryPersistence &operator=(CBinaryPersistence &);
+
+public:
+  CBinaryPersistence() {}
+  virtual ~CBinaryPersistence() {}
+  /**
+   * Set the name of the media to be used for persistent storage.
+   * The exact interpretation of the name depends on the implementation
+   * of the component.
+   *
+   * @param name the media to be used
+   */
+  void setMediaName(std::string name);
+  /**
+   * Get the files of the media which writeData() replaces
+   *
+   * @param fileNames the names of the files (with path)
+   */
+  void getMediaFiles(std::vector<std::string> &fileNames) const;
+  /**
+   * Write the data to the persistent storage.
+   *
+   * @param waypointDb the data base with way points
+   * @param poiDb the database with points of interest
+   * @return true if the data could be saved successfully
+   */
+  bool writeData(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb);
+  /**
+   * Fill the databases with the data from persistent storage. If
+   * merge mode is MERGE, the content in the persistent storage
+   * will be merged with any content already existing in the data
+   * bases. If merge mode is REPLACE, already existing content
+   * will be removed before inserting the content from the persistent
+   * storage.
+   *
+   * @param waypointDb the the data base with way points
+   * @param poiDb the database with points of interest
+   * @param mode the merge mode
+   * @return true if the data could be read successfully
+   */
+  bool readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb, MergeMode mode);
+  /**
+   * Maps the snapshot file into the snapshot, nothing is copied. The
+   * checksums are not checked, see CBinarySnapshot::verify().
+   * @param CBinarySnapshot& snapshot [OUT] - The snapshot
+   * @return true if the file is a complete snapshot, false otherwise
+   */
+  bool readSnapshot(CBinarySnapshot &snapshot);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBINARY_PERSISTENCE_H
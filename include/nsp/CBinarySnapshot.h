@@ -0,0 +1,228 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBinarySnapshot.H
+* Author          : Jishnu M Thampan
+* Description     : class CBinarySnapshot
+*                   Read-only view of a mapped binary snapshot of the
+*                   waypoints and POIs, written by CBinaryPersistence.
+****************************************************************************/
+#ifndef CBINARY_SNAPSHOT_H
+#define CBINARY_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include "CMappedFile.h"
+#include "CPOI.h"
+#include "CWaypoint.h"
+
+/**
+ * CBinarySnapshot maps a snapshot file and reads it in place, nothing is
+ * parsed or copied when it is opened. The file is little-endian and every
+ * section starts at a multiple of 8 bytes:
+ *
+ * header  - magic, version
+ * per table (waypoints, POIs), in the order of section_t:
+ *   latitudes, longitudes      - double[count]
+ *   types                      - uint8_t[count] (CPOI::t_poi), POIs only
+ *   name, description offsets  - uint64_t[count + 1] into the string heap,
+ *                                descriptions for POIs only
+ *   name index                 - uint32_t[slots] open addressing hash of the
+ *                                names, a slot holds index + 1 or 0
+ * string heap                  - the names and descriptions, not terminated
+ * trailer                      - magic, version, counts, the offset, size
+ *                                and CRC-32 of every section and the CRC-32
+ *                                of the trailer
+ *
+ * The trailer is written last, so a file which was not completely written
+ * is not opened. open() only checks the header, the trailer and the bounds
+ * of the sections; the checksums of the sections are checked by verify(),
+ * which reads the whole file.
+ */
+class CBinarySnapshot {
+public:
+  typedef enum {
+    WAYPOINT_TABLE = 0, /**< \brief Represents the waypoints */
+    POI_TABLE,          /**< \brief Represents the POIs */
+    TABLE_COUNT         /**< \brief Represents the number of tables */
+  } table_t;
+
+  typedef enum {
+    LATITUDES = 0,        /**< \brief Represents the latitudes */
+    LONGITUDES,           /**< \brief Represents the longitudes */
+    TYPES,                /**< \brief Represents the POI types */
+    NAME_OFFSETS,         /**< \brief Represents the name offsets */
+    DESCRIPTION_OFFSETS,  /**< \brief Represents the description offsets */
+    NAME_INDEX,           /**< \brief Represents the name hash index */
+    TABLE_SECTION_COUNT   /**< \brief Represents the sections of a table */
+  } section_t;
+
+  typedef struct {
+    uint64_t offset;   /**< \brief Represents the start in the file */
+    uint64_t size;     /**< \brief Represents the size in bytes */
+    uint32_t checksum; /**< \brief Represents the CRC-32 of the section */
+    uint32_t reserved; /**< \brief Represents the padding, 0 */
+  } sectionEntry_t;
+
+  /**
+   * Represents the sections of the tables followed by the string heap
+   */
+  static const size_t SECTION_COUNT = TABLE_COUNT * TABLE_SECTION_COUNT + 1;
+  static const size_t STRING_HEAP = SECTION_COUNT - 1;
+
+  typedef struct {
+    uint32_t magic;   /**< \brief Represents the file type, SNAPSHOT_MAGIC */
+    uint32_t version; /**< \brief Represents the format, SNAPSHOT_VERSION */
+  } header_t;
+
+  typedef struct {
+    uint32_t magic;   /**< \brief Represents the file type, SNAPSHOT_MAGIC */
+    uint32_t version; /**< \brief Represents the format, SNAPSHOT_VERSION */
+    uint64_t counts[TABLE_COUNT]; /**< \brief Represents the entries of the
+                                     tables */
+    uint64_t slots[TABLE_COUNT];  /**< \brief Represents the slots of the
+                                     name indexes, a power of 2 */
+    sectionEntry_t sections[SECTION_COUNT]; /**< \brief Represents the
+                                               sections */
+    uint32_t reserved; /**< \brief Represents the padding, 0 */
+    uint32_t checksum; /**< \brief Represents the CRC-32 of the trailer up
+                          to this field */
+  } trailer_t;
+
+  static const uint32_t SNAPSHOT_MAGIC = 0x504e534e; /**< "NSNP" */
+  static const uint32_t SNAPSHOT_VERSION = 1;
+
+private:
+  CMappedFile m_file; /**< \brief Represents the mapped snapshot */
+  const trailer_t *m_pTrailer; /**< \brief Represents the trailer in the
+                                  file, NULL if no file is open */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBinarySnapshot(CBinarySnapshot &);
+  CBinarySnapshot &operator=(CBinarySnapshot &);
+
+  /**
+   * Gets the start of a section in the mapped file
+   */
+  const char *getSection(table_t table, section_t section) const
+  {
+    return m_file.getData() +
+           m_pTrailer->sections[table * TABLE_SECTION_COUNT + section].offset;
+  }
+  /**
+   * Gets the string between two offsets of an offset section
+   * @param table_t table [IN] - The table
+   * @param section_t section [IN] - NAME_OFFSETS or DESCRIPTION_OFFSETS
+   * @param size_t index [IN] - Index of the entry
+   * @return std::string_view - The string, empty if the offsets are invalid
+   */
+  std::string_view getString(table_t table, section_t section,
+                             size_t index) const;
+
+public:
+  CBinarySnapshot() : m_pTrailer(NULL) {}
+  /**
+   * Maps the snapshot and checks its header, its trailer and the bounds of
+   * its sections. The time does not depend on the size of the file.
+   * @param const std::string& fileName [IN] - Name of the snapshot file
+   * @return true if the file is a complete snapshot, false otherwise
+   */
+  bool open(const std::string &fileName);
+  /**
+   * Releases the mapping
+   * @param None
+   * @return None
+   */
+  void close(void);
+  bool isOpen(void) const { return (NULL != m_pTrailer); }
+  /**
+   * Checks the checksums of the sections and that the string offsets are
+   * ascending. Reads the whole file.
+   * @param None
+   * @return true if the snapshot is intact, false otherwise
+   */
+  bool verify(void) const;
+
+  size_t getCount(table_t table) const
+  {
+    return isOpen() ? m_pTrailer->counts[table] : 0;
+  }
+  /**
+   * Gets a column of a table, the arrays hold getCount() values and are
+   * valid while the file is mapped
+   */
+  const double *getLatitudes(table_t table) const
+  {
+    return reinterpret_cast<const double *>(getSection(table, LATITUDES));
+  }
+  const double *getLongitudes(table_t table) const
+  {
+    return reinterpret_cast<const double *>(getSection(table, LONGITUDES));
+  }
+  /**
+   * Gets the types of the POIs as CPOI::t_poi values
+   */
+  const uint8_t *getPoiTypes(void) const
+  {
+    return reinterpret_cast<const uint8_t *>(getSection(POI_TABLE, TYPES));
+  }
+  /**
+   * Gets the name or the description of an entry as a view into the file,
+   * without copying it. The entries are in the order of the names.
+   * @param table_t table [IN] - The table
+   * @param size_t index [IN] - Index of the entry, below getCount()
+   * @return std::string_view - The string, empty for the description of a
+   * waypoint
+   */
+  std::string_view getName(table_t table, size_t index) const
+  {
+    return getString(table, NAME_OFFSETS, index);
+  }
+  std::string_view getDescription(table_t table, size_t index) const
+  {
+    return (POI_TABLE == table)
+               ? getString(table, DESCRIPTION_OFFSETS, index)
+               : std::string_view();
+  }
+  /**
+   * Finds an entry by its name through the name index
+   * @param table_t table [IN] - The table
+   * @param std::string_view name [IN] - The name
+   * @param size_t& index [OUT] - Index of the entry
+   * @return true if the name is found, false otherwise
+   */
+  bool find(table_t table, std::string_view name, size_t &index) const;
+  /**
+   * Materializes a waypoint or POI of the snapshot
+   * @param size_t index [IN] - Index of the entry
+   * @return CWaypoint / CPOI - The object as it was written
+   */
+  CWaypoint getWaypoint(size_t index) const;
+  CPOI getPoi(size_t index) const;
+
+  /**
+   * Hashes a name as the name index does (64 bit FNV-1a)
+   * @param std::string_view name [IN] - The name
+   * @return uint64_t - The hash
+   */
+  static uint64_t hashName(std::string_view name);
+  /**
+   * Updates a CRC-32 (IEEE 802.3) with the bytes
+   * @param uint32_t checksum [IN] - The CRC of the previous bytes, 0 at the
+   * start
+   * @param const void* pData [IN] - The bytes
+   * @param size_t size [IN] - The number of bytes
+   * @return uint32_t - The CRC of the previous bytes and the bytes
+   */
+  static uint32_t updateChecksum(uint32_t checksum, const void *pData,
+                                 size_t size);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBINARY_SNAPSHOT_H
@@ -0,0 +1,165 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBufferPool.H
+* Author          : Jishnu M Thampan
+* Description     : class CBufferPool
+*                   Caches the fixed-size pages of a file in a fixed number
+*                   of frames, for the disk-resident B+tree.
+****************************************************************************/
+#ifndef CBUFFER_POOL_H
+#define CBUFFER_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define DB_PAGE_SIZE (4096) /**< @brief Represents the size of a page */
+#define MIN_POOL_FRAMES \
+  (8) /**< @brief Represents the fewest frames, one path of the B+tree and
+         its split pages stay pinned */
+
+/**
+ * CBufferPool reads the pages of a file into a fixed number of frames, so
+ * that the memory stays bounded however large the file is. A page is
+ * pinned while it is used and cannot be evicted. A page which is needed
+ * and not in a frame replaces an unpinned page chosen by the clock
+ * algorithm: the clock hand passes the frames in a circle, a used page
+ * gets a second chance and the first page which was not used since the
+ * last pass is evicted. Changed pages are written back when they are
+ * evicted or flushed.
+ *
+ * The pool is not crash safe: a file which was not flushed may hold a mix
+ * of old and new pages.
+ */
+class CBufferPool {
+private:
+  typedef struct {
+    uint32_t pageId;   /**< \brief Represents the page in the frame */
+    uint32_t pinCount; /**< \brief Represents the users of the page */
+    bool isUsed;       /**< \brief Represents the page used since the last
+                          pass of the clock hand */
+    bool isDirty;      /**< \brief Represents a changed page */
+    bool isValid;      /**< \brief Represents a frame which holds a page */
+  } frame_t;
+
+  int m_fd;                    /**< \brief Represents the file */
+  uint32_t m_pageCount;        /**< \brief Represents the pages of the file */
+  std::vector<char> m_memory;  /**< \brief Represents the frame contents */
+  std::vector<frame_t> m_frames; /**< \brief Represents the frames */
+  std::unordered_map<uint32_t, size_t>
+      m_pageFrames; /**< \brief Represents the frame of each cached page */
+  size_t m_clockHand; /**< \brief Represents the next frame to be checked */
+  uint64_t m_hits;    /**< \brief Represents the pages found in a frame */
+  uint64_t m_misses;  /**< \brief Represents the pages read from the file */
+  uint64_t m_evictions; /**< \brief Represents the evicted pages */
+  bool m_isFailed;    /**< \brief Represents a failed read or write */
+
+  /**
+   * Gets a frame for a page, evicting the page in it
+   * @param size_t& frame [OUT] - The frame
+   * @return true if an unpinned frame was found, false otherwise
+   */
+  bool getFreeFrame(size_t &frame);
+  /**
+   * Writes the page of a frame back to the file, if it was changed
+   * @param size_t frame [IN] - The frame
+   * @return true if the page was written, false otherwise
+   */
+  bool writeFrame(size_t frame);
+  /**
+   * Gets the contents of a frame
+   */
+  char *getFrameData(size_t frame) { return &m_memory[frame * DB_PAGE_SIZE]; }
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBufferPool(CBufferPool &);
+  CBufferPool &operator=(CBufferPool &);
+
+public:
+  CBufferPool();
+  ~CBufferPool();
+  /**
+   * Opens or creates the page file. A previously opened file is closed.
+   * @param const std::string& fileName [IN] - Name of the file
+   * @param size_t frames [IN] - The frames, at least MIN_POOL_FRAMES
+   * @param bool isTruncated [IN] - Removes the pages of an existing file
+   * @return true if the file could be opened, false otherwise
+   */
+  bool open(const std::string &fileName, size_t frames,
+            bool isTruncated = false);
+  /**
+   * Writes the changed pages and closes the file
+   * @param None
+   * @return true if every write succeeded, false otherwise
+   */
+  bool close(void);
+  /**
+   * Writes the changed pages to the file
+   * @param None
+   * @return true if every write succeeded, false otherwise
+   */
+  bool flush(void);
+  /**
+   * Removes every page of the file
+   * @param None
+   * @return true if the file was truncated, false otherwise
+   */
+  bool truncate(void);
+  /**
+   * Pins a page into a frame, the page is read if it is not cached
+   * @param uint32_t pageId [IN] - The page
+   * @return char* - The DB_PAGE_SIZE bytes of the page, NULL if the page does
+   * not exist, cannot be read or every frame is pinned
+   */
+  char *fetchPage(uint32_t pageId);
+  /**
+   * Appends a zeroed page to the file and pins it
+   * @param uint32_t& pageId [OUT] - The new page
+   * @return char* - The page, NULL if every frame is pinned
+   */
+  char *newPage(uint32_t &pageId);
+  /**
+   * Unpins a page fetched with fetchPage() or newPage()
+   * @param uint32_t pageId [IN] - The page
+   * @param bool isDirty [IN] - The page was changed
+   * @return None
+   */
+  void unpinPage(uint32_t pageId, bool isDirty);
+  /**
+   * Checks if a file is open
+   */
+  bool isOpen(void) const { return (m_fd >= 0); }
+  /**
+   * Checks if a read or a write failed since the file was opened
+   */
+  bool isFailed(void) const { return m_isFailed; }
+  /**
+   * Gets the number of pages of the file
+   */
+  uint32_t getPageCount(void) const { return m_pageCount; }
+  /**
+   * Gets the number of frames
+   */
+  size_t getFrameCount(void) const { return m_frames.size(); }
+  /**
+   * Gets the number of fetches which found the page in a frame
+   */
+  uint64_t getHits(void) const { return m_hits; }
+  /**
+   * Gets the number of fetches which read the page from the file
+   */
+  uint64_t getMisses(void) const { return m_misses; }
+  /**
+   * Gets the number of pages which were evicted from their frame
+   */
+  uint64_t getEvictions(void) const { return m_evictions; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBUFFER_POOL_H
@@ -0,0 +1,131 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBufferedWriter.H
+* Author          : Jishnu M Thampan
+* Description     : class CBufferedWriter
+*                   Collects the output of a file in large buffers which
+*                   are written with few system calls, optionally on a
+*                   background I/O thread.
+****************************************************************************/
+#ifndef CBUFFERED_WRITER_H
+#define CBUFFERED_WRITER_H
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define WRITE_BUFFER_SIZE                                                      \
+  (1 << 20) /**< \brief Represents the bytes collected for one write */
+
+/**
+ * CBufferedWriter is a utility class which writes a file sequentially. The
+ * appended text is collected in a buffer of WRITE_BUFFER_SIZE bytes and
+ * every full buffer is written with one write(2). With a background I/O
+ * thread the caller fills the second buffer while the first one is
+ * written. close() writes the rest and flushes the file to the disk once.
+ */
+class CBufferedWriter {
+private:
+  int m_fd;                   /**< \brief Represents the file descriptor */
+  bool m_isFailed;            /**< \brief Represents a failed write */
+  std::vector<char> m_buffer; /**< \brief Represents the buffer which is
+                                 filled by the caller */
+  size_t m_used;              /**< \brief Represents the filled bytes */
+
+  /* Background I/O, only used if it is enabled in open() */
+  bool m_isBackground;          /**< \brief Represents the background mode */
+  std::vector<char> m_ioBuffer; /**< \brief Represents the buffer which is
+                                   written by the I/O thread */
+  size_t m_ioUsed; /**< \brief Represents the bytes to be written by the I/O
+                      thread, 0 if the I/O thread is idle */
+  bool m_isStopping; /**< \brief Represents the request to stop the I/O
+                        thread */
+  std::thread m_ioThread;             /**< \brief Represents the I/O thread */
+  std::mutex m_mutex;                 /**< \brief Guards the handover */
+  std::condition_variable m_handover; /**< \brief Signals the handover */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CBufferedWriter(CBufferedWriter &);
+  CBufferedWriter &operator=(CBufferedWriter &);
+  /**
+   * Writes the filled part of the buffer to the file, or hands it over to
+   * the I/O thread
+   * @param None
+   * @return None
+   */
+  void flushBuffer(void);
+  /**
+   * Writes the bytes to the file, continuing after partial writes
+   * @param const char* pData [IN] - The bytes to be written
+   * @param size_t size [IN] - Number of bytes
+   * @return true if every byte is written, false otherwise
+   */
+  bool writeAll(const char *pData, size_t size);
+  /**
+   * Writes the handed over buffers until the writer is closed
+   * @param None
+   * @return None
+   */
+  void ioThreadMain(void);
+
+public:
+  CBufferedWriter();
+  ~CBufferedWriter();
+  /**
+   * Creates the file, an existing file is truncated unless it is appended
+   * to. A previously opened file is closed.
+   * @param const std::string& fileName [IN] - Name of the file to be written
+   * @param bool isBackground [IN] - Writes the buffers on an I/O thread
+   * @param bool isAppend [IN] - Keeps the contents of an existing file and
+   * writes after them
+   * @return true if the file could be created, false otherwise
+   */
+  bool open(const std::string &fileName, bool isBackground = false,
+            bool isAppend = false);
+  /**
+   * Writes the buffered text, flushes the file to the disk and closes it
+   * @param None
+   * @return true if every write and the flush succeeded, false otherwise
+   */
+  bool close(void);
+  /**
+   * Checks if a file is open
+   * @return true if a file is open, false otherwise
+   */
+  bool isOpen(void) const { return (m_fd >= 0); }
+  /**
+   * Appends text to the file
+   * @param std::string_view text [IN] - The text to be appended
+   * @return None
+   */
+  void append(std::string_view text);
+  /**
+   * Appends a single character to the file
+   * @param char character [IN] - The character to be appended
+   * @return None
+   */
+  void append(char character)
+  {
+    if (m_used == m_buffer.size())
+      flushBuffer();
+    m_buffer[m_used++] = character;
+  }
+  /**
+   * Appends the shortest text of the number which is read back unchanged
+   * (type_mapping::formatDouble)
+   * @param double number [IN] - The number to be appended
+   * @return None
+   */
+  void appendDouble(double number);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CBUFFERED_WRITER_H
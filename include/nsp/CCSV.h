@@ -8,22 +8,24 @@
 #define CCSV_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include "CAttributeExtractor.h"
+#include "CMappedFile.h"
 #include "CPersistentStorage.h"
 #include "CPoiDatabase.h"
 #include "CWpDatabase.h"
 
+class CBufferedWriter;
+
 class CCSV : public CPersistentStorage {
 private:
   std::string m_mediaName; /**< \brief Represents Media Name*/
   std::string
       m_wpFileName; /**< \brief Represents Waypoint File Name (with path)*/
   std::string m_poiFileName; /**< \brief Represents POI File Name (with path)*/
-  CAttributeExtractor m_attributeExtractor; /**< \brief Represents the Utility
-                                               class which performs attribute
-                                               extraction*/
+  unsigned int m_threadCount; /**< \brief Represents the threads parsing a
+                                 file, 0 for one per core */
 
   /* Copy constructor and copy assignment operators are
    * not used */
@@ -34,6 +36,7 @@ public:
   CCSV();
   virtual ~CCSV(){};
   typedef std::vector<std::string> StringVector;
+  typedef std::vector<std::string_view> FieldVector;
   typedef enum { WP_FILE = 0, POI_FILE } fileType_t;
   /**
    * Set the name of the media to be used for persistent storage.
@@ -43,6 +46,22 @@ public:
    * @param name the media to be used
    */
   void setMediaName(std::string name);
+  /**
+   * Get the files of the media which writeData() replaces
+   *
+   * @param fileNames the names of the files (with path)
+   */
+  void getMediaFiles(std::vector<std::string> &fileNames) const;
+  /**
+   * Sets the number of threads which parse a file. Large files are cut into
+   * chunks at line breaks which are parsed in parallel; the records and the
+   * error messages are still stored and printed in file order. Files are
+   * written on a background I/O thread unless the count is 1.
+   * @param unsigned int threadCount [IN] - Number of threads, 0 uses one
+   * thread per core (default), 1 parses and writes on the calling thread
+   * @return None
+   */
+  void setThreadCount(unsigned int threadCount);
   /**
    * Write the data to the persistent storage.
    *
@@ -66,23 +85,39 @@ public:
    * @return true if the data could be read successfully
    */
   bool readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb, MergeMode mode);
+  /**
+   * Appends the Waypoint as a line of the CSV Waypoint file
+   * @param CBufferedWriter& file [OUT] - The file written to
+   * @param const CWaypoint& wp [IN] - The Waypoint
+   * @return None
+   */
+  static void appendWaypointRecord(CBufferedWriter &file, const CWaypoint &wp);
+  /**
+   * Appends the POI as a line of the CSV POI file
+   * @param CBufferedWriter& file [OUT] - The file written to
+   * @param const CPOI& poi [IN] - The POI
+   * @return true if the POI is appended, false if its type is invalid
+   */
+  static bool appendPoiRecord(CBufferedWriter &file, const CPOI &poi);
 
 private:
   /**
-   * Reads the CSV file and copies the contents to the string vector
+   * Maps the CSV file into memory, the contents are not copied
    * @param std::string& fileName 		  - Name of the file to be read
    * [IN]
-   * @param StringVector& fileContents 	  - The contents of the file	[OUT]
+   * @param CMappedFile& file 	  - The mapping of the file	[OUT]
    * @return true if read is successful, false otherwise
    */
-  bool readCSVFile(const std::string &fileName, StringVector &fileContents);
+  bool readCSVFile(const std::string &fileName, CMappedFile &file);
   /**
    * Parses the CSV file contents, Validates and Stores the contents to the
-   * Databases
+   * Databases. Lines and attributes are views into the contents, only the
+   * records stored in the Databases are copied. Contents of one chunk are
+   * stored as they are parsed; large contents are parsed in chunks on a
+   * CThreadPool and merged in file order.
    * @param const fileType_t fileType [IN]		     - The File type- POI or
    * Waypoint
-   * @param const CCSV::StringVector& fileContents [IN]- The contents of the
-   * file
+   * @param std::string_view fileContents [IN]- The contents of the file
    * @param CPoiDatabase& poiDb [OUT]- The POI Database obj where the extracted
    * contents are written into
    * @param CWpDatabase &wpDb   [OUT]- The Waypoint Database obj where the
@@ -91,7 +126,7 @@ private:
    * the caller.
    */
   bool parseCSVFileContents(const fileType_t &fileType,
-                            const CCSV::StringVector &fileContents,
+                            std::string_view fileContents,
                             CPoiDatabase &poiDb, CWpDatabase &wpDb);
   /**
    * Writes the Waypoint Database contents into the CSV Waypoint File
@@ -107,33 +142,11 @@ private:
    */
   bool writeToCSVPoiFile(const CPoiDatabase &poiDb);
   /**
-   * Validates and if valid stores the Waypoint in the Waypoint Database
-   * @param const StringVector& attributeVec [IN] - The string vector consisting
-   * of the extracted attributes
-   * @param CPoiDatabase& poiDb [OUT]	- Waypoint Database where the validated
-   * content is to be stored
-   * @return true if validation is successful, false otherwise
-   */
-  bool validateAndStoreWaypoint(const StringVector &attributeVec,
-                                CWpDatabase &wpDb);
-  /**
-   * Validates and if valid stores the POI in the POI Database
-   * @param const StringVector& attributeVec [IN] - The string vector consisting
-   * of the extracted attributes
-   * @param CPoiDatabase& poiDb [OUT]	- POI Database where the validated
-   * content is to be stored
-   * @return true if validation is successful, false otherwise
-   */
-  bool validateAndStorePoi(const StringVector &attributeVec,
-                           CPoiDatabase &poiDb);
-  /**
-   * Initializes the Max attributes for the attribute extractor depending upon
-   * the file type
-   * @param const fileType_t& fileType [IN] - The file type - Waypoint file or
-   * POI file
-   * @return true if initialization is successful, false otherwise
+   * Checks if the files are written on a background I/O thread, which is
+   * the case unless a single thread is set
+   * @return true if the writes overlap with the formatting, false otherwise
    */
-  bool initMaxAttributes(const fileType_t &fileType);
+  bool isBackgroundWrite(void) const { return (1 != m_threadCount); }
 };
 
 #endif // CCSV_H
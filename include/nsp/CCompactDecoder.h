@@ -0,0 +1,126 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactDecoder.H
+* Author          : Jishnu M Thampan
+* Description     : class CCompactDecoder
+*                   Block-wise reader of the compact coordinate format.
+****************************************************************************/
+#ifndef CCOMPACT_DECODER_H
+#define CCOMPACT_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CMappedFile.h"
+#include "CPOI.h"
+#include "CompactCoding.h"
+
+/**
+ * CCompactDecoder maps a file written by CCompactEncoder. open() reads the
+ * trailer and the block index, a block is only decoded when it is
+ * requested, so a reader streams the file block by block or decodes only
+ * the blocks whose area it needs. The strings of the records are views
+ * into the mapped file.
+ */
+class CCompactDecoder {
+public:
+  typedef struct {
+    compact_coding::table_t table; /**< \brief Represents the table */
+    uint32_t records;              /**< \brief Represents the records */
+    double minLatitude, minLongitude, maxLatitude,
+        maxLongitude; /**< \brief Represents the area of the records */
+  } blockInfo_t;      /**< \brief Represents the header of a block */
+
+  typedef struct {
+    double latitude;  /**< \brief Represents the latitude */
+    double longitude; /**< \brief Represents the longitude */
+    CPOI::t_poi type; /**< \brief Represents the type, UNKNOWN for a
+                         waypoint */
+    std::string_view name;        /**< \brief Represents the name */
+    std::string_view description; /**< \brief Represents the description,
+                                     empty for a waypoint */
+  } record_t;                     /**< \brief Represents a decoded record */
+
+private:
+  CMappedFile m_file;     /**< \brief Represents the compact file */
+  const char *m_pIndex;   /**< \brief Represents the block offsets, NULL if
+                             no file is open */
+  size_t m_blockCount;    /**< \brief Represents the number of blocks */
+  uint64_t m_indexOffset; /**< \brief Represents the end of the blocks */
+  uint64_t m_records[compact_coding::TABLE_COUNT]; /**< \brief Represents
+                                                      the records */
+  unsigned int m_tileLevel; /**< \brief Represents the tiles of the blocks,
+                               0 if the blocks are not tiled */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CCompactDecoder(CCompactDecoder &);
+  CCompactDecoder &operator=(CCompactDecoder &);
+
+  /**
+   * Gets a block header and body
+   * @param size_t block [IN] - Index of the block
+   * @param const char*& pBody [OUT] - The body
+   * @param size_t& size [OUT] - The size of the body
+   * @return true if the block lies within the blocks, false otherwise
+   */
+  bool getBlock(size_t block, const char *&pBody, size_t &size) const;
+
+public:
+  CCompactDecoder();
+  /**
+   * Maps the file and checks its header, its trailer and its index
+   * @param const std::string& fileName [IN] - Name of the file
+   * @return true if the file is complete, false otherwise
+   */
+  bool open(const std::string &fileName);
+  /**
+   * Releases the mapping
+   * @param None
+   * @return None
+   */
+  void close(void);
+  bool isOpen(void) const { return (NULL != m_pIndex); }
+  /**
+   * Gets the number of blocks and of the records of a table
+   */
+  size_t getBlockCount(void) const { return m_blockCount; }
+  uint64_t getRecordCount(compact_coding::table_t table) const
+  {
+    return m_records[table];
+  }
+  /**
+   * Gets the tile level of the blocks, every block lies in one tile of it
+   * @return unsigned int - The tile level, 0 if the blocks are not tiled
+   */
+  unsigned int getTileLevel(void) const { return m_tileLevel; }
+  /**
+   * Reads the header of a block, without decoding it
+   * @param size_t block [IN] - Index of the block
+   * @param blockInfo_t& info [OUT] - The header
+   * @return true if the block is valid, false otherwise
+   */
+  bool getBlockInfo(size_t block, blockInfo_t &info) const;
+  /**
+   * Checks the checksums of every block
+   * @param None
+   * @return true if the file is intact, false otherwise
+   */
+  bool verify(void) const;
+  /**
+   * Decodes the records of a block
+   * @param size_t block [IN] - Index of the block
+   * @param std::vector<record_t>& records [OUT] - The records
+   * @return true if the block is intact, false otherwise
+   */
+  bool decodeBlock(size_t block, std::vector<record_t> &records) const;
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CCOMPACT_DECODER_H
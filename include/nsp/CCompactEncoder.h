@@ -0,0 +1,141 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactEncoder.H
+* Author          : Jishnu M Thampan
+* Description     : class CCompactEncoder
+*                   Streaming writer of the compact coordinate format.
+****************************************************************************/
+#ifndef CCOMPACT_ENCODER_H
+#define CCOMPACT_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CBufferedWriter.h"
+#include "CPOI.h"
+#include "CWaypoint.h"
+#include "CompactCoding.h"
+
+#define DEFAULT_BLOCK_RECORDS \
+  (512) /**< \brief Represents the records of a full block */
+
+/**
+ * CCompactEncoder writes waypoints and POIs in the compact format, which is
+ * meant for archives and transfers. All fixed size fields are little-endian:
+ *
+ * header  - uint32 magic, uint32 version
+ * blocks  - uint32 body size, uint32 records, uint8 table, 3 bytes 0,
+ *           int32 minimum latitude, minimum longitude, maximum latitude,
+ *           maximum longitude (1e-7 degree), uint32 CRC-32 of the header
+ *           up to this field and of the body;
+ *           the body holds per record the zigzag varint differences of the
+ *           quantized latitude and longitude to the previous record of the
+ *           block, the POI type byte (POIs only), the varint length and
+ *           bytes of the name and of the description (POIs only)
+ * index   - uint64 offset of every block
+ * trailer - uint32 magic, uint32 version, uint64 blocks, uint64 index
+ *           offset, uint64 waypoints, uint64 POIs, uint32 tile level,
+ *           uint32 CRC-32 of the index and the trailer up to this field
+ *
+ * A block holds the records of one table and is decoded on its own, the
+ * index and the area of every block give random access. The records are
+ * stored in the order in which they are added; callers which archive a
+ * Database sort them by getHilbertIndex() first (CCompactPersistence), a
+ * route keeps its order. The waypoints and the POIs are collected in a
+ * block each, a full block is written at once, so the memory used does
+ * not grow with the number of records.
+ *
+ * With a tile level above 0 a block also ends where the tile of the
+ * records changes, so that every block lies in one tile (CPoiTileStore).
+ */
+class CCompactEncoder {
+private:
+  /**
+   * Represents the block of a table which is being filled
+   */
+  typedef struct {
+    std::string body;   /**< \brief Represents the coded records */
+    uint32_t records;   /**< \brief Represents the number of records */
+    int32_t latitude;   /**< \brief Represents the previous latitude */
+    int32_t longitude;  /**< \brief Represents the previous longitude */
+    int32_t minLatitude, minLongitude, maxLatitude,
+        maxLongitude; /**< \brief Represents the area of the records */
+    uint64_t tileKey; /**< \brief Represents the tile of the records */
+  } block_t;
+
+  CBufferedWriter m_file; /**< \brief Represents the compact file */
+  uint64_t m_offset;      /**< \brief Represents the bytes written */
+  size_t m_blockRecords;  /**< \brief Represents the records of a block */
+  unsigned int m_tileLevel; /**< \brief Represents the tiles of the blocks,
+                               0 if the blocks are not tiled */
+  block_t m_blocks[compact_coding::TABLE_COUNT]; /**< \brief Represents the
+                                                    open blocks */
+  uint64_t m_records[compact_coding::TABLE_COUNT]; /**< \brief Represents
+                                                      the written records */
+  std::vector<uint64_t> m_blockOffsets; /**< \brief Represents the index */
+  std::string m_buffer; /**< \brief Represents a header being written */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CCompactEncoder(CCompactEncoder &);
+  CCompactEncoder &operator=(CCompactEncoder &);
+
+  /**
+   * Codes a record into the block of its table, a full block is written
+   * @param compact_coding::table_t table [IN] - The table
+   * @param double latitude, longitude [IN] - The coordinates
+   * @param std::string_view name [IN] - The name
+   * @param std::string_view description [IN] - The description of a POI
+   * @param CPOI::t_poi type [IN] - The type of a POI
+   * @return None
+   */
+  void addRecord(compact_coding::table_t table, double latitude,
+                 double longitude, std::string_view name,
+                 std::string_view description, CPOI::t_poi type);
+  /**
+   * Writes the block of a table, if it holds records, and empties it
+   * @param compact_coding::table_t table [IN] - The table
+   * @return None
+   */
+  void writeBlock(compact_coding::table_t table);
+
+public:
+  CCompactEncoder();
+  /**
+   * Creates the file and writes its header
+   * @param const std::string& fileName [IN] - Name of the file
+   * @param size_t blockRecords [IN] - The records of a full block
+   * @param unsigned int tileLevel [IN] - Ends the blocks at the tiles of
+   * this level, 0 for no tiles, at most MAX_TILE_LEVEL
+   * @return true if the file could be created, false otherwise
+   */
+  bool open(const std::string &fileName,
+            size_t blockRecords = DEFAULT_BLOCK_RECORDS,
+            unsigned int tileLevel = 0);
+  /**
+   * Adds a waypoint or POI to the file
+   * @param const CWaypoint& wp / const CPOI& poi [IN] - The record
+   * @return None
+   */
+  void addWaypoint(const CWaypoint &wp);
+  void addPoi(const CPOI &poi);
+  /**
+   * Writes the open blocks, the index and the trailer and closes the file
+   * @param None
+   * @return true if every write succeeded, false otherwise
+   */
+  bool close(void);
+  /**
+   * Gets the bytes written so far
+   */
+  uint64_t getSize(void) const { return m_offset; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CCOMPACT_ENCODER_H
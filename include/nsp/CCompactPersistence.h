@@ -0,0 +1,82 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactPersistence.H
+* Author          : Jishnu M Thampan
+* Description     : class CCompactPersistence
+*                   Persistent storage in the compact coordinate format,
+*                   for archives and transfers.
+****************************************************************************/
+#ifndef CCOMPACT_PERSISTENCE_H
+#define CCOMPACT_PERSISTENCE_H
+
+#include <string>
+#include <vector>
+
+#include "CPersistentStorage.h"
+#include "CPoiDatabase.h"
+#include "CWpDatabase.h"
+
+/**
+ * CCompactPersistence stores the Databases in myCode/<name>.nspc, written
+ * by CCompactEncoder. The entries are sorted by the Hilbert index of their
+ * coordinates, so that the blocks cover small areas and the coordinate
+ * differences take few bytes.
+ *
+ * The coordinates are quantized to 1e-7 degree: a coordinate of up to 7
+ * decimals is read back unchanged, a finer one is rounded by at most 0.5 cm.
+ */
+class CCompactPersistence : public CPersistentStorage {
+private:
+  std::string m_fileName; /**< \brief Represents the compact file name
+                             (with path) */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CCompactPersistence(CCompactPersistence &);
+  CCompactPersistence &operator=(CCompactPersistence &);
+
+public:
+  CCompactPersistence() {}
+  virtual ~CCompactPersistence() {}
+  /**
+   * Set the name of the media to be used for persistent storage.
+   * The exact interpretation of the name depends on the implementation
+   * of the component.
+   *
+   * @param name the media to be used
+   */
+  void setMediaName(std::string name);
+  /**
+   * Get the files of the media which writeData() replaces
+   *
+   * @param fileNames the names of the files (with path)
+   */
+  void getMediaFiles(std::vector<std::string> &fileNames) const;
+  /**
+   * Write the data to the persistent storage.
+   *
+   * @param waypointDb the data base with way points
+   * @param poiDb the database with points of interest
+   * @return true if the data could be saved successfully
+   */
+  bool writeData(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb);
+  /**
+   * Fill the databases with the data from persistent storage. If
+   * merge mode is MERGE, the content in the persistent storage
+   * will be merged with any content already existing in the data
+   * bases. If merge mode is REPLACE, already existing content
+   * will be removed before inserting the content from the persistent
+   * storage.
+   *
+   * @param waypointDb the the data base with way points
+   * @param poiDb the database with points of interest
+   * @param mode the merge mode
+   * @return true if the data could be read successfully
+   */
+  bool readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb, MergeMode mode);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CCOMPACT_PERSISTENCE_H
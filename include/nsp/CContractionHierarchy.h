@@ -0,0 +1,178 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CContractionHierarchy.H
+* Author          : Jishnu M Thampan
+* Description     : class CContractionHierarchy
+*                   This class holds the contraction hierarchy of a
+*                   CRoutingGraph. The hierarchy is built offline, written
+*                   to a binary file and memory-mapped at startup, so that
+*                   route queries only touch a few hundred nodes.
+****************************************************************************/
+#ifndef CCONTRACTION_HIERARCHY_H
+#define CCONTRACTION_HIERARCHY_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "CMappedFile.h"
+#include "CRoutingGraph.h"
+
+/**
+ * CContractionHierarchy orders the nodes of a routing graph by importance
+ * and contracts them one level after the other. Whenever a node is
+ * contracted, shortcut edges are inserted between its remaining neighbours
+ * for every shortest path which led through the node.
+ *
+ * For every node only the edges leading to more important nodes are kept:
+ * the upward edges (node -> higher node) for the forward search and the
+ * downward edges (higher node -> node) for the backward search. Both are
+ * stored in CSR form. Every edge remembers the contracted node it bypasses
+ * (or INVALID_NODE for an original edge) so that paths can be unpacked.
+ *
+ * The file layout is the in-memory layout, hence a mapped file is used
+ * without any parsing. The file is written in the byte order of the
+ * machine which built it.
+ */
+class CContractionHierarchy {
+public:
+  typedef CRoutingGraph::node_t node_t;
+  typedef CRoutingGraph::edge_t edge_t;
+
+  typedef struct {
+    node_t target; /**< \brief Represents the other end of the edge */
+    node_t middle; /**< \brief Represents the bypassed node of a shortcut */
+    double weight; /**< \brief Represents the length of the edge in km */
+  } hierarchyEdge_t; /**< \brief Represents an upward or downward edge */
+
+private:
+  typedef struct {
+    char magic[8];          /**< \brief Represents the file signature */
+    uint32_t version;       /**< \brief Represents the file format version */
+    uint32_t nodeCount;     /**< \brief Represents the number of nodes */
+    uint32_t upEdgeCount;   /**< \brief Represents the upward edges */
+    uint32_t downEdgeCount; /**< \brief Represents the downward edges */
+    uint32_t nameHeapSize;  /**< \brief Represents the bytes of all names */
+    uint32_t reserved;      /**< \brief Keeps the header 8 byte aligned */
+  } fileHeader_t;           /**< \brief Represents the header of the file */
+
+  /* Storage of a hierarchy which was built in this process, see the views
+   * below for the meaning of the members */
+  std::vector<edge_t> m_upOffsetStore;
+  std::vector<hierarchyEdge_t> m_upEdgeStore;
+  std::vector<edge_t> m_downOffsetStore;
+  std::vector<hierarchyEdge_t> m_downEdgeStore;
+  std::vector<uint32_t> m_nameOffsetStore; /* nodeCount + 1 entries */
+  std::vector<node_t> m_nameOrderStore;
+  std::vector<char> m_nameHeapStore;
+  CMappedFile m_file; /**< \brief Represents the storage of a hierarchy
+                         which was read from a file */
+
+  /* Views onto either of the two storages */
+  node_t m_nodeCount; /**< \brief Represents the number of nodes */
+  const edge_t *m_pUpOffsets; /**< \brief Represents the CSR row offsets of
+                                 the upward edges */
+  const hierarchyEdge_t *m_pUpEdges; /**< \brief Represents the upward
+                                        edges */
+  const edge_t *m_pDownOffsets; /**< \brief Represents the CSR row offsets
+                                   of the downward edges */
+  const hierarchyEdge_t *m_pDownEdges; /**< \brief Represents the downward
+                                          edges */
+  const uint32_t *m_pNameOffsets; /**< \brief Represents the start of each
+                                     name in the name heap */
+  const node_t *m_pNameOrder; /**< \brief Represents the nodes sorted by
+                                 name */
+  const char *m_pNameHeap;    /**< \brief Represents all names, one after
+                                 the other */
+
+  /**
+   * Points the views onto the vectors of a hierarchy built in this process
+   * @param None
+   * @return None
+   */
+  void attachStore(void);
+  /**
+   * Resets the views to an empty hierarchy
+   * @param None
+   * @return None
+   */
+  void detach(void);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CContractionHierarchy(CContractionHierarchy &);
+  CContractionHierarchy &operator=(CContractionHierarchy &);
+
+public:
+  CContractionHierarchy();
+  /**
+   * Builds the hierarchy of a finalized routing graph. The node priorities
+   * are computed in parallel and in every round an independent set of nodes
+   * (no two of them adjacent) is contracted in parallel.
+   * @param const CRoutingGraph& graph [IN] - The graph to be contracted
+   * @param unsigned int threadCount [IN] - Number of worker threads, 0 uses
+   * one thread per core
+   * @return None
+   */
+  void build(const CRoutingGraph &graph, unsigned int threadCount = 0);
+  /**
+   * Writes the hierarchy to a binary file
+   * @param const std::string& fileName [IN] - Name of the file
+   * @return true if the file is written, false otherwise
+   */
+  bool writeToFile(const std::string &fileName) const;
+  /**
+   * Maps a hierarchy file into memory. The file is checked but not copied.
+   * @param const std::string& fileName [IN] - Name of the file
+   * @return true if the file is a valid hierarchy, false otherwise
+   */
+  bool openFile(const std::string &fileName);
+  /**
+   * Releases the hierarchy
+   * @param None
+   * @return None
+   */
+  void clear(void);
+  /**
+   * Gets the node which belongs to the Waypoint with the given name. The
+   * name index is sorted, hence the lookup is a binary search.
+   * @param const std::string& name [IN] - Name of the Waypoint
+   * @param node_t& node [OUT] - Index of the node
+   * @return true if the node is found, false otherwise
+   */
+  bool getNode(const std::string &name, node_t &node) const;
+  /**
+   * Gets the Waypoint name of a node
+   * @param node_t node [IN] - Index of the node
+   * @return std::string - Name of the Waypoint
+   */
+  std::string getNodeName(node_t node) const;
+
+  node_t getNodeCount(void) const { return m_nodeCount; }
+  edge_t getUpEdgeCount(void) const {
+    return (0 == m_nodeCount) ? 0 : m_pUpOffsets[m_nodeCount];
+  }
+  edge_t getDownEdgeCount(void) const {
+    return (0 == m_nodeCount) ? 0 : m_pDownOffsets[m_nodeCount];
+  }
+  /** First edge from the node to a more important node */
+  edge_t getUpBegin(node_t node) const { return m_pUpOffsets[node]; }
+  /** One past the last edge from the node to a more important node */
+  edge_t getUpEnd(node_t node) const { return m_pUpOffsets[node + 1]; }
+  const hierarchyEdge_t &getUpEdge(edge_t edge) const {
+    return m_pUpEdges[edge];
+  }
+  /** First edge from a more important node to the node */
+  edge_t getDownBegin(node_t node) const { return m_pDownOffsets[node]; }
+  /** One past the last edge from a more important node to the node */
+  edge_t getDownEnd(node_t node) const { return m_pDownOffsets[node + 1]; }
+  const hierarchyEdge_t &getDownEdge(edge_t edge) const {
+    return m_pDownEdges[edge];
+  }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CCONTRACTION_HIERARCHY_H
@@ -14,16 +14,103 @@
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <map>
+#include <sstream>
 #include <string>
+#include <vector>
+
+#include "CDiagnostics.h"
 
 template <class KeyValue, class DataType> class CDatabase {
 private:
   typedef std::map<KeyValue, DataType> DatabaseMap_t;
+  typedef std::map<unsigned long, KeyValue> ChangeLog_t;
 
   DatabaseMap_t m_databaseMap; /**< \brief Describes the Database object */
 
+  /* Change tracking, only filled while it is enabled */
+  unsigned long m_trackingId; /**< \brief Identifies the tracked changes, 0
+                                 if changes are not tracked */
+  unsigned long m_changeSequence; /**< \brief Represents the last change */
+  unsigned long m_clearSequence;  /**< \brief Represents the last clear */
+  ChangeLog_t m_changeLog; /**< \brief Represents the changed keys by the
+                              sequence of their last change */
+  std::map<KeyValue, unsigned long>
+      m_lastChange; /**< \brief Represents the last change of every key */
+  bool m_isTrackingSuspended; /**< \brief Represents changes which are not
+                                 recorded, the tracking id is kept */
+
+  /**
+       * Gets an identifier which is unique in the process
+       * @param None
+       * @return unsigned long - New identifier, never 0
+       */
+  static unsigned long createTrackingId(void) {
+    static std::atomic<unsigned long> s_trackingCount(0);
+    return ++s_trackingCount;
+  }
+  /**
+       * Records a change of the entry, if changes are tracked
+       * @param const KeyValue& key [IN] - Key of the added, updated or
+   * removed entry
+       * @return None
+       */
+  void recordChange(const KeyValue &key) {
+    if ((0 == m_trackingId) || m_isTrackingSuspended) {
+      return;
+    }
+    m_changeSequence++;
+    typename std::map<KeyValue, unsigned long>::iterator itr =
+        m_lastChange.find(key);
+    if (itr != m_lastChange.end()) {
+      m_changeLog.erase(itr->second);
+      itr->second = m_changeSequence;
+    } else {
+      m_lastChange.insert(std::make_pair(key, m_changeSequence));
+    }
+    m_changeLog.insert(std::make_pair(m_changeSequence, key));
+  }
+
+protected:
+  /**
+       * Suspends or resumes the recording of changes without starting a
+       * new tracking id, for entries which are not data of the user
+       * @param bool isSuspended [IN] - Does not record the following changes
+       * @return None
+       */
+  void suspendChangeTracking(bool isSuspended) {
+    m_isTrackingSuspended = isSuspended;
+  }
+
 public:
+  typedef typename DatabaseMap_t::const_iterator
+      const_iterator; /**< \brief Iterates the entries in key order */
+  typedef typename DatabaseMap_t::node_type
+      node_t; /**< \brief Represents an entry which is not in a Database */
+
+  CDatabase()
+      : m_trackingId(0), m_changeSequence(0), m_clearSequence(0),
+        m_isTrackingSuspended(false) {}
+  /**
+       * Copies the entries. The copy has its own change tracking, so that
+       * the changes of the copy and of the original are not mixed up.
+       */
+  CDatabase(const CDatabase &other)
+      : m_databaseMap(other.m_databaseMap), m_trackingId(0),
+        m_changeSequence(0), m_clearSequence(0),
+        m_isTrackingSuspended(false) {
+    setChangeTracking(0 != other.m_trackingId);
+  }
+  CDatabase &operator=(const CDatabase &other) {
+    if (this != &other) {
+      m_databaseMap = other.m_databaseMap;
+      setChangeTracking(false);
+      setChangeTracking(0 != other.m_trackingId);
+    }
+    return *this;
+  }
+
   /**
        * Adds the requested data to the map
        * @param const KeyValue& key [IN] - Key value of the Template Map
@@ -33,19 +120,86 @@ public:
        */
   void addData(const KeyValue &key, const DataType &data) {
     if (m_databaseMap.size() < m_databaseMap.max_size()) {
-      /* If there is space available then insert it into the database */
-      std::pair<typename DatabaseMap_t::iterator, bool> result =
-          m_databaseMap.insert(std::make_pair(key, data));
-      if (!(result.second)) {
-        std::cout << "CWpDatabase::addWaypoint: Data already present in the "
-                     "Waypoint Database"
-                  << std::endl;
+      /* If there is space available then insert it into the database. The
+       * end is the hint, so that keys in ascending order, as the files are
+       * written, are appended without searching the map. */
+      size_t previousSize = m_databaseMap.size();
+      m_databaseMap.insert(m_databaseMap.end(), std::make_pair(key, data));
+      if (m_databaseMap.size() != previousSize) {
+        recordChange(key);
+      } else {
+        CDiagnostics::report(CDiagnostics::DUPLICATE_ENTRY,
+                             "CWpDatabase::addWaypoint: Data already present "
+                             "in the Waypoint Database");
+      }
+    } else {
+      CDiagnostics::report(
+          CDiagnostics::STORAGE_ERROR,
+          "ERROR: CWpDatabase::addWaypoint() failed: No space available!!");
+    }
+  }
+  /**
+       * Creates an entry which is added later with addNode(). The entry
+       * belongs to no Database, so it can be created on any thread.
+       * @param const KeyValue& key [IN] - Key value of the Template Map
+       * @param const DataType& data [IN]- The Actual Data to be stored
+       * @return node_t - The entry
+       */
+  static node_t createNode(const KeyValue &key, const DataType &data) {
+    DatabaseMap_t entry;
+    entry.emplace(key, data);
+    return entry.extract(entry.begin());
+  }
+  /**
+       * Adds the entry like addData(), the entry is moved into the map and
+       * not copied. A duplicate entry is left in the node.
+       * @param node_t& node [IN/OUT] - The entry created by createNode()
+       * @return None
+       */
+  void addNode(node_t &node) {
+    if (m_databaseMap.size() < m_databaseMap.max_size()) {
+      typename DatabaseMap_t::iterator position =
+          m_databaseMap.insert(m_databaseMap.end(), std::move(node));
+      if (node.empty()) {
+        recordChange(position->first);
+      } else {
+        CDiagnostics::report(CDiagnostics::DUPLICATE_ENTRY,
+                             "CWpDatabase::addWaypoint: Data already present "
+                             "in the Waypoint Database");
       }
     } else {
-      std::cout
-          << "ERROR: CWpDatabase::addWaypoint() failed: No space available!!"
-          << std::endl;
+      CDiagnostics::report(
+          CDiagnostics::STORAGE_ERROR,
+          "ERROR: CWpDatabase::addWaypoint() failed: No space available!!");
+    }
+  }
+  /**
+       * Adds the data or replaces the data stored under the key
+       * @param const KeyValue& key [IN] - Key value of the Template Map
+       * @param const DataType& data [IN]- The Actual Data to be stored in the
+   * map
+       * @return None
+       */
+  void updateData(const KeyValue &key, const DataType &data) {
+    typename DatabaseMap_t::iterator itr = m_databaseMap.find(key);
+    if (itr != m_databaseMap.end()) {
+      itr->second = data;
+    } else {
+      m_databaseMap.insert(std::make_pair(key, data));
     }
+    recordChange(key);
+  }
+  /**
+       * Removes the data stored under the key
+       * @param const KeyValue& key [IN] - Key value of the Template Map
+       * @return true if the data was present, false otherwise
+       */
+  bool removeData(const KeyValue &key) {
+    if (0 == m_databaseMap.erase(key)) {
+      return false;
+    }
+    recordChange(key);
+    return true;
   }
   /**
        * Gets the Pointer to the  Template object in the map
@@ -57,12 +211,23 @@ public:
     typename DatabaseMap_t::iterator itr = m_databaseMap.find(key);
     if (itr != m_databaseMap.end()) {
       pWp = &(itr->second);
-    } else {
-      std::cout << "ERROR!CWpDatabase::getPointerToWaypoint!" << key
-                << " not found" << std::endl;
+    } else if (CDiagnostics::count(CDiagnostics::MISSING_ENTRY)) {
+      std::ostringstream message;
+      message << "ERROR!CWpDatabase::getPointerToWaypoint!" << key
+              << " not found";
+      CDiagnostics::write(CDiagnostics::MISSING_ENTRY, message.str());
     }
     return pWp;
   }
+  /**
+       * Finds the data without reporting a missing key
+       * @param const KeyValue& key [IN] - Key value of the Template Map
+       * @return const DataType* - Pointer to the data if found, otherwise null
+       */
+  const DataType *findData(const KeyValue &key) const {
+    typename DatabaseMap_t::const_iterator itr = m_databaseMap.find(key);
+    return (itr != m_databaseMap.end()) ? &(itr->second) : NULL;
+  }
   /**
        * Get the Pointer to the container of Database
        * @param  DatabaseMap_t& dataBaseMap [OUT] -  Gets the internal map
@@ -72,12 +237,88 @@ public:
   void getDatabaseContent(DatabaseMap_t &dataBaseMap) const {
     dataBaseMap = m_databaseMap;
   }
+  /**
+       * Gets the first entry of the Database. The entries are visited in
+       * place, unlike getDatabaseContent() which copies the whole map. The
+       * iterators stay valid until the entry is removed.
+       * @param None
+       * @return const_iterator - Iterator to the first (key, data) pair
+       */
+  const_iterator begin(void) const { return m_databaseMap.begin(); }
+  /**
+       * Gets the end of the Database entries
+       * @param None
+       * @return const_iterator - Iterator past the last (key, data) pair
+       */
+  const_iterator end(void) const { return m_databaseMap.end(); }
+  /**
+       * Gets the number of entries of the Database
+       * @param None
+       * @return size_t - Number of entries
+       */
+  size_t size(void) const { return m_databaseMap.size(); }
   /**
        * Clears the contents of Database
        * @param None
        * @return None
        */
-  void clearDatabase(void) { m_databaseMap.clear(); }
+  void clearDatabase(void) {
+    m_databaseMap.clear();
+    if (0 != m_trackingId) {
+      /* One clear replaces the changes of all previous entries */
+      m_clearSequence = ++m_changeSequence;
+      m_changeLog.clear();
+      m_lastChange.clear();
+    }
+  }
+  /**
+       * Enables or disables the tracking of changes. Every enable starts a
+       * new tracking id without changes. Changes made to the data through
+       * getPointerToData() are not tracked, updateData() is.
+       * @param bool isEnabled [IN] - Tracks the following changes
+       * @return None
+       */
+  void setChangeTracking(bool isEnabled) {
+    m_trackingId = isEnabled ? createTrackingId() : 0;
+    m_changeLog.clear();
+    m_lastChange.clear();
+  }
+  /**
+       * Gets the identifier of the tracked changes. The changes of one id
+       * are continuous, a new id means that changes were not tracked.
+       * @param None
+       * @return unsigned long - The tracking id, 0 if changes are not tracked
+       */
+  unsigned long getTrackingId(void) const { return m_trackingId; }
+  /**
+       * Gets the sequence number of the last change
+       * @param None
+       * @return unsigned long - Sequence number
+       */
+  unsigned long getChangeSequence(void) const { return m_changeSequence; }
+  /**
+       * Gets the sequence number of the last clear of the Database
+       * @param None
+       * @return unsigned long - Sequence number
+       */
+  unsigned long getClearSequence(void) const { return m_clearSequence; }
+  /**
+       * Gets the keys which were added, updated or removed after a change
+       * and after the last clear, in the order of their last change. Whether
+       * a key was removed is told by findData().
+       * @param unsigned long sequence [IN] - Sequence number of the change
+       * @param std::vector<KeyValue>& keys [OUT] - The changed keys
+       * @return None
+       */
+  void getChangedKeys(unsigned long sequence,
+                      std::vector<KeyValue> &keys) const {
+    keys.clear();
+    for (typename ChangeLog_t::const_iterator itr =
+             m_changeLog.upper_bound(sequence);
+         itr != m_changeLog.end(); ++itr) {
+      keys.push_back(itr->second);
+    }
+  }
   /**
        * Prints the content of Database
        * @param None
@@ -0,0 +1,285 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDiagnostics.H
+* Author          : Jishnu M Thampan
+* Description     : class CDiagnostics, CDiagnosticSink, CConsoleSink,
+*                   CRingBufferSink and CDiagnosticScope
+*                   Counts the errors and warnings of the Databases and the
+*                   persistent storages per category and writes a sample
+*                   of their messages to an exchangeable sink.
+****************************************************************************/
+#ifndef CDIAGNOSTICS_H
+#define CDIAGNOSTICS_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define DIAGNOSTIC_SAMPLE_LIMIT                                                \
+  (1000) /**< @brief Represents the messages of a category which are written \
+            in full during a load */
+#define DIAGNOSTIC_SAMPLE_INTERVAL                                             \
+  (1000) /**< @brief Represents every how many messages one is written after \
+            the sample limit */
+#define DIAGNOSTIC_RING_SIZE                                                   \
+  (4096) /**< @brief Represents the default slots of a CRingBufferSink */
+#define DIAGNOSTIC_TEXT_LENGTH                                                 \
+  (256) /**< @brief Represents the longest message kept by a CRingBufferSink */
+
+class CDiagnosticSink;
+
+/**
+ * CDiagnostics is the single point where the Databases and the persistent
+ * storages report their errors and warnings. Every diagnostic is counted in
+ * its category. During a load (see CDiagnosticScope) only the first
+ * DIAGNOSTIC_SAMPLE_LIMIT messages of a category and then every
+ * DIAGNOSTIC_SAMPLE_INTERVAL-th message are written to the sink, so a dirty
+ * file is not loaded at the speed of the console; the end of the load
+ * writes a summary of the counts. Outside of a load every message is
+ * written. The default sink prints to std::cout.
+ */
+class CDiagnostics {
+public:
+  /**
+   * Represents the category of a diagnostic
+   */
+  typedef enum {
+    DUPLICATE_ENTRY = 0, /**< \brief Represents data already present in a
+                            Database */
+    MISSING_ENTRY,       /**< \brief Represents data not found in a Database */
+    INVALID_RECORD,      /**< \brief Represents an invalid line of a file */
+    INVALID_VALUE,       /**< \brief Represents an invalid Waypoint or POI
+                            attribute */
+    INVALID_JSON,        /**< \brief Represents an error of the JSON format */
+    STORAGE_ERROR,       /**< \brief Represents a failed file operation */
+    NOTICE,              /**< \brief Represents an information, it is neither
+                            counted nor sampled */
+    CATEGORY_COUNT       /**< \brief Represents the number of categories */
+  } category_t;
+
+  /**
+   * Counts a diagnostic of the category and decides if its message is
+   * written. Callers which compose the message only do so if it is.
+   * @param category_t category [IN] - The category of the diagnostic
+   * @return true if the message is to be written (see write()), false if it
+   * is only counted
+   */
+  static bool count(category_t category);
+  /**
+   * Writes the message of a counted diagnostic to the sink
+   * @param category_t category [IN] - The category of the diagnostic
+   * @param std::string_view message [IN] - The message without line break
+   * @return None
+   */
+  static void write(category_t category, std::string_view message);
+  /**
+   * Counts a diagnostic and writes its message if it is sampled
+   * @param category_t category [IN] - The category of the diagnostic
+   * @param std::string_view message [IN] - The message without line break
+   * @return None
+   */
+  static void report(category_t category, std::string_view message)
+  {
+    if (count(category))
+      write(category, message);
+  }
+  /**
+   * Sets the sink of the messages. The sink is used until another one is
+   * set and must not be set while a diagnostic is reported.
+   * @param CDiagnosticSink* pSink [IN] - The sink, NULL for the console
+   * @return None
+   */
+  static void setSink(CDiagnosticSink *pSink);
+  /**
+   * Sets how many messages of a category are written during a load
+   * @param unsigned long limit [IN] - Messages written in full
+   * @param unsigned long interval [IN] - Every how many messages one is
+   * written after the limit, 0 writes none
+   * @return None
+   */
+  static void setSampling(unsigned long limit, unsigned long interval);
+  /**
+   * Gets the diagnostics of a category counted since the start of the last
+   * load (or the program)
+   * @param category_t category [IN] - The category
+   * @return unsigned long - The number of diagnostics
+   */
+  static unsigned long getCount(category_t category);
+  /**
+   * Gets the name of a category in plural, as used in the summary
+   * @param category_t category [IN] - The category
+   * @return const char* - The name
+   */
+  static const char *getCategoryName(category_t category);
+  /**
+   * Starts a load: the counters are reset and the messages are sampled.
+   * Nested loads belong to the outermost one.
+   * @param None
+   * @return None
+   */
+  static void beginLoad(void);
+  /**
+   * Ends a load. The outermost load writes a summary of the counted
+   * diagnostics, if there are any, and flushes the sink.
+   * @param std::string_view loadName [IN] - Name of the load in the summary
+   * @return None
+   */
+  static void endLoad(std::string_view loadName);
+
+private:
+  static std::atomic<unsigned long>
+      s_counts[CATEGORY_COUNT]; /**< \brief Represents the counters */
+  static std::atomic<unsigned long> s_written; /**< \brief Represents the
+                                                  messages written in a load */
+  static std::atomic<int> s_loadDepth; /**< \brief Represents the nested
+                                          loads */
+  static std::atomic<unsigned long> s_sampleLimit; /**< \brief Represents the
+                                                      sample limit */
+  static std::atomic<unsigned long> s_sampleInterval; /**< \brief Represents
+                                                         the sample interval */
+  static std::atomic<CDiagnosticSink *> s_pSink; /**< \brief Represents the
+                                                   sink, NULL for the
+                                                   console */
+};
+
+/**
+ * Receives the messages written by CDiagnostics. write() can be called by
+ * several threads at the same time.
+ */
+class CDiagnosticSink {
+public:
+  virtual ~CDiagnosticSink() {}
+  /**
+   * Writes a message
+   * @param CDiagnostics::category_t category [IN] - The category
+   * @param std::string_view message [IN] - The message without line break
+   * @return None
+   */
+  virtual void write(CDiagnostics::category_t category,
+                     std::string_view message) = 0;
+  /**
+   * Waits until the written messages are visible in the output
+   * @param None
+   * @return None
+   */
+  virtual void flush(void) {}
+};
+
+/**
+ * Prints every message as a line of an output stream, the caller waits for
+ * the output
+ */
+class CConsoleSink : public CDiagnosticSink {
+private:
+  std::ostream &m_out; /**< \brief Represents the output */
+
+public:
+  /**
+   * Constructor of CConsoleSink class
+   * @param std::ostream& out [IN] - The output, std::cout by default
+   */
+  CConsoleSink(std::ostream &out = std::cout) : m_out(out) {}
+  void write(CDiagnostics::category_t category, std::string_view message);
+  void flush(void) { m_out.flush(); }
+};
+
+/**
+ * Copies every message into a slot of a bounded lock-free ring buffer and
+ * prints it on a background logger thread, so the reporting thread never
+ * waits for the output. Messages are cut to DIAGNOSTIC_TEXT_LENGTH
+ * characters; if the ring buffer is full, the message is dropped and
+ * counted.
+ */
+class CRingBufferSink : public CDiagnosticSink {
+private:
+  /**
+   * Holds one message. The sequence tells if the slot is free for the
+   * producer of a position or filled for the logger.
+   */
+  typedef struct {
+    std::atomic<size_t> sequence; /**< \brief Represents the state of the
+                                     slot */
+    unsigned short length;        /**< \brief Represents the message length */
+    char text[DIAGNOSTIC_TEXT_LENGTH]; /**< \brief Represents the message */
+  } slot_t;
+
+  std::ostream &m_out;          /**< \brief Represents the output */
+  std::vector<slot_t> m_slots;  /**< \brief Represents the ring buffer */
+  size_t m_mask;                /**< \brief Represents the slots - 1 */
+  std::atomic<size_t> m_enqueuePos; /**< \brief Represents the next slot to
+                                       be filled */
+  std::atomic<size_t> m_printedPos; /**< \brief Represents the messages which
+                                       are printed and flushed */
+  std::atomic<unsigned long> m_dropped; /**< \brief Represents the dropped
+                                           messages */
+  std::atomic<bool> m_isStopping; /**< \brief Represents the request to stop
+                                     the logger */
+  std::thread m_loggerThread;     /**< \brief Represents the logger */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CRingBufferSink(CRingBufferSink &);
+  CRingBufferSink &operator=(CRingBufferSink &);
+  /**
+   * Prints the filled slots until the sink is destroyed
+   * @param None
+   * @return None
+   */
+  void loggerThreadMain(void);
+
+public:
+  /**
+   * Constructor of CRingBufferSink class, starts the logger thread
+   * @param std::ostream& out [IN] - The output, std::cout by default
+   * @param size_t slots [IN] - Slots of the ring buffer, rounded up to a
+   * power of 2
+   */
+  CRingBufferSink(std::ostream &out = std::cout,
+                  size_t slots = DIAGNOSTIC_RING_SIZE);
+  /**
+   * Destructor of CRingBufferSink class, prints the remaining messages
+   */
+  ~CRingBufferSink();
+  void write(CDiagnostics::category_t category, std::string_view message);
+  void flush(void);
+  /**
+   * Gets the messages dropped because the ring buffer was full
+   * @return unsigned long - The number of messages
+   */
+  unsigned long getDroppedCount(void) const { return m_dropped.load(); }
+};
+
+/**
+ * Marks a load for CDiagnostics from its construction to its destruction
+ */
+class CDiagnosticScope {
+private:
+  std::string_view m_loadName; /**< \brief Represents the name of the load */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CDiagnosticScope(CDiagnosticScope &);
+  CDiagnosticScope &operator=(CDiagnosticScope &);
+
+public:
+  /**
+   * Constructor of CDiagnosticScope class, begins the load
+   * @param std::string_view loadName [IN] - Name of the load in the summary,
+   * a string literal
+   */
+  CDiagnosticScope(std::string_view loadName) : m_loadName(loadName)
+  {
+    CDiagnostics::beginLoad();
+  }
+  ~CDiagnosticScope() { CDiagnostics::endLoad(m_loadName); }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CDIAGNOSTICS_H
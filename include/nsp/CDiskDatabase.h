@@ -0,0 +1,285 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDiskDatabase.H
+* Author          : Jishnu M Thampan
+* Description     : class CDiskDatabase
+*                   A Database of CWaypoint/CPOI objects in a page file,
+*                   for datasets which do not fit into memory.
+****************************************************************************/
+#ifndef CDISK_DATABASE_H
+#define CDISK_DATABASE_H
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CBPlusTree.h"
+#include "CBufferPool.h"
+#include "CDiagnostics.h"
+#include "RecordCoding.h"
+
+#define NAME_META_PAGE (0) /**< @brief Represents the meta page of names */
+#define AREA_META_PAGE (1) /**< @brief Represents the meta page of areas */
+#define DEFAULT_POOL_FRAMES \
+  (4096) /**< @brief Represents the default pool of 16 MB */
+
+/**
+ * CDiskDatabase stores the entries in a page file and keeps a fixed number
+ * of pages in memory, see CBufferPool. It has the interface of CDatabase
+ * with the name as key, except that the data is copied out of the pages:
+ * findData() fills an object instead of returning a pointer, and the
+ * entries are visited with scanData() instead of iterators. Changes are
+ * not tracked.
+ *
+ * Two B+trees share the file. The names map to the records, the area keys
+ * (Hilbert index of the position, then name) map to the positions, so
+ * that findArea() reads the pages of an area instead of every page.
+ *
+ * DataType is CWaypoint or CPOI, see record_coding.
+ */
+template <class DataType> class CDiskDatabase {
+private:
+  CBufferPool m_pool; /**< \brief Represents the pages of the file */
+  CBPlusTree m_names; /**< \brief Represents the records by name */
+  CBPlusTree m_areas; /**< \brief Represents the positions by area key */
+
+  /**
+   * Opens the trees, an empty file gets their meta pages
+   * @param None
+   * @return true if the file holds the trees, false otherwise
+   */
+  bool openTrees(void) {
+    if (0 == m_pool.getPageCount()) {
+      for (uint32_t page = NAME_META_PAGE; page <= AREA_META_PAGE; page++) {
+        uint32_t pageId = 0;
+        if (NULL == m_pool.newPage(pageId)) {
+          return false;
+        }
+        m_pool.unpinPage(pageId, true);
+      }
+    }
+    return m_names.open(m_pool, NAME_META_PAGE) &&
+           m_areas.open(m_pool, AREA_META_PAGE);
+  }
+  /**
+   * Reports an entry which could not be stored
+   */
+  void reportFailure(const std::string &key) {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR: CDiskDatabase::addData() failed: Unable to "
+                         "store " + key);
+  }
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CDiskDatabase(CDiskDatabase &);
+  CDiskDatabase &operator=(CDiskDatabase &);
+
+public:
+  CDiskDatabase() {}
+  ~CDiskDatabase() { close(); }
+  /**
+   * Opens or creates the page file. A previously opened file is closed.
+   * @param const std::string& fileName [IN] - Name of the file
+   * @param size_t frames [IN] - Pages kept in memory, of DB_PAGE_SIZE bytes
+   * @param bool isTruncated [IN] - Removes the entries of an existing file
+   * @return true if the file holds a Database, false otherwise
+   */
+  bool open(const std::string &fileName, size_t frames = DEFAULT_POOL_FRAMES,
+            bool isTruncated = false) {
+    if (!m_pool.open(fileName, frames, isTruncated)) {
+      return false;
+    }
+    if (!openTrees()) {
+      m_pool.close();
+      return false;
+    }
+    return true;
+  }
+  /**
+   * Writes the changed pages to the file
+   * @param None
+   * @return true if every page was written, false otherwise
+   */
+  bool flush(void) {
+    bool isFlushed = m_names.flush();
+    isFlushed = m_areas.flush() && isFlushed;
+    return m_pool.flush() && isFlushed;
+  }
+  /**
+   * Writes the changed pages and closes the file
+   * @param None
+   * @return true if every page was written, false otherwise
+   */
+  bool close(void) {
+    if (!m_pool.isOpen()) {
+      return false;
+    }
+    bool isFlushed = flush();
+    return m_pool.close() && isFlushed;
+  }
+  /**
+   * Adds the requested data to the Database
+   * @param const std::string& key [IN] - Name of the entry
+   * @param const DataType& data [IN]- The Actual Data to be stored
+   * @return None
+   */
+  void addData(const std::string &key, const DataType &data) {
+    std::string record, areaKey;
+    record_coding::encodeRecord(data, record);
+    CBPlusTree::status_t status = m_names.insert(key, record, false);
+    if (CBPlusTree::DUPLICATE == status) {
+      CDiagnostics::report(CDiagnostics::DUPLICATE_ENTRY,
+                           "CWpDatabase::addWaypoint: Data already present "
+                           "in the Waypoint Database");
+      return;
+    }
+    record_coding::getAreaKey(data.getLatitude(), data.getLongitude(), key,
+                              areaKey);
+    if ((CBPlusTree::INSERTED != status) ||
+        (CBPlusTree::FAILED ==
+         m_areas.insert(areaKey,
+                        std::string_view(record.data(),
+                                         RECORD_POSITION_SIZE),
+                        true))) {
+      reportFailure(key);
+    }
+  }
+  /**
+   * Adds the data or replaces the data stored under the key
+   * @param const std::string& key [IN] - Name of the entry
+   * @param const DataType& data [IN]- The Actual Data to be stored
+   * @return None
+   */
+  void updateData(const std::string &key, const DataType &data) {
+    removeData(key);
+    addData(key, data);
+  }
+  /**
+   * Removes the data stored under the key
+   * @param const std::string& key [IN] - Name of the entry
+   * @return true if the data was present, false otherwise
+   */
+  bool removeData(const std::string &key) {
+    std::string record, areaKey;
+    double latitude = 0, longitude = 0;
+    if (!m_names.find(key, record) ||
+        !record_coding::decodePosition(record, latitude, longitude)) {
+      return false;
+    }
+    record_coding::getAreaKey(latitude, longitude, key, areaKey);
+    m_areas.erase(areaKey);
+    return m_names.erase(key);
+  }
+  /**
+   * Finds the data without reporting a missing key
+   * @param const std::string& key [IN] - Name of the entry
+   * @param DataType& data [OUT] - The data
+   * @return true if the data was found, false otherwise
+   */
+  bool findData(const std::string &key, DataType &data) const {
+    std::string record;
+    return m_names.find(key, record) &&
+           record_coding::decodeRecord(record, key, data);
+  }
+  /**
+   * Visits the entries from a name up to another in the order of the
+   * names. The Database must not be changed during the scan.
+   * @param const std::string& from [IN] - The first name
+   * @param const std::string& to [IN] - The name after the last, empty for
+   * the last entry
+   * @param Visitor visitor [IN] - Called with each const DataType&, returns
+   * false to stop the scan
+   * @return true if every page could be read, false otherwise
+   */
+  template <class Visitor>
+  bool scanData(const std::string &from, const std::string &to,
+                Visitor visitor) const {
+    DataType data;
+    return m_names.scan(
+        from, to, [&](std::string_view key, std::string_view record) {
+          return !record_coding::decodeRecord(record, std::string(key),
+                                              data) ||
+                 visitor(static_cast<const DataType &>(data));
+        });
+  }
+  /**
+   * Finds the entries in an area. Only the pages of the area keys near the
+   * area and the records of the found entries are read.
+   * @param double minLatitude, minLongitude [IN] - The south west corner
+   * @param double maxLatitude, maxLongitude [IN] - The north east corner
+   * @param std::vector<DataType>& entries [OUT] - The entries in the area
+   * @return true if every page could be read, false otherwise
+   */
+  bool findArea(double minLatitude, double minLongitude, double maxLatitude,
+                double maxLongitude, std::vector<DataType> &entries) const {
+    entries.clear();
+    std::vector<std::pair<uint64_t, uint64_t> > ranges;
+    record_coding::getAreaRanges(minLatitude, minLongitude, maxLatitude,
+                                 maxLongitude, ranges);
+    std::vector<std::string> names;
+    bool isRead = true;
+    for (size_t i = 0; i < ranges.size(); i++) {
+      std::string to = (UINT64_MAX == ranges[i].second)
+                           ? std::string()
+                           : record_coding::getAreaBound(ranges[i].second + 1);
+      isRead = m_areas.scan(record_coding::getAreaBound(ranges[i].first), to,
+                            [&](std::string_view key,
+                                std::string_view position) {
+                              double latitude = 0, longitude = 0;
+                              if (record_coding::decodePosition(
+                                      position, latitude, longitude) &&
+                                  (minLatitude <= latitude) &&
+                                  (latitude <= maxLatitude) &&
+                                  (minLongitude <= longitude) &&
+                                  (longitude <= maxLongitude)) {
+                                names.push_back(std::string(
+                                    key.substr(AREA_INDEX_SIZE)));
+                              }
+                              return true;
+                            }) &&
+               isRead;
+    }
+    entries.resize(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+      isRead = findData(names[i], entries[i]) && isRead;
+    }
+    return isRead;
+  }
+  /**
+   * Gets the number of entries of the Database
+   * @param None
+   * @return size_t - Number of entries
+   */
+  size_t size(void) const { return m_names.size(); }
+  /**
+   * Clears the contents of Database, the file is truncated
+   * @param None
+   * @return None
+   */
+  void clearDatabase(void) {
+    if (!m_pool.truncate() || !openTrees()) {
+      CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                           "ERROR: CDiskDatabase::clearDatabase() failed");
+    }
+  }
+  /**
+   * Gets the page cache, for its statistics
+   * @param None
+   * @return const CBufferPool& - The pool
+   */
+  const CBufferPool &getPool(void) const { return m_pool; }
+};
+/********************
+**  CLASS END
+*********************/
+
+typedef CDiskDatabase<CWaypoint>
+    CDiskWpDatabase; /**< \brief Represents the Waypoints on disk */
+typedef CDiskDatabase<CPOI> CDiskPoiDatabase; /**< \brief Represents the
+                                                 POIs on disk */
+
+#endif // CDISK_DATABASE_H
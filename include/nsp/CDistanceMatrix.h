@@ -0,0 +1,96 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDistanceMatrix.H
+* Author          : Jishnu M Thampan
+* Description     : class CDistanceMatrix
+*                   Computes the great-circle distances between all pairs
+*                   of a set of Waypoints and POIs on the workers of a
+*                   CThreadPool.
+****************************************************************************/
+#ifndef CDISTANCE_MATRIX_H
+#define CDISTANCE_MATRIX_H
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "CThreadPool.h"
+#include "CWaypoint.h"
+
+/**
+ * CDistanceMatrix converts every point once into a unit vector (kept as
+ * separate x, y and z arrays) and gets the distance of two points from
+ * their chord length: angle = 2 * asin(chord / 2). Unlike the acos formula
+ * of CWaypoint::calculateDistance this stays exact for nearby points, and
+ * asin is evaluated with a rational approximation which runs in SIMD
+ * registers (SSE2, or AVX2 if the build enables it).
+ *
+ * The matrix is computed in square tiles. Only the tiles on and above the
+ * diagonal are computed, every tile is then mirrored into its transposed
+ * position while it is still in the cache. The tiles are distributed over
+ * the workers of the pool.
+ *
+ * The result is written row-major into an array of count * count entries
+ * allocated by the caller. Single precision output halves the memory, the
+ * distances are still computed in double precision.
+ */
+class CDistanceMatrix {
+private:
+  CThreadPool *m_pPool; /**< \brief Represents the pool running the tiles */
+  std::vector<double> m_x; /**< \brief Represents the x of the unit vectors */
+  std::vector<double> m_y; /**< \brief Represents the y of the unit vectors */
+  std::vector<double> m_z; /**< \brief Represents the z of the unit vectors */
+
+  /**
+   * Computes the matrix for both output types
+   */
+  template <typename output_t> void computeMatrix(output_t *matrix) const;
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CDistanceMatrix(CDistanceMatrix &);
+  CDistanceMatrix &operator=(CDistanceMatrix &);
+
+public:
+  /**
+   * Constructor of CDistanceMatrix class
+   * @param CThreadPool& pool [IN] - The pool which computes the matrix. It
+   * must outlive the CDistanceMatrix object.
+   */
+  CDistanceMatrix(CThreadPool &pool);
+  /**
+   * Sets the points of the matrix, e.g. CRoute::getRoute() or Waypoints and
+   * POIs fetched from the databases. Row and column i belong to points[i].
+   * @param const std::vector<const CWaypoint*>& points [IN] - The points
+   * @return None
+   */
+  void setPoints(const std::vector<const CWaypoint *> &points);
+  /**
+   * Computes the distances between all pairs of points
+   * @param double* matrix [OUT] - getPointCount()^2 distances in kilometers,
+   * row-major
+   * @return None
+   */
+  void compute(double *matrix) const;
+  /**
+   * Computes the distances between all pairs of points in single precision
+   * @param float* matrix [OUT] - getPointCount()^2 distances in kilometers,
+   * row-major
+   * @return None
+   */
+  void compute(float *matrix) const;
+  /**
+   * Gets the distance of a single pair, computed like the matrix entries
+   * @param size_t from [IN] - Index of the first point
+   * @param size_t to [IN] - Index of the second point
+   * @return double - Distance in kilometers
+   */
+  double getDistance(size_t from, size_t to) const;
+
+  size_t getPointCount(void) const { return m_x.size(); }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CDISTANCE_MATRIX_H
@@ -0,0 +1,159 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CHierarchyRouteFinder.H
+* Author          : Jishnu M Thampan
+* Description     : class CHierarchyRouteFinder
+*                   This class answers point-to-point shortest path queries
+*                   on a CContractionHierarchy with a bidirectional search
+*                   which only follows edges to more important nodes.
+****************************************************************************/
+#ifndef CHIERARCHY_ROUTE_FINDER_H
+#define CHIERARCHY_ROUTE_FINDER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CContractionHierarchy.h"
+#include "CRoute.h"
+
+/**
+ * CHierarchyRouteFinder searches the shortest path between two nodes of a
+ * CContractionHierarchy. The forward search from the source follows the
+ * upward edges, the backward search from the target follows the downward
+ * edges in reverse. The shortest path meets at its most important node.
+ * Shortcuts of the path are unpacked into the original Waypoints.
+ *
+ * Like CRouteFinder, the search state is kept in the object and reset
+ * lazily. Every thread needs its own CHierarchyRouteFinder object, while
+ * the hierarchy itself may be shared.
+ */
+class CHierarchyRouteFinder {
+private:
+  typedef CContractionHierarchy::node_t node_t;
+  typedef CContractionHierarchy::edge_t edge_t;
+  typedef std::pair<double, node_t>
+      queueEntry_t; /**< \brief Represents an open list entry (path length,
+                       node) */
+
+  typedef struct searchDirection {
+    std::vector<double>
+        cost; /**< \brief Represents the path length from the start */
+    std::vector<node_t>
+        parent; /**< \brief Represents the predecessor in the search */
+    std::vector<edge_t>
+        parentEdge; /**< \brief Represents the edge from the predecessor */
+    std::vector<unsigned int> visitStamp; /**< \brief Represents the query
+                                             which reached the node last */
+    std::vector<queueEntry_t>
+        openList; /**< \brief Represents the binary heap of open nodes */
+  } searchDirection_t; /**< \brief Represents the state of one direction */
+
+  typedef struct {
+    node_t from;   /**< \brief Represents the start of the edge */
+    node_t to;     /**< \brief Represents the end of the edge */
+    node_t middle; /**< \brief Represents the bypassed node */
+  } unpackEntry_t; /**< \brief Represents an edge which is to be unpacked */
+
+  const CContractionHierarchy
+      *m_pHierarchy; /**< \brief Represents the hierarchy which is searched */
+  searchDirection_t m_forward;  /**< \brief Represents the forward search */
+  searchDirection_t m_backward; /**< \brief Represents the backward search */
+  std::vector<unpackEntry_t>
+      m_unpackStack; /**< \brief Represents the edges still to be unpacked */
+  unsigned int m_currentStamp; /**< \brief Represents the current query */
+  unsigned int
+      m_settledNodes; /**< \brief Represents the nodes settled by the last
+                         query */
+
+  /**
+   * Prepares the search state for a new query
+   * @param None
+   * @return None
+   */
+  void startQuery(void);
+  /**
+   * Runs the bidirectional search between two different nodes
+   * @param node_t source [IN] - Start node
+   * @param node_t target [IN] - Destination node
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return node_t - The most important node of the shortest path, or
+   * INVALID_NODE if there is no path
+   */
+  node_t search(node_t source, node_t target, double &distance);
+  /**
+   * Checks if a settled node is reached on a shorter path through a more
+   * important node (stall on demand)
+   * @param int direction [IN] - 0 for the forward, 1 for the backward search
+   * @param node_t node [IN] - The settled node
+   * @param double cost [IN] - Path length of the node in this search
+   * @return true if the node is stalled, false otherwise
+   */
+  bool isStalled(int direction, node_t node, double cost) const;
+  /**
+   * Appends the original nodes of an edge to the path
+   * @param node_t from [IN] - Start of the edge, already on the path
+   * @param node_t to [IN] - End of the edge
+   * @param node_t middle [IN] - Bypassed node or INVALID_NODE
+   * @param std::vector<node_t>& path [OUT] - The path
+   * @return None
+   */
+  void unpackEdge(node_t from, node_t to, node_t middle,
+                  std::vector<node_t> &path);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CHierarchyRouteFinder(CHierarchyRouteFinder &);
+  CHierarchyRouteFinder &operator=(CHierarchyRouteFinder &);
+
+public:
+  /**
+   * Constructor of CHierarchyRouteFinder class
+   * @param const CContractionHierarchy& hierarchy [IN] - The hierarchy to
+   * be searched. It must outlive the CHierarchyRouteFinder object.
+   */
+  CHierarchyRouteFinder(const CContractionHierarchy &hierarchy);
+  /**
+   * Searches the shortest path between two nodes
+   * @param node_t source [IN] - Start node
+   * @param node_t target [IN] - Destination node
+   * @param std::vector<node_t>& path [OUT] - The nodes of the path,
+   * including source and target
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return true if a path is found, false otherwise
+   */
+  bool findPath(node_t source, node_t target, std::vector<node_t> &path,
+                double &distance);
+  /**
+   * Searches the length of the shortest path between two nodes. The path
+   * itself is not unpacked.
+   * @param node_t source [IN] - Start node
+   * @param node_t target [IN] - Destination node
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return true if a path is found, false otherwise
+   */
+  bool findDistance(node_t source, node_t target, double &distance);
+  /**
+   * Searches the shortest path between two Waypoints and appends the
+   * Waypoints of the path to the route. The route has to be connected to
+   * the Waypoint database the hierarchy was built from.
+   * @param const std::string& from [IN] - Name of the start Waypoint
+   * @param const std::string& to [IN] - Name of the destination Waypoint
+   * @param CRoute& route [OUT] - The route the path is appended to
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return true if a path is found, false otherwise
+   */
+  bool findRoute(const std::string &from, const std::string &to,
+                 CRoute &route, double &distance);
+  /**
+   * Gets the number of nodes settled by the last query
+   * @param None
+   * @return unsigned int - Number of settled nodes
+   */
+  unsigned int getSettledNodeCount(void) const { return m_settledNodes; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CHIERARCHY_ROUTE_FINDER_H
@@ -0,0 +1,164 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJournal.H
+* Author          : Jishnu M Thampan
+* Description     : class CJournal
+*                   Persistent storage which appends the changes of the
+*                   Databases to a journal file and folds the journal into
+*                   a base snapshot in the background.
+****************************************************************************/
+#ifndef CJOURNAL_H
+#define CJOURNAL_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "CPersistentStorage.h"
+
+/**
+ * Represents how far the journal holds the changes of a Database
+ */
+typedef struct {
+  unsigned long trackingId; /**< \brief Represents the tracking id of the
+                               Database, 0 if the journal is not in sync */
+  unsigned long sequence;   /**< \brief Represents the last journaled change */
+} journalSync_t;
+
+/**
+ * CJournal stores the Databases as a base snapshot, written by another
+ * persistent storage (CCSV or CJsonPersistence), and a journal file of the
+ * changes since. After readData() the Databases track their changes and
+ * writeData() only appends the added, updated and removed entries, so a save
+ * costs time proportional to the changes. When the journal has grown, it is
+ * folded into a fresh base snapshot on a background thread; readData()
+ * replays the base, a journal being folded and the journal.
+ *
+ * The journal is a text file with one record per line: the record type, a
+ * semicolon and the fields:
+ * W;<CSV Waypoint line>, P;<CSV POI line> - Added or updated entry
+ * w;<name>, p;<name>                     - Removed entry
+ * C;W, C;P                               - Cleared Database
+ */
+class CJournal : public CPersistentStorage {
+private:
+  CPersistentStorage &m_baseStorage; /**< \brief Represents the storage of the
+                                        base snapshot */
+  std::string m_mediaName;           /**< \brief Represents the media name */
+  std::string m_journalFileName;     /**< \brief Represents the journal file
+                                        name (with path) */
+  std::string m_compactingFileName;  /**< \brief Represents the journal which
+                                        is being folded into the base */
+  journalSync_t m_wpSync;  /**< \brief Represents the state of the WP DB */
+  journalSync_t m_poiSync; /**< \brief Represents the state of the POI DB */
+  size_t m_journalRecords; /**< \brief Represents the records in the journal */
+  size_t m_compactionRecords; /**< \brief Represents the least records which
+                                 start a compaction */
+  std::thread m_compactionThread;     /**< \brief Represents the compaction */
+  std::atomic<bool> m_isCompacting;   /**< \brief Represents a running
+                                         compaction */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CJournal(CJournal &);
+  CJournal &operator=(CJournal &);
+  /**
+   * Writes both Databases as a new base snapshot and removes the journal
+   * @param const CWpDatabase& waypointDb [IN] - The Waypoint Database
+   * @param const CPoiDatabase& poiDb [IN] - The POI Database
+   * @return true if the snapshot is written, false otherwise
+   */
+  bool writeSnapshot(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb);
+  /**
+   * Appends the changes of both Databases since the last save to the journal
+   * @param const CWpDatabase& waypointDb [IN] - The Waypoint Database
+   * @param const CPoiDatabase& poiDb [IN] - The POI Database
+   * @return true if the changes are durable in the journal, false otherwise
+   */
+  bool appendChanges(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb);
+  /**
+   * Applies the records of a journal file to the Databases. A missing file
+   * has no records, invalid lines are reported and skipped.
+   * @param const std::string& fileName [IN] - The journal file
+   * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+   * @param CPoiDatabase& poiDb [OUT] - The POI Database
+   * @return size_t - Number of applied records
+   */
+  static size_t replayJournal(const std::string &fileName,
+                              CWpDatabase &waypointDb, CPoiDatabase &poiDb);
+  /**
+   * Renames the journal and starts folding it into the base snapshot on the
+   * compaction thread
+   * @param None
+   * @return None
+   */
+  void startCompaction(void);
+  /**
+   * Folds the renamed journal into a new base snapshot, runs on the
+   * compaction thread. The snapshot is written to other files of the base
+   * storage, which replace the base files when they are on the disk.
+   * @param None
+   * @return None
+   */
+  void compactJournal(void);
+
+public:
+  /**
+   * Constructor of CJournal class
+   * @param CPersistentStorage& baseStorage [IN] - Storage of the base
+   * snapshot, it is only used by the journal from now on
+   */
+  CJournal(CPersistentStorage &baseStorage);
+  virtual ~CJournal();
+  /**
+   * Set the name of the media to be used for persistent storage. The base
+   * storage gets the same name and must name its files (getMediaFiles())
+   * to be compacted, the journal is src/<name>-journal.txt
+   *
+   * @param name the media to be used
+   */
+  void setMediaName(std::string name);
+  /**
+   * Write the data to the persistent storage. Only the changes are appended
+   * to the journal if the Databases were read or written by this journal and
+   * have tracked their changes since, otherwise a new base snapshot is
+   * written.
+   *
+   * @param waypointDb the data base with way points
+   * @param poiDb the database with points of interest
+   * @return true if the data could be saved successfully
+   */
+  bool writeData(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb);
+  /**
+   * Fill the databases with the data from persistent storage: the base
+   * snapshot and the journal. The Databases track their changes afterwards.
+   * In MERGE mode the next writeData() writes a new base snapshot.
+   *
+   * @param waypointDb the the data base with way points
+   * @param poiDb the database with points of interest
+   * @param mode the merge mode
+   * @return true if the data could be read successfully
+   */
+  bool readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb, MergeMode mode);
+  /**
+   * Sets the least number of journal records which start a compaction. A
+   * compaction also waits until the journal has half as many records as the
+   * Databases have entries.
+   * @param size_t records [IN] - Number of records
+   * @return None
+   */
+  void setCompactionThreshold(size_t records);
+  /**
+   * Waits until a running compaction has finished
+   * @param None
+   * @return None
+   */
+  void waitForCompaction(void);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CJOURNAL_H
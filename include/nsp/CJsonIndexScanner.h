@@ -0,0 +1,124 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonIndexScanner.H
+* Author          : Jishnu M Thampan
+* Description     : class CJsonIndexScanner
+*                   Scanner of JSON text in memory which first finds the
+*                   structural characters with SIMD bitmasks and then
+*                   delivers the tokens by walking their index.
+****************************************************************************/
+#ifndef CJSON_INDEX_SCANNER_H
+#define CJSON_INDEX_SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CJsonToken.h"
+
+#define JSON_INDEX_WINDOW_SIZE                                                 \
+  (1 << 16) /**< @brief Represents the bytes indexed at once, a multiple of \
+               64 */
+
+/**
+ * CJsonIndexScanner delivers the same tokens as APT::CJsonScanner, but
+ * scans the whole text in two stages. Stage 1 classifies 64 bytes at a
+ * time with SIMD compares into bitmasks of quotes, backslashes, whitespace
+ * and operators, masks out everything inside strings (escaped quotes are
+ * respected) and records the position of every operator, string and start
+ * of a number or literal in an index. Stage 2 walks the index and fills
+ * the token: strings are views into the text, numbers are parsed in place.
+ * The text is indexed in windows of JSON_INDEX_WINDOW_SIZE bytes, so the
+ * index stays small and in the cache.
+ *
+ * Numbers, literals and illegal characters are matched exactly like the
+ * flex scanner does, including its lenient number pattern.
+ */
+class CJsonIndexScanner {
+private:
+  std::string_view m_input;     /**< \brief Represents the JSON text */
+  std::vector<uint32_t> m_index; /**< \brief Represents the positions of the
+                                    tokens in the window */
+  size_t m_indexPos;    /**< \brief Represents the next index entry */
+  size_t m_windowStart; /**< \brief Represents the start of the window */
+  size_t m_windowEnd;   /**< \brief Represents the end of the window */
+  size_t m_atomPos;     /**< \brief Represents the rest of a number or
+                           literal which is the next token, 0 if none */
+  uint64_t m_prevInString; /**< \brief Represents a string which continues
+                              in the next block, all bits set */
+  uint64_t m_prevEscaped;  /**< \brief Represents an escape which continues
+                              in the next block */
+  uint64_t m_prevAtom;     /**< \brief Represents a number or literal which
+                              continues in the next block */
+  size_t m_tokenEnd;  /**< \brief Represents the end of the last token */
+  size_t m_linePos;   /**< \brief Represents the end of the counted lines */
+  int m_lineNumber;   /**< \brief Represents the line of m_linePos */
+  size_t m_illegalPos; /**< \brief Represents the last illegal character */
+  APT::CJsonToken m_token; /**< \brief Represents the filled token */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CJsonIndexScanner(CJsonIndexScanner &);
+  CJsonIndexScanner &operator=(CJsonIndexScanner &);
+  /**
+   * Stage 1: indexes the next window of the text
+   * @param None
+   * @return None
+   */
+  void indexWindow(void);
+  /**
+   * Fills the token with the number or literal at the position
+   * @param size_t position [IN] - Start of the token
+   * @return false if the character at the position is illegal
+   */
+  bool scanAtom(size_t position);
+
+public:
+  /**
+   * Constructor of CJsonIndexScanner class
+   * @param std::string_view input [IN] - The JSON text, it must stay valid
+   * while the scanner is used
+   */
+  CJsonIndexScanner(std::string_view input);
+  /**
+   * Returns the next token from the input. The pointer returned points to
+   * an object managed by this class. It is only valid until the next
+   * invocation of the method; a string value stays valid as long as the
+   * input.
+   * @param None
+   * @return APT::CJsonToken* - The token, NULL if the input is exhausted
+   * @throw std::string - An illegal character of the input
+   */
+  APT::CJsonToken *nextToken(void);
+  /**
+   * Returns the next token like nextToken(), but does not throw. For an
+   * illegal character NULL is returned and isIllegal is set; illegalChar()
+   * then returns the character.
+   * @param bool& isIllegal [OUT] - Set if an illegal character was found
+   * @return APT::CJsonToken* - The token, NULL if the input is exhausted or
+   * the character is illegal
+   */
+  APT::CJsonToken *nextToken(bool &isIllegal);
+  /**
+   * Returns the illegal character found by the last invocation of
+   * nextToken()
+   * @param None
+   * @return std::string - The illegal character
+   */
+  std::string illegalChar(void);
+  /**
+   * Return the line number of the input where last token (returned by
+   * nextToken()) was found.
+   * @param None
+   * @return int - The line of the end of the token
+   */
+  int scannedLine(void);
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CJSON_INDEX_SCANNER_H
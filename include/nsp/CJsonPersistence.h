@@ -8,10 +8,15 @@
 #ifndef CJSON_H
 #define CJSON_H
 
+#include <deque>
 #include <string>
 #include <vector>
 
+#include "CBufferedWriter.h"
+#include "CDiagnostics.h"
+#include "CJsonIndexScanner.h"
 #include "CJsonScanner.h"
+#include "CJsonView.h"
 #include "CPersistentStorage.h"
 #include "CPoiDatabase.h"
 #include "CWpDatabase.h"
@@ -26,12 +31,9 @@
 
 class CJsonPersistence : public CPersistentStorage {
 private:
-  typedef std::vector<std::string>
-      StringVector; /**< \brief Represents a vector of strings */
-
   typedef struct {
-    std::string
-        errorMsg; /**< \brief Describes the error message to be displayed */
+    const char
+        *errorMsg; /**< \brief Describes the error message to be displayed */
     bool isFatal; /**< \brief Describes if the error is fatal or minor */
   } error_data_t; /**< \brief Contains the error data */
 
@@ -69,9 +71,52 @@ private:
                                                    IS_WAITING_FOR_DB_ARRAY_END state */
     IS_WAITING_FOR_PARSE_END,                   /**< \brief Represents the
                                                    IS_WAITING_FOR_PARSE_END state */
+    PARSER_STATE_COUNT /**< \brief Represents the number of states */
   } parser_state_t; /**< \brief Represents the states of the parser state
                        machine */
 
+  typedef enum {
+    NO_ACTION,                 /**< \brief Represents a plain transition */
+    DB_NAME_ACTION,            /**< \brief Represents the validation of the
+                                  database name */
+    ATTR_NAME_ACTION,          /**< \brief Represents the lookup of the
+                                  attribute name */
+    MISSING_ATTR_NAME_ACTION,  /**< \brief Represents a token instead of the
+                                  attribute name */
+    ATTR_VALUE_ACTION,         /**< \brief Represents the assignment of the
+                                  attribute value */
+    OBJ_END_ACTION,            /**< \brief Represents the check of the
+                                  completed object */
+    DATA_RESET_ACTION,         /**< \brief Represents the reset of the data */
+    PARSE_END_ACTION           /**< \brief Represents the end of parsing */
+  } parser_action_t; /**< \brief Represents the actions of the transitions */
+
+  typedef struct {
+    parser_state_t nextState; /**< \brief Represents the state after the
+                                 token */
+    parser_action_t action;   /**< \brief Represents the action on the token */
+    const char *errorMsg;     /**< \brief Represents the error raised after
+                                 the action, NULL if none */
+    bool isFatal;             /**< \brief Represents if the error is fatal */
+  } transition_t; /**< \brief Represents a transition of the state machine */
+
+  typedef struct {
+    transition_t transitions[PARSER_STATE_COUNT]
+                            [APT::CJsonToken::JSON_NULL + 1]; /**< \brief
+        Represents the transition of every state and token type */
+  } transitionTable_t; /**< \brief Represents the parser state machine */
+
+  typedef enum {
+    NAME_ATTRIBUTE,        /**< \brief Represents the name attribute */
+    LATITUDE_ATTRIBUTE,    /**< \brief Represents the latitude attribute */
+    LONGITUDE_ATTRIBUTE,   /**< \brief Represents the longitude attribute */
+    DESCRIPTION_ATTRIBUTE, /**< \brief Represents the description attribute */
+    TYPE_ATTRIBUTE,        /**< \brief Represents the type attribute */
+    NO_ATTRIBUTE /**< \brief Represents an unknown attribute, also the number
+                    of attributes */
+  } attribute_t; /**< \brief Represents the attribute names of the database
+                    objects */
+
   typedef enum {
     WP_DB,     /**< \brief Represents the Waypoint Database */
     POI_DB,    /**< \brief Represents the POI Database */
@@ -87,9 +132,14 @@ private:
         description;     /**< \brief Represents the description of the poi */
     CPOI::t_poi poiType; /**< \brief Represents the type of the poi */
     bool isValid;        /**< \brief Represents if the data is valid */
-                         /**
-                          * Resets the contents of the data .
-                          */
+    std::string_view nameText; /**< \brief Represents the name in the text
+                                  of the scanner, only valid with
+                                  CJsonIndexScanner */
+    std::string_view descriptionText; /**< \brief Represents the
+                                         description, see nameText */
+                                      /**
+                                       * Resets the contents of the data .
+                                       */
     void reset() {
       latitude = 0;
       longitude = 0;
@@ -97,6 +147,8 @@ private:
       name = DEFAULT_STRING;
       isValid = true;
       description = DEFAULT_STRING;
+      nameText = std::string_view();
+      descriptionText = std::string_view();
     }
     /**
      * Constructor which resets the contents of the data .
@@ -110,8 +162,8 @@ private:
         currentState; /**< \brief Represents the current state of the state
                          machine*/
     db_type_t dbType; /**< \brief Represents the type of database*/
-    std::string
-        parameter;  /**< \brief Represents the type of parameter found in the
+    attribute_t
+        attribute;  /**< \brief Represents the attribute found in the
                        previous iteration*/
     bool dataReady; /**< \brief Set if all the data is extracted and ready*/
                     /**
@@ -120,22 +172,97 @@ private:
     __stateInfo() {
       currentState = CJsonPersistence::IS_WAITING_FOR_FIRST_TOKEN;
       dbType = CJsonPersistence::UNKNOWN_DB;
+      attribute = CJsonPersistence::NO_ATTRIBUTE;
       dataReady = false;
     }
   } stateInfo_t;
 
+  typedef struct {
+    APT::CJsonToken::TokenType valueType; /**< \brief Represents the token
+                                             type of the value */
+    bool (*assign)(const APT::CJsonToken &token, data_t &data,
+                   error_data_t &errorData); /**< \brief Represents the
+                                                assignment of the value, NULL
+                                                if the database has no such
+                                                attribute */
+  } attributeHandler_t; /**< \brief Represents the handling of an attribute
+                           value */
+
+  typedef enum {
+    WAYPOINT_ENTRY, /**< \brief Represents a Waypoint of the segment */
+    POI_ENTRY,      /**< \brief Represents a POI of the segment */
+    MESSAGE_ENTRY   /**< \brief Represents a diagnostic of the segment */
+  } entry_t;        /**< \brief Represents the kinds of segment entries */
+
+  typedef struct {
+    entry_t type; /**< \brief Represents the kind of the entry */
+    size_t index; /**< \brief Represents the index in the vector of the
+                     kind */
+  } segmentEntry_t; /**< \brief Represents an entry of a segment in file
+                       order */
+
+  typedef struct {
+    CDiagnostics::category_t category; /**< \brief Represents the category */
+    std::string text;                  /**< \brief Represents the message */
+  } message_t; /**< \brief Represents a diagnostic kept for the merge */
+
+  typedef struct __segment {
+    size_t begin;     /**< \brief Represents the offset of the segment */
+    int firstLine;    /**< \brief Represents the line of the offset */
+    db_type_t dbType; /**< \brief Represents the database of the array the
+                         segment starts in */
+    stateInfo_t stateInfo; /**< \brief Represents the state of the parser,
+                              at the end after the segment is parsed */
+    CWpDatabase *pWpDb;   /**< \brief Represents the databases the records
+                             are added to, NULL if they are kept */
+    CPoiDatabase *pPoiDb; /**< \brief Represents the POI database, see
+                             pWpDb */
+    CJsonView *pView; /**< \brief Represents the view the records are added
+                         to instead, NULL if none */
+    std::deque<CWpDatabase::node_t>
+        waypoints; /**< \brief Represents the kept Waypoints, as entries
+                      which the merge moves into the Database */
+    std::deque<CPoiDatabase::node_t>
+        pois; /**< \brief Represents the kept POIs, see waypoints */
+    std::vector<message_t> messages;  /**< \brief Represents the kept
+                                         diagnostics */
+    std::vector<segmentEntry_t>
+        entries; /**< \brief Represents the kept entries in file order */
+    bool isRead; /**< \brief Represents the result of the parsing */
+    bool isAborted; /**< \brief Set if the parsing stopped in the segment */
+    /**
+     * Constructor of a segment at the start of the text whose records are
+     * kept
+     */
+    __segment()
+        : begin(0), firstLine(1), dbType(UNKNOWN_DB), pWpDb(NULL),
+          pPoiDb(NULL), pView(NULL), isRead(true), isAborted(false) {}
+  } segment_t; /**< \brief Represents a part of the file which is parsed by
+                  one thread */
+
+  static const transitionTable_t
+      s_transitionTable; /**< \brief Represents the parser state machine */
+  static const attributeHandler_t
+      s_attributeHandlers[UNKNOWN_DB + 1]
+                         [NO_ATTRIBUTE]; /**< \brief Represents the attribute
+                                            dispatch table of every database */
+
   std::string m_mediaName; /**< \brief Represents Media Name*/
   std::string
       m_fileName; /**< \brief Represents Waypoint File Name (with path)*/
-  StringVector jsonFileContents; /**< \brief Represents a Vector of strings to
-                                    hold the json file contents */
   /* Copy constructor and copy assignment operators are
    * not used */
   CJsonPersistence(CJsonPersistence &);
   CJsonPersistence &operator=(CJsonPersistence &);
 
 public:
-  CJsonPersistence(){};
+  typedef enum {
+    FLEX_SCANNER, /**< \brief Represents the flex scanner reading a stream */
+    INDEX_SCANNER /**< \brief Represents the SIMD structural index scanner
+                     over the mapped file */
+  } scanner_t;    /**< \brief Represents the scanner backends of readData */
+
+  CJsonPersistence() : m_scanner(FLEX_SCANNER), m_threadCount(1){};
 
   virtual ~CJsonPersistence(){};
   /**
@@ -146,6 +273,32 @@ public:
    * @param name the media to be used
    */
   void setMediaName(std::string name);
+  /**
+   * Get the files of the media which writeData() replaces
+   *
+   * @param fileNames the names of the files (with path)
+   */
+  void getMediaFiles(std::vector<std::string> &fileNames) const;
+  /**
+   * Selects the scanner backend used by readData(). FLEX_SCANNER is the
+   * default; INDEX_SCANNER maps the file and finds the structural
+   * characters with SIMD before the tokens are delivered, which is faster
+   * on large files. Both deliver the same tokens and line numbers.
+   *
+   * @param scanner the scanner backend
+   */
+  void setScanner(scanner_t scanner);
+  /**
+   * Sets the number of threads which parse a file. With more than one
+   * thread, the file is mapped and a pre-scan cuts the waypoint and POI
+   * arrays into segments of whole objects, which are parsed with
+   * CJsonIndexScanner on a CThreadPool. The records and messages are still
+   * stored and written in file order, with the same line numbers.
+   *
+   * @param threadCount the number of threads, 0 uses one thread per core,
+   * 1 parses on the calling thread with the selected scanner (default)
+   */
+  void setThreadCount(unsigned int threadCount);
   /**
    * Write the data to the persistent storage.
    *
@@ -169,8 +322,147 @@ public:
    * @return true if the data could be read successfully
    */
   bool readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb, MergeMode mode);
+  /**
+   * Lazy load mode: maps the file into the view and records the valid
+   * waypoints and POIs without creating any CWaypoint or CPOI. Only the
+   * coordinates and the POI type are parsed; names and descriptions are
+   * kept as their offsets in the file and copied when the view is asked
+   * for them. Invalid objects are reported and skipped like by readData(),
+   * but duplicate names are not checked.
+   *
+   * @param view[OUT] the view, its previous records are removed
+   * @return true if the data could be read successfully
+   */
+  bool readView(CJsonView &view);
 
 private:
+  scanner_t m_scanner; /**< \brief Represents the scanner backend of
+                          readData */
+  unsigned int m_threadCount; /**< \brief Represents the threads parsing a
+                                 file, 0 for one per core */
+  /**
+   * Feeds the tokens of the scanner through the state machine, starting in
+   * the state of the segment, and adds the extracted data to the databases
+   * of the segment or keeps it in the segment
+   *
+   * @param Scanner& scannerObj [IN] - APT::CJsonScanner or CJsonIndexScanner
+   * @param segment_t& segment [IN/OUT] - The segment which is parsed
+   * @return true if the data could be read successfully
+   */
+  template <class Scanner>
+  bool parseTokens(Scanner &scannerObj, segment_t &segment);
+  /**
+   * Pre-scan of the text: finds the objects of the waypoint and POI arrays
+   * and starts a segment at an object about every text size / segmentCount
+   * bytes. Only quotes, brackets and line breaks are looked at.
+   *
+   * @param std::string_view text [IN] - The JSON text
+   * @param size_t segmentCount [IN] - The number of segments aimed at
+   * @param std::deque<segment_t>& segments [OUT] - The segments, the first
+   * one starts at the begin of the text
+   * @return None
+   */
+  void findSegments(std::string_view text, size_t segmentCount,
+                    std::deque<segment_t> &segments);
+  /**
+   * Parses the segments of the text on a thread pool and merges them into
+   * the databases in file order
+   *
+   * @param std::string_view text [IN] - The JSON text
+   * @param unsigned int threadCount [IN] - The number of threads
+   * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+   * @param CPoiDatabase& poiDb [OUT] - The POI Database
+   * @return true if the data could be read successfully
+   */
+  bool readSegments(std::string_view text, unsigned int threadCount,
+                    CWpDatabase &waypointDb, CPoiDatabase &poiDb);
+  /**
+   * Adds the kept records to the databases and writes the kept messages in
+   * file order, then releases them
+   *
+   * @param segment_t& segment [IN/OUT] - The parsed segment
+   * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+   * @param CPoiDatabase& poiDb [OUT] - The POI Database
+   * @return None
+   */
+  static void mergeSegment(segment_t &segment, CWpDatabase &waypointDb,
+                           CPoiDatabase &poiDb);
+  /**
+   * Checks if the parser is in the state of the begin of an object in the
+   * array of the database, the state a segment is parsed from
+   *
+   * @param const stateInfo_t& stateInfo [IN] - The state of the parser
+   * @param db_type_t dbType [IN] - The database of the array
+   * @return true if the state is the one at the begin of an object
+   */
+  static bool isObjectBegin(const stateInfo_t &stateInfo, db_type_t dbType);
+  /**
+   * Scans a text which only holds well-formed, valid objects directly into
+   * the view, without the scanner and the state machine
+   *
+   * @param std::string_view text [IN] - The JSON text of the view
+   * @param CJsonView& view [OUT] - The view
+   * @return true if the whole text is scanned, false if it holds anything
+   * the parser would report (the view then holds a part of the records)
+   */
+  bool scanView(std::string_view text, CJsonView &view);
+  /**
+   * Scans the attributes of an object after its begin, see scanView()
+   *
+   * @param std::string_view text [IN] - The JSON text of the view
+   * @param size_t& position [IN/OUT] - The position in the text, after the
+   * object if it is scanned
+   * @param db_type_t dbType [IN] - The database of the array
+   * @param data_t& data [OUT] - The data of the object, reset before
+   * @return true if the object is valid and complete
+   */
+  bool scanViewObject(std::string_view text, size_t &position,
+                      db_type_t dbType, data_t &data);
+  /**
+   * Gets the record of the data for a view
+   *
+   * @param const data_t& data [IN] - The data, its strings in the text
+   * @param std::string_view text [IN] - The JSON text of the view
+   * @return CJsonView::record_t - The record
+   */
+  static CJsonView::record_t getViewRecord(const data_t &data,
+                                           std::string_view text);
+  /**
+   * Checks if the records and messages of the segment are kept for the
+   * merge
+   *
+   * @param const segment_t& segment [IN] - The segment being parsed
+   * @return true if they are kept, false if they are added and written
+   */
+  static bool isKept(const segment_t &segment)
+  {
+    return (NULL == segment.pWpDb) && (NULL == segment.pView);
+  }
+  /**
+   * Checks if a message of the category is written, which is counted at
+   * once for a segment added to the databases and at the merge otherwise
+   *
+   * @param const segment_t& segment [IN] - The segment being parsed
+   * @param CDiagnostics::category_t category [IN] - The category
+   * @return true if the message is to be written
+   */
+  static bool isReported(const segment_t &segment,
+                         CDiagnostics::category_t category)
+  {
+    return isKept(segment) || (CDiagnostics::NOTICE == category) ||
+           CDiagnostics::count(category);
+  }
+  /**
+   * Writes the message or keeps it in the segment
+   *
+   * @param segment_t& segment [IN/OUT] - The segment being parsed
+   * @param CDiagnostics::category_t category [IN] - The category
+   * @param std::string_view text [IN] - The message
+   * @return None
+   */
+  static void writeMessage(segment_t &segment,
+                           CDiagnostics::category_t category,
+                           std::string_view text);
   /**
    * State machine handling the read operation
    *
@@ -178,32 +470,75 @@ private:
    * Json file
    * @param stateInfo_t& stateInfo:[OUT]the Reference to the structure
    * containing the attributes of the current state
-   * @return None
+   * @param error_data_t& errorData:[OUT] the error raised by the token
+   * @return true if the token is accepted, false if an error is raised
    */
-  void processStateChange(APT::CJsonToken *currentToken,
-                          stateInfo_t &stateInfo);
+  bool processStateChange(APT::CJsonToken *currentToken,
+                          stateInfo_t &stateInfo, error_data_t &errorData);
   /**
-   * Gets the parameter name and assigns it to out based on the database type
+   * Builds the transition table of the parser state machine
+   *
+   * @return transitionTable_t - The transition of every state and token type
+   */
+  static transitionTable_t buildTransitionTable(void);
+  /**
+   * Resolves an attribute name through a perfect hash
+   *
+   * @param std::string_view name: [IN] the attribute name
+   * @return attribute_t - The attribute, NO_ATTRIBUTE if unknown
+   */
+  static attribute_t findAttribute(std::string_view name);
+  /**
+   * Fills the error raised by the state machine
+   *
+   * @param error_data_t& errorData: [OUT] the error
+   * @param const char* errorMsg: [IN] the error message
+   * @param bool isFatal: [IN] if the parsing must be aborted
+   * @return false, to be returned by the raising method
+   */
+  static bool raiseError(error_data_t &errorData, const char *errorMsg,
+                         bool isFatal);
+  /**
+   * Assignments of the attribute values, they raise an error if the value
+   * is invalid or repeated
+   *
+   * @param const APT::CJsonToken& token: [IN] the value token
+   * @param data_t& data: [OUT] the data of the database object
+   * @param error_data_t& errorData: [OUT] the error if the value is invalid
+   * @return true if the value is assigned, false otherwise
+   */
+  static bool assignName(const APT::CJsonToken &token, data_t &data,
+                         error_data_t &errorData);
+  static bool assignLatitude(const APT::CJsonToken &token, data_t &data,
+                             error_data_t &errorData);
+  static bool assignLongitude(const APT::CJsonToken &token, data_t &data,
+                              error_data_t &errorData);
+  static bool assignDescription(const APT::CJsonToken &token, data_t &data,
+                                error_data_t &errorData);
+  static bool assignType(const APT::CJsonToken &token, data_t &data,
+                         error_data_t &errorData);
+  /**
+   * Gets the attribute of the parameter name based on the database type
    *
    * @param db_type_t& db: [IN] the Reference to the current database which is
    * extracted from json file
-   * @param std::string& in: [IN] the Reference to the current input Token
-   * extracted from the Json file
-   * @param std::string& out:[OUT]the Reference to the type of the parameter
+   * @param std::string_view in: [IN] the current input Token extracted from
+   * the Json file
+   * @param attribute_t& out:[OUT]the Reference to the attribute
    * @return true if the database and parameter is a valid one, false otherwise
    */
-  bool checkAndExtractParameterName(const db_type_t &db, const std::string &in,
-                                    std::string &out);
+  bool checkAndExtractParameterName(const db_type_t &db, std::string_view in,
+                                    attribute_t &out);
   /**
    * Checks if the given db is valid or not
    *
    * @param db_type_t& db: [OUT] the Reference to the current database which is
    * extracted from json file
-   * @param std::string& dbName: [IN] the Reference to the current database
-   * string extracted from the Json file
+   * @param std::string_view dbName: [IN] the current database string
+   * extracted from the Json file
    * @return true if the database is a valid one, false otherwise
    */
-  bool isValidDb(const std::string &dbName, db_type_t &dbType);
+  bool isValidDb(std::string_view dbName, db_type_t &dbType);
   /**
    * Checks if the Parsing of data is completed
    *
@@ -213,97 +548,20 @@ private:
    */
   bool isDataParseComplete(const stateInfo_t &stateInfo);
   /**
-   * Writes the member data(jsonFileContents) to the Json File
-   * @return true if the write is successful, false otherwise
-   */
-  bool writeToJsonFile();
-  /**
-   * Converts the data to json compatible format
-   *
-   * @param std::map<std::string, DataType>& dataMap: [IN] the Reference to the
-   * Map containing the Data contents (Wp Data or POI Data)
+   * Appends the Waypoint as an object of the waypoints array
+   * @param CBufferedWriter& file [OUT] - The file written to
+   * @param const CWaypoint& wp [IN] - The Waypoint
    * @return None
    */
-  template <class DataType>
-  void convertToJsonFormat(const std::map<std::string, DataType> &dataMap) {
-    size_t count = 1;
-    for (typename std::map<std::string, DataType>::const_iterator
-             itr = dataMap.begin();
-         itr != dataMap.end(); ++itr, ++count) {
-      DataType dataType = itr->second;
-      formatJsonData(dataType);
-      (count == dataMap.size()) ? jsonFileContents.push_back("\t  }")
-                                : jsonFileContents.push_back("\t  },");
-    }
-  }
-  /**
-   * Formats the data to json compatible format with necessary tabs and quotes
-   *
-   * @param std::string parameter: [IN] the parameter in the database
-   * @param std::string& value: [IN] the value representing the string/number
-   * @param bool isNumber: [IN] if the input is a number, quotes will not be
-   * applied to it
-   * @return string - Modified string
-   */
-  inline std::string to_json_attributes(std::string parameter,
-                                        std::string &value,
-                                        bool isNumber = false) {
-    std::string result = DOUBLE_TAB_STRING + QUOTE_STRING + parameter +
-                         QUOTE_STRING + COLON_STRING;
-    if (!isNumber) {
-      result += QUOTE_STRING + value + QUOTE_STRING;
-    } else {
-      result += value;
-    }
-    return result;
-  }
+  void appendWaypointObject(CBufferedWriter &file, const CWaypoint &wp);
   /**
-   * Fills the jsonContents after formatting the data
-   *
-   * @param Database& databaseObj: [IN] the Reference to the Database object -
-   * WaypointDb or POIDb
-   * @return None
+   * Appends the POI as an object of the pois array
+   * @param CBufferedWriter& file [OUT] - The file written to
+   * @param const CPOI& poi [IN] - The POI
+   * @return true if the POI is appended, false if its type is invalid (the
+   * type is written empty)
    */
-  template <typename Database> void formatJsonData(Database &databaseObj) {
-    CPOI *poiPtr = dynamic_cast<CPOI *>(&databaseObj);
-    jsonFileContents.push_back("\t  {");
-
-    double latitude = databaseObj.getLatitude();
-    double longitude = databaseObj.getLongitude();
-
-    std::string nameStr = databaseObj.getName();
-    std::string jsonName = to_json_attributes("name", nameStr) + COMA_STRING;
-    jsonFileContents.push_back(jsonName);
-
-    std::string latitudeStr = type_mapping::to_string(latitude);
-    std::string jsonLatitudeStr =
-        to_json_attributes("latitude", latitudeStr, true) + COMA_STRING;
-    jsonFileContents.push_back(jsonLatitudeStr);
-
-    std::string longitudeStr = type_mapping::to_string(longitude);
-    std::string jsonLongitudeStr =
-        to_json_attributes("longitude", longitudeStr, true);
-    if (poiPtr != NULL)
-      jsonLongitudeStr += COMA_STRING;
-
-    jsonFileContents.push_back(jsonLongitudeStr);
-
-    if (poiPtr) {
-      std::string poiType;
-      /* Convert the POI Type to String to be stored in the POI file */
-      if (!type_mapping::convertPoiTypeToString(poiPtr->getType(), poiType)) {
-        std::cout << "ERROR!JSON::writeData() failed! Invalid POI Type!"
-                  << std::endl;
-      }
-      std::string descriptionData = poiPtr->getDescription();
-      std::string jsonDescription =
-          to_json_attributes("description", descriptionData) + COMA_STRING;
-      jsonFileContents.push_back(jsonDescription);
-
-      std::string jsonPoi = to_json_attributes("type", poiType);
-      jsonFileContents.push_back(jsonPoi);
-    }
-  }
+  bool appendPoiObject(CBufferedWriter &file, const CPOI &poi);
 };
 
 #endif // CJSON_PERSISTENCE_H
@@ -24,8 +24,9 @@ class CJsonScanner : private jsonFlexLexer {
 private:
   /**
    * @link aggregationByValue
+   * The token which is filled in place for every token of the input.
    */
-  CJsonToken *token;
+  CJsonToken token;
 
   /** @link dependency */
   /*# CJsonToken lnkCJsonToken; */
@@ -45,13 +46,28 @@ public:
 
   /**
    * Returns the next token from the input. The pointer returned points
-   * to an object managed by this class. It is only valid until the next
-   * invocation of the method.
+   * to an object managed by this class. It (and a string value, which is
+   * a view into the input buffer) is only valid until the next invocation
+   * of the method.
    *
-   * If the input is exhausted, the method returns 0.
+   * If the input is exhausted, the method returns 0. An illegal character
+   * is thrown as std::string.
    */
   CJsonToken *nextToken();
 
+  /**
+   * Returns the next token like nextToken(), but does not throw. For an
+   * illegal character the method returns 0 and sets isIllegal;
+   * illegalChar() then returns the character.
+   */
+  CJsonToken *nextToken(bool &isIllegal);
+
+  /**
+   * Return the illegal character found by the last invocation of
+   * nextToken().
+   */
+  std::string illegalChar();
+
   /**
    * Return the line number of the input where last token (returned
    * by nextToken()) was found.
@@ -8,14 +8,16 @@
 #ifndef MYCODE_CJSONTOKEN_H_
 #define MYCODE_CJSONTOKEN_H_
 
-#include <sstream>
 #include <string>
+#include <string_view>
 
 namespace APT {
 
 /**
- * This is the base class for all tokens. It provides the
- * token type.
+ * A token of the JSON input: the token type and, depending on the type,
+ * its string, number or bool(ean) value. The scanner fills one token in
+ * place for every token of the input, so no token is allocated; a string
+ * value is a view into the buffer of the scanner.
  */
 class CJsonToken {
 public:
@@ -36,66 +38,69 @@ public:
     JSON_NULL
   };
 
-  CJsonToken(TokenType type);
-  virtual ~CJsonToken();
+  CJsonToken();
 
   /**
    * Return the type of the token.
    */
-  TokenType getType();
+  TokenType getType() const { return type; }
 
   /**
-   * Allow convertion to string.
+   * Return the value of a STRING token without the quotes. The view is
+   * only valid until the scanner reads the next token.
    */
-  virtual std::string str();
+  std::string_view getString() const { return text; }
 
-private:
-  TokenType type;
-};
+  /**
+   * Return the value of a NUMBER token.
+   */
+  double getNumber() const { return number; }
 
-/**
- * This template is used to define special tokens that have an associated
- * value of the given type. This is not intended to be used by programmers.
- * Use the derived types CJsonStringToken, CJsonNumberToken and
- * CJsonBoolToken instead.
- */
-template <CJsonToken::TokenType tokenType, class T>
-class CJsonValueToken : public CJsonToken {
-private:
-  T value;
+  /**
+   * Return the value of a BOOL token.
+   */
+  bool getBool() const { return boolean; }
 
-public:
   /**
-   * Create a token with the given value.
+   * Make the token a token without value of the given type.
    */
-  CJsonValueToken(T value) : CJsonToken(tokenType) { this->value = value; }
+  void set(TokenType type) { this->type = type; }
 
   /**
-   * Return the value associated with the token.
+   * Make the token a STRING token with the given value.
    */
-  T getValue() const { return value; }
+  void setString(std::string_view text) {
+    type = STRING;
+    this->text = text;
+  }
 
-  std::string str() {
-    std::ostringstream res;
-    res << CJsonToken::str() << ": " << value;
-    return res.str();
+  /**
+   * Make the token a NUMBER token with the given value.
+   */
+  void setNumber(double number) {
+    type = NUMBER;
+    this->number = number;
   }
-};
 
-/**
- * A string token associated with a string value.
- */
-typedef CJsonValueToken<CJsonToken::STRING, std::string> CJsonStringToken;
+  /**
+   * Make the token a BOOL token with the given value.
+   */
+  void setBool(bool boolean) {
+    type = BOOL;
+    this->boolean = boolean;
+  }
 
-/**
- * A number token associated with a double value.
- */
-typedef CJsonValueToken<CJsonToken::NUMBER, double> CJsonNumberToken;
+  /**
+   * Allow convertion to string.
+   */
+  std::string str() const;
 
-/**
- * A bool(ean) token associated with a bool(ean).
- */
-typedef CJsonValueToken<CJsonToken::BOOL, bool> CJsonBoolToken;
+private:
+  TokenType type;
+  std::string_view text;
+  double number;
+  bool boolean;
+};
 
 } /* namespace APT */
 
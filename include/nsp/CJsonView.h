@@ -0,0 +1,148 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonView.H
+* Author          : Jishnu M Thampan
+* Description     : class CJsonView
+*                   Lazy view of the waypoints and POIs of a mapped JSON
+*                   file, which only holds the coordinates, the POI types
+*                   and the positions of the strings.
+****************************************************************************/
+#ifndef CJSON_VIEW_H
+#define CJSON_VIEW_H
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CMappedFile.h"
+#include "CPOI.h"
+#include "CWaypoint.h"
+
+/**
+ * CJsonView is filled by CJsonPersistence::readView(). It keeps the file
+ * mapped and stores one record per valid waypoint or POI in file order:
+ * the coordinates and the type are parsed, the name and the description
+ * are only the byte offset and length of the string in the file. A string
+ * is copied when it is read through getName() or getDescription(), a
+ * CWaypoint or CPOI only when it is requested, so jobs which only use the
+ * coordinates never touch the strings.
+ *
+ * The records are not checked for duplicate names, the view holds every
+ * valid object of the file. The strings are the raw JSON text, like the
+ * ones stored by readData().
+ */
+class CJsonView {
+public:
+  typedef struct {
+    double latitude;          /**< \brief Represents the latitude */
+    double longitude;         /**< \brief Represents the longitude */
+    size_t nameOffset;        /**< \brief Represents the name in the file */
+    size_t nameLength;        /**< \brief Represents the name length */
+    size_t descriptionOffset; /**< \brief Represents the description in the
+                                 file, 0 for a waypoint */
+    size_t descriptionLength; /**< \brief Represents the description
+                                 length, 0 for a waypoint */
+    CPOI::t_poi type; /**< \brief Represents the type, UNKNOWN for a
+                         waypoint */
+  } record_t;         /**< \brief Represents an object of the file */
+
+private:
+  CMappedFile m_file; /**< \brief Represents the mapped JSON file */
+  std::vector<record_t>
+      m_waypoints; /**< \brief Represents the waypoints in file order */
+  std::vector<record_t> m_pois; /**< \brief Represents the POIs in file
+                                   order */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CJsonView(CJsonView &);
+  CJsonView &operator=(CJsonView &);
+
+public:
+  CJsonView() {}
+  /**
+   * Maps the file and removes the records of a previous file
+   * @param const std::string& fileName [IN] - Name of the JSON file
+   * @return true if the file could be mapped, false otherwise
+   */
+  bool open(const std::string &fileName);
+  /**
+   * Removes the records and releases the mapping
+   * @param None
+   * @return None
+   */
+  void close(void);
+  /**
+   * Removes the records, the file stays mapped
+   * @param None
+   * @return None
+   */
+  void clearRecords(void);
+  /**
+   * Gets the text of the mapped file
+   */
+  std::string_view getText(void) const
+  {
+    return std::string_view(m_file.getData(), m_file.getSize());
+  }
+  /**
+   * Appends a record, used by CJsonPersistence::readView()
+   * @param const record_t& record [IN] - The record of a waypoint or POI
+   * @return None
+   */
+  void addWaypoint(const record_t &record) { m_waypoints.push_back(record); }
+  void addPoi(const record_t &record) { m_pois.push_back(record); }
+
+  size_t getWaypointCount(void) const { return m_waypoints.size(); }
+  size_t getPoiCount(void) const { return m_pois.size(); }
+  /**
+   * Gets a record, the index must be below the count
+   */
+  const record_t &getWaypoint(size_t index) const
+  {
+    return m_waypoints[index];
+  }
+  const record_t &getPoi(size_t index) const { return m_pois[index]; }
+  /**
+   * Gets the name or description of a record as a view into the file,
+   * without copying it. The view is valid while the file is mapped.
+   * @param const record_t& record [IN] - A record of this view
+   * @return std::string_view - The string
+   */
+  std::string_view getNameView(const record_t &record) const
+  {
+    return getText().substr(record.nameOffset, record.nameLength);
+  }
+  std::string_view getDescriptionView(const record_t &record) const
+  {
+    return getText().substr(record.descriptionOffset,
+                            record.descriptionLength);
+  }
+  /**
+   * Materializes the name or description of a record
+   * @param const record_t& record [IN] - A record of this view
+   * @return std::string - A copy of the string
+   */
+  std::string getName(const record_t &record) const
+  {
+    return std::string(getNameView(record));
+  }
+  std::string getDescription(const record_t &record) const
+  {
+    return std::string(getDescriptionView(record));
+  }
+  /**
+   * Materializes a waypoint or POI of the view
+   * @param size_t index [IN] - Index of the record
+   * @return CWaypoint / CPOI - The object as readData() stores it
+   */
+  CWaypoint getWaypointObject(size_t index) const;
+  CPOI getPoiObject(size_t index) const;
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CJSON_VIEW_H
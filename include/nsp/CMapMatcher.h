@@ -0,0 +1,213 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CMapMatcher.H
+* Author          : Jishnu M Thampan
+* Description     : class CMapMatcher
+*                   Snaps a sequence of noisy GPS fixes to the most likely
+*                   sequence of Waypoints of a CRoutingGraph. Works on a
+*                   whole recorded trace or online, fix by fix.
+****************************************************************************/
+#ifndef CMAP_MATCHER_H
+#define CMAP_MATCHER_H
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "CRoutingGraph.h"
+#include "CWaypoint.h"
+
+/**
+ * CMapMatcher is a hidden Markov model whose hidden states are the nodes
+ * of the routing graph. The candidates of a fix are the nodes within the
+ * search radius, found through a uniform grid over the nodes. A candidate
+ * is scored by its distance to the fix (gaussian GPS noise) and every
+ * transition by the difference between the route length of the two
+ * candidates and the great-circle distance of the two fixes (exponential
+ * distribution). The most likely sequence is found with the Viterbi
+ * algorithm in log space.
+ *
+ * Undecided fixes are kept in a window. As soon as the best paths of all
+ * candidates of the newest fix run through the same candidate of an older
+ * fix, that fix and all fixes before it are final. In online mode a fix is
+ * additionally decided once it is maxLag fixes old, which bounds the
+ * latency at the cost of an occasional suboptimal decision.
+ *
+ * A fix without candidates, or without any connected candidate, breaks
+ * the chain: the window is decided and matching starts again. Fixes
+ * without candidates are matched to INVALID_NODE.
+ */
+class CMapMatcher {
+public:
+  typedef CRoutingGraph::node_t node_t;
+  typedef CRoutingGraph::edge_t edge_t;
+
+  typedef struct {
+    double searchRadius;        /**< \brief Represents the largest distance
+                                   of a candidate from its fix in km */
+    double gpsSigma;            /**< \brief Represents the standard deviation
+                                   of the GPS noise in km */
+    double transitionBeta;      /**< \brief Represents the mean difference of
+                                   route and fix distance in km */
+    unsigned int maxCandidates; /**< \brief Represents the candidates kept
+                                   per fix */
+    unsigned int maxLag; /**< \brief Represents the age in fixes at which a
+                            fix is decided in online mode, 0 for none */
+  } matchParameters_t;   /**< \brief Represents the model parameters */
+
+private:
+  typedef struct {
+    double sinLatitude;  /**< \brief Represents the sine of the latitude */
+    double cosLatitude;  /**< \brief Represents the cosine of the latitude */
+    double longitudeRad; /**< \brief Represents the longitude in radian */
+    node_t node;         /**< \brief Represents the node of the graph */
+  } gridEntry_t;         /**< \brief Represents a node sorted into a cell */
+
+  typedef struct {
+    node_t node;         /**< \brief Represents the candidate node */
+    double distance;     /**< \brief Represents the distance to the fix */
+    double score;        /**< \brief Represents the log probability of the
+                            best path ending in this candidate */
+    unsigned int parent; /**< \brief Represents the candidate of the
+                            previous fix on that path */
+  } candidate_t;         /**< \brief Represents a hidden state of a fix */
+
+  typedef struct {
+    double sinLatitude;  /**< \brief Represents the sine of the latitude */
+    double cosLatitude;  /**< \brief Represents the cosine of the latitude */
+    double longitudeRad; /**< \brief Represents the longitude in radian */
+    std::vector<candidate_t> candidates; /**< \brief Represents the
+                                            candidates of the fix */
+  } step_t; /**< \brief Represents an undecided fix */
+
+  typedef std::pair<double, node_t> queueEntry_t;
+
+  const CRoutingGraph *m_pGraph; /**< \brief Represents the matched graph */
+  matchParameters_t m_parameters; /**< \brief Represents the parameters */
+
+  /* Uniform grid over the nodes, see CSpatialGrid */
+  std::vector<gridEntry_t> m_entries;
+  std::vector<unsigned int> m_cellOffsets;
+  double m_minLatitude;
+  double m_minLongitude;
+  double m_cellSize;
+  unsigned int m_rows;
+  unsigned int m_columns;
+
+  std::deque<step_t> m_window;  /**< \brief Represents the undecided fixes */
+  std::deque<node_t> m_matches; /**< \brief Represents the decided fixes
+                                   which are not fetched yet */
+
+  /* Workspace of the route length searches, reset lazily by stamp */
+  std::vector<double> m_cost;
+  std::vector<unsigned int> m_visitStamp;
+  std::vector<unsigned int> m_settledStamp;
+  std::vector<unsigned int> m_targetStamp;
+  std::vector<unsigned int> m_targetIndex;
+  unsigned int m_currentStamp;
+  std::vector<queueEntry_t> m_openList;
+  std::vector<double> m_routeLength; /* Per candidate of the newest fix */
+  std::vector<unsigned int> m_liveCandidates;
+  std::vector<node_t> m_backtrack;
+
+  /**
+   * Sorts the nodes of the graph into the grid
+   */
+  void buildGrid(void);
+  /**
+   * Collects the candidates of a fix, nearest first
+   */
+  void findCandidates(double latitude, double longitude, step_t &step) const;
+  /**
+   * Computes the route lengths from a node to all candidates of a fix
+   */
+  void findRouteLengths(node_t source, const step_t &step, double maxLength);
+  /**
+   * Adds a fix to the model and decides the fixes which became final
+   */
+  void processFix(double latitude, double longitude, unsigned int maxLag);
+  /**
+   * Decides the oldest fixes up to and including the given window
+   * position, following the best path back from the given candidate
+   */
+  void decide(size_t windowPos, unsigned int candidate);
+  /**
+   * Decides all fixes of the window
+   */
+  void decideAll(void);
+  /**
+   * Decides the fixes on which all best paths agree
+   */
+  void decideConverged(void);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CMapMatcher(CMapMatcher &);
+  CMapMatcher &operator=(CMapMatcher &);
+
+public:
+  /**
+   * Constructor of CMapMatcher class, uses the default parameters
+   * @param const CRoutingGraph& graph [IN] - The finalized graph to be
+   * matched onto. It must outlive the CMapMatcher object.
+   */
+  CMapMatcher(const CRoutingGraph &graph);
+  /**
+   * Sets the model parameters and resets the online state
+   * @param const matchParameters_t& parameters [IN] - The parameters
+   * @return true if the parameters are valid, false otherwise
+   */
+  bool setParameters(const matchParameters_t &parameters);
+  const matchParameters_t &getParameters(void) const { return m_parameters; }
+  /**
+   * Matches a whole trace. The result is the exact Viterbi path, maxLag is
+   * not applied.
+   * @param const double* latitudes [IN] - Latitudes of the fixes
+   * @param const double* longitudes [IN] - Longitudes of the fixes
+   * @param size_t count [IN] - Number of fixes
+   * @param std::vector<node_t>& nodes [OUT] - Matched node of every fix,
+   * INVALID_NODE if the fix has no candidate
+   * @return None
+   */
+  void match(const double *latitudes, const double *longitudes, size_t count,
+             std::vector<node_t> &nodes);
+  /**
+   * Adds the next fix of an online trace
+   * @param double latitude [IN] - Latitude of the fix
+   * @param double longitude [IN] - Longitude of the fix
+   * @return None
+   */
+  void addFix(double latitude, double longitude);
+  /**
+   * Adds the next fix of an online trace, e.g. from CGPSSensor
+   * @param const CWaypoint& fix [IN] - The fix
+   * @return None
+   */
+  void addFix(const CWaypoint &fix);
+  /**
+   * Fetches the match of the oldest decided fix of the online trace
+   * @param node_t& node [OUT] - Matched node, INVALID_NODE if the fix has
+   * no candidate
+   * @return true if a decided fix was available, false otherwise
+   */
+  bool getMatch(node_t &node);
+  /**
+   * Decides all pending fixes, e.g. at the end of a trace
+   * @param None
+   * @return None
+   */
+  void flush(void);
+  /**
+   * Drops all pending and decided fixes
+   * @param None
+   * @return None
+   */
+  void reset(void);
+  /** Number of fixes which are not decided yet */
+  size_t getPendingFixCount(void) const { return m_window.size(); }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CMAP_MATCHER_H
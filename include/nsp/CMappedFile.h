@@ -0,0 +1,71 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CMappedFile.H
+* Author          : Jishnu M Thampan
+* Description     : class CMappedFile
+*                   Maps a file read-only into memory, so that its contents
+*                   can be accessed without copying them.
+****************************************************************************/
+#ifndef CMAPPED_FILE_H
+#define CMAPPED_FILE_H
+
+#include <stddef.h>
+
+#include <string>
+
+/**
+ * CMappedFile is a utility class which maps a whole file read-only into
+ * the address space of the process. The mapping is released when the
+ * object is closed or destroyed.
+ */
+class CMappedFile {
+private:
+  const char *m_pData; /**< \brief Represents the start of the mapping */
+  size_t m_size;       /**< \brief Represents the size of the file */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CMappedFile(CMappedFile &);
+  CMappedFile &operator=(CMappedFile &);
+
+public:
+  CMappedFile();
+  ~CMappedFile();
+  /**
+   * Maps the file into memory. A previously mapped file is released.
+   * @param const std::string& fileName [IN] - Name of the file to be mapped
+   * @return true if the file could be mapped, false otherwise
+   */
+  bool open(const std::string &fileName);
+  /**
+   * Releases the mapping
+   * @param None
+   * @return None
+   */
+  void close(void);
+  /**
+   * Advises the kernel that the mapping will be read sequentially once
+   * @param None
+   * @return None
+   */
+  void adviseSequential(void) const;
+  /**
+   * Checks if a file is mapped
+   * @return true if a file is mapped, false otherwise
+   */
+  bool isOpen(void) const { return (NULL != m_pData); }
+  /**
+   * Gets the start of the mapped contents. An empty file is mapped to a
+   * valid pointer with size 0.
+   */
+  const char *getData(void) const { return m_pData; }
+  /**
+   * Gets the size of the mapped contents in bytes
+   */
+  size_t getSize(void) const { return m_size; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CMAPPED_FILE_H
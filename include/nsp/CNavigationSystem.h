@@ -24,10 +24,14 @@
 #define CNAVIGATIONSYSTEM_H
 
 #include "CCSV.h"
+#include "CContractionHierarchy.h"
 #include "CGPSSensor.h"
 #include "CJsonPersistence.h"
 #include "CPoiDatabase.h"
+#include "CHierarchyRouteFinder.h"
 #include "CRoute.h"
+#include "CRouteFinder.h"
+#include "CRoutingGraph.h"
 #include "CWpDatabase.h"
 /**
  * This class is the controller class for the Navigation
@@ -48,6 +52,9 @@ private:
   CWpDatabase m_WpDatabase;   /**< \brief CWpDatabase object */
   CCSV csv;
   CJsonPersistence cj;
+  CRoutingGraph m_routingGraph; /**< \brief Road network between Waypoints */
+  CContractionHierarchy
+      m_hierarchy; /**< \brief Preprocessed road network for fast queries */
   /* Private Member Functions */
 
   /**
@@ -165,6 +172,10 @@ private:
 
   void TC_readReplaceMode();
 
+  void TC_findShortestRoute();
+
+  void TC_findHierarchyRoute();
+
 public:
   /* Public Member Functions */
 
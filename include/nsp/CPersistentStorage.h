@@ -1,6 +1,8 @@
 
 #ifndef CPERSISTENT_STORAGE_H
 #define CPERSISTENT_STORAGE_H
+#include <string>
+#include <vector>
 #include <nsp/CWpDatabase.h>
 #include <nsp/CPoiDatabase.h>
 class CPersistentStorage {
@@ -14,6 +16,16 @@ public:
   */
   virtual void setMediaName(std::string name) = 0;
   /**
+  * Get the files of the media which writeData() replaces. A storage
+  * which does not name its files returns none.
+  *
+  * @param fileNames the names of the files (with path)
+  */
+  virtual void getMediaFiles(std::vector<std::string> &fileNames) const
+  {
+    fileNames.clear();
+  }
+  /**
   * Write the data to the persistent storage.
   *
   * @param waypointDb the data base with way points
@@ -13,16 +13,76 @@
 #ifndef CPOIDATABASE_H
 #define CPOIDATABASE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 // Own Include Files
 #include "CDatabase.h"
 #include "CPOI.h"
 
+#define DEFAULT_TILE_MEMORY \
+  (64 * 1024 * 1024) /**< @brief Represents the default memory of the
+                        loaded tiles */
+
+class CPoiTileStore;
+
 /**
  * CPoiDatabase class maintains the database which consists of
  * CPOI objects.
+ *
+ * The POIs of a tiled file (CPoiTileStore) can be loaded on demand:
+ * loadArea() adds the POIs of the tiles of an area which are not loaded
+ * yet, and removes the POIs of the least recently used tiles while the
+ * loaded tiles take more than the memory limit. A pointer to a POI of a
+ * tile stays valid until its tile is removed.
  */
 class CPoiDatabase : public CDatabase<std::string, CPOI> {
+private:
+  typedef std::list<uint64_t> TileOrder_t;
+  typedef struct {
+    TileOrder_t::iterator order; /**< \brief Represents the place of the
+                                    tile in the order of use */
+    std::vector<std::string> names; /**< \brief Represents the POIs which
+                                       were added for the tile */
+    size_t memory; /**< \brief Represents the estimated memory of the POIs */
+  } tile_t;        /**< \brief Represents a loaded tile */
+  typedef std::unordered_map<uint64_t, tile_t> TileMap_t;
+
+  std::unique_ptr<CPoiTileStore> m_pTileStore; /**< \brief Represents the
+                                                  tiled file, NULL if none is
+                                                  open */
+  TileOrder_t m_tileOrder; /**< \brief Represents the loaded tiles, the most
+                              recently used first */
+  TileMap_t m_tiles;       /**< \brief Represents the loaded tiles by key */
+  size_t m_tileMemory;     /**< \brief Represents the memory of the tiles */
+  size_t m_tileMemoryLimit; /**< \brief Represents the memory limit */
+
+  /**
+   * Removes the POIs of the least recently used tile, change tracking must
+   * be suspended
+   * @param None
+   * @return None
+   */
+  void evictTile(void);
+  /**
+   * Removes a POI from the names of its loaded tile, so that its tile no
+   * longer removes it
+   * @param const std::string& name [IN] - Name of the POI
+   * @return None
+   */
+  void releaseTilePoi(const std::string &name);
+  /**
+   * Forgets the loaded tiles, their POIs stay in the Database
+   * @param None
+   * @return None
+   */
+  void resetTiles(void);
 
 public:
   typedef std::map<std::string, CPOI> POIDatabaseMap_t;
@@ -32,6 +92,14 @@ public:
    * clears the POI Database
    */
   CPoiDatabase();
+  ~CPoiDatabase();
+  /**
+   * Copies the POIs. The copy has no tiled file, the POIs of the loaded
+   * tiles are ordinary POIs of the copy.
+   * @param const CPoiDatabase& other [IN] - The Database to copy
+   */
+  CPoiDatabase(const CPoiDatabase &other);
+  CPoiDatabase &operator=(const CPoiDatabase &other);
   /**
   * Add a POI to the POIDatabase
   * If the POI table is not full, adds the POI with the given attributes to the
@@ -47,6 +115,18 @@ public:
   * @return None
   */
   void addPoi(CPOI const &poi);
+  /**
+   * Adds the POI or replaces the POI of the same name
+   * @param const CPOI& poi [IN] - Reference to the POI object
+   * @return None
+   */
+  void updatePoi(const CPOI &poi);
+  /**
+   * Removes the POI from the POI Database
+   * @param const std::string& name [IN] - Name (Key value) of the POI
+   * @return true if the POI was present, false otherwise
+   */
+  bool removePoi(const std::string &name);
   /**
    * Get Pointer to the POI object in the POI Database
    * Note: In case of multiple POI objects with the same name, the first one is
@@ -71,6 +151,40 @@ public:
        * @return None
        */
   void clearPoiDatabase(void);
+  /**
+   * Opens a tiled file for loadArea(). The tiles loaded from a previously
+   * opened file are forgotten, their POIs stay in the Database.
+   * @param const std::string& fileName [IN] - Name of the tiled file
+   * @param size_t memoryLimit [IN] - The memory of the loaded tiles, in
+   * bytes, before the least recently used ones are removed
+   * @return true if the file is a tiled POI file, false otherwise
+   */
+  bool openTiles(const std::string &fileName,
+                 size_t memoryLimit = DEFAULT_TILE_MEMORY);
+  /**
+   * Closes the tiled file, the POIs of the loaded tiles stay in the
+   * Database
+   * @param None
+   * @return None
+   */
+  void closeTiles(void);
+  /**
+   * Loads the tiles of an area which are not loaded yet. A POI whose name
+   * is already in the Database is skipped. The tiles of the area are never
+   * removed by this call, even if they exceed the memory limit. Loaded and
+   * removed POIs of tiles are not tracked as changes, a POI which was
+   * updated or removed by the user is no longer part of its tile.
+   * @param double minLatitude, minLongitude [IN] - The south west corner
+   * @param double maxLatitude, maxLongitude [IN] - The north east corner
+   * @return true if every tile of the area could be read, false otherwise
+   */
+  bool loadArea(double minLatitude, double minLongitude, double maxLatitude,
+                double maxLongitude);
+  /**
+   * Gets the number and the estimated memory of the loaded tiles
+   */
+  size_t getLoadedTileCount(void) const { return m_tiles.size(); }
+  size_t getTileMemory(void) const { return m_tileMemory; }
   /**
        * Prints the content of POI Database
        * @param None
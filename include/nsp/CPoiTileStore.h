@@ -0,0 +1,118 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CPoiTileStore.H
+* Author          : Jishnu M Thampan
+* Description     : class CPoiTileStore
+*                   POIs in a compact file of tiles, read tile by tile.
+****************************************************************************/
+#ifndef CPOI_TILE_STORE_H
+#define CPOI_TILE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "CCompactDecoder.h"
+#include "CPOI.h"
+
+#define DEFAULT_TILE_LEVEL \
+  (10) /**< @brief Represents tiles of about 0.35 x 0.18 degree */
+
+class CPoiDatabase;
+
+/**
+ * CPoiTileStore reads the POIs of a compact file which was written with a
+ * tile level, see writeTiles(). The blocks of the file are in the order of
+ * the tile keys and every block lies in one tile, so the blocks of a tile
+ * are found by a binary search over the block headers. open() only maps
+ * the file; a tile is decoded when it is requested.
+ */
+class CPoiTileStore {
+private:
+  CCompactDecoder m_decoder; /**< \brief Represents the tiled file */
+
+  /**
+   * Gets the tile of a block, the tile of its south west corner
+   * @param size_t block [IN] - Index of the block
+   * @param uint32_t& column [OUT] - The tile column
+   * @param uint32_t& row [OUT] - The tile row
+   * @return true if the block is a valid POI block, false otherwise
+   */
+  bool getBlockTile(size_t block, uint32_t &column, uint32_t &row) const;
+  /**
+   * Finds the first block of a tile or of the tiles after it
+   * @param uint64_t key [IN] - The tile key
+   * @param size_t& block [OUT] - Index of the block, the number of blocks
+   * if every block is before the tile
+   * @return true if the headers could be read, false otherwise
+   */
+  bool findFirstBlock(uint64_t key, size_t &block) const;
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CPoiTileStore(CPoiTileStore &);
+  CPoiTileStore &operator=(CPoiTileStore &);
+
+public:
+  CPoiTileStore() {}
+  /**
+   * Writes the POIs of a Database as a tiled compact file. The POIs are
+   * sorted by their tile key, then by the Hilbert index of their
+   * coordinates.
+   * @param const std::string& fileName [IN] - Name of the file
+   * @param const CPoiDatabase& poiDb [IN] - The POIs
+   * @param unsigned int level [IN] - The tile level, 1 to MAX_TILE_LEVEL
+   * @return true if the file was written, false otherwise
+   */
+  static bool writeTiles(const std::string &fileName,
+                         const CPoiDatabase &poiDb,
+                         unsigned int level = DEFAULT_TILE_LEVEL);
+  /**
+   * Maps a tiled file. Only the trailer and the index are read.
+   * @param const std::string& fileName [IN] - Name of the file
+   * @return true if the file is a complete tiled POI file, false otherwise
+   */
+  bool open(const std::string &fileName);
+  /**
+   * Releases the mapping
+   * @param None
+   * @return None
+   */
+  void close(void) { m_decoder.close(); }
+  bool isOpen(void) const { return m_decoder.isOpen(); }
+  /**
+   * Gets the tile level of the file
+   * @return unsigned int - The tile level, 0 if no file is open
+   */
+  unsigned int getTileLevel(void) const { return m_decoder.getTileLevel(); }
+  /**
+   * Gets the key of the tile of a position
+   * @param double latitude, longitude [IN] - The position
+   * @return uint64_t - The tile key
+   */
+  uint64_t getTileKey(double latitude, double longitude) const;
+  /**
+   * Gets the tiles which hold POIs in an area
+   * @param double minLatitude, minLongitude [IN] - The south west corner
+   * @param double maxLatitude, maxLongitude [IN] - The north east corner
+   * @param std::vector<uint64_t>& keys [OUT] - The tile keys, ascending
+   * @return true if the headers could be read, false otherwise
+   */
+  bool getTiles(double minLatitude, double minLongitude, double maxLatitude,
+                double maxLongitude, std::vector<uint64_t> &keys) const;
+  /**
+   * Decodes the POIs of a tile
+   * @param uint64_t key [IN] - The tile key
+   * @param std::vector<CPOI>& pois [OUT] - The POIs, empty for a tile
+   * without POIs
+   * @return true if the blocks of the tile are intact, false otherwise
+   */
+  bool loadTile(uint64_t key, std::vector<CPOI> &pois) const;
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CPOI_TILE_STORE_H
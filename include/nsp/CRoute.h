@@ -165,6 +165,19 @@ public:
    * @return CRoute& - The Reference to the modified route
    */
   CRoute &operator=(const CRoute &rop);
+  /**
+   * Simplifies the route with the Douglas-Peucker algorithm on the sphere.
+   * Waypoints are removed as long as every removed Waypoint stays within the
+   * tolerance of the great-circle arc between the remaining ones. POIs are
+   * anchors: they are never removed and the route is never simplified across
+   * them. The Waypoints themselves stay in the database.
+   * @param double toleranceMeters [IN] - Allowed cross-track distance in
+   * meters
+   * @param unsigned int threadCount [IN] - Number of worker threads, 0 uses
+   * one thread per core. Default Value: 1
+   * @return unsigned int - Number of Waypoints removed from the route
+   */
+  unsigned int simplify(double toleranceMeters, unsigned int threadCount = 1);
 
   const std::vector<const CWaypoint *> getRoute();
 };
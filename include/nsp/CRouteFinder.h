@@ -0,0 +1,108 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CRouteFinder.H
+* Author          : Jishnu M Thampan
+* Description     : class CRouteFinder
+*                   This class answers point-to-point shortest path queries
+*                   on a CRoutingGraph using the A* algorithm. The
+*                   great-circle distance to the destination is used as
+*                   the heuristic.
+****************************************************************************/
+#ifndef CROUTE_FINDER_H
+#define CROUTE_FINDER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CRoute.h"
+#include "CRoutingGraph.h"
+
+/**
+ * CRouteFinder searches the shortest path between two nodes of a
+ * CRoutingGraph. The search state is kept in the object and is reused
+ * between the queries, so a CRouteFinder object should be reused for many
+ * queries. The state is only reset lazily (with a visit stamp), hence a
+ * query only touches the nodes it actually visits.
+ * A CRouteFinder object must not be shared between threads, however any
+ * number of CRouteFinder objects may search the same graph concurrently.
+ */
+class CRouteFinder {
+private:
+  typedef CRoutingGraph::node_t node_t;
+  typedef CRoutingGraph::edge_t edge_t;
+  typedef std::pair<double, node_t>
+      queueEntry_t; /**< \brief Represents an open list entry (estimated
+                       total length, node) */
+
+  const CRoutingGraph
+      *m_pGraph; /**< \brief Represents the graph which is searched */
+  std::vector<double>
+      m_cost; /**< \brief Represents the path length from the source */
+  std::vector<node_t>
+      m_parent; /**< \brief Represents the predecessor on the best path */
+  std::vector<unsigned int> m_visitStamp; /**< \brief Represents the query
+                                             which reached the node last */
+  std::vector<unsigned int> m_settledStamp; /**< \brief Represents the query
+                                               which settled the node last */
+  std::vector<queueEntry_t>
+      m_openList; /**< \brief Represents the binary heap of open nodes */
+  unsigned int m_currentStamp; /**< \brief Represents the current query */
+  unsigned int
+      m_settledNodes; /**< \brief Represents the nodes settled by the last
+                         query */
+
+  /**
+   * Prepares the search state for a new query
+   * @param None
+   * @return None
+   */
+  void startQuery(void);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CRouteFinder(CRouteFinder &);
+  CRouteFinder &operator=(CRouteFinder &);
+
+public:
+  /**
+   * Constructor of CRouteFinder class
+   * @param const CRoutingGraph& graph [IN] - The finalized graph to be
+   * searched. It must outlive the CRouteFinder object.
+   */
+  CRouteFinder(const CRoutingGraph &graph);
+  /**
+   * Searches the shortest path between two nodes
+   * @param node_t source [IN] - Start node
+   * @param node_t target [IN] - Destination node
+   * @param std::vector<node_t>& path [OUT] - The nodes of the path,
+   * including source and target
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return true if a path is found, false otherwise
+   */
+  bool findPath(node_t source, node_t target, std::vector<node_t> &path,
+                double &distance);
+  /**
+   * Searches the shortest path between two Waypoints and appends the
+   * Waypoints of the path to the route. The route has to be connected to
+   * the Waypoint database the graph was built from.
+   * @param const std::string& from [IN] - Name of the start Waypoint
+   * @param const std::string& to [IN] - Name of the destination Waypoint
+   * @param CRoute& route [OUT] - The route the path is appended to
+   * @param double& distance [OUT] - Length of the path in kilometers
+   * @return true if a path is found, false otherwise
+   */
+  bool findRoute(const std::string &from, const std::string &to,
+                 CRoute &route, double &distance);
+  /**
+   * Gets the number of nodes settled by the last query
+   * @param None
+   * @return unsigned int - Number of settled nodes
+   */
+  unsigned int getSettledNodeCount(void) const { return m_settledNodes; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CROUTE_FINDER_H
@@ -0,0 +1,154 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CRoutingGraph.H
+* Author          : Jishnu M Thampan
+* Description     : class CRoutingGraph
+*                   This class holds the directed, weighted connections
+*                   between the Waypoints of a CWpDatabase. The
+*                   connections are stored in a compressed sparse row
+*                   (CSR) adjacency structure so that the outgoing edges
+*                   of a node are contiguous in memory.
+****************************************************************************/
+#ifndef CROUTING_GRAPH_H
+#define CROUTING_GRAPH_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CWpDatabase.h"
+
+/**
+ * CRoutingGraph holds the road network which connects the Waypoints of a
+ * CWpDatabase. Nodes are added first, followed by the edges. Once all
+ * edges are added, finalize() builds the CSR adjacency which is used by
+ * the path search algorithms (see CRouteFinder).
+ *
+ * Edge weights are lengths in kilometers. A weight which is shorter than
+ * the great-circle distance between its end points is raised to that
+ * distance, so that the great-circle distance always stays an admissible
+ * estimate of the remaining path length.
+ */
+class CRoutingGraph {
+public:
+  typedef unsigned int node_t; /**< \brief Represents the index of a node */
+  typedef unsigned int edge_t; /**< \brief Represents the index of an edge */
+
+  static const node_t INVALID_NODE =
+      static_cast<node_t>(-1); /**< \brief Represents an invalid node */
+
+private:
+  typedef struct {
+    node_t from;   /**< \brief Represents the start node of the edge */
+    node_t to;     /**< \brief Represents the end node of the edge */
+    double weight; /**< \brief Represents the length of the edge in km */
+  } pendingEdge_t; /**< \brief Represents an edge which is not yet in the
+                      CSR structure */
+
+  std::vector<std::string>
+      m_nodeNames; /**< \brief Represents the Waypoint name of each node */
+  std::vector<double>
+      m_latitude; /**< \brief Represents the latitude of each node */
+  std::vector<double>
+      m_longitude; /**< \brief Represents the longitude of each node */
+  std::vector<double> m_sinLatitude; /**< \brief Represents the precomputed
+                                        sine of each latitude */
+  std::vector<double> m_cosLatitude; /**< \brief Represents the precomputed
+                                        cosine of each latitude */
+  std::vector<double> m_longitudeRad; /**< \brief Represents each longitude
+                                         in radian */
+  std::map<std::string, node_t>
+      m_nodeIndex; /**< \brief Maps a Waypoint name to its node */
+
+  std::vector<edge_t> m_edgeOffsets; /**< \brief Represents the CSR row
+                                        offsets, one per node plus one */
+  std::vector<node_t>
+      m_edgeTargets; /**< \brief Represents the CSR edge end nodes */
+  std::vector<double>
+      m_edgeWeights; /**< \brief Represents the CSR edge lengths in km */
+  std::vector<pendingEdge_t> m_pendingEdges; /**< \brief Represents the
+                                                edges added since the last
+                                                finalize() */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CRoutingGraph(CRoutingGraph &);
+  CRoutingGraph &operator=(CRoutingGraph &);
+
+public:
+  CRoutingGraph();
+  /**
+   * Adds a node to the graph. If a node with the same name is already
+   * present, the existing node is returned.
+   * @param const std::string& name [IN] - Name of the Waypoint
+   * @param double latitude [IN] - Latitude of the Waypoint
+   * @param double longitude [IN] - Longitude of the Waypoint
+   * @return node_t - Index of the node
+   */
+  node_t addNode(const std::string &name, double latitude, double longitude);
+  /**
+   * Adds a directed edge to the graph. The edge becomes visible to the path
+   * search after the next call to finalize().
+   * @param node_t from [IN] - Start node of the edge
+   * @param node_t to [IN] - End node of the edge
+   * @param double weight [IN] - Length of the edge in kilometers
+   * @return true if the edge is valid, false otherwise
+   */
+  bool addEdge(node_t from, node_t to, double weight);
+  /**
+   * Builds the CSR adjacency from all the edges added so far
+   * @param None
+   * @return None
+   */
+  void finalize(void);
+  /**
+   * Clears all nodes and edges of the graph
+   * @param None
+   * @return None
+   */
+  void clear(void);
+  /**
+   * Builds the graph from the Waypoints of the database and the edge list
+   * file. Every line of the file has the format
+   * "<from waypoint>;<to waypoint>;<length in km>".
+   * @param const std::string& fileName [IN] - Name of the edge list file
+   * @param const CWpDatabase& wpDb [IN] - Database holding the Waypoints
+   * @return true if the file could be read, false otherwise. Invalid lines
+   * are reported and skipped.
+   */
+  bool loadFromFile(const std::string &fileName, const CWpDatabase &wpDb);
+  /**
+   * Gets the node which belongs to the Waypoint with the given name
+   * @param const std::string& name [IN] - Name of the Waypoint
+   * @param node_t& node [OUT] - Index of the node
+   * @return true if the node is found, false otherwise
+   */
+  bool getNode(const std::string &name, node_t &node) const;
+  /**
+   * Gets the great-circle distance between two nodes using the precomputed
+   * trigonometry of the nodes
+   * @param node_t from [IN] - First node
+   * @param node_t to [IN] - Second node
+   * @return double - Distance in kilometers
+   */
+  double getDistance(node_t from, node_t to) const;
+
+  node_t getNodeCount(void) const { return m_nodeNames.size(); }
+  edge_t getEdgeCount(void) const { return m_edgeTargets.size(); }
+  const std::string &getNodeName(node_t node) const {
+    return m_nodeNames[node];
+  }
+  double getLatitude(node_t node) const { return m_latitude[node]; }
+  double getLongitude(node_t node) const { return m_longitude[node]; }
+  /** First outgoing edge of the node */
+  edge_t getEdgeBegin(node_t node) const { return m_edgeOffsets[node]; }
+  /** One past the last outgoing edge of the node */
+  edge_t getEdgeEnd(node_t node) const { return m_edgeOffsets[node + 1]; }
+  node_t getEdgeTarget(edge_t edge) const { return m_edgeTargets[edge]; }
+  double getEdgeWeight(edge_t edge) const { return m_edgeWeights[edge]; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CROUTING_GRAPH_H
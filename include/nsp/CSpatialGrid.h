@@ -0,0 +1,89 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CSpatialGrid.H
+* Author          : Jishnu M Thampan
+* Description     : class CSpatialGrid
+*                   A uniform latitude/longitude grid over the POIs of a
+*                   CPoiDatabase which answers nearest-POI queries.
+****************************************************************************/
+#ifndef CSPATIAL_GRID_H
+#define CSPATIAL_GRID_H
+
+#include <vector>
+
+#include "CPoiDatabase.h"
+
+/**
+ * CSpatialGrid sorts the POIs into the cells of a uniform grid. The POIs of
+ * a cell are contiguous in memory (CSR layout) together with their
+ * precomputed trigonometry. A nearest-POI query scans the rings of cells
+ * around the query position and stops as soon as the next ring cannot hold
+ * a POI closer than the best one found.
+ *
+ * The grid keeps pointers to the POIs of the database, hence it has to be
+ * rebuilt whenever the database changes. All queries are const and may run
+ * concurrently. Longitudes are not wrapped around the date line.
+ */
+class CSpatialGrid {
+private:
+  typedef struct {
+    double sinLatitude;  /**< \brief Represents the sine of the latitude */
+    double cosLatitude;  /**< \brief Represents the cosine of the latitude */
+    double longitudeRad; /**< \brief Represents the longitude in radian */
+    const CPOI *pPoi;    /**< \brief Represents the POI in the database */
+  } gridEntry_t;         /**< \brief Represents a POI sorted into a cell */
+
+  std::vector<gridEntry_t>
+      m_entries; /**< \brief Represents the POIs ordered by cell */
+  std::vector<unsigned int> m_cellOffsets; /**< \brief Represents the first
+                                              entry of each cell, one per
+                                              cell plus one */
+  double m_minLatitude;  /**< \brief Represents the south edge of the grid */
+  double m_minLongitude; /**< \brief Represents the west edge of the grid */
+  double m_cellSize;     /**< \brief Represents the cell size in degree */
+  unsigned int m_rows;   /**< \brief Represents the cells in latitude */
+  unsigned int m_columns; /**< \brief Represents the cells in longitude */
+  double m_minCosLatitude; /**< \brief Represents the smallest cosine of the
+                              POI latitudes */
+
+  /**
+   * Gets the cell of a coordinate, clamped to the grid
+   */
+  unsigned int getRow(double latitude) const;
+  unsigned int getColumn(double longitude) const;
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CSpatialGrid(CSpatialGrid &);
+  CSpatialGrid &operator=(CSpatialGrid &);
+
+public:
+  CSpatialGrid();
+  /**
+   * Sorts all POIs of the database into the grid
+   * @param const CPoiDatabase& poiDb [IN] - The POI database. It must not
+   * change while the grid is used.
+   * @param double cellSize [IN] - Cell size in degree, 0 chooses a size
+   * with a few POIs per cell
+   * @return None
+   */
+  void build(const CPoiDatabase &poiDb, double cellSize = 0);
+  /**
+   * Searches the POI which is closest to a position
+   * @param double latitude [IN] - Latitude of the position
+   * @param double longitude [IN] - Longitude of the position
+   * @param const CPOI*& pPoi [OUT] - The nearest POI
+   * @param double& distance [OUT] - Distance to the POI in kilometers
+   * @return true if a POI is found, false if the grid is empty
+   */
+  bool findNearest(double latitude, double longitude, const CPOI *&pPoi,
+                   double &distance) const;
+
+  size_t getPoiCount(void) const { return m_entries.size(); }
+  double getCellSize(void) const { return m_cellSize; }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CSPATIAL_GRID_H
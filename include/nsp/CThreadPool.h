@@ -0,0 +1,151 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CThreadPool.H
+* Author          : Jishnu M Thampan
+* Description     : class CThreadPool
+*                   A fixed set of worker threads which execute submitted
+*                   tasks. Every worker owns a task queue, idle workers
+*                   steal tasks from the queues of the others.
+****************************************************************************/
+#ifndef CTHREAD_POOL_H
+#define CTHREAD_POOL_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * CThreadPool executes tasks on a fixed number of worker threads.
+ * A task which is submitted by a worker is put into the queue of that
+ * worker, other tasks are distributed over the queues round robin. A worker
+ * takes its newest own task first (the data of which is likely still in
+ * its cache) and steals the oldest task of another worker when its own
+ * queue is empty.
+ *
+ * Every task gets the index of the worker which runs it, so that callers
+ * can keep per worker state (e.g. a route finder) without any locking.
+ *
+ * The task counters are atomic; the state lock is only taken to put a
+ * worker to sleep, to wake one and when the last task is done.
+ */
+class CThreadPool {
+public:
+  typedef std::function<void(unsigned int)>
+      task_t; /**< \brief Represents a task, called with the worker index */
+
+private:
+  typedef struct workerQueue {
+    std::mutex lock;           /**< \brief Protects the tasks */
+    std::deque<task_t> tasks;  /**< \brief Represents the queued tasks */
+  } workerQueue_t; /**< \brief Represents the task queue of one worker */
+
+  std::vector<std::thread> m_workers; /**< \brief Represents the threads */
+  std::vector<workerQueue_t *>
+      m_queues; /**< \brief Represents the queue of each worker */
+  std::mutex m_stateLock; /**< \brief Protects the sleeping of the workers
+                             and the shutdown request */
+  std::condition_variable
+      m_workAvailable; /**< \brief Wakes up idle workers */
+  std::condition_variable
+      m_allDone; /**< \brief Wakes up the threads waiting in wait() */
+  std::atomic<size_t>
+      m_queuedTasks; /**< \brief Represents the tasks not yet taken */
+  std::atomic<size_t>
+      m_unfinishedTasks; /**< \brief Represents the tasks not yet done */
+  std::atomic<size_t> m_sleepingWorkers; /**< \brief Represents the workers
+                                            waiting for a task */
+  std::atomic<unsigned int> m_nextQueue; /**< \brief Represents the next
+                                            queue used for a task submitted
+                                            from outside */
+  bool m_isStopping; /**< \brief Represents the shutdown request */
+
+  /**
+   * Main loop of a worker thread
+   * @param unsigned int index [IN] - Index of the worker
+   * @return None
+   */
+  void runWorker(unsigned int index);
+  /**
+   * Takes a task from the own queue or steals one from another worker
+   * @param unsigned int index [IN] - Index of the worker
+   * @param task_t& task [OUT] - The task
+   * @return true if a task is taken, false if all queues are empty
+   */
+  bool takeTask(unsigned int index, task_t &task);
+  /**
+   * Reserves one of the queued tasks
+   * @param None
+   * @return true if a task is reserved, false if none is queued
+   */
+  bool reserveTask(void);
+  /**
+   * Takes and runs a reserved task
+   * @param unsigned int index [IN] - Index of the worker
+   * @return None
+   */
+  void runTask(unsigned int index);
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CThreadPool(CThreadPool &);
+  CThreadPool &operator=(CThreadPool &);
+
+public:
+  /**
+   * Constructor of CThreadPool class, starts the workers
+   * @param unsigned int threadCount [IN] - Number of workers, 0 uses one
+   * worker per core
+   */
+  CThreadPool(unsigned int threadCount = 0);
+  /**
+   * Destructor of CThreadPool class, finishes all queued tasks and stops
+   * the workers
+   */
+  ~CThreadPool();
+  /**
+   * Queues a task
+   * @param const task_t& task [IN] - The task
+   * @return None
+   */
+  void submit(const task_t &task);
+  /**
+   * Waits until all submitted tasks are finished, including the tasks of
+   * other callers. Must not be called by a task.
+   * @param None
+   * @return None
+   */
+  void wait(void);
+  /**
+   * Runs a function over the index range [0, count) and waits for it. The
+   * range is cut into tasks of grainSize indices. Only the tasks of this
+   * call are waited for, so the pool may be shared by several callers. A
+   * call from a task of this pool runs the range inline on the calling
+   * worker, with its worker index, so that no other task uses the state of
+   * that worker in between.
+   * @param size_t count [IN] - Size of the range
+   * @param size_t grainSize [IN] - Indices per task
+   * @param const std::function<void(size_t, size_t, unsigned int)>&
+   * function [IN] - Called as function(begin, end, worker)
+   * @return None
+   */
+  void parallelFor(
+      size_t count, size_t grainSize,
+      const std::function<void(size_t, size_t, unsigned int)> &function);
+  /**
+   * Gets the number of workers
+   * @param None
+   * @return unsigned int - Number of workers
+   */
+  unsigned int getThreadCount(void) const { return m_workers.size(); }
+};
+/********************
+**  CLASS END
+*********************/
+#endif // CTHREAD_POOL_H
@@ -34,6 +34,18 @@ public:
        * @return None
        */
   void addWaypoint(const CWaypoint &wp);
+  /**
+       * Adds the Waypoint or replaces the Waypoint of the same name
+       * @param const CWaypoint& wp [IN] - Reference to the Waypoint object
+       * @return None
+       */
+  void updateWaypoint(const CWaypoint &wp);
+  /**
+       * Removes the Waypoint from the Waypoint Database
+       * @param const std::string& name [IN] - Name (Key value) of the Waypoint
+       * @return true if the Waypoint was present, false otherwise
+       */
+  bool removeWaypoint(const std::string &name);
   /**
        * Gets the Pointer to the Waypoint object in the map
        * @param const CWaypoint& wp [IN] - Name (Key value) of the Waypoint Map
@@ -0,0 +1,144 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CompactCoding.H
+* Author          : Jishnu M Thampan
+* Description     : Namespace compact_coding
+*                   Integer codings of the compact coordinate format, which
+*                   is written by CCompactEncoder and read by
+*                   CCompactDecoder.
+****************************************************************************/
+#ifndef COMPACT_CODING_H
+#define COMPACT_CODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#define COORDINATE_SCALE \
+  (1e7) /**< @brief Represents the steps of the coordinates per degree */
+#define COMPACT_MAGIC (0x43505343u) /**< @brief Represents "CSPC" */
+#define COMPACT_VERSION (1)         /**< @brief Represents the format */
+#define COMPACT_HEADER_SIZE \
+  (8) /**< @brief Represents the file header: magic, version */
+#define COMPACT_BLOCK_HEADER_SIZE \
+  (32) /**< @brief Represents the header of a block */
+#define COMPACT_TRAILER_SIZE (48) /**< @brief Represents the trailer */
+#define MAX_TILE_LEVEL \
+  (16) /**< @brief Represents the finest tiles, 2^16 x 2^16 on the globe */
+
+/**
+ * NameSpace compact_coding stores the codings of the compact format. The
+ * coordinates are quantized to 1e-7 degree (about 1 cm), the differences
+ * of consecutive coordinates are zigzag coded, so that small negative
+ * numbers become small unsigned numbers, and written as varints of 7 bits
+ * per byte. Fixed size fields are written in little-endian byte order on
+ * any host. The Hilbert index orders coordinates along a space filling
+ * curve, so that points which are close in the order are close on the map
+ * and their differences are small. A tile is a cell of a quad-tree over
+ * the globe: level L splits the longitudes and latitudes into 2^L columns
+ * and rows, the key of a tile interleaves the bits of its column and row
+ * (Morton order), so the tiles of a coarser cell have consecutive keys.
+ */
+namespace compact_coding {
+
+/**
+ * Represents the tables of the compact format
+ */
+typedef enum {
+  WAYPOINT_TABLE = 0, /**< \brief Represents the waypoints */
+  POI_TABLE,          /**< \brief Represents the POIs */
+  TABLE_COUNT         /**< \brief Represents the number of tables */
+} table_t;
+
+/**
+ * Quantizes a coordinate to steps of 1e-7 degree
+ * @param double degree [IN] - Latitude or longitude, within +-180 degree
+ * @return int32_t - The nearest step
+ */
+int32_t quantize(double degree);
+/**
+ * Gets the coordinate of a step, the nearest double of the decimal number
+ * @param int32_t step [IN] - The step
+ * @return double - The coordinate in degree
+ */
+inline double dequantize(int32_t step) { return step / COORDINATE_SCALE; }
+/**
+ * Maps a signed number to an unsigned one, 0, -1, 1, -2 to 0, 1, 2, 3
+ */
+inline uint64_t zigzagEncode(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+inline int64_t zigzagDecode(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+/**
+ * Appends a number as a varint, 7 bits per byte with the lowest bits first
+ * @param std::string& buffer [OUT] - The buffer
+ * @param uint64_t value [IN] - The number
+ * @return None
+ */
+inline void appendVarint(std::string &buffer, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buffer += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  buffer += static_cast<char>(value);
+}
+/**
+ * Reads a varint
+ * @param const char*& pData [IN/OUT] - The varint, after it on success
+ * @param const char* pEnd [IN] - The end of the data
+ * @param uint64_t& value [OUT] - The number
+ * @return true if a complete varint of at most 10 bytes is read, false
+ * otherwise
+ */
+bool readVarint(const char *&pData, const char *pEnd, uint64_t &value);
+/**
+ * Appends a number in little-endian byte order
+ * @param std::string& buffer [OUT] - The buffer
+ * @param uint64_t value [IN] - The number
+ * @param size_t size [IN] - The number of bytes, 4 or 8
+ * @return None
+ */
+void appendFixed(std::string &buffer, uint64_t value, size_t size);
+/**
+ * Reads a number in little-endian byte order
+ * @param const char* pData [IN] - The number
+ * @param size_t size [IN] - The number of bytes, 4 or 8
+ * @return uint64_t - The number
+ */
+uint64_t readFixed(const char *pData, size_t size);
+/**
+ * Gets the position of a coordinate on the Hilbert curve through the grid
+ * of 2^32 x 2^32 steps
+ * @param int32_t latitude [IN] - The quantized latitude
+ * @param int32_t longitude [IN] - The quantized longitude
+ * @return uint64_t - The position on the curve
+ */
+uint64_t getHilbertIndex(int32_t latitude, int32_t longitude);
+/**
+ * Gets the tile column of a longitude or the tile row of a latitude
+ * @param int32_t longitude / latitude [IN] - The quantized coordinate
+ * @param unsigned int level [IN] - The tile level, up to MAX_TILE_LEVEL
+ * @return uint32_t - The column (row), 180 (90) degree is in the last one
+ */
+uint32_t getTileColumn(int32_t longitude, unsigned int level);
+uint32_t getTileRow(int32_t latitude, unsigned int level);
+/**
+ * Gets the key of a tile
+ * @param uint32_t column [IN] - The column
+ * @param uint32_t row [IN] - The row
+ * @return uint64_t - The key, the bits of column and row interleaved
+ */
+uint64_t getTileKey(uint32_t column, uint32_t row);
+
+} // namespace compact_coding
+
+#endif // COMPACT_CODING_H
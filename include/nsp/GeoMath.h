@@ -0,0 +1,81 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : GeoMath.H
+* Author          : Jishnu M Thampan
+* Description     : Namespace geo_math
+****************************************************************************/
+#ifndef GEO_MATH_H
+#define GEO_MATH_H
+
+#define EARTH_RADIUS_LENGTH \
+  6378.17             /**< @brief Defines the Radius of Earth in kilometers*/
+#define PI 3.14159265 /**< @brief Defines the constant PI */
+#define CONVERT_DEGREE_TO_RADIAN(x) \
+  (x * PI / 180)     /**< @brief Defines the conversion from degree to radian*/
+
+/**
+ * NameSpace geo_math stores the spherical geometry helpers which are shared
+ * by the Waypoint, Route and Routing modules. All distances are returned in
+ * kilometers and are computed with the same spherical earth model which is
+ * used by CWaypoint::calculateDistance, so that results of the different
+ * modules can be compared with each other.
+ */
+namespace geo_math {
+
+/**
+ * Converts an angle from degree to radian
+ * @param double degree [IN] - Angle in degree
+ * @return double - Angle in radian
+ */
+inline double degreeToRadian(double degree) { return degree * PI / 180; }
+/**
+ * Calculates the great-circle distance between two coordinates given in
+ * degree
+ * @param double latitude1  [IN] - Latitude of the first coordinate
+ * @param double longitude1 [IN] - Longitude of the first coordinate
+ * @param double latitude2  [IN] - Latitude of the second coordinate
+ * @param double longitude2 [IN] - Longitude of the second coordinate
+ * @return double - Distance in kilometers
+ */
+double greatCircleDistance(double latitude1, double longitude1,
+                           double latitude2, double longitude2);
+/**
+ * Calculates the great-circle distance between two coordinates whose
+ * latitude sine/cosine and longitude (in radian) are already known. This
+ * avoids recomputing the trigonometry of points which are used repeatedly.
+ * @param double sinLatitude1 [IN] - Sine of the first latitude
+ * @param double cosLatitude1 [IN] - Cosine of the first latitude
+ * @param double longitude1   [IN] - First longitude in radian
+ * @param double sinLatitude2 [IN] - Sine of the second latitude
+ * @param double cosLatitude2 [IN] - Cosine of the second latitude
+ * @param double longitude2   [IN] - Second longitude in radian
+ * @return double - Distance in kilometers
+ */
+double greatCircleDistance(double sinLatitude1, double cosLatitude1,
+                           double longitude1, double sinLatitude2,
+                           double cosLatitude2, double longitude2);
+/**
+ * Converts a coordinate given in degree to a unit vector in earth centered
+ * cartesian coordinates
+ * @param double latitude  [IN] - Latitude of the coordinate
+ * @param double longitude [IN] - Longitude of the coordinate
+ * @param double vector[3] [OUT] - The unit vector
+ * @return None
+ */
+void toUnitVector(double latitude, double longitude, double vector[3]);
+/**
+ * Calculates the distance of a point to the great-circle arc between two
+ * other points. If the foot of the perpendicular lies outside the arc, the
+ * distance to the nearer end of the arc is returned.
+ * @param const double point[3] [IN] - Unit vector of the point
+ * @param const double start[3] [IN] - Unit vector of the start of the arc
+ * @param const double end[3]   [IN] - Unit vector of the end of the arc
+ * @return double - Distance in kilometers
+ */
+double arcDistance(const double point[3], const double start[3],
+                   const double end[3]);
+
+} // namespace geo_math
+
+#endif // GEO_MATH_H
@@ -0,0 +1,110 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : RecordCoding.H
+* Author          : Jishnu M Thampan
+* Description     : Namespace record_coding
+*                   Codings of the Waypoints and POIs in the pages of
+*                   CDiskDatabase.
+****************************************************************************/
+#ifndef RECORD_CODING_H
+#define RECORD_CODING_H
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CPOI.h"
+#include "CWaypoint.h"
+
+#define RECORD_POSITION_SIZE \
+  (16) /**< @brief Represents the latitude and longitude of a record */
+#define AREA_INDEX_SIZE \
+  (8) /**< @brief Represents the Hilbert index in front of an area key */
+
+/**
+ * NameSpace record_coding stores the codings of CDiskDatabase. The name of
+ * an entry is its key, the record holds the rest: the latitude and the
+ * longitude as doubles, for a POI followed by its type byte and its
+ * description. An area key is the Hilbert index of the position in
+ * big-endian byte order followed by the name, so that the area keys in
+ * byte order are in the order of the curve, and the value of an area key
+ * is the position of the entry.
+ */
+namespace record_coding {
+
+/**
+ * Codes the record of a Waypoint
+ * @param const CWaypoint& wp [IN] - The Waypoint
+ * @param std::string& record [OUT] - The record
+ * @return None
+ */
+void encodeRecord(const CWaypoint &wp, std::string &record);
+/**
+ * Codes the record of a POI
+ * @param const CPOI& poi [IN] - The POI
+ * @param std::string& record [OUT] - The record
+ * @return None
+ */
+void encodeRecord(const CPOI &poi, std::string &record);
+/**
+ * Reads the record of a Waypoint
+ * @param std::string_view record [IN] - The record
+ * @param const std::string& name [IN] - The name, the key of the record
+ * @param CWaypoint& wp [OUT] - The Waypoint
+ * @return true if the record is complete, false otherwise
+ */
+bool decodeRecord(std::string_view record, const std::string &name,
+                  CWaypoint &wp);
+/**
+ * Reads the record of a POI
+ * @param std::string_view record [IN] - The record
+ * @param const std::string& name [IN] - The name, the key of the record
+ * @param CPOI& poi [OUT] - The POI
+ * @return true if the record is complete, false otherwise
+ */
+bool decodeRecord(std::string_view record, const std::string &name,
+                  CPOI &poi);
+/**
+ * Reads the position at the start of a record or of an area value
+ * @param std::string_view record [IN] - The record
+ * @param double& latitude, longitude [OUT] - The position
+ * @return true if the record holds a position, false otherwise
+ */
+bool decodePosition(std::string_view record, double &latitude,
+                    double &longitude);
+/**
+ * Gets the area key of an entry
+ * @param double latitude, longitude [IN] - The position of the entry
+ * @param std::string_view name [IN] - The name of the entry
+ * @param std::string& key [OUT] - The area key
+ * @return None
+ */
+void getAreaKey(double latitude, double longitude, std::string_view name,
+                std::string &key);
+/**
+ * Gets the first area key of a Hilbert index, of any name
+ * @param uint64_t index [IN] - The Hilbert index
+ * @return std::string - The key
+ */
+std::string getAreaBound(uint64_t index);
+/**
+ * Gets the ranges of Hilbert indexes which cover an area. The area is
+ * covered by a few aligned square cells, the indexes of a cell are
+ * consecutive, so the ranges hold points outside of the area as well.
+ * @param double minLatitude, minLongitude [IN] - The south west corner
+ * @param double maxLatitude, maxLongitude [IN] - The north east corner
+ * @param std::vector<std::pair<uint64_t, uint64_t> >& ranges [OUT] - The
+ * first and the last index of each range, in ascending order
+ * @return None
+ */
+void getAreaRanges(double minLatitude, double minLongitude,
+                   double maxLatitude, double maxLongitude,
+                   std::vector<std::pair<uint64_t, uint64_t> > &ranges);
+
+} // namespace record_coding
+
+#endif // RECORD_CODING_H
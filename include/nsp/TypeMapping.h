@@ -8,8 +8,10 @@
 #ifndef TYPE_MAPPING_H
 #define TYPE_MAPPING_H
 
-#include <sstream>
+#include <stddef.h>
+
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "CPOI.h"
@@ -19,6 +21,8 @@
   (5) /**< \brief Represents Max number of POI Attributes */
 #define MAX_WAYPOINT_ATTRIBUTES                                                \
   (3) /**< \brief Represents Max number of Waypoint Attributes */
+#define MAX_DOUBLE_TEXT_LENGTH                                                 \
+  (340) /**< \brief Represents the longest text of formatDouble() */
 
 const std::string TAB_STRING = "\t";
 const std::string DOUBLE_TAB_STRING = "\t\t";
@@ -55,35 +59,59 @@ typedef enum {
 /**
  * Converts the string to longitude type. Performs the necessary validations for
  * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& longitude [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToLongitude(const std::string &attr, double &longitude);
+bool convertStringToLongitude(std::string_view attr, double &longitude);
 /**
  * Converts the string to latitude type. Performs the necessary validations for
  * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& latitude [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToLatitude(const std::string &attr, double &latitude);
+bool convertStringToLatitude(std::string_view attr, double &latitude);
 /**
  * Converts the string to double type. Performs the necessary validations for
- * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * the same: the whole string must be a decimal number without exponent.
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& val [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToDouble(const std::string &attr, double &val);
+bool convertStringToDouble(std::string_view attr, double &val);
+/**
+ * Parses the longest decimal number at the start of the text in a single
+ * pass, independent of the locale and without allocation. The result is
+ * correctly rounded like strtod(), an overflow gives +-HUGE_VAL. The
+ * number may start with a minus or a plus sign, like for strtod().
+ * @param std::string_view text [IN] - Text starting with the number
+ * @param double& val [OUT] - Converted data
+ * @param bool isExponentAllowed [IN] - Accepts an exponent as in JSON numbers
+ * @return size_t - Characters of the number, 0 if the text starts with none
+ */
+size_t parseDecimal(std::string_view text, double &val,
+                    bool isExponentAllowed = false);
+/**
+ * Formats the double as the shortest decimal text which parses back to the
+ * same value, without exponent (so CSV and JSON readers both accept it).
+ * Writes into the caller's buffer, nothing is allocated and no terminating
+ * '\0' is appended.
+ * @param double val [IN] - Value to be formatted
+ * @param char* pBuffer [OUT] - Buffer receiving the text
+ * @param size_t bufferSize [IN] - Size of the buffer, MAX_DOUBLE_TEXT_LENGTH
+ * always fits
+ * @return size_t - Characters written, 0 if the buffer is too small
+ */
+size_t formatDouble(double val, char *pBuffer, size_t bufferSize);
 /**
  * Converts the string to POI type. Performs the necessary validations for the
  * same.
- * @param const std::string& stringType [IN] - Input string to be converted
+ * @param std::string_view stringType [IN] - Input string to be converted
  * @param CPOI::t_poi& poiType [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToPoiType(const std::string &stringType,
+bool convertStringToPoiType(std::string_view stringType,
                             CPOI::t_poi &poiType);
 
 /**
@@ -97,6 +125,17 @@ bool convertStringToPoiType(const std::string &stringType,
 errorCode_t
 convertStringToCPoiType(const std::vector<std::string> &poiAttributeVec,
                         CPOI &poi);
+/**
+ * Converts the fields of a CSV record to CPOI type without copying them
+ * first. Performs the same validations as the string version.
+ * @param const std::vector<std::string_view>& poiAttributeVec [IN] - Input
+ * views of the CPOI attributes to be converted
+ * @param CPOI &poi [OUT] - Converted data which of CPOI type
+ * @return errorCode_t    - Error codes based on the conversion result
+ */
+errorCode_t
+convertStringToCPoiType(const std::vector<std::string_view> &poiAttributeVec,
+                        CPOI &poi);
 /**
  * Gets the Error Type in String representation
  * @param  const errorCode_t& ec [IN] - The errorCode to be converted
@@ -114,6 +153,17 @@ std::string getErrorType(const errorCode_t &ec);
 errorCode_t
 convertStringToCWaypointType(const std::vector<std::string> &wpAttributeVec,
                              CWaypoint &wp);
+/**
+ * Converts the fields of a CSV record to CWaypoint type without copying them
+ * first. Performs the same validations as the string version.
+ * @param const std::vector<std::string_view>& wpAttributeVec [IN] - Input
+ * views of the Waypoint attributes to be converted
+ * @param CWaypoint& wp [OUT] - Converted data which is of Waypoint type
+ * @return errorCode_t      - Error codes based on the conversion result
+ */
+errorCode_t
+convertStringToCWaypointType(
+    const std::vector<std::string_view> &wpAttributeVec, CWaypoint &wp);
 /**
  * Converts the POI type to String. Performs the necessary validations for the
  * same.
@@ -126,21 +176,14 @@ bool convertPoiTypeToString(const CPOI::t_poi &poiType,
 
 /**
  * Validates the String data
- * @param const std::string& attr[IN] - the string data to be validated
+ * @param std::string_view attr [IN] - the string data to be validated
  * @return True if Valid string data, else False
  */
-bool validateStringData(const std::string &attr);
+bool validateStringData(std::string_view attr);
 
 bool validateLatitude(double &);
 bool validateLongitude(double &);
 
-template <typename T> std::string to_string(T &data) {
-  std::stringstream ss;
-  ss << data;
-  std::string result = ss.str();
-  return result;
-}
-
 } // namespace type_mapping
 
 #endif // TYPE_MAPPING_H
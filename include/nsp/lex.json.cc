@@ -321,7 +321,6 @@ void jsonfree (void *  );
 typedef unsigned char YY_CHAR;
 
 #define yytext_ptr yytext
-#define YY_INTERACTIVE
 
 #include "FlexLexer.h"
 int yyFlexLexer::yylex()
@@ -469,6 +468,7 @@ static yyconst flex_int32_t yy_rule_can_match_eol[17] =
 #line 7 "json.l"
 #include <cstdlib>
 #include <nsp/CJsonScanner.h>
+#include <nsp/TypeMapping.h>
 #line 473 "lex.json.cc"
 
 #define INITIAL 0
@@ -669,72 +669,76 @@ case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
 #line 21 "json.l"
-{ std::string s(YYText());
-				token = new CJsonStringToken(s.substr(1, s.length()-2));
+{ token.setString(std::string_view(YYText() + 1, YYLeng() - 2));
 				return 1; }
 	YY_BREAK
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
 #line 24 "json.l"
-{ std::string s(YYText());
-				token = new CJsonStringToken(s.substr(1, s.length()-2));
+{ token.setString(std::string_view(YYText() + 1, YYLeng() - 2));
 				return 1; }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
 #line 27 "json.l"
-{ token = new CJsonToken(CJsonToken::BEGIN_ARRAY); return 1; }
+{ token.set(CJsonToken::BEGIN_ARRAY); return 1; }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
 #line 28 "json.l"
-{ token = new CJsonToken(CJsonToken::END_ARRAY); return 1; }
+{ token.set(CJsonToken::END_ARRAY); return 1; }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
 #line 29 "json.l"
-{ token = new CJsonToken(CJsonToken::BEGIN_OBJECT); return 1; }
+{ token.set(CJsonToken::BEGIN_OBJECT); return 1; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
 #line 30 "json.l"
-{ token = new CJsonToken(CJsonToken::END_OBJECT); return 1; }
+{ token.set(CJsonToken::END_OBJECT); return 1; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
 #line 31 "json.l"
-{ token = new CJsonToken(CJsonToken::VALUE_SEPARATOR); return 1; }
+{ token.set(CJsonToken::VALUE_SEPARATOR); return 1; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
 #line 32 "json.l"
-{ token = new CJsonToken(CJsonToken::NAME_SEPARATOR); return 1; }
+{ token.set(CJsonToken::NAME_SEPARATOR); return 1; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
 #line 33 "json.l"
-{ token = new CJsonNumberToken(atof(YYText())); return 1; }
+{ double number = 0;
+				type_mapping::parseDecimal(std::string_view(YYText(), YYLeng()), number, true);
+				token.setNumber(number);
+				return 1; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
 #line 34 "json.l"
-{ token = new CJsonNumberToken(atof(YYText())); return 1; }
+{ double number = 0;
+				type_mapping::parseDecimal(std::string_view(YYText(), YYLeng()), number, true);
+				token.setNumber(number);
+				return 1; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
 #line 35 "json.l"
-{ token = new CJsonBoolToken(true); return 1; }
+{ token.setBool(true); return 1; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
 #line 36 "json.l"
-{ token = new CJsonBoolToken(false); return 1; }
+{ token.setBool(false); return 1; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
 #line 37 "json.l"
-{ token = new CJsonToken(CJsonToken::JSON_NULL); return 1; }
+{ token.set(CJsonToken::JSON_NULL); return 1; }
 	YY_BREAK
 case 14:
 /* rule 14 can match eol */
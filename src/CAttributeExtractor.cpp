@@ -5,11 +5,75 @@
 * Author          : Jishnu M Thampan
 * Description     : class CAttributeExtractor
 ****************************************************************************/
-#include <algorithm> //std::count
+#include <algorithm> //std::find
 #include <iostream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_BLOCK_SIZE (32) /**< @brief Represents the bytes per register */
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_BLOCK_SIZE (16) /**< @brief Represents the bytes per register */
+#else
+#define SIMD_BLOCK_SIZE (0) /**< @brief Represents the scalar fallback */
+#endif
+
 #include <nsp/CAttributeExtractor.h>
 
+#define MAX_SIMD_DELIMITERS \
+  (4) /**< @brief Represents the delimiters compared in registers, more are \
+         compared byte by byte */
+
+#if SIMD_BLOCK_SIZE > 0
+/* Thin wrappers which let one splitter serve both instruction sets */
+#if defined(__AVX2__)
+typedef __m256i block_t;
+static inline block_t blockLoad(const char *p)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+static inline block_t blockSet(char value) { return _mm256_set1_epi8(value); }
+static inline unsigned int blockMatch(block_t a, block_t b)
+{
+  return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+}
+#else
+typedef __m128i block_t;
+static inline block_t blockLoad(const char *p)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+static inline block_t blockSet(char value) { return _mm_set1_epi8(value); }
+static inline unsigned int blockMatch(block_t a, block_t b)
+{
+  return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+}
+#endif
+#endif
+
+/**
+ * Ends the current attribute at a delimiter
+ * @param std::string_view line [IN] - The text to be extracted
+ * @param size_t delimiterPos [IN] - Position of the delimiter
+ * @param size_t maxDelimiters [IN] - Delimiters allowed in the text
+ * @param size_t& attributeStart [IN/OUT] - Start of the current attribute
+ * @param std::vector<std::string_view>& attributeVec [OUT] - The attributes
+ * @return false if the text has too many attributes, true otherwise
+ */
+static inline bool endAttribute(std::string_view line, size_t delimiterPos,
+                                size_t maxDelimiters, size_t &attributeStart,
+                                std::vector<std::string_view> &attributeVec)
+{
+  if (attributeVec.size() >= maxDelimiters)
+  {
+    return false;
+  }
+  attributeVec.push_back(std::string_view(line.data() + attributeStart,
+                                          delimiterPos - attributeStart));
+  attributeStart = delimiterPos + 1;
+  return true;
+}
+
 CAttributeExtractor::CAttributeExtractor() { max_attributes = 0; }
 /**
  * Extracts the attributes from the string text and inserts the attributes to
@@ -23,60 +87,95 @@ CAttributeExtractor::RC_t
 CAttributeExtractor::extractAttributes(const std::string &line,
                                        std::vector<std::string> &attributeVec)
 {
-  unsigned int numberOfAttributes = 0;
-  /* numberOfAttributes = sum of all possible delimiters */
-  for (unsigned int i = 0; i < getDelimiterCount(); i++)
+  /* Local views, so that the extractor can be used by several threads */
+  std::vector<std::string_view> attributeViews;
+  attributeViews.reserve(max_attributes);
+  RC_t errorType = extractAttributes(std::string_view(line), attributeViews);
+  if (CAttributeExtractor::RC_SUCCESS == errorType)
   {
-    numberOfAttributes +=
-        std::count(line.begin(), line.end(), m_deliemiterVec[i]);
+    /* Store the extracted attributes */
+    attributeVec.insert(attributeVec.end(), attributeViews.begin(),
+                        attributeViews.end());
   }
-  /* Check if the configured max attributes and the number of attributes in the
-   * text matches */
-  if (max_attributes != (numberOfAttributes + 1))
+  return errorType;
+}
+/**
+ * Splits the text in a single pass into views of the attributes
+ * @param std::string_view line [IN] - The text to be extracted
+ * @param std::vector<std::string_view>& attributeVec [OUT] - Views of the
+ * attributes, cleared first so that it can be reused for every line
+ * @return RC_t - the error code after extraction
+ */
+CAttributeExtractor::RC_t CAttributeExtractor::extractAttributes(
+    std::string_view line, std::vector<std::string_view> &attributeVec)
+{
+  size_t position = 0, attributeStart = 0;
+  attributeVec.clear();
+  if (0 == max_attributes)
   {
     return CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES;
   }
-  size_t parseStartPosition = 0, parseEndPosition = line.length();
-  /* Extract attribute by attribute and store it in the string vector */
-  for (unsigned int i = 0;
-       (i <= numberOfAttributes) && (parseStartPosition <= parseEndPosition);
-       i++)
+  /* Every delimiter ends an attribute, the last one is ended by the text */
+  size_t maxDelimiters = max_attributes - 1;
+#if SIMD_BLOCK_SIZE > 0
+  unsigned int delimiterCount = getDelimiterCount();
+  if (delimiterCount <= MAX_SIMD_DELIMITERS)
   {
-    std::string textToBeProcessed =
-        line.substr(parseStartPosition,
-                    parseEndPosition); /* Text which represents the remaining
-                                          atrributes to be extracted */
-    size_t delimiter_pos = getClosestDelimiterPos(
-        textToBeProcessed); /* Get the closes delimiter pos in the text */
-    std::string attr = line.substr(parseStartPosition,
-                                   delimiter_pos); /* Get the first attribute */
-    parseStartPosition +=
-        delimiter_pos + 1;        /* Move the parsePosition to the next attribute */
-    attributeVec.push_back(attr); /* Store the extracted attribute */
+    block_t delimiters[MAX_SIMD_DELIMITERS];
+    for (unsigned int i = 0; i < delimiterCount; i++)
+    {
+      delimiters[i] = blockSet(m_deliemiterVec[i]);
+    }
+    for (; position + SIMD_BLOCK_SIZE <= line.length();
+         position += SIMD_BLOCK_SIZE)
+    {
+      block_t block = blockLoad(line.data() + position);
+      unsigned int mask = 0;
+      for (unsigned int i = 0; i < delimiterCount; i++)
+      {
+        mask |= blockMatch(block, delimiters[i]);
+      }
+      /* One attribute ends at every set bit, lowest position first */
+      for (; 0 != mask; mask &= mask - 1)
+      {
+        if (!endAttribute(line, position + __builtin_ctz(mask), maxDelimiters,
+                          attributeStart, attributeVec))
+        {
+          return CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES;
+        }
+      }
+    }
   }
-  /* Return success if the output is not empty, else return error */
-  return (attributeVec.size() ? CAttributeExtractor::RC_SUCCESS
-                              : RC_UNKNOWN_ERROR);
-}
-/**
- * Gets the closes Delimiter Positon within the input text
- * @param  const std::string& line [IN] - Input text
- * @return size_t - Position of the closes delimiter
- */
-size_t CAttributeExtractor::getClosestDelimiterPos(const std::string &line)
-{
-  unsigned int index = 0;
-  size_t pos = line.find(m_deliemiterVec.at(index));
-  /* Get the closest delimiter in te text*/
-  for (unsigned int i = 1; i < getDelimiterCount(); i++)
+#endif
+  /* The bytes after the last full block */
+  for (; position < line.length(); position++)
   {
-    size_t new_pos = line.find(m_deliemiterVec.at(i));
-    if (pos >= new_pos)
+    if (isDelimiter(line[position]) &&
+        !endAttribute(line, position, maxDelimiters, attributeStart,
+                      attributeVec))
     {
-      pos = new_pos;
+      return CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES;
     }
   }
-  return pos;
+  attributeVec.push_back(line.substr(attributeStart));
+  /* Check if the configured max attributes and the number of attributes in the
+   * text matches */
+  if (max_attributes != attributeVec.size())
+  {
+    return CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES;
+  }
+  return CAttributeExtractor::RC_SUCCESS;
+}
+/**
+ * Checks if the character is one of the delimiters
+ * @param char character [IN] - The character to be checked
+ * @return true if it is a delimiter, false otherwise
+ */
+bool CAttributeExtractor::isDelimiter(char character) const
+{
+  return (m_deliemiterVec.end() != std::find(m_deliemiterVec.begin(),
+                                             m_deliemiterVec.end(),
+                                             character));
 }
 /**
  * Sets the Max Attributes
@@ -0,0 +1,732 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBPlusTree.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBPlusTree
+****************************************************************************/
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <nsp/CBPlusTree.h>
+
+#define TREE_MAGIC (0x45525442u) /**< @brief Represents "BTRE" */
+#define TREE_VERSION (1)         /**< @brief Represents the page layout */
+#define NO_PAGE (0xffffffffu) /**< @brief Represents a missing next leaf */
+
+#define LEAF_NODE (1)  /**< @brief Represents a page of entries */
+#define INNER_NODE (2) /**< @brief Represents a page of children */
+
+/* Fields of the page header */
+#define TYPE_OFFSET (0)       /**< @brief u8, LEAF_NODE or INNER_NODE */
+#define COUNT_OFFSET (2)      /**< @brief u16, number of cells */
+#define CELL_START_OFFSET (4) /**< @brief u16, first byte of the cells */
+#define FREED_OFFSET (6)      /**< @brief u16, bytes of removed cells */
+#define LINK_OFFSET \
+  (8) /**< @brief u32, next leaf of a leaf, first child of an inner page */
+#define NODE_HEADER_SIZE (16) /**< @brief Represents the page header */
+#define CELL_HEADER_SIZE \
+  (4) /**< @brief Represents the u16 key and value sizes of a cell */
+
+/* Fields of the meta page */
+#define META_MAGIC_OFFSET (0)   /**< @brief u32, TREE_MAGIC */
+#define META_VERSION_OFFSET (4) /**< @brief u32, TREE_VERSION */
+#define META_ROOT_OFFSET (8)    /**< @brief u32, root page */
+#define META_HEIGHT_OFFSET (12) /**< @brief u32, levels of the tree */
+#define META_COUNT_OFFSET (16)  /**< @brief u64, number of entries */
+
+/**
+ * CPageGuard pins a page of the pool while it is in scope
+ */
+class CPageGuard {
+private:
+  CBufferPool &m_pool; /**< \brief Represents the pool of the page */
+  uint32_t m_pageId;   /**< \brief Represents the page */
+  char *m_pData;       /**< \brief Represents the page, NULL if unpinned */
+  bool m_isDirty;      /**< \brief Represents a changed page */
+
+  /* Copy constructor and copy assignment operators are
+   * not used */
+  CPageGuard(CPageGuard &);
+  CPageGuard &operator=(CPageGuard &);
+
+public:
+  /**
+   * Pins a page of the file
+   */
+  CPageGuard(CBufferPool &pool, uint32_t pageId)
+      : m_pool(pool), m_pageId(pageId), m_pData(pool.fetchPage(pageId)),
+        m_isDirty(false) {}
+  /**
+   * Appends a new page to the file and pins it
+   */
+  explicit CPageGuard(CBufferPool &pool)
+      : m_pool(pool), m_pageId(0), m_pData(pool.newPage(m_pageId)),
+        m_isDirty(false) {}
+  ~CPageGuard() { release(); }
+  /**
+   * Unpins the page before the end of the scope
+   */
+  void release(void) {
+    if (NULL != m_pData) {
+      m_pool.unpinPage(m_pageId, m_isDirty);
+      m_pData = NULL;
+    }
+  }
+  bool isValid(void) const { return (NULL != m_pData); }
+  char *getData(void) { return m_pData; }
+  uint32_t getPageId(void) const { return m_pageId; }
+  void setDirty(void) { m_isDirty = true; }
+};
+
+/**
+ * Reads a field of a page
+ * @param const char* pPage [IN] - The page
+ * @param size_t offset [IN] - The offset of the field
+ * @return T - The value
+ */
+template <typename T> static T getField(const char *pPage, size_t offset)
+{
+  T value;
+  memcpy(&value, pPage + offset, sizeof(T));
+  return value;
+}
+
+/**
+ * Writes a field of a page
+ * @param char* pPage [OUT] - The page
+ * @param size_t offset [IN] - The offset of the field
+ * @param T value [IN] - The value
+ * @return None
+ */
+template <typename T>
+static void setField(char *pPage, size_t offset, T value)
+{
+  memcpy(pPage + offset, &value, sizeof(T));
+}
+
+/**
+ * Gets the number of cells of a page
+ */
+static size_t getCount(const char *pPage)
+{
+  return getField<uint16_t>(pPage, COUNT_OFFSET);
+}
+
+/**
+ * Gets a cell of a page
+ */
+static const char *getCell(const char *pPage, size_t slot)
+{
+  return pPage + getField<uint16_t>(pPage, NODE_HEADER_SIZE + 2 * slot);
+}
+
+/**
+ * Gets the size of a cell: its header, its key and its value
+ */
+static size_t getCellSize(const char *pCell)
+{
+  return CELL_HEADER_SIZE + getField<uint16_t>(pCell, 0) +
+         getField<uint16_t>(pCell, 2);
+}
+
+/**
+ * Gets the key of a cell
+ */
+static std::string_view getKey(const char *pPage, size_t slot)
+{
+  const char *pCell = getCell(pPage, slot);
+  return std::string_view(pCell + CELL_HEADER_SIZE,
+                          getField<uint16_t>(pCell, 0));
+}
+
+/**
+ * Gets the value of a cell, the child page of an inner page
+ */
+static std::string_view getValue(const char *pPage, size_t slot)
+{
+  const char *pCell = getCell(pPage, slot);
+  size_t keySize = getField<uint16_t>(pCell, 0);
+  return std::string_view(pCell + CELL_HEADER_SIZE + keySize,
+                          getField<uint16_t>(pCell, 2));
+}
+
+/**
+ * Creates a cell
+ * @param std::string_view key [IN] - The key
+ * @param std::string_view value [IN] - The value
+ * @return std::string - The cell
+ */
+static std::string makeCell(std::string_view key, std::string_view value)
+{
+  std::string cell(CELL_HEADER_SIZE, '\0');
+  setField<uint16_t>(&cell[0], 0, key.size());
+  setField<uint16_t>(&cell[0], 2, value.size());
+  cell.append(key);
+  cell.append(value);
+  return cell;
+}
+
+/**
+ * Creates a cell of an inner page
+ * @param std::string_view key [IN] - The first key of the child
+ * @param uint32_t pageId [IN] - The child
+ * @return std::string - The cell
+ */
+static std::string makeChildCell(std::string_view key, uint32_t pageId)
+{
+  return makeCell(key, std::string_view(reinterpret_cast<char *>(&pageId),
+                                        sizeof(pageId)));
+}
+
+/**
+ * Gets the first slot whose key is not less than a key
+ */
+static size_t lowerBound(const char *pPage, std::string_view key)
+{
+  size_t first = 0, last = getCount(pPage);
+  while (first < last)
+  {
+    size_t middle = first + (last - first) / 2;
+    if (getKey(pPage, middle) < key)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+/**
+ * Gets the first slot whose key is greater than a key
+ */
+static size_t upperBound(const char *pPage, std::string_view key)
+{
+  size_t first = 0, last = getCount(pPage);
+  while (first < last)
+  {
+    size_t middle = first + (last - first) / 2;
+    if (key < getKey(pPage, middle))
+    {
+      last = middle;
+    }
+    else
+    {
+      first = middle + 1;
+    }
+  }
+  return first;
+}
+
+/**
+ * Gets the child of an inner page which holds a key: the first child for
+ * the keys before the first cell, otherwise the child of the last cell
+ * whose key is not greater
+ */
+static uint32_t getChild(const char *pPage, std::string_view key)
+{
+  size_t slot = upperBound(pPage, key);
+  if (0 == slot)
+  {
+    return getField<uint32_t>(pPage, LINK_OFFSET);
+  }
+  return getField<uint32_t>(getValue(pPage, slot - 1).data(), 0);
+}
+
+/**
+ * Initializes an empty page
+ * @param char* pPage [OUT] - The page
+ * @param uint8_t type [IN] - LEAF_NODE or INNER_NODE
+ * @param uint32_t link [IN] - The next leaf or the first child
+ * @return None
+ */
+static void initNode(char *pPage, uint8_t type, uint32_t link)
+{
+  memset(pPage, 0, NODE_HEADER_SIZE);
+  setField<uint8_t>(pPage, TYPE_OFFSET, type);
+  setField<uint16_t>(pPage, CELL_START_OFFSET, DB_PAGE_SIZE);
+  setField<uint32_t>(pPage, LINK_OFFSET, link);
+}
+
+/**
+ * Gets the bytes between the slots and the cells of a page
+ */
+static size_t getFreeSpace(const char *pPage)
+{
+  return getField<uint16_t>(pPage, CELL_START_OFFSET) - NODE_HEADER_SIZE -
+         2 * getCount(pPage);
+}
+
+/**
+ * Copies the cells of a page in key order
+ */
+static void getCells(const char *pPage, std::vector<std::string> &cells)
+{
+  cells.clear();
+  for (size_t slot = 0; slot < getCount(pPage); slot++)
+  {
+    const char *pCell = getCell(pPage, slot);
+    cells.push_back(std::string(pCell, getCellSize(pCell)));
+  }
+}
+
+/**
+ * Adds a cell after the last cell of a page, which has space for it
+ */
+static void appendCell(char *pPage, const std::string &cell)
+{
+  size_t count = getCount(pPage);
+  uint16_t cellStart = getField<uint16_t>(pPage, CELL_START_OFFSET) -
+                       cell.size();
+  memcpy(pPage + cellStart, cell.data(), cell.size());
+  setField<uint16_t>(pPage, NODE_HEADER_SIZE + 2 * count, cellStart);
+  setField<uint16_t>(pPage, CELL_START_OFFSET, cellStart);
+  setField<uint16_t>(pPage, COUNT_OFFSET, count + 1);
+}
+
+/**
+ * Rewrites the cells of a page without the space of removed cells
+ */
+static void compactNode(char *pPage)
+{
+  std::vector<std::string> cells;
+  getCells(pPage, cells);
+  initNode(pPage, getField<uint8_t>(pPage, TYPE_OFFSET),
+           getField<uint32_t>(pPage, LINK_OFFSET));
+  for (size_t i = 0; i < cells.size(); i++)
+  {
+    appendCell(pPage, cells[i]);
+  }
+}
+
+/**
+ * Inserts a cell into a page at a slot
+ * @param char* pPage [IN/OUT] - The page
+ * @param size_t slot [IN] - The slot of the cell
+ * @param const std::string& cell [IN] - The cell
+ * @return true if the page has space for the cell, false otherwise
+ */
+static bool insertCell(char *pPage, size_t slot, const std::string &cell)
+{
+  size_t required = cell.size() + 2;
+  if (getFreeSpace(pPage) < required)
+  {
+    if (getFreeSpace(pPage) + getField<uint16_t>(pPage, FREED_OFFSET) <
+        required)
+    {
+      return false;
+    }
+    compactNode(pPage);
+  }
+  size_t count = getCount(pPage);
+  appendCell(pPage, cell);
+  /* Move the new offset from the end of the slots to its slot */
+  uint16_t cellOffset = getField<uint16_t>(pPage, NODE_HEADER_SIZE + 2 * count);
+  char *pSlots = pPage + NODE_HEADER_SIZE;
+  memmove(pSlots + 2 * (slot + 1), pSlots + 2 * slot, 2 * (count - slot));
+  setField<uint16_t>(pPage, NODE_HEADER_SIZE + 2 * slot, cellOffset);
+  return true;
+}
+
+/**
+ * Removes the cell of a slot from a page
+ */
+static void removeCell(char *pPage, size_t slot)
+{
+  size_t count = getCount(pPage);
+  setField<uint16_t>(pPage, FREED_OFFSET,
+                     getField<uint16_t>(pPage, FREED_OFFSET) +
+                         getCellSize(getCell(pPage, slot)));
+  char *pSlots = pPage + NODE_HEADER_SIZE;
+  memmove(pSlots + 2 * slot, pSlots + 2 * (slot + 1),
+          2 * (count - slot - 1));
+  setField<uint16_t>(pPage, COUNT_OFFSET, count - 1);
+}
+
+/**
+ * Splits a full page into itself and a new right page, with a new cell.
+ * The page keeps the first cells of about half the bytes. The first key
+ * of a right leaf stays in the leaf, the middle key of an inner page moves
+ * up and its child becomes the first child of the right page.
+ * @param CBufferPool& pool [IN] - The pool
+ * @param char* pPage [IN/OUT] - The full page
+ * @param size_t slot [IN] - The slot of the new cell
+ * @param const std::string& cell [IN] - The new cell
+ * @param std::string& splitKey [OUT] - The first key of the right page
+ * @param uint32_t& rightPageId [OUT] - The right page
+ * @return true if the page was split, false if no page could be created
+ */
+static bool splitNode(CBufferPool &pool, char *pPage, size_t slot,
+                      const std::string &cell, std::string &splitKey,
+                      uint32_t &rightPageId)
+{
+  CPageGuard right(pool);
+  if (!right.isValid())
+  {
+    return false;
+  }
+  std::vector<std::string> cells;
+  getCells(pPage, cells);
+  cells.insert(cells.begin() + slot, cell);
+  size_t total = 0;
+  for (size_t i = 0; i < cells.size(); i++)
+  {
+    total += cells[i].size() + 2;
+  }
+  size_t middle = 0;
+  for (size_t bytes = 0; (middle + 1 < cells.size()) && (2 * bytes < total);
+       middle++)
+  {
+    bytes += cells[middle].size() + 2;
+  }
+  middle = std::max<size_t>(middle, 1);
+  const std::string &middleCell = cells[middle];
+  uint16_t keySize = getField<uint16_t>(middleCell.data(), 0);
+  splitKey.assign(middleCell.data() + CELL_HEADER_SIZE, keySize);
+  uint8_t type = getField<uint8_t>(pPage, TYPE_OFFSET);
+  uint32_t link = getField<uint32_t>(pPage, LINK_OFFSET);
+  size_t first = middle;
+  if (LEAF_NODE == type)
+  {
+    initNode(right.getData(), LEAF_NODE, link);
+    link = right.getPageId();
+  }
+  else
+  {
+    initNode(right.getData(), INNER_NODE,
+             getField<uint32_t>(middleCell.data(),
+                                CELL_HEADER_SIZE + keySize));
+    first = middle + 1;
+  }
+  for (size_t i = first; i < cells.size(); i++)
+  {
+    appendCell(right.getData(), cells[i]);
+  }
+  initNode(pPage, type, link);
+  for (size_t i = 0; i < middle; i++)
+  {
+    appendCell(pPage, cells[i]);
+  }
+  right.setDirty();
+  rightPageId = right.getPageId();
+  return true;
+}
+
+CBPlusTree::CBPlusTree()
+    : m_pPool(NULL), m_metaPage(0), m_rootPage(NO_PAGE), m_height(0),
+      m_count(0)
+{
+}
+/**
+ * Opens the tree of a meta page. A zeroed meta page, as it is created by
+ * CBufferPool::newPage(), gets an empty tree.
+ * @param CBufferPool& pool [IN] - The pool
+ * @param uint32_t metaPage [IN] - The meta page
+ * @return true if the meta page holds a tree, false otherwise
+ */
+bool CBPlusTree::open(CBufferPool &pool, uint32_t metaPage)
+{
+  m_pPool = NULL;
+  CPageGuard meta(pool, metaPage);
+  if (!meta.isValid())
+  {
+    return false;
+  }
+  uint32_t magic = getField<uint32_t>(meta.getData(), META_MAGIC_OFFSET);
+  if (0 == magic)
+  {
+    CPageGuard root(pool);
+    if (!root.isValid())
+    {
+      return false;
+    }
+    initNode(root.getData(), LEAF_NODE, NO_PAGE);
+    root.setDirty();
+    m_pPool = &pool;
+    m_metaPage = metaPage;
+    m_rootPage = root.getPageId();
+    m_height = 1;
+    m_count = 0;
+    meta.release();
+    return flush();
+  }
+  if ((TREE_MAGIC != magic) ||
+      (TREE_VERSION !=
+       getField<uint32_t>(meta.getData(), META_VERSION_OFFSET)))
+  {
+    return false;
+  }
+  m_pPool = &pool;
+  m_metaPage = metaPage;
+  m_rootPage = getField<uint32_t>(meta.getData(), META_ROOT_OFFSET);
+  m_height = getField<uint32_t>(meta.getData(), META_HEIGHT_OFFSET);
+  m_count = getField<uint64_t>(meta.getData(), META_COUNT_OFFSET);
+  return true;
+}
+/**
+ * Writes the root, the height and the number of entries to the meta page
+ * @param None
+ * @return true if the meta page could be written, false otherwise
+ */
+bool CBPlusTree::flush(void)
+{
+  if (NULL == m_pPool)
+  {
+    return false;
+  }
+  CPageGuard meta(*m_pPool, m_metaPage);
+  if (!meta.isValid())
+  {
+    return false;
+  }
+  char *pMeta = meta.getData();
+  setField<uint32_t>(pMeta, META_MAGIC_OFFSET, TREE_MAGIC);
+  setField<uint32_t>(pMeta, META_VERSION_OFFSET, TREE_VERSION);
+  setField<uint32_t>(pMeta, META_ROOT_OFFSET, m_rootPage);
+  setField<uint32_t>(pMeta, META_HEIGHT_OFFSET, m_height);
+  setField<uint64_t>(pMeta, META_COUNT_OFFSET, m_count);
+  meta.setDirty();
+  return true;
+}
+/**
+ * Inserts an entry below a page, splitting the pages which are full. A
+ * page is unpinned while its child is changed, so that only the pages of
+ * one level and a split stay pinned.
+ * @param uint32_t pageId [IN] - The page
+ * @param std::string_view key, value [IN] - The entry
+ * @param bool isReplacing [IN] - Replaces the value of a present key
+ * @param split_t& split [OUT] - The split of the page
+ * @return status_t - The result
+ */
+CBPlusTree::status_t CBPlusTree::insertBelow(uint32_t pageId,
+                                             std::string_view key,
+                                             std::string_view value,
+                                             bool isReplacing,
+                                             split_t &split)
+{
+  split.isSplit = false;
+  CPageGuard page(*m_pPool, pageId);
+  if (!page.isValid())
+  {
+    return FAILED;
+  }
+  char *pPage = page.getData();
+  std::string cell;
+  size_t slot = 0;
+  status_t status = INSERTED;
+  if (INNER_NODE == getField<uint8_t>(pPage, TYPE_OFFSET))
+  {
+    uint32_t child = getChild(pPage, key);
+    page.release();
+    split_t childSplit;
+    status = insertBelow(child, key, value, isReplacing, childSplit);
+    if (!childSplit.isSplit)
+    {
+      return status;
+    }
+    CPageGuard parent(*m_pPool, pageId);
+    if (!parent.isValid())
+    {
+      return FAILED;
+    }
+    pPage = parent.getData();
+    cell = makeChildCell(childSplit.key, childSplit.pageId);
+    slot = upperBound(pPage, childSplit.key);
+    if (!insertCell(pPage, slot, cell))
+    {
+      split.isSplit =
+          splitNode(*m_pPool, pPage, slot, cell, split.key, split.pageId);
+      if (!split.isSplit)
+      {
+        return FAILED;
+      }
+    }
+    parent.setDirty();
+    return status;
+  }
+  slot = lowerBound(pPage, key);
+  bool isFound = (slot < getCount(pPage)) && (getKey(pPage, slot) == key);
+  if (isFound)
+  {
+    if (!isReplacing)
+    {
+      return DUPLICATE;
+    }
+    removeCell(pPage, slot);
+    status = REPLACED;
+  }
+  page.setDirty();
+  cell = makeCell(key, value);
+  if (!insertCell(pPage, slot, cell))
+  {
+    split.isSplit =
+        splitNode(*m_pPool, pPage, slot, cell, split.key, split.pageId);
+    if (!split.isSplit)
+    {
+      return FAILED;
+    }
+  }
+  if (!isFound)
+  {
+    m_count++;
+  }
+  return status;
+}
+/**
+ * Inserts an entry, a split root gets a new root above it
+ * @param std::string_view key [IN] - The key
+ * @param std::string_view value [IN] - The value
+ * @param bool isReplacing [IN] - Replaces the value of a present key
+ * @return status_t - The result
+ */
+CBPlusTree::status_t CBPlusTree::insert(std::string_view key,
+                                        std::string_view value,
+                                        bool isReplacing)
+{
+  if ((NULL == m_pPool) || (key.size() + value.size() > MAX_ENTRY_SIZE))
+  {
+    return FAILED;
+  }
+  split_t split;
+  status_t status = insertBelow(m_rootPage, key, value, isReplacing, split);
+  if (split.isSplit)
+  {
+    CPageGuard root(*m_pPool);
+    if (!root.isValid())
+    {
+      return FAILED;
+    }
+    initNode(root.getData(), INNER_NODE, m_rootPage);
+    appendCell(root.getData(), makeChildCell(split.key, split.pageId));
+    root.setDirty();
+    m_rootPage = root.getPageId();
+    m_height++;
+  }
+  return status;
+}
+/**
+ * Gets the leaf page which holds a key, or would hold it
+ * @param std::string_view key [IN] - The key
+ * @param uint32_t& pageId [OUT] - The leaf page
+ * @return true if every page could be read, false otherwise
+ */
+bool CBPlusTree::findLeaf(std::string_view key, uint32_t &pageId) const
+{
+  if (NULL == m_pPool)
+  {
+    return false;
+  }
+  pageId = m_rootPage;
+  for (uint32_t level = 1; level < m_height; level++)
+  {
+    CPageGuard page(*m_pPool, pageId);
+    if (!page.isValid() ||
+        (INNER_NODE != getField<uint8_t>(page.getData(), TYPE_OFFSET)))
+    {
+      return false;
+    }
+    pageId = getChild(page.getData(), key);
+  }
+  return true;
+}
+/**
+ * Finds the value of a key
+ * @param std::string_view key [IN] - The key
+ * @param std::string& value [OUT] - The value
+ * @return true if the key is present, false otherwise
+ */
+bool CBPlusTree::find(std::string_view key, std::string &value) const
+{
+  uint32_t pageId = NO_PAGE;
+  if (!findLeaf(key, pageId))
+  {
+    return false;
+  }
+  CPageGuard page(*m_pPool, pageId);
+  if (!page.isValid())
+  {
+    return false;
+  }
+  size_t slot = lowerBound(page.getData(), key);
+  if ((slot >= getCount(page.getData())) ||
+      (getKey(page.getData(), slot) != key))
+  {
+    return false;
+  }
+  value.assign(getValue(page.getData(), slot));
+  return true;
+}
+/**
+ * Removes an entry, its page is not merged with a neighbour
+ * @param std::string_view key [IN] - The key
+ * @return true if the key was present, false otherwise
+ */
+bool CBPlusTree::erase(std::string_view key)
+{
+  uint32_t pageId = NO_PAGE;
+  if (!findLeaf(key, pageId))
+  {
+    return false;
+  }
+  CPageGuard page(*m_pPool, pageId);
+  if (!page.isValid())
+  {
+    return false;
+  }
+  size_t slot = lowerBound(page.getData(), key);
+  if ((slot >= getCount(page.getData())) ||
+      (getKey(page.getData(), slot) != key))
+  {
+    return false;
+  }
+  removeCell(page.getData(), slot);
+  page.setDirty();
+  m_count--;
+  return true;
+}
+/**
+ * Visits the entries from a key up to another in key order, along the
+ * links of the leaves. One leaf is pinned at a time.
+ * @param std::string_view from [IN] - The first key
+ * @param std::string_view to [IN] - The key after the last, empty for the
+ * end of the tree
+ * @param const visitor_t& visitor [IN] - Called for each entry
+ * @return true if every page could be read, false otherwise
+ */
+bool CBPlusTree::scan(std::string_view from, std::string_view to,
+                      const visitor_t &visitor) const
+{
+  uint32_t pageId = NO_PAGE;
+  if (!findLeaf(from, pageId))
+  {
+    return false;
+  }
+  bool isFirstLeaf = true;
+  while (NO_PAGE != pageId)
+  {
+    CPageGuard page(*m_pPool, pageId);
+    if (!page.isValid())
+    {
+      return false;
+    }
+    const char *pPage = page.getData();
+    size_t count = getCount(pPage);
+    for (size_t slot = isFirstLeaf ? lowerBound(pPage, from) : 0;
+         slot < count; slot++)
+    {
+      std::string_view key = getKey(pPage, slot);
+      if ((!to.empty() && !(key < to)) || !visitor(key, getValue(pPage, slot)))
+      {
+        return true;
+      }
+    }
+    isFirstLeaf = false;
+    pageId = getField<uint32_t>(pPage, LINK_OFFSET);
+  }
+  return true;
+}
@@ -0,0 +1,178 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBatchQuery.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBatchQuery
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <nsp/CBatchQuery.h>
+
+#define NEAREST_POI_GRAIN (1024) /**< @brief Represents the nearest-POI
+                                    queries per task */
+#define ROUTE_GRAIN (16) /**< @brief Represents the route queries per task */
+
+typedef std::chrono::steady_clock batchClock_t;
+
+/**
+ * Gets the microseconds between two time points
+ */
+static double elapsedMicroseconds(const batchClock_t::time_point &start,
+                                  const batchClock_t::time_point &end)
+{
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+/**
+ * Constructor of CBatchQuery class
+ * @param CThreadPool& pool [IN] - The pool which runs the queries
+ */
+CBatchQuery::CBatchQuery(CThreadPool &pool)
+    : m_pPool(&pool), m_pFinderHierarchy(NULL)
+{
+}
+
+CBatchQuery::~CBatchQuery() { releaseRouteFinders(); }
+/**
+ * Deletes the route finders
+ * @param None
+ * @return None
+ */
+void CBatchQuery::releaseRouteFinders(void)
+{
+  for (size_t i = 0; i < m_routeFinders.size(); i++)
+  {
+    delete m_routeFinders[i];
+  }
+  m_routeFinders.clear();
+  m_pFinderHierarchy = NULL;
+}
+/**
+ * Searches the nearest POI of every position
+ * @param const CSpatialGrid& grid [IN] - The POI index
+ * @param const double* latitudes [IN] - Latitudes of the positions
+ * @param const double* longitudes [IN] - Longitudes of the positions
+ * @param size_t count [IN] - Number of positions
+ * @param const CPOI** pois [OUT] - The nearest POI of each position
+ * @param double* distances [OUT] - The distances in kilometers
+ * @param batchStats_t& stats [OUT] - Statistics of the batch
+ * @return None
+ */
+void CBatchQuery::findNearestPois(const CSpatialGrid &grid,
+                                  const double *latitudes,
+                                  const double *longitudes, size_t count,
+                                  const CPOI **pois, double *distances,
+                                  batchStats_t &stats)
+{
+  m_latencies.resize(count);
+  double *latencies = m_latencies.data();
+  batchClock_t::time_point batchStart = batchClock_t::now();
+  m_pPool->parallelFor(
+      count, NEAREST_POI_GRAIN,
+      [&](size_t begin, size_t end, unsigned int) {
+        batchClock_t::time_point queryStart = batchClock_t::now();
+        for (size_t i = begin; i < end; i++)
+        {
+          if (!grid.findNearest(latitudes[i], longitudes[i], pois[i],
+                                distances[i]))
+          {
+            pois[i] = NULL;
+            distances[i] = HUGE_VAL;
+          }
+          batchClock_t::time_point queryEnd = batchClock_t::now();
+          latencies[i] = elapsedMicroseconds(queryStart, queryEnd);
+          queryStart = queryEnd;
+        }
+      });
+  computeStats(count, elapsedMicroseconds(batchStart, batchClock_t::now()) /
+                          1e6,
+               stats);
+}
+/**
+ * Searches the shortest path length of every source/target pair. Every
+ * worker uses its own route finder, the finders are kept for the next
+ * batch on the same hierarchy.
+ * @param const CContractionHierarchy& hierarchy [IN] - The road network
+ * @param const node_t* sources [IN] - Start nodes
+ * @param const node_t* targets [IN] - Destination nodes
+ * @param size_t count [IN] - Number of pairs
+ * @param double* distances [OUT] - The lengths in kilometers, HUGE_VAL if
+ * the target cannot be reached
+ * @param batchStats_t& stats [OUT] - Statistics of the batch
+ * @return None
+ */
+void CBatchQuery::findRouteDistances(const CContractionHierarchy &hierarchy,
+                                     const node_t *sources,
+                                     const node_t *targets, size_t count,
+                                     double *distances, batchStats_t &stats)
+{
+  if (m_pFinderHierarchy != &hierarchy)
+  {
+    releaseRouteFinders();
+    for (unsigned int i = 0; i < m_pPool->getThreadCount(); i++)
+    {
+      m_routeFinders.push_back(new CHierarchyRouteFinder(hierarchy));
+    }
+    m_pFinderHierarchy = &hierarchy;
+  }
+  m_latencies.resize(count);
+  double *latencies = m_latencies.data();
+  batchClock_t::time_point batchStart = batchClock_t::now();
+  m_pPool->parallelFor(
+      count, ROUTE_GRAIN, [&](size_t begin, size_t end, unsigned int worker) {
+        CHierarchyRouteFinder &finder = *m_routeFinders[worker];
+        batchClock_t::time_point queryStart = batchClock_t::now();
+        for (size_t i = begin; i < end; i++)
+        {
+          if (!finder.findDistance(sources[i], targets[i], distances[i]))
+          {
+            distances[i] = HUGE_VAL;
+          }
+          batchClock_t::time_point queryEnd = batchClock_t::now();
+          latencies[i] = elapsedMicroseconds(queryStart, queryEnd);
+          queryStart = queryEnd;
+        }
+      });
+  computeStats(count, elapsedMicroseconds(batchStart, batchClock_t::now()) /
+                          1e6,
+               stats);
+}
+/**
+ * Fills the statistics from the latencies of the last batch. The
+ * percentiles are selected in place, the latencies are not sorted.
+ * @param size_t count [IN] - Number of queries
+ * @param double elapsedSeconds [IN] - Wall clock time of the batch
+ * @param batchStats_t& stats [OUT] - The statistics
+ * @return None
+ */
+void CBatchQuery::computeStats(size_t count, double elapsedSeconds,
+                               batchStats_t &stats)
+{
+  stats.queryCount = count;
+  stats.elapsedSeconds = elapsedSeconds;
+  stats.queriesPerSecond = (elapsedSeconds > 0) ? count / elapsedSeconds : 0;
+  stats.meanLatencyUs = stats.p50LatencyUs = 0;
+  stats.p99LatencyUs = stats.maxLatencyUs = 0;
+  if (0 == count)
+  {
+    return;
+  }
+  double sum = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    sum += m_latencies[i];
+  }
+  stats.meanLatencyUs = sum / count;
+  std::vector<double>::iterator p50 = m_latencies.begin() + count / 2;
+  std::nth_element(m_latencies.begin(), p50, m_latencies.end());
+  stats.p50LatencyUs = *p50;
+  /* The 99th percentile lies above the median */
+  std::vector<double>::iterator p99 =
+      m_latencies.begin() + std::min(count - 1, count * 99 / 100);
+  std::nth_element(p50, p99, m_latencies.end());
+  stats.p99LatencyUs = *p99;
+  stats.maxLatencyUs = *std::max_element(p99, m_latencies.end());
+}
@@ -0,0 +1,429 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBinaryPersistence.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBinaryPersistence
+****************************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include <string_view>
+#include <vector>
+
+#include <nsp/CBinaryPersistence.h>
+#include <nsp/CBufferedWriter.h>
+#include <nsp/CDiagnostics.h>
+
+#define FILE_LOCATION \
+  "myCode/" /**< @brief Represents the snapshot file location */
+#define FILE_EXTENSION \
+  ".bin" /**< @brief Represents the extension of the snapshot file */
+#define COLUMN_BLOCK_SIZE \
+  (4096) /**< @brief Represents the values checksummed and appended at once */
+#define MAX_TABLE_COUNT \
+  (0xfffffffeull) /**< @brief Represents the most entries of a table */
+
+/**
+ * Represents the section of the snapshot which is being written
+ */
+typedef struct {
+  CBufferedWriter *pFile; /**< \brief Represents the snapshot file */
+  uint64_t offset;        /**< \brief Represents the bytes written */
+  CBinarySnapshot::sectionEntry_t *pEntry; /**< \brief Represents the entry
+                                              of the section in the trailer */
+} sectionOutput_t;
+
+/**
+ * Gets the type of a POI as it is stored
+ */
+static uint8_t getPoiType(const CPOI &poi)
+{
+  return static_cast<uint8_t>(poi.getType());
+}
+static uint8_t getPoiType(const CWaypoint &) { return CPOI::UNKNOWN; }
+/**
+ * Gets the description of a POI, a waypoint has none
+ */
+static std::string getDescription(const CPOI &poi)
+{
+  return poi.getDescription();
+}
+static std::string getDescription(const CWaypoint &) { return std::string(); }
+/**
+ * Appends bytes to the file and to the checksum of the current section
+ * @param sectionOutput_t& output [IN/OUT] - The output
+ * @param const void* pData [IN] - The bytes
+ * @param size_t size [IN] - The number of bytes
+ * @return None
+ */
+static void appendBytes(sectionOutput_t &output, const void *pData,
+                        size_t size)
+{
+  output.pFile->append(
+      std::string_view(static_cast<const char *>(pData), size));
+  output.offset += size;
+  if (NULL != output.pEntry)
+  {
+    output.pEntry->checksum =
+        CBinarySnapshot::updateChecksum(output.pEntry->checksum, pData, size);
+    output.pEntry->size += size;
+  }
+}
+/**
+ * Pads the file to a multiple of 8 bytes and starts a section there
+ * @param sectionOutput_t& output [IN/OUT] - The output
+ * @param CBinarySnapshot::sectionEntry_t& entry [OUT] - The entry of the
+ * section
+ * @return None
+ */
+static void beginSection(sectionOutput_t &output,
+                         CBinarySnapshot::sectionEntry_t &entry)
+{
+  static const char s_padding[8] = {0};
+  output.pEntry = NULL;
+  appendBytes(output, s_padding, (8 - output.offset % 8) % 8);
+  memset(&entry, 0, sizeof(entry));
+  entry.offset = output.offset;
+  output.pEntry = &entry;
+}
+/**
+ * Appends a column with one value per entry, in blocks of COLUMN_BLOCK_SIZE
+ * values
+ * @param sectionOutput_t& output [IN/OUT] - The output
+ * @param const std::vector<Iterator>& entries [IN] - The Database entries
+ * @param Getter getValue [IN] - Gets the value of an entry
+ * @return None
+ */
+template <typename Value, typename Iterator, typename Getter>
+static void appendColumn(sectionOutput_t &output,
+                         const std::vector<Iterator> &entries,
+                         Getter getValue)
+{
+  Value block[COLUMN_BLOCK_SIZE];
+  size_t used = 0;
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    block[used++] = getValue(entries[i]->first, entries[i]->second);
+    if (COLUMN_BLOCK_SIZE == used)
+    {
+      appendBytes(output, block, sizeof(block));
+      used = 0;
+    }
+  }
+  appendBytes(output, block, used * sizeof(Value));
+}
+/**
+ * Builds the open addressing hash index of the names
+ * @param const std::vector<Iterator>& entries [IN] - The Database entries
+ * @param std::vector<uint32_t>& slots [OUT] - The slots, index + 1 or 0
+ * @return None
+ */
+template <typename Iterator>
+static void buildNameIndex(const std::vector<Iterator> &entries,
+                           std::vector<uint32_t> &slots)
+{
+  /* At most two of three slots are used, at least one is empty */
+  size_t slotCount = 1;
+  while (slotCount <= entries.size() + entries.size() / 2)
+    slotCount <<= 1;
+  slots.assign(slotCount, 0);
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    size_t slot = CBinarySnapshot::hashName(entries[i]->first) &
+                  (slotCount - 1);
+    while (0 != slots[slot])
+      slot = (slot + 1) & (slotCount - 1);
+    slots[slot] = i + 1;
+  }
+}
+/**
+ * Appends the sections of a table. The string offsets continue at the end
+ * of the strings of the previous tables.
+ * @param sectionOutput_t& output [IN/OUT] - The output
+ * @param const std::vector<Iterator>& entries [IN] - The Database entries
+ * @param CBinarySnapshot::table_t table [IN] - The table
+ * @param CBinarySnapshot::trailer_t& trailer [OUT] - The trailer
+ * @param uint64_t& heapSize [IN/OUT] - The size of the strings before
+ * @return None
+ */
+template <typename Iterator>
+static void appendTable(sectionOutput_t &output,
+                        const std::vector<Iterator> &entries,
+                        CBinarySnapshot::table_t table,
+                        CBinarySnapshot::trailer_t &trailer,
+                        uint64_t &heapSize)
+{
+  typedef typename Iterator::value_type::second_type Data_t;
+  CBinarySnapshot::sectionEntry_t *pSections =
+      trailer.sections + table * CBinarySnapshot::TABLE_SECTION_COUNT;
+  bool isPoi = (CBinarySnapshot::POI_TABLE == table);
+  trailer.counts[table] = entries.size();
+
+  beginSection(output, pSections[CBinarySnapshot::LATITUDES]);
+  appendColumn<double>(output, entries,
+                       [](const std::string &, const Data_t &data) {
+                         return data.getLatitude();
+                       });
+  beginSection(output, pSections[CBinarySnapshot::LONGITUDES]);
+  appendColumn<double>(output, entries,
+                       [](const std::string &, const Data_t &data) {
+                         return data.getLongitude();
+                       });
+  beginSection(output, pSections[CBinarySnapshot::TYPES]);
+  if (isPoi)
+  {
+    appendColumn<uint8_t>(output, entries,
+                          [](const std::string &, const Data_t &data) {
+                            return getPoiType(data);
+                          });
+  }
+  beginSection(output, pSections[CBinarySnapshot::NAME_OFFSETS]);
+  appendColumn<uint64_t>(output, entries,
+                         [&](const std::string &name, const Data_t &) {
+                           uint64_t offset = heapSize;
+                           heapSize += name.size();
+                           return offset;
+                         });
+  appendBytes(output, &heapSize, sizeof(heapSize));
+  beginSection(output, pSections[CBinarySnapshot::DESCRIPTION_OFFSETS]);
+  if (isPoi)
+  {
+    appendColumn<uint64_t>(output, entries,
+                           [&](const std::string &, const Data_t &data) {
+                             uint64_t offset = heapSize;
+                             heapSize += getDescription(data).size();
+                             return offset;
+                           });
+    appendBytes(output, &heapSize, sizeof(heapSize));
+  }
+  std::vector<uint32_t> slots;
+  buildNameIndex(entries, slots);
+  trailer.slots[table] = slots.size();
+  beginSection(output, pSections[CBinarySnapshot::NAME_INDEX]);
+  appendBytes(output, slots.data(), slots.size() * sizeof(uint32_t));
+}
+/**
+ * Appends the strings of a table to the string heap, in the order of the
+ * offsets written by appendTable()
+ * @param sectionOutput_t& output [IN/OUT] - The output
+ * @param const std::vector<Iterator>& entries [IN] - The Database entries
+ * @param bool isDescription [IN] - Appends the descriptions, not the names
+ * @param std::string& block [IN/OUT] - The strings not yet appended
+ * @return None
+ */
+template <typename Iterator>
+static void appendStrings(sectionOutput_t &output,
+                          const std::vector<Iterator> &entries,
+                          bool isDescription, std::string &block)
+{
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    if (isDescription)
+      block += getDescription(entries[i]->second);
+    else
+      block += entries[i]->first;
+    if (block.size() >= COLUMN_BLOCK_SIZE * sizeof(uint64_t))
+    {
+      appendBytes(output, block.data(), block.size());
+      block.clear();
+    }
+  }
+}
+/**
+ * Set the name of the media to be used for persistent storage. The
+ * snapshot is myCode/<name>.bin
+ *
+ * @param name the media to be used
+ */
+void CBinaryPersistence::setMediaName(std::string name)
+{
+  m_fileName = FILE_LOCATION + name + FILE_EXTENSION;
+}
+/**
+ * Get the files of the media which writeData() replaces
+ *
+ * @param fileNames the names of the files (with path)
+ */
+void CBinaryPersistence::getMediaFiles(
+    std::vector<std::string> &fileNames) const
+{
+  fileNames.assign(1, m_fileName);
+}
+/**
+ * Write the data to the persistent storage. The columns are appended in
+ * blocks straight from the databases, only the name indexes are built in
+ * memory. The trailer with the checksums is written last.
+ *
+ * @param waypointDb[IN] the data base with way points
+ * @param poiDb[IN] the database with points of interest
+ * @return true if the data could be saved successfully
+ */
+bool CBinaryPersistence::writeData(const CWpDatabase &waypointDb,
+                                   const CPoiDatabase &poiDb)
+{
+  if ((waypointDb.size() > MAX_TABLE_COUNT) || (poiDb.size() > MAX_TABLE_COUNT))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CBinaryPersistence::writeData() failed: Too many entries");
+    return false;
+  }
+  std::vector<CWpDatabase::const_iterator> waypoints;
+  waypoints.reserve(waypointDb.size());
+  for (CWpDatabase::const_iterator itr = waypointDb.begin();
+       itr != waypointDb.end(); ++itr)
+  {
+    waypoints.push_back(itr);
+  }
+  std::vector<CPoiDatabase::const_iterator> pois;
+  pois.reserve(poiDb.size());
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    pois.push_back(itr);
+  }
+
+  CBufferedWriter snapshotFile;
+  if (!snapshotFile.open(m_fileName))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CBinaryPersistence::writeData() failed: Unable to open " +
+            m_fileName);
+    return false;
+  }
+  CBinarySnapshot::header_t header;
+  header.magic = CBinarySnapshot::SNAPSHOT_MAGIC;
+  header.version = CBinarySnapshot::SNAPSHOT_VERSION;
+  CBinarySnapshot::trailer_t trailer;
+  memset(&trailer, 0, sizeof(trailer));
+  trailer.magic = CBinarySnapshot::SNAPSHOT_MAGIC;
+  trailer.version = CBinarySnapshot::SNAPSHOT_VERSION;
+
+  sectionOutput_t output = {&snapshotFile, 0, NULL};
+  appendBytes(output, &header, sizeof(header));
+  uint64_t heapSize = 0;
+  appendTable(output, waypoints, CBinarySnapshot::WAYPOINT_TABLE, trailer,
+              heapSize);
+  appendTable(output, pois, CBinarySnapshot::POI_TABLE, trailer, heapSize);
+
+  beginSection(output, trailer.sections[CBinarySnapshot::STRING_HEAP]);
+  std::string block;
+  appendStrings(output, waypoints, false, block);
+  appendStrings(output, pois, false, block);
+  appendStrings(output, pois, true, block);
+  appendBytes(output, block.data(), block.size());
+
+  /* The trailer starts at a multiple of 8, as it ends the file */
+  CBinarySnapshot::sectionEntry_t padding;
+  beginSection(output, padding);
+  output.pEntry = NULL;
+  trailer.checksum = CBinarySnapshot::updateChecksum(
+      0, &trailer, offsetof(CBinarySnapshot::trailer_t, checksum));
+  appendBytes(output, &trailer, sizeof(trailer));
+
+  if (!snapshotFile.close())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CBinaryPersistence::writeData() failed: Unable to write " +
+            m_fileName);
+    return false;
+  }
+  return true;
+}
+/**
+ * Fill the databases with the data from persistent storage. If
+ * merge mode is MERGE, the content in the persistent storage
+ * will be merged with any content already existing in the data
+ * bases. If merge mode is REPLACE, already existing content
+ * will be removed before inserting the content from the persistent
+ * storage. The databases are not changed if the snapshot is not intact.
+ *
+ * @param waypointDb[OUT] the the data base with way points
+ * @param poiDb[OUT] the database with points of interest
+ * @param mode[IN] the merge mode
+ * @return true if the data could be read successfully
+ */
+bool CBinaryPersistence::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
+                                  MergeMode mode)
+{
+  CDiagnosticScope load("CBinaryPersistence::readData()");
+  CBinarySnapshot snapshot;
+  if (!readSnapshot(snapshot))
+  {
+    return false;
+  }
+  if (!snapshot.verify())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CBinaryPersistence::readData() failed: Checksum error in " +
+            m_fileName);
+    return false;
+  }
+  switch (mode)
+  {
+  case MERGE:
+  {
+    // no change
+    break;
+  }
+  case REPLACE:
+  {
+    waypointDb.clearWpDatabase();
+    poiDb.clearPoiDatabase();
+    break;
+  }
+  default:
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR, "Invalid Mode Specified");
+    return false;
+  }
+  }
+  /* The entries are moved into the Databases, in key order they are
+   * appended without searching */
+  for (size_t i = 0; i < snapshot.getCount(CBinarySnapshot::WAYPOINT_TABLE);
+       i++)
+  {
+    CWpDatabase::node_t node = CWpDatabase::createNode(
+        std::string(snapshot.getName(CBinarySnapshot::WAYPOINT_TABLE, i)),
+        snapshot.getWaypoint(i));
+    waypointDb.addNode(node);
+  }
+  const uint8_t *pTypes = snapshot.getPoiTypes();
+  for (size_t i = 0; i < snapshot.getCount(CBinarySnapshot::POI_TABLE); i++)
+  {
+    if (pTypes[i] > CPOI::UNKNOWN)
+    {
+      CDiagnostics::report(
+          CDiagnostics::INVALID_VALUE,
+          "ERROR!CBinaryPersistence::readData() failed! Invalid POI Type!");
+      continue;
+    }
+    CPoiDatabase::node_t node = CPoiDatabase::createNode(
+        std::string(snapshot.getName(CBinarySnapshot::POI_TABLE, i)),
+        snapshot.getPoi(i));
+    poiDb.addNode(node);
+  }
+  return true;
+}
+/**
+ * Maps the snapshot file into the snapshot, nothing is copied. The
+ * checksums are not checked, see CBinarySnapshot::verify().
+ * @param CBinarySnapshot& snapshot [OUT] - The snapshot
+ * @return true if the file is a complete snapshot, false otherwise
+ */
+bool CBinaryPersistence::readSnapshot(CBinarySnapshot &snapshot)
+{
+  if (!snapshot.open(m_fileName))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CBinaryPersistence::readData() failed: " + m_fileName +
+            " is not a complete snapshot");
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,316 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBinarySnapshot.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBinarySnapshot
+****************************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include <limits>
+
+#include <nsp/CBinarySnapshot.h>
+
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "The binary snapshot is read in place and needs a little-endian host"
+#endif
+static_assert(std::numeric_limits<double>::is_iec559 && (8 == sizeof(double)),
+              "The binary snapshot stores IEEE 754 doubles");
+
+#define CRC_POLYNOMIAL \
+  (0xedb88320u) /**< @brief Represents the reflected CRC-32 polynomial */
+#define FNV_OFFSET_BASIS \
+  (14695981039346656037ull) /**< @brief Represents the FNV-1a start value */
+#define FNV_PRIME (1099511628211ull) /**< @brief Represents the FNV prime */
+#define MAX_TABLE_COUNT \
+  (0xfffffffeull) /**< @brief Represents the most entries of a table, the
+                     name index stores index + 1 in 32 bits */
+
+/**
+ * Represents the lookup tables of the CRC-32, which processes 8 bytes per
+ * step (slicing-by-8)
+ */
+typedef struct crcTables_t {
+  uint32_t table[8][256]; /**< \brief Represents the CRC of a byte at the
+                             positions 0 to 7 before the end of a step */
+  crcTables_t()
+  {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; bit++)
+        crc = (crc >> 1) ^ ((crc & 1) ? CRC_POLYNOMIAL : 0);
+      table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      for (int slice = 1; slice < 8; slice++)
+        table[slice][i] = (table[slice - 1][i] >> 8) ^
+                          table[0][table[slice - 1][i] & 0xff];
+    }
+  }
+} crcTables_t;
+
+/**
+ * Checks that a section lies between the header and the trailer, is aligned
+ * and has the size which the counts of the trailer give
+ * @param const CBinarySnapshot::sectionEntry_t& section [IN] - The section
+ * @param uint64_t end [IN] - The start of the trailer
+ * @param uint64_t size [IN] - The expected size in bytes
+ * @return true if the section is valid, false otherwise
+ */
+static bool isValidSection(const CBinarySnapshot::sectionEntry_t &section,
+                           uint64_t end, uint64_t size)
+{
+  return (section.size == size) && (0 == section.offset % 8) &&
+         (section.offset >= sizeof(CBinarySnapshot::header_t)) &&
+         (section.offset <= end) && (section.size <= end - section.offset);
+}
+/**
+ * Updates a CRC-32 (IEEE 802.3) with the bytes
+ * @param uint32_t checksum [IN] - The CRC of the previous bytes, 0 at the
+ * start
+ * @param const void* pData [IN] - The bytes
+ * @param size_t size [IN] - The number of bytes
+ * @return uint32_t - The CRC of the previous bytes and the bytes
+ */
+uint32_t CBinarySnapshot::updateChecksum(uint32_t checksum, const void *pData,
+                                         size_t size)
+{
+  static const crcTables_t s_tables;
+  const uint32_t(*table)[256] = s_tables.table;
+  const unsigned char *pByte = static_cast<const unsigned char *>(pData);
+  uint32_t crc = ~checksum;
+  for (; size >= 8; size -= 8, pByte += 8)
+  {
+    uint32_t low, high;
+    memcpy(&low, pByte, sizeof(low));
+    memcpy(&high, pByte + 4, sizeof(high));
+    low ^= crc;
+    crc = table[7][low & 0xff] ^ table[6][(low >> 8) & 0xff] ^
+          table[5][(low >> 16) & 0xff] ^ table[4][low >> 24] ^
+          table[3][high & 0xff] ^ table[2][(high >> 8) & 0xff] ^
+          table[1][(high >> 16) & 0xff] ^ table[0][high >> 24];
+  }
+  for (; size > 0; size--, pByte++)
+    crc = (crc >> 8) ^ table[0][(crc ^ *pByte) & 0xff];
+  return ~crc;
+}
+/**
+ * Hashes a name as the name index does (64 bit FNV-1a)
+ * @param std::string_view name [IN] - The name
+ * @return uint64_t - The hash
+ */
+uint64_t CBinarySnapshot::hashName(std::string_view name)
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for (size_t i = 0; i < name.size(); i++)
+  {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+/**
+ * Maps the snapshot and checks its header, its trailer and the bounds of
+ * its sections. The time does not depend on the size of the file.
+ * @param const std::string& fileName [IN] - Name of the snapshot file
+ * @return true if the file is a complete snapshot, false otherwise
+ */
+bool CBinarySnapshot::open(const std::string &fileName)
+{
+  close();
+  if (!m_file.open(fileName))
+  {
+    return false;
+  }
+  size_t size = m_file.getSize();
+  if ((size < sizeof(header_t) + sizeof(trailer_t)) ||
+      (0 != (size - sizeof(trailer_t)) % 8))
+  {
+    close();
+    return false;
+  }
+  const header_t *pHeader =
+      reinterpret_cast<const header_t *>(m_file.getData());
+  const trailer_t *pTrailer =
+      reinterpret_cast<const trailer_t *>(m_file.getData() + size -
+                                          sizeof(trailer_t));
+  bool isValid = (SNAPSHOT_MAGIC == pHeader->magic) &&
+                 (SNAPSHOT_VERSION == pHeader->version) &&
+                 (SNAPSHOT_MAGIC == pTrailer->magic) &&
+                 (SNAPSHOT_VERSION == pTrailer->version) &&
+                 (pTrailer->checksum ==
+                  updateChecksum(0, pTrailer, offsetof(trailer_t, checksum)));
+
+  uint64_t end = size - sizeof(trailer_t);
+  for (int table = 0; isValid && (table < TABLE_COUNT); table++)
+  {
+    uint64_t count = pTrailer->counts[table];
+    uint64_t slots = pTrailer->slots[table];
+    /* The index keeps an empty slot, so that a lookup ends */
+    isValid = (count <= MAX_TABLE_COUNT) && (slots > count) &&
+              (0 == (slots & (slots - 1)));
+    uint64_t sizes[TABLE_SECTION_COUNT] = {
+        count * sizeof(double),
+        count * sizeof(double),
+        (POI_TABLE == table) ? count : 0,
+        (count + 1) * sizeof(uint64_t),
+        (POI_TABLE == table) ? (count + 1) * sizeof(uint64_t) : 0,
+        slots * sizeof(uint32_t)};
+    const sectionEntry_t *pSections =
+        pTrailer->sections + table * TABLE_SECTION_COUNT;
+    for (int section = 0; isValid && (section < TABLE_SECTION_COUNT);
+         section++)
+    {
+      isValid = isValidSection(pSections[section], end, sizes[section]);
+    }
+  }
+  if (isValid)
+  {
+    isValid = isValidSection(pTrailer->sections[STRING_HEAP], end,
+                             pTrailer->sections[STRING_HEAP].size);
+  }
+  if (!isValid)
+  {
+    close();
+    return false;
+  }
+  m_pTrailer = pTrailer;
+  return true;
+}
+/**
+ * Releases the mapping
+ * @param None
+ * @return None
+ */
+void CBinarySnapshot::close(void)
+{
+  m_pTrailer = NULL;
+  m_file.close();
+}
+/**
+ * Checks the checksums of the sections and that the string offsets are
+ * ascending. Reads the whole file.
+ * @param None
+ * @return true if the snapshot is intact, false otherwise
+ */
+bool CBinarySnapshot::verify(void) const
+{
+  if (!isOpen())
+  {
+    return false;
+  }
+  for (size_t section = 0; section < SECTION_COUNT; section++)
+  {
+    const sectionEntry_t &entry = m_pTrailer->sections[section];
+    if (entry.checksum !=
+        updateChecksum(0, m_file.getData() + entry.offset, entry.size))
+    {
+      return false;
+    }
+  }
+  uint64_t heapSize = m_pTrailer->sections[STRING_HEAP].size;
+  for (int table = 0; table < TABLE_COUNT; table++)
+  {
+    for (int section = NAME_OFFSETS; section <= DESCRIPTION_OFFSETS;
+         section++)
+    {
+      if ((WAYPOINT_TABLE == table) && (DESCRIPTION_OFFSETS == section))
+        continue;
+      const uint64_t *pOffsets = reinterpret_cast<const uint64_t *>(
+          getSection((table_t)table, (section_t)section));
+      size_t count = m_pTrailer->counts[table];
+      for (size_t i = 0; i < count; i++)
+      {
+        if (pOffsets[i] > pOffsets[i + 1])
+          return false;
+      }
+      if (pOffsets[count] > heapSize)
+        return false;
+    }
+  }
+  return true;
+}
+/**
+ * Gets the string between two offsets of an offset section
+ * @param table_t table [IN] - The table
+ * @param section_t section [IN] - NAME_OFFSETS or DESCRIPTION_OFFSETS
+ * @param size_t index [IN] - Index of the entry
+ * @return std::string_view - The string, empty if the offsets are invalid
+ */
+std::string_view CBinarySnapshot::getString(table_t table, section_t section,
+                                            size_t index) const
+{
+  const uint64_t *pOffsets =
+      reinterpret_cast<const uint64_t *>(getSection(table, section));
+  uint64_t begin = pOffsets[index], end = pOffsets[index + 1];
+  /* An unverified file must not lead out of the string heap */
+  if ((begin > end) || (end > m_pTrailer->sections[STRING_HEAP].size))
+  {
+    return std::string_view();
+  }
+  return std::string_view(m_file.getData() +
+                              m_pTrailer->sections[STRING_HEAP].offset + begin,
+                          end - begin);
+}
+/**
+ * Finds an entry by its name through the name index
+ * @param table_t table [IN] - The table
+ * @param std::string_view name [IN] - The name
+ * @param size_t& index [OUT] - Index of the entry
+ * @return true if the name is found, false otherwise
+ */
+bool CBinarySnapshot::find(table_t table, std::string_view name,
+                           size_t &index) const
+{
+  if (!isOpen())
+  {
+    return false;
+  }
+  const uint32_t *pSlots =
+      reinterpret_cast<const uint32_t *>(getSection(table, NAME_INDEX));
+  uint64_t mask = m_pTrailer->slots[table] - 1;
+  uint64_t count = m_pTrailer->counts[table];
+  uint64_t slot = hashName(name) & mask;
+  for (uint64_t probe = 0; probe <= mask; probe++)
+  {
+    uint32_t entry = pSlots[slot];
+    if (0 == entry)
+    {
+      return false;
+    }
+    if ((entry <= count) && (getName(table, entry - 1) == name))
+    {
+      index = entry - 1;
+      return true;
+    }
+    slot = (slot + 1) & mask;
+  }
+  return false;
+}
+/**
+ * Materializes a waypoint of the snapshot
+ * @param size_t index [IN] - Index of the entry
+ * @return CWaypoint - The waypoint as it was written
+ */
+CWaypoint CBinarySnapshot::getWaypoint(size_t index) const
+{
+  return CWaypoint(getLatitudes(WAYPOINT_TABLE)[index],
+                   getLongitudes(WAYPOINT_TABLE)[index],
+                   std::string(getName(WAYPOINT_TABLE, index)));
+}
+/**
+ * Materializes a POI of the snapshot
+ * @param size_t index [IN] - Index of the entry
+ * @return CPOI - The POI as it was written, an invalid type is UNKNOWN
+ */
+CPOI CBinarySnapshot::getPoi(size_t index) const
+{
+  uint8_t type = getPoiTypes()[index];
+  return CPOI((type <= CPOI::UNKNOWN) ? (CPOI::t_poi)type : CPOI::UNKNOWN,
+              std::string(getName(POI_TABLE, index)),
+              std::string(getDescription(POI_TABLE, index)),
+              getLatitudes(POI_TABLE)[index], getLongitudes(POI_TABLE)[index]);
+}
@@ -0,0 +1,269 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBufferPool.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBufferPool
+****************************************************************************/
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <nsp/CBufferPool.h>
+
+#define FILE_PERMISSIONS \
+  (0644) /**< @brief Represents the permissions of a created file */
+
+CBufferPool::CBufferPool()
+    : m_fd(-1), m_pageCount(0), m_clockHand(0), m_hits(0), m_misses(0),
+      m_evictions(0), m_isFailed(false)
+{
+}
+
+CBufferPool::~CBufferPool() { close(); }
+/**
+ * Opens or creates the page file. A previously opened file is closed.
+ * @param const std::string& fileName [IN] - Name of the file
+ * @param size_t frames [IN] - The frames, at least MIN_POOL_FRAMES
+ * @param bool isTruncated [IN] - Removes the pages of an existing file
+ * @return true if the file could be opened, false otherwise
+ */
+bool CBufferPool::open(const std::string &fileName, size_t frames,
+                       bool isTruncated)
+{
+  close();
+  m_fd = ::open(fileName.c_str(),
+                O_RDWR | O_CREAT | (isTruncated ? O_TRUNC : 0),
+                FILE_PERMISSIONS);
+  if (m_fd < 0)
+  {
+    return false;
+  }
+  struct stat status;
+  if (0 != fstat(m_fd, &status))
+  {
+    ::close(m_fd);
+    m_fd = -1;
+    return false;
+  }
+  /* A page which was not completely written is not part of the file */
+  m_pageCount = status.st_size / DB_PAGE_SIZE;
+  frames = std::max<size_t>(frames, MIN_POOL_FRAMES);
+  m_memory.assign(frames * DB_PAGE_SIZE, 0);
+  frame_t frame = {0, 0, false, false, false};
+  m_frames.assign(frames, frame);
+  m_pageFrames.clear();
+  m_pageFrames.reserve(frames);
+  m_clockHand = 0;
+  m_hits = m_misses = m_evictions = 0;
+  m_isFailed = false;
+  return true;
+}
+/**
+ * Writes the changed pages and closes the file
+ * @param None
+ * @return true if every write succeeded, false otherwise
+ */
+bool CBufferPool::close(void)
+{
+  if (m_fd < 0)
+  {
+    return false;
+  }
+  bool isFlushed = flush();
+  bool isClosed = (0 == ::close(m_fd));
+  m_fd = -1;
+  m_pageCount = 0;
+  m_memory.clear();
+  m_frames.clear();
+  m_pageFrames.clear();
+  return isFlushed && isClosed;
+}
+/**
+ * Writes the changed pages to the file
+ * @param None
+ * @return true if every write succeeded, false otherwise
+ */
+bool CBufferPool::flush(void)
+{
+  bool isWritten = true;
+  for (size_t frame = 0; frame < m_frames.size(); frame++)
+  {
+    isWritten = writeFrame(frame) && isWritten;
+  }
+  return isWritten && !m_isFailed;
+}
+/**
+ * Removes every page of the file. The pages must not be pinned.
+ * @param None
+ * @return true if the file was truncated, false otherwise
+ */
+bool CBufferPool::truncate(void)
+{
+  if ((m_fd < 0) || (0 != ftruncate(m_fd, 0)))
+  {
+    return false;
+  }
+  for (size_t frame = 0; frame < m_frames.size(); frame++)
+  {
+    m_frames[frame].isValid = false;
+    m_frames[frame].isDirty = false;
+    m_frames[frame].pinCount = 0;
+  }
+  m_pageFrames.clear();
+  m_pageCount = 0;
+  return true;
+}
+/**
+ * Writes the page of a frame back to the file, if it was changed
+ * @param size_t frame [IN] - The frame
+ * @return true if the page was written, false otherwise
+ */
+bool CBufferPool::writeFrame(size_t frame)
+{
+  frame_t &entry = m_frames[frame];
+  if (!entry.isValid || !entry.isDirty)
+  {
+    return true;
+  }
+  if (DB_PAGE_SIZE != pwrite(m_fd, getFrameData(frame), DB_PAGE_SIZE,
+                             (off_t)entry.pageId * DB_PAGE_SIZE))
+  {
+    m_isFailed = true;
+    return false;
+  }
+  entry.isDirty = false;
+  return true;
+}
+/**
+ * Gets a frame for a page with the clock algorithm, evicting the page in
+ * it. The first pass of the clock hand clears the used flags of every
+ * unpinned frame, so the second finds a frame unless all are pinned.
+ * @param size_t& frame [OUT] - The frame
+ * @return true if an unpinned frame was found, false otherwise
+ */
+bool CBufferPool::getFreeFrame(size_t &frame)
+{
+  for (size_t step = 0; step < 2 * m_frames.size(); step++)
+  {
+    frame_t &entry = m_frames[m_clockHand];
+    size_t candidate = m_clockHand;
+    m_clockHand = (m_clockHand + 1) % m_frames.size();
+    if (!entry.isValid)
+    {
+      frame = candidate;
+      return true;
+    }
+    if (0 != entry.pinCount)
+    {
+      continue;
+    }
+    if (entry.isUsed)
+    {
+      /* Second chance */
+      entry.isUsed = false;
+      continue;
+    }
+    if (!writeFrame(candidate))
+    {
+      continue;
+    }
+    m_pageFrames.erase(entry.pageId);
+    entry.isValid = false;
+    m_evictions++;
+    frame = candidate;
+    return true;
+  }
+  return false;
+}
+/**
+ * Pins a page into a frame, the page is read if it is not cached
+ * @param uint32_t pageId [IN] - The page
+ * @return char* - The DB_PAGE_SIZE bytes of the page, NULL if the page
+ * does not exist, cannot be read or every frame is pinned
+ */
+char *CBufferPool::fetchPage(uint32_t pageId)
+{
+  if ((m_fd < 0) || (pageId >= m_pageCount))
+  {
+    return NULL;
+  }
+  std::unordered_map<uint32_t, size_t>::iterator itr =
+      m_pageFrames.find(pageId);
+  if (itr != m_pageFrames.end())
+  {
+    frame_t &entry = m_frames[itr->second];
+    entry.pinCount++;
+    entry.isUsed = true;
+    m_hits++;
+    return getFrameData(itr->second);
+  }
+  size_t frame = 0;
+  if (!getFreeFrame(frame))
+  {
+    return NULL;
+  }
+  if (DB_PAGE_SIZE != pread(m_fd, getFrameData(frame), DB_PAGE_SIZE,
+                            (off_t)pageId * DB_PAGE_SIZE))
+  {
+    m_isFailed = true;
+    return NULL;
+  }
+  frame_t &entry = m_frames[frame];
+  entry.pageId = pageId;
+  entry.pinCount = 1;
+  entry.isUsed = true;
+  entry.isDirty = false;
+  entry.isValid = true;
+  m_pageFrames[pageId] = frame;
+  m_misses++;
+  return getFrameData(frame);
+}
+/**
+ * Appends a zeroed page to the file and pins it. The page is written when
+ * it is evicted or flushed.
+ * @param uint32_t& pageId [OUT] - The new page
+ * @return char* - The page, NULL if every frame is pinned
+ */
+char *CBufferPool::newPage(uint32_t &pageId)
+{
+  size_t frame = 0;
+  if ((m_fd < 0) || !getFreeFrame(frame))
+  {
+    return NULL;
+  }
+  pageId = m_pageCount++;
+  memset(getFrameData(frame), 0, DB_PAGE_SIZE);
+  frame_t &entry = m_frames[frame];
+  entry.pageId = pageId;
+  entry.pinCount = 1;
+  entry.isUsed = true;
+  entry.isDirty = true;
+  entry.isValid = true;
+  m_pageFrames[pageId] = frame;
+  return getFrameData(frame);
+}
+/**
+ * Unpins a page fetched with fetchPage() or newPage()
+ * @param uint32_t pageId [IN] - The page
+ * @param bool isDirty [IN] - The page was changed
+ * @return None
+ */
+void CBufferPool::unpinPage(uint32_t pageId, bool isDirty)
+{
+  std::unordered_map<uint32_t, size_t>::iterator itr =
+      m_pageFrames.find(pageId);
+  if (itr == m_pageFrames.end())
+  {
+    return;
+  }
+  frame_t &entry = m_frames[itr->second];
+  if (0 != entry.pinCount)
+  {
+    entry.pinCount--;
+  }
+  entry.isDirty = entry.isDirty || isDirty;
+}
@@ -0,0 +1,213 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CBufferedWriter.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CBufferedWriter
+****************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <nsp/CBufferedWriter.h>
+#include <nsp/TypeMapping.h>
+
+#define FILE_PERMISSIONS \
+  (0644) /**< @brief Represents the permissions of a created file */
+
+CBufferedWriter::CBufferedWriter()
+    : m_fd(-1), m_isFailed(false), m_used(0), m_isBackground(false),
+      m_ioUsed(0), m_isStopping(false)
+{
+}
+
+CBufferedWriter::~CBufferedWriter() { close(); }
+/**
+ * Creates the file, an existing file is truncated unless it is appended
+ * to. A previously opened file is closed.
+ * @param const std::string& fileName [IN] - Name of the file to be written
+ * @param bool isBackground [IN] - Writes the buffers on an I/O thread
+ * @param bool isAppend [IN] - Keeps the contents of an existing file and
+ * writes after them
+ * @return true if the file could be created, false otherwise
+ */
+bool CBufferedWriter::open(const std::string &fileName, bool isBackground,
+                           bool isAppend)
+{
+  close();
+  m_fd = ::open(fileName.c_str(),
+                O_WRONLY | O_CREAT | (isAppend ? O_APPEND : O_TRUNC),
+                FILE_PERMISSIONS);
+  if (m_fd < 0)
+  {
+    return false;
+  }
+  m_isFailed = false;
+  m_buffer.resize(WRITE_BUFFER_SIZE);
+  m_used = 0;
+  m_isBackground = isBackground;
+  if (m_isBackground)
+  {
+    m_ioBuffer.resize(WRITE_BUFFER_SIZE);
+    m_ioUsed = 0;
+    m_isStopping = false;
+    m_ioThread = std::thread(&CBufferedWriter::ioThreadMain, this);
+  }
+  return true;
+}
+/**
+ * Writes the buffered text, flushes the file to the disk and closes it
+ * @param None
+ * @return true if every write and the flush succeeded, false otherwise
+ */
+bool CBufferedWriter::close(void)
+{
+  if (m_fd < 0)
+  {
+    return false;
+  }
+  flushBuffer();
+  if (m_isBackground)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+    m_handover.notify_all();
+    m_ioThread.join();
+    std::vector<char>().swap(m_ioBuffer);
+  }
+  /* The only flush to the disk: all records are durable or none is known */
+  if (0 != fsync(m_fd))
+  {
+    m_isFailed = true;
+  }
+  if (0 != ::close(m_fd))
+  {
+    m_isFailed = true;
+  }
+  m_fd = -1;
+  std::vector<char>().swap(m_buffer);
+  m_used = 0;
+  return !m_isFailed;
+}
+/**
+ * Appends text to the file
+ * @param std::string_view text [IN] - The text to be appended
+ * @return None
+ */
+void CBufferedWriter::append(std::string_view text)
+{
+  const char *pText = text.data();
+  size_t remaining = text.length();
+  while (remaining > 0)
+  {
+    if (m_used == m_buffer.size())
+    {
+      flushBuffer();
+    }
+    size_t size = std::min(remaining, m_buffer.size() - m_used);
+    memcpy(&m_buffer[m_used], pText, size);
+    m_used += size;
+    pText += size;
+    remaining -= size;
+  }
+}
+/**
+ * Appends the shortest text of the number which is read back unchanged
+ * @param double number [IN] - The number to be appended
+ * @return None
+ */
+void CBufferedWriter::appendDouble(double number)
+{
+  if (m_buffer.size() - m_used < MAX_DOUBLE_TEXT_LENGTH)
+  {
+    flushBuffer();
+  }
+  m_used += type_mapping::formatDouble(number, &m_buffer[m_used],
+                                       m_buffer.size() - m_used);
+}
+/**
+ * Writes the filled part of the buffer to the file, or hands it over to
+ * the I/O thread
+ * @param None
+ * @return None
+ */
+void CBufferedWriter::flushBuffer(void)
+{
+  if (0 == m_used)
+  {
+    return;
+  }
+  if (!m_isBackground)
+  {
+    if (!writeAll(m_buffer.data(), m_used))
+    {
+      m_isFailed = true;
+    }
+  }
+  else
+  {
+    /* Wait until the I/O thread has written the previous buffer, then
+     * exchange the buffers */
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_handover.wait(lock, [this] { return (0 == m_ioUsed); });
+    m_buffer.swap(m_ioBuffer);
+    m_ioUsed = m_used;
+    lock.unlock();
+    m_handover.notify_all();
+  }
+  m_used = 0;
+}
+/**
+ * Writes the bytes to the file, continuing after partial writes
+ * @param const char* pData [IN] - The bytes to be written
+ * @param size_t size [IN] - Number of bytes
+ * @return true if every byte is written, false otherwise
+ */
+bool CBufferedWriter::writeAll(const char *pData, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t written = ::write(m_fd, pData, size);
+    if (written < 0)
+    {
+      if (EINTR == errno)
+        continue;
+      return false;
+    }
+    pData += written;
+    size -= written;
+  }
+  return true;
+}
+/**
+ * Writes the handed over buffers until the writer is closed
+ * @param None
+ * @return None
+ */
+void CBufferedWriter::ioThreadMain(void)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_handover.wait(lock, [this] { return (0 != m_ioUsed) || m_isStopping; });
+    if (0 == m_ioUsed)
+    {
+      break; /* Stopping and nothing left to write */
+    }
+    /* The caller does not touch the I/O buffer until m_ioUsed is 0 */
+    lock.unlock();
+    bool isWritten = writeAll(m_ioBuffer.data(), m_ioUsed);
+    lock.lock();
+    if (!isWritten)
+    {
+      m_isFailed = true;
+    }
+    m_ioUsed = 0;
+    m_handover.notify_all();
+  }
+}
@@ -5,10 +5,16 @@
 * Author          : Jishnu M Thampan
 * Description     : class CCSV
 ****************************************************************************/
-#include <fstream>
-#include <iostream>
+#include <string.h>
 
+#include <algorithm>
+#include <thread>
+
+#include <nsp/CAttributeExtractor.h>
+#include <nsp/CBufferedWriter.h>
 #include <nsp/CCSV.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CThreadPool.h>
 #include <nsp/TypeMapping.h>
 
 #define EMPTY_STRING ""
@@ -16,6 +22,7 @@
 #define COMA_STRING ","       /**< @brief Represents Coma String */
 #define SEMI_COLON_STRING ";" /**< @brief Represents Semi Colon String */
 #define NEW_LINE_STRING "\n"  /**< @brief Represents New Line String */
+#define NEW_LINE_CHAR '\n'    /**< @brief Represents New Line Character */
 #define SEMI_COLON_CHAR ';'   /**< @brief Represents Semi Colon Character */
 #define COMA_CHAR ','         /**< @brief Represents Coma Character */
 #define DELIMITER SEMI_COLON_STRING
@@ -26,14 +33,124 @@
 #define POI_FILE_EXTENSION \
   "-poi.txt" /**< @brief Represents the extension for POI File */
 
-CCSV::CCSV()
+#define MIN_CHUNK_SIZE \
+  (1 << 20) /**< @brief Represents the smallest chunk parsed by a thread */
+#define CHUNKS_PER_THREAD \
+  (4) /**< @brief Represents the chunks per thread, for load balancing */
+
+/**
+ * Represents an invalid line. The error message is only formatted when the
+ * error is reported, see reportError().
+ */
+typedef struct {
+  unsigned int line;   /**< \brief Represents the line of the error */
+  bool isExtractError; /**< \brief Represents an error of the attribute
+                          extraction, a conversion error otherwise */
+  int errorCode;       /**< \brief Represents the CAttributeExtractor::RC_t
+                          or type_mapping::errorCode_t */
+} csvError_t;
+
+/**
+ * Holds the records and errors of one chunk of a CSV file in file order.
+ * The line numbers count from the start of the chunk until the chunk is
+ * merged into the Databases.
+ */
+typedef struct {
+  unsigned int lineCount; /**< \brief Represents the lines of the chunk */
+  std::vector<CWaypoint> waypoints; /**< \brief Represents the valid
+                                       Waypoints */
+  std::vector<CPOI> pois; /**< \brief Represents the valid POIs */
+  std::vector<unsigned int>
+      recordLines; /**< \brief Represents the line of every record */
+  std::vector<csvError_t> errors; /**< \brief Represents the errors */
+} csvChunk_t;
+
+/**
+ * Keeps the records and errors of a chunk which is parsed in parallel to
+ * the others
+ */
+class CChunkCollector {
+private:
+  csvChunk_t &m_chunk; /**< \brief Represents the parsed chunk */
+
+public:
+  CChunkCollector(csvChunk_t &chunk) : m_chunk(chunk) {}
+  void addWaypoint(const CWaypoint &wp, unsigned int line)
+  {
+    m_chunk.waypoints.push_back(wp);
+    m_chunk.recordLines.push_back(line);
+  }
+  void addPoi(const CPOI &poi, unsigned int line)
+  {
+    m_chunk.pois.push_back(poi);
+    m_chunk.recordLines.push_back(line);
+  }
+  void addError(const csvError_t &error) { m_chunk.errors.push_back(error); }
+};
+
+/**
+ * Stores the records of a single chunk in the Databases and reports its
+ * errors at once, so nothing is kept for a sequential parse
+ */
+class CDatabaseInserter {
+private:
+  CCSV::fileType_t m_fileType; /**< \brief Represents the file type */
+  CPoiDatabase &m_poiDb;       /**< \brief Represents the POI Database */
+  CWpDatabase &m_wpDb; /**< \brief Represents the Waypoint Database */
+
+public:
+  CDatabaseInserter(CCSV::fileType_t fileType, CPoiDatabase &poiDb,
+                    CWpDatabase &wpDb)
+      : m_fileType(fileType), m_poiDb(poiDb), m_wpDb(wpDb)
+  {
+  }
+  void addWaypoint(const CWaypoint &wp, unsigned int)
+  {
+    m_wpDb.addWaypoint(wp);
+  }
+  void addPoi(const CPOI &poi, unsigned int) { m_poiDb.addPoi(poi); }
+  void addError(const csvError_t &error);
+};
+
+/**
+ * Parses and validates the lines of one chunk
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param std::string_view contents [IN] - Whole lines of the file
+ * @param Handler& handler [OUT] - Gets the records and errors in file order
+ * @return unsigned int - The lines of the chunk
+ */
+template <class Handler>
+static unsigned int parseChunk(CCSV::fileType_t fileType,
+                               std::string_view contents, Handler &handler);
+/**
+ * Stores the records and reports the errors of a chunk in file order
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param const csvChunk_t& chunk [IN] - The parsed chunk
+ * @param unsigned int firstLine [IN] - Line number of the first chunk line
+ * @param CPoiDatabase& poiDb [OUT] - The POI Database
+ * @param CWpDatabase& wpDb [OUT] - The Waypoint Database
+ * @return None
+ */
+static void mergeChunk(CCSV::fileType_t fileType, const csvChunk_t &chunk,
+                       unsigned int firstLine, CPoiDatabase &poiDb,
+                       CWpDatabase &wpDb);
+/**
+ * Reports an invalid line. The message is only formatted if the
+ * diagnostics write it.
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param const csvError_t& error [IN] - The error
+ * @param unsigned int firstLine [IN] - Line number of the first chunk line
+ * @return None
+ */
+static void reportError(CCSV::fileType_t fileType, const csvError_t &error,
+                        unsigned int firstLine);
+
+void CDatabaseInserter::addError(const csvError_t &error)
 {
-  /* Initialize the delimiters of the CSV file */
-  std::vector<char> delimiters;
-  delimiters.push_back(SEMI_COLON_CHAR);
-  delimiters.push_back(COMA_CHAR);
-  m_attributeExtractor.setDelimiters(delimiters);
+  reportError(m_fileType, error, 1);
 }
+
+CCSV::CCSV() { m_threadCount = 0; }
 /**
  * Set the name of the media to be used for persistent storage.
  * The exact interpretation of the name depends on the implementation
@@ -48,6 +165,27 @@ void CCSV::setMediaName(std::string name)
   m_wpFileName = FILE_LOCATION + m_mediaName + WP_FILE_EXTENSION;
   m_poiFileName = FILE_LOCATION + m_mediaName + POI_FILE_EXTENSION;
 }
+/**
+ * Get the files of the media which writeData() replaces
+ *
+ * @param fileNames the names of the files (with path)
+ */
+void CCSV::getMediaFiles(std::vector<std::string> &fileNames) const
+{
+  fileNames.clear();
+  fileNames.push_back(m_wpFileName);
+  fileNames.push_back(m_poiFileName);
+}
+/**
+ * Sets the number of threads which parse a file
+ * @param unsigned int threadCount [IN] - Number of threads, 0 uses one
+ * thread per core, 1 parses on the calling thread
+ * @return None
+ */
+void CCSV::setThreadCount(unsigned int threadCount)
+{
+  m_threadCount = threadCount;
+}
 /**
  * Fill the databases with the data from persistent storage. If
  * merge mode is MERGE, the content in the persistent storage
@@ -64,38 +202,41 @@ void CCSV::setMediaName(std::string name)
 bool CCSV::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
                     MergeMode mode)
 {
+  CDiagnosticScope load("CCSV::readData()");
   bool retVal = true;
   switch (mode)
   {
   case MERGE:
   {
-    CCSV::StringVector wpFileContents, poiFileContents;
+    CMappedFile wpFile, poiFile;
 
-    if (!(
-            readCSVFile(m_poiFileName, poiFileContents) && /* Read and parse
-                                                              from POI File is
-                                                              Not Successful */
-            parseCSVFileContents(POI_FILE, poiFileContents, poiDb, waypointDb)))
+    if (!(readCSVFile(m_poiFileName, poiFile) && /* Read and parse from POI
+                                                    File is Not Successful */
+          parseCSVFileContents(
+              POI_FILE, std::string_view(poiFile.getData(), poiFile.getSize()),
+              poiDb, waypointDb)))
       retVal = false;
 
-    if (!(readCSVFile(m_wpFileName, wpFileContents) && /* Read and parse from
-                                                          Waypoint File is Not
-                                                          Successful */
-          parseCSVFileContents(WP_FILE, wpFileContents, poiDb, waypointDb)))
+    if (!(readCSVFile(m_wpFileName, wpFile) && /* Read and parse from
+                                                  Waypoint File is Not
+                                                  Successful */
+          parseCSVFileContents(
+              WP_FILE, std::string_view(wpFile.getData(), wpFile.getSize()),
+              poiDb, waypointDb)))
       retVal = false;
 
     break;
   }
   case REPLACE:
   {
-    CCSV::StringVector wpFileContents, poiFileContents;
+    CMappedFile wpFile, poiFile;
     if (readCSVFile(m_poiFileName,
-                    poiFileContents)) /* Read from POI File is Successful */
+                    poiFile)) /* Read from POI File is Successful */
     {
       poiDb.clearPoiDatabase(); /* Clear POI Database */
       if (!parseCSVFileContents(
-              POI_FILE, poiFileContents, poiDb,
-              waypointDb))
+              POI_FILE, std::string_view(poiFile.getData(), poiFile.getSize()),
+              poiDb, waypointDb))
       { /* Parse the POI file is unsuccessful */
         retVal = false;
       }
@@ -104,12 +245,12 @@ bool CCSV::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
       retVal = false;
 
     if (readCSVFile(m_wpFileName,
-                    wpFileContents)) /* Read from Waypoint File is Successful */
+                    wpFile)) /* Read from Waypoint File is Successful */
     {
       waypointDb.clearWpDatabase(); /* Clear Waypoint Database */
       if (!parseCSVFileContents(
-              WP_FILE, wpFileContents, poiDb,
-              waypointDb))
+              WP_FILE, std::string_view(wpFile.getData(), wpFile.getSize()),
+              poiDb, waypointDb))
       { /* Parse the Waypoint file is unsuccessful */
         retVal = false;
       }
@@ -122,8 +263,8 @@ bool CCSV::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
   default:
   {
     retVal = false;
-    std::cout << "ERROR! CCSV::readData() failed! Invalid Merge Mode!"
-              << std::endl;
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR! CCSV::readData() failed! Invalid Merge Mode!");
   }
   }
   return retVal;
@@ -136,30 +277,28 @@ bool CCSV::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
  */
 bool CCSV::writeToCSVWaypointFile(const CWpDatabase &waypointDb)
 {
-  std::fstream wpFile(m_wpFileName.c_str(), std::ios::out);
-  bool retVal = true;
-  if (wpFile.is_open())
+  CBufferedWriter wpFile;
+  if (!wpFile.open(m_wpFileName, isBackgroundWrite()))
   {
-    /* Get the Pointer to the Database Container */
-    CWpDatabase::WaypointDatabaseMap_t db;
-    waypointDb.getWpDatabase(db);
-
-    /* Iterate through the container and write the contents to the file */
-    for (CWpDatabase::WaypointDatabaseMap_t::const_iterator itr = db.begin();
-         itr != db.end(); ++itr)
-    {
-      wpFile << (itr->first) << DELIMITER << (itr->second).getLatitude()
-             << DELIMITER << (itr->second).getLongitude() << std::endl;
-    }
-    wpFile.close();
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CCSV::writeData() failed: Unable to open " +
+                             m_wpFileName);
+    return false;
   }
-  else
+  /* Iterate through the Database and write the contents to the file */
+  for (CWpDatabase::const_iterator itr = waypointDb.begin();
+       itr != waypointDb.end(); ++itr)
   {
-    retVal = false;
-    std::cout << "ERROR!CCSV::writeData() failed: Unable to open " << m_wpFileName
-              << std::endl;
+    appendWaypointRecord(wpFile, itr->second);
   }
-  return retVal;
+  if (!wpFile.close())
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CCSV::writeData() failed: Unable to write " +
+                             m_wpFileName);
+    return false;
+  }
+  return true;
 }
 /**
  * Writes the POI Database contents into the CSV POI File
@@ -168,43 +307,73 @@ bool CCSV::writeToCSVWaypointFile(const CWpDatabase &waypointDb)
  */
 bool CCSV::writeToCSVPoiFile(const CPoiDatabase &poiDb)
 {
-  bool retVal = true;
-
-  std::fstream poiFile(m_poiFileName.c_str(), std::ios::out);
-  if (poiFile.is_open())
+  CBufferedWriter poiFile;
+  if (!poiFile.open(m_poiFileName, isBackgroundWrite()))
   {
-    /* Get the Pointer to the Database Container */
-    CPoiDatabase::POIDatabaseMap_t db;
-    poiDb.getPoiDatabase(db);
-    /* Iterate through the container and write the contents to the file */
-    for (CPoiDatabase::POIDatabaseMap_t::const_iterator itr = db.begin();
-         itr != db.end(); ++itr)
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CCSV::writeData() failed: Unable to open " +
+                             m_poiFileName);
+    return false;
+  }
+  /* Iterate through the Database and write the contents to the file */
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    if (!appendPoiRecord(poiFile, itr->second))
     {
-      std::string poiType;
-      /* Convert the POI Type to String to be stored in the POI file */
-      if (type_mapping::convertPoiTypeToString((itr->second).getType(),
-                                               poiType))
-      {
-        poiFile << poiType << DELIMITER << (itr->first) << DELIMITER
-                << (itr->second.getDescription()) << DELIMITER
-                << (itr->second).getLatitude() << DELIMITER
-                << (itr->second).getLongitude() << std::endl;
-      }
-      else
-      {
-        std::cout << "ERROR!CCSV::writeData() failed! Invalid POI Type!"
-                  << std::endl;
-      }
+      CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                           "ERROR!CCSV::writeData() failed! Invalid POI Type!");
     }
-    poiFile.close();
   }
-  else
+  if (!poiFile.close())
   {
-    retVal = false;
-    std::cout << "ERROR!CCSV::writeData() failed: Unable to open " << m_poiFileName
-              << std::endl;
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CCSV::writeData() failed: Unable to write " +
+                             m_poiFileName);
+    return false;
   }
-  return retVal;
+  return true;
+}
+/**
+ * Appends the Waypoint as a line of the CSV Waypoint file
+ * @param CBufferedWriter& file [OUT] - The file written to
+ * @param const CWaypoint& wp [IN] - The Waypoint
+ * @return None
+ */
+void CCSV::appendWaypointRecord(CBufferedWriter &file, const CWaypoint &wp)
+{
+  file.append(wp.getName());
+  file.append(SEMI_COLON_CHAR);
+  file.appendDouble(wp.getLatitude());
+  file.append(SEMI_COLON_CHAR);
+  file.appendDouble(wp.getLongitude());
+  file.append(NEW_LINE_CHAR);
+}
+/**
+ * Appends the POI as a line of the CSV POI file
+ * @param CBufferedWriter& file [OUT] - The file written to
+ * @param const CPOI& poi [IN] - The POI
+ * @return true if the POI is appended, false if its type is invalid
+ */
+bool CCSV::appendPoiRecord(CBufferedWriter &file, const CPOI &poi)
+{
+  std::string poiType;
+  /* Convert the POI Type to String to be stored in the POI file */
+  if (!type_mapping::convertPoiTypeToString(poi.getType(), poiType))
+  {
+    return false;
+  }
+  file.append(poiType);
+  file.append(SEMI_COLON_CHAR);
+  file.append(poi.getName());
+  file.append(SEMI_COLON_CHAR);
+  file.append(poi.getDescription());
+  file.append(SEMI_COLON_CHAR);
+  file.appendDouble(poi.getLatitude());
+  file.append(SEMI_COLON_CHAR);
+  file.appendDouble(poi.getLongitude());
+  file.append(NEW_LINE_CHAR);
+  return true;
 }
 /**
  * Write the data to the persistent storage.
@@ -229,65 +398,35 @@ bool CCSV::writeData(const CWpDatabase &waypointDb, const CPoiDatabase &poiDb)
   return retVal;
 }
 /**
- * Reads the CSV file and copies the contents to the string vector
+ * Maps the CSV file into memory, the contents are not copied
  * @param std::string& fileName 		  - Name of the file to be read
  * [IN]
- * @param StringVector& fileContents 	  - The contents of the file	[OUT]
+ * @param CMappedFile& file 	  - The mapping of the file	[OUT]
  * @return true if read is successful, false otherwise
  */
-bool CCSV::readCSVFile(const std::string &fileName,
-                       StringVector &fileContents)
+bool CCSV::readCSVFile(const std::string &fileName, CMappedFile &file)
 {
   bool retVal = true;
-  std::fstream poiFile(fileName.c_str(), std::ios::in);
-  if (poiFile.is_open())
+  if (file.open(fileName))
   {
-    std::string line;
-    /* Fetch the contents line by line and store it into fileContents*/
-    while (getline(poiFile, line))
-    {
-      fileContents.push_back(line);
-      /* No further processing of the text is done here in order to release the
-       * resource quickly */
-    }
-    poiFile.close();
+    /* The file is parsed front to back exactly once */
+    file.adviseSequential();
   }
   else
   {
     retVal = false;
-    std::cout << "ERROR!CCSV::readCSVFile() failed! Unable to open " << fileName
-              << std::endl;
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CCSV::readCSVFile() failed! Unable to open " +
+                             fileName);
   }
   return retVal;
 }
-/**
- * Initializes the Max attributes for the attribute extractor depending upon the
- * file type
- * @param const fileType_t& fileType [IN] - The file type - Waypoint file or POI
- * file
- * @return true if initialization is successful, false otherwise
- */
-bool CCSV::initMaxAttributes(const fileType_t &fileType)
-{
-  bool retVal = true;
-
-  if (WP_FILE == fileType)
-    m_attributeExtractor.setMaxAttributes(MAX_WAYPOINT_ATTRIBUTES);
-
-  else if (POI_FILE == fileType)
-    m_attributeExtractor.setMaxAttributes(MAX_POI_ATTRIBUTES);
-
-  else
-    retVal = false;
-
-  return retVal;
-}
 /**
  * Parses the CSV file contents, Validates and Stores the contents to the
  * Databases
  * @param const fileType_t fileType [IN]		     - The File type- POI or
  * Waypoint
- * @param const CCSV::StringVector& fileContents [IN]- The contents of the file
+ * @param std::string_view fileContents [IN]- The contents of the file
  * @param CPoiDatabase& poiDb [OUT]- The POI Database obj where the extracted
  * contents are written into
  * @param CWpDatabase &wpDb   [OUT]- The Waypoint Database obj where the
@@ -296,109 +435,219 @@ bool CCSV::initMaxAttributes(const fileType_t &fileType)
  * the caller.
  */
 bool CCSV::parseCSVFileContents(const fileType_t &fileType,
-                                const CCSV::StringVector &fileContents,
+                                std::string_view fileContents,
                                 CPoiDatabase &poiDb, CWpDatabase &wpDb)
 {
-  /* Initialize the Attribute Extractor (Utility class) with the file specific
-   * delimiters and attribute no */
-  if (!initMaxAttributes(fileType))
+  if ((WP_FILE != fileType) && (POI_FILE != fileType))
   {
-    std::cout << "ERROR!  CCSV::parseCSVFileContents()!Invalid file provided"
-              << std::endl;
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!  CCSV::parseCSVFileContents()!Invalid file provided");
     return false;
   }
+  unsigned int threadCount = m_threadCount;
+  if (0 == threadCount)
+  {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  size_t chunkCount = 1;
+  if (threadCount > 1)
+  {
+    chunkCount = std::min((size_t)threadCount * CHUNKS_PER_THREAD,
+                          fileContents.size() / MIN_CHUNK_SIZE);
+    chunkCount = std::max(chunkCount, (size_t)1);
+  }
+  /* Cut the contents into chunks of whole lines */
+  std::vector<std::string_view> chunkContents;
+  size_t chunkStart = 0;
+  for (size_t i = 1; i <= chunkCount; i++)
+  {
+    size_t chunkEnd = fileContents.size();
+    if (i < chunkCount)
+    {
+      size_t lineBreak = fileContents.find(
+          NEW_LINE_CHAR,
+          std::max(chunkStart, fileContents.size() / chunkCount * i));
+      chunkEnd = (std::string_view::npos == lineBreak) ? fileContents.size()
+                                                       : lineBreak + 1;
+    }
+    chunkContents.push_back(
+        fileContents.substr(chunkStart, chunkEnd - chunkStart));
+    chunkStart = chunkEnd;
+  }
+
+  if (1 == chunkContents.size())
+  {
+    /* A single chunk goes straight into the Databases */
+    CDatabaseInserter inserter(fileType, poiDb, wpDb);
+    parseChunk(fileType, chunkContents[0], inserter);
+    return true;
+  }
+  std::vector<csvChunk_t> chunks(chunkContents.size());
+  CThreadPool pool(threadCount);
+  pool.parallelFor(chunks.size(), 1,
+                   [&](size_t begin, size_t end, unsigned int) {
+                     for (size_t i = begin; i < end; i++)
+                     {
+                       CChunkCollector collector(chunks[i]);
+                       chunks[i].lineCount =
+                           parseChunk(fileType, chunkContents[i], collector);
+                     }
+                   });
+  /* The line numbers of a chunk start after the lines of all previous
+   * chunks. Merging in file order keeps the first of duplicate entries, as
+   * a sequential parse does */
+  unsigned int firstLine = 1;
+  for (size_t i = 0; i < chunks.size(); i++)
+  {
+    mergeChunk(fileType, chunks[i], firstLine, poiDb, wpDb);
+    firstLine += chunks[i].lineCount;
+    chunks[i] = csvChunk_t(); /* Release the merged records */
+  }
+  return true;
+}
+/**
+ * Parses and validates the lines of one chunk
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param std::string_view contents [IN] - Whole lines of the file
+ * @param Handler& handler [OUT] - Gets the records and errors in file order
+ * @return unsigned int - The lines of the chunk
+ */
+template <class Handler>
+static unsigned int parseChunk(CCSV::fileType_t fileType,
+                               std::string_view contents, Handler &handler)
+{
+  /* Initialize the Attribute Extractor (Utility class) with the file specific
+   * delimiters and attribute no. Every chunk has its own extractor. */
+  CAttributeExtractor attributeExtractor;
+  std::vector<char> delimiters;
+  delimiters.push_back(SEMI_COLON_CHAR);
+  delimiters.push_back(COMA_CHAR);
+  attributeExtractor.setDelimiters(delimiters);
+  attributeExtractor.setMaxAttributes((CCSV::WP_FILE == fileType)
+                                          ? MAX_WAYPOINT_ATTRIBUTES
+                                          : MAX_POI_ATTRIBUTES);
+
   unsigned int lineNumber = 1;
-  /* Iterate through the file contents */
-  for (CCSV::StringVector::const_iterator itr = fileContents.begin();
-       itr != fileContents.end(); ++itr, ++lineNumber)
+  const char *pLine = contents.data();
+  const char *pContentsEnd = pLine + contents.size();
+  CCSV::FieldVector attributeVec; /* Reused for every line */
+  /* Iterate through the contents line by line */
+  for (; pLine < pContentsEnd; ++lineNumber)
   {
-    std::string line = *itr;
+    const char *pLineEnd = static_cast<const char *>(
+        memchr(pLine, NEW_LINE_CHAR, pContentsEnd - pLine));
+    if (NULL == pLineEnd)
+      pLineEnd = pContentsEnd; /* Last line without a line break */
+    std::string_view line(pLine, pLineEnd - pLine);
+    pLine = pLineEnd + 1;
     if ((SPACE_STRING == line) || (NEW_LINE_STRING == line) ||
         (EMPTY_STRING == line))
       continue; // process text delimit
 
-    CCSV::StringVector attributeVec;
-    /* Extract the attributes and store it in attributeVec */
+    /* Extract the attributes and store their views in attributeVec */
     CAttributeExtractor::RC_t errorType =
-        m_attributeExtractor.extractAttributes(line, attributeVec);
-
+        attributeExtractor.extractAttributes(line, attributeVec);
     if (CAttributeExtractor::RC_SUCCESS !=
-        errorType) /* Display Err if extraction fails */
+        errorType) /* Keep the Err if extraction fails */
     {
-      std::cout << "ERROR!CCSV::parseCSVFile() failed!ErrorType:"
-                << m_attributeExtractor.getErrorType(errorType)
-                << " line_no: " << lineNumber << std::endl;
+      csvError_t error = {lineNumber, true, errorType};
+      handler.addError(error);
       continue;
     }
-    /* Validate and Store the extracted data */
-    bool isValid =
-        ((WP_FILE == fileType) ? validateAndStoreWaypoint(attributeVec, wpDb)
-                               : validateAndStorePoi(attributeVec, poiDb));
-    /* If not valid print the line number and continue */
-    if (!isValid)
+    /* Validate and pass on the extracted data */
+    type_mapping::errorCode_t ec = type_mapping::RC_SUCCESS;
+    if (CCSV::WP_FILE == fileType)
+    {
+      CWaypoint wp; /* Waypoint to be added in the database */
+      ec = type_mapping::convertStringToCWaypointType(attributeVec, wp);
+      if (type_mapping::RC_SUCCESS == ec)
+        handler.addWaypoint(wp, lineNumber);
+    }
+    else
     {
-      std::cout << " line_no: " << lineNumber << std::endl;
+      CPOI newPoi; /* POI object to be added to the database */
+      ec = type_mapping::convertStringToCPoiType(attributeVec, newPoi);
+      if (type_mapping::RC_SUCCESS == ec)
+        handler.addPoi(newPoi, lineNumber);
+    }
+    if (type_mapping::RC_SUCCESS != ec)
+    {
+      csvError_t error = {lineNumber, false, ec};
+      handler.addError(error);
     }
   }
-  return true;
+  return lineNumber - 1;
 }
 /**
- * Validates and if valid stores the POI in the POI Database
- * @param const StringVector& attributeVec [IN] - The string vector consisting
- * of the extracted attributes
- * @param CPoiDatabase& poiDb [OUT]	- POI Database where the validated
- * content is to be stored
- * @return true if validation is successful, false otherwise
+ * Stores the records and reports the errors of a chunk in file order
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param const csvChunk_t& chunk [IN] - The parsed chunk
+ * @param unsigned int firstLine [IN] - Line number of the first chunk line
+ * @param CPoiDatabase& poiDb [OUT] - The POI Database
+ * @param CWpDatabase& wpDb [OUT] - The Waypoint Database
+ * @return None
  */
-bool CCSV::validateAndStorePoi(const StringVector &attributeVec,
-                               CPoiDatabase &poiDb)
+static void mergeChunk(CCSV::fileType_t fileType, const csvChunk_t &chunk,
+                       unsigned int firstLine, CPoiDatabase &poiDb,
+                       CWpDatabase &wpDb)
 {
-  bool retVal = true;
-  CPOI newPoi; /* POI object to be added to the database */
-
-  /* Perform Validation of the extracted attributes */
-  type_mapping::errorCode_t ec =
-      type_mapping::convertStringToCPoiType(attributeVec, newPoi);
-  if (type_mapping::RC_SUCCESS == ec)
+  size_t record = 0, error = 0;
+  while ((record < chunk.recordLines.size()) || (error < chunk.errors.size()))
   {
-    /* After successful validation store the attributes to the database */
-    poiDb.addPoi(newPoi);
-  }
-  else
-  {
-    retVal = false;
-    std::cout << "ERROR!CCSV::parseCSVPoiFile() failed! ErrorType:"
-              << type_mapping::getErrorType(ec);
+    if ((error < chunk.errors.size()) &&
+        ((record == chunk.recordLines.size()) ||
+         (chunk.errors[error].line < chunk.recordLines[record])))
+    {
+      reportError(fileType, chunk.errors[error], firstLine);
+      error++;
+    }
+    else
+    {
+      /* After successful validation store the attributes to the database */
+      if (CCSV::WP_FILE == fileType)
+        wpDb.addWaypoint(chunk.waypoints[record]);
+      else
+        poiDb.addPoi(chunk.pois[record]);
+      record++;
+    }
   }
-  return retVal;
 }
 /**
- * Validates and if valid stores the Waypoint in the Waypoint Database
- * @param const StringVector& attributeVec [IN] - The string vector consisting
- * of the extracted attributes
- * @param CPoiDatabase& poiDb [OUT]	- Waypoint Database where the validated
- * content is to be stored
- * @return true if validation is successful, false otherwise
+ * Reports an invalid line. The message is only formatted if the
+ * diagnostics write it.
+ * @param CCSV::fileType_t fileType [IN] - The File type- POI or Waypoint
+ * @param const csvError_t& error [IN] - The error
+ * @param unsigned int firstLine [IN] - Line number of the first chunk line
+ * @return None
  */
-bool CCSV::validateAndStoreWaypoint(const StringVector &attributeVec,
-                                    CWpDatabase &wpDb)
+static void reportError(CCSV::fileType_t fileType, const csvError_t &error,
+                        unsigned int firstLine)
 {
-  bool retVal = true;
-  CWaypoint wp; /* Waypoint to be added in the database */
-
-  /* Perform Validation of the extracted attributes */
-  type_mapping::errorCode_t ec =
-      type_mapping::convertStringToCWaypointType(attributeVec, wp);
-  if (type_mapping::RC_SUCCESS == ec)
+  if (!CDiagnostics::count(CDiagnostics::INVALID_RECORD))
+    return;
+  std::string message;
+  if (error.isExtractError)
   {
-    /* After successful validation store the attributes to the database */
-    wpDb.addWaypoint(wp);
+    CAttributeExtractor attributeExtractor;
+    message = "ERROR!CCSV::parseCSVFile() failed!ErrorType:" +
+              attributeExtractor.getErrorType(
+                  (CAttributeExtractor::RC_t)error.errorCode);
+  }
+  else if (CCSV::WP_FILE == fileType)
+  {
+    message = "ERROR!CCSV::parseCSVWaypointFile() failed!ErrorType:" +
+              type_mapping::getErrorType(
+                  (type_mapping::errorCode_t)error.errorCode);
   }
   else
   {
-    retVal = false;
-    std::cout << "ERROR!CCSV::parseCSVWaypointFile() failed!ErrorType:"
-              << type_mapping::getErrorType(ec);
+    message = "ERROR!CCSV::parseCSVPoiFile() failed! ErrorType:" +
+              type_mapping::getErrorType(
+                  (type_mapping::errorCode_t)error.errorCode);
   }
-  return retVal;
+  /* Report the line number of the invalid line */
+  CDiagnostics::write(CDiagnostics::INVALID_RECORD,
+                      message + " line_no: " +
+                          std::to_string(firstLine + error.line - 1));
 }
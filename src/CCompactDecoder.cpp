@@ -0,0 +1,253 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactDecoder.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CCompactDecoder
+****************************************************************************/
+#include <nsp/CBinarySnapshot.h>
+#include <nsp/CCompactDecoder.h>
+
+using namespace compact_coding;
+
+/**
+ * Reads a string of a record, its varint length and its bytes
+ * @param const char*& pData [IN/OUT] - The string, after it on success
+ * @param const char* pEnd [IN] - The end of the block
+ * @param std::string_view& text [OUT] - The string
+ * @return true if the string lies within the block, false otherwise
+ */
+static bool readString(const char *&pData, const char *pEnd,
+                       std::string_view &text)
+{
+  uint64_t length = 0;
+  if (!readVarint(pData, pEnd, length) ||
+      (length > static_cast<uint64_t>(pEnd - pData)))
+  {
+    return false;
+  }
+  text = std::string_view(pData, length);
+  pData += length;
+  return true;
+}
+
+/**
+ * Checks the CRC-32 of a block, which covers its header and its body
+ * @param const char* pBody [IN] - The body, after the header
+ * @param size_t size [IN] - The size of the body
+ * @return true if the block is intact, false otherwise
+ */
+static bool isIntactBlock(const char *pBody, size_t size)
+{
+  const char *pHeader = pBody - COMPACT_BLOCK_HEADER_SIZE;
+  uint32_t checksum = CBinarySnapshot::updateChecksum(
+      0, pHeader, COMPACT_BLOCK_HEADER_SIZE - 4);
+  return (readFixed(pBody - 4, 4) ==
+          CBinarySnapshot::updateChecksum(checksum, pBody, size));
+}
+
+CCompactDecoder::CCompactDecoder()
+    : m_pIndex(NULL), m_blockCount(0), m_indexOffset(0), m_tileLevel(0)
+{
+  m_records[WAYPOINT_TABLE] = m_records[POI_TABLE] = 0;
+}
+/**
+ * Maps the file and checks its header, its trailer and its index
+ * @param const std::string& fileName [IN] - Name of the file
+ * @return true if the file is complete, false otherwise
+ */
+bool CCompactDecoder::open(const std::string &fileName)
+{
+  close();
+  if (!m_file.open(fileName))
+  {
+    return false;
+  }
+  const char *pData = m_file.getData();
+  uint64_t size = m_file.getSize();
+  if ((size < COMPACT_HEADER_SIZE + COMPACT_TRAILER_SIZE) ||
+      (COMPACT_MAGIC != readFixed(pData, 4)) ||
+      (COMPACT_VERSION != readFixed(pData + 4, 4)))
+  {
+    close();
+    return false;
+  }
+  const char *pTrailer = pData + size - COMPACT_TRAILER_SIZE;
+  uint64_t blockCount = readFixed(pTrailer + 8, 8);
+  uint64_t indexOffset = readFixed(pTrailer + 16, 8);
+  /* The index lies between the blocks and the trailer */
+  bool isValid = (COMPACT_MAGIC == readFixed(pTrailer, 4)) &&
+                 (COMPACT_VERSION == readFixed(pTrailer + 4, 4)) &&
+                 (indexOffset >= COMPACT_HEADER_SIZE) &&
+                 (indexOffset <= size) &&
+                 (blockCount <= (size - COMPACT_TRAILER_SIZE) / 8) &&
+                 (indexOffset + blockCount * 8 == size - COMPACT_TRAILER_SIZE);
+  if (isValid)
+  {
+    size_t checkedSize = blockCount * 8 + COMPACT_TRAILER_SIZE - 4;
+    isValid = (readFixed(pTrailer + COMPACT_TRAILER_SIZE - 4, 4) ==
+               CBinarySnapshot::updateChecksum(0, pData + indexOffset,
+                                               checkedSize)) &&
+              (readFixed(pTrailer + 40, 4) <= MAX_TILE_LEVEL);
+  }
+  if (!isValid)
+  {
+    close();
+    return false;
+  }
+  m_pIndex = pData + indexOffset;
+  m_blockCount = blockCount;
+  m_indexOffset = indexOffset;
+  m_records[WAYPOINT_TABLE] = readFixed(pTrailer + 24, 8);
+  m_records[POI_TABLE] = readFixed(pTrailer + 32, 8);
+  m_tileLevel = readFixed(pTrailer + 40, 4);
+  return true;
+}
+/**
+ * Releases the mapping
+ * @param None
+ * @return None
+ */
+void CCompactDecoder::close(void)
+{
+  m_pIndex = NULL;
+  m_blockCount = 0;
+  m_indexOffset = 0;
+  m_records[WAYPOINT_TABLE] = m_records[POI_TABLE] = 0;
+  m_tileLevel = 0;
+  m_file.close();
+}
+/**
+ * Gets a block header and body
+ * @param size_t block [IN] - Index of the block
+ * @param const char*& pBody [OUT] - The body
+ * @param size_t& size [OUT] - The size of the body
+ * @return true if the block lies within the blocks, false otherwise
+ */
+bool CCompactDecoder::getBlock(size_t block, const char *&pBody,
+                               size_t &size) const
+{
+  if (block >= m_blockCount)
+  {
+    return false;
+  }
+  uint64_t offset = readFixed(m_pIndex + block * 8, 8);
+  if ((offset < COMPACT_HEADER_SIZE) || (offset > m_indexOffset) ||
+      (m_indexOffset - offset < COMPACT_BLOCK_HEADER_SIZE))
+  {
+    return false;
+  }
+  const char *pHeader = m_file.getData() + offset;
+  size = readFixed(pHeader, 4);
+  pBody = pHeader + COMPACT_BLOCK_HEADER_SIZE;
+  return (size <= m_indexOffset - offset - COMPACT_BLOCK_HEADER_SIZE) &&
+         (readFixed(pHeader + 8, 4) < TABLE_COUNT);
+}
+/**
+ * Reads the header of a block, without decoding it
+ * @param size_t block [IN] - Index of the block
+ * @param blockInfo_t& info [OUT] - The header
+ * @return true if the block is valid, false otherwise
+ */
+bool CCompactDecoder::getBlockInfo(size_t block, blockInfo_t &info) const
+{
+  const char *pBody = NULL;
+  size_t size = 0;
+  if (!getBlock(block, pBody, size))
+  {
+    return false;
+  }
+  const char *pHeader = pBody - COMPACT_BLOCK_HEADER_SIZE;
+  info.records = readFixed(pHeader + 4, 4);
+  info.table = (table_t)readFixed(pHeader + 8, 4);
+  info.minLatitude = dequantize((int32_t)readFixed(pHeader + 12, 4));
+  info.minLongitude = dequantize((int32_t)readFixed(pHeader + 16, 4));
+  info.maxLatitude = dequantize((int32_t)readFixed(pHeader + 20, 4));
+  info.maxLongitude = dequantize((int32_t)readFixed(pHeader + 24, 4));
+  return true;
+}
+/**
+ * Checks the checksums of every block
+ * @param None
+ * @return true if the file is intact, false otherwise
+ */
+bool CCompactDecoder::verify(void) const
+{
+  if (!isOpen())
+  {
+    return false;
+  }
+  for (size_t block = 0; block < m_blockCount; block++)
+  {
+    const char *pBody = NULL;
+    size_t size = 0;
+    if (!getBlock(block, pBody, size) || !isIntactBlock(pBody, size))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+/**
+ * Decodes the records of a block
+ * @param size_t block [IN] - Index of the block
+ * @param std::vector<record_t>& records [OUT] - The records
+ * @return true if the block is intact, false otherwise
+ */
+bool CCompactDecoder::decodeBlock(size_t block,
+                                  std::vector<record_t> &records) const
+{
+  records.clear();
+  blockInfo_t info;
+  const char *pBody = NULL;
+  size_t size = 0;
+  /* A record takes at least 3 bytes */
+  if (!getBlockInfo(block, info) || !getBlock(block, pBody, size) ||
+      !isIntactBlock(pBody, size) || (info.records > size / 3))
+  {
+    return false;
+  }
+  const char *pEnd = pBody + size;
+  int64_t latitude = 0, longitude = 0;
+  records.resize(info.records);
+  for (uint32_t i = 0; i < info.records; i++)
+  {
+    record_t &record = records[i];
+    uint64_t latitudeDelta = 0, longitudeDelta = 0;
+    if (!readVarint(pBody, pEnd, latitudeDelta) ||
+        !readVarint(pBody, pEnd, longitudeDelta))
+    {
+      records.clear();
+      return false;
+    }
+    latitude += zigzagDecode(latitudeDelta);
+    longitude += zigzagDecode(longitudeDelta);
+    record.latitude = dequantize((int32_t)latitude);
+    record.longitude = dequantize((int32_t)longitude);
+    record.type = CPOI::UNKNOWN;
+    if (POI_TABLE == info.table)
+    {
+      unsigned char type = (pBody != pEnd) ? *pBody++ : CPOI::UNKNOWN + 1;
+      if (type > CPOI::UNKNOWN)
+      {
+        records.clear();
+        return false;
+      }
+      record.type = (CPOI::t_poi)type;
+    }
+    if (!readString(pBody, pEnd, record.name) ||
+        ((POI_TABLE == info.table) &&
+         !readString(pBody, pEnd, record.description)))
+    {
+      records.clear();
+      return false;
+    }
+  }
+  /* The body ends with the last record */
+  if (pBody != pEnd)
+  {
+    records.clear();
+    return false;
+  }
+  return true;
+}
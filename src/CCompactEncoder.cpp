@@ -0,0 +1,205 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactEncoder.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CCompactEncoder
+****************************************************************************/
+#include <algorithm>
+
+#include <nsp/CBinarySnapshot.h>
+#include <nsp/CCompactEncoder.h>
+
+using namespace compact_coding;
+
+CCompactEncoder::CCompactEncoder()
+    : m_offset(0), m_blockRecords(0), m_tileLevel(0)
+{
+  for (int table = 0; table < TABLE_COUNT; table++)
+  {
+    m_blocks[table].records = 0;
+    m_records[table] = 0;
+  }
+}
+/**
+ * Creates the file and writes its header
+ * @param const std::string& fileName [IN] - Name of the file
+ * @param size_t blockRecords [IN] - The records of a full block
+ * @param unsigned int tileLevel [IN] - Ends the blocks at the tiles of this
+ * level, 0 for no tiles
+ * @return true if the file could be created, false otherwise
+ */
+bool CCompactEncoder::open(const std::string &fileName, size_t blockRecords,
+                           unsigned int tileLevel)
+{
+  if (!m_file.open(fileName))
+  {
+    return false;
+  }
+  m_blockRecords = std::max<size_t>(blockRecords, 1);
+  m_tileLevel = std::min<unsigned int>(tileLevel, MAX_TILE_LEVEL);
+  for (int table = 0; table < TABLE_COUNT; table++)
+  {
+    m_blocks[table].body.clear();
+    m_blocks[table].records = 0;
+    m_records[table] = 0;
+  }
+  m_blockOffsets.clear();
+  m_buffer.clear();
+  appendFixed(m_buffer, COMPACT_MAGIC, 4);
+  appendFixed(m_buffer, COMPACT_VERSION, 4);
+  m_file.append(m_buffer);
+  m_offset = m_buffer.size();
+  return true;
+}
+/**
+ * Adds a waypoint to the file
+ * @param const CWaypoint& wp [IN] - The waypoint
+ * @return None
+ */
+void CCompactEncoder::addWaypoint(const CWaypoint &wp)
+{
+  addRecord(WAYPOINT_TABLE, wp.getLatitude(), wp.getLongitude(),
+            wp.getName(), std::string_view(), CPOI::UNKNOWN);
+}
+/**
+ * Adds a POI to the file
+ * @param const CPOI& poi [IN] - The POI
+ * @return None
+ */
+void CCompactEncoder::addPoi(const CPOI &poi)
+{
+  addRecord(POI_TABLE, poi.getLatitude(), poi.getLongitude(), poi.getName(),
+            poi.getDescription(), poi.getType());
+}
+/**
+ * Codes a record into the block of its table, a full block is written
+ * @param compact_coding::table_t table [IN] - The table
+ * @param double latitude, longitude [IN] - The coordinates
+ * @param std::string_view name [IN] - The name
+ * @param std::string_view description [IN] - The description of a POI
+ * @param CPOI::t_poi type [IN] - The type of a POI
+ * @return None
+ */
+void CCompactEncoder::addRecord(compact_coding::table_t table,
+                                double latitude, double longitude,
+                                std::string_view name,
+                                std::string_view description,
+                                CPOI::t_poi type)
+{
+  block_t &block = m_blocks[table];
+  int32_t stepLatitude = quantize(latitude);
+  int32_t stepLongitude = quantize(longitude);
+  uint64_t tileKey = 0;
+  if (0 != m_tileLevel)
+  {
+    tileKey = getTileKey(getTileColumn(stepLongitude, m_tileLevel),
+                         getTileRow(stepLatitude, m_tileLevel));
+    if ((0 != block.records) && (tileKey != block.tileKey))
+    {
+      writeBlock(table);
+    }
+  }
+  if (0 == block.records)
+  {
+    /* A block is decoded on its own, its first record starts at 0 */
+    block.latitude = block.longitude = 0;
+    block.minLatitude = block.maxLatitude = stepLatitude;
+    block.minLongitude = block.maxLongitude = stepLongitude;
+    block.tileKey = tileKey;
+  }
+  appendVarint(block.body,
+               zigzagEncode((int64_t)stepLatitude - block.latitude));
+  appendVarint(block.body,
+               zigzagEncode((int64_t)stepLongitude - block.longitude));
+  if (POI_TABLE == table)
+  {
+    block.body += static_cast<char>(type);
+  }
+  appendVarint(block.body, name.size());
+  block.body.append(name);
+  if (POI_TABLE == table)
+  {
+    appendVarint(block.body, description.size());
+    block.body.append(description);
+  }
+  block.latitude = stepLatitude;
+  block.longitude = stepLongitude;
+  block.minLatitude = std::min(block.minLatitude, stepLatitude);
+  block.maxLatitude = std::max(block.maxLatitude, stepLatitude);
+  block.minLongitude = std::min(block.minLongitude, stepLongitude);
+  block.maxLongitude = std::max(block.maxLongitude, stepLongitude);
+  if (++block.records >= m_blockRecords)
+  {
+    writeBlock(table);
+  }
+}
+/**
+ * Writes the block of a table, if it holds records, and empties it
+ * @param compact_coding::table_t table [IN] - The table
+ * @return None
+ */
+void CCompactEncoder::writeBlock(compact_coding::table_t table)
+{
+  block_t &block = m_blocks[table];
+  if (0 == block.records)
+  {
+    return;
+  }
+  m_buffer.clear();
+  appendFixed(m_buffer, block.body.size(), 4);
+  appendFixed(m_buffer, block.records, 4);
+  appendFixed(m_buffer, table, 4);
+  appendFixed(m_buffer, (uint32_t)block.minLatitude, 4);
+  appendFixed(m_buffer, (uint32_t)block.minLongitude, 4);
+  appendFixed(m_buffer, (uint32_t)block.maxLatitude, 4);
+  appendFixed(m_buffer, (uint32_t)block.maxLongitude, 4);
+  /* The checksum covers the header, so that a changed area or count is
+   * found as well */
+  uint32_t checksum =
+      CBinarySnapshot::updateChecksum(0, m_buffer.data(), m_buffer.size());
+  appendFixed(m_buffer,
+              CBinarySnapshot::updateChecksum(checksum, block.body.data(),
+                                              block.body.size()),
+              4);
+  m_blockOffsets.push_back(m_offset);
+  m_file.append(m_buffer);
+  m_file.append(block.body);
+  m_offset += m_buffer.size() + block.body.size();
+  m_records[table] += block.records;
+  block.body.clear();
+  block.records = 0;
+}
+/**
+ * Writes the open blocks, the index and the trailer and closes the file
+ * @param None
+ * @return true if every write succeeded, false otherwise
+ */
+bool CCompactEncoder::close(void)
+{
+  if (!m_file.isOpen())
+  {
+    return false;
+  }
+  writeBlock(WAYPOINT_TABLE);
+  writeBlock(POI_TABLE);
+  m_buffer.clear();
+  for (size_t i = 0; i < m_blockOffsets.size(); i++)
+  {
+    appendFixed(m_buffer, m_blockOffsets[i], 8);
+  }
+  appendFixed(m_buffer, COMPACT_MAGIC, 4);
+  appendFixed(m_buffer, COMPACT_VERSION, 4);
+  appendFixed(m_buffer, m_blockOffsets.size(), 8);
+  appendFixed(m_buffer, m_offset, 8);
+  appendFixed(m_buffer, m_records[WAYPOINT_TABLE], 8);
+  appendFixed(m_buffer, m_records[POI_TABLE], 8);
+  appendFixed(m_buffer, m_tileLevel, 4);
+  appendFixed(m_buffer,
+              CBinarySnapshot::updateChecksum(0, m_buffer.data(),
+                                              m_buffer.size()),
+              4);
+  m_file.append(m_buffer);
+  m_offset += m_buffer.size();
+  return m_file.close();
+}
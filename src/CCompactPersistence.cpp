@@ -0,0 +1,228 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CCompactPersistence.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CCompactPersistence
+****************************************************************************/
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <nsp/CCompactDecoder.h>
+#include <nsp/CCompactEncoder.h>
+#include <nsp/CCompactPersistence.h>
+#include <nsp/CDiagnostics.h>
+
+#define FILE_LOCATION \
+  "myCode/" /**< @brief Represents the compact file location */
+#define FILE_EXTENSION \
+  ".nspc" /**< @brief Represents the extension of the compact file */
+
+/**
+ * Gets the entries of a Database in the order of the Hilbert index of
+ * their coordinates, entries at the same position in the order of their
+ * names
+ * @param const Database& db [IN] - The Waypoint or POI Database
+ * @param std::vector<Iterator>& entries [OUT] - The entries
+ * @return None
+ */
+template <typename Database, typename Iterator>
+static void sortByHilbertIndex(const Database &db,
+                               std::vector<Iterator> &entries)
+{
+  std::vector<std::pair<uint64_t, Iterator> > keys;
+  keys.reserve(db.size());
+  for (Iterator itr = db.begin(); itr != db.end(); ++itr)
+  {
+    keys.push_back(std::make_pair(
+        compact_coding::getHilbertIndex(
+            compact_coding::quantize(itr->second.getLatitude()),
+            compact_coding::quantize(itr->second.getLongitude())),
+        itr));
+  }
+  /* The map is in name order, so a stable sort keeps it for equal keys */
+  std::stable_sort(keys.begin(), keys.end(),
+                   [](const std::pair<uint64_t, Iterator> &first,
+                      const std::pair<uint64_t, Iterator> &second) {
+                     return first.first < second.first;
+                   });
+  entries.clear();
+  entries.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    entries.push_back(keys[i].second);
+  }
+}
+
+/**
+ * Adds entries to a Database in the order of their names, so that each of
+ * them is appended to the Database
+ * @param Database& db [IN/OUT] - The Waypoint or POI Database
+ * @param std::vector<Node>& nodes [IN/OUT] - The entries, empty afterwards
+ * @return None
+ */
+template <typename Database, typename Node>
+static void addNodesByName(Database &db, std::vector<Node> &nodes)
+{
+  std::sort(nodes.begin(), nodes.end(),
+            [](const Node &first, const Node &second) {
+              return first.key() < second.key();
+            });
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    db.addNode(nodes[i]);
+  }
+  nodes.clear();
+}
+
+/**
+ * Set the name of the media to be used for persistent storage. The
+ * compact file is myCode/<name>.nspc
+ *
+ * @param name the media to be used
+ */
+void CCompactPersistence::setMediaName(std::string name)
+{
+  m_fileName = FILE_LOCATION + name + FILE_EXTENSION;
+}
+/**
+ * Get the files of the media which writeData() replaces
+ *
+ * @param fileNames the names of the files (with path)
+ */
+void CCompactPersistence::getMediaFiles(
+    std::vector<std::string> &fileNames) const
+{
+  fileNames.assign(1, m_fileName);
+}
+/**
+ * Write the data to the persistent storage. The entries are sorted by the
+ * Hilbert index of their coordinates and coded in blocks.
+ *
+ * @param waypointDb[IN] the data base with way points
+ * @param poiDb[IN] the database with points of interest
+ * @return true if the data could be saved successfully
+ */
+bool CCompactPersistence::writeData(const CWpDatabase &waypointDb,
+                                    const CPoiDatabase &poiDb)
+{
+  CCompactEncoder encoder;
+  if (!encoder.open(m_fileName))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CCompactPersistence::writeData() failed: Unable to open " +
+            m_fileName);
+    return false;
+  }
+  std::vector<CWpDatabase::const_iterator> waypoints;
+  sortByHilbertIndex(waypointDb, waypoints);
+  for (size_t i = 0; i < waypoints.size(); i++)
+  {
+    encoder.addWaypoint(waypoints[i]->second);
+  }
+  std::vector<CPoiDatabase::const_iterator> pois;
+  sortByHilbertIndex(poiDb, pois);
+  for (size_t i = 0; i < pois.size(); i++)
+  {
+    encoder.addPoi(pois[i]->second);
+  }
+  if (!encoder.close())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CCompactPersistence::writeData() failed: Unable to write " +
+            m_fileName);
+    return false;
+  }
+  return true;
+}
+/**
+ * Fill the databases with the data from persistent storage. If
+ * merge mode is MERGE, the content in the persistent storage
+ * will be merged with any content already existing in the data
+ * bases. If merge mode is REPLACE, already existing content
+ * will be removed before inserting the content from the persistent
+ * storage. The databases are not changed if the file is not intact.
+ *
+ * @param waypointDb[OUT] the the data base with way points
+ * @param poiDb[OUT] the database with points of interest
+ * @param mode[IN] the merge mode
+ * @return true if the data could be read successfully
+ */
+bool CCompactPersistence::readData(CWpDatabase &waypointDb,
+                                   CPoiDatabase &poiDb, MergeMode mode)
+{
+  CDiagnosticScope load("CCompactPersistence::readData()");
+  CCompactDecoder decoder;
+  if (!decoder.open(m_fileName) || !decoder.verify())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CCompactPersistence::readData() failed: " + m_fileName +
+            " is not a complete compact file");
+    return false;
+  }
+  switch (mode)
+  {
+  case MERGE:
+  {
+    // no change
+    break;
+  }
+  case REPLACE:
+  {
+    waypointDb.clearWpDatabase();
+    poiDb.clearPoiDatabase();
+    break;
+  }
+  default:
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR, "Invalid Mode Specified");
+    return false;
+  }
+  }
+  bool retVal = true;
+  std::vector<CCompactDecoder::record_t> records;
+  std::vector<CWpDatabase::node_t> waypoints;
+  std::vector<CPoiDatabase::node_t> pois;
+  waypoints.reserve(decoder.getRecordCount(compact_coding::WAYPOINT_TABLE));
+  pois.reserve(decoder.getRecordCount(compact_coding::POI_TABLE));
+  for (size_t block = 0; block < decoder.getBlockCount(); block++)
+  {
+    CCompactDecoder::blockInfo_t info;
+    if (!decoder.getBlockInfo(block, info) ||
+        !decoder.decodeBlock(block, records))
+    {
+      CDiagnostics::report(
+          CDiagnostics::STORAGE_ERROR,
+          "ERROR!CCompactPersistence::readData() failed: Invalid block in " +
+              m_fileName);
+      retVal = false;
+      continue;
+    }
+    for (size_t i = 0; i < records.size(); i++)
+    {
+      const CCompactDecoder::record_t &record = records[i];
+      std::string name(record.name);
+      if (compact_coding::WAYPOINT_TABLE == info.table)
+      {
+        waypoints.push_back(CWpDatabase::createNode(
+            name, CWaypoint(record.latitude, record.longitude, name)));
+      }
+      else
+      {
+        pois.push_back(CPoiDatabase::createNode(
+            name, CPOI(record.type, name, std::string(record.description),
+                       record.latitude, record.longitude)));
+      }
+    }
+  }
+  /* The file is in Hilbert order, in name order the entries are appended */
+  addNodesByName(waypointDb, waypoints);
+  addNodesByName(poiDb, pois);
+  return retVal;
+}
@@ -0,0 +1,780 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CContractionHierarchy.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CContractionHierarchy
+****************************************************************************/
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <utility>
+
+#include <nsp/CContractionHierarchy.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CThreadPool.h>
+
+#define CH_FILE_VERSION (1) /**< @brief Represents the file format version */
+#define CH_FILE_ALIGNMENT (8) /**< @brief Represents the section alignment */
+#define WITNESS_SETTLE_LIMIT                                                 \
+  (500) /**< @brief Represents the nodes a witness search may settle when a \
+           node is contracted */
+#define PRIORITY_SETTLE_LIMIT                                                \
+  (50) /**< @brief Represents the nodes a witness search may settle when a  \
+          priority is estimated */
+#define PARALLEL_BLOCK_SIZE                                                  \
+  (64) /**< @brief Represents the nodes of one task */
+
+typedef CContractionHierarchy::node_t node_t;
+typedef CContractionHierarchy::edge_t edge_t;
+typedef CContractionHierarchy::hierarchyEdge_t hierarchyEdge_t;
+typedef std::vector<hierarchyEdge_t> edgeList_t;
+
+static const char CH_FILE_MAGIC[8] = {'N', 'S', 'P', 'C', 'H', 0, 0, 0};
+static const edge_t EMPTY_EDGE_OFFSETS[1] = {0};
+static const uint32_t EMPTY_NAME_OFFSETS[1] = {0};
+
+typedef struct {
+  node_t from;   /**< \brief Represents the start node of the shortcut */
+  node_t to;     /**< \brief Represents the end node of the shortcut */
+  node_t middle; /**< \brief Represents the bypassed node */
+  double weight; /**< \brief Represents the length of the shortcut in km */
+} shortcut_t;    /**< \brief Represents a shortcut found for a node */
+
+typedef struct contractionGraph {
+  std::vector<edgeList_t> out; /**< \brief Represents the outgoing edges of
+                                  every node which is not yet contracted */
+  std::vector<edgeList_t> in;  /**< \brief Represents the incoming edges of
+                                  every node which is not yet contracted */
+} contractionGraph_t; /**< \brief Represents the remaining graph */
+
+typedef struct witnessWorkspace {
+  std::vector<double> cost;
+  std::vector<unsigned int> visitStamp;
+  std::vector<unsigned int> targetStamp; /**< \brief Marks the nodes a
+                                            witness is searched for */
+  std::vector<std::pair<double, node_t> > openList;
+  std::vector<shortcut_t> shortcuts; /**< \brief Scratch for priorities */
+  unsigned int currentStamp;
+} witnessWorkspace_t; /**< \brief Represents the state of one worker */
+
+/**
+ * Inserts an edge into an edge list. If the list already holds an edge to
+ * the same node, only the shorter of the two is kept.
+ * @param edgeList_t& edges [IN, OUT] - The edge list
+ * @param node_t target [IN] - Other end of the edge
+ * @param node_t middle [IN] - Bypassed node or INVALID_NODE
+ * @param double weight [IN] - Length of the edge
+ * @return None
+ */
+static void insertEdge(edgeList_t &edges, node_t target, node_t middle,
+                       double weight)
+{
+  for (edgeList_t::iterator itr = edges.begin(); itr != edges.end(); ++itr)
+  {
+    if (itr->target == target)
+    {
+      if (weight < itr->weight)
+      {
+        itr->weight = weight;
+        itr->middle = middle;
+      }
+      return;
+    }
+  }
+  hierarchyEdge_t edge = {target, middle, weight};
+  edges.push_back(edge);
+}
+/**
+ * Removes the edge to a node from an edge list
+ * @param edgeList_t& edges [IN, OUT] - The edge list
+ * @param node_t target [IN] - Other end of the edge
+ * @return None
+ */
+static void removeEdge(edgeList_t &edges, node_t target)
+{
+  for (size_t i = 0; i < edges.size(); i++)
+  {
+    if (edges[i].target == target)
+    {
+      edges[i] = edges.back();
+      edges.pop_back();
+      return;
+    }
+  }
+}
+/**
+ * Runs a bounded Dijkstra search in the remaining graph which avoids the
+ * nodes that are about to be contracted
+ * @param const contractionGraph_t& graph [IN] - The remaining graph
+ * @param node_t source [IN] - Start node
+ * @param node_t excluded [IN] - Node which must not be used
+ * @param const std::vector<char>& isContracting [IN] - Nodes of the current
+ * round, which must not be used either
+ * @param double maxCost [IN] - Search radius
+ * @param unsigned int settleLimit [IN] - Maximum number of settled nodes
+ * @param unsigned int targetCount [IN] - Number of nodes marked with the
+ * current target stamp. The search stops once all of them are settled.
+ * @param witnessWorkspace_t& ws [OUT] - Holds the reached nodes
+ * @return None
+ */
+static void runWitnessSearch(const contractionGraph_t &graph, node_t source,
+                             node_t excluded,
+                             const std::vector<char> &isContracting,
+                             double maxCost,
+                             unsigned int settleLimit, unsigned int targetCount,
+                             witnessWorkspace_t &ws)
+{
+  std::greater<std::pair<double, node_t> > heapOrder;
+  ws.openList.clear();
+  ws.cost[source] = 0;
+  ws.visitStamp[source] = ws.currentStamp;
+  ws.openList.push_back(std::make_pair(0.0, source));
+
+  unsigned int settledNodes = 0;
+  while (!ws.openList.empty())
+  {
+    std::pop_heap(ws.openList.begin(), ws.openList.end(), heapOrder);
+    double cost = ws.openList.back().first;
+    node_t node = ws.openList.back().second;
+    ws.openList.pop_back();
+    if (cost > ws.cost[node]) /* Outdated entry */
+      continue;
+    if ((cost > maxCost) || (++settledNodes > settleLimit))
+      break;
+    if ((ws.targetStamp[node] == ws.currentStamp) && (0 == --targetCount))
+      break;
+
+    const edgeList_t &edges = graph.out[node];
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+      node_t next = edges[i].target;
+      double nextCost = cost + edges[i].weight;
+      if ((next == excluded) || isContracting[next] ||
+          (nextCost > maxCost))
+        continue;
+      if ((ws.visitStamp[next] != ws.currentStamp) || (nextCost < ws.cost[next]))
+      {
+        ws.visitStamp[next] = ws.currentStamp;
+        ws.cost[next] = nextCost;
+        ws.openList.push_back(std::make_pair(nextCost, next));
+        std::push_heap(ws.openList.begin(), ws.openList.end(), heapOrder);
+      }
+    }
+  }
+}
+/**
+ * Finds the shortcuts which are needed when a node is contracted. A path
+ * u -> node -> x needs a shortcut unless a witness path from u to x which
+ * avoids the node and is not longer is found. The other nodes contracted
+ * in the same round are removed together with the node, so they are no
+ * witnesses either.
+ * @param const contractionGraph_t& graph [IN] - The remaining graph
+ * @param node_t node [IN] - Node to be contracted
+ * @param const std::vector<char>& isContracting [IN] - Nodes of the current
+ * round
+ * @param unsigned int settleLimit [IN] - Limit of the witness searches
+ * @param witnessWorkspace_t& ws [IN] - Workspace of the calling thread
+ * @param std::vector<shortcut_t>& shortcuts [OUT] - The shortcuts
+ * @return None
+ */
+static void findShortcuts(const contractionGraph_t &graph, node_t node,
+                          const std::vector<char> &isContracting,
+                          unsigned int settleLimit, witnessWorkspace_t &ws,
+                          std::vector<shortcut_t> &shortcuts)
+{
+  shortcuts.clear();
+  const edgeList_t &inEdges = graph.in[node];
+  const edgeList_t &outEdges = graph.out[node];
+  for (size_t i = 0; i < inEdges.size(); i++)
+  {
+    if (0 == ++ws.currentStamp)
+    {
+      std::fill(ws.visitStamp.begin(), ws.visitStamp.end(), 0);
+      std::fill(ws.targetStamp.begin(), ws.targetStamp.end(), 0);
+      ws.currentStamp = 1;
+    }
+    node_t from = inEdges[i].target;
+    double maxOutWeight = -1;
+    unsigned int targetCount = 0;
+    for (size_t j = 0; j < outEdges.size(); j++)
+    {
+      if (outEdges[j].target == from)
+        continue;
+      ws.targetStamp[outEdges[j].target] = ws.currentStamp;
+      targetCount++;
+      if (outEdges[j].weight > maxOutWeight)
+        maxOutWeight = outEdges[j].weight;
+    }
+    if (0 == targetCount) /* No path through the node starts at from */
+      continue;
+
+    runWitnessSearch(graph, from, node, isContracting,
+                     inEdges[i].weight + maxOutWeight, settleLimit,
+                     targetCount, ws);
+    for (size_t j = 0; j < outEdges.size(); j++)
+    {
+      node_t to = outEdges[j].target;
+      double viaCost = inEdges[i].weight + outEdges[j].weight;
+      if (to == from)
+        continue;
+      if ((ws.visitStamp[to] == ws.currentStamp) && (ws.cost[to] <= viaCost))
+        continue; /* Witness found */
+      shortcut_t shortcut = {from, to, node, viaCost};
+      shortcuts.push_back(shortcut);
+    }
+  }
+}
+/**
+ * Estimates the priority of a node. Nodes which add fewer edges than they
+ * remove are contracted first. The contracted neighbours and the level
+ * (the longest chain of contracted nodes below the node) spread the
+ * contraction evenly over the graph, which keeps the query search spaces
+ * small.
+ * @param const contractionGraph_t& graph [IN] - The remaining graph
+ * @param node_t node [IN] - The node
+ * @param unsigned int deletedNeighbours [IN] - Contracted neighbours
+ * @param unsigned int level [IN] - Level of the node
+ * @param const std::vector<char>& isContracting [IN] - Nodes of the current
+ * round
+ * @param witnessWorkspace_t& ws [IN] - Workspace of the calling thread
+ * @return int - Priority, lower is contracted earlier
+ */
+static int computePriority(const contractionGraph_t &graph, node_t node,
+                           unsigned int deletedNeighbours, unsigned int level,
+                           const std::vector<char> &isContracting,
+                           witnessWorkspace_t &ws)
+{
+  findShortcuts(graph, node, isContracting, PRIORITY_SETTLE_LIMIT, ws,
+                ws.shortcuts);
+  int edgeDifference = (int)ws.shortcuts.size() -
+                       (int)(graph.in[node].size() + graph.out[node].size());
+  return 2 * edgeDifference + (int)deletedNeighbours + (int)level;
+}
+/**
+ * Checks if a node has a lower priority than all its remaining neighbours.
+ * Ties are broken by the node index, so no two neighbours are selected in
+ * the same round.
+ * @return true if the node is a local minimum, false otherwise
+ */
+static bool isLocalMinimum(const contractionGraph_t &graph,
+                           const std::vector<int> &priority, node_t node)
+{
+  const edgeList_t *lists[2] = {&graph.out[node], &graph.in[node]};
+  for (int list = 0; list < 2; list++)
+  {
+    for (size_t i = 0; i < lists[list]->size(); i++)
+    {
+      node_t other = (*lists[list])[i].target;
+      if ((priority[other] < priority[node]) ||
+          ((priority[other] == priority[node]) && (other < node)))
+        return false;
+    }
+  }
+  return true;
+}
+/**
+ * Writes a section of the file and pads it to the section alignment
+ * @return None
+ */
+static void writeSection(std::fstream &file, const void *pData, size_t size)
+{
+  static const char padding[CH_FILE_ALIGNMENT] = {0};
+  if (0 != size)
+  {
+    file.write(static_cast<const char *>(pData), size);
+  }
+  file.write(padding, (CH_FILE_ALIGNMENT - size % CH_FILE_ALIGNMENT) %
+                          CH_FILE_ALIGNMENT);
+}
+/**
+ * Gets the padded size of a section
+ */
+static size_t alignSection(size_t size)
+{
+  return (size + CH_FILE_ALIGNMENT - 1) / CH_FILE_ALIGNMENT * CH_FILE_ALIGNMENT;
+}
+/**
+ * Checks the offsets of a section which is read from a file: they start at
+ * 0, never decrease and end at the size of the indexed section
+ * @param const uint32_t* pOffsets [IN] - The offsets, count + 1 entries
+ * @param size_t count [IN] - Number of nodes
+ * @param size_t total [IN] - Number of entries of the indexed section
+ * @return true if every range lies in the indexed section, false otherwise
+ */
+static bool isValidOffsets(const uint32_t *pOffsets, size_t count,
+                           size_t total)
+{
+  if ((0 != pOffsets[0]) || (total != pOffsets[count]))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++)
+  {
+    if (pOffsets[i] > pOffsets[i + 1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+/**
+ * Checks the edges of a section which is read from a file
+ * @param const hierarchyEdge_t* pEdges [IN] - The edges
+ * @param size_t edgeCount [IN] - Number of edges
+ * @param size_t nodeCount [IN] - Number of nodes
+ * @return true if every edge leads to a node and bypasses a node or
+ * INVALID_NODE, false otherwise
+ */
+static bool isValidEdges(const hierarchyEdge_t *pEdges, size_t edgeCount,
+                         size_t nodeCount)
+{
+  for (size_t i = 0; i < edgeCount; i++)
+  {
+    if ((pEdges[i].target >= nodeCount) ||
+        ((pEdges[i].middle >= nodeCount) &&
+         (CRoutingGraph::INVALID_NODE != pEdges[i].middle)) ||
+        !(pEdges[i].weight >= 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+CContractionHierarchy::CContractionHierarchy() { detach(); }
+/**
+ * Builds the hierarchy of a finalized routing graph.
+ * Every round selects the nodes whose priority is lower than that of all
+ * their neighbours. These nodes are independent, hence their witness
+ * searches only read the remaining graph and run in parallel, every worker
+ * with its own workspace and shortcut buffers. The searches avoid every
+ * node of the round, since all of them are removed at once. The shortcuts
+ * are merged afterwards and only the priorities of the neighbours are
+ * updated.
+ * @param const CRoutingGraph& graph [IN] - The graph to be contracted
+ * @param unsigned int threadCount [IN] - Number of worker threads, 0 uses
+ * one thread per core
+ * @return None
+ */
+void CContractionHierarchy::build(const CRoutingGraph &graph,
+                                  unsigned int threadCount)
+{
+  clear();
+  CThreadPool pool(threadCount);
+  threadCount = pool.getThreadCount();
+  node_t nodeCount = graph.getNodeCount();
+
+  /* Copy the graph into modifiable adjacency lists */
+  contractionGraph_t remaining;
+  remaining.out.resize(nodeCount);
+  remaining.in.resize(nodeCount);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    for (edge_t edge = graph.getEdgeBegin(node); edge < graph.getEdgeEnd(node);
+         edge++)
+    {
+      node_t target = graph.getEdgeTarget(edge);
+      if (target == node) /* Loops are never part of a shortest path */
+        continue;
+      insertEdge(remaining.out[node], target, CRoutingGraph::INVALID_NODE,
+                 graph.getEdgeWeight(edge));
+      insertEdge(remaining.in[target], node, CRoutingGraph::INVALID_NODE,
+                 graph.getEdgeWeight(edge));
+    }
+  }
+
+  std::vector<witnessWorkspace_t> workspaces(threadCount);
+  for (unsigned int thread = 0; thread < threadCount; thread++)
+  {
+    workspaces[thread].cost.resize(nodeCount);
+    workspaces[thread].visitStamp.assign(nodeCount, 0);
+    workspaces[thread].targetStamp.assign(nodeCount, 0);
+    workspaces[thread].currentStamp = 0;
+  }
+  std::vector<int> priority(nodeCount);
+  std::vector<unsigned int> deletedNeighbours(nodeCount, 0);
+  std::vector<unsigned int> level(nodeCount, 0);
+  /* A contracted node keeps its mark, it has no edges left anyway */
+  std::vector<char> isContracting(nodeCount, 0);
+  pool.parallelFor(nodeCount, PARALLEL_BLOCK_SIZE,
+              [&](size_t begin, size_t end, unsigned int thread) {
+                for (size_t node = begin; node < end; node++)
+                {
+                  priority[node] = computePriority(remaining, node, 0, 0,
+                                                   isContracting,
+                                                   workspaces[thread]);
+                }
+              });
+
+  std::vector<edgeList_t> upEdges(nodeCount);
+  std::vector<edgeList_t> downEdges(nodeCount);
+  std::vector<node_t> candidates(nodeCount);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    candidates[node] = node;
+  }
+  std::vector<node_t> nextCandidates, independentSet, neighbours;
+  std::vector<char> isSelected, isNeighbour(nodeCount, 0);
+  std::vector<std::vector<shortcut_t> > shortcuts;
+
+  while (!candidates.empty())
+  {
+    /* Select the independent set of this round */
+    isSelected.assign(candidates.size(), 0);
+    pool.parallelFor(candidates.size(), PARALLEL_BLOCK_SIZE,
+                [&](size_t begin, size_t end, unsigned int) {
+                  for (size_t i = begin; i < end; i++)
+                  {
+                    isSelected[i] =
+                        isLocalMinimum(remaining, priority, candidates[i]);
+                  }
+                });
+    independentSet.clear();
+    nextCandidates.clear();
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+      (isSelected[i] ? independentSet : nextCandidates)
+          .push_back(candidates[i]);
+    }
+    for (size_t i = 0; i < independentSet.size(); i++)
+    {
+      isContracting[independentSet[i]] = 1;
+    }
+
+    /* Find the shortcuts of all selected nodes in parallel */
+    if (shortcuts.size() < independentSet.size())
+    {
+      shortcuts.resize(independentSet.size());
+    }
+    pool.parallelFor(independentSet.size(), PARALLEL_BLOCK_SIZE,
+                [&](size_t begin, size_t end, unsigned int thread) {
+                  for (size_t i = begin; i < end; i++)
+                  {
+                    findShortcuts(remaining, independentSet[i],
+                                  isContracting, WITNESS_SETTLE_LIMIT,
+                                  workspaces[thread], shortcuts[i]);
+                  }
+                });
+
+    /* Contract the selected nodes. The remaining neighbours of a node are
+     * contracted later, hence all its edges lead upwards. */
+    neighbours.clear();
+    for (size_t i = 0; i < independentSet.size(); i++)
+    {
+      node_t node = independentSet[i];
+      upEdges[node].swap(remaining.out[node]);
+      downEdges[node].swap(remaining.in[node]);
+      for (size_t j = 0; j < upEdges[node].size(); j++)
+      {
+        node_t other = upEdges[node][j].target;
+        removeEdge(remaining.in[other], node);
+        deletedNeighbours[other]++;
+        level[other] = std::max(level[other], level[node] + 1);
+        if (!isNeighbour[other])
+        {
+          isNeighbour[other] = 1;
+          neighbours.push_back(other);
+        }
+      }
+      for (size_t j = 0; j < downEdges[node].size(); j++)
+      {
+        node_t other = downEdges[node][j].target;
+        removeEdge(remaining.out[other], node);
+        deletedNeighbours[other]++;
+        level[other] = std::max(level[other], level[node] + 1);
+        if (!isNeighbour[other])
+        {
+          isNeighbour[other] = 1;
+          neighbours.push_back(other);
+        }
+      }
+    }
+    for (size_t i = 0; i < independentSet.size(); i++)
+    {
+      for (size_t j = 0; j < shortcuts[i].size(); j++)
+      {
+        const shortcut_t &shortcut = shortcuts[i][j];
+        insertEdge(remaining.out[shortcut.from], shortcut.to, shortcut.middle,
+                   shortcut.weight);
+        insertEdge(remaining.in[shortcut.to], shortcut.from, shortcut.middle,
+                   shortcut.weight);
+      }
+    }
+
+    /* Only the neighbours of contracted nodes change their priority */
+    pool.parallelFor(neighbours.size(), PARALLEL_BLOCK_SIZE,
+                [&](size_t begin, size_t end, unsigned int thread) {
+                  for (size_t i = begin; i < end; i++)
+                  {
+                    node_t node = neighbours[i];
+                    priority[node] = computePriority(
+                        remaining, node, deletedNeighbours[node],
+                        level[node], isContracting, workspaces[thread]);
+                  }
+                });
+    for (size_t i = 0; i < neighbours.size(); i++)
+    {
+      isNeighbour[neighbours[i]] = 0;
+    }
+    candidates.swap(nextCandidates);
+  }
+
+  /* Flatten the edge lists into the CSR arrays */
+  m_upOffsetStore.assign(1, 0);
+  m_downOffsetStore.assign(1, 0);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    m_upEdgeStore.insert(m_upEdgeStore.end(), upEdges[node].begin(),
+                         upEdges[node].end());
+    m_upOffsetStore.push_back(m_upEdgeStore.size());
+    edgeList_t().swap(upEdges[node]);
+    m_downEdgeStore.insert(m_downEdgeStore.end(), downEdges[node].begin(),
+                           downEdges[node].end());
+    m_downOffsetStore.push_back(m_downEdgeStore.size());
+    edgeList_t().swap(downEdges[node]);
+  }
+
+  /* Build the name heap and the sorted name index */
+  m_nameOffsetStore.assign(1, 0);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    const std::string &name = graph.getNodeName(node);
+    m_nameHeapStore.insert(m_nameHeapStore.end(), name.begin(), name.end());
+    m_nameOffsetStore.push_back(m_nameHeapStore.size());
+  }
+  m_nameOrderStore.resize(nodeCount);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    m_nameOrderStore[node] = node;
+  }
+  std::sort(m_nameOrderStore.begin(), m_nameOrderStore.end(),
+            [&graph](node_t first, node_t second) {
+              return graph.getNodeName(first) < graph.getNodeName(second);
+            });
+  m_nodeCount = nodeCount;
+  attachStore();
+}
+/**
+ * Writes the hierarchy to a binary file. The file consists of the header
+ * followed by the upward CSR, the downward CSR, the name offsets, the
+ * sorted name index and the name heap. Every section starts 8 byte aligned.
+ * @param const std::string& fileName [IN] - Name of the file
+ * @return true if the file is written, false otherwise
+ */
+bool CContractionHierarchy::writeToFile(const std::string &fileName) const
+{
+  std::fstream file(fileName.c_str(),
+                    std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CContractionHierarchy::writeToFile() failed! "
+                         "Unable to open " +
+                             fileName);
+    return false;
+  }
+  fileHeader_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CH_FILE_MAGIC, sizeof(header.magic));
+  header.version = CH_FILE_VERSION;
+  header.nodeCount = m_nodeCount;
+  header.upEdgeCount = getUpEdgeCount();
+  header.downEdgeCount = getDownEdgeCount();
+  header.nameHeapSize = m_pNameOffsets[m_nodeCount];
+
+  writeSection(file, &header, sizeof(header));
+  writeSection(file, m_pUpOffsets, (m_nodeCount + 1) * sizeof(edge_t));
+  writeSection(file, m_pUpEdges, header.upEdgeCount * sizeof(hierarchyEdge_t));
+  writeSection(file, m_pDownOffsets, (m_nodeCount + 1) * sizeof(edge_t));
+  writeSection(file, m_pDownEdges,
+               header.downEdgeCount * sizeof(hierarchyEdge_t));
+  writeSection(file, m_pNameOffsets, (m_nodeCount + 1) * sizeof(uint32_t));
+  writeSection(file, m_pNameOrder, m_nodeCount * sizeof(node_t));
+  writeSection(file, m_pNameHeap, header.nameHeapSize);
+  file.close();
+  if (file.fail())
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CContractionHierarchy::writeToFile() failed! "
+                         "Unable to write " +
+                             fileName);
+    return false;
+  }
+  return true;
+}
+/**
+ * Maps a hierarchy file into memory. The header and the section sizes are
+ * checked, the sections themselves are used in place.
+ * @param const std::string& fileName [IN] - Name of the file
+ * @return true if the file is a valid hierarchy, false otherwise
+ */
+bool CContractionHierarchy::openFile(const std::string &fileName)
+{
+  CDiagnosticScope load("CContractionHierarchy::openFile()");
+  clear();
+  if (!m_file.open(fileName))
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CContractionHierarchy::openFile() failed! "
+                         "Unable to open " +
+                             fileName);
+    return false;
+  }
+  const char *pData = m_file.getData();
+  size_t fileSize = m_file.getSize();
+  fileHeader_t header;
+  bool isValid = (fileSize >= sizeof(header));
+  if (isValid)
+  {
+    memcpy(&header, pData, sizeof(header));
+    isValid = (0 == memcmp(header.magic, CH_FILE_MAGIC, sizeof(header.magic))) &&
+              (CH_FILE_VERSION == header.version);
+  }
+  if (isValid)
+  {
+    size_t offsetsSize = ((size_t)header.nodeCount + 1) * sizeof(edge_t);
+    size_t position = alignSection(sizeof(header));
+    const char *pUpOffsets = pData + position;
+    position += alignSection(offsetsSize);
+    const char *pUpEdges = pData + position;
+    position += alignSection(header.upEdgeCount * sizeof(hierarchyEdge_t));
+    const char *pDownOffsets = pData + position;
+    position += alignSection(offsetsSize);
+    const char *pDownEdges = pData + position;
+    position += alignSection(header.downEdgeCount * sizeof(hierarchyEdge_t));
+    const char *pNameOffsets = pData + position;
+    position += alignSection(offsetsSize);
+    const char *pNameOrder = pData + position;
+    position += alignSection(header.nodeCount * sizeof(node_t));
+    const char *pNameHeap = pData + position;
+    position += alignSection(header.nameHeapSize);
+
+    isValid = (position <= fileSize);
+    if (isValid)
+    {
+      m_nodeCount = header.nodeCount;
+      m_pUpOffsets = reinterpret_cast<const edge_t *>(pUpOffsets);
+      m_pUpEdges = reinterpret_cast<const hierarchyEdge_t *>(pUpEdges);
+      m_pDownOffsets = reinterpret_cast<const edge_t *>(pDownOffsets);
+      m_pDownEdges = reinterpret_cast<const hierarchyEdge_t *>(pDownEdges);
+      m_pNameOffsets = reinterpret_cast<const uint32_t *>(pNameOffsets);
+      m_pNameOrder = reinterpret_cast<const node_t *>(pNameOrder);
+      m_pNameHeap = pNameHeap;
+      /* A query trusts the sections, so they are checked once here */
+      isValid =
+          isValidOffsets(m_pUpOffsets, m_nodeCount, header.upEdgeCount) &&
+          isValidOffsets(m_pDownOffsets, m_nodeCount, header.downEdgeCount) &&
+          isValidOffsets(m_pNameOffsets, m_nodeCount, header.nameHeapSize) &&
+          isValidEdges(m_pUpEdges, header.upEdgeCount, m_nodeCount) &&
+          isValidEdges(m_pDownEdges, header.downEdgeCount, m_nodeCount);
+      for (node_t i = 0; isValid && (i < m_nodeCount); i++)
+      {
+        isValid = (m_pNameOrder[i] < m_nodeCount);
+      }
+    }
+  }
+  if (!isValid)
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CContractionHierarchy::openFile() failed! " +
+                             fileName + " is not a valid hierarchy file");
+    clear();
+    return false;
+  }
+  return true;
+}
+/**
+ * Releases the hierarchy
+ * @param None
+ * @return None
+ */
+void CContractionHierarchy::clear(void)
+{
+  detach();
+  m_file.close();
+  std::vector<edge_t>().swap(m_upOffsetStore);
+  std::vector<hierarchyEdge_t>().swap(m_upEdgeStore);
+  std::vector<edge_t>().swap(m_downOffsetStore);
+  std::vector<hierarchyEdge_t>().swap(m_downEdgeStore);
+  std::vector<uint32_t>().swap(m_nameOffsetStore);
+  std::vector<node_t>().swap(m_nameOrderStore);
+  std::vector<char>().swap(m_nameHeapStore);
+}
+/**
+ * Points the views onto the vectors of a hierarchy built in this process
+ * @param None
+ * @return None
+ */
+void CContractionHierarchy::attachStore(void)
+{
+  m_pUpOffsets = &m_upOffsetStore[0];
+  m_pUpEdges = m_upEdgeStore.data();
+  m_pDownOffsets = &m_downOffsetStore[0];
+  m_pDownEdges = m_downEdgeStore.data();
+  m_pNameOffsets = &m_nameOffsetStore[0];
+  m_pNameOrder = m_nameOrderStore.data();
+  m_pNameHeap = m_nameHeapStore.data();
+}
+/**
+ * Resets the views to an empty hierarchy
+ * @param None
+ * @return None
+ */
+void CContractionHierarchy::detach(void)
+{
+  m_nodeCount = 0;
+  m_pUpOffsets = EMPTY_EDGE_OFFSETS;
+  m_pUpEdges = NULL;
+  m_pDownOffsets = EMPTY_EDGE_OFFSETS;
+  m_pDownEdges = NULL;
+  m_pNameOffsets = EMPTY_NAME_OFFSETS;
+  m_pNameOrder = NULL;
+  m_pNameHeap = NULL;
+}
+/**
+ * Gets the node which belongs to the Waypoint with the given name. The
+ * name index is sorted, hence the lookup is a binary search.
+ * @param const std::string& name [IN] - Name of the Waypoint
+ * @param node_t& node [OUT] - Index of the node
+ * @return true if the node is found, false otherwise
+ */
+bool CContractionHierarchy::getNode(const std::string &name,
+                                    node_t &node) const
+{
+  size_t low = 0, high = m_nodeCount;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    node_t candidate = m_pNameOrder[mid];
+    if (name.compare(0, std::string::npos,
+                     m_pNameHeap + m_pNameOffsets[candidate],
+                     m_pNameOffsets[candidate + 1] -
+                         m_pNameOffsets[candidate]) > 0)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  if ((low < m_nodeCount) && (getNodeName(m_pNameOrder[low]) == name))
+  {
+    node = m_pNameOrder[low];
+    return true;
+  }
+  return false;
+}
+/**
+ * Gets the Waypoint name of a node
+ * @param node_t node [IN] - Index of the node
+ * @return std::string - Name of the Waypoint
+ */
+std::string CContractionHierarchy::getNodeName(node_t node) const
+{
+  return std::string(m_pNameHeap + m_pNameOffsets[node],
+                     m_pNameOffsets[node + 1] - m_pNameOffsets[node]);
+}
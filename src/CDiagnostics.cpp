@@ -0,0 +1,340 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDiagnostics.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CDiagnostics, CConsoleSink and CRingBufferSink
+****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <nsp/CDiagnostics.h>
+
+#define LOGGER_IDLE_TIME                                                       \
+  (1) /**< @brief Represents the milliseconds the logger sleeps when the ring \
+         buffer is empty */
+
+std::atomic<unsigned long> CDiagnostics::s_counts[CDiagnostics::CATEGORY_COUNT];
+std::atomic<unsigned long> CDiagnostics::s_written(0);
+std::atomic<int> CDiagnostics::s_loadDepth(0);
+std::atomic<unsigned long>
+    CDiagnostics::s_sampleLimit(DIAGNOSTIC_SAMPLE_LIMIT);
+std::atomic<unsigned long>
+    CDiagnostics::s_sampleInterval(DIAGNOSTIC_SAMPLE_INTERVAL);
+std::atomic<CDiagnosticSink *> CDiagnostics::s_pSink(NULL);
+
+/**
+ * Gets the sink which prints to std::cout
+ * @param None
+ * @return CDiagnosticSink& - The console sink
+ */
+static CDiagnosticSink &getConsoleSink(void)
+{
+  static CConsoleSink s_consoleSink;
+  return s_consoleSink;
+}
+/**
+ * Gets the sink of the messages
+ * @param CDiagnosticSink* pSink [IN] - The set sink, NULL for the console
+ * @return CDiagnosticSink& - The sink to be written to
+ */
+static CDiagnosticSink &getSink(CDiagnosticSink *pSink)
+{
+  return (NULL != pSink) ? *pSink : getConsoleSink();
+}
+/**
+ * Counts a diagnostic of the category and decides if its message is
+ * written. Callers which compose the message only do so if it is.
+ * @param category_t category [IN] - The category of the diagnostic
+ * @return true if the message is to be written (see write()), false if it
+ * is only counted
+ */
+bool CDiagnostics::count(category_t category)
+{
+  if ((category < 0) || (category >= NOTICE))
+  {
+    return true;
+  }
+  unsigned long number =
+      s_counts[category].fetch_add(1, std::memory_order_relaxed) + 1;
+  if (0 == s_loadDepth.load(std::memory_order_relaxed))
+  {
+    return true;
+  }
+  unsigned long limit = s_sampleLimit.load(std::memory_order_relaxed);
+  unsigned long interval = s_sampleInterval.load(std::memory_order_relaxed);
+  if ((number <= limit) ||
+      ((0 != interval) && (0 == (number - limit) % interval)))
+  {
+    s_written.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+/**
+ * Writes the message of a counted diagnostic to the sink
+ * @param category_t category [IN] - The category of the diagnostic
+ * @param std::string_view message [IN] - The message without line break
+ * @return None
+ */
+void CDiagnostics::write(category_t category, std::string_view message)
+{
+  getSink(s_pSink.load(std::memory_order_acquire)).write(category, message);
+}
+/**
+ * Sets the sink of the messages. The sink is used until another one is
+ * set and must not be set while a diagnostic is reported.
+ * @param CDiagnosticSink* pSink [IN] - The sink, NULL for the console
+ * @return None
+ */
+void CDiagnostics::setSink(CDiagnosticSink *pSink)
+{
+  getSink(s_pSink.load()).flush();
+  s_pSink.store(pSink, std::memory_order_release);
+}
+/**
+ * Sets how many messages of a category are written during a load
+ * @param unsigned long limit [IN] - Messages written in full
+ * @param unsigned long interval [IN] - Every how many messages one is
+ * written after the limit, 0 writes none
+ * @return None
+ */
+void CDiagnostics::setSampling(unsigned long limit, unsigned long interval)
+{
+  s_sampleLimit.store(limit);
+  s_sampleInterval.store(interval);
+}
+/**
+ * Gets the diagnostics of a category counted since the start of the last
+ * load (or the program)
+ * @param category_t category [IN] - The category
+ * @return unsigned long - The number of diagnostics
+ */
+unsigned long CDiagnostics::getCount(category_t category)
+{
+  if ((category < 0) || (category >= NOTICE))
+  {
+    return 0;
+  }
+  return s_counts[category].load();
+}
+/**
+ * Gets the name of a category in plural, as used in the summary
+ * @param category_t category [IN] - The category
+ * @return const char* - The name
+ */
+const char *CDiagnostics::getCategoryName(category_t category)
+{
+  switch (category)
+  {
+  case DUPLICATE_ENTRY:
+    return "duplicate entries";
+  case MISSING_ENTRY:
+    return "missing entries";
+  case INVALID_RECORD:
+    return "invalid records";
+  case INVALID_VALUE:
+    return "invalid values";
+  case INVALID_JSON:
+    return "JSON errors";
+  case STORAGE_ERROR:
+    return "storage errors";
+  case NOTICE:
+    return "notices";
+  default:
+    return "unknown diagnostics";
+  }
+}
+/**
+ * Starts a load: the counters are reset and the messages are sampled.
+ * Nested loads belong to the outermost one.
+ * @param None
+ * @return None
+ */
+void CDiagnostics::beginLoad(void)
+{
+  if (0 == s_loadDepth.fetch_add(1))
+  {
+    for (int category = 0; category < NOTICE; category++)
+    {
+      s_counts[category].store(0);
+    }
+    s_written.store(0);
+  }
+}
+/**
+ * Ends a load. The outermost load writes a summary of the counted
+ * diagnostics, if there are any, and flushes the sink.
+ * @param std::string_view loadName [IN] - Name of the load in the summary
+ * @return None
+ */
+void CDiagnostics::endLoad(std::string_view loadName)
+{
+  if (1 != s_loadDepth.fetch_sub(1))
+  {
+    return;
+  }
+  std::string summary;
+  unsigned long total = 0;
+  for (int category = 0; category < NOTICE; category++)
+  {
+    unsigned long number = s_counts[category].load();
+    if (0 != number)
+    {
+      summary += summary.empty() ? ": " : ", ";
+      summary += std::to_string(number) + " ";
+      summary += getCategoryName((category_t)category);
+      total += number;
+    }
+  }
+  CDiagnosticSink &sink = getSink(s_pSink.load(std::memory_order_acquire));
+  if (0 != total)
+  {
+    unsigned long suppressed = total - std::min(total, s_written.load());
+    summary = "SUMMARY!" + std::string(loadName) + summary;
+    if (0 != suppressed)
+    {
+      summary += " (" + std::to_string(suppressed) + " messages not shown)";
+    }
+    sink.write(NOTICE, summary);
+  }
+  sink.flush();
+}
+/**
+ * Prints the message as a line of the output
+ * @param CDiagnostics::category_t category [IN] - The category
+ * @param std::string_view message [IN] - The message without line break
+ * @return None
+ */
+void CConsoleSink::write(CDiagnostics::category_t /*category*/,
+                         std::string_view message)
+{
+  m_out << message << std::endl;
+}
+/**
+ * Rounds the number of slots up to a power of 2
+ * @param size_t slots [IN] - The requested slots
+ * @return size_t - The slots of the ring buffer
+ */
+static size_t roundUpSlots(size_t slots)
+{
+  size_t roundedSlots = 2;
+  while (roundedSlots < slots)
+  {
+    roundedSlots <<= 1;
+  }
+  return roundedSlots;
+}
+
+CRingBufferSink::CRingBufferSink(std::ostream &out, size_t slots)
+    : m_out(out), m_slots(roundUpSlots(slots)), m_mask(m_slots.size() - 1),
+      m_enqueuePos(0), m_printedPos(0), m_dropped(0), m_isStopping(false)
+{
+  for (size_t slot = 0; slot < m_slots.size(); slot++)
+  {
+    m_slots[slot].sequence.store(slot, std::memory_order_relaxed);
+  }
+  m_loggerThread = std::thread(&CRingBufferSink::loggerThreadMain, this);
+}
+
+CRingBufferSink::~CRingBufferSink()
+{
+  m_isStopping.store(true, std::memory_order_release);
+  m_loggerThread.join();
+}
+/**
+ * Copies the message into the next free slot without waiting for a lock.
+ * Every slot is free for the producer whose position equals its sequence
+ * and filled for the logger when its sequence is the position + 1.
+ * @param CDiagnostics::category_t category [IN] - The category
+ * @param std::string_view message [IN] - The message without line break
+ * @return None
+ */
+void CRingBufferSink::write(CDiagnostics::category_t /*category*/,
+                            std::string_view message)
+{
+  size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+  slot_t *pSlot = NULL;
+  for (;;)
+  {
+    pSlot = &m_slots[position & m_mask];
+    intptr_t difference =
+        (intptr_t)pSlot->sequence.load(std::memory_order_acquire) -
+        (intptr_t)position;
+    if (0 == difference)
+    {
+      /* The slot is free, reserve it unless another producer was faster */
+      if (m_enqueuePos.compare_exchange_weak(position, position + 1,
+                                             std::memory_order_relaxed))
+        break;
+    }
+    else if (difference < 0)
+    {
+      /* The logger has not printed the slot of the last round yet */
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+    {
+      position = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  size_t length = std::min(message.size(), (size_t)DIAGNOSTIC_TEXT_LENGTH);
+  memcpy(pSlot->text, message.data(), length);
+  pSlot->length = (unsigned short)length;
+  pSlot->sequence.store(position + 1, std::memory_order_release);
+}
+/**
+ * Waits until the logger has printed every message written before
+ * @param None
+ * @return None
+ */
+void CRingBufferSink::flush(void)
+{
+  size_t position = m_enqueuePos.load(std::memory_order_acquire);
+  while (m_printedPos.load(std::memory_order_acquire) < position)
+  {
+    std::this_thread::yield();
+  }
+}
+/**
+ * Prints the filled slots until the sink is destroyed
+ * @param None
+ * @return None
+ */
+void CRingBufferSink::loggerThreadMain(void)
+{
+  size_t position = 0;
+  for (;;)
+  {
+    bool isStopping = m_isStopping.load(std::memory_order_acquire);
+    size_t firstPosition = position;
+    for (;;)
+    {
+      slot_t &slot = m_slots[position & m_mask];
+      if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+        break;
+      m_out.write(slot.text, slot.length);
+      m_out.put('\n');
+      /* Free the slot for the producer of the next round */
+      slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+      position++;
+    }
+    if (position != firstPosition)
+    {
+      m_out.flush();
+      m_printedPos.store(position, std::memory_order_release);
+    }
+    else if (isStopping)
+    {
+      break;
+    }
+    else
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(LOGGER_IDLE_TIME));
+    }
+  }
+}
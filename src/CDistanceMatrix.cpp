@@ -0,0 +1,349 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CDistanceMatrix.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CDistanceMatrix
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_WIDTH (4) /**< @brief Represents the doubles per register */
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_WIDTH (2) /**< @brief Represents the doubles per register */
+#else
+#define SIMD_WIDTH (1) /**< @brief Represents the scalar fallback */
+#endif
+
+#include <nsp/CDistanceMatrix.h>
+#include <nsp/GeoMath.h>
+
+#define TILE_SIZE (64) /**< @brief Represents the rows and columns of a tile,
+                          a tile of doubles fills 32 kB */
+#define TILE_GRAIN (4) /**< @brief Represents the tiles per task */
+#define HALF_PI (1.57079632679489661923) /**< @brief Represents PI / 2 */
+
+/* Coefficients of the rational approximation of asin, taken from fdlibm:
+ * asin(s) = s + s * t * P(t) / Q(t) with t = s * s and |s| <= 0.5 */
+#define ASIN_P0 (1.66666666666666657415e-01)
+#define ASIN_P1 (-3.25565818622400915405e-01)
+#define ASIN_P2 (2.01212532134862925881e-01)
+#define ASIN_P3 (-4.00555345006794114027e-02)
+#define ASIN_P4 (7.91534994289814532176e-04)
+#define ASIN_P5 (3.47933107596021167570e-05)
+#define ASIN_Q1 (-2.40339491173441421878e+00)
+#define ASIN_Q2 (2.02094576023350569471e+00)
+#define ASIN_Q3 (-6.88283971605453293030e-01)
+#define ASIN_Q4 (7.70381505559019352791e-02)
+
+/**
+ * Converts the squared chord length of two unit vectors into the distance
+ * of the two points. With s = chord / 2 the angle is 2 * asin(s). Above
+ * s = 0.5 the identity asin(s) = PI / 2 - 2 * asin(sqrt((1 - s) / 2)) keeps
+ * the argument of the approximation small. Rounding may make the chord of
+ * antipodal points longer than the diameter, so s is clamped to 1.
+ * @param double chordSquared [IN] - Squared chord length
+ * @return double - Distance in kilometers
+ */
+static inline double chordToDistance(double chordSquared)
+{
+  double s = std::min(1.0, sqrt(chordSquared * 0.25));
+  bool isLarge = (s > 0.5);
+  double t = isLarge ? (1 - s) * 0.5 : s * s;
+  double root = isLarge ? sqrt(t) : s;
+  double p = t * (ASIN_P0 +
+                  t * (ASIN_P1 +
+                       t * (ASIN_P2 + t * (ASIN_P3 + t * (ASIN_P4 +
+                                                          t * ASIN_P5)))));
+  double q = 1 + t * (ASIN_Q1 + t * (ASIN_Q2 + t * (ASIN_Q3 + t * ASIN_Q4)));
+  double w = root + root * (p / q);
+  double angle = isLarge ? (HALF_PI - 2 * w) : w;
+  return (2 * EARTH_RADIUS_LENGTH) * angle;
+}
+
+#if SIMD_WIDTH > 1
+/* Thin wrappers which let one kernel serve both instruction sets */
+#if defined(__AVX2__)
+typedef __m256d vector_t;
+static inline vector_t vectorLoad(const double *p)
+{
+  return _mm256_loadu_pd(p);
+}
+static inline vector_t vectorSet(double value) { return _mm256_set1_pd(value); }
+static inline vector_t vectorAdd(vector_t a, vector_t b)
+{
+  return _mm256_add_pd(a, b);
+}
+static inline vector_t vectorSub(vector_t a, vector_t b)
+{
+  return _mm256_sub_pd(a, b);
+}
+static inline vector_t vectorMul(vector_t a, vector_t b)
+{
+  return _mm256_mul_pd(a, b);
+}
+static inline vector_t vectorDiv(vector_t a, vector_t b)
+{
+  return _mm256_div_pd(a, b);
+}
+static inline vector_t vectorSqrt(vector_t a) { return _mm256_sqrt_pd(a); }
+static inline vector_t vectorMin(vector_t a, vector_t b)
+{
+  return _mm256_min_pd(a, b);
+}
+static inline vector_t vectorGreater(vector_t a, vector_t b)
+{
+  return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+}
+/** Takes a where the mask is set, b elsewhere */
+static inline vector_t vectorSelect(vector_t mask, vector_t a, vector_t b)
+{
+  return _mm256_blendv_pd(b, a, mask);
+}
+static inline void vectorStore(double *p, vector_t a)
+{
+  _mm256_storeu_pd(p, a);
+}
+static inline void vectorStore(float *p, vector_t a)
+{
+  _mm_storeu_ps(p, _mm256_cvtpd_ps(a));
+}
+#else
+typedef __m128d vector_t;
+static inline vector_t vectorLoad(const double *p) { return _mm_loadu_pd(p); }
+static inline vector_t vectorSet(double value) { return _mm_set1_pd(value); }
+static inline vector_t vectorAdd(vector_t a, vector_t b)
+{
+  return _mm_add_pd(a, b);
+}
+static inline vector_t vectorSub(vector_t a, vector_t b)
+{
+  return _mm_sub_pd(a, b);
+}
+static inline vector_t vectorMul(vector_t a, vector_t b)
+{
+  return _mm_mul_pd(a, b);
+}
+static inline vector_t vectorDiv(vector_t a, vector_t b)
+{
+  return _mm_div_pd(a, b);
+}
+static inline vector_t vectorSqrt(vector_t a) { return _mm_sqrt_pd(a); }
+static inline vector_t vectorMin(vector_t a, vector_t b)
+{
+  return _mm_min_pd(a, b);
+}
+static inline vector_t vectorGreater(vector_t a, vector_t b)
+{
+  return _mm_cmpgt_pd(a, b);
+}
+/** Takes a where the mask is set, b elsewhere */
+static inline vector_t vectorSelect(vector_t mask, vector_t a, vector_t b)
+{
+  return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+static inline void vectorStore(double *p, vector_t a) { _mm_storeu_pd(p, a); }
+static inline void vectorStore(float *p, vector_t a)
+{
+  _mm_storel_pi(reinterpret_cast<__m64 *>(p), _mm_cvtpd_ps(a));
+}
+#endif
+/**
+ * Vector version of chordToDistance, both branches are computed and the
+ * lanes pick their result
+ * @param vector_t chordSquared [IN] - Squared chord lengths
+ * @return vector_t - Distances in kilometers
+ */
+static inline vector_t chordToDistance(vector_t chordSquared)
+{
+  vector_t half = vectorSet(0.5);
+  vector_t s = vectorMin(vectorSqrt(vectorMul(chordSquared, vectorSet(0.25))),
+                         vectorSet(1));
+  vector_t isLarge = vectorGreater(s, half);
+  vector_t t = vectorSelect(
+      isLarge, vectorMul(vectorSub(vectorSet(1), s), half), vectorMul(s, s));
+  vector_t root = vectorSelect(isLarge, vectorSqrt(t), s);
+  vector_t p =
+      vectorAdd(vectorSet(ASIN_P4), vectorMul(t, vectorSet(ASIN_P5)));
+  p = vectorAdd(vectorSet(ASIN_P3), vectorMul(t, p));
+  p = vectorAdd(vectorSet(ASIN_P2), vectorMul(t, p));
+  p = vectorAdd(vectorSet(ASIN_P1), vectorMul(t, p));
+  p = vectorMul(t, vectorAdd(vectorSet(ASIN_P0), vectorMul(t, p)));
+  vector_t q =
+      vectorAdd(vectorSet(ASIN_Q3), vectorMul(t, vectorSet(ASIN_Q4)));
+  q = vectorAdd(vectorSet(ASIN_Q2), vectorMul(t, q));
+  q = vectorAdd(vectorSet(ASIN_Q1), vectorMul(t, q));
+  q = vectorAdd(vectorSet(1), vectorMul(t, q));
+  vector_t w = vectorAdd(root, vectorMul(root, vectorDiv(p, q)));
+  vector_t angle = vectorSelect(
+      isLarge, vectorSub(vectorSet(HALF_PI), vectorAdd(w, w)), w);
+  return vectorMul(vectorSet(2 * EARTH_RADIUS_LENGTH), angle);
+}
+#endif
+
+/**
+ * Computes one tile of the matrix. The columns of a row are processed a
+ * register at a time, the remaining columns one by one.
+ * @param const double* x, y, z [IN] - The unit vectors
+ * @param size_t count [IN] - Number of points (row length)
+ * @param size_t rowBegin, rowEnd [IN] - Rows of the tile
+ * @param size_t columnBegin, columnEnd [IN] - Columns of the tile
+ * @param output_t* matrix [OUT] - The matrix
+ * @return None
+ */
+template <typename output_t>
+static void computeTile(const double *x, const double *y, const double *z,
+                        size_t count, size_t rowBegin, size_t rowEnd,
+                        size_t columnBegin, size_t columnEnd,
+                        output_t *matrix)
+{
+  for (size_t row = rowBegin; row < rowEnd; row++)
+  {
+    output_t *pRow = matrix + row * count;
+    size_t column = columnBegin;
+#if SIMD_WIDTH > 1
+    vector_t rowX = vectorSet(x[row]);
+    vector_t rowY = vectorSet(y[row]);
+    vector_t rowZ = vectorSet(z[row]);
+    for (; column + SIMD_WIDTH <= columnEnd; column += SIMD_WIDTH)
+    {
+      vector_t dx = vectorSub(vectorLoad(x + column), rowX);
+      vector_t dy = vectorSub(vectorLoad(y + column), rowY);
+      vector_t dz = vectorSub(vectorLoad(z + column), rowZ);
+      vector_t chordSquared = vectorAdd(
+          vectorAdd(vectorMul(dx, dx), vectorMul(dy, dy)), vectorMul(dz, dz));
+      vectorStore(pRow + column, chordToDistance(chordSquared));
+    }
+#endif
+    for (; column < columnEnd; column++)
+    {
+      double dx = x[column] - x[row];
+      double dy = y[column] - y[row];
+      double dz = z[column] - z[row];
+      pRow[column] = (output_t)chordToDistance(dx * dx + dy * dy + dz * dz);
+    }
+  }
+}
+/**
+ * Copies a tile above the diagonal into its transposed position below the
+ * diagonal
+ * @param size_t count [IN] - Number of points (row length)
+ * @param size_t rowBegin, rowEnd [IN] - Rows of the tile
+ * @param size_t columnBegin, columnEnd [IN] - Columns of the tile
+ * @param output_t* matrix [IN/OUT] - The matrix
+ * @return None
+ */
+template <typename output_t>
+static void mirrorTile(size_t count, size_t rowBegin, size_t rowEnd,
+                       size_t columnBegin, size_t columnEnd,
+                       output_t *matrix)
+{
+  for (size_t column = columnBegin; column < columnEnd; column++)
+  {
+    output_t *pTarget = matrix + column * count;
+    for (size_t row = rowBegin; row < rowEnd; row++)
+    {
+      pTarget[row] = matrix[row * count + column];
+    }
+  }
+}
+
+/**
+ * Constructor of CDistanceMatrix class
+ * @param CThreadPool& pool [IN] - The pool which computes the matrix
+ */
+CDistanceMatrix::CDistanceMatrix(CThreadPool &pool) : m_pPool(&pool) {}
+/**
+ * Sets the points of the matrix and converts them into unit vectors
+ * @param const std::vector<const CWaypoint*>& points [IN] - The points
+ * @return None
+ */
+void CDistanceMatrix::setPoints(const std::vector<const CWaypoint *> &points)
+{
+  m_x.resize(points.size());
+  m_y.resize(points.size());
+  m_z.resize(points.size());
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    double vector[3] = {0, 0, 0};
+    if (NULL != points[i])
+    {
+      geo_math::toUnitVector(points[i]->getLatitude(),
+                             points[i]->getLongitude(), vector);
+    }
+    m_x[i] = vector[0];
+    m_y[i] = vector[1];
+    m_z[i] = vector[2];
+  }
+}
+/**
+ * Computes the matrix. Every task computes a few tiles on or above the
+ * diagonal and mirrors them. The tasks write disjoint parts of the
+ * matrix, hence no locking is needed.
+ * @param output_t* matrix [OUT] - The matrix
+ * @return None
+ */
+template <typename output_t>
+void CDistanceMatrix::computeMatrix(output_t *matrix) const
+{
+  size_t count = getPointCount();
+  size_t tiles = (count + TILE_SIZE - 1) / TILE_SIZE;
+  std::vector<std::pair<size_t, size_t> > upperTiles;
+  upperTiles.reserve(tiles * (tiles + 1) / 2);
+  for (size_t tileRow = 0; tileRow < tiles; tileRow++)
+  {
+    for (size_t tileColumn = tileRow; tileColumn < tiles; tileColumn++)
+    {
+      upperTiles.push_back(std::make_pair(tileRow, tileColumn));
+    }
+  }
+  const double *x = m_x.data(), *y = m_y.data(), *z = m_z.data();
+  m_pPool->parallelFor(
+      upperTiles.size(), TILE_GRAIN,
+      [&](size_t begin, size_t end, unsigned int) {
+        for (size_t tile = begin; tile < end; tile++)
+        {
+          size_t rowBegin = upperTiles[tile].first * TILE_SIZE;
+          size_t rowEnd = std::min(count, rowBegin + TILE_SIZE);
+          size_t columnBegin = upperTiles[tile].second * TILE_SIZE;
+          size_t columnEnd = std::min(count, columnBegin + TILE_SIZE);
+          computeTile(x, y, z, count, rowBegin, rowEnd, columnBegin,
+                      columnEnd, matrix);
+          if (rowBegin != columnBegin)
+          {
+            mirrorTile(count, rowBegin, rowEnd, columnBegin, columnEnd,
+                       matrix);
+          }
+        }
+      });
+}
+/**
+ * Computes the distances between all pairs of points
+ * @param double* matrix [OUT] - getPointCount()^2 distances in kilometers
+ * @return None
+ */
+void CDistanceMatrix::compute(double *matrix) const { computeMatrix(matrix); }
+/**
+ * Computes the distances between all pairs of points in single precision
+ * @param float* matrix [OUT] - getPointCount()^2 distances in kilometers
+ * @return None
+ */
+void CDistanceMatrix::compute(float *matrix) const { computeMatrix(matrix); }
+/**
+ * Gets the distance of a single pair, computed like the matrix entries
+ * @param size_t from [IN] - Index of the first point
+ * @param size_t to [IN] - Index of the second point
+ * @return double - Distance in kilometers
+ */
+double CDistanceMatrix::getDistance(size_t from, size_t to) const
+{
+  double dx = m_x[to] - m_x[from];
+  double dy = m_y[to] - m_y[from];
+  double dz = m_z[to] - m_z[from];
+  return chordToDistance(dx * dx + dy * dy + dz * dz);
+}
@@ -0,0 +1,359 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CHierarchyRouteFinder.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CHierarchyRouteFinder
+****************************************************************************/
+#include <algorithm>
+#include <functional>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CHierarchyRouteFinder.h>
+
+/**
+ * Constructor of CHierarchyRouteFinder class
+ * @param const CContractionHierarchy& hierarchy [IN] - The hierarchy to be
+ * searched. It must outlive the CHierarchyRouteFinder object.
+ */
+CHierarchyRouteFinder::CHierarchyRouteFinder(
+    const CContractionHierarchy &hierarchy)
+    : m_pHierarchy(&hierarchy), m_currentStamp(0), m_settledNodes(0)
+{
+}
+/**
+ * Prepares the search state for a new query. The per node arrays are only
+ * cleared when the hierarchy has changed its size or the stamp counter
+ * wraps around.
+ * @param None
+ * @return None
+ */
+void CHierarchyRouteFinder::startQuery(void)
+{
+  node_t nodeCount = m_pHierarchy->getNodeCount();
+  searchDirection_t *directions[2] = {&m_forward, &m_backward};
+  bool isReset = (m_forward.visitStamp.size() != nodeCount);
+  if (!isReset && (0 == ++m_currentStamp)) /* Stamp counter wrapped around */
+  {
+    isReset = true;
+  }
+  for (int i = 0; i < 2; i++)
+  {
+    if (isReset)
+    {
+      directions[i]->cost.assign(nodeCount, 0);
+      directions[i]->parent.assign(nodeCount, CRoutingGraph::INVALID_NODE);
+      directions[i]->parentEdge.assign(nodeCount, 0);
+      directions[i]->visitStamp.assign(nodeCount, 0);
+    }
+    directions[i]->openList.clear();
+  }
+  if (isReset)
+  {
+    m_currentStamp = 1;
+  }
+  m_settledNodes = 0;
+}
+/**
+ * Runs the bidirectional search between two different nodes.
+ * Both searches are advanced alternately, always the one with the smaller
+ * open list minimum. Whenever a node is settled which the other search has
+ * reached, the path through this node is a candidate. A search stops once
+ * its open list minimum is not shorter than the best candidate.
+ * @param node_t source [IN] - Start node
+ * @param node_t target [IN] - Destination node
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return node_t - The most important node of the shortest path, or
+ * INVALID_NODE if there is no path
+ */
+CHierarchyRouteFinder::node_t
+CHierarchyRouteFinder::search(node_t source, node_t target, double &distance)
+{
+  startQuery();
+
+  const CContractionHierarchy &hierarchy = *m_pHierarchy;
+  std::greater<queueEntry_t> heapOrder; /* Min-heap on path length */
+  searchDirection_t *directions[2] = {&m_forward, &m_backward};
+  node_t starts[2] = {source, target};
+  for (int i = 0; i < 2; i++)
+  {
+    directions[i]->cost[starts[i]] = 0;
+    directions[i]->parent[starts[i]] = CRoutingGraph::INVALID_NODE;
+    directions[i]->visitStamp[starts[i]] = m_currentStamp;
+    directions[i]->openList.push_back(queueEntry_t(0, starts[i]));
+  }
+
+  double bestDistance = 0;
+  node_t meetingNode = CRoutingGraph::INVALID_NODE;
+  while (true)
+  {
+    bool isActive[2];
+    for (int i = 0; i < 2; i++)
+    {
+      isActive[i] = !directions[i]->openList.empty() &&
+                    ((CRoutingGraph::INVALID_NODE == meetingNode) ||
+                     (directions[i]->openList.front().first < bestDistance));
+    }
+    if (!isActive[0] && !isActive[1])
+      break;
+    int current = (isActive[0] &&
+                   (!isActive[1] || (m_forward.openList.front().first <=
+                                     m_backward.openList.front().first)))
+                      ? 0
+                      : 1;
+    searchDirection_t &search = *directions[current];
+    const searchDirection_t &other = *directions[1 - current];
+
+    std::pop_heap(search.openList.begin(), search.openList.end(), heapOrder);
+    double cost = search.openList.back().first;
+    node_t node = search.openList.back().second;
+    search.openList.pop_back();
+    if (cost > search.cost[node]) /* Outdated entry */
+      continue;
+    m_settledNodes++;
+
+    if ((other.visitStamp[node] == m_currentStamp) &&
+        ((CRoutingGraph::INVALID_NODE == meetingNode) ||
+         (cost + other.cost[node] < bestDistance)))
+    {
+      bestDistance = cost + other.cost[node];
+      meetingNode = node;
+    }
+    if (isStalled(current, node, cost))
+      continue;
+    edge_t begin = (0 == current) ? hierarchy.getUpBegin(node)
+                                  : hierarchy.getDownBegin(node);
+    edge_t end = (0 == current) ? hierarchy.getUpEnd(node)
+                                : hierarchy.getDownEnd(node);
+    for (edge_t edge = begin; edge < end; edge++)
+    {
+      const CContractionHierarchy::hierarchyEdge_t &hierarchyEdge =
+          (0 == current) ? hierarchy.getUpEdge(edge)
+                         : hierarchy.getDownEdge(edge);
+      node_t next = hierarchyEdge.target;
+      double nextCost = cost + hierarchyEdge.weight;
+      if ((search.visitStamp[next] != m_currentStamp) ||
+          (nextCost < search.cost[next]))
+      {
+        search.visitStamp[next] = m_currentStamp;
+        search.cost[next] = nextCost;
+        search.parent[next] = node;
+        search.parentEdge[next] = edge;
+        search.openList.push_back(queueEntry_t(nextCost, next));
+        std::push_heap(search.openList.begin(), search.openList.end(),
+                       heapOrder);
+      }
+    }
+  }
+  distance = bestDistance;
+  return meetingNode;
+}
+/**
+ * Searches the shortest path between two nodes
+ * @param node_t source [IN] - Start node
+ * @param node_t target [IN] - Destination node
+ * @param std::vector<node_t>& path [OUT] - The nodes of the path,
+ * including source and target
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return true if a path is found, false otherwise
+ */
+bool CHierarchyRouteFinder::findPath(node_t source, node_t target,
+                                     std::vector<node_t> &path,
+                                     double &distance)
+{
+  path.clear();
+  if ((source >= m_pHierarchy->getNodeCount()) ||
+      (target >= m_pHierarchy->getNodeCount()))
+  {
+    return false;
+  }
+  if (source == target)
+  {
+    path.push_back(source);
+    distance = 0;
+    return true;
+  }
+  node_t meetingNode = search(source, target, distance);
+  if (CRoutingGraph::INVALID_NODE == meetingNode)
+  {
+    return false;
+  }
+  const CContractionHierarchy &hierarchy = *m_pHierarchy;
+
+  /* Forward part: walk back from the meeting node to the source */
+  std::vector<node_t> upwardNodes;
+  for (node_t node = meetingNode; CRoutingGraph::INVALID_NODE != node;
+       node = m_forward.parent[node])
+  {
+    upwardNodes.push_back(node);
+  }
+  path.push_back(source);
+  for (size_t i = upwardNodes.size() - 1; i > 0; i--)
+  {
+    node_t node = upwardNodes[i - 1];
+    unpackEdge(upwardNodes[i], node,
+               hierarchy.getUpEdge(m_forward.parentEdge[node]).middle, path);
+  }
+  /* Backward part: the predecessors lead from the meeting node down to the
+   * target */
+  for (node_t node = meetingNode;
+       CRoutingGraph::INVALID_NODE != m_backward.parent[node];
+       node = m_backward.parent[node])
+  {
+    unpackEdge(node, m_backward.parent[node],
+               hierarchy.getDownEdge(m_backward.parentEdge[node]).middle,
+               path);
+  }
+  return true;
+}
+/**
+ * Searches the length of the shortest path between two nodes. The path
+ * itself is not unpacked.
+ * @param node_t source [IN] - Start node
+ * @param node_t target [IN] - Destination node
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return true if a path is found, false otherwise
+ */
+bool CHierarchyRouteFinder::findDistance(node_t source, node_t target,
+                                         double &distance)
+{
+  if ((source >= m_pHierarchy->getNodeCount()) ||
+      (target >= m_pHierarchy->getNodeCount()))
+  {
+    return false;
+  }
+  if (source == target)
+  {
+    distance = 0;
+    return true;
+  }
+  return (CRoutingGraph::INVALID_NODE != search(source, target, distance));
+}
+/**
+ * Checks if a settled node can be reached on a shorter path through a more
+ * important node which the same search has already reached (stall on
+ * demand). The path found so far is then not a shortest path and the edges
+ * of the node need not be relaxed. The edges which lead into a node from a
+ * more important node are the opposite list of the node, e.g. the downward
+ * edges for the forward search.
+ * @param int direction [IN] - 0 for the forward, 1 for the backward search
+ * @param node_t node [IN] - The settled node
+ * @param double cost [IN] - Path length of the node in this search
+ * @return true if the node is stalled, false otherwise
+ */
+bool CHierarchyRouteFinder::isStalled(int direction, node_t node,
+                                      double cost) const
+{
+  const CContractionHierarchy &hierarchy = *m_pHierarchy;
+  const searchDirection_t &search = (0 == direction) ? m_forward : m_backward;
+  edge_t begin = (0 == direction) ? hierarchy.getDownBegin(node)
+                                  : hierarchy.getUpBegin(node);
+  edge_t end = (0 == direction) ? hierarchy.getDownEnd(node)
+                                : hierarchy.getUpEnd(node);
+  for (edge_t edge = begin; edge < end; edge++)
+  {
+    const CContractionHierarchy::hierarchyEdge_t &hierarchyEdge =
+        (0 == direction) ? hierarchy.getDownEdge(edge)
+                         : hierarchy.getUpEdge(edge);
+    node_t other = hierarchyEdge.target;
+    if ((search.visitStamp[other] == m_currentStamp) &&
+        (search.cost[other] + hierarchyEdge.weight < cost))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+/**
+ * Appends the original nodes of an edge to the path. A shortcut from -> to
+ * bypassing middle consists of the edges from -> middle and middle -> to.
+ * The middle node is less important than both ends, hence these edges are
+ * a downward and an upward edge of the middle node.
+ * @param node_t from [IN] - Start of the edge, already on the path
+ * @param node_t to [IN] - End of the edge
+ * @param node_t middle [IN] - Bypassed node or INVALID_NODE
+ * @param std::vector<node_t>& path [OUT] - The path
+ * @return None
+ */
+void CHierarchyRouteFinder::unpackEdge(node_t from, node_t to, node_t middle,
+                                       std::vector<node_t> &path)
+{
+  const CContractionHierarchy &hierarchy = *m_pHierarchy;
+  unpackEntry_t entry = {from, to, middle};
+  m_unpackStack.clear();
+  m_unpackStack.push_back(entry);
+  while (!m_unpackStack.empty())
+  {
+    entry = m_unpackStack.back();
+    m_unpackStack.pop_back();
+    if (CRoutingGraph::INVALID_NODE == entry.middle)
+    {
+      path.push_back(entry.to);
+      continue;
+    }
+    unpackEntry_t first = {entry.from, entry.middle,
+                           CRoutingGraph::INVALID_NODE};
+    unpackEntry_t second = {entry.middle, entry.to,
+                            CRoutingGraph::INVALID_NODE};
+    for (edge_t edge = hierarchy.getDownBegin(entry.middle);
+         edge < hierarchy.getDownEnd(entry.middle); edge++)
+    {
+      if (hierarchy.getDownEdge(edge).target == entry.from)
+      {
+        first.middle = hierarchy.getDownEdge(edge).middle;
+        break;
+      }
+    }
+    for (edge_t edge = hierarchy.getUpBegin(entry.middle);
+         edge < hierarchy.getUpEnd(entry.middle); edge++)
+    {
+      if (hierarchy.getUpEdge(edge).target == entry.to)
+      {
+        second.middle = hierarchy.getUpEdge(edge).middle;
+        break;
+      }
+    }
+    /* The first half is processed first */
+    m_unpackStack.push_back(second);
+    m_unpackStack.push_back(first);
+  }
+}
+/**
+ * Searches the shortest path between two Waypoints and appends the
+ * Waypoints of the path to the route.
+ * @param const std::string& from [IN] - Name of the start Waypoint
+ * @param const std::string& to [IN] - Name of the destination Waypoint
+ * @param CRoute& route [OUT] - The route the path is appended to
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return true if a path is found, false otherwise
+ */
+bool CHierarchyRouteFinder::findRoute(const std::string &from,
+                                      const std::string &to, CRoute &route,
+                                      double &distance)
+{
+  node_t source = CRoutingGraph::INVALID_NODE;
+  node_t target = CRoutingGraph::INVALID_NODE;
+  if (!m_pHierarchy->getNode(from, source) ||
+      !m_pHierarchy->getNode(to, target))
+  {
+    CDiagnostics::report(CDiagnostics::MISSING_ENTRY,
+                         "ERROR!CHierarchyRouteFinder::findRoute() failed! "
+                         "Waypoint not found in the hierarchy");
+    return false;
+  }
+  std::vector<node_t> path;
+  if (!findPath(source, target, path, distance))
+  {
+    CDiagnostics::report(CDiagnostics::MISSING_ENTRY,
+                         "ERROR!CHierarchyRouteFinder::findRoute() failed! "
+                         "No path from " +
+                             from + " to " + to);
+    return false;
+  }
+  for (std::vector<node_t>::const_iterator itr = path.begin();
+       itr != path.end(); ++itr)
+  {
+    route.addWaypoint(m_pHierarchy->getNodeName(*itr));
+  }
+  return true;
+}
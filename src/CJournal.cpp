@@ -0,0 +1,534 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJournal.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CJournal
+****************************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include <nsp/CAttributeExtractor.h>
+#include <nsp/CBufferedWriter.h>
+#include <nsp/CCSV.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CJournal.h>
+#include <nsp/CMappedFile.h>
+#include <nsp/TypeMapping.h>
+
+#define FILE_LOCATION "src/" /**< @brief Represents the journal location */
+#define JOURNAL_FILE_EXTENSION \
+  "-journal.txt" /**< @brief Represents the extension of the journal */
+#define COMPACTING_FILE_EXTENSION \
+  "-journal-compacting.txt" /**< @brief Represents the extension of the
+                                journal which is folded into the base */
+#define SNAPSHOT_MEDIA_EXTENSION \
+  "-compacting-snapshot" /**< @brief Represents the extension of the media
+                             to which a compaction writes the snapshot */
+#define DEFAULT_COMPACTION_RECORDS \
+  (10000) /**< @brief Represents the least records which start a compaction */
+
+#define WAYPOINT_RECORD 'W'        /**< @brief Represents an added Waypoint */
+#define POI_RECORD 'P'             /**< @brief Represents an added POI */
+#define REMOVE_WAYPOINT_RECORD 'w' /**< @brief Represents a removed Waypoint */
+#define REMOVE_POI_RECORD 'p'      /**< @brief Represents a removed POI */
+#define CLEAR_RECORD 'C'           /**< @brief Represents a cleared Database */
+#define FIELD_CHAR ';' /**< @brief Represents the field delimiter */
+#define COMA_CHAR ','  /**< @brief Represents the second CSV delimiter */
+#define NEW_LINE_CHAR '\n' /**< @brief Represents the end of a record */
+
+/**
+ * Flushes a file or a directory to the disk
+ * @param const std::string& path [IN] - The file or directory
+ * @return true if it is durable, false otherwise
+ */
+static bool syncPath(const std::string &path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  bool isSynced = (0 == fsync(fd));
+  return (0 == close(fd)) && isSynced;
+}
+/**
+ * Flushes new files and then renames them over the old ones. The
+ * directories are flushed as well, so the new names are durable.
+ * @param const std::vector<std::string>& newFiles [IN] - The new files
+ * @param const std::vector<std::string>& oldFiles [IN] - The replaced files
+ * @return true if every file is replaced, false otherwise
+ */
+static bool replaceFiles(const std::vector<std::string> &newFiles,
+                         const std::vector<std::string> &oldFiles)
+{
+  if (newFiles.empty() || (newFiles.size() != oldFiles.size()))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < newFiles.size(); i++)
+  {
+    if (!syncPath(newFiles[i]))
+    {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < newFiles.size(); i++)
+  {
+    size_t slash = oldFiles[i].rfind('/');
+    if ((0 != rename(newFiles[i].c_str(), oldFiles[i].c_str())) ||
+        !syncPath((std::string::npos == slash) ? std::string(".")
+                                               : oldFiles[i].substr(0, slash)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Appends the record of an added or updated Waypoint
+ * @param CBufferedWriter& journal [OUT] - The journal
+ * @param const CWaypoint& wp [IN] - The Waypoint
+ * @return true if the record is appended, false otherwise
+ */
+static bool appendRecord(CBufferedWriter &journal, const CWaypoint &wp)
+{
+  journal.append(WAYPOINT_RECORD);
+  journal.append(FIELD_CHAR);
+  CCSV::appendWaypointRecord(journal, wp);
+  return true;
+}
+/**
+ * Appends the record of an added or updated POI
+ * @param CBufferedWriter& journal [OUT] - The journal
+ * @param const CPOI& poi [IN] - The POI
+ * @return true if the record is appended, false if the POI type is invalid
+ */
+static bool appendRecord(CBufferedWriter &journal, const CPOI &poi)
+{
+  std::string poiType;
+  if (!type_mapping::convertPoiTypeToString(poi.getType(), poiType))
+  {
+    return false;
+  }
+  journal.append(POI_RECORD);
+  journal.append(FIELD_CHAR);
+  return CCSV::appendPoiRecord(journal, poi);
+}
+/**
+ * Appends the records of the changes of a Database after a sequence number
+ * @param CBufferedWriter& journal [OUT] - The journal
+ * @param const Database& db [IN] - The Waypoint or POI Database
+ * @param unsigned long sequence [IN] - The last journaled change
+ * @param char databaseType [IN] - Record type of an added entry
+ * @param char removeType [IN] - Record type of a removed entry
+ * @return size_t - Number of appended records
+ */
+template <typename Database>
+static size_t appendDatabaseChanges(CBufferedWriter &journal,
+                                    const Database &db, unsigned long sequence,
+                                    char databaseType, char removeType)
+{
+  size_t records = 0;
+  if (db.getClearSequence() > sequence)
+  {
+    journal.append(CLEAR_RECORD);
+    journal.append(FIELD_CHAR);
+    journal.append(databaseType);
+    journal.append(NEW_LINE_CHAR);
+    records++;
+  }
+  std::vector<std::string> keys;
+  db.getChangedKeys(sequence, keys);
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    /* A changed key which is not present any more was removed */
+    const auto *pData = db.findData(keys[i]);
+    if (NULL == pData)
+    {
+      journal.append(removeType);
+      journal.append(FIELD_CHAR);
+      journal.append(keys[i]);
+      journal.append(NEW_LINE_CHAR);
+      records++;
+    }
+    else if (appendRecord(journal, *pData))
+    {
+      records++;
+    }
+    else
+    {
+      CDiagnostics::report(
+          CDiagnostics::INVALID_VALUE,
+          "ERROR!CJournal::writeData() failed! Invalid POI Type!");
+    }
+  }
+  return records;
+}
+
+CJournal::CJournal(CPersistentStorage &baseStorage)
+    : m_baseStorage(baseStorage), m_journalRecords(0),
+      m_compactionRecords(DEFAULT_COMPACTION_RECORDS), m_isCompacting(false)
+{
+  m_wpSync.trackingId = m_poiSync.trackingId = 0;
+  m_wpSync.sequence = m_poiSync.sequence = 0;
+}
+
+CJournal::~CJournal() { waitForCompaction(); }
+/**
+ * Set the name of the media to be used for persistent storage. The base
+ * storage gets the same name, the journal is src/<name>-journal.txt
+ *
+ * @param name the media to be used
+ */
+void CJournal::setMediaName(std::string name)
+{
+  waitForCompaction();
+  m_baseStorage.setMediaName(name);
+  m_mediaName = name;
+  m_journalFileName = FILE_LOCATION + name + JOURNAL_FILE_EXTENSION;
+  m_compactingFileName = FILE_LOCATION + name + COMPACTING_FILE_EXTENSION;
+  m_wpSync.trackingId = m_poiSync.trackingId = 0;
+}
+/**
+ * Sets the least number of journal records which start a compaction
+ * @param size_t records [IN] - Number of records
+ * @return None
+ */
+void CJournal::setCompactionThreshold(size_t records)
+{
+  m_compactionRecords = records;
+}
+/**
+ * Write the data to the persistent storage. Only the changes are appended
+ * to the journal if the Databases are in sync with it, otherwise a new base
+ * snapshot is written.
+ *
+ * @param waypointDb the data base with way points
+ * @param poiDb the database with points of interest
+ * @return true if the data could be saved successfully
+ */
+bool CJournal::writeData(const CWpDatabase &waypointDb,
+                         const CPoiDatabase &poiDb)
+{
+  if ((0 == m_wpSync.trackingId) || (0 == m_poiSync.trackingId) ||
+      (waypointDb.getTrackingId() != m_wpSync.trackingId) ||
+      (poiDb.getTrackingId() != m_poiSync.trackingId))
+  {
+    return writeSnapshot(waypointDb, poiDb);
+  }
+  if (!appendChanges(waypointDb, poiDb))
+  {
+    /* The journal may hold a part of the changes, start over */
+    m_wpSync.trackingId = m_poiSync.trackingId = 0;
+    return false;
+  }
+  if (m_journalRecords >=
+      std::max(m_compactionRecords, (waypointDb.size() + poiDb.size()) / 2))
+  {
+    startCompaction();
+  }
+  return true;
+}
+/**
+ * Fill the databases with the data from persistent storage: the base
+ * snapshot and the journal. The Databases track their changes afterwards.
+ *
+ * @param waypointDb the the data base with way points
+ * @param poiDb the database with points of interest
+ * @param mode the merge mode
+ * @return true if the data could be read successfully
+ */
+bool CJournal::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
+                        MergeMode mode)
+{
+  waitForCompaction();
+  CDiagnosticScope load("CJournal::readData()");
+  /* Loading is no change, tracking starts afterwards */
+  waypointDb.setChangeTracking(false);
+  poiDb.setChangeTracking(false);
+  bool retVal = m_baseStorage.readData(waypointDb, poiDb, mode);
+  if (retVal)
+  {
+    /* A journal which was not folded completely is older than the journal */
+    m_journalRecords =
+        replayJournal(m_compactingFileName, waypointDb, poiDb) +
+        replayJournal(m_journalFileName, waypointDb, poiDb);
+  }
+  waypointDb.setChangeTracking(true);
+  poiDb.setChangeTracking(true);
+  m_wpSync.trackingId = m_poiSync.trackingId = 0;
+  if (retVal && (REPLACE == mode))
+  {
+    m_wpSync.trackingId = waypointDb.getTrackingId();
+    m_wpSync.sequence = waypointDb.getChangeSequence();
+    m_poiSync.trackingId = poiDb.getTrackingId();
+    m_poiSync.sequence = poiDb.getChangeSequence();
+    if (0 == access(m_compactingFileName.c_str(), F_OK))
+    {
+      /* Complete the compaction from the Databases */
+      retVal = writeSnapshot(waypointDb, poiDb);
+    }
+  }
+  return retVal;
+}
+/**
+ * Waits until a running compaction has finished
+ * @param None
+ * @return None
+ */
+void CJournal::waitForCompaction(void)
+{
+  if (m_compactionThread.joinable())
+  {
+    m_compactionThread.join();
+  }
+}
+/**
+ * Writes both Databases as a new base snapshot and removes the journal
+ * @param const CWpDatabase& waypointDb [IN] - The Waypoint Database
+ * @param const CPoiDatabase& poiDb [IN] - The POI Database
+ * @return true if the snapshot is written, false otherwise
+ */
+bool CJournal::writeSnapshot(const CWpDatabase &waypointDb,
+                             const CPoiDatabase &poiDb)
+{
+  waitForCompaction();
+  m_wpSync.trackingId = m_poiSync.trackingId = 0;
+  if (!m_baseStorage.writeData(waypointDb, poiDb))
+  {
+    return false;
+  }
+  /* The snapshot holds every journaled change, so replaying a journal which
+   * is left after a crash here changes nothing */
+  remove(m_journalFileName.c_str());
+  remove(m_compactingFileName.c_str());
+  m_journalRecords = 0;
+  m_wpSync.trackingId = waypointDb.getTrackingId();
+  m_wpSync.sequence = waypointDb.getChangeSequence();
+  m_poiSync.trackingId = poiDb.getTrackingId();
+  m_poiSync.sequence = poiDb.getChangeSequence();
+  return true;
+}
+/**
+ * Appends the changes of both Databases since the last save to the journal
+ * @param const CWpDatabase& waypointDb [IN] - The Waypoint Database
+ * @param const CPoiDatabase& poiDb [IN] - The POI Database
+ * @return true if the changes are durable in the journal, false otherwise
+ */
+bool CJournal::appendChanges(const CWpDatabase &waypointDb,
+                             const CPoiDatabase &poiDb)
+{
+  if ((waypointDb.getChangeSequence() == m_wpSync.sequence) &&
+      (poiDb.getChangeSequence() == m_poiSync.sequence))
+  {
+    return true; /* Nothing changed */
+  }
+  CBufferedWriter journal;
+  if (!journal.open(m_journalFileName, false, true))
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CJournal::writeData() failed: Unable to open " +
+                             m_journalFileName);
+    return false;
+  }
+  size_t records =
+      appendDatabaseChanges(journal, waypointDb, m_wpSync.sequence,
+                            WAYPOINT_RECORD, REMOVE_WAYPOINT_RECORD) +
+      appendDatabaseChanges(journal, poiDb, m_poiSync.sequence, POI_RECORD,
+                            REMOVE_POI_RECORD);
+  /* The changes are saved once they are flushed to the disk */
+  if (!journal.close())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CJournal::writeData() failed: Unable to write " +
+            m_journalFileName);
+    return false;
+  }
+  m_wpSync.sequence = waypointDb.getChangeSequence();
+  m_poiSync.sequence = poiDb.getChangeSequence();
+  m_journalRecords += records;
+  return true;
+}
+/**
+ * Applies the records of a journal file to the Databases. A missing file
+ * has no records, invalid lines are reported and skipped.
+ * @param const std::string& fileName [IN] - The journal file
+ * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+ * @param CPoiDatabase& poiDb [OUT] - The POI Database
+ * @return size_t - Number of applied records
+ */
+size_t CJournal::replayJournal(const std::string &fileName,
+                               CWpDatabase &waypointDb, CPoiDatabase &poiDb)
+{
+  CMappedFile journal;
+  if (!journal.open(fileName))
+  {
+    return 0;
+  }
+  journal.adviseSequential();
+
+  /* The added entries are CSV lines */
+  std::vector<char> delimiters;
+  delimiters.push_back(FIELD_CHAR);
+  delimiters.push_back(COMA_CHAR);
+  CAttributeExtractor wpExtractor, poiExtractor;
+  wpExtractor.setDelimiters(delimiters);
+  wpExtractor.setMaxAttributes(MAX_WAYPOINT_ATTRIBUTES);
+  poiExtractor.setDelimiters(delimiters);
+  poiExtractor.setMaxAttributes(MAX_POI_ATTRIBUTES);
+  CCSV::FieldVector attributeVec;
+
+  size_t records = 0;
+  unsigned int lineNumber = 1;
+  const char *pLine = journal.getData();
+  const char *pEnd = pLine + journal.getSize();
+  for (; pLine < pEnd; ++lineNumber)
+  {
+    const char *pLineEnd =
+        static_cast<const char *>(memchr(pLine, NEW_LINE_CHAR, pEnd - pLine));
+    if (NULL == pLineEnd)
+      pLineEnd = pEnd; /* A record cut off by a crash is invalid */
+    std::string_view line(pLine, pLineEnd - pLine);
+    pLine = pLineEnd + 1;
+    if (line.empty())
+      continue;
+
+    bool isValid = (line.length() > 2) && (FIELD_CHAR == line[1]);
+    std::string_view fields = isValid ? line.substr(2) : std::string_view();
+    if (isValid)
+    {
+      switch (line[0])
+      {
+      case WAYPOINT_RECORD:
+      {
+        CWaypoint wp;
+        isValid = (CAttributeExtractor::RC_SUCCESS ==
+                   wpExtractor.extractAttributes(fields, attributeVec)) &&
+                  (type_mapping::RC_SUCCESS ==
+                   type_mapping::convertStringToCWaypointType(attributeVec,
+                                                              wp));
+        if (isValid)
+          waypointDb.updateWaypoint(wp);
+        break;
+      }
+      case POI_RECORD:
+      {
+        CPOI poi;
+        isValid = (CAttributeExtractor::RC_SUCCESS ==
+                   poiExtractor.extractAttributes(fields, attributeVec)) &&
+                  (type_mapping::RC_SUCCESS ==
+                   type_mapping::convertStringToCPoiType(attributeVec, poi));
+        if (isValid)
+          poiDb.updatePoi(poi);
+        break;
+      }
+      case REMOVE_WAYPOINT_RECORD:
+        waypointDb.removeWaypoint(std::string(fields));
+        break;
+      case REMOVE_POI_RECORD:
+        poiDb.removePoi(std::string(fields));
+        break;
+      case CLEAR_RECORD:
+        if ((1 == fields.length()) && (WAYPOINT_RECORD == fields[0]))
+          waypointDb.clearWpDatabase();
+        else if ((1 == fields.length()) && (POI_RECORD == fields[0]))
+          poiDb.clearPoiDatabase();
+        else
+          isValid = false;
+        break;
+      default:
+        isValid = false;
+      }
+    }
+    if (isValid)
+    {
+      records++;
+    }
+    else if (CDiagnostics::count(CDiagnostics::INVALID_RECORD))
+    {
+      CDiagnostics::write(
+          CDiagnostics::INVALID_RECORD,
+          "ERROR!CJournal::readData() failed! Invalid record in " + fileName +
+              " line_no: " + std::to_string(lineNumber));
+    }
+  }
+  return records;
+}
+/**
+ * Renames the journal and starts folding it into the base snapshot on the
+ * compaction thread
+ * @param None
+ * @return None
+ */
+void CJournal::startCompaction(void)
+{
+  if (m_isCompacting)
+  {
+    return; /* The next save tries again */
+  }
+  waitForCompaction();
+  /* A journal left by a failed compaction is folded by the next snapshot */
+  if ((0 == access(m_compactingFileName.c_str(), F_OK)) ||
+      (0 != rename(m_journalFileName.c_str(), m_compactingFileName.c_str())))
+  {
+    return;
+  }
+  /* New changes go to a new journal while the old one is folded */
+  m_journalRecords = 0;
+  m_isCompacting = true;
+  m_compactionThread = std::thread(&CJournal::compactJournal, this);
+}
+/**
+ * Folds the renamed journal into a new base snapshot, runs on the
+ * compaction thread. The snapshot is written to other files of the base
+ * storage, which replace the base files when they are on the disk.
+ * @param None
+ * @return None
+ */
+void CJournal::compactJournal(void)
+{
+  CWpDatabase waypointDb;
+  CPoiDatabase poiDb;
+  std::vector<std::string> snapshotFiles, baseFiles;
+  bool isFolded =
+      m_baseStorage.readData(waypointDb, poiDb, CPersistentStorage::REPLACE);
+  if (isFolded)
+  {
+    replayJournal(m_compactingFileName, waypointDb, poiDb);
+    /* The base stays intact until the new snapshot is durable */
+    m_baseStorage.setMediaName(m_mediaName + SNAPSHOT_MEDIA_EXTENSION);
+    m_baseStorage.getMediaFiles(snapshotFiles);
+    isFolded = !snapshotFiles.empty() &&
+               m_baseStorage.writeData(waypointDb, poiDb);
+    m_baseStorage.setMediaName(m_mediaName);
+    m_baseStorage.getMediaFiles(baseFiles);
+    /* A crash between the renames leaves a base of old and new files;
+     * replaying the kept journal over it gives the same Databases */
+    isFolded = isFolded && replaceFiles(snapshotFiles, baseFiles);
+  }
+  if (isFolded)
+  {
+    remove(m_compactingFileName.c_str());
+  }
+  else
+  {
+    for (size_t i = 0; i < snapshotFiles.size(); i++)
+    {
+      remove(snapshotFiles[i].c_str());
+    }
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CJournal::compactJournal() failed! The journal is kept in " +
+            m_compactingFileName);
+  }
+  m_isCompacting = false;
+}
@@ -0,0 +1,498 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonIndexScanner.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CJsonIndexScanner
+****************************************************************************/
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_BLOCK_SIZE (32) /**< @brief Represents the bytes per register */
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_BLOCK_SIZE (16) /**< @brief Represents the bytes per register */
+#else
+#define SIMD_BLOCK_SIZE (0) /**< @brief Represents the scalar fallback */
+#endif
+
+#include <nsp/CJsonIndexScanner.h>
+#include <nsp/TypeMapping.h>
+
+#define INDEX_BLOCK_SIZE (64) /**< @brief Represents the bytes of a bitmask */
+
+/**
+ * Holds the bitmasks of one block of 64 bytes, bit i stands for byte i
+ */
+typedef struct {
+  uint64_t quote;      /**< \brief Represents the quotes */
+  uint64_t backslash;  /**< \brief Represents the backslashes */
+  uint64_t whitespace; /**< \brief Represents space, tab, CR and LF */
+  uint64_t operators;  /**< \brief Represents { } [ ] : and , */
+} blockMasks_t;
+
+#if SIMD_BLOCK_SIZE > 0
+/* Thin wrappers which let one classifier serve both instruction sets */
+#if defined(__AVX2__)
+typedef __m256i block_t;
+static inline block_t blockLoad(const char *p)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+static inline block_t blockEqual(block_t a, char value)
+{
+  return _mm256_cmpeq_epi8(a, _mm256_set1_epi8(value));
+}
+static inline block_t blockOr(block_t a, block_t b)
+{
+  return _mm256_or_si256(a, b);
+}
+static inline uint64_t blockMask(block_t a)
+{
+  return (uint32_t)_mm256_movemask_epi8(a);
+}
+#else
+typedef __m128i block_t;
+static inline block_t blockLoad(const char *p)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+static inline block_t blockEqual(block_t a, char value)
+{
+  return _mm_cmpeq_epi8(a, _mm_set1_epi8(value));
+}
+static inline block_t blockOr(block_t a, block_t b)
+{
+  return _mm_or_si128(a, b);
+}
+static inline uint64_t blockMask(block_t a)
+{
+  return (uint32_t)_mm_movemask_epi8(a);
+}
+#endif
+#endif
+
+/**
+ * Classifies the bytes of a block into bitmasks
+ * @param const char* p [IN] - The 64 bytes of the block
+ * @param blockMasks_t& masks [OUT] - The bitmasks
+ * @return None
+ */
+static inline void classifyBlock(const char *p, blockMasks_t &masks)
+{
+  masks.quote = masks.backslash = masks.whitespace = masks.operators = 0;
+#if SIMD_BLOCK_SIZE > 0
+  for (int offset = 0; offset < INDEX_BLOCK_SIZE; offset += SIMD_BLOCK_SIZE)
+  {
+    block_t bytes = blockLoad(p + offset);
+    block_t whitespace =
+        blockOr(blockOr(blockEqual(bytes, ' '), blockEqual(bytes, '\t')),
+                blockOr(blockEqual(bytes, '\n'), blockEqual(bytes, '\r')));
+    block_t brackets =
+        blockOr(blockOr(blockEqual(bytes, '{'), blockEqual(bytes, '}')),
+                blockOr(blockEqual(bytes, '['), blockEqual(bytes, ']')));
+    block_t operators = blockOr(
+        brackets, blockOr(blockEqual(bytes, ':'), blockEqual(bytes, ',')));
+    masks.quote |= blockMask(blockEqual(bytes, '"')) << offset;
+    masks.backslash |= blockMask(blockEqual(bytes, '\\')) << offset;
+    masks.whitespace |= blockMask(whitespace) << offset;
+    masks.operators |= blockMask(operators) << offset;
+  }
+#else
+  for (int offset = 0; offset < INDEX_BLOCK_SIZE; offset++)
+  {
+    uint64_t bit = (uint64_t)1 << offset;
+    switch (p[offset])
+    {
+    case '"':
+      masks.quote |= bit;
+      break;
+    case '\\':
+      masks.backslash |= bit;
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      masks.whitespace |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      masks.operators |= bit;
+      break;
+    default:
+      break;
+    }
+  }
+#endif
+}
+/**
+ * Finds the characters which are escaped by an odd number of backslashes
+ * @param uint64_t backslash [IN] - The backslashes of the block
+ * @param uint64_t& prevEscaped [IN/OUT] - 1 if the first character of the
+ * block is escaped, afterwards for the next block
+ * @return uint64_t - The escaped characters
+ */
+static inline uint64_t findEscaped(uint64_t backslash, uint64_t &prevEscaped)
+{
+  if (0 == (backslash | prevEscaped))
+  {
+    return 0; /* The usual case: no escapes at all */
+  }
+  uint64_t escaped = 0;
+  bool isEscaped = (0 != prevEscaped);
+  for (int bit = 0; bit < INDEX_BLOCK_SIZE; bit++)
+  {
+    if (isEscaped)
+    {
+      escaped |= (uint64_t)1 << bit;
+      isEscaped = false;
+    }
+    else if (0 != ((backslash >> bit) & 1))
+    {
+      isEscaped = true;
+    }
+  }
+  prevEscaped = isEscaped ? 1 : 0;
+  return escaped;
+}
+/**
+ * Sets every bit from a quote up to the bit before the next quote
+ * @param uint64_t quote [IN] - The unescaped quotes
+ * @return uint64_t - The quotes opening a string and the string contents
+ */
+static inline uint64_t prefixXor(uint64_t quote)
+{
+  quote ^= quote << 1;
+  quote ^= quote << 2;
+  quote ^= quote << 4;
+  quote ^= quote << 8;
+  quote ^= quote << 16;
+  quote ^= quote << 32;
+  return quote;
+}
+/**
+ * Checks if a character is part of a number, a literal or illegal
+ * @param char character [IN] - The character
+ * @return true if it is neither whitespace, an operator nor a quote
+ */
+static inline bool isAtomChar(char character)
+{
+  return (NULL == memchr(" \t\n\r{}[]:,\"", character, 11));
+}
+/**
+ * Matches the number pattern of the flex scanner at the start of the text:
+ * [+-]?[0-9]*\.?[0-9]*([eE][+-]?[0-9]+)?
+ * @param const char* pBegin [IN] - Start of the text
+ * @param const char* pEnd [IN] - End of the text
+ * @return size_t - Length of the longest match, 0 if none
+ */
+static size_t matchNumber(const char *pBegin, const char *pEnd)
+{
+  const char *p = pBegin;
+  if ((p < pEnd) && (('+' == *p) || ('-' == *p)))
+    p++;
+  while ((p < pEnd) && (*p >= '0') && (*p <= '9'))
+    p++;
+  if ((p < pEnd) && ('.' == *p))
+    p++;
+  while ((p < pEnd) && (*p >= '0') && (*p <= '9'))
+    p++;
+  if ((p < pEnd) && (('e' == *p) || ('E' == *p)))
+  {
+    const char *pExponent = p + 1;
+    if ((pExponent < pEnd) && (('+' == *pExponent) || ('-' == *pExponent)))
+      pExponent++;
+    if ((pExponent < pEnd) && (*pExponent >= '0') && (*pExponent <= '9'))
+    {
+      while ((pExponent < pEnd) && (*pExponent >= '0') && (*pExponent <= '9'))
+        pExponent++;
+      p = pExponent;
+    }
+  }
+  return p - pBegin;
+}
+/**
+ * Checks the escape sequences of a string like the flex scanner does:
+ * \" \\ \/ \b \f \n \r \t and \u followed by 4 hex digits
+ * @param std::string_view text [IN] - The string without quotes
+ * @return true if all escape sequences are valid
+ */
+static bool hasValidEscapes(std::string_view text)
+{
+  size_t position = text.find('\\');
+  while (std::string_view::npos != position)
+  {
+    if (position + 1 == text.size())
+      return false;
+    char escaped = text[position + 1];
+    if ('u' == escaped)
+    {
+      if ((position + 6 > text.size()) ||
+          (text.substr(position + 2, 4).find_first_not_of(
+               "0123456789abcdefABCDEF") != std::string_view::npos))
+        return false;
+      position += 6;
+    }
+    else if (NULL != memchr("\"\\/bfnrt", escaped, 8))
+    {
+      position += 2;
+    }
+    else
+    {
+      return false;
+    }
+    position = text.find('\\', position);
+  }
+  return true;
+}
+/**
+ * Checks if the text starts with a literal
+ * @param std::string_view text [IN] - The text
+ * @param std::string_view literal [IN] - The literal
+ * @return true if the text starts with the literal
+ */
+static inline bool startsWith(std::string_view text, std::string_view literal)
+{
+  return (text.size() >= literal.size()) &&
+         (0 == memcmp(text.data(), literal.data(), literal.size()));
+}
+
+CJsonIndexScanner::CJsonIndexScanner(std::string_view input)
+    : m_input(input), m_indexPos(0), m_windowStart(0), m_windowEnd(0),
+      m_atomPos(0), m_prevInString(0), m_prevEscaped(0), m_prevAtom(0),
+      m_tokenEnd(0), m_linePos(0), m_lineNumber(1), m_illegalPos(0)
+{
+  m_index.reserve(JSON_INDEX_WINDOW_SIZE / 2);
+}
+/**
+ * Stage 1: indexes the next window of the text
+ * @param None
+ * @return None
+ */
+void CJsonIndexScanner::indexWindow(void)
+{
+  m_index.clear();
+  m_indexPos = 0;
+  m_windowStart = m_windowEnd;
+  m_windowEnd =
+      std::min(m_windowStart + JSON_INDEX_WINDOW_SIZE, m_input.size());
+  for (size_t block = m_windowStart; block < m_windowEnd;
+       block += INDEX_BLOCK_SIZE)
+  {
+    const char *pBlock = m_input.data() + block;
+    char lastBlock[INDEX_BLOCK_SIZE];
+    if (block + INDEX_BLOCK_SIZE > m_input.size())
+    {
+      /* The end of the text is padded with whitespace */
+      memset(lastBlock, ' ', sizeof(lastBlock));
+      memcpy(lastBlock, pBlock, m_input.size() - block);
+      pBlock = lastBlock;
+    }
+    blockMasks_t masks;
+    classifyBlock(pBlock, masks);
+    uint64_t quote = masks.quote & ~findEscaped(masks.backslash, m_prevEscaped);
+    uint64_t inString = prefixXor(quote) ^ m_prevInString;
+    m_prevInString = (uint64_t)((int64_t)inString >> 63);
+    /* A number or literal starts after whitespace, an operator or a quote */
+    uint64_t atom =
+        ~(masks.whitespace | masks.operators | masks.quote) & ~inString;
+    uint64_t atomStart = atom & ~((atom << 1) | m_prevAtom);
+    m_prevAtom = atom >> 63;
+    uint64_t structural =
+        (masks.operators & ~inString) | (quote & inString) | atomStart;
+    while (0 != structural)
+    {
+      m_index.push_back(
+          (uint32_t)(block - m_windowStart + __builtin_ctzll(structural)));
+      structural &= structural - 1;
+    }
+  }
+}
+/**
+ * Fills the token with the number or literal at the position
+ * @param size_t position [IN] - Start of the token
+ * @return false if the character at the position is illegal
+ */
+bool CJsonIndexScanner::scanAtom(size_t position)
+{
+  std::string_view text = m_input.substr(position);
+  size_t length = matchNumber(text.data(), text.data() + text.size());
+  if (0 != length)
+  {
+    double number = 0;
+    type_mapping::parseDecimal(text.substr(0, length), number, true);
+    m_token.setNumber(number);
+  }
+  else if (startsWith(text, "true"))
+  {
+    length = 4;
+    m_token.setBool(true);
+  }
+  else if (startsWith(text, "false"))
+  {
+    length = 5;
+    m_token.setBool(false);
+  }
+  else if (startsWith(text, "null"))
+  {
+    length = 4;
+    m_token.set(APT::CJsonToken::JSON_NULL);
+  }
+  else
+  {
+    m_tokenEnd = position + 1;
+    m_illegalPos = position;
+    return false;
+  }
+  m_tokenEnd = position + length;
+  /* The flex scanner splits "1.2.3" or "true1" into several tokens */
+  m_atomPos = ((m_tokenEnd < m_input.size()) && isAtomChar(m_input[m_tokenEnd]))
+                  ? m_tokenEnd
+                  : 0;
+  return true;
+}
+/**
+ * Returns the next token from the input. The pointer returned points to
+ * an object managed by this class. It is only valid until the next
+ * invocation of the method; a string value stays valid as long as the
+ * input.
+ * @param None
+ * @return APT::CJsonToken* - The token, NULL if the input is exhausted
+ * @throw std::string - An illegal character of the input
+ */
+APT::CJsonToken *CJsonIndexScanner::nextToken(void)
+{
+  bool isIllegal = false;
+  APT::CJsonToken *pToken = nextToken(isIllegal);
+  if (isIllegal)
+  {
+    throw illegalChar();
+  }
+  return pToken;
+}
+/**
+ * Returns the next token like nextToken(), but does not throw
+ * @param bool& isIllegal [OUT] - Set if an illegal character was found
+ * @return APT::CJsonToken* - The token, NULL if the input is exhausted or
+ * the character is illegal
+ */
+APT::CJsonToken *CJsonIndexScanner::nextToken(bool &isIllegal)
+{
+  isIllegal = false;
+  size_t position = m_atomPos;
+  if (0 != position)
+  {
+    m_atomPos = 0;
+    isIllegal = !scanAtom(position);
+    return isIllegal ? NULL : &m_token;
+  }
+  while (m_indexPos == m_index.size())
+  {
+    if (m_windowEnd >= m_input.size())
+    {
+      m_tokenEnd = m_input.size();
+      return NULL;
+    }
+    indexWindow();
+  }
+  position = m_windowStart + m_index[m_indexPos++];
+  m_tokenEnd = position + 1;
+  switch (m_input[position])
+  {
+  case '{':
+    m_token.set(APT::CJsonToken::BEGIN_OBJECT);
+    break;
+  case '}':
+    m_token.set(APT::CJsonToken::END_OBJECT);
+    break;
+  case '[':
+    m_token.set(APT::CJsonToken::BEGIN_ARRAY);
+    break;
+  case ']':
+    m_token.set(APT::CJsonToken::END_ARRAY);
+    break;
+  case ':':
+    m_token.set(APT::CJsonToken::NAME_SEPARATOR);
+    break;
+  case ',':
+    m_token.set(APT::CJsonToken::VALUE_SEPARATOR);
+    break;
+  case '"':
+  {
+    /* The closing quote is the next one after an even number of
+     * backslashes, stage 1 has skipped the same characters */
+    size_t closing = position + 1;
+    for (;;)
+    {
+      const char *pQuote = static_cast<const char *>(
+          memchr(m_input.data() + closing, '"', m_input.size() - closing));
+      if (NULL == pQuote)
+      {
+        m_illegalPos = position; /* Unterminated string */
+        isIllegal = true;
+        return NULL;
+      }
+      closing = pQuote - m_input.data();
+      size_t backslashes = 0;
+      while ((closing - backslashes > position + 1) &&
+             ('\\' == m_input[closing - backslashes - 1]))
+        backslashes++;
+      if (0 == backslashes % 2)
+        break;
+      closing++;
+    }
+    std::string_view text =
+        m_input.substr(position + 1, closing - position - 1);
+    if ((NULL != memchr(text.data(), '\\', text.size())) &&
+        !hasValidEscapes(text))
+    {
+      m_illegalPos = position; /* Not a string for the flex scanner */
+      isIllegal = true;
+      return NULL;
+    }
+    m_token.setString(text);
+    m_tokenEnd = closing + 1;
+    break;
+  }
+  default:
+    isIllegal = !scanAtom(position);
+    return isIllegal ? NULL : &m_token;
+  }
+  return &m_token;
+}
+/**
+ * Returns the illegal character found by the last invocation of
+ * nextToken(), like the flex scanner as C string.
+ * @param None
+ * @return std::string - The illegal character
+ */
+std::string CJsonIndexScanner::illegalChar(void)
+{
+  return std::string(m_input.data() + m_illegalPos,
+                     ('\0' == m_input[m_illegalPos]) ? 0 : 1);
+}
+/**
+ * Return the line number of the input where last token (returned by
+ * nextToken()) was found.
+ * @param None
+ * @return int - The line of the end of the token
+ */
+int CJsonIndexScanner::scannedLine(void)
+{
+  if (m_tokenEnd > m_linePos)
+  {
+    m_lineNumber += std::count(m_input.data() + m_linePos,
+                               m_input.data() + m_tokenEnd, '\n');
+    m_linePos = m_tokenEnd;
+  }
+  return m_lineNumber;
+}
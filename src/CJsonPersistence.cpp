@@ -7,10 +7,15 @@
 ****************************************************************************/
 #include <nsp/CJsonPersistence.h>
 
+#include <string.h>
+
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <thread>
 
+#include <nsp/CMappedFile.h>
+#include <nsp/CThreadPool.h>
 #include <nsp/TypeMapping.h>
 
 #define EMPTY_STRING ""       /**< @brief Represents an EMPTY STRING */
@@ -25,6 +30,15 @@
 #define FILE_EXTENSION \
   ".json" /**< @brief Represents the extension of the json file */
 
+#define ATTRIBUTE_HASH_SIZE \
+  (8) /**< @brief Represents the slots of the attribute name hash */
+#define ANY_TOKEN \
+  (-1) /**< @brief Represents every token type in the transition rules */
+#define MIN_SEGMENT_SIZE \
+  (1 << 20) /**< @brief Represents the smallest segment parsed by a thread */
+#define SEGMENTS_PER_THREAD \
+  (4) /**< @brief Represents the segments per thread, for load balancing */
+
 #define ERR_IGNORE                                                        \
   (                                                                       \
       false) /**< @brief Represents the case when a json parsing error is \
@@ -48,60 +62,377 @@ void CJsonPersistence::setMediaName(std::string name)
   m_fileName = FILE_LOCATION + m_mediaName + FILE_EXTENSION;
 }
 /**
- * Gets the parameter name and assigns it to out based on the database type
+ * Get the files of the media which writeData() replaces
  *
- * @param db_type_t& db: [IN] the Reference to the current database which is
- * extracted from json file
- * @param std::string& in: [IN] the Reference to the current input Token
- * extracted from the Json file
- * @param std::string& out:[OUT]the Reference to the type of the parameter
- * @return true if the database and parameter is a valid one, false otherwise
+ * @param fileNames the names of the files (with path)
  */
-bool CJsonPersistence::checkAndExtractParameterName(const db_type_t &db,
-                                                    const std::string &in,
-                                                    std::string &out)
+void CJsonPersistence::getMediaFiles(std::vector<std::string> &fileNames) const
+{
+  fileNames.assign(1, m_fileName);
+}
+/**
+ * Selects the scanner backend used by readData()
+ * @param scanner_t scanner [IN] - FLEX_SCANNER or INDEX_SCANNER
+ * @return None
+ */
+void CJsonPersistence::setScanner(scanner_t scanner) { m_scanner = scanner; }
+/**
+ * Sets the number of threads which parse a file
+ * @param unsigned int threadCount [IN] - Number of threads, 0 uses one
+ * thread per core, 1 parses on the calling thread
+ * @return None
+ */
+void CJsonPersistence::setThreadCount(unsigned int threadCount)
+{
+  m_threadCount = threadCount;
+}
+/**
+ * Builds the transition table of the parser state machine. The first rule of
+ * a state covers every token type, the following rules of the state override
+ * single token types.
+ *
+ * @return transitionTable_t - The transition of every state and token type
+ */
+CJsonPersistence::transitionTable_t CJsonPersistence::buildTransitionTable(void)
 {
-  bool isFound = false;
-  unsigned int arraySize = 0;
-  const std::string *attributePtr = NULL;
-  const std::string wpAttributes[] = {"name", "latitude", "longitude"};
-  const std::string poiAttributes[] = {"name", "latitude", "longitude",
-                                       "description", "type"};
-  if (WP_DB == db)
+  typedef struct {
+    parser_state_t state; /* The current state */
+    int tokenType;        /* The token type, ANY_TOKEN for all */
+    transition_t transition;
+  } transitionRule_t;
+  /* ERROR Handling Criteria is defined as follows:
+   * =>In case there is an error in the standard Json format, then the parsing
+   * is aborted (ERR_CRITICAL)
+   * =>In case there is issue with the contents, that particular set alone is
+   * ignored and the parsing is resumed (ERR_IGNORE)
+   */
+  static const transitionRule_t rules[] = {
+      {IS_WAITING_FOR_FIRST_TOKEN, ANY_TOKEN,
+       {IS_WAITING_FOR_FIRST_TOKEN, NO_ACTION, "INVALID_BEGIN_OBJECT_TOKEN",
+        ERR_CRITICAL}},
+      {IS_WAITING_FOR_FIRST_TOKEN, APT::CJsonToken::BEGIN_OBJECT,
+       {IS_WAITING_FOR_DB_NAME, NO_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_NAME, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_NAME_SEPARATOR, NO_ACTION, "INVALID_DB_NAME_TOKEN",
+        ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_NAME, APT::CJsonToken::STRING,
+       {IS_WAITING_FOR_DB_NAME_SEPARATOR, DB_NAME_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_NAME_SEPARATOR, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_NAME_SEPARATOR, NO_ACTION,
+        "INVALID_DB_NAME_SEPARATOR_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_NAME_SEPARATOR, APT::CJsonToken::NAME_SEPARATOR,
+       {IS_WAITING_FOR_DB_ARRAY_BEGIN, NO_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_ARRAY_BEGIN, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_ARRAY_BEGIN, NO_ACTION,
+        "INVALID_DB_ARRAY_BEGIN_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_ARRAY_BEGIN, APT::CJsonToken::BEGIN_ARRAY,
+       {IS_WAITING_FOR_DB_OBJ_BEGIN, NO_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_OBJ_BEGIN, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_BEGIN, NO_ACTION, "INVALID_DB_OBJ_BEGIN_TOKEN",
+        ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_OBJ_BEGIN, APT::CJsonToken::BEGIN_OBJECT,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_NAME, NO_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_OBJ_ATTR_NAME, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR, MISSING_ATTR_NAME_ACTION,
+        NULL, ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_NAME, APT::CJsonToken::STRING,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR, ATTR_NAME_ACTION, NULL,
+        ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR, NO_ACTION,
+        "INVALID_DB_OBJ_ATTR_NAME_SEPARATOR_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR,
+       APT::CJsonToken::NAME_SEPARATOR,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE, NO_ACTION, NULL, ERR_IGNORE}},
+
+      /* Values other than strings and numbers are skipped */
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE, NO_ACTION, NULL, ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE, APT::CJsonToken::STRING,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR, ATTR_VALUE_ACTION, NULL,
+        ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE, APT::CJsonToken::NUMBER,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR, ATTR_VALUE_ACTION, NULL,
+        ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR, NO_ACTION,
+        "INVALID_DB_OBJ_ATTR_VALUE_SEPARATOR_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR,
+       APT::CJsonToken::VALUE_SEPARATOR,
+       {IS_WAITING_FOR_DB_OBJ_ATTR_NAME, NO_ACTION, NULL, ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR, APT::CJsonToken::END_OBJECT,
+       {IS_WAITING_FOR_DB_OBJ_SEPARATOR, OBJ_END_ACTION, NULL, ERR_IGNORE}},
+
+      /* The data is reset after parsing one set, also before an error */
+      {IS_WAITING_FOR_DB_OBJ_SEPARATOR, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_OBJ_SEPARATOR, DATA_RESET_ACTION,
+        "INVALID_DB_OBJ_SEPARATOR_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_OBJ_SEPARATOR, APT::CJsonToken::VALUE_SEPARATOR,
+       {IS_WAITING_FOR_DB_OBJ_BEGIN, DATA_RESET_ACTION, NULL, ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_OBJ_SEPARATOR, APT::CJsonToken::END_ARRAY,
+       {IS_WAITING_FOR_DB_ARRAY_SEPARATOR, DATA_RESET_ACTION, NULL,
+        ERR_IGNORE}},
+
+      {IS_WAITING_FOR_DB_ARRAY_SEPARATOR, ANY_TOKEN,
+       {IS_WAITING_FOR_DB_ARRAY_SEPARATOR, NO_ACTION,
+        "INVALID_DB_ARRAY_SEPARATOR_TOKEN", ERR_CRITICAL}},
+      {IS_WAITING_FOR_DB_ARRAY_SEPARATOR, APT::CJsonToken::VALUE_SEPARATOR,
+       {IS_WAITING_FOR_DB_NAME, NO_ACTION, NULL, ERR_IGNORE}},
+      {IS_WAITING_FOR_DB_ARRAY_SEPARATOR, APT::CJsonToken::END_OBJECT,
+       {IS_WAITING_FOR_PARSE_END, NO_ACTION, NULL, ERR_IGNORE}},
+
+      {IS_WAITING_FOR_PARSE_END, ANY_TOKEN,
+       {IS_WAITING_FOR_PARSE_END, PARSE_END_ACTION, NULL, ERR_IGNORE}}};
+
+  transitionTable_t table;
+  for (unsigned int i = 0; i < sizeof(rules) / sizeof(rules[0]); i++)
   {
-    attributePtr = wpAttributes;
-    arraySize = sizeof(wpAttributes) / sizeof(wpAttributes[0]);
+    for (int tokenType = 0; tokenType <= APT::CJsonToken::JSON_NULL;
+         tokenType++)
+    {
+      if ((ANY_TOKEN == rules[i].tokenType) ||
+          (tokenType == rules[i].tokenType))
+      {
+        table.transitions[rules[i].state][tokenType] = rules[i].transition;
+      }
+    }
   }
-  else if (POI_DB == db)
+  return table;
+}
+
+const CJsonPersistence::transitionTable_t
+    CJsonPersistence::s_transitionTable =
+        CJsonPersistence::buildTransitionTable();
+
+const CJsonPersistence::attributeHandler_t
+    CJsonPersistence::s_attributeHandlers[UNKNOWN_DB + 1][NO_ATTRIBUTE] = {
+        /* WP_DB */
+        {{APT::CJsonToken::STRING, &CJsonPersistence::assignName},
+         {APT::CJsonToken::NUMBER, &CJsonPersistence::assignLatitude},
+         {APT::CJsonToken::NUMBER, &CJsonPersistence::assignLongitude},
+         {APT::CJsonToken::STRING, NULL},
+         {APT::CJsonToken::STRING, NULL}},
+        /* POI_DB */
+        {{APT::CJsonToken::STRING, &CJsonPersistence::assignName},
+         {APT::CJsonToken::NUMBER, &CJsonPersistence::assignLatitude},
+         {APT::CJsonToken::NUMBER, &CJsonPersistence::assignLongitude},
+         {APT::CJsonToken::STRING, &CJsonPersistence::assignDescription},
+         {APT::CJsonToken::STRING, &CJsonPersistence::assignType}},
+        /* UNKNOWN_DB */
+        {{APT::CJsonToken::STRING, NULL},
+         {APT::CJsonToken::NUMBER, NULL},
+         {APT::CJsonToken::NUMBER, NULL},
+         {APT::CJsonToken::STRING, NULL},
+         {APT::CJsonToken::STRING, NULL}}};
+/**
+ * Resolves an attribute name through a perfect hash: length plus first
+ * character modulo ATTRIBUTE_HASH_SIZE is different for all attribute names,
+ * so one comparison decides.
+ *
+ * @param std::string_view name: [IN] the attribute name
+ * @return attribute_t - The attribute, NO_ATTRIBUTE if unknown
+ */
+CJsonPersistence::attribute_t
+CJsonPersistence::findAttribute(std::string_view name)
+{
+  typedef struct {
+    std::string_view name;
+    attribute_t attribute;
+  } attributeSlot_t;
+  static const attributeSlot_t slots[ATTRIBUTE_HASH_SIZE] = {
+      {"type", TYPE_ATTRIBUTE},
+      {"", NO_ATTRIBUTE},
+      {"name", NAME_ATTRIBUTE},
+      {"", NO_ATTRIBUTE},
+      {"latitude", LATITUDE_ATTRIBUTE},
+      {"longitude", LONGITUDE_ATTRIBUTE},
+      {"", NO_ATTRIBUTE},
+      {"description", DESCRIPTION_ATTRIBUTE}};
+  if (name.empty())
   {
-    attributePtr = poiAttributes;
-    arraySize = sizeof(poiAttributes) / sizeof(poiAttributes[0]);
+    return NO_ATTRIBUTE;
   }
-  else
+  const attributeSlot_t &slot =
+      slots[(name.size() + (unsigned char)name[0]) & (ATTRIBUTE_HASH_SIZE - 1)];
+  return (slot.name == name) ? slot.attribute : NO_ATTRIBUTE;
+}
+/**
+ * Fills the error raised by the state machine
+ *
+ * @param error_data_t& errorData: [OUT] the error
+ * @param const char* errorMsg: [IN] the error message
+ * @param bool isFatal: [IN] if the parsing must be aborted
+ * @return false, to be returned by the raising method
+ */
+bool CJsonPersistence::raiseError(error_data_t &errorData,
+                                  const char *errorMsg, bool isFatal)
+{
+  errorData.errorMsg = errorMsg;
+  errorData.isFatal = isFatal;
+  return false;
+}
+/**
+ * Assigns the name, it must not be repeated
+ *
+ * @param const APT::CJsonToken& token: [IN] the value token
+ * @param data_t& data: [OUT] the data of the database object
+ * @param error_data_t& errorData: [OUT] the error if the value is invalid
+ * @return true if the value is assigned, false otherwise
+ */
+bool CJsonPersistence::assignName(const APT::CJsonToken &token, data_t &data,
+                                  error_data_t &errorData)
+{
+  if (data.name != DEFAULT_STRING) /* Name is checked if it is written already,
+                                      so that repeated redundant fields can be
+                                      detected*/
   {
-    return isFound;
+    return raiseError(errorData, "Repeated 'name' Entry detected", ERR_IGNORE);
   }
-  for (unsigned int i = 0; i < arraySize; i++)
+  data.name = token.getString();
+  data.nameText = token.getString();
+  if (!type_mapping::validateStringData(data.name)) /* Validate the string */
   {
-    if (attributePtr[i] == in)
-    {
-      out = attributePtr[i];
-      isFound = true;
-      break;
-    }
+    return raiseError(errorData, "INVALID_NAME", ERR_IGNORE);
   }
-  return isFound;
+  return true;
+}
+/**
+ * Assigns the latitude, it must not be repeated
+ *
+ * @param const APT::CJsonToken& token: [IN] the value token
+ * @param data_t& data: [OUT] the data of the database object
+ * @param error_data_t& errorData: [OUT] the error if the value is invalid
+ * @return true if the value is assigned, false otherwise
+ */
+bool CJsonPersistence::assignLatitude(const APT::CJsonToken &token,
+                                      data_t &data, error_data_t &errorData)
+{
+  if (data.latitude) /* Latitude is checked if it is written already, so that
+                        repeated redundant fields can be detected*/
+  {
+    return raiseError(errorData,
+                      "Repeated latitude field detectced", ERR_IGNORE);
+  }
+  data.latitude = token.getNumber();
+  if (!type_mapping::validateLatitude(data.latitude))
+  {
+    return raiseError(errorData, "INVALID_LATITUDE", ERR_IGNORE);
+  }
+  return true;
+}
+/**
+ * Assigns the longitude, it must not be repeated
+ *
+ * @param const APT::CJsonToken& token: [IN] the value token
+ * @param data_t& data: [OUT] the data of the database object
+ * @param error_data_t& errorData: [OUT] the error if the value is invalid
+ * @return true if the value is assigned, false otherwise
+ */
+bool CJsonPersistence::assignLongitude(const APT::CJsonToken &token,
+                                       data_t &data, error_data_t &errorData)
+{
+  if (data.longitude) /* Longitude is checked if it is written already, so
+                         that repeated redundant fields can be detected*/
+  {
+    return raiseError(errorData,
+                      "Repeated Longitude field detected", ERR_IGNORE);
+  }
+  data.longitude = token.getNumber();
+  if (!type_mapping::validateLongitude(data.longitude))
+  {
+    return raiseError(errorData, "INVALID_LONGITUDE", ERR_IGNORE);
+  }
+  return true;
+}
+/**
+ * Assigns the description, it must not be repeated
+ *
+ * @param const APT::CJsonToken& token: [IN] the value token
+ * @param data_t& data: [OUT] the data of the database object
+ * @param error_data_t& errorData: [OUT] the error if the value is invalid
+ * @return true if the value is assigned, false otherwise
+ */
+bool CJsonPersistence::assignDescription(const APT::CJsonToken &token,
+                                         data_t &data, error_data_t &errorData)
+{
+  if (data.description != DEFAULT_STRING) /* Description is checked if it is
+                                             written already, so that repeated
+                                             redundant fields can be detected*/
+  {
+    return raiseError(errorData,
+                      "Repeated description field detected", ERR_IGNORE);
+  }
+  data.description = token.getString();
+  data.descriptionText = token.getString();
+  if (!type_mapping::validateStringData(data.description))
+  {
+    return raiseError(errorData, "INVALID_DESCRIPTION", ERR_IGNORE);
+  }
+  return true;
+}
+/**
+ * Assigns the POI type, it must not be repeated
+ *
+ * @param const APT::CJsonToken& token: [IN] the value token
+ * @param data_t& data: [OUT] the data of the database object
+ * @param error_data_t& errorData: [OUT] the error if the value is invalid
+ * @return true if the value is assigned, false otherwise
+ */
+bool CJsonPersistence::assignType(const APT::CJsonToken &token, data_t &data,
+                                  error_data_t &errorData)
+{
+  if (data.poiType != CPOI::UNKNOWN) /* POI is checked if it is written
+                                        already, so that repeated redundant
+                                        fields can be detected*/
+  {
+    return raiseError(errorData, "Repeated type field detected", ERR_IGNORE);
+  }
+  if (!type_mapping::convertStringToPoiType(token.getString(), data.poiType))
+  {
+    return raiseError(errorData, "INVALID_POI_TYPE", ERR_IGNORE);
+  }
+  return true;
+}
+/**
+ * Gets the attribute of the parameter name based on the database type
+ *
+ * @param db_type_t& db: [IN] the Reference to the current database which is
+ * extracted from json file
+ * @param std::string_view in: [IN] the current input Token extracted from
+ * the Json file
+ * @param attribute_t& out:[OUT]the Reference to the attribute
+ * @return true if the database and parameter is a valid one, false otherwise
+ */
+bool CJsonPersistence::checkAndExtractParameterName(const db_type_t &db,
+                                                    std::string_view in,
+                                                    attribute_t &out)
+{
+  attribute_t attribute = findAttribute(in);
+  if ((NO_ATTRIBUTE == attribute) ||
+      (NULL == s_attributeHandlers[db][attribute].assign))
+  {
+    return false;
+  }
+  out = attribute;
+  return true;
 }
 /**
  * Checks if the given db is valid or not
  *
  * @param db_type_t& db: [OUT] the Reference to the current database which is
  * extracted from json file
- * @param std::string& dbName: [IN] the Reference to the current database string
- * extracted from the Json file
+ * @param std::string_view dbName: [IN] the current database string extracted
+ * from the Json file
  * @return true if the database is a valid one, false otherwise
  */
-bool CJsonPersistence::isValidDb(const std::string &dbName, db_type_t &dbType)
+bool CJsonPersistence::isValidDb(std::string_view dbName, db_type_t &dbType)
 {
   bool isValid = false;
   if (dbName == WAYPOINTS_ARRAY_NAME)
@@ -148,388 +479,125 @@ bool CJsonPersistence::isDataParseComplete(const stateInfo_t &stateInfo)
   return false;
 }
 /**
- * State machine handling the read operation
+ * State machine handling the read operation. The transition of the current
+ * state and token type is looked up in the transition table; its action is
+ * executed and its error raised afterwards. Errors are returned, not thrown,
+ * since dirty files raise them for many records.
  *
  * @param CJsonToken* currentToken: [IN] the current Token extracted from the
  * Json file
  * @param stateInfo_t& stateInfo:[OUT] the Reference to the structure containing
  * the attributes of the current state
- * @return None
+ * @param error_data_t& errorData:[OUT] the error raised by the token
+ * @return true if the token is accepted, false if an error is raised
  */
-void CJsonPersistence::processStateChange(APT::CJsonToken *currentToken,
-                                          stateInfo_t &stateInfo)
+bool CJsonPersistence::processStateChange(APT::CJsonToken *currentToken,
+                                          stateInfo_t &stateInfo,
+                                          error_data_t &errorData)
 {
-  /* Get the stateInfo struct attributes by reference */
-
-  parser_state_t &currentState = stateInfo.currentState;
-  db_type_t &dbType = stateInfo.dbType;
-  std::string &parameter = stateInfo.parameter;
-
-  double &latitude = stateInfo.data.latitude;
-  double &longitude = stateInfo.data.longitude;
-  std::string &name = stateInfo.data.name;
-  std::string &description = stateInfo.data.description;
-  CPOI::t_poi &poiType = stateInfo.data.poiType;
-
-  /* ERROR Handling Criteria is defined as follows:
-   * =>In case there is an error in the standard Json format, then the parsing
-   * is aborted
-   * =>In case there is issue with the contents, that particular set alone is
-   * ignored and
-   *   the parsing is resumed
-   */
-  switch (currentState)
+  const transition_t &transition =
+      s_transitionTable
+          .transitions[stateInfo.currentState][currentToken->getType()];
+  stateInfo.currentState = transition.nextState;
+  switch (transition.action)
   {
-  case CJsonPersistence::IS_WAITING_FOR_FIRST_TOKEN:
+  case CJsonPersistence::NO_ACTION:
   {
-    if (APT::CJsonToken::BEGIN_OBJECT == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_NAME;
-    }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_BEGIN_OBJECT_TOKEN", ERR_CRITICAL}; /* Parsing is aborted
-                                                          since the format is
-                                                          not correct */
-      throw error_data;
-    }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_NAME:
+  case CJsonPersistence::DB_NAME_ACTION:
   {
-    bool isError = true;
-    currentState = CJsonPersistence::IS_WAITING_FOR_DB_NAME_SEPARATOR;
-    if (APT::CJsonToken::STRING == currentToken->getType())
-    {
-      APT::CJsonStringToken *sToken = (APT::CJsonStringToken *)currentToken;
-      isError =
-          !isValidDb(sToken->getValue(), dbType); /*Validate the Database */
-    }
-    if (isError)
+    if (!isValidDb(currentToken->getString(),
+                   stateInfo.dbType)) /*Validate the Database */
     {
-      error_data_t error_data = {"INVALID_DB_NAME_TOKEN",
-                                 ERR_IGNORE}; /* Ignore the error since it is
-                                                 the problem with this db */
-      throw error_data;
+      /* Ignore the error since it is the problem with this db */
+      return raiseError(errorData, "INVALID_DB_NAME_TOKEN", ERR_IGNORE);
     }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_NAME_SEPARATOR:
+  case CJsonPersistence::ATTR_NAME_ACTION:
   {
-    if (APT::CJsonToken::NAME_SEPARATOR == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_ARRAY_BEGIN;
-    }
-    else
+    if (!checkAndExtractParameterName(
+            stateInfo.dbType, currentToken->getString(),
+            stateInfo.attribute)) /* Checks if the parameter/db is valid*/
     {
-      error_data_t error_data = {
-          "INVALID_DB_NAME_SEPARATOR_TOKEN",
-          ERR_CRITICAL}; /* Parsing is aborted since the format is not correct
-                            */
-      throw error_data;
-    }
-    break;
-  }
-  case CJsonPersistence::IS_WAITING_FOR_DB_ARRAY_BEGIN:
-  {
-    if (APT::CJsonToken::BEGIN_ARRAY == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_BEGIN;
-    }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_DB_ARRAY_BEGIN_TOKEN",
-          ERR_CRITICAL}; /* Parsing is aborted since the format is not correct
-                            */
-      throw error_data;
-    }
-    break;
-  }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_BEGIN:
-  {
-    if (APT::CJsonToken::BEGIN_OBJECT == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_NAME;
-    }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_DB_OBJ_BEGIN_TOKEN", ERR_CRITICAL}; /* Parsing is aborted
-                                                          since the format is
-                                                          not correct */
-      throw error_data;
-    }
-    break;
-  }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_NAME:
-  {
-    currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR;
-    if (APT::CJsonToken::STRING == currentToken->getType())
-    {
-      APT::CJsonStringToken *sToken = (APT::CJsonStringToken *)currentToken;
-      if (!checkAndExtractParameterName(
-              dbType, sToken->getValue(),
-              parameter)) /* Checks if the parameter/db is valid*/
-      {
-        if (dbType ==
-            UNKNOWN_DB) /* Invalidate the data in case of unknown db */
-        {
-          stateInfo.data.isValid = false;
-        }
-        error_data_t error_data = {"INVALID_DB_OBJ_ATTR_NAME_TOKEN",
-                                   ERR_IGNORE};
-        throw error_data;
-      }
-      else if (isDataParseComplete(stateInfo))
+      if (stateInfo.dbType ==
+          UNKNOWN_DB) /* Invalidate the data in case of unknown db */
       {
-        error_data_t error_data = {"OBJECT NOT TERMINATED", ERR_CRITICAL};
-        throw error_data;
+        stateInfo.data.isValid = false;
       }
+      return raiseError(errorData,
+                        "INVALID_DB_OBJ_ATTR_NAME_TOKEN", ERR_IGNORE);
     }
-    else
+    else if (isDataParseComplete(stateInfo))
     {
-      if (isDataParseComplete(stateInfo))
-      {
-        error_data_t error_data = {"Database attribute count exceeded",
-                                   ERR_CRITICAL};
-        throw error_data;
-      }
-      error_data_t error_data = {"INVALID_DB_OBJ_ATTR_NAME_TOKEN", ERR_IGNORE};
-      throw error_data;
+      return raiseError(errorData, "OBJECT NOT TERMINATED", ERR_CRITICAL);
     }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_NAME_SEPARATOR:
+  case CJsonPersistence::MISSING_ATTR_NAME_ACTION:
   {
-    if (APT::CJsonToken::NAME_SEPARATOR == currentToken->getType())
+    if (isDataParseComplete(stateInfo))
     {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_VALUE;
+      return raiseError(errorData,
+                        "Database attribute count exceeded", ERR_CRITICAL);
     }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_DB_OBJ_ATTR_NAME_SEPARATOR_TOKEN",
-          ERR_CRITICAL}; /* Parsing is aborted since the format is not correct
-                            */
-      throw error_data;
-    }
-    break;
+    return raiseError(errorData, "INVALID_DB_OBJ_ATTR_NAME_TOKEN", ERR_IGNORE);
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_VALUE:
+  case CJsonPersistence::ATTR_VALUE_ACTION:
   {
-    if (APT::CJsonToken::STRING == currentToken->getType())
+    /* Dispatch to the assignment of the attribute in this database */
+    const attributeHandler_t *pHandler =
+        (NO_ATTRIBUTE == stateInfo.attribute)
+            ? NULL
+            : &s_attributeHandlers[stateInfo.dbType][stateInfo.attribute];
+    if ((NULL == pHandler) || (NULL == pHandler->assign) ||
+        (pHandler->valueType != currentToken->getType()))
     {
-      APT::CJsonStringToken *sToken = (APT::CJsonStringToken *)currentToken;
-      currentState =
-          CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR;
-      if (parameter == "name")
-      {
-        if (name ==
-            DEFAULT_STRING) /* Name is checked if it is written already, so that
-                               repeated redundant fields can be detected*/
-        {
-          name = sToken->getValue();
-          if (!type_mapping::validateStringData(
-                  name)) /* Validate the string data */
-          {
-            error_data_t error_data = {"INVALID_NAME", ERR_IGNORE};
-            throw error_data;
-          }
-        }
-        else
-        {
-          error_data_t error_data = {"Repeated 'name' Entry detected",
-                                     ERR_IGNORE};
-          throw error_data;
-        }
-      }
-      else if (parameter == "description")
-      {
-        if (description == DEFAULT_STRING) /* Description is checked if it is
-                                              written already, so that repeated
-                                              redundant fields can be detected*/
-        {
-          description = sToken->getValue();
-          if (!type_mapping::validateStringData(
-                  description)) /* Validate the string data */
-          {
-            error_data_t error_data = {"INVALID_DESCRIPTION", ERR_IGNORE};
-            throw error_data;
-          }
-        }
-        else
-        {
-          error_data_t error_data = {"Repeated description field detected",
-                                     ERR_IGNORE};
-          throw error_data;
-        }
-      }
-      else if (parameter == "type")
-      {
-        if (poiType == CPOI::UNKNOWN) /* POI is checked if it is written
-                                         already, so that repeated redundant
-                                         fields can be detected*/
-        {
-          std::string str_poiType = sToken->getValue();
-          if (!type_mapping::convertStringToPoiType(
-                  str_poiType, poiType)) /* Converts the string to POI Type */
-          {
-            error_data_t error_data = {"INVALID_POI_TYPE", ERR_IGNORE};
-            throw error_data;
-          }
-        }
-        else
-        {
-          error_data_t error_data = {"Repeated type field detected",
-                                     ERR_IGNORE};
-          throw error_data;
-        }
-      }
-      else
-      {
-        error_data_t error_data = {"Error", ERR_IGNORE};
-        throw error_data;
-      }
+      return raiseError(errorData, "Error", ERR_IGNORE);
     }
-    if (APT::CJsonToken::NUMBER == currentToken->getType())
+    if (!pHandler->assign(*currentToken, stateInfo.data, errorData))
     {
-      APT::CJsonNumberToken *nToken = (APT::CJsonNumberToken *)currentToken;
-      currentState =
-          CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR;
-      if (parameter == "latitude")
-      {
-        if (!latitude) /* Latitude is checked if it is written already, so that
-                          repeated redundant fields can be detected*/
-        {
-          latitude = nToken->getValue();
-          if (!type_mapping::validateLatitude(
-                  latitude)) /* Validate the latitude */
-          {
-            error_data_t error_data = {"INVALID_LATITUDE", ERR_IGNORE};
-            throw error_data;
-          }
-        }
-        else
-        {
-          error_data_t error_data = {"Repeated latitude field detectced",
-                                     ERR_IGNORE};
-          throw error_data;
-        }
-      }
-      else if (parameter == "longitude")
-      {
-        if (!longitude) /* Longitude is checked if it is written already, so
-                           that repeated redundant fields can be detected*/
-        {
-          longitude = nToken->getValue();
-          if (!type_mapping::validateLongitude(
-                  longitude)) /* Validate the longitude */
-          {
-            error_data_t error_data = {"INVALID_LONGITUDE", ERR_IGNORE};
-            throw error_data;
-          }
-        }
-        else
-        {
-          error_data_t error_data = {"Repeated Longitude field detected",
-                                     ERR_IGNORE};
-          throw error_data;
-        }
-      }
-      else
-      {
-        error_data_t error_data = {"Error", ERR_IGNORE};
-        throw error_data;
-      }
+      return false;
     }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_VALUE_SEPARATOR:
+  case CJsonPersistence::OBJ_END_ACTION:
   {
-    if (APT::CJsonToken::VALUE_SEPARATOR == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_ATTR_NAME;
-    }
-    else if (APT::CJsonToken::END_OBJECT == currentToken->getType())
+    if (isDataParseComplete(stateInfo)) /* Checks if the one set of data is
+                                           extracted successfully */
     {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_SEPARATOR;
-      if (isDataParseComplete(stateInfo)) /* Checks if the one set of data is
-                                             extracted successfully */
-      {
-        stateInfo.dataReady = true; // flag is set so that this set of data can
-                                    // be written to the db
-      }
-      else
-      {
-        error_data_t error_data = {"Incorrect Number of attributes",
-                                   ERR_IGNORE};
-        throw error_data;
-      }
+      stateInfo.dataReady = true; // flag is set so that this set of data can
+                                  // be written to the db
     }
     else
     {
-      error_data_t error_data = {
-          "INVALID_DB_OBJ_ATTR_VALUE_SEPARATOR_TOKEN",
-          ERR_CRITICAL}; /* Parsing is aborted since the format is not correct
-                            */
-      throw error_data;
+      return raiseError(errorData,
+                        "Incorrect Number of attributes", ERR_IGNORE);
     }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_OBJ_SEPARATOR:
+  case CJsonPersistence::DATA_RESET_ACTION:
   {
     stateInfo.data.reset(); /* Reset the data after parsing one set */
-    if (APT::CJsonToken::VALUE_SEPARATOR == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_OBJ_BEGIN;
-    }
-    else if (APT::CJsonToken::END_ARRAY == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_ARRAY_SEPARATOR;
-    }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_DB_OBJ_SEPARATOR_TOKEN",
-          ERR_CRITICAL}; /* Parsing is aborted since the format is not correct
-                            */
-      throw error_data;
-    }
     break;
   }
-  case CJsonPersistence::IS_WAITING_FOR_DB_ARRAY_SEPARATOR:
+  case CJsonPersistence::PARSE_END_ACTION:
   {
-    if (APT::CJsonToken::VALUE_SEPARATOR == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_DB_NAME;
-    }
-    else if (APT::CJsonToken::END_OBJECT == currentToken->getType())
-    {
-      currentState = CJsonPersistence::IS_WAITING_FOR_PARSE_END;
-    }
-    else
-    {
-      error_data_t error_data = {
-          "INVALID_DB_ARRAY_SEPARATOR_TOKEN", ERR_CRITICAL}; /* Parsing is
-                                                                aborted since
-                                                                the format is
-                                                                not correct */
-      throw error_data;
-    }
-    break;
-  }
-  case CJsonPersistence::IS_WAITING_FOR_PARSE_END:
-  {
-    std::cout << "Parsing completed" << std::endl;
+    /* The notice is written by parseTokens(), which keeps it in order */
     break;
   }
   default:
   {
-    std::cout << "FATAL ERROR occured!! System Restart needed!";
+    CDiagnostics::report(CDiagnostics::INVALID_JSON,
+                         "FATAL ERROR occured!! System Restart needed!");
+  }
   }
+  if (NULL != transition.errorMsg)
+  {
+    return raiseError(errorData, transition.errorMsg, transition.isFatal);
   }
+  return true;
 }
 /**
  * Fill the databases with the data from persistent storage. If
@@ -557,11 +625,29 @@ void CJsonPersistence::processStateChange(APT::CJsonToken *currentToken,
 bool CJsonPersistence::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
                                 MergeMode mode)
 {
-  bool retVal = true;
-  std::fstream jsonFile(m_fileName.c_str(), std::ios::in);
-  if (!jsonFile.is_open())
+  CDiagnosticScope load("CJsonPersistence::readData()");
+  unsigned int threadCount = m_threadCount;
+  if (0 == threadCount)
   {
-    return false;
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  bool isMapped = (INDEX_SCANNER == m_scanner) || (threadCount > 1);
+  CMappedFile mappedFile;
+  std::fstream jsonFile;
+  if (isMapped)
+  {
+    if (!mappedFile.open(m_fileName))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    jsonFile.open(m_fileName.c_str(), std::ios::in);
+    if (!jsonFile.is_open())
+    {
+      return false;
+    }
   }
   switch (mode)
   {
@@ -578,136 +664,832 @@ bool CJsonPersistence::readData(CWpDatabase &waypointDb, CPoiDatabase &poiDb,
   }
   default:
   {
-    std::cout << "Invalid Mode Specified" << std::endl;
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR, "Invalid Mode Specified");
     return false;
   }
   }
+  if (isMapped)
+  {
+    mappedFile.adviseSequential();
+    std::string_view text(mappedFile.getData(), mappedFile.getSize());
+    if (threadCount > 1)
+    {
+      return readSegments(text, threadCount, waypointDb, poiDb);
+    }
+    CJsonIndexScanner scannerObj(text);
+    segment_t segment;
+    segment.pWpDb = &waypointDb;
+    segment.pPoiDb = &poiDb;
+    return parseTokens(scannerObj, segment);
+  }
   APT::CJsonScanner scannerObj(jsonFile);
-  stateInfo_t stateInfo;
+  segment_t segment;
+  segment.pWpDb = &waypointDb;
+  segment.pPoiDb = &poiDb;
+  return parseTokens(scannerObj, segment);
+}
+/**
+ * Lazy load mode: maps the file into the view and records the valid objects
+ * with their coordinates, POI type and the offsets of their strings.
+ *
+ * A file which only holds well-formed, valid objects is scanned directly
+ * by scanView(), which neither runs the scanner nor copies a string. If it
+ * finds anything else, the records are dropped and the file is parsed with
+ * CJsonIndexScanner and the state machine, so that every error is reported
+ * at its line exactly like by readData().
+ *
+ * @param view[OUT] the view, its previous records are removed
+ * @return true if the data could be read successfully
+ */
+bool CJsonPersistence::readView(CJsonView &view)
+{
+  CDiagnosticScope load("CJsonPersistence::readView()");
+  if (!view.open(m_fileName))
+  {
+    return false;
+  }
+  std::string_view text = view.getText();
+  if (scanView(text, view))
+  {
+    return true;
+  }
+  view.clearRecords();
+  CJsonIndexScanner scannerObj(text);
+  segment_t segment;
+  segment.pView = &view;
+  return parseTokens(scannerObj, segment);
+}
+/**
+ * Feeds the tokens of the scanner through the state machine, starting in the
+ * state of the segment, and adds the extracted data to the databases or the
+ * view of the segment or keeps it in the segment. The lines of the scanner
+ * count from the begin of the segment.
+ *
+ * @param Scanner& scannerObj [IN] - APT::CJsonScanner or CJsonIndexScanner
+ * @param segment_t& segment [IN/OUT] - The segment which is parsed
+ * @return true if the data could be read successfully
+ */
+template <class Scanner>
+bool CJsonPersistence::parseTokens(Scanner &scannerObj, segment_t &segment)
+{
+  bool retVal = true;
+  stateInfo_t &stateInfo = segment.stateInfo;
   APT::CJsonToken *currentToken = NULL;
+  bool isIllegal = false;
   try
   {
-    while (NULL !=
-           (currentToken = scannerObj.nextToken())) // Get the token 1 by 1
+    while (NULL != (currentToken = scannerObj.nextToken(
+                        isIllegal))) // Get the token 1 by 1
     {
-      try
+      error_data_t errorData = {NULL, ERR_IGNORE};
+      if (IS_WAITING_FOR_PARSE_END == stateInfo.currentState)
       {
-        processStateChange(currentToken, stateInfo); // Parse the Token through
-                                                     // the state machine and
-                                                     // take appropriate actions
-        if (stateInfo
-                .dataReady) // checks if 1 set of data is extracted successfully
-        {
-          stateInfo.dataReady = false; // reset the data ready flag
-          if (stateInfo.data.isValid)  //  Check if the data is valid, if valid,
-                                       //  add to database
-            switch (stateInfo.dbType)
-            {
-            case CJsonPersistence::WP_DB:
+        writeMessage(segment, CDiagnostics::NOTICE, "Parsing completed");
+      }
+      if (processStateChange(currentToken, stateInfo,
+                             errorData) && // Parse the Token through the
+                                           // state machine and take
+                                           // appropriate actions
+          stateInfo.dataReady) // checks if 1 set of data is extracted
+                               // successfully
+      {
+        stateInfo.dataReady = false; // reset the data ready flag
+        if (stateInfo.data.isValid)  //  Check if the data is valid, if valid,
+                                     //  add to database
+          switch (stateInfo.dbType)
+          {
+          case CJsonPersistence::WP_DB:
+          {
+            if (NULL != segment.pView)
             {
-              CWaypoint wpObj(stateInfo.data.latitude, stateInfo.data.longitude,
-                              stateInfo.data.name);
-              waypointDb.addWaypoint(wpObj);
+              segment.pView->addWaypoint(
+                  getViewRecord(stateInfo.data, segment.pView->getText()));
               break;
             }
-            case CJsonPersistence::POI_DB:
+            CWaypoint wpObj(stateInfo.data.latitude, stateInfo.data.longitude,
+                            stateInfo.data.name);
+            if (NULL != segment.pWpDb)
+            {
+              segment.pWpDb->addWaypoint(wpObj);
+            }
+            else
+            {
+              segmentEntry_t entry = {WAYPOINT_ENTRY,
+                                      segment.waypoints.size()};
+              segment.entries.push_back(entry);
+              segment.waypoints.push_back(
+                  CWpDatabase::createNode(wpObj.getName(), wpObj));
+            }
+            break;
+          }
+          case CJsonPersistence::POI_DB:
+          {
+            if (NULL != segment.pView)
             {
-              CPOI poiObj(stateInfo.data.poiType, stateInfo.data.name,
-                          stateInfo.data.description, stateInfo.data.latitude,
-                          stateInfo.data.longitude);
-              poiDb.addPoi(poiObj);
+              segment.pView->addPoi(
+                  getViewRecord(stateInfo.data, segment.pView->getText()));
               break;
             }
-            default:
+            CPOI poiObj(stateInfo.data.poiType, stateInfo.data.name,
+                        stateInfo.data.description, stateInfo.data.latitude,
+                        stateInfo.data.longitude);
+            if (NULL != segment.pPoiDb)
             {
-              CJsonPersistence::error_data_t errorData;
-              errorData.errorMsg = "INVALID_DB_OBJ_ATTR_NAME";
-              throw errorData;
+              segment.pPoiDb->addPoi(poiObj);
             }
+            else
+            {
+              segmentEntry_t entry = {POI_ENTRY, segment.pois.size()};
+              segment.entries.push_back(entry);
+              segment.pois.push_back(
+                  CPoiDatabase::createNode(poiObj.getName(), poiObj));
             }
+            break;
+          }
+          default:
+          {
+            raiseError(errorData, "INVALID_DB_OBJ_ATTR_NAME", ERR_IGNORE);
+          }
+          }
+        if (NULL == errorData.errorMsg)
           stateInfo.data.reset(); // resets the data to parse the next set
+      }
+      if ((NULL != errorData.errorMsg) &&
+          stateInfo.data.isValid) // to stop reporting more errors if 1 type
+                                  // of error is detected
+      {
+        if (isReported(segment, CDiagnostics::INVALID_JSON))
+          writeMessage(segment, CDiagnostics::INVALID_JSON,
+                       std::string("Exception occurred! Exception "
+                                   "Cause:") +
+                           errorData.errorMsg + " at Line:" +
+                           std::to_string(scannerObj.scannedLine() +
+                                          segment.firstLine - 1));
+        if (errorData.isFatal) // Check if the parsing needs to be continued
+        {
+          writeMessage(segment, CDiagnostics::NOTICE,
+                       "Aborted Json parsing due to incorrect Json Format, "
+                       "Please correct and try again!");
+          retVal = false;
+          break;
         }
+        stateInfo.data.isValid = false; // This is set so that this invalid
+                                        // data is not written to the database
       }
-      catch (CJsonPersistence::error_data_t &errorData) // Exception handling
-                                                        // for exceptions from
-                                                        // the state machine
+    }
+    if (isIllegal) // Illegal character found by the scanner
+    {
+      if (isReported(segment, CDiagnostics::INVALID_JSON))
+        writeMessage(segment, CDiagnostics::INVALID_JSON,
+                     "Exception occurred!:Illegal character: " +
+                         scannerObj.illegalChar() +
+                         " in Json file at line number :" +
+                         std::to_string(scannerObj.scannedLine() +
+                                        segment.firstLine - 1));
+      writeMessage(segment, CDiagnostics::NOTICE,
+                   "Aborted Json parsing due to incorrect Json Format, "
+                   "Please correct and try again!");
+    }
+    segment.isAborted = !retVal || isIllegal;
+  }
+  catch (...) // central default exception handler, e.g. for bad_alloc
+  {
+    if (isReported(segment, CDiagnostics::INVALID_JSON))
+      writeMessage(segment, CDiagnostics::INVALID_JSON,
+                   "An unknown exception has occurred!");
+    writeMessage(segment, CDiagnostics::NOTICE,
+                 "Please check the json file and try again!");
+    segment.isAborted = true;
+  }
+  segment.isRead = retVal;
+  return retVal;
+}
+/**
+ * Pre-scan of the text: finds the objects of the waypoint and POI arrays and
+ * starts a segment at an object about every text size / segmentCount bytes.
+ * Only quotes, brackets and line breaks are looked at; strings are skipped
+ * with memchr. The structure is not checked here, a segment which does not
+ * start in the state the parser reaches is parsed again in readSegments().
+ *
+ * @param std::string_view text [IN] - The JSON text
+ * @param size_t segmentCount [IN] - The number of segments aimed at
+ * @param std::deque<segment_t>& segments [OUT] - The segments, the first one
+ * starts at the begin of the text
+ * @return None
+ */
+void CJsonPersistence::findSegments(std::string_view text,
+                                    size_t segmentCount,
+                                    std::deque<segment_t> &segments)
+{
+  const char *pText = text.data();
+  size_t nextBegin = text.size() / segmentCount;
+  int depth = 0, line = 1;
+  std::string_view key;       /* The last string in the outer object */
+  bool isDbArray = false;     /* Set inside the array of a database */
+  db_type_t dbType = UNKNOWN_DB;
+  segments.clear();
+  segments.push_back(segment_t());
+  for (size_t position = 0; position < text.size(); position++)
+  {
+    switch (pText[position])
+    {
+    case '\n':
+    {
+      line++;
+      break;
+    }
+    case '"':
+    {
+      /* Find the closing quote which is not escaped by a backslash */
+      size_t closing = position;
+      size_t backslashes = 0;
+      do
       {
-        if (stateInfo.data.isValid) // to stop reporting more errors if 1 type
-                                    // of error is detected
+        const char *pQuote = static_cast<const char *>(
+            memchr(pText + closing + 1, '"', text.size() - closing - 1));
+        if (NULL == pQuote)
         {
-          std::cout << "Exception occurred! Exception Cause:"
-                    << errorData.errorMsg
-                    << " at Line:" << scannerObj.scannedLine() << std::endl;
-          if (errorData.isFatal) // Check if the parsing needs to be continued
-          {
-            std::cout << "Aborted Json parsing due to incorrect Json Format, "
-                         "Please correct and try again!"
-                      << std::endl;
-            retVal = false;
-            break;
-          }
-          stateInfo.data.isValid = false; // This is set so that this invalid
-                                          // data is not written to the database
+          return; /* Unterminated, the last segment is parsed to the end */
         }
+        closing = pQuote - pText;
+        for (backslashes = 0; '\\' == pText[closing - backslashes - 1];
+             backslashes++)
+          ;
+      } while (1 == backslashes % 2);
+      line += std::count(pText + position + 1, pText + closing, '\n');
+      if (1 == depth)
+      {
+        key = text.substr(position + 1, closing - position - 1);
       }
-      catch (...) // default exception handler
+      position = closing;
+      break;
+    }
+    case '{':
+    case '[':
+    {
+      if ((2 == depth) && isDbArray && ('{' == pText[position]) &&
+          (position >= nextBegin))
       {
-        throw; // delegate exception handling to the central default exception
-               // handler
+        segments.push_back(segment_t());
+        segment_t &segment = segments.back();
+        segment.begin = position;
+        segment.firstLine = line;
+        segment.dbType = dbType;
+        segment.stateInfo.currentState = IS_WAITING_FOR_DB_OBJ_BEGIN;
+        segment.stateInfo.dbType = dbType;
+        nextBegin = text.size() / segmentCount * segments.size();
       }
+      else if (1 == depth)
+      {
+        isDbArray = ('[' == pText[position]) && isValidDb(key, dbType);
+      }
+      depth++;
+      break;
     }
+    case '}':
+    case ']':
+    {
+      depth--;
+      break;
+    }
+    default:
+      break;
+    }
+  }
+}
+/**
+ * Parses the segments of the text on a thread pool and merges them into the
+ * databases in file order. A segment is merged if the previous one ends in
+ * the state its parsing started from; after a fatal error or an illegal
+ * character no more segments are merged. If an error left the parser in
+ * another state, the rest of the text is parsed on this thread from the
+ * state it is in.
+ *
+ * @param std::string_view text [IN] - The JSON text
+ * @param unsigned int threadCount [IN] - The number of threads
+ * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+ * @param CPoiDatabase& poiDb [OUT] - The POI Database
+ * @return true if the data could be read successfully
+ */
+bool CJsonPersistence::readSegments(std::string_view text,
+                                    unsigned int threadCount,
+                                    CWpDatabase &waypointDb,
+                                    CPoiDatabase &poiDb)
+{
+  size_t segmentCount = std::min((size_t)threadCount * SEGMENTS_PER_THREAD,
+                                 text.size() / MIN_SEGMENT_SIZE);
+  std::deque<segment_t> segments(1);
+  if (segmentCount > 1)
+  {
+    findSegments(text, segmentCount, segments);
+  }
+  if (1 == segments.size())
+  {
+    CJsonIndexScanner scannerObj(text);
+    segments[0].pWpDb = &waypointDb;
+    segments[0].pPoiDb = &poiDb;
+    return parseTokens(scannerObj, segments[0]);
   }
-  catch (std::string &illegalChar) // Exception handling for exceptions from
-                                   // the scanner class
+
   {
-    std::cout << "Exception occurred!:Illegal character: " << illegalChar
-              << " in Json file at line number :" << scannerObj.scannedLine()
-              << std::endl;
-    std::cout << "Aborted Json parsing due to incorrect Json Format, Please "
-                 "correct and try again!"
-              << std::endl;
+    CThreadPool pool(threadCount);
+    pool.parallelFor(
+        segments.size(), 1, [&](size_t begin, size_t end, unsigned int) {
+          for (size_t i = begin; i < end; i++)
+          {
+            size_t segmentEnd = (i + 1 < segments.size())
+                                    ? segments[i + 1].begin
+                                    : text.size();
+            CJsonIndexScanner scannerObj(
+                text.substr(segments[i].begin, segmentEnd - segments[i].begin));
+            parseTokens(scannerObj, segments[i]);
+          }
+        });
   }
-  catch (...) // central default exception handler
+
+  bool retVal = true;
+  for (size_t i = 0; i < segments.size(); i++)
   {
-    std::cout << "An unknown exception has occurred!" << std::endl;
-    std::cout << "Please check the json file and try again!" << std::endl;
+    if ((i > 0) && !isObjectBegin(segments[i - 1].stateInfo,
+                                  segments[i].dbType))
+    {
+      segment_t rest;
+      rest.begin = segments[i].begin;
+      rest.firstLine = segments[i].firstLine;
+      rest.stateInfo = segments[i - 1].stateInfo;
+      rest.pWpDb = &waypointDb;
+      rest.pPoiDb = &poiDb;
+      CJsonIndexScanner scannerObj(text.substr(rest.begin));
+      return parseTokens(scannerObj, rest) && retVal;
+    }
+    mergeSegment(segments[i], waypointDb, poiDb);
+    retVal = retVal && segments[i].isRead;
+    if (segments[i].isAborted)
+    {
+      break;
+    }
   }
   return retVal;
 }
 /**
- * Writes the member data(jsonFileContents) to the Json File
- * @return true if the write is successful, false otherwise
+ * Adds the kept records to the databases and writes the kept messages in
+ * file order, then releases them. A counted message is counted here, so the
+ * sampling is the one of a parse on one thread.
+ *
+ * @param segment_t& segment [IN/OUT] - The parsed segment
+ * @param CWpDatabase& waypointDb [OUT] - The Waypoint Database
+ * @param CPoiDatabase& poiDb [OUT] - The POI Database
+ * @return None
  */
-bool CJsonPersistence::writeToJsonFile()
+void CJsonPersistence::mergeSegment(segment_t &segment,
+                                    CWpDatabase &waypointDb,
+                                    CPoiDatabase &poiDb)
 {
-  bool retVal = true;
-  std::fstream jsonFile(m_fileName.c_str(), std::ios::out);
-  if (jsonFile.is_open())
+  for (std::vector<segmentEntry_t>::const_iterator itr =
+           segment.entries.begin();
+       itr != segment.entries.end(); ++itr)
+  {
+    switch (itr->type)
+    {
+    case WAYPOINT_ENTRY:
+      waypointDb.addNode(segment.waypoints[itr->index]);
+      break;
+    case POI_ENTRY:
+      poiDb.addNode(segment.pois[itr->index]);
+      break;
+    default:
+    {
+      const message_t &message = segment.messages[itr->index];
+      if ((CDiagnostics::NOTICE == message.category) ||
+          CDiagnostics::count(message.category))
+      {
+        CDiagnostics::write(message.category, message.text);
+      }
+      break;
+    }
+    }
+  }
+  std::deque<CWpDatabase::node_t>().swap(segment.waypoints);
+  std::deque<CPoiDatabase::node_t>().swap(segment.pois);
+  std::vector<message_t>().swap(segment.messages);
+  std::vector<segmentEntry_t>().swap(segment.entries);
+}
+/**
+ * Checks if the parser is in the state of the begin of an object in the
+ * array of the database, the state a segment is parsed from. The attribute
+ * of the state is not compared: it is only read after an attribute name was
+ * accepted, or for data which is already invalid.
+ *
+ * @param const stateInfo_t& stateInfo [IN] - The state of the parser
+ * @param db_type_t dbType [IN] - The database of the array
+ * @return true if the state is the one at the begin of an object
+ */
+bool CJsonPersistence::isObjectBegin(const stateInfo_t &stateInfo,
+                                     db_type_t dbType)
+{
+  return (IS_WAITING_FOR_DB_OBJ_BEGIN == stateInfo.currentState) &&
+         (dbType == stateInfo.dbType) && !stateInfo.dataReady &&
+         stateInfo.data.isValid && (0 == stateInfo.data.latitude) &&
+         (0 == stateInfo.data.longitude) &&
+         (DEFAULT_STRING == stateInfo.data.name) &&
+         (DEFAULT_STRING == stateInfo.data.description) &&
+         (CPOI::UNKNOWN == stateInfo.data.poiType);
+}
+/**
+ * Writes the message or keeps it in the segment
+ *
+ * @param segment_t& segment [IN/OUT] - The segment being parsed
+ * @param CDiagnostics::category_t category [IN] - The category
+ * @param std::string_view text [IN] - The message
+ * @return None
+ */
+void CJsonPersistence::writeMessage(segment_t &segment,
+                                    CDiagnostics::category_t category,
+                                    std::string_view text)
+{
+  if (!isKept(segment))
+  {
+    CDiagnostics::write(category, text);
+    return;
+  }
+  segmentEntry_t entry = {MESSAGE_ENTRY, segment.messages.size()};
+  segment.entries.push_back(entry);
+  message_t message = {category, std::string(text)};
+  segment.messages.push_back(message);
+}
+/**
+ * Skips the whitespace between the tokens, as the scanners do
+ * @param std::string_view text [IN] - The JSON text
+ * @param size_t& position [IN/OUT] - The position, at the next token after
+ * @return None
+ */
+static inline void skipWhitespace(std::string_view text, size_t &position)
+{
+  while ((position < text.size()) &&
+         ((' ' == text[position]) || ('\n' == text[position]) ||
+          ('\t' == text[position]) || ('\r' == text[position])))
+    position++;
+}
+/**
+ * Accepts the operator if it is the next token
+ * @param std::string_view text [IN] - The JSON text
+ * @param size_t& position [IN/OUT] - The position, after the operator if it
+ * is accepted
+ * @param char character [IN] - The operator
+ * @return true if the operator is accepted
+ */
+static inline bool acceptChar(std::string_view text, size_t &position,
+                              char character)
+{
+  skipWhitespace(text, position);
+  if ((position < text.size()) && (character == text[position]))
+  {
+    position++;
+    return true;
+  }
+  return false;
+}
+/**
+ * Accepts a string without escape sequences if it is the next token, a
+ * string with escapes is left to the scanner which checks them
+ * @param std::string_view text [IN] - The JSON text
+ * @param size_t& position [IN/OUT] - The position, after the string if it
+ * is accepted
+ * @param std::string_view& value [OUT] - The string without quotes
+ * @return true if the string is accepted
+ */
+static inline bool acceptString(std::string_view text, size_t &position,
+                                std::string_view &value)
+{
+  if (!acceptChar(text, position, '"'))
+  {
+    return false;
+  }
+  const char *pBegin = text.data() + position;
+  const char *pQuote = static_cast<const char *>(
+      memchr(pBegin, '"', text.size() - position));
+  if ((NULL == pQuote) || (NULL != memchr(pBegin, '\\', pQuote - pBegin)))
+  {
+    return false;
+  }
+  value = std::string_view(pBegin, pQuote - pBegin);
+  position = pQuote + 1 - text.data();
+  return true;
+}
+/**
+ * Accepts a number which starts with a digit or a minus sign if it is the
+ * next token. The caller checks that an operator follows, so that a number
+ * which the scanners match differently is not accepted.
+ * @param std::string_view text [IN] - The JSON text
+ * @param size_t& position [IN/OUT] - The position, after the number if it
+ * is accepted
+ * @param double& value [OUT] - The number
+ * @return true if the number is accepted
+ */
+static inline bool acceptNumber(std::string_view text, size_t &position,
+                                double &value)
+{
+  skipWhitespace(text, position);
+  if ((position == text.size()) ||
+      (('-' != text[position]) &&
+       ((text[position] < '0') || (text[position] > '9'))))
+  {
+    return false;
+  }
+  size_t length =
+      type_mapping::parseDecimal(text.substr(position), value, true);
+  position += length;
+  return (0 != length);
+}
+/**
+ * Scans a text which only holds well-formed, valid objects directly into
+ * the view: the outer object of the waypoint and POI arrays, objects of
+ * known attributes with values of their type, and nothing after the end.
+ * Every check of the state machine which would report an error makes it
+ * return false instead, so that readView() parses the file again.
+ *
+ * @param std::string_view text [IN] - The JSON text of the view
+ * @param CJsonView& view [OUT] - The view
+ * @return true if the whole text is scanned, false if it holds anything
+ * the parser would report
+ */
+bool CJsonPersistence::scanView(std::string_view text, CJsonView &view)
+{
+  size_t position = 0;
+  data_t data;
+  if (!acceptChar(text, position, '{'))
+  {
+    return false;
+  }
+  do
   {
-    if (!jsonFileContents.empty())
+    std::string_view dbName;
+    db_type_t dbType = UNKNOWN_DB;
+    if (!acceptString(text, position, dbName) || !isValidDb(dbName, dbType) ||
+        !acceptChar(text, position, ':') || !acceptChar(text, position, '['))
     {
-      jsonFile << JSON_BEGIN_STRING << std::endl;
+      return false;
     }
-    for (StringVector::const_iterator itr = jsonFileContents.begin();
-         itr != jsonFileContents.end(); ++itr)
+    do
+    {
+      data.reset();
+      if (!acceptChar(text, position, '{') ||
+          !scanViewObject(text, position, dbType, data))
+      {
+        return false;
+      }
+      if (WP_DB == dbType)
+        view.addWaypoint(getViewRecord(data, text));
+      else
+        view.addPoi(getViewRecord(data, text));
+    } while (acceptChar(text, position, ','));
+    if (!acceptChar(text, position, ']'))
     {
-      jsonFile << (*itr) << std::endl;
+      return false;
     }
-    if (!jsonFileContents.empty())
+  } while (acceptChar(text, position, ','));
+  if (!acceptChar(text, position, '}'))
+  {
+    return false;
+  }
+  skipWhitespace(text, position); /* Any token after the end is reported */
+  return (position == text.size());
+}
+/**
+ * Scans the attributes of an object after its begin. The numbers and the
+ * type are assigned by the handlers of the state machine; the strings are
+ * checked like by assignName() and assignDescription(), but not copied.
+ *
+ * @param std::string_view text [IN] - The JSON text of the view
+ * @param size_t& position [IN/OUT] - The position in the text, after the
+ * object if it is scanned
+ * @param db_type_t dbType [IN] - The database of the array
+ * @param data_t& data [OUT] - The data of the object, reset before
+ * @return true if the object is valid and complete
+ */
+bool CJsonPersistence::scanViewObject(std::string_view text, size_t &position,
+                                      db_type_t dbType, data_t &data)
+{
+  APT::CJsonToken token;
+  error_data_t errorData = {NULL, ERR_IGNORE};
+  /* The view data is complete like isDataParseComplete() checks it */
+  bool isComplete = false;
+  do
+  {
+    std::string_view name, value;
+    attribute_t attribute = NO_ATTRIBUTE;
+    if (isComplete || !acceptString(text, position, name) ||
+        !checkAndExtractParameterName(dbType, name, attribute) ||
+        !acceptChar(text, position, ':'))
+    {
+      return false;
+    }
+    const attributeHandler_t &handler = s_attributeHandlers[dbType][attribute];
+    if (APT::CJsonToken::NUMBER == handler.valueType)
+    {
+      double number = 0;
+      if (!acceptNumber(text, position, number))
+      {
+        return false;
+      }
+      token.setNumber(number);
+    }
+    else
     {
-      jsonFile << JSON_END_STRING;
+      if (!acceptString(text, position, value))
+      {
+        return false;
+      }
+      token.setString(value);
     }
+    if ((NAME_ATTRIBUTE == attribute) || (DESCRIPTION_ATTRIBUTE == attribute))
+    {
+      std::string_view &field = (NAME_ATTRIBUTE == attribute)
+                                    ? data.nameText
+                                    : data.descriptionText;
+      /* A string equal to the default one is not seen as assigned */
+      if ((NULL != field.data()) || (DEFAULT_STRING == value) ||
+          !type_mapping::validateStringData(value))
+      {
+        return false;
+      }
+      field = value;
+    }
+    else if (!handler.assign(token, data, errorData))
+    {
+      return false;
+    }
+    isComplete = (0 != data.latitude) && (0 != data.longitude) &&
+                 (NULL != data.nameText.data()) &&
+                 ((WP_DB == dbType) || ((NULL != data.descriptionText.data()) &&
+                                        (CPOI::UNKNOWN != data.poiType)));
+  } while (acceptChar(text, position, ','));
+  return isComplete && acceptChar(text, position, '}');
+}
+/**
+ * Gets the record of the data for a view
+ *
+ * @param const data_t& data [IN] - The data, its strings in the text
+ * @param std::string_view text [IN] - The JSON text of the view
+ * @return CJsonView::record_t - The record
+ */
+CJsonView::record_t CJsonPersistence::getViewRecord(const data_t &data,
+                                                    std::string_view text)
+{
+  CJsonView::record_t record = {data.latitude, data.longitude, 0, 0, 0, 0,
+                                data.poiType};
+  record.nameOffset = data.nameText.data() - text.data();
+  record.nameLength = data.nameText.size();
+  if (NULL != data.descriptionText.data())
+  {
+    record.descriptionOffset = data.descriptionText.data() - text.data();
+    record.descriptionLength = data.descriptionText.size();
   }
-  else
+  return record;
+}
+/**
+ * Gets the length of the valid escape sequence at the backslash
+ * @param std::string_view text [IN] - The text
+ * @param size_t position [IN] - The position of the backslash
+ * @return size_t - The length of the sequence, 0 if it is not a valid one
+ */
+static size_t getEscapeLength(std::string_view text, size_t position)
+{
+  if (position + 1 == text.size())
   {
-    retVal = false;
-    std::cout << "ERROR!CJsonPersistence::writeData() failed: Unable to open "
-              << m_fileName << std::endl;
+    return 0;
   }
-  return retVal;
+  char escaped = text[position + 1];
+  if ('u' == escaped)
+  {
+    if ((position + 6 > text.size()) ||
+        (text.substr(position + 2, 4).find_first_not_of(
+             "0123456789abcdefABCDEF") != std::string_view::npos))
+    {
+      return 0;
+    }
+    return 6;
+  }
+  return (NULL != memchr("\"\\/bfnrt", escaped, 8)) ? 2 : 0;
 }
 /**
- * Write the data to the persistent storage.
+ * Appends the text as a JSON string. The scanners deliver a string with its
+ * escape sequences, so valid sequences are written unchanged and a loaded
+ * string is saved as it was read. Quotes, lone backslashes and control
+ * characters are escaped. Most names and descriptions need no escape and
+ * are appended at once.
+ * @param CBufferedWriter& file [OUT] - The file written to
+ * @param std::string_view text [IN] - The text of the string
+ * @return None
+ */
+static void appendJsonString(CBufferedWriter &file, std::string_view text)
+{
+  static const char hexDigits[] = "0123456789abcdef";
+  size_t position = 0;
+  while ((position < text.size()) &&
+         ((unsigned char)text[position] >= 0x20) && ('"' != text[position]) &&
+         ('\\' != text[position]))
+  {
+    position++;
+  }
+  file.append('"');
+  file.append(text.substr(0, position));
+  while (position < text.size())
+  {
+    unsigned char character = text[position];
+    size_t length = 0;
+    if ('\\' == character)
+    {
+      length = getEscapeLength(text, position);
+    }
+    if (0 != length)
+    {
+      file.append(text.substr(position, length));
+      position += length;
+      continue;
+    }
+    switch (character)
+    {
+    case '"':
+      file.append("\\\"");
+      break;
+    case '\\':
+      file.append("\\\\");
+      break;
+    case '\n':
+      file.append("\\n");
+      break;
+    case '\r':
+      file.append("\\r");
+      break;
+    case '\t':
+      file.append("\\t");
+      break;
+    default:
+      if (character < 0x20)
+      {
+        file.append("\\u00");
+        file.append(hexDigits[character >> 4]);
+        file.append(hexDigits[character & 0xF]);
+      }
+      else
+      {
+        file.append((char)character);
+      }
+      break;
+    }
+    position++;
+  }
+  file.append('"');
+}
+/**
+ * Appends the Waypoint as an object of the waypoints array
+ * @param CBufferedWriter& file [OUT] - The file written to
+ * @param const CWaypoint& wp [IN] - The Waypoint
+ * @return None
+ */
+void CJsonPersistence::appendWaypointObject(CBufferedWriter &file,
+                                            const CWaypoint &wp)
+{
+  file.append("\t  {\n\t\t\"name\":");
+  appendJsonString(file, wp.getName());
+  file.append(",\n\t\t\"latitude\":");
+  file.appendDouble(wp.getLatitude());
+  file.append(",\n\t\t\"longitude\":");
+  file.appendDouble(wp.getLongitude());
+  file.append("\n\t  }");
+}
+/**
+ * Appends the POI as an object of the pois array
+ * @param CBufferedWriter& file [OUT] - The file written to
+ * @param const CPOI& poi [IN] - The POI
+ * @return true if the POI is appended, false if its type is invalid (the
+ * type is written empty)
+ */
+bool CJsonPersistence::appendPoiObject(CBufferedWriter &file, const CPOI &poi)
+{
+  std::string poiType;
+  /* Convert the POI Type to String to be stored in the POI file */
+  bool isValidType = type_mapping::convertPoiTypeToString(poi.getType(),
+                                                          poiType);
+  file.append("\t  {\n\t\t\"name\":");
+  appendJsonString(file, poi.getName());
+  file.append(",\n\t\t\"latitude\":");
+  file.appendDouble(poi.getLatitude());
+  file.append(",\n\t\t\"longitude\":");
+  file.appendDouble(poi.getLongitude());
+  file.append(",\n\t\t\"description\":");
+  appendJsonString(file, poi.getDescription());
+  file.append(",\n\t\t\"type\":");
+  appendJsonString(file, poiType);
+  file.append("\n\t  }");
+  return isValidType;
+}
+/**
+ * Write the data to the persistent storage. The objects are serialized
+ * straight from the databases into the buffer of the file, which is written
+ * in chunks of WRITE_BUFFER_SIZE bytes, so the memory used does not grow
+ * with the size of the databases.
  *
  * @param waypointDb[IN] the data base with way points
  * @param poiDb[IN] the database with points of interest
@@ -716,24 +1498,52 @@ bool CJsonPersistence::writeToJsonFile()
 bool CJsonPersistence::writeData(const CWpDatabase &waypointDb,
                                  const CPoiDatabase &poiDb)
 {
-  bool retVal = true;
-
-  CPoiDatabase::POIDatabaseMap_t poiDbMap;
-  CWpDatabase::WaypointDatabaseMap_t wpDbMap;
-
-  /* Get Waypoint Database contents from the map and write to Json File */
-  waypointDb.getWpDatabase(wpDbMap);
-  jsonFileContents.push_back("\t\"waypoints\": [");
-  convertToJsonFormat(wpDbMap);
-  jsonFileContents.push_back("\t],");
-
-  /* Get Waypoint POI contents from the map and write to Json File */
-  poiDb.getPoiDatabase(poiDbMap);
-  jsonFileContents.push_back("\t\"pois\": [");
-  convertToJsonFormat(poiDbMap);
-  jsonFileContents.push_back("\t]");
+  CBufferedWriter jsonFile;
+  if (!jsonFile.open(m_fileName))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CJsonPersistence::writeData() failed: Unable to open " +
+            m_fileName);
+    return false;
+  }
+  jsonFile.append(JSON_BEGIN_STRING "\n\t\"" WAYPOINTS_ARRAY_NAME "\": [\n");
+  for (CWpDatabase::const_iterator itr = waypointDb.begin();
+       itr != waypointDb.end(); ++itr)
+  {
+    if (itr != waypointDb.begin())
+    {
+      jsonFile.append(",\n");
+    }
+    appendWaypointObject(jsonFile, itr->second);
+  }
+  jsonFile.append(waypointDb.begin() == waypointDb.end() ? "" : "\n");
 
-  retVal = writeToJsonFile();
+  jsonFile.append("\t],\n\t\"" POI_ARRAY_NAME "\": [\n");
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    if (itr != poiDb.begin())
+    {
+      jsonFile.append(",\n");
+    }
+    if (!appendPoiObject(jsonFile, itr->second))
+    {
+      CDiagnostics::report(
+          CDiagnostics::INVALID_VALUE,
+          "ERROR!JSON::writeData() failed! Invalid POI Type!");
+    }
+  }
+  jsonFile.append(poiDb.begin() == poiDb.end() ? "" : "\n");
+  jsonFile.append("\t]\n" JSON_END_STRING);
 
-  return retVal;
+  if (!jsonFile.close())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CJsonPersistence::writeData() failed: Unable to write " +
+            m_fileName);
+    return false;
+  }
+  return true;
 }
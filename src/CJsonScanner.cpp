@@ -12,29 +12,27 @@ using namespace std;
 
 namespace APT {
 
-CJsonScanner::CJsonScanner(std::istream &input) : jsonFlexLexer(&input) {
-  token = 0;
-}
+CJsonScanner::CJsonScanner(std::istream &input) : jsonFlexLexer(&input) {}
 
-CJsonScanner::~CJsonScanner() {
-  if (token != 0) {
-    delete token;
-  }
-}
+CJsonScanner::~CJsonScanner() {}
 
 CJsonToken *CJsonScanner::nextToken() {
-  if (token != 0) {
-    delete token;
-    token = 0;
+  bool isIllegal = false;
+  CJsonToken *pToken = nextToken(isIllegal);
+  if (isIllegal) {
+    throw illegalChar();
   }
+  return pToken;
+}
+
+CJsonToken *CJsonScanner::nextToken(bool &isIllegal) {
   int scanResult = yylex();
-  if (scanResult == -1) {
-    string illegalChar(YYText());
-    throw illegalChar;
-  }
-  return token;
+  isIllegal = (scanResult == -1);
+  return (scanResult <= 0) ? 0 : &token;
 }
 
+string CJsonScanner::illegalChar() { return string(YYText()); }
+
 int CJsonScanner::scannedLine() { return yylineno; }
 
 } /* namespace APT */
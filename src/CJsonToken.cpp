@@ -6,18 +6,16 @@
  */
 
 #include <nsp/CJsonToken.h>
+#include <sstream>
 
 using namespace std;
 
 namespace APT {
 
-CJsonToken::CJsonToken(TokenType type) { this->type = type; }
+CJsonToken::CJsonToken() : type(JSON_NULL), number(0), boolean(false) {}
 
-CJsonToken::~CJsonToken() {}
-
-CJsonToken::TokenType CJsonToken::getType() { return type; }
-
-string CJsonToken::str() {
+string CJsonToken::str() const {
+  ostringstream res;
   switch (type) {
   case BEGIN_OBJECT:
     return "begin_object";
@@ -32,11 +30,14 @@ string CJsonToken::str() {
   case VALUE_SEPARATOR:
     return "value_separator";
   case STRING:
-    return "string";
+    res << "string: " << text;
+    return res.str();
   case NUMBER:
-    return "number";
+    res << "number: " << number;
+    return res.str();
   case BOOL:
-    return "bool";
+    res << "bool: " << boolean;
+    return res.str();
   case JSON_NULL:
     return "null";
   }
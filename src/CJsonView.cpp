@@ -0,0 +1,60 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CJsonView.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CJsonView
+****************************************************************************/
+#include <nsp/CJsonView.h>
+
+/**
+ * Maps the file and removes the records of a previous file
+ * @param const std::string& fileName [IN] - Name of the JSON file
+ * @return true if the file could be mapped, false otherwise
+ */
+bool CJsonView::open(const std::string &fileName)
+{
+  clearRecords();
+  return m_file.open(fileName);
+}
+/**
+ * Removes the records and releases the mapping
+ * @param None
+ * @return None
+ */
+void CJsonView::close(void)
+{
+  clearRecords();
+  m_file.close();
+}
+/**
+ * Removes the records, the file stays mapped
+ * @param None
+ * @return None
+ */
+void CJsonView::clearRecords(void)
+{
+  m_waypoints.clear();
+  m_pois.clear();
+}
+/**
+ * Materializes a waypoint of the view
+ * @param size_t index [IN] - Index of the record
+ * @return CWaypoint - The waypoint as readData() stores it
+ */
+CWaypoint CJsonView::getWaypointObject(size_t index) const
+{
+  const record_t &record = m_waypoints[index];
+  return CWaypoint(record.latitude, record.longitude, getName(record));
+}
+/**
+ * Materializes a POI of the view
+ * @param size_t index [IN] - Index of the record
+ * @return CPOI - The POI as readData() stores it
+ */
+CPOI CJsonView::getPoiObject(size_t index) const
+{
+  const record_t &record = m_pois[index];
+  return CPOI(record.type, getName(record), getDescription(record),
+              record.latitude, record.longitude);
+}
@@ -0,0 +1,572 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CMapMatcher.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CMapMatcher
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CMapMatcher.h>
+#include <nsp/GeoMath.h>
+
+#define DEFAULT_SEARCH_RADIUS (0.1) /**< @brief Represents 100 m */
+#define DEFAULT_GPS_SIGMA (0.02)    /**< @brief Represents 20 m */
+#define DEFAULT_BETA (0.05)         /**< @brief Represents 50 m */
+#define DEFAULT_MAX_CANDIDATES (8)  /**< @brief Represents the candidates per
+                                       fix */
+#define DEFAULT_MAX_LAG (10) /**< @brief Represents the online latency bound
+                                in fixes */
+#define MAX_DETOUR_BETAS (10) /**< @brief Represents the largest detour in
+                                 multiples of beta which is still searched,
+                                 longer detours are about e^-10 less likely */
+#define KM_PER_DEGREE                                                        \
+  (EARTH_RADIUS_LENGTH * PI / 180) /**< @brief Represents the length of one
+                                      degree of latitude */
+#define MIN_CELL_SIZE (1e-5) /**< @brief Represents the smallest cell size
+                                in degree (about 1 m) */
+#define MAX_GRID_CELLS                                                       \
+  (1u << 22) /**< @brief Represents the largest number of cells */
+#define MIN_COS_LATITUDE (1e-6) /**< @brief Represents the cosine below which
+                                   a fix counts as a pole */
+#define NO_PARENT (static_cast<unsigned int>(-1)) /**< @brief Represents the
+                                                     first fix of a chain */
+
+/**
+ * Constructor of CMapMatcher class, uses the default parameters
+ * @param const CRoutingGraph& graph [IN] - The finalized graph to be
+ * matched onto. It must outlive the CMapMatcher object.
+ */
+CMapMatcher::CMapMatcher(const CRoutingGraph &graph)
+    : m_pGraph(&graph), m_minLatitude(0), m_minLongitude(0), m_cellSize(1),
+      m_rows(0), m_columns(0), m_currentStamp(0)
+{
+  m_parameters.searchRadius = DEFAULT_SEARCH_RADIUS;
+  m_parameters.gpsSigma = DEFAULT_GPS_SIGMA;
+  m_parameters.transitionBeta = DEFAULT_BETA;
+  m_parameters.maxCandidates = DEFAULT_MAX_CANDIDATES;
+  m_parameters.maxLag = DEFAULT_MAX_LAG;
+  buildGrid();
+}
+/**
+ * Sets the model parameters and resets the online state. The grid is
+ * rebuilt, since its cell size follows the search radius.
+ * @param const matchParameters_t& parameters [IN] - The parameters
+ * @return true if the parameters are valid, false otherwise
+ */
+bool CMapMatcher::setParameters(const matchParameters_t &parameters)
+{
+  if (!(parameters.searchRadius > 0) || !(parameters.gpsSigma > 0) ||
+      !(parameters.transitionBeta > 0) || (0 == parameters.maxCandidates))
+  {
+    CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                         "ERROR!CMapMatcher::setParameters() failed! Invalid "
+                         "parameters!");
+    return false;
+  }
+  m_parameters = parameters;
+  buildGrid();
+  reset();
+  return true;
+}
+/**
+ * Sorts the nodes of the graph into a uniform grid whose cells are about
+ * as large as the search radius, so a candidate lookup scans only a few
+ * cells. The nodes are bucketed with a counting sort.
+ * @param None
+ * @return None
+ */
+void CMapMatcher::buildGrid(void)
+{
+  const CRoutingGraph &graph = *m_pGraph;
+  node_t nodeCount = graph.getNodeCount();
+  m_entries.clear();
+  m_cellOffsets.assign(1, 0);
+  m_rows = m_columns = 0;
+  if (0 == nodeCount)
+  {
+    return;
+  }
+  double maxLatitude = -HUGE_VAL, maxLongitude = -HUGE_VAL;
+  m_minLatitude = m_minLongitude = HUGE_VAL;
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    m_minLatitude = std::min(m_minLatitude, graph.getLatitude(node));
+    m_minLongitude = std::min(m_minLongitude, graph.getLongitude(node));
+    maxLatitude = std::max(maxLatitude, graph.getLatitude(node));
+    maxLongitude = std::max(maxLongitude, graph.getLongitude(node));
+  }
+  double latitudeRange = maxLatitude - m_minLatitude;
+  double longitudeRange = maxLongitude - m_minLongitude;
+  m_cellSize =
+      std::max(m_parameters.searchRadius / KM_PER_DEGREE, MIN_CELL_SIZE);
+  while (((latitudeRange / m_cellSize) + 1) *
+             ((longitudeRange / m_cellSize) + 1) >
+         MAX_GRID_CELLS)
+  {
+    m_cellSize *= 2;
+  }
+  m_rows = (unsigned int)(latitudeRange / m_cellSize) + 1;
+  m_columns = (unsigned int)(longitudeRange / m_cellSize) + 1;
+
+  size_t cellCount = (size_t)m_rows * m_columns;
+  std::vector<unsigned int> cellOfNode(nodeCount);
+  m_cellOffsets.assign(cellCount + 1, 0);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    unsigned int row = (unsigned int)std::min(
+        (double)m_rows - 1,
+        floor((graph.getLatitude(node) - m_minLatitude) / m_cellSize));
+    unsigned int column = (unsigned int)std::min(
+        (double)m_columns - 1,
+        floor((graph.getLongitude(node) - m_minLongitude) / m_cellSize));
+    cellOfNode[node] = row * m_columns + column;
+    m_cellOffsets[cellOfNode[node] + 1]++;
+  }
+  for (size_t cell = 0; cell < cellCount; cell++)
+  {
+    m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+  }
+  std::vector<unsigned int> insertPos(m_cellOffsets.begin(),
+                                      m_cellOffsets.end() - 1);
+  m_entries.resize(nodeCount);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    double latitudeRad = geo_math::degreeToRadian(graph.getLatitude(node));
+    gridEntry_t &entry = m_entries[insertPos[cellOfNode[node]]++];
+    entry.sinLatitude = sin(latitudeRad);
+    entry.cosLatitude = cos(latitudeRad);
+    entry.longitudeRad = geo_math::degreeToRadian(graph.getLongitude(node));
+    entry.node = node;
+  }
+}
+/**
+ * Collects the nodes within the search radius of a fix. Only the nearest
+ * maxCandidates are kept, sorted by their distance. The score of every
+ * candidate is set to its emission log probability.
+ * @param double latitude [IN] - Latitude of the fix
+ * @param double longitude [IN] - Longitude of the fix
+ * @param step_t& step [IN/OUT] - The fix, its trigonometry must be set
+ * @return None
+ */
+void CMapMatcher::findCandidates(double latitude, double longitude,
+                                 step_t &step) const
+{
+  step.candidates.clear();
+  if (0 == m_rows)
+  {
+    return;
+  }
+  double radius = m_parameters.searchRadius;
+  double latitudeRadius = radius / KM_PER_DEGREE;
+  double longitudeRadius = (step.cosLatitude > MIN_COS_LATITUDE)
+                               ? latitudeRadius / step.cosLatitude
+                               : 360;
+  double firstRow = floor((latitude - latitudeRadius - m_minLatitude) /
+                          m_cellSize);
+  double lastRow = floor((latitude + latitudeRadius - m_minLatitude) /
+                         m_cellSize);
+  double firstColumn = floor(
+      (longitude - longitudeRadius - m_minLongitude) / m_cellSize);
+  double lastColumn = floor(
+      (longitude + longitudeRadius - m_minLongitude) / m_cellSize);
+  if ((lastRow < 0) || (firstRow >= m_rows) || (lastColumn < 0) ||
+      (firstColumn >= m_columns))
+  {
+    return; /* Fix is outside the grid */
+  }
+  unsigned int rowBegin = (unsigned int)std::max(0.0, firstRow);
+  unsigned int rowEnd = (unsigned int)std::min((double)m_rows - 1, lastRow);
+  unsigned int columnBegin = (unsigned int)std::max(0.0, firstColumn);
+  unsigned int columnEnd =
+      (unsigned int)std::min((double)m_columns - 1, lastColumn);
+
+  for (unsigned int row = rowBegin; row <= rowEnd; row++)
+  {
+    unsigned int cell = row * m_columns;
+    for (unsigned int entry = m_cellOffsets[cell + columnBegin];
+         entry < m_cellOffsets[cell + columnEnd + 1]; entry++)
+    {
+      const gridEntry_t &node = m_entries[entry];
+      double distance = geo_math::greatCircleDistance(
+          step.sinLatitude, step.cosLatitude, step.longitudeRad,
+          node.sinLatitude, node.cosLatitude, node.longitudeRad);
+      if (distance <= radius)
+      {
+        candidate_t candidate = {node.node, distance, 0, NO_PARENT};
+        step.candidates.push_back(candidate);
+      }
+    }
+  }
+  struct {
+    bool operator()(const candidate_t &a, const candidate_t &b) const {
+      return a.distance < b.distance;
+    }
+  } nearerFirst;
+  if (step.candidates.size() > m_parameters.maxCandidates)
+  {
+    std::partial_sort(step.candidates.begin(),
+                      step.candidates.begin() + m_parameters.maxCandidates,
+                      step.candidates.end(), nearerFirst);
+    step.candidates.resize(m_parameters.maxCandidates);
+  }
+  else
+  {
+    std::sort(step.candidates.begin(), step.candidates.end(), nearerFirst);
+  }
+  double sigma = m_parameters.gpsSigma;
+  for (size_t i = 0; i < step.candidates.size(); i++)
+  {
+    double normalized = step.candidates[i].distance / sigma;
+    step.candidates[i].score = -0.5 * normalized * normalized;
+  }
+}
+/**
+ * Computes the route lengths from a node to all candidates of a fix with
+ * one Dijkstra search. The search stops once all candidates are settled or
+ * the route exceeds the given length. Unreached candidates keep HUGE_VAL.
+ * @param node_t source [IN] - Start node
+ * @param const step_t& step [IN] - The fix whose candidates are searched
+ * @param double maxLength [IN] - Longest route of interest in km
+ * @return None
+ */
+void CMapMatcher::findRouteLengths(node_t source, const step_t &step,
+                                   double maxLength)
+{
+  const CRoutingGraph &graph = *m_pGraph;
+  node_t nodeCount = graph.getNodeCount();
+  if (m_visitStamp.size() != nodeCount)
+  {
+    m_cost.assign(nodeCount, 0);
+    m_visitStamp.assign(nodeCount, 0);
+    m_settledStamp.assign(nodeCount, 0);
+    m_targetStamp.assign(nodeCount, 0);
+    m_targetIndex.assign(nodeCount, 0);
+    m_currentStamp = 0;
+  }
+  if (0 == ++m_currentStamp) /* Stamp counter wrapped around */
+  {
+    std::fill(m_visitStamp.begin(), m_visitStamp.end(), 0);
+    std::fill(m_settledStamp.begin(), m_settledStamp.end(), 0);
+    std::fill(m_targetStamp.begin(), m_targetStamp.end(), 0);
+    m_currentStamp = 1;
+  }
+  size_t openTargets = step.candidates.size();
+  m_routeLength.assign(openTargets, HUGE_VAL);
+  for (size_t i = 0; i < step.candidates.size(); i++)
+  {
+    m_targetStamp[step.candidates[i].node] = m_currentStamp;
+    m_targetIndex[step.candidates[i].node] = i;
+  }
+
+  std::greater<queueEntry_t> heapOrder; /* Min-heap on route length */
+  m_openList.clear();
+  m_cost[source] = 0;
+  m_visitStamp[source] = m_currentStamp;
+  m_openList.push_back(queueEntry_t(0, source));
+  while (!m_openList.empty())
+  {
+    std::pop_heap(m_openList.begin(), m_openList.end(), heapOrder);
+    double nodeCost = m_openList.back().first;
+    node_t node = m_openList.back().second;
+    m_openList.pop_back();
+    if (nodeCost > maxLength)
+      break;
+    if (m_settledStamp[node] == m_currentStamp) /* Outdated entry */
+      continue;
+    m_settledStamp[node] = m_currentStamp;
+
+    if (m_targetStamp[node] == m_currentStamp)
+    {
+      m_routeLength[m_targetIndex[node]] = nodeCost;
+      if (0 == --openTargets)
+        break;
+    }
+    for (edge_t edge = graph.getEdgeBegin(node); edge < graph.getEdgeEnd(node);
+         edge++)
+    {
+      node_t next = graph.getEdgeTarget(edge);
+      double nextCost = nodeCost + graph.getEdgeWeight(edge);
+      if ((m_visitStamp[next] != m_currentStamp) || (nextCost < m_cost[next]))
+      {
+        m_visitStamp[next] = m_currentStamp;
+        m_cost[next] = nextCost;
+        m_openList.push_back(queueEntry_t(nextCost, next));
+        std::push_heap(m_openList.begin(), m_openList.end(), heapOrder);
+      }
+    }
+  }
+}
+/**
+ * Adds a fix to the model (one Viterbi step) and decides the fixes which
+ * became final. The scores are shifted so that the best candidate of the
+ * newest fix scores 0, which keeps them small on long traces.
+ * @param double latitude [IN] - Latitude of the fix
+ * @param double longitude [IN] - Longitude of the fix
+ * @param unsigned int maxLag [IN] - Age at which a fix is decided, 0 for
+ * none
+ * @return None
+ */
+void CMapMatcher::processFix(double latitude, double longitude,
+                             unsigned int maxLag)
+{
+  double latitudeRad = geo_math::degreeToRadian(latitude);
+  m_window.push_back(step_t());
+  step_t &step = m_window.back();
+  step.sinLatitude = sin(latitudeRad);
+  step.cosLatitude = cos(latitudeRad);
+  step.longitudeRad = geo_math::degreeToRadian(longitude);
+  findCandidates(latitude, longitude, step);
+
+  if (step.candidates.empty()) /* Break the chain, nothing to match */
+  {
+    m_window.pop_back();
+    decideAll();
+    m_matches.push_back(CRoutingGraph::INVALID_NODE);
+    return;
+  }
+  if (m_window.size() > 1)
+  {
+    const step_t &previous = m_window[m_window.size() - 2];
+    double fixDistance = geo_math::greatCircleDistance(
+        previous.sinLatitude, previous.cosLatitude, previous.longitudeRad,
+        step.sinLatitude, step.cosLatitude, step.longitudeRad);
+    double maxLength = fixDistance + 2 * m_parameters.searchRadius +
+                       MAX_DETOUR_BETAS * m_parameters.transitionBeta;
+    double beta = m_parameters.transitionBeta;
+
+    std::vector<double> emission(step.candidates.size());
+    for (size_t i = 0; i < step.candidates.size(); i++)
+    {
+      emission[i] = step.candidates[i].score;
+      step.candidates[i].score = -HUGE_VAL;
+    }
+    for (size_t from = 0; from < previous.candidates.size(); from++)
+    {
+      const candidate_t &source = previous.candidates[from];
+      if (-HUGE_VAL == source.score)
+        continue;
+      findRouteLengths(source.node, step, maxLength);
+      for (size_t to = 0; to < step.candidates.size(); to++)
+      {
+        if (HUGE_VAL == m_routeLength[to])
+          continue;
+        double score =
+            source.score - fabs(m_routeLength[to] - fixDistance) / beta;
+        if (score > step.candidates[to].score)
+        {
+          step.candidates[to].score = score;
+          step.candidates[to].parent = from;
+        }
+      }
+    }
+    double bestScore = -HUGE_VAL;
+    for (size_t i = 0; i < step.candidates.size(); i++)
+    {
+      if (-HUGE_VAL != step.candidates[i].score)
+      {
+        step.candidates[i].score += emission[i];
+        bestScore = std::max(bestScore, step.candidates[i].score);
+      }
+    }
+    if (-HUGE_VAL == bestScore) /* Not connected, break the chain */
+    {
+      step_t brokenStep;
+      brokenStep.sinLatitude = step.sinLatitude;
+      brokenStep.cosLatitude = step.cosLatitude;
+      brokenStep.longitudeRad = step.longitudeRad;
+      brokenStep.candidates.swap(step.candidates);
+      for (size_t i = 0; i < brokenStep.candidates.size(); i++)
+      {
+        brokenStep.candidates[i].score = emission[i];
+        brokenStep.candidates[i].parent = NO_PARENT;
+      }
+      m_window.pop_back();
+      decideAll();
+      m_window.push_back(brokenStep);
+    }
+    else
+    {
+      for (size_t i = 0; i < step.candidates.size(); i++)
+      {
+        step.candidates[i].score -= bestScore;
+      }
+    }
+  }
+  decideConverged();
+
+  if ((0 != maxLag) && (m_window.size() > maxLag))
+  {
+    /* Follow the currently best path back to the fix which is too old */
+    const step_t &newest = m_window.back();
+    unsigned int candidate = 0;
+    for (unsigned int i = 1; i < newest.candidates.size(); i++)
+    {
+      if (newest.candidates[i].score > newest.candidates[candidate].score)
+        candidate = i;
+    }
+    size_t decidePos = m_window.size() - 1 - maxLag;
+    for (size_t pos = m_window.size() - 1; pos > decidePos; pos--)
+    {
+      candidate = m_window[pos].candidates[candidate].parent;
+    }
+    decide(decidePos, candidate);
+  }
+}
+/**
+ * Decides the oldest fixes up to and including the given window position,
+ * following the best path back from the given candidate. The decided fixes
+ * leave the window.
+ * @param size_t windowPos [IN] - Position of the newest fix to be decided
+ * @param unsigned int candidate [IN] - Chosen candidate of that fix
+ * @return None
+ */
+void CMapMatcher::decide(size_t windowPos, unsigned int candidate)
+{
+  m_backtrack.clear();
+  for (size_t pos = windowPos + 1; pos > 0; pos--)
+  {
+    const candidate_t &chosen = m_window[pos - 1].candidates[candidate];
+    m_backtrack.push_back(chosen.node);
+    candidate = chosen.parent;
+  }
+  m_matches.insert(m_matches.end(), m_backtrack.rbegin(), m_backtrack.rend());
+  m_window.erase(m_window.begin(), m_window.begin() + windowPos + 1);
+}
+/**
+ * Decides all fixes of the window along the best path of the newest fix
+ * @param None
+ * @return None
+ */
+void CMapMatcher::decideAll(void)
+{
+  if (m_window.empty())
+  {
+    return;
+  }
+  const step_t &newest = m_window.back();
+  unsigned int best = 0;
+  for (unsigned int i = 1; i < newest.candidates.size(); i++)
+  {
+    if (newest.candidates[i].score > newest.candidates[best].score)
+      best = i;
+  }
+  decide(m_window.size() - 1, best);
+}
+/**
+ * Decides the fixes on which all best paths agree. The best paths of the
+ * candidates of the newest fix are followed back together until they all
+ * pass through one candidate; whatever happens later, the Viterbi path
+ * runs through it. The newest fix itself stays in the window, since the
+ * next fix is connected to its candidates.
+ * @param None
+ * @return None
+ */
+void CMapMatcher::decideConverged(void)
+{
+  const step_t &newest = m_window.back();
+  m_liveCandidates.clear();
+  for (unsigned int i = 0; i < newest.candidates.size(); i++)
+  {
+    if (-HUGE_VAL != newest.candidates[i].score)
+      m_liveCandidates.push_back(i);
+  }
+  for (size_t pos = m_window.size() - 1; pos > 0; pos--)
+  {
+    const step_t &step = m_window[pos];
+    for (size_t i = 0; i < m_liveCandidates.size(); i++)
+    {
+      m_liveCandidates[i] = step.candidates[m_liveCandidates[i]].parent;
+    }
+    std::sort(m_liveCandidates.begin(), m_liveCandidates.end());
+    m_liveCandidates.erase(
+        std::unique(m_liveCandidates.begin(), m_liveCandidates.end()),
+        m_liveCandidates.end());
+    if (1 == m_liveCandidates.size())
+    {
+      decide(pos - 1, m_liveCandidates[0]);
+      return;
+    }
+  }
+}
+/**
+ * Matches a whole trace. The result is the exact Viterbi path, maxLag is
+ * not applied.
+ * @param const double* latitudes [IN] - Latitudes of the fixes
+ * @param const double* longitudes [IN] - Longitudes of the fixes
+ * @param size_t count [IN] - Number of fixes
+ * @param std::vector<node_t>& nodes [OUT] - Matched node of every fix,
+ * INVALID_NODE if the fix has no candidate
+ * @return None
+ */
+void CMapMatcher::match(const double *latitudes, const double *longitudes,
+                        size_t count, std::vector<node_t> &nodes)
+{
+  reset();
+  nodes.clear();
+  nodes.reserve(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    processFix(latitudes[i], longitudes[i], 0);
+    nodes.insert(nodes.end(), m_matches.begin(), m_matches.end());
+    m_matches.clear();
+  }
+  flush();
+  nodes.insert(nodes.end(), m_matches.begin(), m_matches.end());
+  m_matches.clear();
+}
+/**
+ * Adds the next fix of an online trace
+ * @param double latitude [IN] - Latitude of the fix
+ * @param double longitude [IN] - Longitude of the fix
+ * @return None
+ */
+void CMapMatcher::addFix(double latitude, double longitude)
+{
+  processFix(latitude, longitude, m_parameters.maxLag);
+}
+/**
+ * Adds the next fix of an online trace, e.g. from CGPSSensor
+ * @param const CWaypoint& fix [IN] - The fix
+ * @return None
+ */
+void CMapMatcher::addFix(const CWaypoint &fix)
+{
+  processFix(fix.getLatitude(), fix.getLongitude(), m_parameters.maxLag);
+}
+/**
+ * Fetches the match of the oldest decided fix of the online trace
+ * @param node_t& node [OUT] - Matched node, INVALID_NODE if the fix has no
+ * candidate
+ * @return true if a decided fix was available, false otherwise
+ */
+bool CMapMatcher::getMatch(node_t &node)
+{
+  if (m_matches.empty())
+  {
+    return false;
+  }
+  node = m_matches.front();
+  m_matches.pop_front();
+  return true;
+}
+/**
+ * Decides all pending fixes, e.g. at the end of a trace
+ * @param None
+ * @return None
+ */
+void CMapMatcher::flush(void) { decideAll(); }
+/**
+ * Drops all pending and decided fixes
+ * @param None
+ * @return None
+ */
+void CMapMatcher::reset(void)
+{
+  m_window.clear();
+  m_matches.clear();
+}
@@ -0,0 +1,85 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CMappedFile.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CMappedFile
+****************************************************************************/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nsp/CMappedFile.h>
+
+static const char EMPTY_FILE_DATA[1] = {
+    0}; /**< @brief Represents the contents of an empty file */
+
+CMappedFile::CMappedFile() : m_pData(NULL), m_size(0) {}
+
+CMappedFile::~CMappedFile() { close(); }
+/**
+ * Maps the file into memory. A previously mapped file is released.
+ * @param const std::string& fileName [IN] - Name of the file to be mapped
+ * @return true if the file could be mapped, false otherwise
+ */
+bool CMappedFile::open(const std::string &fileName)
+{
+  close();
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat fileStat;
+  bool retVal = false;
+  if (0 == fstat(fd, &fileStat))
+  {
+    if (0 == fileStat.st_size) /* mmap does not accept empty mappings */
+    {
+      m_pData = EMPTY_FILE_DATA;
+      m_size = 0;
+      retVal = true;
+    }
+    else
+    {
+      void *pMapping =
+          mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (MAP_FAILED != pMapping)
+      {
+        m_pData = static_cast<const char *>(pMapping);
+        m_size = fileStat.st_size;
+        retVal = true;
+      }
+    }
+  }
+  /* The mapping stays valid after the descriptor is closed */
+  ::close(fd);
+  return retVal;
+}
+/**
+ * Releases the mapping
+ * @param None
+ * @return None
+ */
+void CMappedFile::close(void)
+{
+  if ((NULL != m_pData) && (EMPTY_FILE_DATA != m_pData))
+  {
+    munmap(const_cast<char *>(m_pData), m_size);
+  }
+  m_pData = NULL;
+  m_size = 0;
+}
+/**
+ * Advises the kernel that the mapping will be read sequentially once
+ * @param None
+ * @return None
+ */
+void CMappedFile::adviseSequential(void) const
+{
+  if ((NULL != m_pData) && (0 != m_size))
+  {
+    madvise(const_cast<char *>(m_pData), m_size, MADV_SEQUENTIAL);
+  }
+}
@@ -237,6 +237,67 @@ void CNavigationSystem::TC_readReplaceMode()
   wpDb.print();
 #endif
 }
+void CNavigationSystem::TC_findShortestRoute()
+{
+  std::cout << "============================================================"
+            << std::endl;
+  std::cout << "TestCase Executed: " << __FUNCTION__ << std::endl;
+  std::cout << "============================================================"
+            << std::endl;
+
+  if (!m_routingGraph.loadFromFile("src/FileIO-edges.txt", m_WpDatabase))
+  {
+    return;
+  }
+  CRouteFinder routeFinder(m_routingGraph);
+  CRoute shortestRoute;
+  shortestRoute.connectToPoiDatabase(&m_PoiDatabase);
+  shortestRoute.connectToWpDatabase(&m_WpDatabase);
+
+  double distance = 0;
+  if (routeFinder.findRoute("H_da", "Stuttgart", shortestRoute, distance))
+  {
+    std::cout << "Shortest route H_da -> Stuttgart: " << distance << " km"
+              << std::endl;
+    shortestRoute.print();
+  }
+}
+void CNavigationSystem::TC_findHierarchyRoute()
+{
+  std::cout << "============================================================"
+            << std::endl;
+  std::cout << "TestCase Executed: " << __FUNCTION__ << std::endl;
+  std::cout << "============================================================"
+            << std::endl;
+
+  /* Offline stage, normally done by the nspBuildHierarchy tool */
+  if (!m_routingGraph.loadFromFile("src/FileIO-edges.txt", m_WpDatabase))
+  {
+    return;
+  }
+  m_hierarchy.build(m_routingGraph);
+  if (!m_hierarchy.writeToFile("src/FileIO-edges.ch"))
+  {
+    return;
+  }
+  /* Startup: map the hierarchy instead of building it */
+  if (!m_hierarchy.openFile("src/FileIO-edges.ch"))
+  {
+    return;
+  }
+  CHierarchyRouteFinder routeFinder(m_hierarchy);
+  CRoute shortestRoute;
+  shortestRoute.connectToPoiDatabase(&m_PoiDatabase);
+  shortestRoute.connectToWpDatabase(&m_WpDatabase);
+
+  double distance = 0;
+  if (routeFinder.findRoute("H_da", "Stuttgart", shortestRoute, distance))
+  {
+    std::cout << "Shortest route H_da -> Stuttgart: " << distance << " km"
+              << std::endl;
+    shortestRoute.print();
+  }
+}
 /**
  * Run method starts the Navigation System
  * Performs route creation/addition
@@ -256,6 +317,8 @@ void CNavigationSystem::run(void)
   // TC_routeCopyConstructor();
   // TC_createDatabases();
   // TC_writeToFile();
+  // TC_findShortestRoute();
+  // TC_findHierarchyRoute();
   TC_readMergeMode();
 
 #if 0
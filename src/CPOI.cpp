@@ -14,6 +14,7 @@
  ****************************************************************************/
 #include <string>
 // Own Include Files
+#include <nsp/CDiagnostics.h>
 #include <nsp/CPOI.h>
 
 #define SPACE_CHAR " " /**< @brief Represents Space character */
@@ -71,7 +72,8 @@ bool CPOI::set(CPOI::t_poi type, std::string name, std::string description,
     else
     {
       isValidPoi = false;
-      std::cout << "ERROR!Invalid Poi Type!" << std::endl;
+      CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                           "ERROR!Invalid Poi Type!");
       break;
     }
     if (description.find_first_not_of(' ') != std::string::npos)
@@ -81,7 +83,8 @@ bool CPOI::set(CPOI::t_poi type, std::string name, std::string description,
     else
     {
       isValidPoi = false;
-      std::cout << "--ERROR!Invalid Poi Description!" << std::endl;
+      CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                           "--ERROR!Invalid Poi Description!");
       break;
     }
     if ((isValidPoi = CWaypoint::set(name, latitude, longitude)))
@@ -7,12 +7,58 @@
  * This class maintains the database which consists of
  * CPOI objects.
  ****************************************************************************/
+#include <algorithm>
+
+#include <nsp/CDiagnostics.h>
 // Own Include Files
 #include <nsp/CPoiDatabase.h>
+#include <nsp/CPoiTileStore.h>
+
+#define MAP_NODE_SIZE \
+  (4 * sizeof(void *)) /**< @brief Represents the links and the colour of a
+                          node of the map */
+
+/**
+ * Estimates the memory of a POI in the Database: the node of the map, the
+ * key and the strings which do not fit into the objects
+ * @param const CPOI& poi [IN] - The POI
+ * @return size_t - The bytes
+ */
+static size_t getPoiMemory(const CPOI &poi)
+{
+  return MAP_NODE_SIZE + sizeof(std::string) + sizeof(CPOI) +
+         2 * poi.getName().size() + poi.getDescription().size();
+}
 
 // Method Implementations
 
-CPoiDatabase::CPoiDatabase() {}
+CPoiDatabase::CPoiDatabase()
+    : m_tileMemory(0), m_tileMemoryLimit(DEFAULT_TILE_MEMORY)
+{
+}
+
+CPoiDatabase::~CPoiDatabase() {}
+/**
+ * Copies the POIs. The copy has no tiled file, the POIs of the loaded
+ * tiles are ordinary POIs of the copy.
+ * @param const CPoiDatabase& other [IN] - The Database to copy
+ */
+CPoiDatabase::CPoiDatabase(const CPoiDatabase &other)
+    : CDatabase(other), m_tileMemory(0),
+      m_tileMemoryLimit(other.m_tileMemoryLimit)
+{
+}
+
+CPoiDatabase &CPoiDatabase::operator=(const CPoiDatabase &other)
+{
+  if (this != &other)
+  {
+    CDatabase::operator=(other);
+    closeTiles();
+    m_tileMemoryLimit = other.m_tileMemoryLimit;
+  }
+  return *this;
+}
 /**
 * Add a POI to the POIDatabase
 * If the POI table is not full, adds the POI with the given attributes to the
@@ -25,6 +71,27 @@ void CPoiDatabase::addPoi(CPOI const &poi)
 {
   CDatabase::addData(poi.getName(), poi);
 }
+/**
+ * Adds the POI or replaces the POI of the same name. A replaced POI of a
+ * loaded tile is no longer removed with the tile.
+ * @param const CPOI& poi [IN] - Reference to the POI object
+ * @return None
+ */
+void CPoiDatabase::updatePoi(const CPOI &poi)
+{
+  releaseTilePoi(poi.getName());
+  CDatabase::updateData(poi.getName(), poi);
+}
+/**
+ * Removes the POI from the POI Database
+ * @param const std::string& name [IN] - Name (Key value) of the POI
+ * @return true if the POI was present, false otherwise
+ */
+bool CPoiDatabase::removePoi(const std::string &name)
+{
+  releaseTilePoi(name);
+  return CDatabase::removeData(name);
+}
 /**
  * Get Pointer to the POI object in the POI Database
  * Note: If no match is found NULL is returned
@@ -57,6 +124,167 @@ void CPoiDatabase::clearPoiDatabase(void)
 {
   /* Clear the contents of the Database */
   CDatabase::clearDatabase();
+  resetTiles();
+}
+/**
+ * Removes a POI from the names of its loaded tile, so that its tile no
+ * longer removes it. The tile is found by the position of the POI.
+ * @param const std::string& name [IN] - Name of the POI
+ * @return None
+ */
+void CPoiDatabase::releaseTilePoi(const std::string &name)
+{
+  const CPOI *pPoi = CDatabase::findData(name);
+  if (m_tiles.empty() || (NULL == pPoi))
+  {
+    return;
+  }
+  TileMap_t::iterator itr = m_tiles.find(
+      m_pTileStore->getTileKey(pPoi->getLatitude(), pPoi->getLongitude()));
+  if (itr == m_tiles.end())
+  {
+    return;
+  }
+  std::vector<std::string> &names = itr->second.names;
+  std::vector<std::string>::iterator position =
+      std::find(names.begin(), names.end(), name);
+  if (position != names.end())
+  {
+    size_t memory = getPoiMemory(*pPoi);
+    itr->second.memory -= memory;
+    m_tileMemory -= memory;
+    /* The order of the names does not matter */
+    std::swap(*position, names.back());
+    names.pop_back();
+  }
+}
+/**
+ * Forgets the loaded tiles, their POIs stay in the Database
+ * @param None
+ * @return None
+ */
+void CPoiDatabase::resetTiles(void)
+{
+  m_tiles.clear();
+  m_tileOrder.clear();
+  m_tileMemory = 0;
+}
+/**
+ * Opens a tiled file for loadArea(). The tiles loaded from a previously
+ * opened file are forgotten, their POIs stay in the Database.
+ * @param const std::string& fileName [IN] - Name of the tiled file
+ * @param size_t memoryLimit [IN] - The memory of the loaded tiles, in
+ * bytes, before the least recently used ones are removed
+ * @return true if the file is a tiled POI file, false otherwise
+ */
+bool CPoiDatabase::openTiles(const std::string &fileName,
+                             size_t memoryLimit)
+{
+  closeTiles();
+  std::unique_ptr<CPoiTileStore> pTileStore(new CPoiTileStore());
+  if (!pTileStore->open(fileName))
+  {
+    CDiagnostics::report(CDiagnostics::STORAGE_ERROR,
+                         "ERROR!CPoiDatabase::openTiles() failed: " +
+                             fileName + " is not a tiled POI file");
+    return false;
+  }
+  m_pTileStore = std::move(pTileStore);
+  m_tileMemoryLimit = memoryLimit;
+  return true;
+}
+/**
+ * Closes the tiled file, the POIs of the loaded tiles stay in the Database
+ * @param None
+ * @return None
+ */
+void CPoiDatabase::closeTiles(void)
+{
+  m_pTileStore.reset();
+  resetTiles();
+}
+/**
+ * Removes the POIs of the least recently used tile, change tracking must
+ * be suspended
+ * @param None
+ * @return None
+ */
+void CPoiDatabase::evictTile(void)
+{
+  TileMap_t::iterator itr = m_tiles.find(m_tileOrder.back());
+  for (size_t i = 0; i < itr->second.names.size(); i++)
+  {
+    CDatabase::removeData(itr->second.names[i]);
+  }
+  m_tileMemory -= itr->second.memory;
+  m_tiles.erase(itr);
+  m_tileOrder.pop_back();
+}
+/**
+ * Loads the tiles of an area which are not loaded yet. A POI whose name is
+ * already in the Database is skipped. The tiles of the area are moved to
+ * the front of the order of use, then the least recently used tiles are
+ * removed while the tiles exceed the memory limit, so the tiles of the
+ * area stay loaded.
+ * @param double minLatitude, minLongitude [IN] - The south west corner
+ * @param double maxLatitude, maxLongitude [IN] - The north east corner
+ * @return true if every tile of the area could be read, false otherwise
+ */
+bool CPoiDatabase::loadArea(double minLatitude, double minLongitude,
+                            double maxLatitude, double maxLongitude)
+{
+  std::vector<uint64_t> keys;
+  if (!m_pTileStore ||
+      !m_pTileStore->getTiles(minLatitude, minLongitude, maxLatitude,
+                              maxLongitude, keys))
+  {
+    return false;
+  }
+  bool isLoaded = true;
+  size_t areaTiles = 0;
+  std::vector<CPOI> pois;
+  /* The POIs of the tiles are no changes of the user */
+  CDatabase::suspendChangeTracking(true);
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    TileMap_t::iterator itr = m_tiles.find(keys[i]);
+    if (itr != m_tiles.end())
+    {
+      m_tileOrder.splice(m_tileOrder.begin(), m_tileOrder, itr->second.order);
+      areaTiles++;
+      continue;
+    }
+    if (!m_pTileStore->loadTile(keys[i], pois))
+    {
+      isLoaded = false;
+      continue;
+    }
+    tile_t &tile = m_tiles[keys[i]];
+    m_tileOrder.push_front(keys[i]);
+    areaTiles++;
+    tile.order = m_tileOrder.begin();
+    tile.memory = 0;
+    tile.names.reserve(pois.size());
+    for (size_t poi = 0; poi < pois.size(); poi++)
+    {
+      std::string name = pois[poi].getName();
+      if (NULL == CDatabase::findData(name))
+      {
+        CDatabase::addData(name, pois[poi]);
+        tile.names.push_back(name);
+        tile.memory += getPoiMemory(pois[poi]);
+      }
+    }
+    m_tileMemory += tile.memory;
+  }
+  /* A tile which could not be read is not in the order of use */
+  while ((m_tileMemory > m_tileMemoryLimit) &&
+         (m_tileOrder.size() > areaTiles))
+  {
+    evictTile();
+  }
+  CDatabase::suspendChangeTracking(false);
+  return isLoaded;
 }
 /**
  * Prints the content of POI Database
@@ -0,0 +1,261 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CPoiTileStore.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CPoiTileStore
+****************************************************************************/
+#include <algorithm>
+#include <tuple>
+
+#include <nsp/CCompactEncoder.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CPoiDatabase.h>
+#include <nsp/CPoiTileStore.h>
+
+using namespace compact_coding;
+
+/**
+ * Writes the POIs of a Database as a tiled compact file. The POIs are
+ * sorted by their tile key, then by the Hilbert index of their
+ * coordinates, entries at the same position in the order of their names.
+ * @param const std::string& fileName [IN] - Name of the file
+ * @param const CPoiDatabase& poiDb [IN] - The POIs
+ * @param unsigned int level [IN] - The tile level, 1 to MAX_TILE_LEVEL
+ * @return true if the file was written, false otherwise
+ */
+bool CPoiTileStore::writeTiles(const std::string &fileName,
+                               const CPoiDatabase &poiDb, unsigned int level)
+{
+  typedef std::tuple<uint64_t, uint64_t, CPoiDatabase::const_iterator>
+      sortKey_t;
+  level = std::max(1u, std::min<unsigned int>(level, MAX_TILE_LEVEL));
+  CCompactEncoder encoder;
+  if (!encoder.open(fileName, DEFAULT_BLOCK_RECORDS, level))
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CPoiTileStore::writeTiles() failed: Unable to open " +
+            fileName);
+    return false;
+  }
+  std::vector<sortKey_t> keys;
+  keys.reserve(poiDb.size());
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    int32_t latitude = quantize(itr->second.getLatitude());
+    int32_t longitude = quantize(itr->second.getLongitude());
+    keys.push_back(std::make_tuple(
+        compact_coding::getTileKey(getTileColumn(longitude, level),
+                                   getTileRow(latitude, level)),
+        getHilbertIndex(latitude, longitude), itr));
+  }
+  /* The map is in name order, so a stable sort keeps it for equal keys */
+  std::stable_sort(keys.begin(), keys.end(),
+                   [](const sortKey_t &first, const sortKey_t &second) {
+                     return std::tie(std::get<0>(first), std::get<1>(first)) <
+                            std::tie(std::get<0>(second),
+                                     std::get<1>(second));
+                   });
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    encoder.addPoi(std::get<2>(keys[i])->second);
+  }
+  if (!encoder.close())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CPoiTileStore::writeTiles() failed: Unable to write " +
+            fileName);
+    return false;
+  }
+  return true;
+}
+/**
+ * Maps a tiled file. Only the trailer and the index are read.
+ * @param const std::string& fileName [IN] - Name of the file
+ * @return true if the file is a complete tiled POI file, false otherwise
+ */
+bool CPoiTileStore::open(const std::string &fileName)
+{
+  if (!m_decoder.open(fileName))
+  {
+    return false;
+  }
+  if ((0 == m_decoder.getTileLevel()) ||
+      (0 != m_decoder.getRecordCount(WAYPOINT_TABLE)))
+  {
+    m_decoder.close();
+    return false;
+  }
+  return true;
+}
+/**
+ * Gets the tile of a block, the tile of its south west corner
+ * @param size_t block [IN] - Index of the block
+ * @param uint32_t& column [OUT] - The tile column
+ * @param uint32_t& row [OUT] - The tile row
+ * @return true if the block is a valid POI block, false otherwise
+ */
+bool CPoiTileStore::getBlockTile(size_t block, uint32_t &column,
+                                 uint32_t &row) const
+{
+  CCompactDecoder::blockInfo_t info;
+  if (!m_decoder.getBlockInfo(block, info) || (POI_TABLE != info.table))
+  {
+    return false;
+  }
+  column = getTileColumn(quantize(info.minLongitude), getTileLevel());
+  row = getTileRow(quantize(info.minLatitude), getTileLevel());
+  return true;
+}
+/**
+ * Finds the first block of a tile or of the tiles after it
+ * @param uint64_t key [IN] - The tile key
+ * @param size_t& block [OUT] - Index of the block, the number of blocks if
+ * every block is before the tile
+ * @return true if the headers could be read, false otherwise
+ */
+bool CPoiTileStore::findFirstBlock(uint64_t key, size_t &block) const
+{
+  size_t first = 0, last = m_decoder.getBlockCount();
+  while (first < last)
+  {
+    size_t middle = first + (last - first) / 2;
+    uint32_t column = 0, row = 0;
+    if (!getBlockTile(middle, column, row))
+    {
+      return false;
+    }
+    if (compact_coding::getTileKey(column, row) < key)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+  block = first;
+  return true;
+}
+/**
+ * Gets the key of the tile of a position
+ * @param double latitude, longitude [IN] - The position
+ * @return uint64_t - The tile key
+ */
+uint64_t CPoiTileStore::getTileKey(double latitude, double longitude) const
+{
+  return compact_coding::getTileKey(
+      getTileColumn(quantize(longitude), getTileLevel()),
+      getTileRow(quantize(latitude), getTileLevel()));
+}
+/**
+ * Gets the tiles which hold POIs in an area. A small area looks its tiles
+ * up one by one, an area of more tiles than the file has blocks reads the
+ * header of every block instead.
+ * @param double minLatitude, minLongitude [IN] - The south west corner
+ * @param double maxLatitude, maxLongitude [IN] - The north east corner
+ * @param std::vector<uint64_t>& keys [OUT] - The tile keys, ascending
+ * @return true if the headers could be read, false otherwise
+ */
+bool CPoiTileStore::getTiles(double minLatitude, double minLongitude,
+                             double maxLatitude, double maxLongitude,
+                             std::vector<uint64_t> &keys) const
+{
+  keys.clear();
+  if (!isOpen() || (minLatitude > maxLatitude) ||
+      (minLongitude > maxLongitude))
+  {
+    return isOpen();
+  }
+  unsigned int level = getTileLevel();
+  uint32_t minColumn = getTileColumn(quantize(minLongitude), level);
+  uint32_t maxColumn = getTileColumn(quantize(maxLongitude), level);
+  uint32_t minRow = getTileRow(quantize(minLatitude), level);
+  uint32_t maxRow = getTileRow(quantize(maxLatitude), level);
+  uint64_t tiles = static_cast<uint64_t>(maxColumn - minColumn + 1) *
+                   (maxRow - minRow + 1);
+  if (tiles <= m_decoder.getBlockCount())
+  {
+    for (uint32_t column = minColumn; column <= maxColumn; column++)
+    {
+      for (uint32_t row = minRow; row <= maxRow; row++)
+      {
+        uint64_t key = compact_coding::getTileKey(column, row);
+        size_t block = 0;
+        uint32_t blockColumn = 0, blockRow = 0;
+        if (!findFirstBlock(key, block))
+        {
+          return false;
+        }
+        if ((block < m_decoder.getBlockCount()) &&
+            getBlockTile(block, blockColumn, blockRow) &&
+            (column == blockColumn) && (row == blockRow))
+        {
+          keys.push_back(key);
+        }
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    return true;
+  }
+  for (size_t block = 0; block < m_decoder.getBlockCount(); block++)
+  {
+    uint32_t column = 0, row = 0;
+    if (!getBlockTile(block, column, row))
+    {
+      return false;
+    }
+    uint64_t key = compact_coding::getTileKey(column, row);
+    if ((minColumn <= column) && (column <= maxColumn) && (minRow <= row) &&
+        (row <= maxRow) && (keys.empty() || (keys.back() != key)))
+    {
+      keys.push_back(key);
+    }
+  }
+  return true;
+}
+/**
+ * Decodes the POIs of a tile, the blocks from the first one of the tile
+ * up to the first one of another tile
+ * @param uint64_t key [IN] - The tile key
+ * @param std::vector<CPOI>& pois [OUT] - The POIs, empty for a tile
+ * without POIs
+ * @return true if the blocks of the tile are intact, false otherwise
+ */
+bool CPoiTileStore::loadTile(uint64_t key, std::vector<CPOI> &pois) const
+{
+  pois.clear();
+  size_t block = 0;
+  if (!isOpen() || !findFirstBlock(key, block))
+  {
+    return false;
+  }
+  std::vector<CCompactDecoder::record_t> records;
+  for (; block < m_decoder.getBlockCount(); block++)
+  {
+    uint32_t column = 0, row = 0;
+    if (!getBlockTile(block, column, row))
+    {
+      return false;
+    }
+    if (compact_coding::getTileKey(column, row) != key)
+    {
+      break;
+    }
+    if (!m_decoder.decodeBlock(block, records))
+    {
+      return false;
+    }
+    for (size_t i = 0; i < records.size(); i++)
+    {
+      const CCompactDecoder::record_t &record = records[i];
+      pois.push_back(CPOI(record.type, std::string(record.name),
+                          std::string(record.description), record.latitude,
+                          record.longitude));
+    }
+  }
+  return true;
+}
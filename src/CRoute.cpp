@@ -17,8 +17,87 @@
  * nearest POI from a particular location.
  ****************************************************************************/
 
+#include <utility>
+#include <vector>
+
 // Own Include Files
 #include <nsp/CRoute.h>
+#include <nsp/CThreadPool.h>
+#include <nsp/GeoMath.h>
+
+#define METERS_PER_KILOMETER (1000.0) /**< @brief Represents meters per km */
+#define SIMPLIFY_TASK_SIZE (4096) /**< @brief Represents the number of
+                                     Waypoints from which on a part of the
+                                     route is handed to another thread */
+
+/**
+ * Represents the state shared by all parts of one route simplification
+ */
+typedef struct {
+  std::vector<double> vectors; /**< \brief Represents the unit vectors of the
+                                  route elements, three values each */
+  std::vector<char> isKept;    /**< \brief Represents the elements which
+                                  remain in the route */
+  double tolerance;            /**< \brief Represents the tolerance in km */
+  CThreadPool *pPool; /**< \brief Represents the workers, NULL if the
+                         simplification runs in the calling thread */
+} simplifyState_t;
+
+/**
+ * Simplifies the elements between two kept elements of the route. The
+ * Douglas-Peucker recursion is replaced by an explicit stack of open
+ * ranges, so long tracks can not overflow the call stack. Every range
+ * only writes the flags of its inner elements, hence large ranges are
+ * handed to other threads without any locking.
+ * @param simplifyState_t& state [IN/OUT] - State of the simplification
+ * @param size_t first [IN] - Index of the kept start element
+ * @param size_t last [IN] - Index of the kept end element
+ * @return None
+ */
+static void simplifyRange(simplifyState_t &state, size_t first, size_t last)
+{
+  std::vector<std::pair<size_t, size_t> > openRanges;
+  openRanges.push_back(std::make_pair(first, last));
+  while (!openRanges.empty())
+  {
+    size_t start = openRanges.back().first;
+    size_t end = openRanges.back().second;
+    openRanges.pop_back();
+    if (end - start < 2) /* No inner elements */
+      continue;
+
+    /* Find the inner element farthest from the arc */
+    const double *pVectors = &state.vectors[0];
+    double maxDistance = -1;
+    size_t split = start;
+    for (size_t i = start + 1; i < end; i++)
+    {
+      double distance = geo_math::arcDistance(
+          pVectors + 3 * i, pVectors + 3 * start, pVectors + 3 * end);
+      if (distance > maxDistance)
+      {
+        maxDistance = distance;
+        split = i;
+      }
+    }
+    if (maxDistance <= state.tolerance) /* All inner elements are dropped */
+      continue;
+
+    state.isKept[split] = 1;
+    if ((NULL != state.pPool) && (end - split > SIMPLIFY_TASK_SIZE))
+    {
+      simplifyState_t *pState = &state;
+      state.pPool->submit([pState, split, end](unsigned int) {
+        simplifyRange(*pState, split, end);
+      });
+    }
+    else
+    {
+      openRanges.push_back(std::make_pair(split, end));
+    }
+    openRanges.push_back(std::make_pair(start, split));
+  }
+}
 
 /**
  * Parameterized constructor to CRoute class - Sets the values in case of valid
@@ -475,3 +554,91 @@ const std::vector<const CWaypoint *> CRoute::getRoute()
   }
   return routeVec;
 }
+/**
+ * Simplifies the route with the Douglas-Peucker algorithm on the sphere.
+ * The route is cut at its POIs, which are kept, and every part between two
+ * of them is simplified on its own.
+ * @param double toleranceMeters [IN] - Allowed cross-track distance in
+ * meters
+ * @param unsigned int threadCount [IN] - Number of worker threads, 0 uses
+ * one thread per core
+ * @return unsigned int - Number of Waypoints removed from the route
+ */
+unsigned int CRoute::simplify(double toleranceMeters, unsigned int threadCount)
+{
+  if (!(toleranceMeters >= 0))
+  {
+    std::cout << "ERROR!CRoute::simplify() failed! Invalid tolerance!"
+              << std::endl;
+    return 0;
+  }
+  size_t elementCount = m_routeContainer.size();
+  if (elementCount < 3)
+  {
+    return 0;
+  }
+  simplifyState_t state;
+  state.vectors.resize(3 * elementCount);
+  state.isKept.assign(elementCount, 0);
+  state.tolerance = toleranceMeters / METERS_PER_KILOMETER;
+  state.pPool = NULL;
+
+  std::vector<size_t> anchors; /* Elements which are always kept */
+  size_t index = 0;
+  for (CRouteList::iterator itr = m_routeContainer.begin();
+       itr != m_routeContainer.end(); ++itr, index++)
+  {
+    if ((NULL == *itr) || (NULL != dynamic_cast<CPOI *>(*itr)) ||
+        (0 == index) || (elementCount - 1 == index))
+    {
+      anchors.push_back(index);
+      state.isKept[index] = 1;
+    }
+    if (NULL != *itr)
+    {
+      geo_math::toUnitVector((*itr)->getLatitude(), (*itr)->getLongitude(),
+                             &state.vectors[3 * index]);
+    }
+  }
+
+  if (1 == threadCount)
+  {
+    for (size_t i = 1; i < anchors.size(); i++)
+    {
+      simplifyRange(state, anchors[i - 1], anchors[i]);
+    }
+  }
+  else
+  {
+    CThreadPool pool(threadCount);
+    state.pPool = &pool;
+    for (size_t i = 1; i < anchors.size(); i++)
+    {
+      size_t first = anchors[i - 1], last = anchors[i];
+      simplifyState_t *pState = &state;
+      pool.submit([pState, first, last](unsigned int) {
+        simplifyRange(*pState, first, last);
+      });
+    }
+    pool.wait();
+  }
+
+  /* Only Waypoints are dropped, the anchors are kept */
+  unsigned int removedCount = 0;
+  index = 0;
+  for (CRouteList::iterator itr = m_routeContainer.begin();
+       itr != m_routeContainer.end(); index++)
+  {
+    if (state.isKept[index])
+    {
+      ++itr;
+    }
+    else
+    {
+      itr = m_routeContainer.erase(itr);
+      removedCount++;
+    }
+  }
+  m_waypointCount -= removedCount;
+  return removedCount;
+}
@@ -0,0 +1,169 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CRouteFinder.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CRouteFinder
+****************************************************************************/
+#include <algorithm>
+#include <functional>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CRouteFinder.h>
+
+/**
+ * Constructor of CRouteFinder class
+ * @param const CRoutingGraph& graph [IN] - The finalized graph to be
+ * searched. It must outlive the CRouteFinder object.
+ */
+CRouteFinder::CRouteFinder(const CRoutingGraph &graph)
+    : m_pGraph(&graph), m_currentStamp(0), m_settledNodes(0)
+{
+}
+/**
+ * Prepares the search state for a new query. The per node arrays are only
+ * cleared when the graph has grown or the stamp counter wraps around.
+ * @param None
+ * @return None
+ */
+void CRouteFinder::startQuery(void)
+{
+  node_t nodeCount = m_pGraph->getNodeCount();
+  if (m_visitStamp.size() != nodeCount)
+  {
+    m_cost.assign(nodeCount, 0);
+    m_parent.assign(nodeCount, CRoutingGraph::INVALID_NODE);
+    m_visitStamp.assign(nodeCount, 0);
+    m_settledStamp.assign(nodeCount, 0);
+    m_currentStamp = 0;
+  }
+  if (0 == ++m_currentStamp) /* Stamp counter wrapped around */
+  {
+    std::fill(m_visitStamp.begin(), m_visitStamp.end(), 0);
+    std::fill(m_settledStamp.begin(), m_settledStamp.end(), 0);
+    m_currentStamp = 1;
+  }
+  m_openList.clear();
+  m_settledNodes = 0;
+}
+/**
+ * Searches the shortest path between two nodes.
+ * The open list is a binary heap ordered by the estimated total length
+ * (path length so far + great-circle distance to the target). Outdated heap
+ * entries are skipped when they are popped instead of being updated in
+ * place. Since the heuristic is consistent, a node is final once it is
+ * popped for the first time.
+ * @param node_t source [IN] - Start node
+ * @param node_t target [IN] - Destination node
+ * @param std::vector<node_t>& path [OUT] - The nodes of the path,
+ * including source and target
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return true if a path is found, false otherwise
+ */
+bool CRouteFinder::findPath(node_t source, node_t target,
+                            std::vector<node_t> &path, double &distance)
+{
+  path.clear();
+  if ((source >= m_pGraph->getNodeCount()) ||
+      (target >= m_pGraph->getNodeCount()))
+  {
+    return false;
+  }
+  startQuery();
+
+  const CRoutingGraph &graph = *m_pGraph;
+  std::greater<queueEntry_t> heapOrder; /* Min-heap on estimated length */
+
+  m_cost[source] = 0;
+  m_parent[source] = CRoutingGraph::INVALID_NODE;
+  m_visitStamp[source] = m_currentStamp;
+  m_openList.push_back(
+      queueEntry_t(graph.getDistance(source, target), source));
+
+  bool isFound = false;
+  while (!m_openList.empty())
+  {
+    std::pop_heap(m_openList.begin(), m_openList.end(), heapOrder);
+    node_t node = m_openList.back().second;
+    m_openList.pop_back();
+
+    if (m_settledStamp[node] == m_currentStamp) /* Outdated entry */
+      continue;
+    m_settledStamp[node] = m_currentStamp;
+    m_settledNodes++;
+
+    if (node == target)
+    {
+      isFound = true;
+      break;
+    }
+    double nodeCost = m_cost[node];
+    for (edge_t edge = graph.getEdgeBegin(node); edge < graph.getEdgeEnd(node);
+         edge++)
+    {
+      node_t next = graph.getEdgeTarget(edge);
+      if (m_settledStamp[next] == m_currentStamp)
+        continue;
+
+      double nextCost = nodeCost + graph.getEdgeWeight(edge);
+      if ((m_visitStamp[next] != m_currentStamp) || (nextCost < m_cost[next]))
+      {
+        m_visitStamp[next] = m_currentStamp;
+        m_cost[next] = nextCost;
+        m_parent[next] = node;
+        m_openList.push_back(
+            queueEntry_t(nextCost + graph.getDistance(next, target), next));
+        std::push_heap(m_openList.begin(), m_openList.end(), heapOrder);
+      }
+    }
+  }
+  if (isFound)
+  {
+    /* Walk back from the target to the source */
+    for (node_t node = target; CRoutingGraph::INVALID_NODE != node;
+         node = m_parent[node])
+    {
+      path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    distance = m_cost[target];
+  }
+  return isFound;
+}
+/**
+ * Searches the shortest path between two Waypoints and appends the
+ * Waypoints of the path to the route.
+ * @param const std::string& from [IN] - Name of the start Waypoint
+ * @param const std::string& to [IN] - Name of the destination Waypoint
+ * @param CRoute& route [OUT] - The route the path is appended to
+ * @param double& distance [OUT] - Length of the path in kilometers
+ * @return true if a path is found, false otherwise
+ */
+bool CRouteFinder::findRoute(const std::string &from, const std::string &to,
+                             CRoute &route, double &distance)
+{
+  node_t source = CRoutingGraph::INVALID_NODE;
+  node_t target = CRoutingGraph::INVALID_NODE;
+  if (!m_pGraph->getNode(from, source) || !m_pGraph->getNode(to, target))
+  {
+    CDiagnostics::report(CDiagnostics::MISSING_ENTRY,
+                         "ERROR!CRouteFinder::findRoute() failed! Waypoint "
+                         "not found in the routing graph");
+    return false;
+  }
+  std::vector<node_t> path;
+  if (!findPath(source, target, path, distance))
+  {
+    CDiagnostics::report(CDiagnostics::MISSING_ENTRY,
+                         "ERROR!CRouteFinder::findRoute() failed! No path "
+                         "from " +
+                             from + " to " + to);
+    return false;
+  }
+  for (std::vector<node_t>::const_iterator itr = path.begin();
+       itr != path.end(); ++itr)
+  {
+    route.addWaypoint(m_pGraph->getNodeName(*itr));
+  }
+  return true;
+}
@@ -0,0 +1,265 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CRoutingGraph.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CRoutingGraph
+****************************************************************************/
+#include <math.h>
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <nsp/CAttributeExtractor.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CRoutingGraph.h>
+#include <nsp/GeoMath.h>
+#include <nsp/TypeMapping.h>
+
+#define EDGE_ATTRIBUTES (3) /**< @brief Represents the attributes per edge */
+#define EDGE_FROM_POS (0)   /**< @brief Represents the position of start */
+#define EDGE_TO_POS (1)     /**< @brief Represents the position of end */
+#define EDGE_WEIGHT_POS (2) /**< @brief Represents the position of length */
+#define SEMI_COLON_CHAR ';' /**< @brief Represents Semi Colon Character */
+
+const CRoutingGraph::node_t CRoutingGraph::INVALID_NODE;
+
+/**
+ * Reports an invalid line of the edge list file. The message is only
+ * formatted if the diagnostics write it.
+ * @param std::string_view errorType [IN] - Name of the error
+ * @param unsigned int lineNumber [IN] - Line number of the line
+ * @return None
+ */
+static void reportInvalidEdge(std::string_view errorType,
+                              unsigned int lineNumber)
+{
+  if (CDiagnostics::count(CDiagnostics::INVALID_RECORD))
+  {
+    CDiagnostics::write(
+        CDiagnostics::INVALID_RECORD,
+        "ERROR!CRoutingGraph::loadFromFile() failed!ErrorType:" +
+            std::string(errorType) + " line_no: " + std::to_string(lineNumber));
+  }
+}
+
+CRoutingGraph::CRoutingGraph() { m_edgeOffsets.push_back(0); }
+/**
+ * Adds a node to the graph. If a node with the same name is already
+ * present, the existing node is returned.
+ * @param const std::string& name [IN] - Name of the Waypoint
+ * @param double latitude [IN] - Latitude of the Waypoint
+ * @param double longitude [IN] - Longitude of the Waypoint
+ * @return node_t - Index of the node
+ */
+CRoutingGraph::node_t CRoutingGraph::addNode(const std::string &name,
+                                             double latitude,
+                                             double longitude)
+{
+  std::pair<std::map<std::string, node_t>::iterator, bool> result =
+      m_nodeIndex.insert(std::make_pair(name, (node_t)m_nodeNames.size()));
+  if (!result.second) /* Node is already known */
+  {
+    return result.first->second;
+  }
+  double latitudeRad = geo_math::degreeToRadian(latitude);
+  m_nodeNames.push_back(name);
+  m_latitude.push_back(latitude);
+  m_longitude.push_back(longitude);
+  m_sinLatitude.push_back(sin(latitudeRad));
+  m_cosLatitude.push_back(cos(latitudeRad));
+  m_longitudeRad.push_back(geo_math::degreeToRadian(longitude));
+  /* A new node has no outgoing edges until the next finalize() */
+  m_edgeOffsets.push_back(m_edgeOffsets.back());
+  return result.first->second;
+}
+/**
+ * Adds a directed edge to the graph. The edge becomes visible to the path
+ * search after the next call to finalize().
+ * @param node_t from [IN] - Start node of the edge
+ * @param node_t to [IN] - End node of the edge
+ * @param double weight [IN] - Length of the edge in kilometers
+ * @return true if the edge is valid, false otherwise
+ */
+bool CRoutingGraph::addEdge(node_t from, node_t to, double weight)
+{
+  if ((from >= getNodeCount()) || (to >= getNodeCount()) || !(weight >= 0))
+  {
+    return false;
+  }
+  /* Keep the great-circle heuristic admissible */
+  double minWeight = getDistance(from, to);
+  pendingEdge_t edge = {from, to, (weight < minWeight) ? minWeight : weight};
+  m_pendingEdges.push_back(edge);
+  return true;
+}
+/**
+ * Builds the CSR adjacency from all the edges added so far. The existing
+ * CSR edges and the pending edges are bucketed by their start node with a
+ * counting sort, which keeps the build linear in the number of edges.
+ * @param None
+ * @return None
+ */
+void CRoutingGraph::finalize(void)
+{
+  node_t nodeCount = getNodeCount();
+  std::vector<edge_t> offsets(nodeCount + 1, 0);
+
+  /* Count the outgoing edges of every node */
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    offsets[node + 1] += getEdgeEnd(node) - getEdgeBegin(node);
+  }
+  for (size_t i = 0; i < m_pendingEdges.size(); i++)
+  {
+    offsets[m_pendingEdges[i].from + 1]++;
+  }
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    offsets[node + 1] += offsets[node];
+  }
+  /* Scatter the edges into their buckets */
+  std::vector<node_t> targets(offsets[nodeCount]);
+  std::vector<double> weights(offsets[nodeCount]);
+  std::vector<edge_t> insertPos(offsets.begin(), offsets.end() - 1);
+  for (node_t node = 0; node < nodeCount; node++)
+  {
+    for (edge_t edge = getEdgeBegin(node); edge < getEdgeEnd(node); edge++)
+    {
+      edge_t pos = insertPos[node]++;
+      targets[pos] = m_edgeTargets[edge];
+      weights[pos] = m_edgeWeights[edge];
+    }
+  }
+  for (size_t i = 0; i < m_pendingEdges.size(); i++)
+  {
+    edge_t pos = insertPos[m_pendingEdges[i].from]++;
+    targets[pos] = m_pendingEdges[i].to;
+    weights[pos] = m_pendingEdges[i].weight;
+  }
+  m_edgeOffsets.swap(offsets);
+  m_edgeTargets.swap(targets);
+  m_edgeWeights.swap(weights);
+  std::vector<pendingEdge_t>().swap(m_pendingEdges);
+}
+/**
+ * Clears all nodes and edges of the graph
+ * @param None
+ * @return None
+ */
+void CRoutingGraph::clear(void)
+{
+  m_nodeNames.clear();
+  m_latitude.clear();
+  m_longitude.clear();
+  m_sinLatitude.clear();
+  m_cosLatitude.clear();
+  m_longitudeRad.clear();
+  m_nodeIndex.clear();
+  m_edgeOffsets.assign(1, 0);
+  m_edgeTargets.clear();
+  m_edgeWeights.clear();
+  m_pendingEdges.clear();
+}
+/**
+ * Builds the graph from the Waypoints of the database and the edge list
+ * file. Every line of the file has the format
+ * "<from waypoint>;<to waypoint>;<length in km>".
+ * @param const std::string& fileName [IN] - Name of the edge list file
+ * @param const CWpDatabase& wpDb [IN] - Database holding the Waypoints
+ * @return true if the file could be read, false otherwise. Invalid lines
+ * are reported and skipped.
+ */
+bool CRoutingGraph::loadFromFile(const std::string &fileName,
+                                 const CWpDatabase &wpDb)
+{
+  CDiagnosticScope load("CRoutingGraph::loadFromFile()");
+  std::fstream edgeFile(fileName.c_str(), std::ios::in);
+  if (!edgeFile.is_open())
+  {
+    CDiagnostics::report(
+        CDiagnostics::STORAGE_ERROR,
+        "ERROR!CRoutingGraph::loadFromFile() failed! Unable to open " +
+            fileName);
+    return false;
+  }
+  clear();
+  /* Every Waypoint of the database becomes a node */
+  for (CWpDatabase::const_iterator itr = wpDb.begin(); itr != wpDb.end();
+       ++itr)
+  {
+    addNode(itr->first, itr->second.getLatitude(),
+            itr->second.getLongitude());
+  }
+
+  CAttributeExtractor attributeExtractor;
+  std::vector<char> delimiters(1, SEMI_COLON_CHAR);
+  attributeExtractor.setDelimiters(delimiters);
+  attributeExtractor.setMaxAttributes(EDGE_ATTRIBUTES);
+
+  std::string line;
+  unsigned int lineNumber = 0;
+  while (getline(edgeFile, line))
+  {
+    lineNumber++;
+    if (!type_mapping::validateStringData(line))
+      continue;
+
+    std::vector<std::string> attributeVec;
+    CAttributeExtractor::RC_t errorType =
+        attributeExtractor.extractAttributes(line, attributeVec);
+    if (CAttributeExtractor::RC_SUCCESS != errorType)
+    {
+      reportInvalidEdge(attributeExtractor.getErrorType(errorType),
+                        lineNumber);
+      continue;
+    }
+    node_t from = INVALID_NODE, to = INVALID_NODE;
+    double weight = 0;
+    if (!getNode(attributeVec[EDGE_FROM_POS], from) ||
+        !getNode(attributeVec[EDGE_TO_POS], to))
+    {
+      reportInvalidEdge("UNKNOWN_WAYPOINT", lineNumber);
+      continue;
+    }
+    if (!type_mapping::convertStringToDouble(attributeVec[EDGE_WEIGHT_POS],
+                                             weight) ||
+        !addEdge(from, to, weight))
+    {
+      reportInvalidEdge("INVALID_EDGE_LENGTH", lineNumber);
+    }
+  }
+  edgeFile.close();
+  finalize();
+  return true;
+}
+/**
+ * Gets the node which belongs to the Waypoint with the given name
+ * @param const std::string& name [IN] - Name of the Waypoint
+ * @param node_t& node [OUT] - Index of the node
+ * @return true if the node is found, false otherwise
+ */
+bool CRoutingGraph::getNode(const std::string &name, node_t &node) const
+{
+  std::map<std::string, node_t>::const_iterator itr = m_nodeIndex.find(name);
+  if (itr == m_nodeIndex.end())
+  {
+    return false;
+  }
+  node = itr->second;
+  return true;
+}
+/**
+ * Gets the great-circle distance between two nodes using the precomputed
+ * trigonometry of the nodes
+ * @param node_t from [IN] - First node
+ * @param node_t to [IN] - Second node
+ * @return double - Distance in kilometers
+ */
+double CRoutingGraph::getDistance(node_t from, node_t to) const
+{
+  return geo_math::greatCircleDistance(
+      m_sinLatitude[from], m_cosLatitude[from], m_longitudeRad[from],
+      m_sinLatitude[to], m_cosLatitude[to], m_longitudeRad[to]);
+}
@@ -0,0 +1,206 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CSpatialGrid.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CSpatialGrid
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+
+#include <nsp/CSpatialGrid.h>
+#include <nsp/GeoMath.h>
+
+#define POIS_PER_CELL (4) /**< @brief Represents the POIs per cell aimed at
+                             by the automatic cell size */
+#define MIN_CELL_SIZE (1e-5) /**< @brief Represents the smallest cell size
+                                in degree (about 1 m) */
+#define MAX_GRID_CELLS                                                       \
+  (1u << 22) /**< @brief Represents the largest number of cells */
+
+CSpatialGrid::CSpatialGrid()
+    : m_minLatitude(0), m_minLongitude(0), m_cellSize(1), m_rows(0),
+      m_columns(0), m_minCosLatitude(1)
+{
+}
+/**
+ * Sorts all POIs of the database into the grid. The grid spans the
+ * bounding box of the POIs, the entries are bucketed with a counting sort.
+ * @param const CPoiDatabase& poiDb [IN] - The POI database
+ * @param double cellSize [IN] - Cell size in degree, 0 chooses a size
+ * with a few POIs per cell
+ * @return None
+ */
+void CSpatialGrid::build(const CPoiDatabase &poiDb, double cellSize)
+{
+  m_entries.clear();
+  m_cellOffsets.assign(1, 0);
+  m_rows = m_columns = 0;
+  if (0 == poiDb.size())
+  {
+    return;
+  }
+  double maxLatitude = -HUGE_VAL, maxLongitude = -HUGE_VAL;
+  m_minLatitude = m_minLongitude = HUGE_VAL;
+  m_minCosLatitude = 1;
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    double latitude = itr->second.getLatitude();
+    double longitude = itr->second.getLongitude();
+    m_minLatitude = std::min(m_minLatitude, latitude);
+    m_minLongitude = std::min(m_minLongitude, longitude);
+    maxLatitude = std::max(maxLatitude, latitude);
+    maxLongitude = std::max(maxLongitude, longitude);
+    m_minCosLatitude =
+        std::min(m_minCosLatitude, cos(geo_math::degreeToRadian(latitude)));
+  }
+  m_minCosLatitude = std::max(0.0, m_minCosLatitude);
+
+  double latitudeRange = maxLatitude - m_minLatitude;
+  double longitudeRange = maxLongitude - m_minLongitude;
+  if (!(cellSize > 0))
+  {
+    double cells = std::max(1.0, (double)poiDb.size() / POIS_PER_CELL);
+    cellSize = sqrt(std::max(latitudeRange, MIN_CELL_SIZE) *
+                    std::max(longitudeRange, MIN_CELL_SIZE) / cells);
+  }
+  m_cellSize = std::max(cellSize, MIN_CELL_SIZE);
+  while (((latitudeRange / m_cellSize) + 1) *
+             ((longitudeRange / m_cellSize) + 1) >
+         MAX_GRID_CELLS)
+  {
+    m_cellSize *= 2;
+  }
+  m_rows = (unsigned int)(latitudeRange / m_cellSize) + 1;
+  m_columns = (unsigned int)(longitudeRange / m_cellSize) + 1;
+
+  /* Count the POIs per cell, then scatter them */
+  size_t cellCount = (size_t)m_rows * m_columns;
+  std::vector<unsigned int> cellOfPoi;
+  cellOfPoi.reserve(poiDb.size());
+  m_cellOffsets.assign(cellCount + 1, 0);
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr)
+  {
+    unsigned int cell = getRow(itr->second.getLatitude()) * m_columns +
+                        getColumn(itr->second.getLongitude());
+    cellOfPoi.push_back(cell);
+    m_cellOffsets[cell + 1]++;
+  }
+  for (size_t cell = 0; cell < cellCount; cell++)
+  {
+    m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+  }
+  std::vector<unsigned int> insertPos(m_cellOffsets.begin(),
+                                      m_cellOffsets.end() - 1);
+  m_entries.resize(poiDb.size());
+  size_t poi = 0;
+  for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end();
+       ++itr, ++poi)
+  {
+    double latitudeRad = geo_math::degreeToRadian(itr->second.getLatitude());
+    gridEntry_t &entry = m_entries[insertPos[cellOfPoi[poi]]++];
+    entry.sinLatitude = sin(latitudeRad);
+    entry.cosLatitude = cos(latitudeRad);
+    entry.longitudeRad = geo_math::degreeToRadian(itr->second.getLongitude());
+    entry.pPoi = &itr->second;
+  }
+}
+/**
+ * Gets the row of a latitude, clamped to the grid
+ */
+unsigned int CSpatialGrid::getRow(double latitude) const
+{
+  double row = floor((latitude - m_minLatitude) / m_cellSize);
+  return (row <= 0) ? 0 : (row >= m_rows) ? m_rows - 1 : (unsigned int)row;
+}
+/**
+ * Gets the column of a longitude, clamped to the grid
+ */
+unsigned int CSpatialGrid::getColumn(double longitude) const
+{
+  double column = floor((longitude - m_minLongitude) / m_cellSize);
+  return (column <= 0)            ? 0
+         : (column >= m_columns) ? m_columns - 1
+                                 : (unsigned int)column;
+}
+/**
+ * Searches the POI which is closest to a position.
+ * Ring r consists of the cells which are r cells away from the cell of the
+ * position. Every POI in ring r is at least (r - 1) cells away in latitude
+ * or in longitude, which gives a lower bound of its distance. Moving
+ * along a latitude circle covers the shortest distance at the latitude
+ * with the smallest cosine, hence that cosine is used for the bound. The
+ * search stops once the bound exceeds the best distance.
+ * @param double latitude [IN] - Latitude of the position
+ * @param double longitude [IN] - Longitude of the position
+ * @param const CPOI*& pPoi [OUT] - The nearest POI
+ * @param double& distance [OUT] - Distance to the POI in kilometers
+ * @return true if a POI is found, false if the grid is empty
+ */
+bool CSpatialGrid::findNearest(double latitude, double longitude,
+                               const CPOI *&pPoi, double &distance) const
+{
+  if (m_entries.empty())
+  {
+    return false;
+  }
+  double latitudeRad = geo_math::degreeToRadian(latitude);
+  double sinLatitude = sin(latitudeRad);
+  double cosLatitude = cos(latitudeRad);
+  double longitudeRad = geo_math::degreeToRadian(longitude);
+  double cosBound = sqrt(std::max(0.0, cosLatitude) * m_minCosLatitude);
+
+  int centerRow = getRow(latitude);
+  int centerColumn = getColumn(longitude);
+  int maxRing = std::max(m_rows, m_columns);
+  double bestDistance = HUGE_VAL;
+  const gridEntry_t *pBest = NULL;
+
+  for (int ring = 0; ring <= maxRing; ring++)
+  {
+    if (ring > 1)
+    {
+      double gapRad = geo_math::degreeToRadian((ring - 1) * m_cellSize);
+      double latitudeBound = EARTH_RADIUS_LENGTH * gapRad;
+      double longitudeBound =
+          (gapRad < PI) ? EARTH_RADIUS_LENGTH * 2 *
+                              asin(std::min(1.0, cosBound * sin(gapRad / 2)))
+                        : latitudeBound;
+      if (std::min(latitudeBound, longitudeBound) > bestDistance)
+        break;
+    }
+    int firstRow = std::max(0, centerRow - ring);
+    int lastRow = std::min((int)m_rows - 1, centerRow + ring);
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+      bool isEdgeRow = (row == centerRow - ring) || (row == centerRow + ring);
+      int step = isEdgeRow ? 1 : 2 * ring;
+      for (int column = centerColumn - ring; column <= centerColumn + ring;
+           column += step)
+      {
+        if ((column < 0) || (column >= (int)m_columns))
+          continue;
+        unsigned int cell = row * m_columns + column;
+        for (unsigned int entry = m_cellOffsets[cell];
+             entry < m_cellOffsets[cell + 1]; entry++)
+        {
+          const gridEntry_t &candidate = m_entries[entry];
+          double candidateDistance = geo_math::greatCircleDistance(
+              sinLatitude, cosLatitude, longitudeRad, candidate.sinLatitude,
+              candidate.cosLatitude, candidate.longitudeRad);
+          if (candidateDistance < bestDistance)
+          {
+            bestDistance = candidateDistance;
+            pBest = &candidate;
+          }
+        }
+      }
+    }
+  }
+  pPoi = pBest->pPoi;
+  distance = bestDistance;
+  return true;
+}
@@ -0,0 +1,255 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CThreadPool.cpp
+* Author          : Jishnu M Thampan
+* Description     : class CThreadPool
+****************************************************************************/
+#include <algorithm>
+#include <memory>
+
+#include <nsp/CThreadPool.h>
+
+/* The pool and the index of the worker running on this thread, used to
+ * keep the tasks submitted by a task in the queue of its worker */
+static thread_local const CThreadPool *t_pCurrentPool = NULL;
+static thread_local unsigned int t_currentWorker = 0;
+
+/**
+ * Represents the completion of the tasks of one parallelFor() call
+ */
+typedef struct {
+  std::atomic<size_t> remainingTasks; /**< \brief Represents the tasks not
+                                         yet done */
+  std::mutex lock;                    /**< \brief Protects the sleeping */
+  std::condition_variable done;       /**< \brief Wakes up the caller */
+} completion_t;
+
+/**
+ * Constructor of CThreadPool class, starts the workers
+ * @param unsigned int threadCount [IN] - Number of workers, 0 uses one
+ * worker per core
+ */
+CThreadPool::CThreadPool(unsigned int threadCount)
+    : m_queuedTasks(0), m_unfinishedTasks(0), m_sleepingWorkers(0),
+      m_nextQueue(0), m_isStopping(false)
+{
+  if (0 == threadCount)
+  {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned int index = 0; index < threadCount; index++)
+  {
+    m_queues.push_back(new workerQueue_t);
+  }
+  for (unsigned int index = 0; index < threadCount; index++)
+  {
+    m_workers.push_back(std::thread(&CThreadPool::runWorker, this, index));
+  }
+}
+/**
+ * Destructor of CThreadPool class, finishes all queued tasks and stops
+ * the workers
+ */
+CThreadPool::~CThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_stateLock);
+    m_isStopping = true;
+  }
+  m_workAvailable.notify_all();
+  for (size_t index = 0; index < m_workers.size(); index++)
+  {
+    m_workers[index].join();
+  }
+  for (size_t index = 0; index < m_queues.size(); index++)
+  {
+    delete m_queues[index];
+  }
+}
+/**
+ * Queues a task. The lock is only taken if a worker sleeps: a worker
+ * counts itself as sleeping before it checks the queued tasks, so either
+ * it sees the new task or the submitter sees the sleeping worker.
+ * @param const task_t& task [IN] - The task
+ * @return None
+ */
+void CThreadPool::submit(const task_t &task)
+{
+  unsigned int queue = (this == t_pCurrentPool)
+                           ? t_currentWorker
+                           : m_nextQueue++ % m_queues.size();
+  m_unfinishedTasks++;
+  {
+    std::lock_guard<std::mutex> guard(m_queues[queue]->lock);
+    m_queues[queue]->tasks.push_back(task);
+  }
+  m_queuedTasks++;
+  if (0 != m_sleepingWorkers)
+  {
+    /* The worker is either waiting or has not checked the tasks yet */
+    std::lock_guard<std::mutex> guard(m_stateLock);
+  }
+  m_workAvailable.notify_one();
+}
+/**
+ * Waits until all submitted tasks are finished
+ * @param None
+ * @return None
+ */
+void CThreadPool::wait(void)
+{
+  std::unique_lock<std::mutex> guard(m_stateLock);
+  while (0 != m_unfinishedTasks)
+  {
+    m_allDone.wait(guard);
+  }
+}
+/**
+ * Runs a function over the index range [0, count) and waits for its tasks
+ * only. A task of this pool runs the range inline on its own worker.
+ * @param size_t count [IN] - Size of the range
+ * @param size_t grainSize [IN] - Indices per task
+ * @param const std::function<void(size_t, size_t, unsigned int)>&
+ * function [IN] - Called as function(begin, end, worker)
+ * @return None
+ */
+void CThreadPool::parallelFor(
+    size_t count, size_t grainSize,
+    const std::function<void(size_t, size_t, unsigned int)> &function)
+{
+  grainSize = std::max((size_t)1, grainSize);
+  if (0 == count)
+  {
+    return;
+  }
+  if (this == t_pCurrentPool)
+  {
+    /* A task owns the state of its worker, a nested call must not run
+     * other tasks of that worker in between */
+    for (size_t begin = 0; begin < count; begin += grainSize)
+    {
+      function(begin, std::min(count, begin + grainSize), t_currentWorker);
+    }
+    return;
+  }
+  /* Shared, since the last task may still notify after the caller left */
+  std::shared_ptr<completion_t> pCompletion(new completion_t);
+  pCompletion->remainingTasks = (count + grainSize - 1) / grainSize;
+  for (size_t begin = 0; begin < count; begin += grainSize)
+  {
+    size_t end = std::min(count, begin + grainSize);
+    submit([&function, pCompletion, begin, end](unsigned int worker) {
+      function(begin, end, worker);
+      if (1 == pCompletion->remainingTasks--)
+      {
+        std::lock_guard<std::mutex> guard(pCompletion->lock);
+        pCompletion->done.notify_all();
+      }
+    });
+  }
+  std::unique_lock<std::mutex> guard(pCompletion->lock);
+  while (0 != pCompletion->remainingTasks)
+  {
+    pCompletion->done.wait(guard);
+  }
+}
+/**
+ * Takes a task from the own queue or steals one from another worker. The
+ * own queue is used as a stack, the other queues as a FIFO.
+ * @param unsigned int index [IN] - Index of the worker
+ * @param task_t& task [OUT] - The task
+ * @return true if a task is taken, false if all queues are empty
+ */
+bool CThreadPool::takeTask(unsigned int index, task_t &task)
+{
+  for (size_t offset = 0; offset < m_queues.size(); offset++)
+  {
+    workerQueue_t &queue = *m_queues[(index + offset) % m_queues.size()];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty())
+    {
+      if (0 == offset)
+      {
+        task.swap(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      else
+      {
+        task.swap(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+/**
+ * Reserves one of the queued tasks
+ * @param None
+ * @return true if a task is reserved, false if none is queued
+ */
+bool CThreadPool::reserveTask(void)
+{
+  size_t queuedTasks = m_queuedTasks;
+  while (0 != queuedTasks)
+  {
+    if (m_queuedTasks.compare_exchange_weak(queuedTasks, queuedTasks - 1))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+/**
+ * Takes and runs a reserved task. Tasks are counted after they are
+ * pushed, hence every reservation finds a task, though not necessarily
+ * the one it was counted for.
+ * @param unsigned int index [IN] - Index of the worker
+ * @return None
+ */
+void CThreadPool::runTask(unsigned int index)
+{
+  task_t task;
+  while (!takeTask(index, task))
+  {
+    std::this_thread::yield();
+  }
+  task(index);
+  task = task_t();
+  if (1 == m_unfinishedTasks--)
+  {
+    std::lock_guard<std::mutex> guard(m_stateLock);
+    m_allDone.notify_all();
+  }
+}
+/**
+ * Main loop of a worker thread. The worker sleeps while no task is queued
+ * and leaves once the pool is stopping and all tasks are taken.
+ * @param unsigned int index [IN] - Index of the worker
+ * @return None
+ */
+void CThreadPool::runWorker(unsigned int index)
+{
+  t_pCurrentPool = this;
+  t_currentWorker = index;
+  while (true)
+  {
+    if (reserveTask())
+    {
+      runTask(index);
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(m_stateLock);
+    m_sleepingWorkers++;
+    while ((0 == m_queuedTasks) && !m_isStopping)
+    {
+      m_workAvailable.wait(guard);
+    }
+    m_sleepingWorkers--;
+    if (0 == m_queuedTasks) /* Stopping and nothing left */
+    {
+      return;
+    }
+  }
+}
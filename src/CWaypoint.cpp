@@ -14,13 +14,10 @@
 #include <stdlib.h>
 
 // Own Include Files
+#include <nsp/CDiagnostics.h>
 #include <nsp/CWaypoint.h>
+#include <nsp/GeoMath.h>
 
-#define EARTH_RADIUS_LENGTH \
-  6378.17             /**< @brief Defines the Radius of Earth in kilometers*/
-#define PI 3.14159265 /**< @brief Defines the constant PI */
-#define CONVERT_DEGREE_TO_RADIAN(x) \
-  (x * PI / 180)     /**< @brief Defines the conversion from degree to radian*/
 #define TIME_UNIT 60 /**< @brief Defines the time unit  */
 
 // Method Implementations
@@ -79,8 +76,9 @@ bool CWaypoint::set(std::string name, double latitude, double longitude)
     }
     else
     {
-      std::cout << "ERROR!:set()failed: Invalid Latitude/Longitude Parameters!"
-                << std::endl;
+      CDiagnostics::report(
+          CDiagnostics::INVALID_VALUE,
+          "ERROR!:set()failed: Invalid Latitude/Longitude Parameters!");
       isValidWaypoint = false;
       break;
     }
@@ -90,7 +88,8 @@ bool CWaypoint::set(std::string name, double latitude, double longitude)
     }
     else
     {
-      std::cout << "--ERROR!:set()failed: Invalid Name!" << std::endl;
+      CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                           "--ERROR!:set()failed: Invalid Name!");
       isValidWaypoint = false;
       break;
     }
@@ -108,9 +107,9 @@ bool CWaypoint::set(std::string name, double latitude, double longitude)
     this->m_latitude = 0;
     this->m_longitude = 0;
     this->m_name = DEFAULT_STRING;
-    std::cout << "WARNING! CWaypoint::set(): Invalid values provided, so "
-                 "default values in action!"
-              << std::endl;
+    CDiagnostics::report(CDiagnostics::INVALID_VALUE,
+                         "WARNING! CWaypoint::set(): Invalid values provided, "
+                         "so default values in action!");
   }
   return isValidWaypoint;
 }
@@ -161,31 +160,10 @@ void CWaypoint::getAllDataByReference(std::string &name, double &latitude,
  */
 double CWaypoint::calculateDistance(const CWaypoint &wp)
 {
-  double latitude_1 =
-      CONVERT_DEGREE_TO_RADIAN(
-          this->getLatitude()); /* Convert the first latitude from degree to
-                                   radian format*/
-  double longitude_1 =
-      CONVERT_DEGREE_TO_RADIAN(this->getLongitude()); /* Convert the first
-                                                         longitude from degree
-                                                         to radian format*/
-
-  double latitude_2 =
-      CONVERT_DEGREE_TO_RADIAN(wp.m_latitude); /* Convert the second latitude
-                                                  from degree to radian format*/
-  double longitude_2 = CONVERT_DEGREE_TO_RADIAN(
-      wp.m_longitude); /* Convert the second longitude from degree to radian
-                          format*/
-
-  double distance = EARTH_RADIUS_LENGTH *
-                    acos(sin(latitude_1) * sin(latitude_2) +
-                         cos(latitude_1) * cos(latitude_2) *
-                             cos((longitude_2 - longitude_1))); /* Calculate
-                                                                   distance
-                                                                   between two
-                                                                   Waypoints
-                                                                   using the
-                                                                   formula */
+  double distance = geo_math::greatCircleDistance(
+      this->getLatitude(), this->getLongitude(), wp.m_latitude,
+      wp.m_longitude); /* Calculate distance between two Waypoints using the
+                          formula */
 
   return distance; /* Return the calculated distance */
 }
@@ -37,6 +37,24 @@ void CWpDatabase::addWaypoint(const CWaypoint &wp)
 {
   CDatabase::addData(wp.getName(), wp);
 }
+/**
+ * Adds the Waypoint or replaces the Waypoint of the same name
+ * @param const CWaypoint& wp [IN] - Reference to the Waypoint object
+ * @return None
+ */
+void CWpDatabase::updateWaypoint(const CWaypoint &wp)
+{
+  CDatabase::updateData(wp.getName(), wp);
+}
+/**
+ * Removes the Waypoint from the Waypoint Database
+ * @param const std::string& name [IN] - Name (Key value) of the Waypoint
+ * @return true if the Waypoint was present, false otherwise
+ */
+bool CWpDatabase::removeWaypoint(const std::string &name)
+{
+  return CDatabase::removeData(name);
+}
 /**
  * Clears the contents of WP Database
  * @param None
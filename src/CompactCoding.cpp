@@ -0,0 +1,163 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : CompactCoding.cpp
+* Author          : Jishnu M Thampan
+* Description     : Integer codings of the compact coordinate format
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+
+#include <nsp/CompactCoding.h>
+
+#define MAX_VARINT_SIZE (10) /**< @brief Represents the bytes of a uint64_t */
+#define COORDINATE_OFFSET \
+  (0x80000000u) /**< @brief Represents the step 0 on the Hilbert grid */
+#define LONGITUDE_STEPS \
+  (3600000000LL) /**< @brief Represents the steps of 360 degree */
+#define LATITUDE_STEPS \
+  (1800000000LL) /**< @brief Represents the steps of 180 degree */
+
+namespace compact_coding
+{
+
+/**
+ * Quantizes a coordinate to steps of 1e-7 degree
+ * @param double degree [IN] - Latitude or longitude, within +-180 degree
+ * @return int32_t - The nearest step
+ */
+int32_t quantize(double degree)
+{
+  return static_cast<int32_t>(lround(degree * COORDINATE_SCALE));
+}
+/**
+ * Reads a varint
+ * @param const char*& pData [IN/OUT] - The varint, after it on success
+ * @param const char* pEnd [IN] - The end of the data
+ * @param uint64_t& value [OUT] - The number
+ * @return true if a complete varint of at most 10 bytes is read, false
+ * otherwise
+ */
+bool readVarint(const char *&pData, const char *pEnd, uint64_t &value)
+{
+  value = 0;
+  const char *pLast = pData + std::min<size_t>(MAX_VARINT_SIZE, pEnd - pData);
+  for (int shift = 0; pData != pLast; shift += 7)
+  {
+    unsigned char byte = static_cast<unsigned char>(*pData++);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (0 == (byte & 0x80))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+/**
+ * Appends a number in little-endian byte order
+ * @param std::string& buffer [OUT] - The buffer
+ * @param uint64_t value [IN] - The number
+ * @param size_t size [IN] - The number of bytes, 4 or 8
+ * @return None
+ */
+void appendFixed(std::string &buffer, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; i++)
+  {
+    buffer += static_cast<char>(value >> (8 * i));
+  }
+}
+/**
+ * Reads a number in little-endian byte order
+ * @param const char* pData [IN] - The number
+ * @param size_t size [IN] - The number of bytes, 4 or 8
+ * @return uint64_t - The number
+ */
+uint64_t readFixed(const char *pData, size_t size)
+{
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++)
+  {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(pData[i]))
+             << (8 * i);
+  }
+  return value;
+}
+/**
+ * Gets the position of a coordinate on the Hilbert curve through the grid
+ * of 2^32 x 2^32 steps
+ * @param int32_t latitude [IN] - The quantized latitude
+ * @param int32_t longitude [IN] - The quantized longitude
+ * @return uint64_t - The position on the curve
+ */
+uint64_t getHilbertIndex(int32_t latitude, int32_t longitude)
+{
+  uint32_t x = static_cast<uint32_t>(longitude) + COORDINATE_OFFSET;
+  uint32_t y = static_cast<uint32_t>(latitude) + COORDINATE_OFFSET;
+  uint64_t index = 0;
+  for (uint32_t side = 0x80000000u; side > 0; side >>= 1)
+  {
+    uint32_t isRight = (0 != (x & side)) ? 1 : 0;
+    uint32_t isTop = (0 != (y & side)) ? 1 : 0;
+    index += static_cast<uint64_t>(side) * side * ((3 * isRight) ^ isTop);
+    /* Rotates the quadrant, so that the curve in it starts at its origin */
+    if (0 == isTop)
+    {
+      if (1 == isRight)
+      {
+        x = ~x;
+        y = ~y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+/**
+ * Gets the cell of a coordinate on an axis of 2^level cells
+ * @param int64_t step [IN] - The quantized coordinate from the start of
+ * the axis
+ * @param int64_t steps [IN] - The steps of the axis
+ * @param unsigned int level [IN] - The tile level
+ * @return uint32_t - The cell, clamped to the axis
+ */
+static uint32_t getTileCell(int64_t step, int64_t steps, unsigned int level)
+{
+  level = std::min<unsigned int>(level, MAX_TILE_LEVEL);
+  int64_t cell = (std::max<int64_t>(step, 0) << level) / steps;
+  return static_cast<uint32_t>(
+      std::min<int64_t>(cell, (static_cast<int64_t>(1) << level) - 1));
+}
+/**
+ * Gets the tile column of a longitude or the tile row of a latitude
+ * @param int32_t longitude / latitude [IN] - The quantized coordinate
+ * @param unsigned int level [IN] - The tile level, up to MAX_TILE_LEVEL
+ * @return uint32_t - The column (row), 180 (90) degree is in the last one
+ */
+uint32_t getTileColumn(int32_t longitude, unsigned int level)
+{
+  return getTileCell(longitude + LONGITUDE_STEPS / 2, LONGITUDE_STEPS, level);
+}
+uint32_t getTileRow(int32_t latitude, unsigned int level)
+{
+  return getTileCell(latitude + LATITUDE_STEPS / 2, LATITUDE_STEPS, level);
+}
+/**
+ * Gets the key of a tile
+ * @param uint32_t column [IN] - The column
+ * @param uint32_t row [IN] - The row
+ * @return uint64_t - The key, the bits of column and row interleaved
+ */
+uint64_t getTileKey(uint32_t column, uint32_t row)
+{
+  uint64_t key = 0;
+  for (int bit = 0; bit < 32; bit++)
+  {
+    key |= static_cast<uint64_t>((column >> bit) & 1) << (2 * bit);
+    key |= static_cast<uint64_t>((row >> bit) & 1) << (2 * bit + 1);
+  }
+  return key;
+}
+
+} // namespace compact_coding
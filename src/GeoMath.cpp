@@ -0,0 +1,157 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : GeoMath.cpp
+* Author          : Jishnu M Thampan
+* Description     : Spherical geometry helpers
+****************************************************************************/
+#include <math.h>
+
+#include <algorithm>
+
+#include <nsp/GeoMath.h>
+
+#define MIN_ARC_NORM (1e-12) /**< @brief Represents the norm of the normal
+                                below which an arc is treated as a point */
+
+namespace geo_math
+{
+
+/**
+ * Calculates the cross product of two vectors
+ * @param const double a[3] [IN] - First vector
+ * @param const double b[3] [IN] - Second vector
+ * @param double result[3] [OUT] - a x b
+ * @return None
+ */
+static inline void crossProduct(const double a[3], const double b[3],
+                                double result[3])
+{
+  result[0] = a[1] * b[2] - a[2] * b[1];
+  result[1] = a[2] * b[0] - a[0] * b[2];
+  result[2] = a[0] * b[1] - a[1] * b[0];
+}
+/**
+ * Calculates the dot product of two vectors
+ * @param const double a[3] [IN] - First vector
+ * @param const double b[3] [IN] - Second vector
+ * @return double - a . b
+ */
+static inline double dotProduct(const double a[3], const double b[3])
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+/**
+ * Calculates the angle between two unit vectors. atan2 stays accurate for
+ * the tiny angles between neighbouring track points, where acos does not.
+ * @param const double a[3] [IN] - First unit vector
+ * @param const double b[3] [IN] - Second unit vector
+ * @return double - Angle in radian
+ */
+static inline double angleBetween(const double a[3], const double b[3])
+{
+  double normal[3];
+  crossProduct(a, b, normal);
+  return atan2(sqrt(dotProduct(normal, normal)), dotProduct(a, b));
+}
+
+/**
+ * Calculates the great-circle distance between two coordinates given in
+ * degree
+ * @param double latitude1  [IN] - Latitude of the first coordinate
+ * @param double longitude1 [IN] - Longitude of the first coordinate
+ * @param double latitude2  [IN] - Latitude of the second coordinate
+ * @param double longitude2 [IN] - Longitude of the second coordinate
+ * @return double - Distance in kilometers
+ */
+double greatCircleDistance(double latitude1, double longitude1,
+                           double latitude2, double longitude2)
+{
+  double latitude_1 = CONVERT_DEGREE_TO_RADIAN(latitude1);
+  double latitude_2 = CONVERT_DEGREE_TO_RADIAN(latitude2);
+
+  return greatCircleDistance(sin(latitude_1), cos(latitude_1),
+                             CONVERT_DEGREE_TO_RADIAN(longitude1),
+                             sin(latitude_2), cos(latitude_2),
+                             CONVERT_DEGREE_TO_RADIAN(longitude2));
+}
+/**
+ * Calculates the great-circle distance between two coordinates whose
+ * latitude sine/cosine and longitude (in radian) are already known.
+ * @param double sinLatitude1 [IN] - Sine of the first latitude
+ * @param double cosLatitude1 [IN] - Cosine of the first latitude
+ * @param double longitude1   [IN] - First longitude in radian
+ * @param double sinLatitude2 [IN] - Sine of the second latitude
+ * @param double cosLatitude2 [IN] - Cosine of the second latitude
+ * @param double longitude2   [IN] - Second longitude in radian
+ * @return double - Distance in kilometers
+ */
+double greatCircleDistance(double sinLatitude1, double cosLatitude1,
+                           double longitude1, double sinLatitude2,
+                           double cosLatitude2, double longitude2)
+{
+  double cosAngle = sinLatitude1 * sinLatitude2 +
+                    cosLatitude1 * cosLatitude2 * cos(longitude2 - longitude1);
+  /* Rounding may push the cosine of (almost) identical points slightly above
+   * 1, which would make acos return NaN */
+  if (cosAngle > 1)
+  {
+    cosAngle = 1;
+  }
+  else if (cosAngle < -1)
+  {
+    cosAngle = -1;
+  }
+  return EARTH_RADIUS_LENGTH * acos(cosAngle);
+}
+
+/**
+ * Converts a coordinate given in degree to a unit vector in earth centered
+ * cartesian coordinates
+ * @param double latitude  [IN] - Latitude of the coordinate
+ * @param double longitude [IN] - Longitude of the coordinate
+ * @param double vector[3] [OUT] - The unit vector
+ * @return None
+ */
+void toUnitVector(double latitude, double longitude, double vector[3])
+{
+  double latitudeRad = degreeToRadian(latitude);
+  double longitudeRad = degreeToRadian(longitude);
+  vector[0] = cos(latitudeRad) * cos(longitudeRad);
+  vector[1] = cos(latitudeRad) * sin(longitudeRad);
+  vector[2] = sin(latitudeRad);
+}
+/**
+ * Calculates the distance of a point to the great-circle arc between two
+ * other points. If the foot of the perpendicular lies outside the arc, the
+ * distance to the nearer end of the arc is returned.
+ * @param const double point[3] [IN] - Unit vector of the point
+ * @param const double start[3] [IN] - Unit vector of the start of the arc
+ * @param const double end[3]   [IN] - Unit vector of the end of the arc
+ * @return double - Distance in kilometers
+ */
+double arcDistance(const double point[3], const double start[3],
+                   const double end[3])
+{
+  double normal[3];
+  crossProduct(start, end, normal);
+  double normalLength = sqrt(dotProduct(normal, normal));
+  if (normalLength > MIN_ARC_NORM)
+  {
+    /* The foot of the perpendicular lies on the arc if the point is on the
+     * same side of both planes through the arc ends and the normal */
+    double toStart[3], toEnd[3];
+    crossProduct(start, point, toStart);
+    crossProduct(point, end, toEnd);
+    if ((dotProduct(toStart, normal) >= 0) &&
+        (dotProduct(toEnd, normal) >= 0))
+    {
+      double sinAngle = fabs(dotProduct(normal, point)) / normalLength;
+      return EARTH_RADIUS_LENGTH * asin((sinAngle > 1) ? 1 : sinAngle);
+    }
+  }
+  return EARTH_RADIUS_LENGTH *
+         std::min(angleBetween(point, start), angleBetween(point, end));
+}
+
+} // namespace geo_math
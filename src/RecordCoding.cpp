@@ -0,0 +1,213 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : RecordCoding.cpp
+* Author          : Jishnu M Thampan
+* Description     : Codings of the Waypoints and POIs of CDiskDatabase
+****************************************************************************/
+#include <string.h>
+
+#include <algorithm>
+
+#include <nsp/CompactCoding.h>
+#include <nsp/RecordCoding.h>
+
+#define AREA_CELLS \
+  (4) /**< @brief Represents the cells of an area query along its longer
+         side, the area is covered by up to 5 x 5 cells */
+#define MAX_CELL_LEVEL \
+  (31) /**< @brief Represents the largest cell, 2^31 steps wide */
+#define COORDINATE_OFFSET \
+  (0x80000000u) /**< @brief Represents the step 0 on the Hilbert grid */
+
+namespace record_coding
+{
+
+/**
+ * Appends a double in the byte order of the host
+ */
+static void appendDouble(std::string &record, double value)
+{
+  record.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/**
+ * Codes the record of a Waypoint
+ * @param const CWaypoint& wp [IN] - The Waypoint
+ * @param std::string& record [OUT] - The record
+ * @return None
+ */
+void encodeRecord(const CWaypoint &wp, std::string &record)
+{
+  record.clear();
+  appendDouble(record, wp.getLatitude());
+  appendDouble(record, wp.getLongitude());
+}
+/**
+ * Codes the record of a POI
+ * @param const CPOI& poi [IN] - The POI
+ * @param std::string& record [OUT] - The record
+ * @return None
+ */
+void encodeRecord(const CPOI &poi, std::string &record)
+{
+  record.clear();
+  appendDouble(record, poi.getLatitude());
+  appendDouble(record, poi.getLongitude());
+  record += static_cast<char>(poi.getType());
+  record.append(poi.getDescription());
+}
+/**
+ * Reads the position at the start of a record or of an area value
+ * @param std::string_view record [IN] - The record
+ * @param double& latitude, longitude [OUT] - The position
+ * @return true if the record holds a position, false otherwise
+ */
+bool decodePosition(std::string_view record, double &latitude,
+                    double &longitude)
+{
+  if (record.size() < RECORD_POSITION_SIZE)
+  {
+    return false;
+  }
+  memcpy(&latitude, record.data(), sizeof(latitude));
+  memcpy(&longitude, record.data() + sizeof(latitude), sizeof(longitude));
+  return true;
+}
+/**
+ * Reads the record of a Waypoint
+ * @param std::string_view record [IN] - The record
+ * @param const std::string& name [IN] - The name, the key of the record
+ * @param CWaypoint& wp [OUT] - The Waypoint
+ * @return true if the record is complete, false otherwise
+ */
+bool decodeRecord(std::string_view record, const std::string &name,
+                  CWaypoint &wp)
+{
+  double latitude = 0, longitude = 0;
+  if ((RECORD_POSITION_SIZE != record.size()) ||
+      !decodePosition(record, latitude, longitude))
+  {
+    return false;
+  }
+  wp = CWaypoint(latitude, longitude, name);
+  return true;
+}
+/**
+ * Reads the record of a POI
+ * @param std::string_view record [IN] - The record
+ * @param const std::string& name [IN] - The name, the key of the record
+ * @param CPOI& poi [OUT] - The POI
+ * @return true if the record is complete, false otherwise
+ */
+bool decodeRecord(std::string_view record, const std::string &name,
+                  CPOI &poi)
+{
+  double latitude = 0, longitude = 0;
+  if (!decodePosition(record, latitude, longitude) ||
+      (record.size() <= RECORD_POSITION_SIZE))
+  {
+    return false;
+  }
+  unsigned char type = record[RECORD_POSITION_SIZE];
+  if (type > CPOI::UNKNOWN)
+  {
+    return false;
+  }
+  poi = CPOI(static_cast<CPOI::t_poi>(type), name,
+             std::string(record.substr(RECORD_POSITION_SIZE + 1)), latitude,
+             longitude);
+  return true;
+}
+/**
+ * Gets the first area key of a Hilbert index, of any name
+ * @param uint64_t index [IN] - The Hilbert index
+ * @return std::string - The key
+ */
+std::string getAreaBound(uint64_t index)
+{
+  std::string key(AREA_INDEX_SIZE, '\0');
+  for (int i = AREA_INDEX_SIZE - 1; i >= 0; i--)
+  {
+    key[i] = static_cast<char>(index & 0xff);
+    index >>= 8;
+  }
+  return key;
+}
+/**
+ * Gets the area key of an entry
+ * @param double latitude, longitude [IN] - The position of the entry
+ * @param std::string_view name [IN] - The name of the entry
+ * @param std::string& key [OUT] - The area key
+ * @return None
+ */
+void getAreaKey(double latitude, double longitude, std::string_view name,
+                std::string &key)
+{
+  key = getAreaBound(
+      compact_coding::getHilbertIndex(compact_coding::quantize(latitude),
+                                      compact_coding::quantize(longitude)));
+  key.append(name);
+}
+/**
+ * Gets the ranges of Hilbert indexes which cover an area. The cells are
+ * squares of 2^level steps on the grid of the Hilbert index, aligned to
+ * their size, so the curve passes each of them in 4^level consecutive
+ * indexes. The level is the smallest one with at most AREA_CELLS + 1
+ * cells along each side of the area.
+ * @param double minLatitude, minLongitude [IN] - The south west corner
+ * @param double maxLatitude, maxLongitude [IN] - The north east corner
+ * @param std::vector<std::pair<uint64_t, uint64_t> >& ranges [OUT] - The
+ * first and the last index of each range, in ascending order
+ * @return None
+ */
+void getAreaRanges(double minLatitude, double minLongitude,
+                   double maxLatitude, double maxLongitude,
+                   std::vector<std::pair<uint64_t, uint64_t> > &ranges)
+{
+  ranges.clear();
+  uint32_t minX = compact_coding::quantize(minLongitude) + COORDINATE_OFFSET;
+  uint32_t maxX = compact_coding::quantize(maxLongitude) + COORDINATE_OFFSET;
+  uint32_t minY = compact_coding::quantize(minLatitude) + COORDINATE_OFFSET;
+  uint32_t maxY = compact_coding::quantize(maxLatitude) + COORDINATE_OFFSET;
+  if ((minX > maxX) || (minY > maxY))
+  {
+    return;
+  }
+  uint32_t span = std::max(maxX - minX, maxY - minY);
+  int level = 0;
+  while ((level < MAX_CELL_LEVEL) && ((span >> level) >= AREA_CELLS))
+  {
+    level++;
+  }
+  uint64_t cellIndexes = static_cast<uint64_t>(1) << (2 * level);
+  for (uint64_t x = minX >> level; x <= (maxX >> level); x++)
+  {
+    for (uint64_t y = minY >> level; y <= (maxY >> level); y++)
+    {
+      uint64_t first = compact_coding::getHilbertIndex(
+          static_cast<int32_t>((y << level) - COORDINATE_OFFSET),
+          static_cast<int32_t>((x << level) - COORDINATE_OFFSET));
+      first &= ~(cellIndexes - 1);
+      ranges.push_back(std::make_pair(first, first + (cellIndexes - 1)));
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+  /* Neighbouring cells are often consecutive on the curve */
+  size_t merged = 0;
+  for (size_t i = 1; i < ranges.size(); i++)
+  {
+    if (ranges[i].first - 1 <= ranges[merged].second)
+    {
+      ranges[merged].second =
+          std::max(ranges[merged].second, ranges[i].second);
+    }
+    else
+    {
+      ranges[++merged] = ranges[i];
+    }
+  }
+  ranges.resize(merged + 1);
+}
+
+} // namespace record_coding
@@ -5,7 +5,10 @@
 * Author          : Jishnu M Thampan
 * Description     : Maps the different types
 ****************************************************************************/
-#include <sstream>
+#include <math.h>
+#include <stdint.h>
+
+#include <charconv>
 
 #include <nsp/TypeMapping.h>
 
@@ -25,6 +28,23 @@
 #define WAYPOINT_LONGITUDE_POS \
   (2) /**< @brief Represents the position of Waypoint longitude */
 
+#define MAX_EXACT_MANTISSA \
+  (1ULL << 53) /**< @brief Represents the largest exact double integer */
+#define MAX_EXACT_POWER \
+  (22) /**< @brief Represents the largest exact power of ten in a double */
+#define MAX_MANTISSA_DIGITS \
+  (19) /**< @brief Represents the digits which fit into 64 bits */
+#define MAX_EXPONENT \
+  (100000) /**< @brief Represents the exponent beyond which every double
+                overflows or underflows */
+
+/**
+ * Represents the powers of ten which are exact in a double
+ */
+static const double EXACT_POWERS_OF_TEN[MAX_EXACT_POWER + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
 /**
  * NameSpace type_mapping stores all the relevant methods of converting from one
  * type to another.
@@ -68,11 +88,11 @@ bool validateLongitude(double &longitude)
 /**
  * Converts the string to latitude type. Performs the necessary validations for
  * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& latitude [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToLatitude(const std::string &attr, double &latitude)
+bool convertStringToLatitude(std::string_view attr, double &latitude)
 {
   if (convertStringToDouble(attr, latitude))
   {
@@ -83,11 +103,11 @@ bool convertStringToLatitude(const std::string &attr, double &latitude)
 /**
  * Converts the string to longitude type. Performs the necessary validations for
  * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& longitude [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToLongitude(const std::string &attr, double &longitude)
+bool convertStringToLongitude(std::string_view attr, double &longitude)
 {
   if (convertStringToDouble(attr, longitude))
   {
@@ -97,12 +117,12 @@ bool convertStringToLongitude(const std::string &attr, double &longitude)
 }
 /**
  * Validates the String data
- * @param const std::string& attr - the string data to be validated
+ * @param std::string_view attr - the string data to be validated
  * @return True if Valid string data, else False
  */
-bool validateStringData(const std::string &attr)
+bool validateStringData(std::string_view attr)
 {
-  if (attr.find_first_not_of(' ') != std::string::npos)
+  if (attr.find_first_not_of(' ') != std::string_view::npos)
   {
     return true;
   }
@@ -125,43 +145,154 @@ bool validatePoiType(const CPOI::t_poi &poiType)
 /**
  * Converts the string to double type. Performs the necessary validations for
  * the same.
- * @param const std::string& attr [IN] - Input string to be converted
+ * @param std::string_view attr [IN] - Input string to be converted
  * @param double& val [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToDouble(const std::string &attr, double &val)
+bool convertStringToDouble(std::string_view attr, double &val)
 {
-  std::stringstream ss(attr);
-  ss >> val;
-  if (ss.fail())
+  double number = 0;
+  size_t length = parseDecimal(attr, number);
+  /* Validation: The whole string has to be the number. A second decimal point
+   * as the very last character has always been tolerated, a plus sign never */
+  if ((0 == length) || isinf(number) || ('+' == attr[0]))
   {
     return false;
   }
-  unsigned int dotCount = 0, i = 0;
-  for (; i < attr.length() && (dotCount <= 1); i++)
+  if ((attr.length() != length) &&
+      !((attr.length() == length + 1) && ('.' == attr[length])))
   {
-    char character = attr[i];
-    /* Validation-1: Allow '-' character only in the beginning to indicate a
-     * negative number */
-    if (character == '-' && i == 0)
-      continue;
-
-    /* Validation-2: Allow only numericals between 0-9 */
-    else if (character >= '0' && character <= '9')
-      continue;
-
-    /* Validation-3: Allow decimal point only once */
-    else if (character == '.')
-      dotCount++;
+    return false;
+  }
+  val = number;
+  return true;
+}
+/**
+ * Parses the longest decimal number at the start of the text in a single
+ * pass, independent of the locale and without allocation
+ * @param std::string_view text [IN] - Text starting with the number
+ * @param double& val [OUT] - Converted data
+ * @param bool isExponentAllowed [IN] - Accepts an exponent as in JSON numbers
+ * @return size_t - Characters of the number, 0 if the text starts with none
+ */
+size_t parseDecimal(std::string_view text, double &val, bool isExponentAllowed)
+{
+  const char *pText = text.data(), *pEnd = pText + text.length();
+  const char *pPosition = pText;
+  bool isNegative = (pPosition < pEnd) && ('-' == *pPosition);
+  /* An explicit plus sign is accepted like by strtod() */
+  bool isPositive = (pPosition < pEnd) && ('+' == *pPosition);
+  if (isNegative || isPositive)
+    pPosition++;
 
-    /* If any of the above validations are not passed, stop checking further */
+  uint64_t mantissa = 0;
+  int digits = 0, significantDigits = 0, exponent = 0;
+  int integerDigits = 0, leadingZeros = 0; /* Magnitude of the number */
+  bool isAfterPoint = false;
+  for (; pPosition < pEnd; pPosition++)
+  {
+    char character = *pPosition;
+    if ((character >= '0') && (character <= '9'))
+    {
+      digits++;
+      if ((0 != mantissa) || ('0' != character))
+      {
+        /* Digits beyond 64 bits only matter to the slow path */
+        if (++significantDigits <= MAX_MANTISSA_DIGITS)
+          mantissa = mantissa * 10 + (character - '0');
+        else if (!isAfterPoint)
+          exponent++;
+        if (!isAfterPoint)
+          integerDigits++;
+      }
+      else if (isAfterPoint)
+      {
+        leadingZeros++;
+      }
+      if (isAfterPoint && (significantDigits <= MAX_MANTISSA_DIGITS))
+        exponent--;
+    }
+    else if (('.' == character) && !isAfterPoint)
+      isAfterPoint = true;
     else
       break;
   }
-  /* Iterator has reached the end of the string => all characters have been
-   * validated and fine,
-   * Else validation has failed at some point */
-  return (i == attr.length());
+  if (0 == digits)
+  {
+    return 0; /* No number, e.g. "-", "+" or "." */
+  }
+  /* The exponent is only taken if at least one digit follows */
+  if (isExponentAllowed && (pPosition < pEnd) &&
+      (('e' == *pPosition) || ('E' == *pPosition)))
+  {
+    const char *pExponent = pPosition + 1;
+    bool isExponentNegative = false;
+    if ((pExponent < pEnd) && (('-' == *pExponent) || ('+' == *pExponent)))
+      isExponentNegative = ('-' == *pExponent++);
+    int exponentValue = 0;
+    const char *pExponentDigits = pExponent;
+    for (; (pExponent < pEnd) && (*pExponent >= '0') && (*pExponent <= '9');
+         pExponent++)
+    {
+      if (exponentValue < MAX_EXPONENT)
+        exponentValue = exponentValue * 10 + (*pExponent - '0');
+    }
+    if (pExponent != pExponentDigits)
+    {
+      exponent += isExponentNegative ? -exponentValue : exponentValue;
+      integerDigits += isExponentNegative ? -exponentValue : exponentValue;
+      pPosition = pExponent;
+    }
+  }
+  size_t length = pPosition - pText;
+
+  /* Fast path: mantissa and power of ten are both exact, so a single
+   * multiplication or division rounds correctly */
+  if ((significantDigits <= MAX_MANTISSA_DIGITS) &&
+      (mantissa <= MAX_EXACT_MANTISSA) && (exponent >= -MAX_EXACT_POWER) &&
+      (exponent <= MAX_EXACT_POWER))
+  {
+    double number = (double)mantissa;
+    number = (exponent < 0) ? number / EXACT_POWERS_OF_TEN[-exponent]
+                            : number * EXACT_POWERS_OF_TEN[exponent];
+    val = isNegative ? -number : number;
+    return length;
+  }
+  /* Slow path: correctly rounded conversion of the validated characters */
+  double number = 0;
+  /* std::from_chars() accepts a minus sign only */
+  std::from_chars_result result = std::from_chars(
+      isPositive ? pText + 1 : pText, pPosition, number,
+      isExponentAllowed ? std::chars_format::general
+                        : std::chars_format::fixed);
+  if (std::errc::result_out_of_range == result.ec)
+  {
+    /* The first significant digit tells an overflow from an underflow */
+    bool isOverflow = (0 != mantissa) && ((integerDigits - leadingZeros) > 0);
+    number = isOverflow ? HUGE_VAL : 0.0;
+    number = isNegative ? -number : number;
+  }
+  val = number;
+  return length;
+}
+/**
+ * Formats the double as the shortest decimal text which parses back to the
+ * same value. std::to_chars() without precision gives the shortest round-trip
+ * digits (Ryu), the fixed format keeps the readers free of exponents
+ * @param double val [IN] - Value to be formatted
+ * @param char* pBuffer [OUT] - Buffer receiving the text
+ * @param size_t bufferSize [IN] - Size of the buffer
+ * @return size_t - Characters written, 0 if the buffer is too small
+ */
+size_t formatDouble(double val, char *pBuffer, size_t bufferSize)
+{
+  std::to_chars_result result = std::to_chars(
+      pBuffer, pBuffer + bufferSize, val, std::chars_format::fixed);
+  if (std::errc() != result.ec)
+  {
+    return 0;
+  }
+  return result.ptr - pBuffer;
 }
 /**
  * Converts the string to CPOI type. Performs the necessary validations for the
@@ -174,6 +305,22 @@ bool convertStringToDouble(const std::string &attr, double &val)
 errorCode_t
 convertStringToCPoiType(const std::vector<std::string> &poiAttributeVec,
                         CPOI &poi)
+{
+  std::vector<std::string_view> attributeViews(poiAttributeVec.begin(),
+                                               poiAttributeVec.end());
+  return convertStringToCPoiType(attributeViews, poi);
+}
+/**
+ * Converts the fields of a CSV record to CPOI type without copying them
+ * first. Performs the same validations as the string version.
+ * @param const std::vector<std::string_view>& poiAttributeVec [IN] - Input
+ * views of the CPOI attributes to be converted
+ * @param CPOI &poi [OUT] - Converted data which of CPOI type
+ * @return errorCode_t    - Error codes based on the conversion result
+ */
+errorCode_t
+convertStringToCPoiType(const std::vector<std::string_view> &poiAttributeVec,
+                        CPOI &poi)
 {
   errorCode_t retVal = RC_SUCCESS;
   double latitude = 0, longitude = 0;
@@ -241,6 +388,21 @@ convertStringToCPoiType(const std::vector<std::string> &poiAttributeVec,
 errorCode_t
 convertStringToCWaypointType(const std::vector<std::string> &wpAttributeVec,
                              CWaypoint &wp)
+{
+  std::vector<std::string_view> attributeViews(wpAttributeVec.begin(),
+                                               wpAttributeVec.end());
+  return convertStringToCWaypointType(attributeViews, wp);
+}
+/**
+ * Converts the fields of a CSV record to CWaypoint type without copying them
+ * first. Performs the same validations as the string version.
+ * @param const std::vector<std::string_view>& wpAttributeVec [IN] - Input
+ * views of the Waypoint attributes to be converted
+ * @param CWaypoint& wp [OUT] - Converted data which is of Waypoint type
+ * @return errorCode_t      - Error codes based on the conversion result
+ */
+errorCode_t convertStringToCWaypointType(
+    const std::vector<std::string_view> &wpAttributeVec, CWaypoint &wp)
 {
   errorCode_t retVal = RC_SUCCESS;
   double latitude = 0, longitude = 0;
@@ -327,11 +489,11 @@ bool convertPoiTypeToString(const CPOI::t_poi &poiType,
 /**
  * Converts the string to POI type. Performs the necessary validations for the
  * same.
- * @param const std::string& stringType [IN] - Input string to be converted
+ * @param std::string_view stringType [IN] - Input string to be converted
  * @param CPOI::t_poi& poiType [OUT] - Converted data
  * @return true if conversion is successful, else false
  */
-bool convertStringToPoiType(const std::string &stringType,
+bool convertStringToPoiType(std::string_view stringType,
                             CPOI::t_poi &poiType)
 {
   bool retVal = false;
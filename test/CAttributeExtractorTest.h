@@ -0,0 +1,156 @@
+#ifndef CTEST_ATTRIBUTE_EXTRACTOR_H
+#define CTEST_ATTRIBUTE_EXTRACTOR_H
+
+#include <string>
+#include <string_view>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CAttributeExtractor.h>
+
+class CAttributeExtractorTest:public CppUnit::TestCase
+{
+	private:
+		CAttributeExtractor* m_pExtractor;
+	public:
+		CAttributeExtractorTest() : TestCase("Testing Attribute Extractor"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pExtractor = new CAttributeExtractor();
+			std::vector<char> delimiters;
+			delimiters.push_back(';');
+			delimiters.push_back(',');
+			m_pExtractor->setDelimiters(delimiters);
+			m_pExtractor->setMaxAttributes(5);
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pExtractor) delete m_pExtractor;
+		}
+		/**
+		 * Tests if a line longer than a register is split at every delimiter (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Delimiters are placed on both sides of the 16 and 32 byte block boundaries
+		 *
+		 * Validation:
+		 * Success - If the views hold the attributes, including the empty one
+		 * Failure - Otherwise
+		 */
+		void splitTest()
+		{
+			std::string line = "RESTAURANT;Mensa HDA,the best Mensa in the whole city;;8.6512";
+			std::vector<std::string_view> attributeVec(3, "stale");
+
+			/* Test Execution*/
+			CAttributeExtractor::RC_t errorType = m_pExtractor->extractAttributes(std::string_view(line), attributeVec);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("splitTest failed", CAttributeExtractor::RC_SUCCESS, errorType);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("splitTest failed", (size_t)5, attributeVec.size());
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", "RESTAURANT" == attributeVec[0]);
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", "Mensa HDA" == attributeVec[1]);
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", "the best Mensa in the whole city" == attributeVec[2]);
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", attributeVec[3].empty());
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", "8.6512" == attributeVec[4]);
+			CPPUNIT_ASSERT_MESSAGE("splitTest failed", line.data() + line.length() - 6 == attributeVec[4].data());
+		}
+		/**
+		 * Tests if the split agrees with the string interface for every position of a delimiter (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the attributes end exactly at the delimiter for every line length up to 3 blocks
+		 * Failure - Otherwise
+		 */
+		void blockBoundaryTest()
+		{
+			m_pExtractor->setMaxAttributes(2);
+			for (size_t position = 0; position < 96; position++)
+			{
+				std::string line = std::string(position, 'a') + ";" + std::string(96 - position, 'b');
+				std::vector<std::string> attributeVec;
+
+				/* Test Execution*/
+				CAttributeExtractor::RC_t errorType = m_pExtractor->extractAttributes(line, attributeVec);
+
+				/* Validation */
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("blockBoundaryTest failed", CAttributeExtractor::RC_SUCCESS, errorType);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("blockBoundaryTest failed", (size_t)2, attributeVec.size());
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("blockBoundaryTest failed", position, attributeVec[0].length());
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("blockBoundaryTest failed", 96 - position, attributeVec[1].length());
+			}
+		}
+		/**
+		 * Tests if a wrong number of attributes is reported (Error case)
+		 *
+		 * Validation:
+		 * Success - If too many and too few attributes fail and the string vector is not changed
+		 * Failure - Otherwise
+		 */
+		void attributeCountTest()
+		{
+			std::vector<std::string> attributeVec(1, "kept");
+			std::string tooMany = "RESTAURANT;Mensa HDA;the best Mensa in the whole city;49.8728;8.6512;";
+			std::string tooFew = "RESTAURANT;Mensa HDA;the best Mensa in the whole city;49.8728";
+
+			/* Test Execution*/
+			CAttributeExtractor::RC_t tooManyError = m_pExtractor->extractAttributes(tooMany, attributeVec);
+			CAttributeExtractor::RC_t tooFewError = m_pExtractor->extractAttributes(tooFew, attributeVec);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeCountTest failed", CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES, tooManyError);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeCountTest failed", CAttributeExtractor::RC_INCORRECT_NUMBER_OF_ATTRIBUTES, tooFewError);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeCountTest failed", (size_t)1, attributeVec.size());
+		}
+		/**
+		 * Tests if more delimiters than compared in registers are found (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If every one of the 6 delimiters ends an attribute
+		 * Failure - Otherwise
+		 */
+		void manyDelimitersTest()
+		{
+			std::vector<char> delimiters;
+			std::string delimiterText = ";,|:#!";
+			delimiters.assign(delimiterText.begin(), delimiterText.end());
+			m_pExtractor->setDelimiters(delimiters);
+			m_pExtractor->setMaxAttributes(7);
+			std::vector<std::string_view> attributeVec;
+
+			/* Test Execution*/
+			CAttributeExtractor::RC_t errorType = m_pExtractor->extractAttributes(std::string_view("one;two,three|four:five#six!seven and more"), attributeVec);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("manyDelimitersTest failed", CAttributeExtractor::RC_SUCCESS, errorType);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("manyDelimitersTest failed", (size_t)7, attributeVec.size());
+			CPPUNIT_ASSERT_MESSAGE("manyDelimitersTest failed", "six" == attributeVec[5]);
+			CPPUNIT_ASSERT_MESSAGE("manyDelimitersTest failed", "seven and more" == attributeVec[6]);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CAttributeExtractorTest>("Split Test",
+						&CAttributeExtractorTest::splitTest));
+			suite->addTest(new CppUnit::TestCaller<CAttributeExtractorTest>("Block Boundary Test",
+						&CAttributeExtractorTest::blockBoundaryTest));
+			suite->addTest(new CppUnit::TestCaller<CAttributeExtractorTest>("Attribute Count Test",
+						&CAttributeExtractorTest::attributeCountTest));
+			suite->addTest(new CppUnit::TestCaller<CAttributeExtractorTest>("Many Delimiters Test",
+						&CAttributeExtractorTest::manyDelimitersTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_ATTRIBUTE_EXTRACTOR_H
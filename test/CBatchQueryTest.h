@@ -0,0 +1,206 @@
+#ifndef CTEST_BATCH_QUERY_H
+#define CTEST_BATCH_QUERY_H
+
+#include <math.h>
+
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CBatchQuery.h>
+
+class CBatchQueryTest:public CppUnit::TestCase
+{
+	private:
+		CThreadPool* m_pPool;
+	public:
+		CBatchQueryTest() : TestCase("Testing Batch Queries"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pPool = new CThreadPool(3);
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pPool) delete m_pPool;
+		}
+		/**
+		 * Tests if every task runs exactly once, including tasks submitted by tasks (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the counter matches the number of tasks after wait()
+		 * Failure - Otherwise
+		 */
+		void threadPoolTest()
+		{
+			std::atomic<int> counter(0);
+			CThreadPool* pPool = m_pPool;
+
+			/* Test Execution*/
+			for (int i = 0; i < 100; i++)
+			{
+				m_pPool->submit([&counter, pPool](unsigned int) {
+					counter++;
+					pPool->submit([&counter](unsigned int) { counter += 10; });
+				});
+			}
+			m_pPool->wait();
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("threadPoolTest failed", 1100, counter.load());
+		}
+		/**
+		 * Tests if parallelFor() waits only for its own tasks, when called by tasks and by two callers (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the nested loops run on the worker of their task and the nested and the concurrent
+		 *           loops finish with every index visited once
+		 * Failure - Otherwise
+		 */
+		void nestedParallelForTest()
+		{
+			std::atomic<int> nestedCounter(0), sharedCounter(0), foreignWorkers(0);
+			CThreadPool* pPool = m_pPool;
+
+			/* Test Execution*/
+			m_pPool->parallelFor(6, 1, [&nestedCounter, &foreignWorkers, pPool](size_t, size_t, unsigned int worker) {
+				pPool->parallelFor(100, 7, [&nestedCounter, &foreignWorkers, worker](size_t begin, size_t end,
+						unsigned int nestedWorker) {
+					nestedCounter += (int)(end - begin);
+					foreignWorkers += (worker != nestedWorker) ? 1 : 0;
+				});
+			});
+			std::thread other([&sharedCounter, pPool]() {
+				pPool->parallelFor(1000, 10, [&sharedCounter](size_t begin, size_t end, unsigned int) {
+					sharedCounter += (int)(end - begin);
+				});
+			});
+			m_pPool->parallelFor(1000, 10, [&sharedCounter](size_t begin, size_t end, unsigned int) {
+				sharedCounter += (int)(end - begin);
+			});
+			other.join();
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("nestedParallelForTest failed", 600, nestedCounter.load());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("nestedParallelForTest failed", 0, foreignWorkers.load());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("nestedParallelForTest failed", 2000, sharedCounter.load());
+		}
+		/**
+		 * Tests if the nearest POI of every position is found (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Positions are partly outside the area of the POIs
+		 *
+		 * Validation:
+		 * Success - If every result matches a search over all POIs
+		 * Failure - Otherwise
+		 */
+		void nearestPoiTest()
+		{
+			std::mt19937 generator(1);
+			std::uniform_real_distribution<double> latitude(49.0, 50.0), longitude(8.0, 9.0);
+			CPoiDatabase poiDb;
+			for (int i = 0; i < 500; i++)
+			{
+				std::ostringstream name;
+				name << "poi_" << i;
+				poiDb.addPoi(CPOI(CPOI::RESTAURANT, name.str(), "test", latitude(generator), longitude(generator)));
+			}
+			CSpatialGrid grid;
+			grid.build(poiDb);
+			std::uniform_real_distribution<double> queryLatitude(48.5, 50.5), queryLongitude(7.5, 9.5);
+			std::vector<double> latitudes(200), longitudes(200), distances(200);
+			std::vector<const CPOI*> pois(200);
+			for (size_t i = 0; i < latitudes.size(); i++)
+			{
+				latitudes[i] = queryLatitude(generator);
+				longitudes[i] = queryLongitude(generator);
+			}
+			CBatchQuery batchQuery(*m_pPool);
+			CBatchQuery::batchStats_t stats;
+
+			/* Test Execution*/
+			batchQuery.findNearestPois(grid, latitudes.data(), longitudes.data(), latitudes.size(), pois.data(), distances.data(), stats);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("nearestPoiTest failed", latitudes.size(), stats.queryCount);
+			CPPUNIT_ASSERT_MESSAGE("nearestPoiTest failed", stats.p50LatencyUs <= stats.p99LatencyUs);
+			CPPUNIT_ASSERT_MESSAGE("nearestPoiTest failed", stats.p99LatencyUs <= stats.maxLatencyUs);
+			for (size_t i = 0; i < latitudes.size(); i++)
+			{
+				CWaypoint position(latitudes[i], longitudes[i], "position");
+				double bestDistance = HUGE_VAL;
+				for (CPoiDatabase::const_iterator itr = poiDb.begin(); itr != poiDb.end(); ++itr)
+				{
+					CWaypoint poi = itr->second;
+					bestDistance = std::min(bestDistance, position.calculateDistance(poi));
+				}
+				CPPUNIT_ASSERT_MESSAGE("nearestPoiTest failed", NULL != pois[i]);
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("nearestPoiTest failed", bestDistance, distances[i], 1e-6);
+			}
+		}
+		/**
+		 * Tests if the route distances of all pairs are found (Normal and Error case)
+		 *
+		 * Validation:
+		 * Success - If the reachable pairs have their shortest length and the others HUGE_VAL
+		 * Failure - Otherwise
+		 */
+		void routeDistanceTest()
+		{
+			CRoutingGraph graph;
+			CRoutingGraph::node_t darmstadt  = graph.addNode("Darmstadt", 49.8728, 8.6512);
+			CRoutingGraph::node_t mannheim   = graph.addNode("Mannheim", 49.49671, 8.47955);
+			CRoutingGraph::node_t heidelberg = graph.addNode("Heidelberg", 49.4076, 8.69079);
+			CRoutingGraph::node_t stuttgart  = graph.addNode("Stuttgart", 48.7823, 9.1770200);
+			graph.addEdge(darmstadt, heidelberg, 200);
+			graph.addEdge(darmstadt, mannheim, 50);
+			graph.addEdge(mannheim, heidelberg, 20);
+			graph.addEdge(heidelberg, stuttgart, 90);
+			graph.finalize();
+			CContractionHierarchy hierarchy;
+			hierarchy.build(graph);
+			CRoutingGraph::node_t sources[] = {darmstadt, darmstadt, stuttgart, mannheim};
+			CRoutingGraph::node_t targets[] = {stuttgart, heidelberg, darmstadt, mannheim};
+			double distances[4];
+			CBatchQuery batchQuery(*m_pPool);
+			CBatchQuery::batchStats_t stats;
+
+			/* Test Execution*/
+			batchQuery.findRouteDistances(hierarchy, sources, targets, 4, distances, stats);
+
+			/* Validation */
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("routeDistanceTest failed", 160.0, distances[0], 0.001);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("routeDistanceTest failed", 70.0, distances[1], 0.001);
+			CPPUNIT_ASSERT_MESSAGE("routeDistanceTest failed", HUGE_VAL == distances[2]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("routeDistanceTest failed", 0.0, distances[3], 0.001);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CBatchQueryTest>("Thread Pool Test",
+						&CBatchQueryTest::threadPoolTest));
+			suite->addTest(new CppUnit::TestCaller<CBatchQueryTest>("Nested Parallel For Test",
+						&CBatchQueryTest::nestedParallelForTest));
+			suite->addTest(new CppUnit::TestCaller<CBatchQueryTest>("Nearest POI Test",
+						&CBatchQueryTest::nearestPoiTest));
+			suite->addTest(new CppUnit::TestCaller<CBatchQueryTest>("Route Distance Test",
+						&CBatchQueryTest::routeDistanceTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_BATCH_QUERY_H
@@ -0,0 +1,192 @@
+#ifndef CTEST_BINARY_PERSISTENCE_H
+#define CTEST_BINARY_PERSISTENCE_H
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CBinaryPersistence.h>
+#include <nsp/CDiagnostics.h>
+
+#define BINARY_TEST_MEDIA "CBinaryPersistenceTest"
+#define BINARY_TEST_FILE "myCode/" BINARY_TEST_MEDIA ".bin"
+
+class CBinaryPersistenceTest:public CppUnit::TestCase
+{
+	private:
+		CBinaryPersistence* m_pPersistence;
+		CWpDatabase* m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+		bool m_isDirectoryCreated;
+
+		/**
+		 * Reads the snapshot file
+		 * @return std::string - The contents of the file
+		 */
+		std::string readFile()
+		{
+			std::ifstream file(BINARY_TEST_FILE, std::ios::in | std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+		/**
+		 * Replaces the snapshot file
+		 * @param const std::string& contents [IN] - The contents of the file
+		 */
+		void writeFile(const std::string& contents)
+		{
+			std::ofstream(BINARY_TEST_FILE, std::ios::out | std::ios::binary) << contents;
+		}
+	public:
+		CBinaryPersistenceTest() : TestCase("Testing Binary Persistence"){}
+		void setUp()
+		{
+			m_isDirectoryCreated = (0 == mkdir("myCode", 0755));
+			m_pPersistence = new CBinaryPersistence();
+			m_pPersistence->setMediaName(BINARY_TEST_MEDIA);
+			m_pWpDb = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+			m_pWpDb->addWaypoint(CWaypoint(52.5167, 13.3833, "Berlin"));
+			m_pWpDb->addWaypoint(CWaypoint(48.8566, 2.3522, "Paris"));
+			m_pPoiDb->addPoi(CPOI(CPOI::UNIVERSITY, "HDA", "university", 49.8666, 8.6407));
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Mensa", "", 49.8670, 8.6380));
+		}
+		void tearDown()
+		{
+			remove(BINARY_TEST_FILE);
+			if (m_isDirectoryCreated)
+				rmdir("myCode");
+			delete m_pPersistence;
+			delete m_pWpDb;
+			delete m_pPoiDb;
+		}
+		/**
+		 * Tests if the written snapshot is mapped and read back unchanged (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the snapshot holds the columns in name order, finds every name and readData replaces the Databases
+		 * Failure - Otherwise
+		 */
+		void roundTripTest()
+		{
+			CPPUNIT_ASSERT(m_pPersistence->writeData(*m_pWpDb, *m_pPoiDb));
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+
+			/* Test Execution*/
+			CBinarySnapshot snapshot;
+			bool isMapped = m_pPersistence->readSnapshot(snapshot);
+			bool isRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", isMapped && snapshot.verify() && isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (size_t)2, snapshot.getCount(CBinarySnapshot::WAYPOINT_TABLE));
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", "Paris" == snapshot.getName(CBinarySnapshot::WAYPOINT_TABLE, 1));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", 48.8566, snapshot.getLatitudes(CBinarySnapshot::WAYPOINT_TABLE)[1]);
+			size_t index = 0;
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", snapshot.find(CBinarySnapshot::POI_TABLE, "Mensa", index));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (size_t)1, index);
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", !snapshot.find(CBinarySnapshot::POI_TABLE, "Berlin", index));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (int)CPOI::RESTAURANT, (int)snapshot.getPoiTypes()[1]);
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", "university" == snapshot.getDescription(CBinarySnapshot::POI_TABLE, 0));
+
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (size_t)2, wpDb.size());
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", NULL == wpDb.findData("Rome"));
+			const CWaypoint* pWp = wpDb.findData("Berlin");
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", (NULL != pWp) && (13.3833 == pWp->getLongitude()));
+			const CPOI* pPoi = poiDb.findData("HDA");
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", (NULL != pPoi) && (CPOI::UNIVERSITY == pPoi->getType()));
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", "university" == pPoi->getDescription());
+		}
+		/**
+		 * Tests if MERGE keeps the entries of the Databases (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the entries are added to the present ones and a present name is reported as a duplicate
+		 * Failure - Otherwise
+		 */
+		void mergeTest()
+		{
+			CPPUNIT_ASSERT(m_pPersistence->writeData(*m_pWpDb, *m_pPoiDb));
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+			wpDb.addWaypoint(CWaypoint(1.0, 2.0, "Paris"));
+			std::ostringstream messages;
+			CConsoleSink sink(messages);
+
+			/* Test Execution*/
+			CDiagnostics::setSink(&sink);
+			bool isRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::MERGE);
+			CDiagnostics::setSink(NULL);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("mergeTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mergeTest failed", (size_t)3, wpDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mergeTest failed", (size_t)2, poiDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mergeTest failed", 1.0, wpDb.findData("Paris")->getLatitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mergeTest failed", 1UL,
+					CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY));
+		}
+		/**
+		 * Tests if a damaged or incomplete snapshot is rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If readData fails on a changed byte and on a cut file and the Databases are unchanged
+		 * Failure - Otherwise
+		 */
+		void checksumTest()
+		{
+			CPPUNIT_ASSERT(m_pPersistence->writeData(*m_pWpDb, *m_pPoiDb));
+			std::string contents = readFile();
+			std::string damaged = contents;
+			damaged[damaged.find("Mensa")] = 'm';
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+			std::ostringstream messages;
+			CConsoleSink sink(messages);
+			CBinarySnapshot snapshot;
+
+			/* Test Execution*/
+			CDiagnostics::setSink(&sink);
+			writeFile(damaged);
+			bool isDamagedRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			bool isDamagedMapped = m_pPersistence->readSnapshot(snapshot);
+			bool isDamagedVerified = snapshot.verify();
+			snapshot.close();
+			writeFile(contents.substr(0, contents.size() - 1));
+			bool isCutRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			CDiagnostics::setSink(NULL);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("checksumTest failed", !isDamagedRead && !isCutRead);
+			CPPUNIT_ASSERT_MESSAGE("checksumTest failed", isDamagedMapped && !isDamagedVerified);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("checksumTest failed", (size_t)1, wpDb.size());
+			CPPUNIT_ASSERT_MESSAGE("checksumTest failed", NULL != wpDb.findData("Rome"));
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CBinaryPersistenceTest>("Round Trip Test",
+						&CBinaryPersistenceTest::roundTripTest));
+			suite->addTest(new CppUnit::TestCaller<CBinaryPersistenceTest>("Merge Test",
+						&CBinaryPersistenceTest::mergeTest));
+			suite->addTest(new CppUnit::TestCaller<CBinaryPersistenceTest>("Checksum Test",
+						&CBinaryPersistenceTest::checksumTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_BINARY_PERSISTENCE_H
@@ -0,0 +1,168 @@
+#ifndef CTEST_BUFFERED_WRITER_H
+#define CTEST_BUFFERED_WRITER_H
+
+#include <stdio.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CBufferedWriter.h>
+
+#define WRITER_TEST_FILE "src/CBufferedWriterTest.txt"
+
+class CBufferedWriterTest:public CppUnit::TestCase
+{
+	private:
+		CBufferedWriter* m_pWriter;
+
+		std::string readFile(const char* fileName)
+		{
+			std::ifstream file(fileName, std::ios::in | std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+		/*
+		 * Appends text, characters and numbers over several buffers and
+		 * returns the expected file contents
+		 */
+		std::string appendRecords(unsigned int records)
+		{
+			std::string expected;
+			for (unsigned int i = 0; i < records; i++)
+			{
+				std::string name = "record_" + std::to_string(i);
+				m_pWriter->append(name);
+				m_pWriter->append(';');
+				m_pWriter->appendDouble(i + 0.25);
+				m_pWriter->append('\n');
+				expected += name + ";" + std::to_string(i) + ".25\n";
+			}
+			return expected;
+		}
+	public:
+		CBufferedWriterTest() : TestCase("Testing Buffered Writer"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pWriter = new CBufferedWriter();
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pWriter) delete m_pWriter;
+			remove(WRITER_TEST_FILE);
+		}
+		/**
+		 * Tests if text larger than the buffer is written in order (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the file holds exactly the appended text
+		 * Failure - Otherwise
+		 */
+		void writeTest()
+		{
+			CPPUNIT_ASSERT(m_pWriter->open(WRITER_TEST_FILE));
+			std::string expected = appendRecords(100000);
+
+			/* Test Execution*/
+			bool isClosed = m_pWriter->close();
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("writeTest failed", isClosed);
+			CPPUNIT_ASSERT_MESSAGE("writeTest failed", expected.length() > 2 * WRITE_BUFFER_SIZE);
+			CPPUNIT_ASSERT_MESSAGE("writeTest failed", expected == readFile(WRITER_TEST_FILE));
+		}
+		/**
+		 * Tests if the background I/O thread writes the buffers in order (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. A single append is larger than a buffer
+		 *
+		 * Validation:
+		 * Success - If the file holds exactly the appended text
+		 * Failure - Otherwise
+		 */
+		void backgroundWriteTest()
+		{
+			CPPUNIT_ASSERT(m_pWriter->open(WRITER_TEST_FILE, true));
+			std::string expected = appendRecords(100000);
+			std::string largeText(3 * WRITE_BUFFER_SIZE + 7, 'x');
+			m_pWriter->append(largeText);
+			expected += largeText;
+
+			/* Test Execution*/
+			bool isClosed = m_pWriter->close();
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("backgroundWriteTest failed", isClosed);
+			CPPUNIT_ASSERT_MESSAGE("backgroundWriteTest failed", expected == readFile(WRITER_TEST_FILE));
+		}
+		/**
+		 * Tests if an existing file is truncated and a writer can be opened again (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If only the text of the second open is in the file
+		 * Failure - Otherwise
+		 */
+		void reopenTest()
+		{
+			CPPUNIT_ASSERT(m_pWriter->open(WRITER_TEST_FILE, true));
+			appendRecords(1000);
+			CPPUNIT_ASSERT(m_pWriter->close());
+
+			/* Test Execution*/
+			CPPUNIT_ASSERT(m_pWriter->open(WRITER_TEST_FILE));
+			m_pWriter->append("short");
+			bool isClosed = m_pWriter->close();
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("reopenTest failed", isClosed);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("reopenTest failed", std::string("short"), readFile(WRITER_TEST_FILE));
+			CPPUNIT_ASSERT_MESSAGE("reopenTest failed", !m_pWriter->isOpen());
+		}
+		/**
+		 * Tests if a file which cannot be created is reported (Error case)
+		 *
+		 * Validation:
+		 * Success - If open and close fail
+		 * Failure - Otherwise
+		 */
+		void openFailTest()
+		{
+			/* Test Execution*/
+			bool isOpened = m_pWriter->open("src/missing directory/file.txt", true);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("openFailTest failed", !isOpened);
+			CPPUNIT_ASSERT_MESSAGE("openFailTest failed", !m_pWriter->isOpen());
+			CPPUNIT_ASSERT_MESSAGE("openFailTest failed", !m_pWriter->close());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CBufferedWriterTest>("Write Test",
+						&CBufferedWriterTest::writeTest));
+			suite->addTest(new CppUnit::TestCaller<CBufferedWriterTest>("Background Write Test",
+						&CBufferedWriterTest::backgroundWriteTest));
+			suite->addTest(new CppUnit::TestCaller<CBufferedWriterTest>("Reopen Test",
+						&CBufferedWriterTest::reopenTest));
+			suite->addTest(new CppUnit::TestCaller<CBufferedWriterTest>("Open Fail Test",
+						&CBufferedWriterTest::openFailTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_BUFFERED_WRITER_H
@@ -0,0 +1,247 @@
+#ifndef CTEST_CSV_READER_H
+#define CTEST_CSV_READER_H
+
+#include <stdio.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CCSV.h>
+
+#define CSV_TEST_MEDIA "CCSVReaderTest"
+#define CSV_TEST_WP_FILE "src/" CSV_TEST_MEDIA "-wp.txt"
+#define CSV_TEST_POI_FILE "src/" CSV_TEST_MEDIA "-poi.txt"
+
+class CCSVReaderTest:public CppUnit::TestCase
+{
+	private:
+		CCSV* m_pCsv;
+		CWpDatabase* m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+
+		void writeFile(const char* fileName, const char* contents)
+		{
+			std::ofstream file(fileName, std::ios::out | std::ios::binary);
+			file << contents;
+		}
+	public:
+		CCSVReaderTest() : TestCase("Testing CSV Reader"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pCsv = new CCSV();
+			m_pCsv->setMediaName(CSV_TEST_MEDIA);
+			m_pWpDb = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			remove(CSV_TEST_WP_FILE);
+			remove(CSV_TEST_POI_FILE);
+			if(m_pCsv)   delete m_pCsv;
+			if(m_pWpDb)  delete m_pWpDb;
+			if(m_pPoiDb) delete m_pPoiDb;
+		}
+		/**
+		 * Tests if the records of both files are stored in the databases (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The last line of the Waypoint file has no line break
+		 *
+		 * Validation:
+		 * Success - If every record is stored with its attributes
+		 * Failure - Otherwise
+		 */
+		void readRecordsTest()
+		{
+			writeFile(CSV_TEST_WP_FILE, "Berlin;52.5167;13.3833\n\nAmsterdam,52.3680,4.9036");
+			writeFile(CSV_TEST_POI_FILE, "RESTAURANT;Mensa HDA;the best Mensa;49.8728;8.6512\n");
+
+			/* Test Execution*/
+			bool isRead = m_pCsv->readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::MERGE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("readRecordsTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", (size_t)2, m_pWpDb->size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", (size_t)1, m_pPoiDb->size());
+			CWaypoint* pAmsterdam = m_pWpDb->getPointerToWaypoint("Amsterdam");
+			CPPUNIT_ASSERT_MESSAGE("readRecordsTest failed", NULL != pAmsterdam);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", 4.9036, pAmsterdam->getLongitude());
+			CPOI* pMensa = m_pPoiDb->getPointerToPoi("Mensa HDA");
+			CPPUNIT_ASSERT_MESSAGE("readRecordsTest failed", NULL != pMensa);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", CPOI::RESTAURANT, pMensa->getType());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", std::string("the best Mensa"), pMensa->getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readRecordsTest failed", 49.8728, pMensa->getLatitude());
+		}
+		/**
+		 * Tests if invalid lines are skipped and the valid ones are still stored (Error case)
+		 *
+		 * Validation:
+		 * Success - If only the valid records are stored
+		 * Failure - Otherwise
+		 */
+		void invalidLinesTest()
+		{
+			writeFile(CSV_TEST_WP_FILE, "Berlin;52.5167;13.3833\nToo;many;1;2\nNorth;91;0\nNumber;1.2.3;0\nParis;48.8566;2.3522\n");
+			writeFile(CSV_TEST_POI_FILE, "CAFE;Cafe;coffee;49.8;8.6\nTOURISTIC;Castle; ;49.8;8.6\nTOURISTIC;Tower;old;49.8;8.6\n");
+
+			/* Test Execution*/
+			m_pCsv->readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::MERGE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidLinesTest failed", (size_t)2, m_pWpDb->size());
+			CPPUNIT_ASSERT_MESSAGE("invalidLinesTest failed", NULL != m_pWpDb->getPointerToWaypoint("Paris"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidLinesTest failed", (size_t)1, m_pPoiDb->size());
+			CPPUNIT_ASSERT_MESSAGE("invalidLinesTest failed", NULL != m_pPoiDb->getPointerToPoi("Tower"));
+		}
+		/**
+		 * Tests if written databases are read back unchanged (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the databases read back in REPLACE mode hold the written records
+		 * Failure - Otherwise
+		 */
+		void writeReadTest()
+		{
+			m_pWpDb->addWaypoint(CWaypoint(52.5167, 13.3833, "Berlin"));
+			m_pPoiDb->addPoi(CPOI(CPOI::UNIVERSITY, "HDA", "university", 49.8666, 8.6407));
+			CPPUNIT_ASSERT(m_pCsv->writeData(*m_pWpDb, *m_pPoiDb));
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(0, 0, "Removed"));
+
+			/* Test Execution*/
+			bool isRead = m_pCsv->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("writeReadTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("writeReadTest failed", (size_t)1, wpDb.size());
+			CPPUNIT_ASSERT_MESSAGE("writeReadTest failed", NULL != wpDb.getPointerToWaypoint("Berlin"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("writeReadTest failed", (size_t)1, poiDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("writeReadTest failed", 8.6407, poiDb.getPointerToPoi("HDA")->getLongitude());
+		}
+		/**
+		 * Tests if coordinates with all 17 significant digits survive a write and read (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the coordinates read back are bit for bit the written ones
+		 * Failure - Otherwise
+		 */
+		void exactRoundTripTest()
+		{
+			m_pWpDb->addWaypoint(CWaypoint(49.872812345669999, -1.0 / 3, "Darmstadt"));
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Cafe", "coffee", 0.000012345678901234567, 179.99999999999997));
+			CPPUNIT_ASSERT(m_pCsv->writeData(*m_pWpDb, *m_pPoiDb));
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+
+			/* Test Execution*/
+			m_pCsv->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("exactRoundTripTest failed", NULL != wpDb.getPointerToWaypoint("Darmstadt"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exactRoundTripTest failed", 49.872812345669999, wpDb.getPointerToWaypoint("Darmstadt")->getLatitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exactRoundTripTest failed", -1.0 / 3, wpDb.getPointerToWaypoint("Darmstadt")->getLongitude());
+			CPPUNIT_ASSERT_MESSAGE("exactRoundTripTest failed", NULL != poiDb.getPointerToPoi("Cafe"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exactRoundTripTest failed", 0.000012345678901234567, poiDb.getPointerToPoi("Cafe")->getLatitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exactRoundTripTest failed", 179.99999999999997, poiDb.getPointerToPoi("Cafe")->getLongitude());
+		}
+		/**
+		 * Tests if a missing file keeps the databases in REPLACE mode (Error case)
+		 *
+		 * Validation:
+		 * Success - If readData fails and the databases are unchanged
+		 * Failure - Otherwise
+		 */
+		void missingFileTest()
+		{
+			m_pWpDb->addWaypoint(CWaypoint(52.5167, 13.3833, "Berlin"));
+
+			/* Test Execution*/
+			bool isRead = m_pCsv->readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("missingFileTest failed", !isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("missingFileTest failed", (size_t)1, m_pWpDb->size());
+		}
+		/**
+		 * Tests if a file parsed in chunks on several threads gives the result of a sequential parse (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The file is large enough for several chunks and has invalid lines and duplicate names
+		 *
+		 * Validation:
+		 * Success - If the databases and the printed error messages (with line numbers) are equal
+		 * Failure - Otherwise
+		 */
+		void parallelReadTest()
+		{
+			std::ostringstream contents;
+			for (int i = 0; i < 200000; i++)
+			{
+				contents << "wp_" << i % 140000 << ";" << (i % 179) - 89 << ".25;" << i % 360 - 180 << "\n";
+				if (0 == i % 997)
+				{
+					contents << "invalid;line\n\n";
+				}
+			}
+			writeFile(CSV_TEST_WP_FILE, contents.str().c_str());
+			writeFile(CSV_TEST_POI_FILE, "");
+			std::ostringstream sequentialOutput, parallelOutput;
+			std::streambuf* pCoutBuffer = std::cout.rdbuf(sequentialOutput.rdbuf());
+			m_pCsv->setThreadCount(1);
+			m_pCsv->readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::REPLACE);
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			m_pCsv->setThreadCount(4);
+
+			/* Test Execution*/
+			std::cout.rdbuf(parallelOutput.rdbuf());
+			m_pCsv->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			std::cout.rdbuf(pCoutBuffer);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelReadTest failed", (size_t)140000, wpDb.size());
+			/* The last invalid line follows record 199400 and 200 earlier pairs of inserted lines */
+			CPPUNIT_ASSERT_MESSAGE("parallelReadTest failed", std::string::npos != parallelOutput.str().find("line_no: 199802\n"));
+			CPPUNIT_ASSERT_MESSAGE("parallelReadTest failed", sequentialOutput.str() == parallelOutput.str());
+			CWpDatabase::const_iterator parallelItr = wpDb.begin();
+			for (CWpDatabase::const_iterator itr = m_pWpDb->begin(); itr != m_pWpDb->end(); ++itr, ++parallelItr)
+			{
+				CPPUNIT_ASSERT_MESSAGE("parallelReadTest failed", itr->first == parallelItr->first);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelReadTest failed", itr->second.getLatitude(), parallelItr->second.getLatitude());
+			}
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Read Records Test",
+						&CCSVReaderTest::readRecordsTest));
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Invalid Lines Test",
+						&CCSVReaderTest::invalidLinesTest));
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Write Read Test",
+						&CCSVReaderTest::writeReadTest));
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Exact Round Trip Test",
+						&CCSVReaderTest::exactRoundTripTest));
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Missing File Test",
+						&CCSVReaderTest::missingFileTest));
+			suite->addTest(new CppUnit::TestCaller<CCSVReaderTest>("Parallel Read Test",
+						&CCSVReaderTest::parallelReadTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_CSV_READER_H
@@ -0,0 +1,235 @@
+#ifndef CTEST_COMPACT_PERSISTENCE_H
+#define CTEST_COMPACT_PERSISTENCE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CCompactDecoder.h>
+#include <nsp/CCompactEncoder.h>
+#include <nsp/CCompactPersistence.h>
+#include <nsp/CDiagnostics.h>
+
+#define COMPACT_TEST_MEDIA "CCompactPersistenceTest"
+#define COMPACT_TEST_FILE "myCode/" COMPACT_TEST_MEDIA ".nspc"
+
+class CCompactPersistenceTest:public CppUnit::TestCase
+{
+	private:
+		CCompactPersistence* m_pPersistence;
+		CWpDatabase* m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+		bool m_isDirectoryCreated;
+
+		/**
+		 * Reads the compact file
+		 * @return std::string - The contents of the file
+		 */
+		std::string readFile()
+		{
+			std::ifstream file(COMPACT_TEST_FILE, std::ios::in | std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+	public:
+		CCompactPersistenceTest() : TestCase("Testing Compact Persistence"){}
+		void setUp()
+		{
+			m_isDirectoryCreated = (0 == mkdir("myCode", 0755));
+			m_pPersistence = new CCompactPersistence();
+			m_pPersistence->setMediaName(COMPACT_TEST_MEDIA);
+			m_pWpDb = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+			m_pWpDb->addWaypoint(CWaypoint(52.5167, 13.3833, "Berlin"));
+			m_pWpDb->addWaypoint(CWaypoint(-33.8688197, 151.2092955, "Sydney"));
+			m_pWpDb->addWaypoint(CWaypoint(90, -180, "Pole"));
+			m_pPoiDb->addPoi(CPOI(CPOI::UNIVERSITY, "HDA", "university", 49.8666, 8.6407));
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Mensa", "", 49.8670, 8.6380));
+		}
+		void tearDown()
+		{
+			remove(COMPACT_TEST_FILE);
+			if (m_isDirectoryCreated)
+				rmdir("myCode");
+			delete m_pPersistence;
+			delete m_pWpDb;
+			delete m_pPoiDb;
+		}
+		/**
+		 * Tests the integer codings at their limits (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If zigzag and varint codes are read back, the Hilbert index is a bijection of neighbours
+		 * Failure - Otherwise
+		 */
+		void codingTest()
+		{
+			int64_t values[] = {0, -1, 1, -3600000000LL, 3600000000LL, INT64_MIN, INT64_MAX};
+			std::string buffer;
+
+			/* Test Execution*/
+			for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+				compact_coding::appendVarint(buffer, compact_coding::zigzagEncode(values[i]));
+
+			/* Validation */
+			const char* pData = buffer.data();
+			for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+			{
+				uint64_t value = 0;
+				CPPUNIT_ASSERT_MESSAGE("codingTest failed", compact_coding::readVarint(pData, buffer.data() + buffer.size(), value));
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("codingTest failed", values[i], compact_coding::zigzagDecode(value));
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("codingTest failed", (uint64_t)1, compact_coding::zigzagEncode(-1));
+			uint64_t value = 0;
+			const char* pCut = buffer.data() + buffer.size() - 1;
+			CPPUNIT_ASSERT_MESSAGE("codingTest failed", !compact_coding::readVarint(pCut, pCut, value));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("codingTest failed", 49.8666, compact_coding::dequantize(compact_coding::quantize(49.8666)));
+			/* The four cells of a 2 x 2 square follow each other on the curve */
+			uint64_t first = compact_coding::getHilbertIndex(0, 0);
+			uint64_t cells[] = {first, compact_coding::getHilbertIndex(0, 1), compact_coding::getHilbertIndex(1, 0),
+					compact_coding::getHilbertIndex(1, 1)};
+			std::sort(cells, cells + 4);
+			CPPUNIT_ASSERT_MESSAGE("codingTest failed", (cells[3] - cells[0] == 3) && (cells[1] != cells[0]) && (cells[2] != cells[1]));
+		}
+		/**
+		 * Tests if the Databases are read back from the compact file (Normal case)
+		 *
+		 * Validation:
+		 * Success - If REPLACE reads every entry with coordinates of up to 7 decimals unchanged
+		 * Failure - Otherwise
+		 */
+		void roundTripTest()
+		{
+			CPPUNIT_ASSERT(m_pPersistence->writeData(*m_pWpDb, *m_pPoiDb));
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+
+			/* Test Execution*/
+			bool isRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (size_t)3, wpDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", (size_t)2, poiDb.size());
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", NULL == wpDb.findData("Rome"));
+			const CWaypoint* pWp = wpDb.findData("Sydney");
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", NULL != pWp);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", -33.8688197, pWp->getLatitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", 151.2092955, pWp->getLongitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", -180.0, wpDb.findData("Pole")->getLongitude());
+			const CPOI* pPoi = poiDb.findData("HDA");
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", (NULL != pPoi) && (CPOI::UNIVERSITY == pPoi->getType()));
+			CPPUNIT_ASSERT_MESSAGE("roundTripTest failed", "university" == pPoi->getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("roundTripTest failed", 8.6407, pPoi->getLongitude());
+		}
+		/**
+		 * Tests if the encoder keeps the order of a stream and the blocks are decoded on their own (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the records come back in their order, split into blocks which hold their area
+		 * Failure - Otherwise
+		 */
+		void streamTest()
+		{
+			CCompactEncoder encoder;
+			CPPUNIT_ASSERT(encoder.open(COMPACT_TEST_FILE, 2));
+			const char* names[] = {"Start", "North", "South", "End", "Detour"};
+			double latitudes[] = {49.87, 49.88, 49.86, 49.87, 12.5};
+
+			/* Test Execution*/
+			for (int i = 0; i < 5; i++)
+				encoder.addWaypoint(CWaypoint(latitudes[i], 8.64, names[i]));
+			encoder.addPoi(CPOI(CPOI::GASSTATION, "Fuel", "open", 49.8, 8.6));
+			bool isWritten = encoder.close();
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("streamTest failed", isWritten);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", (size_t)readFile().size(), (size_t)encoder.getSize());
+			CCompactDecoder decoder;
+			CPPUNIT_ASSERT_MESSAGE("streamTest failed", decoder.open(COMPACT_TEST_FILE) && decoder.verify());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", (size_t)4, decoder.getBlockCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", (uint64_t)5, decoder.getRecordCount(compact_coding::WAYPOINT_TABLE));
+			std::vector<CCompactDecoder::record_t> records;
+			size_t waypoint = 0;
+			for (size_t block = 0; block < decoder.getBlockCount(); block++)
+			{
+				CCompactDecoder::blockInfo_t info;
+				CPPUNIT_ASSERT_MESSAGE("streamTest failed", decoder.getBlockInfo(block, info) && decoder.decodeBlock(block, records));
+				for (size_t i = 0; i < records.size(); i++)
+				{
+					CPPUNIT_ASSERT_MESSAGE("streamTest failed", (info.minLatitude <= records[i].latitude) && (records[i].latitude <= info.maxLatitude));
+					if (compact_coding::POI_TABLE == info.table)
+					{
+						CPPUNIT_ASSERT_MESSAGE("streamTest failed", ("Fuel" == records[i].name) && ("open" == records[i].description));
+						CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", (int)CPOI::GASSTATION, (int)records[i].type);
+						continue;
+					}
+					CPPUNIT_ASSERT_MESSAGE("streamTest failed", names[waypoint] == records[i].name);
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", latitudes[waypoint], records[i].latitude);
+					waypoint++;
+				}
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("streamTest failed", (size_t)5, waypoint);
+		}
+		/**
+		 * Tests if a damaged or incomplete compact file is rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If readData fails on a changed byte and on a cut file and the Databases are unchanged
+		 * Failure - Otherwise
+		 */
+		void checksumTest()
+		{
+			CPPUNIT_ASSERT(m_pPersistence->writeData(*m_pWpDb, *m_pPoiDb));
+			std::string contents = readFile();
+			std::string damaged = contents;
+			damaged[damaged.find("Mensa")] = 'm';
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			wpDb.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+			std::ostringstream messages;
+			CConsoleSink sink(messages);
+
+			/* Test Execution*/
+			CDiagnostics::setSink(&sink);
+			std::ofstream(COMPACT_TEST_FILE, std::ios::out | std::ios::binary) << damaged;
+			bool isDamagedRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			std::ofstream(COMPACT_TEST_FILE, std::ios::out | std::ios::binary) << contents.substr(0, contents.size() - 1);
+			bool isCutRead = m_pPersistence->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			CDiagnostics::setSink(NULL);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("checksumTest failed", !isDamagedRead && !isCutRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("checksumTest failed", (size_t)1, wpDb.size());
+			CPPUNIT_ASSERT_MESSAGE("checksumTest failed", NULL != wpDb.findData("Rome"));
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CCompactPersistenceTest>("Coding Test",
+						&CCompactPersistenceTest::codingTest));
+			suite->addTest(new CppUnit::TestCaller<CCompactPersistenceTest>("Compact Round Trip Test",
+						&CCompactPersistenceTest::roundTripTest));
+			suite->addTest(new CppUnit::TestCaller<CCompactPersistenceTest>("Stream Test",
+						&CCompactPersistenceTest::streamTest));
+			suite->addTest(new CppUnit::TestCaller<CCompactPersistenceTest>("Compact Checksum Test",
+						&CCompactPersistenceTest::checksumTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_COMPACT_PERSISTENCE_H
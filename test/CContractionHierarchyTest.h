@@ -0,0 +1,254 @@
+#ifndef CTEST_CONTRACTION_HIERARCHY_H
+#define CTEST_CONTRACTION_HIERARCHY_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CContractionHierarchy.h>
+#include <nsp/CHierarchyRouteFinder.h>
+
+#define CH_TEST_FILE "CContractionHierarchyTest.ch"
+
+class CContractionHierarchyTest:public CppUnit::TestCase
+{
+	private:
+		CRoutingGraph* m_pGraph;
+		CRoutingGraph::node_t m_darmstadt, m_mannheim, m_heidelberg, m_stuttgart, m_berlin;
+	public:
+		CContractionHierarchyTest() : TestCase("Testing Contraction Hierarchy"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pGraph     = new CRoutingGraph();
+			m_darmstadt  = m_pGraph->addNode("Darmstadt", 49.8728, 8.6512);
+			m_mannheim   = m_pGraph->addNode("Mannheim", 49.49671, 8.47955);
+			m_heidelberg = m_pGraph->addNode("Heidelberg", 49.4076, 8.69079);
+			m_stuttgart  = m_pGraph->addNode("Stuttgart", 48.7823, 9.1770200);
+			m_berlin     = m_pGraph->addNode("Berlin", 52.5166, 13.4050);
+
+			/* Darmstadt -> Heidelberg directly is long, the detour via Mannheim is shorter */
+			m_pGraph->addEdge(m_darmstadt, m_heidelberg, 200);
+			m_pGraph->addEdge(m_darmstadt, m_mannheim, 50);
+			m_pGraph->addEdge(m_mannheim, m_heidelberg, 20);
+			m_pGraph->addEdge(m_heidelberg, m_stuttgart, 90);
+			m_pGraph->finalize();
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pGraph) delete m_pGraph;
+			remove(CH_TEST_FILE);
+		}
+		/**
+		 * Tests if the shortest path is found and the shortcuts are unpacked (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the detour via Mannheim is returned with its length
+		 * Failure - Otherwise
+		 */
+		void shortestPathTest()
+		{
+			CContractionHierarchy hierarchy;
+			hierarchy.build(*m_pGraph, 2);
+			CHierarchyRouteFinder finder(hierarchy);
+			std::vector<CRoutingGraph::node_t> path;
+			double distance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findPath(m_darmstadt, m_stuttgart, path, distance);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("shortestPathTest failed", isFound);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("shortestPathTest failed", (size_t)4, path.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("shortestPathTest failed", m_mannheim, path[1]);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("shortestPathTest failed", m_heidelberg, path[2]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("shortestPathTest failed", 160.0, distance, 0.001);
+		}
+		/**
+		 * Tests if no path is reported against the direction of the edges (Error case)
+		 *
+		 * Validation:
+		 * Success - If the search fails for a reversed and an unconnected query
+		 * Failure - Otherwise
+		 */
+		void unreachableTest()
+		{
+			CContractionHierarchy hierarchy;
+			hierarchy.build(*m_pGraph, 1);
+			CHierarchyRouteFinder finder(hierarchy);
+			std::vector<CRoutingGraph::node_t> path;
+			double distance = 0;
+
+			/* Test Execution & Validation */
+			CPPUNIT_ASSERT_MESSAGE("unreachableTest failed", !finder.findPath(m_stuttgart, m_darmstadt, path, distance));
+			CPPUNIT_ASSERT_MESSAGE("unreachableTest failed", !finder.findPath(m_darmstadt, m_berlin, path, distance));
+			CPPUNIT_ASSERT_MESSAGE("unreachableTest failed", path.empty());
+		}
+		/**
+		 * Tests if the shortcuts are kept when the nodes of one round are each other's only witnesses (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the paths across a cycle of equal edges are found with their length
+		 * Failure - Otherwise
+		 */
+		void tiedWeightsTest()
+		{
+			CRoutingGraph graph;
+			/* A and B come first, so the ties select both of them in the first round */
+			CRoutingGraph::node_t a = graph.addNode("A", 49.1, 8.0);
+			CRoutingGraph::node_t b = graph.addNode("B", 49.0, 8.1);
+			CRoutingGraph::node_t u = graph.addNode("U", 49.0, 8.0);
+			CRoutingGraph::node_t x = graph.addNode("X", 49.1, 8.1);
+			CRoutingGraph::node_t cycle[] = {u, a, x, b};
+			for (int i = 0; i < 4; i++)
+			{
+				graph.addEdge(cycle[i], cycle[(i + 1) % 4], 20);
+				graph.addEdge(cycle[(i + 1) % 4], cycle[i], 20);
+			}
+			graph.finalize();
+			CContractionHierarchy hierarchy;
+			hierarchy.build(graph, 1);
+			CHierarchyRouteFinder finder(hierarchy);
+			std::vector<CRoutingGraph::node_t> path;
+			double distance = 0, crossDistance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findPath(u, x, path, distance);
+			bool isCrossFound = finder.findPath(a, b, path, crossDistance);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("tiedWeightsTest failed", isFound && isCrossFound);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tiedWeightsTest failed", (size_t)3, path.size());
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("tiedWeightsTest failed", 40.0, distance, 0.001);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("tiedWeightsTest failed", 40.0, crossDistance, 0.001);
+		}
+		/**
+		 * Tests if a hierarchy read from a file answers the queries (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Route has to be connected to a Waypoint Database holding the nodes
+		 *
+		 * Validation:
+		 * Success - If the file is mapped and the route holds the path in order
+		 * Failure - Otherwise
+		 */
+		void mappedFileTest()
+		{
+			CContractionHierarchy hierarchy;
+			hierarchy.build(*m_pGraph);
+			CPPUNIT_ASSERT_MESSAGE("mappedFileTest failed", hierarchy.writeToFile(CH_TEST_FILE));
+			hierarchy.clear();
+			CPPUNIT_ASSERT_MESSAGE("mappedFileTest failed", hierarchy.openFile(CH_TEST_FILE));
+
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			for (CRoutingGraph::node_t node = 0; node < m_pGraph->getNodeCount(); node++)
+			{
+				wpDb.addWaypoint(CWaypoint(m_pGraph->getLatitude(node), m_pGraph->getLongitude(node), m_pGraph->getNodeName(node)));
+			}
+			CRoute route;
+			route.connectToWpDatabase(&wpDb);
+			route.connectToPoiDatabase(&poiDb);
+			CHierarchyRouteFinder finder(hierarchy);
+			double distance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findRoute("Darmstadt", "Heidelberg", route, distance);
+
+			/* Validation */
+			const std::vector<const CWaypoint*> routeVec = route.getRoute();
+			CPPUNIT_ASSERT_MESSAGE("mappedFileTest failed", isFound);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mappedFileTest failed", m_pGraph->getNodeCount(), hierarchy.getNodeCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mappedFileTest failed", (size_t)3, routeVec.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("mappedFileTest failed", std::string("Mannheim"), routeVec[1]->getName());
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("mappedFileTest failed", 70.0, distance, 0.001);
+		}
+		/**
+		 * Tests if a file which is no hierarchy is rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If opening fails and the hierarchy stays empty
+		 * Failure - Otherwise
+		 */
+		void invalidFileTest()
+		{
+			FILE* pFile = fopen(CH_TEST_FILE, "w");
+			fputs("Darmstadt;Mannheim;50\n", pFile);
+			fclose(pFile);
+			CContractionHierarchy hierarchy;
+			CRoutingGraph::node_t node;
+
+			/* Test Execution & Validation */
+			CPPUNIT_ASSERT_MESSAGE("invalidFileTest failed", !hierarchy.openFile(CH_TEST_FILE));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidFileTest failed", (CRoutingGraph::node_t)0, hierarchy.getNodeCount());
+			CPPUNIT_ASSERT_MESSAGE("invalidFileTest failed", !hierarchy.getNode("Darmstadt", node));
+		}
+		/**
+		 * Tests if a hierarchy file with an edge or an offset out of range is rejected (Error case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The first upward edge follows the header (32 bytes) and the 6 upward offsets (24 bytes)
+		 *
+		 * Validation:
+		 * Success - If opening fails for both files and the hierarchy stays empty
+		 * Failure - Otherwise
+		 */
+		void corruptFileTest()
+		{
+			CContractionHierarchy hierarchy;
+			hierarchy.build(*m_pGraph);
+			uint32_t outOfRange = 1000;
+
+			/* Test Execution*/
+			CPPUNIT_ASSERT(hierarchy.writeToFile(CH_TEST_FILE));
+			FILE* pFile = fopen(CH_TEST_FILE, "r+b");
+			fseek(pFile, 56, SEEK_SET);
+			fwrite(&outOfRange, sizeof(outOfRange), 1, pFile);
+			fclose(pFile);
+			CContractionHierarchy targetHierarchy;
+			bool isTargetOpened = targetHierarchy.openFile(CH_TEST_FILE);
+
+			CPPUNIT_ASSERT(hierarchy.writeToFile(CH_TEST_FILE));
+			pFile = fopen(CH_TEST_FILE, "r+b");
+			fseek(pFile, 36, SEEK_SET);
+			fwrite(&outOfRange, sizeof(outOfRange), 1, pFile);
+			fclose(pFile);
+			CContractionHierarchy offsetHierarchy;
+			bool isOffsetOpened = offsetHierarchy.openFile(CH_TEST_FILE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("corruptFileTest failed", !isTargetOpened && !isOffsetOpened);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("corruptFileTest failed", (CRoutingGraph::node_t)0, targetHierarchy.getNodeCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("corruptFileTest failed", (CRoutingGraph::node_t)0, offsetHierarchy.getNodeCount());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Shortest Path Test",
+						&CContractionHierarchyTest::shortestPathTest));
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Unreachable Destination Test",
+						&CContractionHierarchyTest::unreachableTest));
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Tied Weights Test",
+						&CContractionHierarchyTest::tiedWeightsTest));
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Mapped File Test",
+						&CContractionHierarchyTest::mappedFileTest));
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Invalid File Test",
+						&CContractionHierarchyTest::invalidFileTest));
+			suite->addTest(new CppUnit::TestCaller<CContractionHierarchyTest>("Corrupt File Test",
+						&CContractionHierarchyTest::corruptFileTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_CONTRACTION_HIERARCHY_H
@@ -0,0 +1,207 @@
+#ifndef CTEST_DIAGNOSTICS_H
+#define CTEST_DIAGNOSTICS_H
+
+#include <stdio.h>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CCSV.h>
+#include <nsp/CDiagnostics.h>
+
+#define DIAGNOSTICS_TEST_MEDIA "CDiagnosticsTest"
+#define DIAGNOSTICS_TEST_WP_FILE "src/" DIAGNOSTICS_TEST_MEDIA "-wp.txt"
+#define DIAGNOSTICS_TEST_POI_FILE "src/" DIAGNOSTICS_TEST_MEDIA "-poi.txt"
+
+/*
+ * Keeps the written messages in memory
+ */
+class CTestSink:public CDiagnosticSink
+{
+	public:
+		std::mutex m_mutex;
+		std::vector<std::string> m_messages;
+
+		void write(CDiagnostics::category_t, std::string_view message)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_messages.push_back(std::string(message));
+		}
+};
+
+class CDiagnosticsTest:public CppUnit::TestCase
+{
+	private:
+		CTestSink* m_pSink;
+
+		void writeFile(const char* fileName, const char* contents)
+		{
+			std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+			file << contents;
+		}
+	public:
+		CDiagnosticsTest() : TestCase("Testing Diagnostics"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pSink = new CTestSink();
+			CDiagnostics::setSink(m_pSink);
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			CDiagnostics::setSink(NULL);
+			CDiagnostics::setSampling(DIAGNOSTIC_SAMPLE_LIMIT, DIAGNOSTIC_SAMPLE_INTERVAL);
+			if(m_pSink) delete m_pSink;
+			remove(DIAGNOSTICS_TEST_WP_FILE);
+			remove(DIAGNOSTICS_TEST_POI_FILE);
+		}
+		/**
+		 * Tests if a diagnostic outside of a load is counted and written to the set sink (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the duplicate is counted once and its message is written
+		 * Failure - Otherwise
+		 */
+		void countTest()
+		{
+			CWpDatabase wpDb;
+			wpDb.addWaypoint(CWaypoint(49.8728, 8.6512, "Darmstadt"));
+			unsigned long duplicates = CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY);
+
+			/* Test Execution*/
+			wpDb.addWaypoint(CWaypoint(49.8728, 8.6512, "Darmstadt"));
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("countTest failed", duplicates + 1, CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("countTest failed", (size_t)1, m_pSink->m_messages.size());
+			CPPUNIT_ASSERT_MESSAGE("countTest failed", std::string::npos != m_pSink->m_messages[0].find("Data already present"));
+		}
+		/**
+		 * Tests if only a sample of the messages of a load is written and the load ends with a summary (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The first 3 and then every 10th message of a category are written
+		 *
+		 * Validation:
+		 * Success - If the messages 1, 2, 3, 13 and 23 of 25 and the summary are written
+		 * Failure - Otherwise
+		 */
+		void samplingTest()
+		{
+			CDiagnostics::setSampling(3, 10);
+
+			/* Test Execution*/
+			CDiagnostics::beginLoad();
+			for (int i = 1; i <= 25; i++)
+			{
+				CDiagnostics::report(CDiagnostics::INVALID_RECORD, "record " + std::to_string(i));
+			}
+			CDiagnostics::endLoad("Sampling Test");
+
+			/* Validation */
+			std::vector<std::string> expected = {"record 1", "record 2", "record 3", "record 13", "record 23",
+					"SUMMARY!Sampling Test: 25 invalid records (20 messages not shown)"};
+			CPPUNIT_ASSERT_MESSAGE("samplingTest failed", expected == m_pSink->m_messages);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("samplingTest failed", 25ul, CDiagnostics::getCount(CDiagnostics::INVALID_RECORD));
+		}
+		/**
+		 * Tests if reading a dirty CSV file counts its diagnostics per category (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The Waypoint file has a duplicate name and an invalid line
+		 *
+		 * Validation:
+		 * Success - If 1 duplicate entry and 1 invalid record are counted and summarized at the end
+		 * Failure - Otherwise
+		 */
+		void loadSummaryTest()
+		{
+			writeFile(DIAGNOSTICS_TEST_WP_FILE, "Berlin;52.5167;13.3833\nBerlin;52.5167;13.3833\nNorth;91;0\n");
+			writeFile(DIAGNOSTICS_TEST_POI_FILE, "");
+			CCSV csv;
+			csv.setMediaName(DIAGNOSTICS_TEST_MEDIA);
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+
+			/* Test Execution*/
+			csv.readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadSummaryTest failed", 1ul, CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadSummaryTest failed", 1ul, CDiagnostics::getCount(CDiagnostics::INVALID_RECORD));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadSummaryTest failed", std::string("SUMMARY!CCSV::readData(): 1 duplicate entries, 1 invalid records"),
+					m_pSink->m_messages.back());
+		}
+		/**
+		 * Tests if messages written by several threads to a small ring buffer are printed whole or counted as dropped (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the printed and the dropped messages add up to the written ones and every printed line is complete
+		 * Failure - Otherwise
+		 */
+		void ringBufferTest()
+		{
+			std::ostringstream output;
+			CRingBufferSink* pRingBuffer = new CRingBufferSink(output, 16);
+			std::vector<std::thread> threads;
+
+			/* Test Execution*/
+			for (int thread = 0; thread < 4; thread++)
+			{
+				threads.push_back(std::thread([pRingBuffer, thread]()
+				{
+					for (int i = 0; i < 1000; i++)
+					{
+						pRingBuffer->write(CDiagnostics::INVALID_RECORD,
+								"thread " + std::to_string(thread) + " message " + std::to_string(i));
+					}
+				}));
+			}
+			for (size_t thread = 0; thread < threads.size(); thread++)
+			{
+				threads[thread].join();
+			}
+			pRingBuffer->flush();
+
+			/* Validation */
+			std::istringstream lines(output.str());
+			std::string line;
+			unsigned long printed = 0;
+			while (std::getline(lines, line))
+			{
+				CPPUNIT_ASSERT_MESSAGE("ringBufferTest failed", 0 == line.find("thread ") && std::string::npos != line.find(" message "));
+				printed++;
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("ringBufferTest failed", 4000ul, printed + pRingBuffer->getDroppedCount());
+			delete pRingBuffer;
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CDiagnosticsTest>("Count Test",
+						&CDiagnosticsTest::countTest));
+			suite->addTest(new CppUnit::TestCaller<CDiagnosticsTest>("Sampling Test",
+						&CDiagnosticsTest::samplingTest));
+			suite->addTest(new CppUnit::TestCaller<CDiagnosticsTest>("Load Summary Test",
+						&CDiagnosticsTest::loadSummaryTest));
+			suite->addTest(new CppUnit::TestCaller<CDiagnosticsTest>("Ring Buffer Test",
+						&CDiagnosticsTest::ringBufferTest));
+			return suite;
+		}
+};
+#endif
@@ -0,0 +1,255 @@
+#ifndef CTEST_DISK_DATABASE_H
+#define CTEST_DISK_DATABASE_H
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CDiskDatabase.h>
+
+#define DISK_TEST_FILE "myCode/CDiskDatabaseTest.db"
+
+class CDiskDatabaseTest:public CppUnit::TestCase
+{
+	private:
+		CDiskPoiDatabase* m_pPoiDb;
+		bool m_isDirectoryCreated;
+
+		/**
+		 * Gets the name of a generated POI, the names sort like the numbers
+		 * @param int number [IN] - The number of the POI
+		 * @return std::string - The name
+		 */
+		static std::string getName(int number)
+		{
+			char name[16];
+			snprintf(name, sizeof(name), "poi_%05d", number);
+			return name;
+		}
+	public:
+		CDiskDatabaseTest() : TestCase("Testing Disk Database"){}
+		void setUp()
+		{
+			m_isDirectoryCreated = (0 == mkdir("myCode", 0755));
+			m_pPoiDb = new CDiskPoiDatabase();
+			/* The smallest pool, so that the pages are evicted */
+			m_pPoiDb->open(DISK_TEST_FILE, MIN_POOL_FRAMES, true);
+		}
+		void tearDown()
+		{
+			delete m_pPoiDb;
+			remove(DISK_TEST_FILE);
+			if (m_isDirectoryCreated)
+				rmdir("myCode");
+		}
+		/**
+		 * Tests the clock eviction of the buffer pool (Normal case)
+		 *
+		 * Validation:
+		 * Success - If a used page gets a second chance, pinned pages stay and written pages are read back
+		 * Failure - Otherwise
+		 */
+		void bufferPoolTest()
+		{
+			delete m_pPoiDb;
+			m_pPoiDb = NULL;
+			CBufferPool pool;
+			CPPUNIT_ASSERT(pool.open(DISK_TEST_FILE, MIN_POOL_FRAMES, true));
+			uint32_t pageId = 0;
+			for (uint32_t page = 0; page < MIN_POOL_FRAMES; page++)
+			{
+				char* pPage = pool.newPage(pageId);
+				CPPUNIT_ASSERT(NULL != pPage);
+				memcpy(pPage, &pageId, sizeof(pageId));
+				pool.unpinPage(pageId, true);
+			}
+
+			/* Test Execution*/
+			/* Every page was used, the first pass evicts page 0 */
+			CPPUNIT_ASSERT(NULL != pool.newPage(pageId));
+			pool.unpinPage(pageId, true);
+			pool.fetchPage(1);
+			pool.unpinPage(1, false);
+			uint64_t hits = pool.getHits();
+			/* Page 1 was used since the last pass, page 2 is evicted */
+			CPPUNIT_ASSERT(NULL != pool.newPage(pageId));
+			pool.unpinPage(pageId, true);
+			pool.fetchPage(1);
+			pool.unpinPage(1, false);
+			bool isUsedPageCached = (hits + 1 == pool.getHits());
+			uint64_t misses = pool.getMisses();
+			char* pPage = pool.fetchPage(2);
+			bool isPageReadBack = (NULL != pPage) && (2 == *reinterpret_cast<uint32_t*>(pPage));
+			pool.unpinPage(2, false);
+			bool isEvicted = (misses + 1 == pool.getMisses());
+			for (uint32_t page = 0; page < MIN_POOL_FRAMES; page++)
+			{
+				pool.fetchPage(page);
+			}
+			char* pOverflow = pool.fetchPage(MIN_POOL_FRAMES);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("bufferPoolTest failed", isUsedPageCached);
+			CPPUNIT_ASSERT_MESSAGE("bufferPoolTest failed", isEvicted && isPageReadBack);
+			CPPUNIT_ASSERT_MESSAGE("bufferPoolTest failed", NULL == pOverflow);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("bufferPoolTest failed", (uint32_t)(MIN_POOL_FRAMES + 2), pool.getPageCount());
+			for (uint32_t page = 0; page < MIN_POOL_FRAMES; page++)
+			{
+				pool.unpinPage(page, false);
+			}
+			CPPUNIT_ASSERT_MESSAGE("bufferPoolTest failed", pool.close());
+		}
+		/**
+		 * Tests if the POIs are found in a file which is much larger than the pool (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every POI is found, also after the file is opened again, and a duplicate is rejected
+		 * Failure - Otherwise
+		 */
+		void insertFindTest()
+		{
+			std::vector<int> numbers;
+			for (int i = 0; i < 5000; i++)
+				numbers.push_back(i);
+			std::shuffle(numbers.begin(), numbers.end(), std::mt19937(7));
+			std::ostringstream messages;
+			CConsoleSink sink(messages);
+
+			/* Test Execution*/
+			for (size_t i = 0; i < numbers.size(); i++)
+				m_pPoiDb->addData(getName(numbers[i]), CPOI(CPOI::RESTAURANT, getName(numbers[i]),
+						"description of " + getName(numbers[i]), 49.0 + numbers[i] * 1e-4, 8.0));
+			unsigned long duplicates = CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY);
+			unsigned long errors = CDiagnostics::getCount(CDiagnostics::STORAGE_ERROR);
+			CDiagnostics::setSink(&sink);
+			m_pPoiDb->addData(getName(42), CPOI(CPOI::TOURISTIC, getName(42), "", 0, 0));
+			m_pPoiDb->addData("large", CPOI(CPOI::TOURISTIC, "large", std::string(2 * DB_PAGE_SIZE, 'x'), 0, 0));
+			CDiagnostics::setSink(NULL);
+			bool isClosed = m_pPoiDb->close();
+			bool isOpened = m_pPoiDb->open(DISK_TEST_FILE, MIN_POOL_FRAMES);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", isClosed && isOpened);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("insertFindTest failed", (size_t)5000, m_pPoiDb->size());
+			CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", m_pPoiDb->getPool().getPageCount() > 10 * MIN_POOL_FRAMES);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("insertFindTest failed", duplicates + 1,
+					CDiagnostics::getCount(CDiagnostics::DUPLICATE_ENTRY));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("insertFindTest failed", errors + 1,
+					CDiagnostics::getCount(CDiagnostics::STORAGE_ERROR));
+			for (int i = 0; i < 5000; i += 7)
+			{
+				CPOI poi;
+				CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", m_pPoiDb->findData(getName(i), poi));
+				CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", CPOI::RESTAURANT == poi.getType());
+				CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", ("description of " + getName(i)) == poi.getDescription());
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("insertFindTest failed", 49.0 + i * 1e-4, poi.getLatitude());
+			}
+			CPOI poi;
+			CPPUNIT_ASSERT_MESSAGE("insertFindTest failed", !m_pPoiDb->findData("large", poi));
+		}
+		/**
+		 * Tests the range scan by name after removals and updates (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the scan visits the remaining names of the range in order with their updated data
+		 * Failure - Otherwise
+		 */
+		void scanTest()
+		{
+			for (int i = 0; i < 2000; i++)
+				m_pPoiDb->addData(getName(i), CPOI(CPOI::GASSTATION, getName(i), "", 50.0, 8.0 + i * 1e-3));
+
+			/* Test Execution*/
+			for (int i = 0; i < 2000; i += 2)
+				m_pPoiDb->removeData(getName(i));
+			m_pPoiDb->updateData(getName(151), CPOI(CPOI::TOURISTIC, getName(151), "updated", 51.0, 9.0));
+			bool isMissingRemoved = m_pPoiDb->removeData(getName(150));
+			std::vector<std::string> names;
+			std::string description;
+			bool isScanned = m_pPoiDb->scanData(getName(100), getName(200), [&](const CPOI& poi) {
+				names.push_back(poi.getName());
+				if (getName(151) == poi.getName())
+					description = poi.getDescription();
+				return true;
+			});
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("scanTest failed", isScanned && !isMissingRemoved);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("scanTest failed", (size_t)1000, m_pPoiDb->size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("scanTest failed", (size_t)50, names.size());
+			CPPUNIT_ASSERT_MESSAGE("scanTest failed", std::is_sorted(names.begin(), names.end()));
+			CPPUNIT_ASSERT_MESSAGE("scanTest failed", (getName(101) == names.front()) && (getName(199) == names.back()));
+			CPPUNIT_ASSERT_MESSAGE("scanTest failed", "updated" == description);
+		}
+		/**
+		 * Tests the area query against all POIs (Normal case)
+		 *
+		 * Validation:
+		 * Success - If exactly the POIs in the area are found, a moved POI only at its new position
+		 * Failure - Otherwise
+		 */
+		void areaTest()
+		{
+			std::mt19937 generator(11);
+			std::uniform_real_distribution<double> latitude(49.0, 51.0), longitude(7.0, 10.0);
+			std::vector<CPOI> pois;
+			for (int i = 0; i < 3000; i++)
+			{
+				pois.push_back(CPOI(CPOI::UNIVERSITY, getName(i), "", latitude(generator), longitude(generator)));
+				m_pPoiDb->addData(getName(i), pois.back());
+			}
+			m_pPoiDb->updateData(getName(0), CPOI(CPOI::UNIVERSITY, getName(0), "", 49.9, 8.6));
+			pois[0] = CPOI(CPOI::UNIVERSITY, getName(0), "", 49.9, 8.6);
+
+			/* Test Execution*/
+			std::vector<CPOI> found;
+			bool isRead = m_pPoiDb->findArea(49.8, 8.5, 50.1, 8.8, found);
+			std::vector<CPOI> outside;
+			m_pPoiDb->findArea(-10.0, -10.0, -9.0, -9.0, outside);
+
+			/* Validation */
+			std::set<std::string> expected, names;
+			for (size_t i = 0; i < pois.size(); i++)
+			{
+				if ((49.8 <= pois[i].getLatitude()) && (pois[i].getLatitude() <= 50.1) &&
+						(8.5 <= pois[i].getLongitude()) && (pois[i].getLongitude() <= 8.8))
+					expected.insert(pois[i].getName());
+			}
+			for (size_t i = 0; i < found.size(); i++)
+				names.insert(found[i].getName());
+			CPPUNIT_ASSERT_MESSAGE("areaTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("areaTest failed", expected.size(), found.size());
+			CPPUNIT_ASSERT_MESSAGE("areaTest failed", expected == names);
+			CPPUNIT_ASSERT_MESSAGE("areaTest failed", names.count(getName(0)) == 1);
+			CPPUNIT_ASSERT_MESSAGE("areaTest failed", outside.empty());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CDiskDatabaseTest>("Buffer Pool Test",
+						&CDiskDatabaseTest::bufferPoolTest));
+			suite->addTest(new CppUnit::TestCaller<CDiskDatabaseTest>("Disk Insert Find Test",
+						&CDiskDatabaseTest::insertFindTest));
+			suite->addTest(new CppUnit::TestCaller<CDiskDatabaseTest>("Disk Scan Test",
+						&CDiskDatabaseTest::scanTest));
+			suite->addTest(new CppUnit::TestCaller<CDiskDatabaseTest>("Disk Area Test",
+						&CDiskDatabaseTest::areaTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_DISK_DATABASE_H
@@ -0,0 +1,221 @@
+#ifndef CTEST_DISTANCE_MATRIX_H
+#define CTEST_DISTANCE_MATRIX_H
+
+#include <math.h>
+
+#include <cmath>
+
+#include <random>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CDistanceMatrix.h>
+#include <nsp/GeoMath.h>
+
+class CDistanceMatrixTest:public CppUnit::TestCase
+{
+	private:
+		CThreadPool* m_pPool;
+		std::vector<CWaypoint> m_waypoints;
+		std::vector<const CWaypoint*> m_points;
+	public:
+		CDistanceMatrixTest() : TestCase("Testing Distance Matrix"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pPool = new CThreadPool(3);
+			/* More points than one tile, spread over the whole globe */
+			std::mt19937 generator(2);
+			std::uniform_real_distribution<double> latitude(-80.0, 80.0), longitude(-180.0, 180.0);
+			m_waypoints.clear();
+			for (int i = 0; i < 203; i++)
+			{
+				m_waypoints.push_back(CWaypoint(latitude(generator), longitude(generator), "point"));
+			}
+			m_points.clear();
+			for (size_t i = 0; i < m_waypoints.size(); i++)
+			{
+				m_points.push_back(&m_waypoints[i]);
+			}
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pPool) delete m_pPool;
+		}
+		/**
+		 * Tests if the matrix holds the distance of every pair (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every entry matches CWaypoint::calculateDistance, the diagonal is 0 and the matrix is symmetric
+		 * Failure - Otherwise
+		 */
+		void doubleMatrixTest()
+		{
+			CDistanceMatrix distanceMatrix(*m_pPool);
+			distanceMatrix.setPoints(m_points);
+			size_t count = distanceMatrix.getPointCount();
+			std::vector<double> matrix(count * count, -1);
+
+			/* Test Execution*/
+			distanceMatrix.compute(matrix.data());
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("doubleMatrixTest failed", m_points.size(), count);
+			for (size_t row = 0; row < count; row++)
+			{
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("doubleMatrixTest failed", 0.0, matrix[row * count + row]);
+				for (size_t column = 0; column < count; column++)
+				{
+					double expected = m_waypoints[row].calculateDistance(m_waypoints[column]);
+					CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("doubleMatrixTest failed", expected, matrix[row * count + column], 1e-3);
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("doubleMatrixTest failed", matrix[column * count + row], matrix[row * count + column]);
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("doubleMatrixTest failed", distanceMatrix.getDistance(row, column), matrix[row * count + column]);
+				}
+			}
+		}
+		/**
+		 * Tests if the single precision matrix holds the rounded distances (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every entry equals the double precision entry rounded to float
+		 * Failure - Otherwise
+		 */
+		void floatMatrixTest()
+		{
+			CDistanceMatrix distanceMatrix(*m_pPool);
+			distanceMatrix.setPoints(m_points);
+			size_t count = distanceMatrix.getPointCount();
+			std::vector<double> matrix(count * count);
+			std::vector<float> floatMatrix(count * count, -1);
+			distanceMatrix.compute(matrix.data());
+
+			/* Test Execution*/
+			distanceMatrix.compute(floatMatrix.data());
+
+			/* Validation */
+			for (size_t i = 0; i < matrix.size(); i++)
+			{
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("floatMatrixTest failed", (float)matrix[i], floatMatrix[i]);
+			}
+		}
+		/**
+		 * Tests if nearby points keep their distance (Boundary case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The points are 1 m apart, where the acos formula loses its precision
+		 *
+		 * Validation:
+		 * Success - If the distance is 1 m within 1 mm
+		 * Failure - Otherwise
+		 */
+		void nearbyPointsTest()
+		{
+			double metersInDegree = 1 / (1000 * EARTH_RADIUS_LENGTH * PI / 180);
+			CWaypoint first(49.8728, 8.6512, "first"), second(49.8728 + metersInDegree, 8.6512, "second");
+			std::vector<const CWaypoint*> points;
+			points.push_back(&first);
+			points.push_back(&second);
+			CDistanceMatrix distanceMatrix(*m_pPool);
+			distanceMatrix.setPoints(points);
+			double matrix[4];
+
+			/* Test Execution*/
+			distanceMatrix.compute(matrix);
+
+			/* Validation */
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("nearbyPointsTest failed", 0.001, matrix[1], 1e-6);
+		}
+		/**
+		 * Tests if antipodal points get half the circumference (Boundary case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Every point has its antipode in the set, the rounded chord may exceed the diameter
+		 *
+		 * Validation:
+		 * Success - If every entry is finite and matches CWaypoint::calculateDistance
+		 * Failure - Otherwise
+		 */
+		void antipodalPointsTest()
+		{
+			const double positions[][2] = {{0, 0}, {49.8728, 8.6512}, {-33.8568, 151.2153}, {89.9, -45}, {12.5, 179.999},
+				{9.9949567018874745, -82.842735077867331}};
+			std::vector<CWaypoint> waypoints;
+			for (size_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++)
+			{
+				waypoints.push_back(CWaypoint(positions[i][0], positions[i][1], "point"));
+				double longitude = positions[i][1] + ((positions[i][1] > 0) ? -180 : 180);
+				waypoints.push_back(CWaypoint(-positions[i][0], longitude, "antipode"));
+			}
+			std::vector<const CWaypoint*> points;
+			for (size_t i = 0; i < waypoints.size(); i++)
+			{
+				points.push_back(&waypoints[i]);
+			}
+			CDistanceMatrix distanceMatrix(*m_pPool);
+			distanceMatrix.setPoints(points);
+			size_t count = points.size();
+			std::vector<double> matrix(count * count);
+
+			/* Test Execution*/
+			distanceMatrix.compute(matrix.data());
+
+			/* Validation */
+			for (size_t row = 0; row < count; row++)
+			{
+				for (size_t column = 0; column < count; column++)
+				{
+					double expected = waypoints[row].calculateDistance(waypoints[column]);
+					CPPUNIT_ASSERT_MESSAGE("antipodalPointsTest failed", std::isfinite(matrix[row * count + column]));
+					CPPUNIT_ASSERT_MESSAGE("antipodalPointsTest failed", std::isfinite(distanceMatrix.getDistance(row, column)));
+					CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("antipodalPointsTest failed", expected, matrix[row * count + column], 1e-3);
+				}
+			}
+		}
+		/**
+		 * Tests if an empty point set is handled (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the point count is 0 and compute() returns
+		 * Failure - Otherwise
+		 */
+		void emptyMatrixTest()
+		{
+			CDistanceMatrix distanceMatrix(*m_pPool);
+			distanceMatrix.setPoints(std::vector<const CWaypoint*>());
+			double dummy = -1;
+
+			/* Test Execution*/
+			distanceMatrix.compute(&dummy);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("emptyMatrixTest failed", (size_t)0, distanceMatrix.getPointCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("emptyMatrixTest failed", -1.0, dummy);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CDistanceMatrixTest>("Double Matrix Test",
+						&CDistanceMatrixTest::doubleMatrixTest));
+			suite->addTest(new CppUnit::TestCaller<CDistanceMatrixTest>("Float Matrix Test",
+						&CDistanceMatrixTest::floatMatrixTest));
+			suite->addTest(new CppUnit::TestCaller<CDistanceMatrixTest>("Nearby Points Test",
+						&CDistanceMatrixTest::nearbyPointsTest));
+			suite->addTest(new CppUnit::TestCaller<CDistanceMatrixTest>("Antipodal Points Test",
+						&CDistanceMatrixTest::antipodalPointsTest));
+			suite->addTest(new CppUnit::TestCaller<CDistanceMatrixTest>("Empty Matrix Test",
+						&CDistanceMatrixTest::emptyMatrixTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_DISTANCE_MATRIX_H
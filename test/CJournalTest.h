@@ -0,0 +1,272 @@
+#ifndef CTEST_JOURNAL_H
+#define CTEST_JOURNAL_H
+
+#include <stdio.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CCSV.h>
+#include <nsp/CJournal.h>
+
+#define JOURNAL_TEST_MEDIA "CJournalTest"
+#define JOURNAL_TEST_WP_FILE "src/" JOURNAL_TEST_MEDIA "-wp.txt"
+#define JOURNAL_TEST_POI_FILE "src/" JOURNAL_TEST_MEDIA "-poi.txt"
+#define JOURNAL_TEST_JOURNAL_FILE "src/" JOURNAL_TEST_MEDIA "-journal.txt"
+#define JOURNAL_TEST_COMPACTING_FILE "src/" JOURNAL_TEST_MEDIA "-journal-compacting.txt"
+#define JOURNAL_TEST_SNAPSHOT_WP_FILE "src/" JOURNAL_TEST_MEDIA "-compacting-snapshot-wp.txt"
+#define JOURNAL_TEST_SNAPSHOT_POI_FILE "src/" JOURNAL_TEST_MEDIA "-compacting-snapshot-poi.txt"
+
+class CJournalTest:public CppUnit::TestCase
+{
+	private:
+		CCSV* m_pCsv;
+		CJournal* m_pJournal;
+		CWpDatabase* m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+
+		std::string readFile(const char* fileName)
+		{
+			std::ifstream file(fileName, std::ios::in | std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+		bool isFilePresent(const char* fileName)
+		{
+			std::ifstream file(fileName);
+			return file.good();
+		}
+		/*
+		 * Checks if the Databases read back from the files equal the Databases of the test
+		 */
+		bool isReadBackEqual()
+		{
+			CCSV csv;
+			CJournal journal(csv);
+			journal.setMediaName(JOURNAL_TEST_MEDIA);
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			journal.readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+			if ((wpDb.size() != m_pWpDb->size()) || (poiDb.size() != m_pPoiDb->size()))
+				return false;
+			for (CWpDatabase::const_iterator itr = m_pWpDb->begin(); itr != m_pWpDb->end(); ++itr)
+			{
+				const CWaypoint* pWp = wpDb.findData(itr->first);
+				if ((NULL == pWp) || (pWp->getLatitude() != itr->second.getLatitude()))
+					return false;
+			}
+			for (CPoiDatabase::const_iterator itr = m_pPoiDb->begin(); itr != m_pPoiDb->end(); ++itr)
+			{
+				const CPOI* pPoi = poiDb.findData(itr->first);
+				if ((NULL == pPoi) || (pPoi->getDescription() != itr->second.getDescription()))
+					return false;
+			}
+			return true;
+		}
+	public:
+		CJournalTest() : TestCase("Testing Journal"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pCsv = new CCSV();
+			m_pJournal = new CJournal(*m_pCsv);
+			m_pJournal->setMediaName(JOURNAL_TEST_MEDIA);
+			m_pWpDb = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+			m_pWpDb->setChangeTracking(true);
+			m_pPoiDb->setChangeTracking(true);
+			m_pWpDb->addWaypoint(CWaypoint(52.5167, 13.3833, "Berlin"));
+			m_pWpDb->addWaypoint(CWaypoint(48.8566, 2.3522, "Paris"));
+			m_pPoiDb->addPoi(CPOI(CPOI::UNIVERSITY, "HDA", "university", 49.8666, 8.6407));
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pJournal) delete m_pJournal;
+			if(m_pCsv)     delete m_pCsv;
+			if(m_pWpDb)    delete m_pWpDb;
+			if(m_pPoiDb)   delete m_pPoiDb;
+			remove(JOURNAL_TEST_WP_FILE);
+			remove(JOURNAL_TEST_POI_FILE);
+			remove(JOURNAL_TEST_JOURNAL_FILE);
+			remove(JOURNAL_TEST_COMPACTING_FILE);
+			remove(JOURNAL_TEST_SNAPSHOT_WP_FILE);
+			remove(JOURNAL_TEST_SNAPSHOT_POI_FILE);
+		}
+		/**
+		 * Tests if only the changes are appended after the first save (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The first save writes the base snapshot
+		 *
+		 * Validation:
+		 * Success - If the base is unchanged, the journal holds one record per change and the data is read back
+		 * Failure - Otherwise
+		 */
+		void appendChangesTest()
+		{
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			CPPUNIT_ASSERT(!isFilePresent(JOURNAL_TEST_JOURNAL_FILE));
+			std::string baseWaypoints = readFile(JOURNAL_TEST_WP_FILE);
+			m_pWpDb->addWaypoint(CWaypoint(52.3680, 4.9036, "Amsterdam"));
+			m_pWpDb->removeWaypoint("Paris");
+			m_pPoiDb->updatePoi(CPOI(CPOI::UNIVERSITY, "HDA", "h_da", 49.8666, 8.6407));
+			m_pPoiDb->updatePoi(CPOI(CPOI::UNIVERSITY, "HDA", "Hochschule Darmstadt", 49.8666, 8.6407));
+
+			/* Test Execution*/
+			bool isWritten = m_pJournal->writeData(*m_pWpDb, *m_pPoiDb);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("appendChangesTest failed", isWritten);
+			CPPUNIT_ASSERT_MESSAGE("appendChangesTest failed", baseWaypoints == readFile(JOURNAL_TEST_WP_FILE));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("appendChangesTest failed",
+					std::string("W;Amsterdam;52.368;4.9036\nw;Paris\nP;UNIVERSITY;HDA;Hochschule Darmstadt;49.8666;8.6407\n"),
+					readFile(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("appendChangesTest failed", isReadBackEqual());
+		}
+		/**
+		 * Tests if a cleared Database is journaled (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If only the entries added after the clear are read back
+		 * Failure - Otherwise
+		 */
+		void clearTest()
+		{
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			m_pWpDb->removeWaypoint("Berlin");
+			m_pWpDb->clearWpDatabase();
+			m_pWpDb->addWaypoint(CWaypoint(52.3680, 4.9036, "Amsterdam"));
+
+			/* Test Execution*/
+			bool isWritten = m_pJournal->writeData(*m_pWpDb, *m_pPoiDb);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("clearTest failed", isWritten);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("clearTest failed", std::string("C;W\nW;Amsterdam;52.368;4.9036\n"),
+					readFile(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("clearTest failed", isReadBackEqual());
+		}
+		/**
+		 * Tests if a grown journal is folded into the base snapshot in the background (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the journal is removed, the new snapshot has replaced the base, the base holds the
+		 *           changes and later changes are journaled again
+		 * Failure - Otherwise
+		 */
+		void compactionTest()
+		{
+			m_pJournal->setCompactionThreshold(3);
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			m_pWpDb->addWaypoint(CWaypoint(52.3680, 4.9036, "Amsterdam"));
+			m_pPoiDb->removePoi("HDA");
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			m_pWpDb->updateWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+
+			/* Test Execution*/
+			bool isWritten = m_pJournal->writeData(*m_pWpDb, *m_pPoiDb);
+			m_pJournal->waitForCompaction();
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", isWritten);
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", !isFilePresent(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", !isFilePresent(JOURNAL_TEST_COMPACTING_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", !isFilePresent(JOURNAL_TEST_SNAPSHOT_WP_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", !isFilePresent(JOURNAL_TEST_SNAPSHOT_POI_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", std::string::npos != readFile(JOURNAL_TEST_WP_FILE).find("Rome;"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("compactionTest failed", std::string(""), readFile(JOURNAL_TEST_POI_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", isReadBackEqual());
+			m_pWpDb->removeWaypoint("Rome");
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("compactionTest failed", std::string("w;Rome\n"), readFile(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("compactionTest failed", isReadBackEqual());
+		}
+		/**
+		 * Tests if a journal with a record cut off by a crash is read (Error case)
+		 *
+		 * Pre:Conditions:
+		 * 1. A compaction did not finish and left its journal
+		 *
+		 * Validation:
+		 * Success - If the complete records are applied, the cut off record is skipped and the compaction is completed
+		 * Failure - Otherwise
+		 */
+		void crashRecoveryTest()
+		{
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			std::ofstream(JOURNAL_TEST_COMPACTING_FILE) << "w;Paris\nW;Amsterdam;52.368;4.9036\n";
+			std::ofstream(JOURNAL_TEST_JOURNAL_FILE) << "W;Rome;41.9028;12.4964\nW;Madrid;40.41";
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+
+			/* Test Execution*/
+			bool isRead = m_pJournal->readData(wpDb, poiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("crashRecoveryTest failed", (size_t)3, wpDb.size());
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", NULL == wpDb.findData("Paris"));
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", NULL != wpDb.findData("Rome"));
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", NULL == wpDb.findData("Madrid"));
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", !isFilePresent(JOURNAL_TEST_COMPACTING_FILE));
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", !isFilePresent(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("crashRecoveryTest failed", std::string::npos != readFile(JOURNAL_TEST_WP_FILE).find("Rome;"));
+		}
+		/**
+		 * Tests if Databases which are not in sync with the journal are saved as a snapshot (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If saving a copy of the Databases writes the base and removes the journal
+		 * Failure - Otherwise
+		 */
+		void snapshotTest()
+		{
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			m_pWpDb->addWaypoint(CWaypoint(52.3680, 4.9036, "Amsterdam"));
+			CPPUNIT_ASSERT(m_pJournal->writeData(*m_pWpDb, *m_pPoiDb));
+			CPPUNIT_ASSERT(isFilePresent(JOURNAL_TEST_JOURNAL_FILE));
+			CWpDatabase wpCopy(*m_pWpDb);
+			wpCopy.addWaypoint(CWaypoint(41.9028, 12.4964, "Rome"));
+
+			/* Test Execution*/
+			bool isWritten = m_pJournal->writeData(wpCopy, *m_pPoiDb);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("snapshotTest failed", isWritten);
+			CPPUNIT_ASSERT_MESSAGE("snapshotTest failed", 0 != wpCopy.getTrackingId());
+			CPPUNIT_ASSERT_MESSAGE("snapshotTest failed", m_pWpDb->getTrackingId() != wpCopy.getTrackingId());
+			CPPUNIT_ASSERT_MESSAGE("snapshotTest failed", !isFilePresent(JOURNAL_TEST_JOURNAL_FILE));
+			CPPUNIT_ASSERT_MESSAGE("snapshotTest failed", std::string::npos != readFile(JOURNAL_TEST_WP_FILE).find("Rome;"));
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CJournalTest>("Append Changes Test",
+						&CJournalTest::appendChangesTest));
+			suite->addTest(new CppUnit::TestCaller<CJournalTest>("Clear Test",
+						&CJournalTest::clearTest));
+			suite->addTest(new CppUnit::TestCaller<CJournalTest>("Compaction Test",
+						&CJournalTest::compactionTest));
+			suite->addTest(new CppUnit::TestCaller<CJournalTest>("Crash Recovery Test",
+						&CJournalTest::crashRecoveryTest));
+			suite->addTest(new CppUnit::TestCaller<CJournalTest>("Snapshot Test",
+						&CJournalTest::snapshotTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_JOURNAL_H
@@ -0,0 +1,207 @@
+#ifndef CTEST_JSON_INDEX_SCANNER_H
+#define CTEST_JSON_INDEX_SCANNER_H
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CJsonIndexScanner.h>
+#include <nsp/CJsonPersistence.h>
+#include <nsp/CJsonScanner.h>
+
+#define INDEX_TEST_MEDIA "CJsonIndexScannerTest"
+#define INDEX_TEST_FILE "myCode/" INDEX_TEST_MEDIA ".json"
+
+class CJsonIndexScannerTest:public CppUnit::TestCase
+{
+	private:
+		/**
+		 * Scans the whole input and describes every token with its line
+		 * @param Scanner& scanner [IN] - The scanner of the input
+		 * @return std::string - The tokens, ended by END or the illegal character
+		 */
+		template <class Scanner> std::string describeTokens(Scanner& scanner)
+		{
+			std::ostringstream tokens;
+			try
+			{
+				APT::CJsonToken* pToken = NULL;
+				while (NULL != (pToken = scanner.nextToken()))
+				{
+					tokens << pToken->str() << "@" << scanner.scannedLine() << ";";
+				}
+				tokens << "END@" << scanner.scannedLine();
+			}
+			catch (std::string& illegalChar)
+			{
+				tokens << "ILLEGAL " << illegalChar << "@" << scanner.scannedLine();
+			}
+			return tokens.str();
+		}
+		/**
+		 * Describes the tokens of both scanners
+		 * @param const std::string& input [IN] - The JSON text
+		 * @param std::string& flexTokens [OUT] - The tokens of APT::CJsonScanner
+		 * @param std::string& indexTokens [OUT] - The tokens of CJsonIndexScanner
+		 */
+		void scanWithBoth(const std::string& input, std::string& flexTokens, std::string& indexTokens)
+		{
+			std::istringstream stream(input);
+			APT::CJsonScanner flexScanner(stream);
+			CJsonIndexScanner indexScanner(input);
+			flexTokens = describeTokens(flexScanner);
+			indexTokens = describeTokens(indexScanner);
+		}
+	public:
+		CJsonIndexScannerTest() : TestCase("Testing Json Index Scanner"){}
+		/**
+		 * Tests if the index scanner delivers the same tokens and lines as the flex scanner (Normal case)
+		 *
+		 * Validation:
+		 * Success - If both scanners deliver the same tokens, values and lines and a plus sign keeps
+		 *           the value of the number
+		 * Failure - Otherwise
+		 */
+		void sameTokensTest()
+		{
+			const char* inputs[] = {
+					"{\"pois\" : [ {\"name\" : \"Mensa\", \"latitude\" : -4.98725e1, \"open\" : true, \"x\" : null} ]}",
+					"{\n\t\"waypoints\" :\r\n[\n{\"name\":\"a \\\"quoted\\\" \\\\ name\\u00e9\",\"latitude\":1e5}\n]\n}\n",
+					"[1.2.3, 5-3, 1e5e5, true1, +1, -, ., e5, \"x\"\"y\"]",
+					"[+48.5, +.5e2, +12345678901234567890.5]",
+					"\"line\nbreak\" 12",
+					"",
+					"   \n  "};
+
+			for (unsigned int i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+			{
+				std::string flexTokens, indexTokens;
+
+				/* Test Execution*/
+				scanWithBoth(inputs[i], flexTokens, indexTokens);
+
+				/* Validation */
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("sameTokensTest failed", flexTokens, indexTokens);
+			}
+			std::string flexTokens, indexTokens;
+			scanWithBoth("[+48.5, +.5e2]", flexTokens, indexTokens);
+			CPPUNIT_ASSERT_MESSAGE("sameTokensTest failed", std::string::npos != indexTokens.find("number: 48.5@"));
+			CPPUNIT_ASSERT_MESSAGE("sameTokensTest failed", std::string::npos != indexTokens.find("number: 50@"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("sameTokensTest failed", flexTokens, indexTokens);
+		}
+		/**
+		 * Tests if the index scanner reports illegal input like the flex scanner (Error case)
+		 *
+		 * Validation:
+		 * Success - If both scanners throw the same character on the same line
+		 * Failure - Otherwise
+		 */
+		void illegalInputTest()
+		{
+			const char* inputs[] = {"{\n@}", "[1e]", "[truex]", "[tru]", "\"unterminated\n",
+					"\"invalid \\q escape\"", "\"short \\u12\"", "{\"x\"y}", "[1,\f2]"};
+
+			for (unsigned int i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+			{
+				std::string flexTokens, indexTokens;
+
+				/* Test Execution*/
+				scanWithBoth(inputs[i], flexTokens, indexTokens);
+
+				/* Validation */
+				CPPUNIT_ASSERT_MESSAGE("illegalInputTest failed", std::string::npos != indexTokens.find("ILLEGAL"));
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalInputTest failed", flexTokens, indexTokens);
+			}
+		}
+		/**
+		 * Tests if strings, escapes and numbers which cross the 64 byte blocks and the index windows
+		 * are delivered like the flex scanner does (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If both scanners deliver the same tokens, values and lines
+		 * Failure - Otherwise
+		 */
+		void windowBoundaryTest()
+		{
+			std::ostringstream json;
+			json << "[\n";
+			for (unsigned int i = 0; json.tellp() < 3 * JSON_INDEX_WINDOW_SIZE; i++)
+			{
+				/* Shift the tokens by one byte per entry across the block borders */
+				json << "{\"" << std::string(i % 67, 'n') << "\\\"\\\\\" : " << i << ".5e-1, \"b\" : true}"
+						<< ((0 == i % 5) ? ",\n" : ",");
+			}
+			json << "\"" << std::string(JSON_INDEX_WINDOW_SIZE, 's') << "\\\\\", 7]\n";
+			std::string flexTokens, indexTokens;
+
+			/* Test Execution*/
+			scanWithBoth(json.str(), flexTokens, indexTokens);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("windowBoundaryTest failed", std::string::npos != indexTokens.find("number: 7@"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("windowBoundaryTest failed", flexTokens, indexTokens);
+		}
+		/**
+		 * Tests if readData fills the databases in the same way with both scanner backends (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The directory myCode is created if it does not exist
+		 *
+		 * Validation:
+		 * Success - If both backends read the same waypoints and POIs
+		 * Failure - Otherwise
+		 */
+		void readDataTest()
+		{
+			bool isDirectoryCreated = (0 == mkdir("myCode", 0755));
+			std::ofstream(INDEX_TEST_FILE) << "{\n\"waypoints\" : [\n"
+					"{\"name\" : \"Home\", \"latitude\" : 49.86, \"longitude\" : 8.65}\n],\n"
+					"\"pois\" : [\n{\"name\" : \"Mensa\", \"latitude\" : 49.87, \"longitude\" : 8.64,"
+					" \"description\" : \"Food\", \"type\" : \"RESTAURANT\"}\n]\n}\n";
+			CJsonPersistence persistence;
+			persistence.setMediaName(INDEX_TEST_MEDIA);
+			CWpDatabase flexWpDb, indexWpDb;
+			CPoiDatabase flexPoiDb, indexPoiDb;
+
+			/* Test Execution*/
+			bool flexRead = persistence.readData(flexWpDb, flexPoiDb, CPersistentStorage::REPLACE);
+			persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+			bool indexRead = persistence.readData(indexWpDb, indexPoiDb, CPersistentStorage::REPLACE);
+			remove(INDEX_TEST_FILE);
+			if (isDirectoryCreated)
+				rmdir("myCode");
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("readDataTest failed", flexRead && indexRead);
+			CPOI* pFlexPoi = flexPoiDb.getPointerToPoi("Mensa");
+			CPOI* pIndexPoi = indexPoiDb.getPointerToPoi("Mensa");
+			CWaypoint* pFlexWp = flexWpDb.getPointerToWaypoint("Home");
+			CWaypoint* pIndexWp = indexWpDb.getPointerToWaypoint("Home");
+			CPPUNIT_ASSERT_MESSAGE("readDataTest failed", (NULL != pFlexPoi) && (NULL != pIndexPoi));
+			CPPUNIT_ASSERT_MESSAGE("readDataTest failed", (NULL != pFlexWp) && (NULL != pIndexWp));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readDataTest failed", pFlexPoi->getDescription(), pIndexPoi->getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readDataTest failed", pFlexPoi->getLongitude(), pIndexPoi->getLongitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("readDataTest failed", pFlexWp->getLatitude(), pIndexWp->getLatitude());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CJsonIndexScannerTest>("Same Tokens Test",
+						&CJsonIndexScannerTest::sameTokensTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonIndexScannerTest>("Illegal Input Test",
+						&CJsonIndexScannerTest::illegalInputTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonIndexScannerTest>("Window Boundary Test",
+						&CJsonIndexScannerTest::windowBoundaryTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonIndexScannerTest>("Read Data Test",
+						&CJsonIndexScannerTest::readDataTest));
+			return suite;
+		}
+};
+#endif
@@ -0,0 +1,356 @@
+#ifndef CTEST_JSON_PERSISTENCE_H
+#define CTEST_JSON_PERSISTENCE_H
+
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CDiagnostics.h>
+#include <nsp/CJsonPersistence.h>
+
+#define JSON_TEST_MEDIA "CJsonPersistenceTest"
+#define JSON_TEST_FILE "myCode/" JSON_TEST_MEDIA ".json"
+
+class CJsonPersistenceTest:public CppUnit::TestCase
+{
+	private:
+		CWpDatabase* m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+		bool m_isDirectoryCreated;
+
+		/**
+		 * Writes the JSON text and reads it into the databases
+		 * @param const std::string& json [IN] - The contents of the file
+		 * @return bool - The result of readData
+		 */
+		bool readJson(const std::string& json)
+		{
+			std::ofstream(JSON_TEST_FILE) << json;
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			return persistence.readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::REPLACE);
+		}
+		/**
+		 * Reads the contents of the file written by writeData
+		 * @return std::string - The contents of the file
+		 */
+		std::string readFile()
+		{
+			std::ifstream file(JSON_TEST_FILE, std::ios::in | std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return contents.str();
+		}
+	public:
+		CJsonPersistenceTest() : TestCase("Testing Json Persistence"){}
+		void setUp()
+		{
+			m_pWpDb = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+			m_isDirectoryCreated = (0 == mkdir("myCode", 0755));
+		}
+		void tearDown()
+		{
+			remove(JSON_TEST_FILE);
+			if (m_isDirectoryCreated)
+				rmdir("myCode");
+			delete m_pWpDb;
+			delete m_pPoiDb;
+		}
+		/**
+		 * Tests if the attributes are assigned in any order (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the waypoint and the POI hold the values of their attributes
+		 * Failure - Otherwise
+		 */
+		void attributeOrderTest()
+		{
+			/* Test Execution*/
+			bool isRead = readJson("{\"waypoints\" : [{\"longitude\" : 8.65, \"name\" : \"Home\", \"latitude\" : 49.86}],\n"
+					"\"pois\" : [{\"type\" : \"UNIVERSITY\", \"description\" : \"Campus\", \"longitude\" : 8.64,"
+					" \"latitude\" : 49.87, \"name\" : \"HDA\"}]}");
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("attributeOrderTest failed", isRead);
+			CWaypoint* pWaypoint = m_pWpDb->getPointerToWaypoint("Home");
+			CPOI* pPoi = m_pPoiDb->getPointerToPoi("HDA");
+			CPPUNIT_ASSERT_MESSAGE("attributeOrderTest failed", (NULL != pWaypoint) && (NULL != pPoi));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeOrderTest failed", 49.86, pWaypoint->getLatitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeOrderTest failed", 8.65, pWaypoint->getLongitude());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeOrderTest failed", std::string("Campus"), pPoi->getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("attributeOrderTest failed", (int)CPOI::UNIVERSITY, (int)pPoi->getType());
+		}
+		/**
+		 * Tests if an object with an attribute of another database, a repeated attribute or a value of
+		 * the wrong type is skipped while the other objects are read (Error case)
+		 *
+		 * Validation:
+		 * Success - If only the valid objects are read and every invalid one is counted once
+		 * Failure - Otherwise
+		 */
+		void invalidAttributeTest()
+		{
+			/* Test Execution*/
+			bool isRead = readJson("{\"waypoints\" : [\n"
+					"{\"name\" : \"Poi attribute\", \"latitude\" : 1.5, \"longitude\" : 2.5, \"description\" : \"x\"},\n"
+					"{\"name\" : \"Repeated\", \"latitude\" : 1.5, \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" : \"Wrong type\", \"latitude\" : \"1.5\", \"longitude\" : 2.5},\n"
+					"{\"name\" : \"Valid\", \"latitude\" : 1.5, \"longitude\" : 2.5}\n]}");
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("invalidAttributeTest failed", isRead);
+			CPPUNIT_ASSERT_MESSAGE("invalidAttributeTest failed", NULL != m_pWpDb->getPointerToWaypoint("Valid"));
+			CWpDatabase::WaypointDatabaseMap_t waypoints;
+			m_pWpDb->getWpDatabase(waypoints);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidAttributeTest failed", (size_t)1, waypoints.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidAttributeTest failed", 3UL,
+					CDiagnostics::getCount(CDiagnostics::INVALID_JSON));
+		}
+		/**
+		 * Tests if an error in the JSON format aborts the parsing (Error case)
+		 *
+		 * Validation:
+		 * Success - If readData fails and only the objects before the error are read
+		 * Failure - Otherwise
+		 */
+		void formatErrorTest()
+		{
+			/* Test Execution*/
+			bool isRead = readJson("{\"waypoints\" : [\n"
+					"{\"name\" : \"Before\", \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" \"Missing separator\", \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" : \"After\", \"latitude\" : 1.5, \"longitude\" : 2.5}\n]}");
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("formatErrorTest failed", !isRead);
+			CPPUNIT_ASSERT_MESSAGE("formatErrorTest failed", NULL != m_pWpDb->getPointerToWaypoint("Before"));
+			CWpDatabase::WaypointDatabaseMap_t waypoints;
+			m_pWpDb->getWpDatabase(waypoints);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("formatErrorTest failed", (size_t)1, waypoints.size());
+		}
+		/**
+		 * Tests if an illegal character ends the parsing with both scanner backends (Error case)
+		 *
+		 * Validation:
+		 * Success - If both backends read only the objects before the illegal character
+		 * Failure - Otherwise
+		 */
+		void illegalCharacterTest()
+		{
+			std::ofstream(JSON_TEST_FILE) << "{\"waypoints\" : [\n"
+					"{\"name\" : \"Before\", \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" : @\"Illegal\", \"latitude\" : 1.5, \"longitude\" : 2.5}\n]}";
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			CWpDatabase indexWpDb;
+			CPoiDatabase indexPoiDb;
+
+			/* Test Execution*/
+			bool flexRead = persistence.readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::REPLACE);
+			persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+			bool indexRead = persistence.readData(indexWpDb, indexPoiDb, CPersistentStorage::REPLACE);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("illegalCharacterTest failed", flexRead && indexRead);
+			CWpDatabase::WaypointDatabaseMap_t flexWaypoints, indexWaypoints;
+			m_pWpDb->getWpDatabase(flexWaypoints);
+			indexWpDb.getWpDatabase(indexWaypoints);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalCharacterTest failed", (size_t)1, flexWaypoints.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalCharacterTest failed", (size_t)1, indexWaypoints.size());
+			CPPUNIT_ASSERT_MESSAGE("illegalCharacterTest failed", NULL != indexWpDb.getPointerToWaypoint("Before"));
+		}
+		/**
+		 * Tests if strings with quotes, backslashes, control characters and escape sequences are
+		 * written as valid JSON and saved again unchanged after they are read (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If both backends read every object and the second file equals the first one
+		 * Failure - Otherwise
+		 */
+		void escapedStringTest()
+		{
+			m_pWpDb->addWaypoint(CWaypoint(1.5, 2.5, "Quote \" mark"));
+			m_pWpDb->addWaypoint(CWaypoint(1.5, 2.5, "Lone \\ backslash"));
+			m_pWpDb->addWaypoint(CWaypoint(1.5, 2.5, "Escaped \\\"name\\\" \\u00e9"));
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Mensa", "Line\nbreak\tand \x01", 1.5, 2.5));
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			CWpDatabase flexWpDb, indexWpDb;
+			CPoiDatabase flexPoiDb, indexPoiDb;
+
+			/* Test Execution*/
+			bool isWritten = persistence.writeData(*m_pWpDb, *m_pPoiDb);
+			std::string firstFile = readFile();
+			bool flexRead = persistence.readData(flexWpDb, flexPoiDb, CPersistentStorage::REPLACE);
+			persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+			bool indexRead = persistence.readData(indexWpDb, indexPoiDb, CPersistentStorage::REPLACE);
+			isWritten = persistence.writeData(indexWpDb, indexPoiDb) && isWritten;
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("escapedStringTest failed", isWritten && flexRead && indexRead);
+			CWpDatabase::WaypointDatabaseMap_t flexWaypoints, indexWaypoints;
+			flexWpDb.getWpDatabase(flexWaypoints);
+			indexWpDb.getWpDatabase(indexWaypoints);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("escapedStringTest failed", (size_t)3, flexWaypoints.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("escapedStringTest failed", (size_t)3, indexWaypoints.size());
+			CPPUNIT_ASSERT_MESSAGE("escapedStringTest failed", NULL != indexWpDb.getPointerToWaypoint("Quote \\\" mark"));
+			CPPUNIT_ASSERT_MESSAGE("escapedStringTest failed",
+					NULL != indexWpDb.getPointerToWaypoint("Escaped \\\"name\\\" \\u00e9"));
+			CPPUNIT_ASSERT_MESSAGE("escapedStringTest failed", NULL != flexPoiDb.getPointerToPoi("Mensa"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("escapedStringTest failed", firstFile, readFile());
+		}
+		/**
+		 * Tests if a file of several segments is read on four threads like on one thread, with
+		 * invalid objects in every segment (Normal case)
+		 *
+		 * Validation:
+		 * Success - If both loads read the same objects and write the same messages with the same
+		 * line numbers
+		 * Failure - Otherwise
+		 */
+		void parallelLoadTest()
+		{
+			std::ofstream json(JSON_TEST_FILE);
+			json << "{\"waypoints\" : [\n";
+			for (int i = 0; i < 20000; i++)
+			{
+				json << "{\"name\" : \"wp_" << i << "\", " << ((0 == i % 997) ? "\"name\" : \"again\", " : "")
+						<< "\"latitude\" : 49.86, \"longitude\" : 8.65},\n";
+			}
+			json << "{\"name\" : \"Last\", \"latitude\" : 49.86, \"longitude\" : 8.65}],\n\"pois\" : [\n";
+			for (int i = 0; i < 20000; i++)
+			{
+				json << "{\"name\" : \"poi_" << i << "\", \"latitude\" : " << ((0 == i % 991) ? "\"49.87\"" : "49.87")
+						<< ", \"longitude\" : 8.64, \"description\" : \"Campus\", \"type\" : \"UNIVERSITY\"},\n";
+			}
+			json << "{\"name\" : \"Last\", \"latitude\" : 49.87, \"longitude\" : 8.64, \"description\" : \"Campus\","
+					" \"type\" : \"UNIVERSITY\"}]}\n";
+			json.close();
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			persistence.setScanner(CJsonPersistence::INDEX_SCANNER);
+			CWpDatabase parallelWpDb;
+			CPoiDatabase parallelPoiDb;
+			std::ostringstream messages, parallelMessages;
+			CConsoleSink sink(messages), parallelSink(parallelMessages);
+
+			/* Test Execution*/
+			CDiagnostics::setSink(&sink);
+			bool isRead = persistence.readData(*m_pWpDb, *m_pPoiDb, CPersistentStorage::REPLACE);
+			persistence.setThreadCount(4);
+			CDiagnostics::setSink(&parallelSink);
+			bool parallelRead = persistence.readData(parallelWpDb, parallelPoiDb, CPersistentStorage::REPLACE);
+			CDiagnostics::setSink(NULL);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("parallelLoadTest failed", isRead && parallelRead);
+			CWpDatabase::WaypointDatabaseMap_t waypoints, parallelWaypoints;
+			m_pWpDb->getWpDatabase(waypoints);
+			parallelWpDb.getWpDatabase(parallelWaypoints);
+			CPoiDatabase::POIDatabaseMap_t pois, parallelPois;
+			m_pPoiDb->getPoiDatabase(pois);
+			parallelPoiDb.getPoiDatabase(parallelPois);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelLoadTest failed", (size_t)19980, waypoints.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelLoadTest failed", (size_t)19980, pois.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelLoadTest failed", waypoints.size(), parallelWaypoints.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelLoadTest failed", pois.size(), parallelPois.size());
+			CPPUNIT_ASSERT_MESSAGE("parallelLoadTest failed", NULL != parallelPoiDb.getPointerToPoi("Last"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("parallelLoadTest failed", messages.str(), parallelMessages.str());
+		}
+		/**
+		 * Tests if the lazy load keeps the coordinates and types and gives the strings on request
+		 * (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the view holds every object in file order with the values of its attributes
+		 * Failure - Otherwise
+		 */
+		void lazyViewTest()
+		{
+			std::ofstream(JSON_TEST_FILE) << "{\"pois\" : [{\"name\" : \"HDA\", \"latitude\" : 49.87, \"longitude\" : 8.64,"
+					" \"description\" : \"Campus\", \"type\" : \"UNIVERSITY\"}],\n"
+					"\"waypoints\" : [{\"name\" : \"Home\", \"latitude\" : 49.86, \"longitude\" : 8.65},\n"
+					"{\"longitude\" : 8.66, \"latitude\" : -49.85, \"name\" : \"Away\"}]}";
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			CJsonView view;
+
+			/* Test Execution*/
+			bool isRead = persistence.readView(view);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("lazyViewTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", (size_t)2, view.getWaypointCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", (size_t)1, view.getPoiCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", -49.85, view.getWaypoint(1).latitude);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", std::string("Away"), view.getName(view.getWaypoint(1)));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", (int)CPOI::UNIVERSITY, (int)view.getPoi(0).type);
+			CPOI poi = view.getPoiObject(0);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", std::string("HDA"), poi.getName());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", std::string("Campus"), poi.getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewTest failed", 8.64, poi.getLongitude());
+		}
+		/**
+		 * Tests if the lazy load skips and reports the invalid objects like readData (Error case)
+		 *
+		 * Validation:
+		 * Success - If the view holds the valid objects, including one with an escaped name, and the
+		 * invalid ones are counted
+		 * Failure - Otherwise
+		 */
+		void lazyViewErrorTest()
+		{
+			std::ofstream(JSON_TEST_FILE) << "{\"waypoints\" : [\n"
+					"{\"name\" : \"Repeated\", \"latitude\" : 1.5, \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" : \"Escaped \\\"name\\\"\", \"latitude\" : 1.5, \"longitude\" : 2.5},\n"
+					"{\"name\" : \"Wrong type\", \"latitude\" : \"1.5\", \"longitude\" : 2.5},\n"
+					"{\"name\" : \"Valid\", \"latitude\" : 1.5, \"longitude\" : 2.5}\n]}";
+			CJsonPersistence persistence;
+			persistence.setMediaName(JSON_TEST_MEDIA);
+			CJsonView view;
+
+			/* Test Execution*/
+			bool isRead = persistence.readView(view);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("lazyViewErrorTest failed", isRead);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewErrorTest failed", (size_t)2, view.getWaypointCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewErrorTest failed", std::string("Escaped \\\"name\\\""),
+					view.getName(view.getWaypoint(0)));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewErrorTest failed", std::string("Valid"),
+					view.getWaypointObject(1).getName());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("lazyViewErrorTest failed", 2UL,
+					CDiagnostics::getCount(CDiagnostics::INVALID_JSON));
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Attribute Order Test",
+						&CJsonPersistenceTest::attributeOrderTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Invalid Attribute Test",
+						&CJsonPersistenceTest::invalidAttributeTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Format Error Test",
+						&CJsonPersistenceTest::formatErrorTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Illegal Character Test",
+						&CJsonPersistenceTest::illegalCharacterTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Escaped String Test",
+						&CJsonPersistenceTest::escapedStringTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Parallel Load Test",
+						&CJsonPersistenceTest::parallelLoadTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Lazy View Test",
+						&CJsonPersistenceTest::lazyViewTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonPersistenceTest>("Lazy View Error Test",
+						&CJsonPersistenceTest::lazyViewErrorTest));
+			return suite;
+		}
+};
+#endif
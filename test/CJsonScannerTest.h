@@ -0,0 +1,123 @@
+#ifndef CTEST_JSON_SCANNER_H
+#define CTEST_JSON_SCANNER_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CJsonScanner.h>
+
+class CJsonScannerTest:public CppUnit::TestCase
+{
+	public:
+		CJsonScannerTest() : TestCase("Testing Json Scanner"){}
+		/**
+		 * Tests if the reused token holds the type and value of every token of the input (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every token has the expected type and value and the input ends with NULL
+		 * Failure - Otherwise
+		 */
+		void tokensTest()
+		{
+			std::istringstream input("{\"pois\" : [ {\"name\" : \"Mensa\", \"latitude\" : -4.98725e1, \"open\" : true, \"x\" : null} ]}");
+			APT::CJsonScanner scanner(input);
+			APT::CJsonToken::TokenType expectedTypes[] = {APT::CJsonToken::BEGIN_OBJECT, APT::CJsonToken::STRING,
+					APT::CJsonToken::NAME_SEPARATOR, APT::CJsonToken::BEGIN_ARRAY, APT::CJsonToken::BEGIN_OBJECT,
+					APT::CJsonToken::STRING, APT::CJsonToken::NAME_SEPARATOR, APT::CJsonToken::STRING,
+					APT::CJsonToken::VALUE_SEPARATOR, APT::CJsonToken::STRING, APT::CJsonToken::NAME_SEPARATOR,
+					APT::CJsonToken::NUMBER, APT::CJsonToken::VALUE_SEPARATOR, APT::CJsonToken::STRING,
+					APT::CJsonToken::NAME_SEPARATOR, APT::CJsonToken::BOOL, APT::CJsonToken::VALUE_SEPARATOR,
+					APT::CJsonToken::STRING, APT::CJsonToken::NAME_SEPARATOR, APT::CJsonToken::JSON_NULL,
+					APT::CJsonToken::END_OBJECT, APT::CJsonToken::END_ARRAY, APT::CJsonToken::END_OBJECT};
+			std::string strings;
+
+			/* Test Execution*/
+			for (unsigned int i = 0; i < sizeof(expectedTypes) / sizeof(expectedTypes[0]); i++)
+			{
+				APT::CJsonToken* pToken = scanner.nextToken();
+
+				/* Validation */
+				CPPUNIT_ASSERT_MESSAGE("tokensTest failed", NULL != pToken);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("tokensTest failed", (int)expectedTypes[i], (int)pToken->getType());
+				if (APT::CJsonToken::STRING == pToken->getType())
+					strings += std::string(pToken->getString()) + ";";
+				if (APT::CJsonToken::NUMBER == pToken->getType())
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("tokensTest failed", -49.8725, pToken->getNumber());
+				if (APT::CJsonToken::BOOL == pToken->getType())
+					CPPUNIT_ASSERT_MESSAGE("tokensTest failed", pToken->getBool());
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tokensTest failed", std::string("pois;name;Mensa;latitude;open;x;"), strings);
+			CPPUNIT_ASSERT_MESSAGE("tokensTest failed", NULL == scanner.nextToken());
+		}
+		/**
+		 * Tests if an illegal character is reported with its line (Error case)
+		 *
+		 * Validation:
+		 * Success - If the illegal character is thrown after the valid tokens, on line 2
+		 * Failure - Otherwise
+		 */
+		void illegalCharacterTest()
+		{
+			std::istringstream input("{\n@}");
+			APT::CJsonScanner scanner(input);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalCharacterTest failed", (int)APT::CJsonToken::BEGIN_OBJECT, (int)scanner.nextToken()->getType());
+			std::string illegalChar;
+
+			/* Test Execution*/
+			try
+			{
+				scanner.nextToken();
+			}
+			catch (std::string& character)
+			{
+				illegalChar = character;
+			}
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalCharacterTest failed", std::string("@"), illegalChar);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("illegalCharacterTest failed", 2, scanner.scannedLine());
+		}
+		/**
+		 * Tests if numbers with a plus sign keep their value (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the numbers have the values strtod() gives them
+		 * Failure - Otherwise
+		 */
+		void signedNumberTest()
+		{
+			std::istringstream input("[+48.5, +.5e2]");
+			APT::CJsonScanner scanner(input);
+			std::vector<double> numbers;
+
+			/* Test Execution*/
+			APT::CJsonToken* pToken = NULL;
+			while (NULL != (pToken = scanner.nextToken()))
+			{
+				if (APT::CJsonToken::NUMBER == pToken->getType())
+					numbers.push_back(pToken->getNumber());
+			}
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("signedNumberTest failed", (size_t)2, numbers.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("signedNumberTest failed", 48.5, numbers[0]);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("signedNumberTest failed", 50.0, numbers[1]);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CJsonScannerTest>("Tokens Test",
+						&CJsonScannerTest::tokensTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonScannerTest>("Signed Number Test",
+						&CJsonScannerTest::signedNumberTest));
+			suite->addTest(new CppUnit::TestCaller<CJsonScannerTest>("Illegal Character Test",
+						&CJsonScannerTest::illegalCharacterTest));
+			return suite;
+		}
+};
+#endif
@@ -0,0 +1,209 @@
+#ifndef CTEST_MAP_MATCHER_H
+#define CTEST_MAP_MATCHER_H
+
+#include <random>
+#include <sstream>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CMapMatcher.h>
+
+#define MATCH_GRID_SIDE (6)
+#define MATCH_GRID_SPACING (0.001)
+
+class CMapMatcherTest:public CppUnit::TestCase
+{
+	private:
+		CRoutingGraph* m_pGraph;
+		CMapMatcher* m_pMatcher;
+		std::vector<double> m_latitudes;
+		std::vector<double> m_longitudes;
+		std::vector<CRoutingGraph::node_t> m_truth;
+	public:
+		CMapMatcherTest() : TestCase("Testing Map Matching"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			/* Grid of roads in both directions */
+			m_pGraph = new CRoutingGraph();
+			for (int row = 0; row < MATCH_GRID_SIDE; row++)
+			{
+				for (int col = 0; col < MATCH_GRID_SIDE; col++)
+				{
+					std::ostringstream name;
+					name << "node_" << row << "_" << col;
+					m_pGraph->addNode(name.str(), 49.0 + row * MATCH_GRID_SPACING, 8.0 + col * MATCH_GRID_SPACING);
+				}
+			}
+			for (int row = 0; row < MATCH_GRID_SIDE; row++)
+			{
+				for (int col = 0; col < MATCH_GRID_SIDE; col++)
+				{
+					CRoutingGraph::node_t node = row * MATCH_GRID_SIDE + col;
+					if (col + 1 < MATCH_GRID_SIDE)
+					{
+						m_pGraph->addEdge(node, node + 1, 0);
+						m_pGraph->addEdge(node + 1, node, 0);
+					}
+					if (row + 1 < MATCH_GRID_SIDE)
+					{
+						m_pGraph->addEdge(node, node + MATCH_GRID_SIDE, 0);
+						m_pGraph->addEdge(node + MATCH_GRID_SIDE, node, 0);
+					}
+				}
+			}
+			m_pGraph->finalize();
+			m_pMatcher = new CMapMatcher(*m_pGraph);
+
+			/* Trace along row 1 to the east, then up column 4, one fix per node and one
+			 * in between, with about 10 m of noise */
+			std::mt19937 generator(5);
+			std::normal_distribution<double> noise(0.0, 0.0001);
+			for (int step = 0; step < 16; step++)
+			{
+				double row = (step < 8) ? 1 : 1 + (step - 8) * 0.5;
+				double col = (step < 8) ? step * 0.5 : 4;
+				m_latitudes.push_back(49.0 + row * MATCH_GRID_SPACING + noise(generator));
+				m_longitudes.push_back(8.0 + col * MATCH_GRID_SPACING + noise(generator));
+				bool isAtNode = (row == (int)row) && (col == (int)col);
+				m_truth.push_back(isAtNode ? (int)row * MATCH_GRID_SIDE + (int)col : CRoutingGraph::INVALID_NODE);
+			}
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pMatcher) delete m_pMatcher;
+			if(m_pGraph)   delete m_pGraph;
+		}
+		/**
+		 * Tests if a whole trace is matched to the driven nodes (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every fix recorded at a node is matched to that node
+		 * Failure - Otherwise
+		 */
+		void batchMatchTest()
+		{
+			std::vector<CRoutingGraph::node_t> matched;
+
+			/* Test Execution*/
+			m_pMatcher->match(m_latitudes.data(), m_longitudes.data(), m_latitudes.size(), matched);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("batchMatchTest failed", m_truth.size(), matched.size());
+			for (size_t i = 0; i < m_truth.size(); i++)
+			{
+				CPPUNIT_ASSERT_MESSAGE("batchMatchTest failed", CRoutingGraph::INVALID_NODE != matched[i]);
+				if (CRoutingGraph::INVALID_NODE != m_truth[i])
+				{
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("batchMatchTest failed", m_truth[i], matched[i]);
+				}
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("batchMatchTest failed", (size_t)0, m_pMatcher->getPendingFixCount());
+		}
+		/**
+		 * Tests if online matching keeps the latency bound and agrees with the batch result (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The lag is limited to 2 fixes
+		 *
+		 * Validation:
+		 * Success - If never more than 2 fixes are pending and the matches equal the batch matches
+		 * Failure - Otherwise
+		 */
+		void onlineMatchTest()
+		{
+			std::vector<CRoutingGraph::node_t> batch, online;
+			m_pMatcher->match(m_latitudes.data(), m_longitudes.data(), m_latitudes.size(), batch);
+			CMapMatcher::matchParameters_t parameters = m_pMatcher->getParameters();
+			parameters.maxLag = 2;
+			CPPUNIT_ASSERT(m_pMatcher->setParameters(parameters));
+
+			/* Test Execution*/
+			CRoutingGraph::node_t node;
+			for (size_t i = 0; i < m_latitudes.size(); i++)
+			{
+				m_pMatcher->addFix(CWaypoint(m_latitudes[i], m_longitudes[i], "fix"));
+				CPPUNIT_ASSERT_MESSAGE("onlineMatchTest failed", m_pMatcher->getPendingFixCount() <= 2);
+				while (m_pMatcher->getMatch(node))
+				{
+					online.push_back(node);
+				}
+			}
+			m_pMatcher->flush();
+			while (m_pMatcher->getMatch(node))
+			{
+				online.push_back(node);
+			}
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("onlineMatchTest failed", batch == online);
+		}
+		/**
+		 * Tests if a fix far off the roads is not matched and the matching continues (Error case)
+		 *
+		 * Validation:
+		 * Success - If the far fix is matched to INVALID_NODE and the others to their nodes
+		 * Failure - Otherwise
+		 */
+		void noCandidateTest()
+		{
+			double latitudes[] = {49.001, 49.001, 50.0, 49.001};
+			double longitudes[] = {8.0, 8.001, 9.0, 8.002};
+			std::vector<CRoutingGraph::node_t> matched;
+
+			/* Test Execution*/
+			m_pMatcher->match(latitudes, longitudes, 4, matched);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("noCandidateTest failed", (size_t)4, matched.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("noCandidateTest failed", (CRoutingGraph::node_t)MATCH_GRID_SIDE, matched[0]);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("noCandidateTest failed", (CRoutingGraph::node_t)MATCH_GRID_SIDE + 1, matched[1]);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("noCandidateTest failed", CRoutingGraph::INVALID_NODE, matched[2]);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("noCandidateTest failed", (CRoutingGraph::node_t)MATCH_GRID_SIDE + 2, matched[3]);
+		}
+		/**
+		 * Tests if invalid parameters are rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If setParameters fails and the previous parameters are kept
+		 * Failure - Otherwise
+		 */
+		void invalidParametersTest()
+		{
+			CMapMatcher::matchParameters_t parameters = m_pMatcher->getParameters();
+			double searchRadius = parameters.searchRadius;
+			parameters.searchRadius = -1;
+
+			/* Test Execution*/
+			bool isSet = m_pMatcher->setParameters(parameters);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("invalidParametersTest failed", !isSet);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidParametersTest failed", searchRadius, m_pMatcher->getParameters().searchRadius);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CMapMatcherTest>("Batch Match Test",
+						&CMapMatcherTest::batchMatchTest));
+			suite->addTest(new CppUnit::TestCaller<CMapMatcherTest>("Online Match Test",
+						&CMapMatcherTest::onlineMatchTest));
+			suite->addTest(new CppUnit::TestCaller<CMapMatcherTest>("No Candidate Test",
+						&CMapMatcherTest::noCandidateTest));
+			suite->addTest(new CppUnit::TestCaller<CMapMatcherTest>("Invalid Parameters Test",
+						&CMapMatcherTest::invalidParametersTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_MAP_MATCHER_H
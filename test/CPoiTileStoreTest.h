@@ -0,0 +1,256 @@
+#ifndef CTEST_POI_TILE_STORE_H
+#define CTEST_POI_TILE_STORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CCompactDecoder.h>
+#include <nsp/CCompactEncoder.h>
+#include <nsp/CDiagnostics.h>
+#include <nsp/CPoiDatabase.h>
+#include <nsp/CPoiTileStore.h>
+
+#define TILE_TEST_FILE "myCode/CPoiTileStoreTest.nspc"
+
+class CPoiTileStoreTest:public CppUnit::TestCase
+{
+	private:
+		CPoiDatabase* m_pPoiDb;
+		bool m_isDirectoryCreated;
+	public:
+		CPoiTileStoreTest() : TestCase("Testing POI Tile Store"){}
+		void setUp()
+		{
+			m_isDirectoryCreated = (0 == mkdir("myCode", 0755));
+			m_pPoiDb = new CPoiDatabase();
+			m_pPoiDb->addPoi(CPOI(CPOI::UNIVERSITY, "HDA", "university", 49.8666, 8.6407));
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Mensa", "", 49.8670, 8.6380));
+			m_pPoiDb->addPoi(CPOI(CPOI::TOURISTIC, "Brandenburger Tor", "gate", 52.5163, 13.3777));
+			m_pPoiDb->addPoi(CPOI(CPOI::TOURISTIC, "Opera House", "opera", -33.8568, 151.2153));
+		}
+		void tearDown()
+		{
+			remove(TILE_TEST_FILE);
+			if (m_isDirectoryCreated)
+				rmdir("myCode");
+			delete m_pPoiDb;
+		}
+		/**
+		 * Tests the tile keys and the tiles of a tiled file (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the keys are in Morton order, the borders of the globe are in the outer tiles,
+		 *           every tile gets its own block and a file without tiles is rejected
+		 * Failure - Otherwise
+		 */
+		void tileKeyTest()
+		{
+			CPoiTileStore store;
+			CCompactDecoder decoder;
+			CCompactEncoder encoder;
+			std::vector<uint64_t> keys;
+
+			/* Test Execution*/
+			bool isWritten = CPoiTileStore::writeTiles(TILE_TEST_FILE, *m_pPoiDb);
+			bool isDecoded = decoder.open(TILE_TEST_FILE);
+			size_t blocks = decoder.getBlockCount();
+			decoder.close();
+			bool isOpened = store.open(TILE_TEST_FILE);
+			bool isListed = store.getTiles(-90, -180, 90, 180, keys);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint64_t)1, compact_coding::getTileKey(1, 0));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint64_t)2, compact_coding::getTileKey(0, 1));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint64_t)12, compact_coding::getTileKey(2, 2));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint32_t)0,
+					compact_coding::getTileColumn(compact_coding::quantize(-180), MAX_TILE_LEVEL));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint32_t)65535,
+					compact_coding::getTileColumn(compact_coding::quantize(180), MAX_TILE_LEVEL));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (uint32_t)1,
+					compact_coding::getTileRow(compact_coding::quantize(0), 1));
+			CPPUNIT_ASSERT_MESSAGE("tileKeyTest failed", isWritten && isDecoded && isOpened && isListed);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (size_t)3, blocks);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", (size_t)3, keys.size());
+			CPPUNIT_ASSERT_MESSAGE("tileKeyTest failed", (keys[0] < keys[1]) && (keys[1] < keys[2]));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("tileKeyTest failed", store.getTileKey(49.8666, 8.6407),
+					store.getTileKey(49.8670, 8.6380));
+			CPPUNIT_ASSERT(encoder.open(TILE_TEST_FILE));
+			encoder.addPoi(CPOI());
+			CPPUNIT_ASSERT(encoder.close());
+			CPPUNIT_ASSERT_MESSAGE("tileKeyTest failed", !store.open(TILE_TEST_FILE));
+		}
+		/**
+		 * Tests if only the tiles of an area are loaded (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the POIs of the area are loaded once, others are not loaded and a POI
+		 *           already in the Database is kept
+		 * Failure - Otherwise
+		 */
+		void loadAreaTest()
+		{
+			CPPUNIT_ASSERT(CPoiTileStore::writeTiles(TILE_TEST_FILE, *m_pPoiDb));
+			CPoiDatabase poiDb;
+			poiDb.addPoi(CPOI(CPOI::RESTAURANT, "Mensa", "own entry", 49.8670, 8.6380));
+
+			/* Test Execution*/
+			bool isOpened = poiDb.openTiles(TILE_TEST_FILE);
+			bool isLoaded = poiDb.loadArea(49.8, 8.6, 49.9, 8.7);
+			bool isReloaded = poiDb.loadArea(49.86, 8.63, 49.87, 8.65);
+			size_t darmstadtSize = poiDb.size();
+			size_t darmstadtTiles = poiDb.getLoadedTileCount();
+			bool isBerlinLoaded = poiDb.loadArea(52, 13, 53, 14);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("loadAreaTest failed", isOpened && isLoaded && isReloaded && isBerlinLoaded);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", (size_t)2, darmstadtSize);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", (size_t)1, darmstadtTiles);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", (size_t)3, poiDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", (size_t)2, poiDb.getLoadedTileCount());
+			CPPUNIT_ASSERT_MESSAGE("loadAreaTest failed", NULL == poiDb.findData("Opera House"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", std::string("own entry"),
+					poiDb.getPointerToPoi("Mensa")->getDescription());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("loadAreaTest failed", std::string("university"),
+					poiDb.getPointerToPoi("HDA")->getDescription());
+			CPPUNIT_ASSERT_MESSAGE("loadAreaTest failed", poiDb.getTileMemory() > 0);
+		}
+		/**
+		 * Tests if the least recently used tiles are removed under the memory limit (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the tiles of the last area stay loaded, the older tiles are removed with their
+		 *           POIs and the other POIs are kept
+		 * Failure - Otherwise
+		 */
+		void evictionTest()
+		{
+			CPPUNIT_ASSERT(CPoiTileStore::writeTiles(TILE_TEST_FILE, *m_pPoiDb));
+			CPoiDatabase poiDb;
+			poiDb.addPoi(CPOI(CPOI::UNKNOWN, "Home", "", 49.8700, 8.6500));
+			std::ostringstream messages;
+			CConsoleSink sink(messages);
+
+			/* Test Execution*/
+			bool isOpened = poiDb.openTiles(TILE_TEST_FILE, 1);
+			poiDb.loadArea(49.8, 8.6, 49.9, 8.7);
+			size_t darmstadtSize = poiDb.size();
+			poiDb.loadArea(-34, 151, -33, 152);
+			CDiagnostics::setSink(&sink);
+			bool isMissingRejected = !poiDb.openTiles("myCode/CPoiTileStoreTest.none");
+			CDiagnostics::setSink(NULL);
+			bool isClosedLoaded = poiDb.loadArea(52, 13, 53, 14);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("evictionTest failed", isOpened && isMissingRejected && !isClosedLoaded);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("evictionTest failed", (size_t)3, darmstadtSize);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("evictionTest failed", (size_t)2, poiDb.size());
+			CPPUNIT_ASSERT_MESSAGE("evictionTest failed", NULL == poiDb.findData("HDA"));
+			CPPUNIT_ASSERT_MESSAGE("evictionTest failed", NULL != poiDb.findData("Home"));
+			CPPUNIT_ASSERT_MESSAGE("evictionTest failed", NULL != poiDb.findData("Opera House"));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("evictionTest failed", (size_t)0, poiDb.getLoadedTileCount());
+		}
+		/**
+		 * Tests the memory limit when a tile of the area cannot be read (Boundary case)
+		 *
+		 * Pre:Conditions:
+		 * The name of the Opera House is damaged in the tiled file
+		 *
+		 * Validation:
+		 * Success - If the area is reported as not loaded, its readable tile stays loaded and the
+		 *           older tiles are removed
+		 * Failure - Otherwise
+		 */
+		void damagedTileTest()
+		{
+			CPPUNIT_ASSERT(CPoiTileStore::writeTiles(TILE_TEST_FILE, *m_pPoiDb));
+			std::string content;
+			FILE* pFile = fopen(TILE_TEST_FILE, "rb");
+			CPPUNIT_ASSERT(NULL != pFile);
+			char buffer[4096];
+			for (size_t read = 0; 0 < (read = fread(buffer, 1, sizeof(buffer), pFile));)
+				content.append(buffer, read);
+			fclose(pFile);
+			size_t position = content.find("Opera House");
+			CPPUNIT_ASSERT(std::string::npos != position);
+			content[position] = 'X';
+			pFile = fopen(TILE_TEST_FILE, "wb");
+			CPPUNIT_ASSERT(NULL != pFile);
+			CPPUNIT_ASSERT_EQUAL(content.size(), fwrite(content.data(), 1, content.size(), pFile));
+			fclose(pFile);
+			CPoiDatabase poiDb;
+
+			/* Test Execution*/
+			bool isOpened = poiDb.openTiles(TILE_TEST_FILE, 1);
+			bool isDarmstadtLoaded = poiDb.loadArea(49.8, 8.6, 49.9, 8.7);
+			bool isAreaLoaded = poiDb.loadArea(-34, 13, 53, 152);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("damagedTileTest failed", isOpened && isDarmstadtLoaded && !isAreaLoaded);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("damagedTileTest failed", (size_t)1, poiDb.getLoadedTileCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("damagedTileTest failed", (size_t)1, poiDb.size());
+			CPPUNIT_ASSERT_MESSAGE("damagedTileTest failed", NULL != poiDb.findData("Brandenburger Tor"));
+			CPPUNIT_ASSERT_MESSAGE("damagedTileTest failed", NULL == poiDb.findData("HDA"));
+			CPPUNIT_ASSERT_MESSAGE("damagedTileTest failed", NULL == poiDb.findData("Opera House"));
+		}
+		/**
+		 * Tests if tiles are loaded and removed without changes and keep the POIs of the user (Normal case)
+		 *
+		 * Validation:
+		 * Success - If only the updated and removed POIs are tracked and a replaced POI stays when its
+		 *           tile is removed
+		 * Failure - Otherwise
+		 */
+		void trackingTest()
+		{
+			CPPUNIT_ASSERT(CPoiTileStore::writeTiles(TILE_TEST_FILE, *m_pPoiDb));
+			CPoiDatabase poiDb;
+			poiDb.setChangeTracking(true);
+			unsigned long trackingId = poiDb.getTrackingId();
+			CPPUNIT_ASSERT(poiDb.openTiles(TILE_TEST_FILE, 1));
+
+			/* Test Execution*/
+			poiDb.loadArea(49.8, 8.6, 49.9, 8.7);
+			unsigned long loadSequence = poiDb.getChangeSequence();
+			poiDb.updatePoi(CPOI(CPOI::UNIVERSITY, "HDA", "replaced", 49.8666, 8.6407));
+			poiDb.removePoi("Mensa");
+			poiDb.loadArea(-34, 151, -33, 152);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", trackingId, poiDb.getTrackingId());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", (unsigned long)0, loadSequence);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", (unsigned long)2, poiDb.getChangeSequence());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", (size_t)1, poiDb.getLoadedTileCount());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", (size_t)2, poiDb.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("trackingTest failed", std::string("replaced"),
+					poiDb.getPointerToPoi("HDA")->getDescription());
+			CPPUNIT_ASSERT_MESSAGE("trackingTest failed", NULL != poiDb.findData("Opera House"));
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CPoiTileStoreTest>("Tile Key Test",
+						&CPoiTileStoreTest::tileKeyTest));
+			suite->addTest(new CppUnit::TestCaller<CPoiTileStoreTest>("Tile Load Area Test",
+						&CPoiTileStoreTest::loadAreaTest));
+			suite->addTest(new CppUnit::TestCaller<CPoiTileStoreTest>("Tile Eviction Test",
+						&CPoiTileStoreTest::evictionTest));
+			suite->addTest(new CppUnit::TestCaller<CPoiTileStoreTest>("Tile Damaged Tile Test",
+						&CPoiTileStoreTest::damagedTileTest));
+			suite->addTest(new CppUnit::TestCaller<CPoiTileStoreTest>("Tile Tracking Test",
+						&CPoiTileStoreTest::trackingTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_POI_TILE_STORE_H
@@ -0,0 +1,137 @@
+#ifndef CTEST_ROUTE_FINDER_H
+#define CTEST_ROUTE_FINDER_H
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CRouteFinder.h>
+
+class CRouteFinderTest:public CppUnit::TestCase
+{
+	private:
+		CRoutingGraph* m_pGraph;
+		CRoutingGraph::node_t m_darmstadt, m_mannheim, m_heidelberg, m_stuttgart, m_berlin;
+	public:
+		CRouteFinderTest() : TestCase("Testing Route Finder"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pGraph     = new CRoutingGraph();
+			m_darmstadt  = m_pGraph->addNode("Darmstadt", 49.8728, 8.6512);
+			m_mannheim   = m_pGraph->addNode("Mannheim", 49.49671, 8.47955);
+			m_heidelberg = m_pGraph->addNode("Heidelberg", 49.4076, 8.69079);
+			m_stuttgart  = m_pGraph->addNode("Stuttgart", 48.7823, 9.1770200);
+			m_berlin     = m_pGraph->addNode("Berlin", 52.5166, 13.4050);
+
+			/* Darmstadt -> Heidelberg directly is long, the detour via Mannheim is shorter */
+			m_pGraph->addEdge(m_darmstadt, m_heidelberg, 200);
+			m_pGraph->addEdge(m_darmstadt, m_mannheim, 50);
+			m_pGraph->addEdge(m_mannheim, m_heidelberg, 20);
+			m_pGraph->addEdge(m_heidelberg, m_stuttgart, 90);
+			m_pGraph->finalize();
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pGraph) delete m_pGraph;
+		}
+		/**
+		 * Tests if the shortest path is found (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Graph has a short detour and a long direct connection
+		 *
+		 * Validation:
+		 * Success - If the detour via Mannheim is returned with its length
+		 * Failure - Otherwise
+		 */
+		void shortestPathTest()
+		{
+			CRouteFinder finder(*m_pGraph);
+			std::vector<CRoutingGraph::node_t> path;
+			double distance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findPath(m_darmstadt, m_stuttgart, path, distance);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("shortestPathTest failed", isFound);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("shortestPathTest failed", (size_t)4, path.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("shortestPathTest failed", m_mannheim, path[1]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("shortestPathTest failed", 160.0, distance, 0.001);
+		}
+		/**
+		 * Tests if no path is reported for an unreachable destination (Error case)
+		 *
+		 * Validation:
+		 * Success - If the search fails and the path is empty
+		 * Failure - Otherwise
+		 */
+		void unreachableTest()
+		{
+			CRouteFinder finder(*m_pGraph);
+			std::vector<CRoutingGraph::node_t> path;
+			double distance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findPath(m_darmstadt, m_berlin, path, distance);
+
+			/* Validation */
+			CPPUNIT_ASSERT_MESSAGE("unreachableTest failed", !isFound);
+			CPPUNIT_ASSERT_MESSAGE("unreachableTest failed", path.empty());
+		}
+		/**
+		 * Tests if the found path is added to a route (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. Route has to be connected to a Waypoint Database holding the nodes
+		 *
+		 * Validation:
+		 * Success - If all Waypoints of the path are in the route in order
+		 * Failure - Otherwise
+		 */
+		void findRouteTest()
+		{
+			CWpDatabase wpDb;
+			CPoiDatabase poiDb;
+			for (CRoutingGraph::node_t node = 0; node < m_pGraph->getNodeCount(); node++)
+			{
+				wpDb.addWaypoint(CWaypoint(m_pGraph->getLatitude(node), m_pGraph->getLongitude(node), m_pGraph->getNodeName(node)));
+			}
+			CRoute route;
+			route.connectToWpDatabase(&wpDb);
+			route.connectToPoiDatabase(&poiDb);
+			CRouteFinder finder(*m_pGraph);
+			double distance = 0;
+
+			/* Test Execution*/
+			bool isFound = finder.findRoute("Darmstadt", "Heidelberg", route, distance);
+
+			/* Validation */
+			const std::vector<const CWaypoint*> routeVec = route.getRoute();
+			CPPUNIT_ASSERT_MESSAGE("findRouteTest failed", isFound);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("findRouteTest failed", (size_t)3, routeVec.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("findRouteTest failed", std::string("Mannheim"), routeVec[1]->getName());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CRouteFinderTest>("Shortest Path Test",
+						&CRouteFinderTest::shortestPathTest));
+			suite->addTest(new CppUnit::TestCaller<CRouteFinderTest>("Unreachable Destination Test",
+						&CRouteFinderTest::unreachableTest));
+			suite->addTest(new CppUnit::TestCaller<CRouteFinderTest>("Find Route Test",
+						&CRouteFinderTest::findRouteTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_ROUTE_FINDER_H
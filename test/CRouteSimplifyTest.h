@@ -0,0 +1,204 @@
+#ifndef CTEST_ROUTE_SIMPLIFY_H
+#define CTEST_ROUTE_SIMPLIFY_H
+
+#include <random>
+#include <sstream>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/CRoute.h>
+#include <nsp/GeoMath.h>
+
+class CRouteSimplifyTest:public CppUnit::TestCase
+{
+	private:
+		CWpDatabase*  m_pWpDb;
+		CPoiDatabase* m_pPoiDb;
+		CRoute* m_pTestRoute;
+
+		/*
+		 * Adds a Waypoint to the database and to the end of the test route
+		 */
+		void addTrackPoint(int index, double latitude, double longitude)
+		{
+			std::ostringstream name;
+			name << "track_" << index;
+			m_pWpDb->addWaypoint(CWaypoint(latitude, longitude, name.str()));
+			m_pTestRoute->addWaypoint(name.str());
+		}
+	public:
+		CRouteSimplifyTest() : TestCase("Testing Route Simplification"){}
+		/*
+		 * Function which would allocate the memory needed and the values
+		 * for the tests running in this suite
+		 */
+		void setUp()
+		{
+			m_pWpDb  = new CWpDatabase();
+			m_pPoiDb = new CPoiDatabase();
+			m_pTestRoute = new CRoute();
+			m_pTestRoute->connectToWpDatabase(m_pWpDb);
+			m_pTestRoute->connectToPoiDatabase(m_pPoiDb);
+		}
+		/*
+		 * Function which would release the memory allocated
+		 * the tests running in this suite
+		 */
+		void tearDown()
+		{
+			if(m_pTestRoute) delete m_pTestRoute;
+			if(m_pWpDb)  	 delete m_pWpDb;
+			if(m_pPoiDb) 	 delete m_pPoiDb;
+		}
+		/**
+		 * Tests if a track along a meridian is reduced to its end points (Normal case)
+		 *
+		 * Validation:
+		 * Success - If only the first and the last Waypoint remain
+		 * Failure - Otherwise
+		 */
+		void straightTrackTest()
+		{
+			/* Pre-conditions */
+			for (int i = 0; i < 1000; i++)
+			{
+				addTrackPoint(i, 49.0 + i * 0.001, 8.65);
+			}
+
+			/* Test Execution*/
+			unsigned int removedCount = m_pTestRoute->simplify(1.0);
+
+			/* Validation */
+			std::vector<const CWaypoint*> routeContents = m_pTestRoute->getRoute();
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("straightTrackTest failed", 998u, removedCount);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("straightTrackTest failed", (size_t)2, routeContents.size());
+			CPPUNIT_ASSERT_MESSAGE("straightTrackTest failed", "track_0" == routeContents.front()->getName());
+			CPPUNIT_ASSERT_MESSAGE("straightTrackTest failed", "track_999" == routeContents.back()->getName());
+		}
+		/**
+		 * Tests if a POI of the route is kept (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The POI lies on the track and is added after a Waypoint in the middle
+		 *
+		 * Validation:
+		 * Success - If the route consists of the first Waypoint, the POI and the last Waypoint
+		 * Failure - Otherwise
+		 */
+		void poiAnchorTest()
+		{
+			/* Pre-conditions */
+			for (int i = 0; i < 1000; i++)
+			{
+				addTrackPoint(i, 49.0 + i * 0.001, 8.65);
+			}
+			m_pPoiDb->addPoi(CPOI(CPOI::RESTAURANT, "Mensa HDA", "the best Mensa", 49.5005, 8.65));
+			m_pTestRoute->addPoi("Mensa HDA", "track_500");
+
+			/* Test Execution*/
+			m_pTestRoute->simplify(1.0);
+
+			/* Validation */
+			std::vector<const CWaypoint*> routeContents = m_pTestRoute->getRoute();
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("poiAnchorTest failed", (size_t)3, routeContents.size());
+			CPPUNIT_ASSERT_MESSAGE("poiAnchorTest failed", "track_0" == routeContents[0]->getName());
+			CPPUNIT_ASSERT_MESSAGE("poiAnchorTest failed", "Mensa HDA" == routeContents[1]->getName());
+			CPPUNIT_ASSERT_MESSAGE("poiAnchorTest failed", "track_999" == routeContents[2]->getName());
+		}
+		/**
+		 * Tests if a noisy track stays within the tolerance and the threads agree (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The track is long enough to be split between the threads
+		 *
+		 * Validation:
+		 * Success - If every Waypoint lies within the tolerance of the simplified route
+		 *           and the parallel result equals the sequential one
+		 * Failure - Otherwise
+		 */
+		void toleranceTest()
+		{
+			const double toleranceMeters = 15.0;
+			std::mt19937 generator(7);
+			std::normal_distribution<double> noise(0.0, 0.0002);
+			double latitude = 49.0, longitude = 8.0, heading = 0.0;
+			for (int i = 0; i < 20000; i++)
+			{
+				heading += noise(generator) * 50;
+				latitude += 0.0001 * cos(heading) + noise(generator);
+				longitude += 0.0001 * sin(heading) + noise(generator);
+				addTrackPoint(i, latitude, longitude);
+			}
+			std::vector<const CWaypoint*> original = m_pTestRoute->getRoute();
+			CRoute parallelRoute(*m_pTestRoute);
+
+			/* Test Execution*/
+			unsigned int removedCount = m_pTestRoute->simplify(toleranceMeters);
+			unsigned int parallelRemovedCount = parallelRoute.simplify(toleranceMeters, 3);
+
+			/* Validation */
+			std::vector<const CWaypoint*> simplified = m_pTestRoute->getRoute();
+			CPPUNIT_ASSERT_MESSAGE("toleranceTest failed", removedCount > 0);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("toleranceTest failed", original.size() - removedCount, simplified.size());
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("toleranceTest failed", removedCount, parallelRemovedCount);
+			CPPUNIT_ASSERT_MESSAGE("toleranceTest failed", simplified == parallelRoute.getRoute());
+
+			size_t kept = 0;
+			double start[3], end[3], point[3];
+			for (size_t i = 0; i < original.size(); i++)
+			{
+				if (original[i] == simplified[kept])
+				{
+					geo_math::toUnitVector(original[i]->getLatitude(), original[i]->getLongitude(), start);
+					kept++;
+					continue;
+				}
+				CPPUNIT_ASSERT_MESSAGE("toleranceTest failed", kept < simplified.size());
+				geo_math::toUnitVector(simplified[kept]->getLatitude(), simplified[kept]->getLongitude(), end);
+				geo_math::toUnitVector(original[i]->getLatitude(), original[i]->getLongitude(), point);
+				CPPUNIT_ASSERT_MESSAGE("toleranceTest failed",
+						geo_math::arcDistance(point, start, end) * 1000 <= toleranceMeters);
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("toleranceTest failed", simplified.size(), kept);
+		}
+		/**
+		 * Tests if a negative tolerance is rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If the route is left unchanged
+		 * Failure - Otherwise
+		 */
+		void invalidToleranceTest()
+		{
+			/* Pre-conditions */
+			for (int i = 0; i < 10; i++)
+			{
+				addTrackPoint(i, 49.0 + i * 0.001, 8.65);
+			}
+
+			/* Test Execution*/
+			unsigned int removedCount = m_pTestRoute->simplify(-1.0);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidToleranceTest failed", 0u, removedCount);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("invalidToleranceTest failed", (size_t)10, m_pTestRoute->getRoute().size());
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CRouteSimplifyTest>("Straight Track Test",
+						&CRouteSimplifyTest::straightTrackTest));
+			suite->addTest(new CppUnit::TestCaller<CRouteSimplifyTest>("POI Anchor Test",
+						&CRouteSimplifyTest::poiAnchorTest));
+			suite->addTest(new CppUnit::TestCaller<CRouteSimplifyTest>("Tolerance Test",
+						&CRouteSimplifyTest::toleranceTest));
+			suite->addTest(new CppUnit::TestCaller<CRouteSimplifyTest>("Invalid Tolerance Test",
+						&CRouteSimplifyTest::invalidToleranceTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_ROUTE_SIMPLIFY_H
@@ -0,0 +1,184 @@
+#ifndef CTEST_TYPE_MAPPING_H
+#define CTEST_TYPE_MAPPING_H
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <string>
+#include <string_view>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+
+#include <nsp/TypeMapping.h>
+
+class CTypeMappingTest:public CppUnit::TestCase
+{
+	public:
+		CTypeMappingTest() : TestCase("Testing Type Mapping"){}
+		/**
+		 * Tests if decimal numbers of the CSV files are converted (Normal case)
+		 *
+		 * Validation:
+		 * Success - If every number equals the result of strtod()
+		 * Failure - Otherwise
+		 */
+		void convertDoubleTest()
+		{
+			const char* numbers[] = {"0", "-0", "52.5167", "-13.3833", ".5", "5.", "5..", "000123.4500",
+				"0.1234567890123456789", "12345678901234567890.5", "-0.0000000000000000000000000001"};
+
+			for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+			{
+				double number = -1;
+
+				/* Test Execution*/
+				bool isConverted = type_mapping::convertStringToDouble(numbers[i], number);
+
+				/* Validation */
+				CPPUNIT_ASSERT_MESSAGE(std::string("convertDoubleTest failed: ") + numbers[i], isConverted);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE(std::string("convertDoubleTest failed: ") + numbers[i], strtod(numbers[i], NULL), number);
+			}
+		}
+		/**
+		 * Tests if text which is no decimal number is rejected (Error case)
+		 *
+		 * Validation:
+		 * Success - If the conversion fails and the output is not changed
+		 * Failure - Otherwise
+		 */
+		void invalidDoubleTest()
+		{
+			const char* texts[] = {"", "-", ".", "1.2.3", "1e5", "+1", " 1", "1 ", "--1", "1-", "0x10", "nan", "inf"};
+			std::string overflow = "1" + std::string(400, '0');
+
+			for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+			{
+				double number = -1;
+
+				/* Test Execution*/
+				bool isConverted = type_mapping::convertStringToDouble(texts[i], number);
+
+				/* Validation */
+				CPPUNIT_ASSERT_MESSAGE(std::string("invalidDoubleTest failed: ") + texts[i], !isConverted);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE(std::string("invalidDoubleTest failed: ") + texts[i], -1.0, number);
+			}
+			double number = -1;
+			CPPUNIT_ASSERT_MESSAGE("invalidDoubleTest failed", !type_mapping::convertStringToDouble(overflow, number));
+		}
+		/**
+		 * Tests if numbers with exponent are parsed like JSON numbers (Normal case)
+		 *
+		 * Pre:Conditions:
+		 * 1. The text is not terminated after the number
+		 *
+		 * Validation:
+		 * Success - If the length and value of the number equal the ones of strtod()
+		 * Failure - Otherwise
+		 */
+		void exponentTest()
+		{
+			const char* texts[] = {"1e1,", "1.25E+1]", "-5.25e-1}", "4.9036e", "2e+", "1e400", "1e-400", "-1e400",
+				"9007199254740993", "2.2250738585072011e-308", "1.7976931348623157e308 ", "+5", "+1.5", "+.5e2", "+1e400",
+				"+12345678901234567890.5"};
+
+			for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+			{
+				double number = -1;
+				char* pEnd = NULL;
+				double expected = strtod(texts[i], &pEnd);
+				std::string_view text(texts[i]);
+
+				/* Test Execution*/
+				size_t length = type_mapping::parseDecimal(text, number, true);
+
+				/* Validation */
+				CPPUNIT_ASSERT_EQUAL_MESSAGE(std::string("exponentTest failed: ") + texts[i], (size_t)(pEnd - texts[i]), length);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE(std::string("exponentTest failed: ") + texts[i], expected, number);
+			}
+		}
+		/**
+		 * Tests if the exponent is only parsed when it is allowed (Boundary case)
+		 *
+		 * Validation:
+		 * Success - If the number ends before the exponent
+		 * Failure - Otherwise
+		 */
+		void exponentNotAllowedTest()
+		{
+			double number = -1;
+
+			/* Test Execution*/
+			size_t length = type_mapping::parseDecimal("12.5e3", number);
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exponentNotAllowedTest failed", (size_t)4, length);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("exponentNotAllowedTest failed", 12.5, number);
+		}
+		/**
+		 * Tests if formatted numbers are the shortest text which is read back unchanged (Normal case)
+		 *
+		 * Validation:
+		 * Success - If the text has no exponent, parses to the same value and has the expected digits
+		 * Failure - Otherwise
+		 */
+		void formatDoubleTest()
+		{
+			double numbers[] = {0, -0.5, 0.1, 52.5167, -13.3833, 49.872812345669999, 1.0 / 3, 180, 1e21, 4.9406564584124654e-324, -1.7976931348623157e308};
+			char buffer[MAX_DOUBLE_TEXT_LENGTH];
+
+			for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+			{
+				/* Test Execution*/
+				size_t length = type_mapping::formatDouble(numbers[i], buffer, sizeof(buffer));
+
+				/* Validation */
+				std::string text(buffer, length);
+				double number = -1;
+				CPPUNIT_ASSERT_MESSAGE("formatDoubleTest failed: " + text, 0 != length);
+				CPPUNIT_ASSERT_MESSAGE("formatDoubleTest failed: " + text, std::string::npos == text.find('e'));
+				CPPUNIT_ASSERT_MESSAGE("formatDoubleTest failed: " + text, type_mapping::convertStringToDouble(text, number));
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("formatDoubleTest failed: " + text, numbers[i], number);
+			}
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("formatDoubleTest failed", std::string("52.5167"), std::string(buffer, type_mapping::formatDouble(52.5167, buffer, sizeof(buffer))));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("formatDoubleTest failed", std::string("-0.1"), std::string(buffer, type_mapping::formatDouble(-0.1, buffer, sizeof(buffer))));
+		}
+		/**
+		 * Tests if a too small buffer is reported (Error case)
+		 *
+		 * Validation:
+		 * Success - If 0 characters are written
+		 * Failure - Otherwise
+		 */
+		void formatSmallBufferTest()
+		{
+			char buffer[4];
+
+			/* Test Execution*/
+			size_t length = type_mapping::formatDouble(52.5167, buffer, sizeof(buffer));
+
+			/* Validation */
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("formatSmallBufferTest failed", (size_t)0, length);
+		}
+		static CppUnit::TestSuite* suite()
+		{
+			CppUnit::TestSuite* suite = new CppUnit::TestSuite("Load Tests");
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Convert Double Test",
+						&CTypeMappingTest::convertDoubleTest));
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Invalid Double Test",
+						&CTypeMappingTest::invalidDoubleTest));
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Exponent Test",
+						&CTypeMappingTest::exponentTest));
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Exponent Not Allowed Test",
+						&CTypeMappingTest::exponentNotAllowedTest));
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Format Double Test",
+						&CTypeMappingTest::formatDoubleTest));
+			suite->addTest(new CppUnit::TestCaller<CTypeMappingTest>("Format Small Buffer Test",
+						&CTypeMappingTest::formatSmallBufferTest));
+
+			return suite;
+		}
+};
+
+#endif // CTEST_TYPE_MAPPING_H
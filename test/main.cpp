@@ -10,6 +10,25 @@
 #include "COperatorPlusEqualTest.h"
 #include "CPrintTest.h"
 #include "CGetDistanceNextPoiTest.h"
+#include "CRouteFinderTest.h"
+#include "CContractionHierarchyTest.h"
+#include "CBatchQueryTest.h"
+#include "CRouteSimplifyTest.h"
+#include "CMapMatcherTest.h"
+#include "CDistanceMatrixTest.h"
+#include "CCSVReaderTest.h"
+#include "CAttributeExtractorTest.h"
+#include "CTypeMappingTest.h"
+#include "CBufferedWriterTest.h"
+#include "CJournalTest.h"
+#include "CDiagnosticsTest.h"
+#include "CJsonScannerTest.h"
+#include "CJsonIndexScannerTest.h"
+#include "CJsonPersistenceTest.h"
+#include "CBinaryPersistenceTest.h"
+#include "CCompactPersistenceTest.h"
+#include "CDiskDatabaseTest.h"
+#include "CPoiTileStoreTest.h"
 
 using namespace CppUnit;
 
@@ -25,6 +44,25 @@ int main()
 	runner.addTest( COperatorPlusEqualTest::suite() );
 	runner.addTest( CPrintTest::suite() );
 	runner.addTest( CGetDistanceNextPoiTest::suite() );
+	runner.addTest( CRouteFinderTest::suite() );
+	runner.addTest( CContractionHierarchyTest::suite() );
+	runner.addTest( CBatchQueryTest::suite() );
+	runner.addTest( CRouteSimplifyTest::suite() );
+	runner.addTest( CMapMatcherTest::suite() );
+	runner.addTest( CDistanceMatrixTest::suite() );
+	runner.addTest( CCSVReaderTest::suite() );
+	runner.addTest( CAttributeExtractorTest::suite() );
+	runner.addTest( CTypeMappingTest::suite() );
+	runner.addTest( CBufferedWriterTest::suite() );
+	runner.addTest( CJournalTest::suite() );
+	runner.addTest( CDiagnosticsTest::suite() );
+	runner.addTest( CJsonScannerTest::suite() );
+	runner.addTest( CJsonIndexScannerTest::suite() );
+	runner.addTest( CJsonPersistenceTest::suite() );
+	runner.addTest( CBinaryPersistenceTest::suite() );
+	runner.addTest( CCompactPersistenceTest::suite() );
+	runner.addTest( CDiskDatabaseTest::suite() );
+	runner.addTest( CPoiTileStoreTest::suite() );
 	runner.run();
 
 	return 0;
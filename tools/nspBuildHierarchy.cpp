@@ -0,0 +1,63 @@
+/***************************************************************************
+* ============= Copyright by Darmstadt University of Applied Sciences =======
+****************************************************************************
+* Filename        : nspBuildHierarchy.cpp
+* Author          : Jishnu M Thampan
+* Description     : Offline preprocessing of the route queries. Builds the
+*                   contraction hierarchy of the Waypoints of a CSV media
+*                   and an edge list file and writes it to a hierarchy file
+*                   which is memory-mapped by the navigation system.
+*                   Usage: nspBuildHierarchy <mediaName> <edgeFile>
+*                          <hierarchyFile> [threads]
+****************************************************************************/
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <nsp/CCSV.h>
+#include <nsp/CContractionHierarchy.h>
+#include <nsp/CRoutingGraph.h>
+
+int main(int argc, char *argv[])
+{
+  if (argc < 4)
+  {
+    std::cout << "Usage: " << argv[0]
+              << " <mediaName> <edgeFile> <hierarchyFile> [threads]"
+              << std::endl;
+    return 1;
+  }
+  unsigned int threads = (argc > 4) ? atoi(argv[4]) : 0;
+
+  CWpDatabase wpDb;
+  CPoiDatabase poiDb;
+  CCSV csv;
+  csv.setMediaName(argv[1]);
+  if (!csv.readData(wpDb, poiDb, CCSV::REPLACE))
+  {
+    return 1;
+  }
+  CRoutingGraph graph;
+  if (!graph.loadFromFile(argv[2], wpDb))
+  {
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  CContractionHierarchy hierarchy;
+  hierarchy.build(graph, threads);
+  std::chrono::duration<double> buildTime =
+      std::chrono::steady_clock::now() - start;
+
+  if (!hierarchy.writeToFile(argv[3]))
+  {
+    return 1;
+  }
+  std::cout << "Contracted " << hierarchy.getNodeCount() << " nodes and "
+            << graph.getEdgeCount() << " edges in " << buildTime.count()
+            << " s into " << hierarchy.getUpEdgeCount() << " upward and "
+            << hierarchy.getDownEdgeCount() << " downward edges" << std::endl;
+  return 0;
+}